@@ -204,6 +204,23 @@ public class BraveRewardsNativeWorker {
         }
     }
 
+    /**
+     * Returns everything the rewards panel shows about the publisher of
+     * |tabId| in one call, rather than one call per field.
+     */
+    @Nullable
+    public BraveRewardsPublisher GetPublisherPanelInfo(int tabId) {
+        synchronized(lock) {
+            String json = BraveRewardsNativeWorkerJni.get().getPublisherPanelInfo(
+                    mNativeBraveRewardsNativeWorker, tabId);
+            try {
+                return new BraveRewardsPublisher(json);
+            } catch (JSONException e) {
+                return null;
+            }
+        }
+    }
+
     public String GetPublisherURL(int tabId) {
         synchronized(lock) {
             return BraveRewardsNativeWorkerJni.get().getPublisherURL(
@@ -625,6 +642,7 @@ public class BraveRewardsNativeWorker {
         String getWalletBalance(long nativeBraveRewardsNativeWorker);
         double getWalletRate(long nativeBraveRewardsNativeWorker);
         void getPublisherInfo(long nativeBraveRewardsNativeWorker, int tabId, String host);
+        String getPublisherPanelInfo(long nativeBraveRewardsNativeWorker, int tabId);
         String getPublisherURL(long nativeBraveRewardsNativeWorker, int tabId);
         String getPublisherFavIconURL(long nativeBraveRewardsNativeWorker, int tabId);
         String getPublisherName(long nativeBraveRewardsNativeWorker, int tabId);
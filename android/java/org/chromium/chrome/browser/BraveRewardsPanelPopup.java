@@ -1431,7 +1431,13 @@ public class BraveRewardsPanelPopup implements BraveRewardsObserver, BraveReward
             btRewardsSummary.setClickable(true);
         }
 
-        String publisherFavIconURL = mBraveRewardsNativeWorker.GetPublisherFavIconURL(currentTabId);
+        BraveRewardsPublisher publisher =
+                mBraveRewardsNativeWorker.GetPublisherPanelInfo(currentTabId);
+        if (publisher == null) {
+            return;
+        }
+
+        String publisherFavIconURL = publisher.getFavIconUrl();
         Tab currentActiveTab = BraveRewardsHelper.currentActiveChromeTabbedActivityTab();
         String url = currentActiveTab.getUrl().getSpec();
         final String favicon_url = (publisherFavIconURL.isEmpty()) ? url : publisherFavIconURL;
@@ -1443,8 +1449,8 @@ public class BraveRewardsPanelPopup implements BraveRewardsObserver, BraveReward
         LinearLayout ll = (LinearLayout) this.root.findViewById(R.id.br_central_layout);
         ll.setBackgroundColor(Color.WHITE);
 
-        String pubName = thisObject.mBraveRewardsNativeWorker.GetPublisherName(currentTabId);
-        String pubId = thisObject.mBraveRewardsNativeWorker.GetPublisherId(currentTabId);
+        String pubName = publisher.getName();
+        String pubId = publisher.getId();
         String pubSuffix = "";
         if (pubId.startsWith(YOUTUBE_TYPE)) {
             pubSuffix = thisObject.root.getResources().getString(R.string.brave_ui_on_youtube);
@@ -1455,19 +1461,15 @@ public class BraveRewardsPanelPopup implements BraveRewardsObserver, BraveReward
         TextView tv = (TextView) thisObject.root.findViewById(R.id.publisher_name);
         tv.setText(Html.fromHtml(pubName));
         tv = (TextView) thisObject.root.findViewById(R.id.publisher_attention);
-        String percent = Integer.toString(thisObject.mBraveRewardsNativeWorker.GetPublisherPercent(
-                                 currentTabId))
-                + "%";
+        String percent = Integer.toString(publisher.getPercent()) + "%";
         tv.setText(percent);
         if (btAutoContribute != null) {
             btAutoContribute.setOnCheckedChangeListener(null);
-            btAutoContribute.setChecked(
-                    !thisObject.mBraveRewardsNativeWorker.GetPublisherExcluded(currentTabId));
+            btAutoContribute.setChecked(!publisher.isExcluded());
             btAutoContribute.setOnCheckedChangeListener(autoContributeSwitchListener);
         }
 
-        UpdatePublisherStatus(
-                thisObject.mBraveRewardsNativeWorker.GetPublisherStatus(currentTabId));
+        UpdatePublisherStatus(publisher.getStatus());
 
         tv = (TextView) root.findViewById(R.id.br_no_activities_yet);
         gl = (GridLayout) thisObject.root.findViewById(R.id.br_activities);
@@ -1475,8 +1477,9 @@ public class BraveRewardsPanelPopup implements BraveRewardsObserver, BraveReward
             tv.setVisibility(View.GONE);
             gl.setVisibility(View.GONE);
         }
-        thisObject.mBraveRewardsNativeWorker.GetRecurringDonations();
 
+        // Recurring donations are fetched once the auto contribute properties
+        // arrive, since the panel needs both.
         mBraveRewardsNativeWorker.GetAutoContributeProperties();
     }
 
@@ -9,6 +9,9 @@ import androidx.annotation.IntDef;
 import java.lang.annotation.Retention;
 import java.lang.annotation.RetentionPolicy;
 
+import org.json.JSONException;
+import org.json.JSONObject;
+
 class BraveRewardsPublisher {
     //PublisherStatus @
     //vendor/bat-native-ledger/include/bat/ledger/public/interfaces/ledger.mojom
@@ -20,4 +23,63 @@ class BraveRewardsPublisher {
     public static final int UPHOLD_VERIFIED = 2;
     public static final int BITFLYER_VERIFIED = 3;
     public static final int GEMINI_VERIFIED = 4;
+
+    /**
+     * matching keys in BraveRewardsNativeWorker::GetPublisherPanelInfo
+     */
+    public static final String JSON_ID = "id";
+    public static final String JSON_NAME = "name";
+    public static final String JSON_URL = "url";
+    public static final String JSON_FAVICON_URL = "favicon_url";
+    public static final String JSON_PERCENT = "percent";
+    public static final String JSON_EXCLUDED = "excluded";
+    public static final String JSON_STATUS = "status";
+
+    private String mId;
+    private String mName;
+    private String mUrl;
+    private String mFavIconUrl;
+    private int mPercent;
+    private boolean mExcluded;
+    @PublisherStatus
+    private int mStatus;
+
+    BraveRewardsPublisher(String json_publisher) throws JSONException {
+        JSONObject jsonroot = new JSONObject(json_publisher);
+        mId = jsonroot.getString(JSON_ID);
+        mName = jsonroot.getString(JSON_NAME);
+        mUrl = jsonroot.getString(JSON_URL);
+        mFavIconUrl = jsonroot.getString(JSON_FAVICON_URL);
+        mPercent = jsonroot.getInt(JSON_PERCENT);
+        mExcluded = jsonroot.getBoolean(JSON_EXCLUDED);
+        mStatus = jsonroot.getInt(JSON_STATUS);
+    }
+
+    public String getId() {
+        return mId;
+    }
+
+    public String getName() {
+        return mName;
+    }
+
+    public String getUrl() {
+        return mUrl;
+    }
+
+    public String getFavIconUrl() {
+        return mFavIconUrl;
+    }
+
+    public int getPercent() {
+        return mPercent;
+    }
+
+    public boolean isExcluded() {
+        return mExcluded;
+    }
+
+    public @PublisherStatus int getStatus() {
+        return mStatus;
+    }
 }
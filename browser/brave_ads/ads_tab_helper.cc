@@ -66,10 +66,21 @@ void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
+  if (!ads_service_ || !ads_service_->IsEnabled()) {
+    return;
+  }
+
+  // Page HTML is only used to match conversions, so don't serialize the
+  // document when conversion tracking is disallowed. The redirect chain is
+  // still needed for ad transfers.
+  if (ads_service_->ShouldAllowConversionTracking()) {
+    dom_distiller::RunIsolatedJavaScript(
+        render_frame_host, "new XMLSerializer().serializeToString(document)",
+        base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
+                       weak_factory_.GetWeakPtr()));
+  } else {
+    ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, /* html */ "");
+  }
 
   dom_distiller::RunIsolatedJavaScript(
       render_frame_host, "document?.body?.innerText",
@@ -8,8 +8,13 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/command_line.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/path_service.h"
+#include "base/strings/strcat.h"
 #include "base/task/post_task.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_shields/ad_block_subscription_download_manager_getter.h"
 #include "brave/browser/brave_stats/brave_stats_updater.h"
 #include "brave/browser/component_updater/brave_component_updater_configurator.h"
@@ -39,10 +44,12 @@
 #include "brave/components/p3a/buildflags.h"
 #include "brave/components/p3a/histograms_braveizer.h"
 #include "brave/services/network/public/cpp/system_request_handler.h"
+#include "chrome/browser/after_startup_task_utils.h"
 #include "chrome/browser/component_updater/component_updater_utils.h"
 #include "chrome/browser/net/system_network_context_manager.h"
 #include "chrome/common/buildflags.h"
 #include "chrome/common/chrome_paths.h"
+#include "chrome/common/chrome_switches.h"
 #include "components/component_updater/component_updater_service.h"
 #include "components/component_updater/timer_update_scheduler.h"
 #include "content/public/browser/browser_thread.h"
@@ -66,6 +73,7 @@
 #if BUILDFLAG(ENABLE_TOR)
 #include "brave/components/tor/brave_tor_client_updater.h"
 #include "brave/components/tor/pref_names.h"
+#include "brave/components/tor/tor_prelauncher.h"
 #endif
 
 #if BUILDFLAG(ENABLE_IPFS)
@@ -99,6 +107,33 @@ void InitSystemRequestHandlerCallback() {
       ->RegisterOnBeforeSystemRequestCallback(before_system_request_callback);
 }
 
+// Traces one step of StartBraveServices and records how long it took and how
+// long after StartBraveServices it finished.
+class ScopedStartupStep {
+ public:
+  ScopedStartupStep(const char* name, base::TimeTicks services_start_time)
+      : name_(name), services_start_time_(services_start_time) {
+    TRACE_EVENT_BEGIN1("startup", "BraveBrowserProcessImpl::StartupStep",
+                       "name", name_);
+  }
+  ~ScopedStartupStep() {
+    TRACE_EVENT_END0("startup", "BraveBrowserProcessImpl::StartupStep");
+    base::UmaHistogramTimes(
+        base::StrCat({"Brave.Startup.ServiceStartTime.", name_}),
+        timer_.Elapsed());
+    base::UmaHistogramMediumTimes(
+        base::StrCat({"Brave.Startup.TimeToServiceStart.", name_}),
+        base::TimeTicks::Now() - services_start_time_);
+  }
+  ScopedStartupStep(const ScopedStartupStep&) = delete;
+  ScopedStartupStep& operator=(const ScopedStartupStep&) = delete;
+
+ private:
+  const char* const name_;
+  const base::TimeTicks services_start_time_;
+  const base::ElapsedTimer timer_;
+};
+
 }  // namespace
 
 using content::BrowserThread;
@@ -171,12 +206,51 @@ ProfileManager* BraveBrowserProcessImpl::profile_manager() {
 
 void BraveBrowserProcessImpl::StartBraveServices() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT0("startup", "BraveBrowserProcessImpl::StartBraveServices");
+  brave_services_start_time_ = base::TimeTicks::Now();
+
+  // Only what the first navigation needs starts now: the ad block engine.
+  {
+    ScopedStartupStep step("AdBlock", brave_services_start_time_);
+    ad_block_service()->Start();
+  }
+
+  brave_sync::NetworkTimeHelper::GetInstance()->SetNetworkTimeTracker(
+      g_browser_process->network_time_tracker());
+
+  // Tests expect every service to be running once the browser is up.
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(switches::kTestType)) {
+    StartDeferredBraveServices();
+    return;
+  }
+
+  // The rest would compete with the first window for the file and component
+  // task runners, so wait until it has painted.
+  AfterStartupTaskUtils::PostTask(
+      FROM_HERE, content::GetUIThreadTaskRunner({}),
+      base::BindOnce(&BraveBrowserProcessImpl::StartDeferredBraveServices,
+                     base::Unretained(this)));
+}
+
+void BraveBrowserProcessImpl::StartDeferredBraveServices() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  TRACE_EVENT0("startup",
+               "BraveBrowserProcessImpl::StartDeferredBraveServices");
 
-  ad_block_service()->Start();
-  https_everywhere_service()->Start();
-  brave_federated_learning_service()->Start();
-  resource_component();
+  {
+    ScopedStartupStep step("HTTPSEverywhere", brave_services_start_time_);
+    https_everywhere_service()->Start();
+  }
+  {
+    ScopedStartupStep step("FederatedLearning", brave_services_start_time_);
+    brave_federated_learning_service()->Start();
+  }
+  {
+    ScopedStartupStep step("AdsResourceComponent", brave_services_start_time_);
+    resource_component();
+  }
 
+  // Observers of the local data files service have to exist before it starts.
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   extension_whitelist_service();
 #endif
@@ -188,10 +262,10 @@ void BraveBrowserProcessImpl::StartBraveServices() {
   speedreader_rewriter_service();
 #endif
   // Now start the local data files service, which calls all observers.
-  local_data_files_service()->Start();
-
-  brave_sync::NetworkTimeHelper::GetInstance()->SetNetworkTimeTracker(
-      g_browser_process->network_time_tracker());
+  {
+    ScopedStartupStep step("LocalDataFiles", brave_services_start_time_);
+    local_data_files_service()->Start();
+  }
 }
 
 brave_shields::AdBlockService* BraveBrowserProcessImpl::ad_block_service() {
@@ -202,7 +276,8 @@ brave_shields::AdBlockService* BraveBrowserProcessImpl::ad_block_service() {
             brave_component_updater_delegate(),
             AdBlockSubscriptionDownloadManagerGetter(),
             profile_manager()->user_data_dir().Append(
-                profile_manager()->GetInitialProfileDir())));
+                profile_manager()->GetInitialProfileDir())),
+        profile_manager()->user_data_dir().AppendASCII("AdBlockSnapshot"));
   }
   return ad_block_service_.get();
 }
@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -60,6 +61,7 @@ class NTPBackgroundImagesService;
 
 namespace tor {
 class BraveTorClientUpdater;
+class TorPrelauncher;
 }
 
 namespace ipfs {
@@ -135,6 +137,10 @@ class BraveBrowserProcessImpl : public BraveBrowserProcess,
   void UpdateBraveDarkMode();
   void OnBraveDarkModeChanged();
 
+  // The part of StartBraveServices that can wait until after the first window
+  // has painted.
+  void StartDeferredBraveServices();
+
   brave_component_updater::BraveComponent::Delegate*
   brave_component_updater_delegate();
 
@@ -163,6 +169,7 @@ class BraveBrowserProcessImpl : public BraveBrowserProcess,
 #endif
 #if BUILDFLAG(ENABLE_TOR)
   std::unique_ptr<tor::BraveTorClientUpdater> tor_client_updater_;
+  std::unique_ptr<tor::TorPrelauncher> tor_prelauncher_;
 #endif
 #if BUILDFLAG(ENABLE_IPFS)
   std::unique_ptr<ipfs::BraveIpfsClientUpdater> ipfs_client_updater_;
@@ -180,6 +187,8 @@ class BraveBrowserProcessImpl : public BraveBrowserProcess,
       speedreader_rewriter_service_;
 #endif
 
+  base::TimeTicks brave_services_start_time_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   DISALLOW_COPY_AND_ASSIGN(BraveBrowserProcessImpl);
@@ -18,6 +18,7 @@
 #include "brave/browser/brave_browser_main_extra_parts.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/brave_shields/preconnect_filtering_hints_handler.h"
 #include "brave/browser/debounce/debounce_service_factory.h"
 #include "brave/browser/ethereum_remote_client/buildflags/buildflags.h"
 #include "brave/browser/net/brave_proxying_url_loader_factory.h"
@@ -32,9 +33,11 @@
 #include "brave/components/brave_search/browser/brave_search_default_host.h"
 #include "brave/components/brave_search/browser/brave_search_default_host_private.h"
 #include "brave/components/brave_search/browser/brave_search_fallback_host.h"
+#include "brave/components/brave_search/browser/brave_search_fallback_prefetcher.h"
 #include "brave/components/brave_search/common/brave_search_default.mojom.h"
 #include "brave/components/brave_search/common/brave_search_fallback.mojom.h"
 #include "brave/components/brave_search/common/brave_search_utils.h"
+#include "brave/components/brave_search/common/features.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/domain_block_navigation_throttle.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -63,6 +66,7 @@
 #include "chrome/common/url_constants.h"
 #include "components/content_settings/browser/page_specific_content_settings.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/network_hints/common/network_hints.mojom.h"
 #include "components/prefs/pref_service.h"
 #include "components/services/heap_profiling/public/mojom/heap_profiling_client.mojom.h"
 #include "components/user_prefs/user_prefs.h"
@@ -128,7 +132,10 @@ using extensions::ChromeContentBrowserClientExtensionsPart;
 #endif
 
 #if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/browser/speedreader/speedreader_service_factory.h"
 #include "brave/browser/speedreader/speedreader_tab_helper.h"
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
+#include "brave/components/speedreader/speedreader_service.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #endif
@@ -248,6 +255,17 @@ void MaybeBindBraveWalletProvider(
 }
 #endif
 
+base::WeakPtr<brave_search::BraveSearchFallbackPrefetcher>
+GetBraveSearchFallbackPrefetcher(content::BrowserContext* context) {
+  if (!base::FeatureList::IsEnabled(
+          brave_search::features::kBraveSearchFallbackPrefetchFeature))
+    return nullptr;
+  return brave_search::BraveSearchFallbackPrefetcher::GetOrCreate(
+             context, context->GetDefaultStoragePartition()
+                          ->GetURLLoaderFactoryForBrowserProcess())
+      ->AsWeakPtr();
+}
+
 void BindBraveSearchFallbackHost(
     int process_id,
     mojo::PendingReceiver<brave_search::mojom::BraveSearchFallback> receiver) {
@@ -260,7 +278,8 @@ void BindBraveSearchFallbackHost(
   mojo::MakeSelfOwnedReceiver(
       std::make_unique<brave_search::BraveSearchFallbackHost>(
           context->GetDefaultStoragePartition()
-              ->GetURLLoaderFactoryForBrowserProcess()),
+              ->GetURLLoaderFactoryForBrowserProcess(),
+          GetBraveSearchFallbackPrefetcher(context)),
       std::move(receiver));
 }
 
@@ -384,6 +403,12 @@ void BraveContentBrowserClient::RegisterBrowserInterfaceBindersForFrame(
       render_frame_host, map);
   map->Add<cosmetic_filters::mojom::CosmeticFiltersResources>(
       base::BindRepeating(&BindCosmeticFiltersResources));
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockPreconnectFiltering)) {
+    // Replaces the handler registered by Chrome above.
+    map->Add<network_hints::mojom::NetworkHintsHandler>(base::BindRepeating(
+        &brave_shields::PreconnectFilteringHintsHandler::Create));
+  }
   if (brave_search::IsDefaultAPIEnabled()) {
     map->Add<brave_search::mojom::BraveSearchDefault>(
         base::BindRepeating(&BindBraveSearchDefaultHost));
@@ -524,9 +549,16 @@ BraveContentBrowserClient::CreateURLLoaderThrottles(
       // Only check for disabled sites if we are in Speedreader mode
       const bool check_disabled_sites =
           state == DistillState::kSpeedreaderModePending;
+      base::WeakPtr<speedreader::SpeedreaderDistilledCache> distilled_cache;
+      auto* speedreader_service =
+          speedreader::SpeedreaderServiceFactory::GetForProfile(
+              Profile::FromBrowserContext(browser_context));
+      if (speedreader_service && speedreader_service->distilled_cache())
+        distilled_cache = speedreader_service->distilled_cache()->GetWeakPtr();
       std::unique_ptr<speedreader::SpeedReaderThrottle> throttle =
           speedreader::SpeedReaderThrottle::MaybeCreateThrottleFor(
               g_brave_browser_process->speedreader_rewriter_service(),
+              distilled_cache,
               HostContentSettingsMapFactory::GetForProfile(
                   Profile::FromBrowserContext(browser_context)),
               tab_helper->GetWeakPtr(), request.url, check_disabled_sites,
@@ -764,6 +796,14 @@ BraveContentBrowserClient::CreateThrottlesForNavigation(
               g_browser_process->GetApplicationLocale()))
     throttles.push_back(std::move(domain_block_navigation_throttle));
 
+  // Not a throttle: gets the backup results for a Brave Search query going
+  // while the results page loads.
+  if (handle->IsInMainFrame() &&
+      brave_search::IsAllowedHost(handle->GetURL())) {
+    if (auto prefetcher = GetBraveSearchFallbackPrefetcher(context))
+      prefetcher->Prefetch(handle->GetURL());
+  }
+
   return throttles;
 }
 
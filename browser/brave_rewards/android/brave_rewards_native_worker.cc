@@ -16,6 +16,7 @@
 #include "base/containers/flat_map.h"
 #include "base/json/json_writer.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "brave/build/android/jni_headers/BraveRewardsNativeWorker_jni.h"
@@ -101,6 +102,37 @@ void BraveRewardsNativeWorker::OnPanelPublisherInfo(
         weak_java_brave_rewards_native_worker_.get(env), tabId);
 }
 
+base::android::ScopedJavaLocalRef<jstring>
+BraveRewardsNativeWorker::GetPublisherPanelInfo(JNIEnv* env, uint64_t tabId) {
+  // Same defaults as the single field getters below.
+  base::Value json_root(base::Value::Type::DICTIONARY);
+  json_root.SetStringKey("id", "");
+  json_root.SetStringKey("name", "");
+  json_root.SetStringKey("url", "");
+  json_root.SetStringKey("favicon_url", "");
+  json_root.SetIntKey("percent", 0);
+  json_root.SetBoolKey("excluded", false);
+  json_root.SetIntKey(
+      "status", static_cast<int>(ledger::type::PublisherStatus::NOT_VERIFIED));
+
+  PublishersInfoMap::const_iterator iter(map_publishers_info_.find(tabId));
+  if (iter != map_publishers_info_.end()) {
+    const ledger::type::PublisherInfoPtr& info = iter->second;
+    json_root.SetStringKey("id", info->id);
+    json_root.SetStringKey("name", info->name);
+    json_root.SetStringKey("url", info->url);
+    json_root.SetStringKey("favicon_url", info->favicon_url);
+    json_root.SetIntKey("percent", info->percent);
+    json_root.SetBoolKey(
+        "excluded", info->excluded == ledger::type::PublisherExclude::EXCLUDED);
+    json_root.SetIntKey("status", static_cast<int>(info->status));
+  }
+
+  std::string json_publisher;
+  base::JSONWriter::Write(json_root, &json_publisher);
+  return base::android::ConvertUTF8ToJavaString(env, json_publisher);
+}
+
 base::android::ScopedJavaLocalRef<jstring>
 BraveRewardsNativeWorker::GetPublisherURL(JNIEnv* env, uint64_t tabId) {
   base::android::ScopedJavaLocalRef<jstring> res =
@@ -49,6 +49,12 @@ class BraveRewardsNativeWorker : public brave_rewards::RewardsServiceObserver,
 
     double GetWalletRate(JNIEnv* env);
 
+    // The panel's view of the publisher of |tabId| as a JSON dictionary, so
+    // the panel doesn't need a JNI call per field.
+    base::android::ScopedJavaLocalRef<jstring> GetPublisherPanelInfo(
+        JNIEnv* env,
+        uint64_t tabId);
+
     base::android::ScopedJavaLocalRef<jstring> GetPublisherURL(JNIEnv* env,
                                                                uint64_t tabId);
 
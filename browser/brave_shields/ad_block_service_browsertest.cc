@@ -15,6 +15,7 @@
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -40,6 +41,7 @@
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "content/public/test/test_utils.h"
 #include "extensions/test/extension_test_message_listener.h"
 #include "net/dns/mock_host_resolver.h"
 #include "services/network/host_resolver.h"
@@ -75,10 +77,13 @@ using brave_shields::features::kBraveAdblockCnameUncloaking;
 using brave_shields::features::kBraveAdblockCollapseBlockedElements;
 using brave_shields::features::kBraveAdblockCosmeticFiltering;
 using brave_shields::features::kBraveAdblockDefault1pBlocking;
+using brave_shields::features::kBraveAdblockEngineSnapshot;
 
 void AdBlockServiceTest::SetUpOnMainThread() {
   ExtensionBrowserTest::SetUpOnMainThread();
   host_resolver()->AddRule("*", "127.0.0.1");
+  brave_shields::BraveShieldsWebContentsObserver::
+      SetFlushBlockedCountsImmediatelyForTesting(true);
 }
 
 void AdBlockServiceTest::SetUp() {
@@ -1988,3 +1993,39 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringIframeScriptlet) {
 
   ASSERT_EQ(true, EvalJs(contents, "show_ad"));
 }
+
+class EngineSnapshotFlagEnabledTest : public AdBlockServiceTest {
+ public:
+  EngineSnapshotFlagEnabledTest() {
+    feature_list_.InitAndEnableFeature(kBraveAdblockEngineSnapshot);
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+IN_PROC_BROWSER_TEST_F(EngineSnapshotFlagEnabledTest,
+                       PRE_AdsGetBlockedBeforeComponentIsReady) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  // Let the snapshot be written.
+  content::RunAllTasksUntilIdle();
+}
+
+// The engine loaded in the PRE_ test blocks ads after a restart, before the
+// component is ready again.
+IN_PROC_BROWSER_TEST_F(EngineSnapshotFlagEnabledTest,
+                       AdsGetBlockedBeforeComponentIsReady) {
+  content::RunAllTasksUntilIdle();
+  WaitForAdBlockServiceThreads();
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
+
+  GURL url = embedded_test_server()->GetURL(kAdBlockTestPage);
+  ui_test_utils::NavigateToURL(browser(), url);
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "setExpectations(0, 1, 0, 0);"
+                         "addImage('ad_banner.png')"));
+  EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 1ULL);
+}
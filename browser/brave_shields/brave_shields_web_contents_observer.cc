@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
@@ -49,6 +50,13 @@ namespace brave_shields {
 namespace {
 
 BraveShieldsWebContentsObserver* g_receiver_impl_for_testing = nullptr;
+bool g_flush_blocked_counts_immediately_for_testing = false;
+
+// Blocked resource counts are added to the profile prefs at most this long
+// after they happen, so that a page blocking hundreds of resources causes a
+// handful of pref writes rather than one per resource.
+constexpr base::TimeDelta kFlushBlockedCountsDelay =
+    base::TimeDelta::FromSeconds(5);
 
 // Content Settings are only sent to the main frame currently. Chrome may fix
 // this at some point, but for now we do this as a work-around. You can verify
@@ -144,6 +152,38 @@ void BraveShieldsWebContentsObserver::BindBraveShieldsHost(
   shields_host->BindReceiver(std::move(receiver), rfh);
 }
 
+void BraveShieldsWebContentsObserver::CountBlockedResource(
+    const char* pref_name) {
+  ++pending_blocked_counts_[pref_name];
+  if (g_flush_blocked_counts_immediately_for_testing) {
+    FlushBlockedCounts();
+    return;
+  }
+
+  if (!flush_blocked_counts_timer_.IsRunning()) {
+    flush_blocked_counts_timer_.Start(
+        FROM_HERE, kFlushBlockedCountsDelay,
+        base::BindOnce(&BraveShieldsWebContentsObserver::FlushBlockedCounts,
+                       base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedCounts() {
+  flush_blocked_counts_timer_.Stop();
+  if (pending_blocked_counts_.empty())
+    return;
+
+  PrefService* prefs =
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext())
+          ->GetOriginalProfile()
+          ->GetPrefs();
+  for (const auto& pending : pending_blocked_counts_) {
+    prefs->SetUint64(pending.first,
+                     prefs->GetUint64(pending.first) + pending.second);
+  }
+  pending_blocked_counts_.clear();
+}
+
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     const GURL& request_url,
@@ -161,21 +201,15 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         BraveShieldsWebContentsObserver::FromWebContents(web_contents);
     if (observer && !observer->IsBlockedSubresource(subresource)) {
       observer->AddBlockedSubresource(subresource);
-      PrefService* prefs =
-          Profile::FromBrowserContext(web_contents->GetBrowserContext())
-              ->GetOriginalProfile()
-              ->GetPrefs();
 
       if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
+        observer->CountBlockedResource(kAdsBlocked);
       } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
+        observer->CountBlockedResource(kHttpsUpgrades);
       } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-                         prefs->GetUint64(kJavascriptBlocked) + 1);
+        observer->CountBlockedResource(kJavascriptBlocked);
       } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-                         prefs->GetUint64(kFingerprintingBlocked) + 1);
+        observer->CountBlockedResource(kFingerprintingBlocked);
       }
     }
   }
@@ -237,6 +271,7 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    FlushBlockedCounts();
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
@@ -256,6 +291,14 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   }
 }
 
+void BraveShieldsWebContentsObserver::DidStopLoading() {
+  FlushBlockedCounts();
+}
+
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedCounts();
+}
+
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
     const std::vector<std::string>& origins,
     WebContents* contents) {
@@ -268,6 +311,12 @@ void BraveShieldsWebContentsObserver::SetReceiverImplForTesting(
   g_receiver_impl_for_testing = impl;
 }
 
+// static
+void BraveShieldsWebContentsObserver::
+    SetFlushBlockedCountsImmediatelyForTesting(bool flush_immediately) {
+  g_flush_blocked_counts_immediately_for_testing = flush_immediately;
+}
+
 void BraveShieldsWebContentsObserver::BindReceiver(
     mojo::PendingAssociatedReceiver<brave_shields::mojom::BraveShieldsHost>
         receiver,
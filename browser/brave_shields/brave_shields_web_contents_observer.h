@@ -14,6 +14,7 @@
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "content/public/browser/render_frame_host_receiver_set.h"
 #include "content/public/browser/web_contents_observer.h"
@@ -53,6 +54,14 @@ class BraveShieldsWebContentsObserver
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Adds one to the profile pref |pref_name| the next time the counts for
+  // this tab are flushed.
+  void CountBlockedResource(const char* pref_name);
+
+  // Makes blocked resource counts reach the prefs as soon as they happen, for
+  // tests that check the prefs right after a resource is blocked.
+  static void SetFlushBlockedCountsImmediatelyForTesting(
+      bool flush_immediately);
 
  protected:
   // content::WebContentsObserver overrides.
@@ -62,6 +71,8 @@ class BraveShieldsWebContentsObserver
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void DidStopLoading() override;
+  void WebContentsDestroyed() override;
 
   // brave_shields::mojom::BraveShieldsHost.
   void OnJavaScriptBlocked(const std::u16string& details) override;
@@ -90,10 +101,18 @@ class BraveShieldsWebContentsObserver
   mojo::AssociatedRemote<brave_shields::mojom::BraveShields>&
   GetBraveShieldsRemote(content::RenderFrameHost* rfh);
 
+  // Adds the blocked resource counts kept since the last flush to the profile
+  // prefs. Runs when a page stops loading or navigates away, when the tab
+  // closes, and on a timer for pages that keep loading resources.
+  void FlushBlockedCounts();
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
+  // Blocked resource counts by pref name, not yet added to the prefs.
+  base::flat_map<const char*, uint64_t> pending_blocked_counts_;
+  base::OneShotTimer flush_blocked_counts_timer_;
 
   content::RenderFrameHostReceiverSet<brave_shields::mojom::BraveShieldsHost>
       receivers_;
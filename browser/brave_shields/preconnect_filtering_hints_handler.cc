@@ -0,0 +1,124 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_shields/preconnect_filtering_hints_handler.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/trace_event/trace_event.h"
+#include "brave/browser/brave_browser_process.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/network_hints/browser/simple_network_hints_handler_impl.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/origin.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Runs on the adblock task runner. Goes through the decision cache like any
+// other request, so repeated hints for the same host are cheap.
+bool ShouldBlockPreconnectOnTaskRunner(const GURL& origin_url,
+                                       const std::string& tab_host,
+                                       bool aggressive_blocking) {
+  TRACE_EVENT0("browser", "ShouldBlockPreconnectOnTaskRunner");
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+  g_brave_browser_process->ad_block_service()->ShouldStartRequest(
+      origin_url, blink::mojom::ResourceType::kSubResource, tab_host,
+      aggressive_blocking, &did_match_rule, &did_match_exception,
+      &did_match_important, &mock_data_url);
+  return did_match_important || (did_match_rule && !did_match_exception);
+}
+
+}  // namespace
+
+PreconnectFilteringHintsHandler::PreconnectFilteringHintsHandler(
+    content::RenderFrameHost* frame_host)
+    : render_process_id_(frame_host->GetProcess()->GetID()),
+      render_frame_id_(frame_host->GetRoutingID()) {
+  network_hints::SimpleNetworkHintsHandlerImpl::Create(
+      frame_host, upstream_.BindNewPipeAndPassReceiver());
+}
+
+PreconnectFilteringHintsHandler::~PreconnectFilteringHintsHandler() = default;
+
+// static
+void PreconnectFilteringHintsHandler::Create(
+    content::RenderFrameHost* frame_host,
+    mojo::PendingReceiver<network_hints::mojom::NetworkHintsHandler>
+        receiver) {
+  mojo::MakeSelfOwnedReceiver(
+      std::make_unique<PreconnectFilteringHintsHandler>(frame_host),
+      std::move(receiver));
+}
+
+void PreconnectFilteringHintsHandler::PrefetchDNS(
+    const std::vector<std::string>& names) {
+  upstream_->PrefetchDNS(names);
+}
+
+void PreconnectFilteringHintsHandler::Preconnect(const GURL& url,
+                                                 bool allow_credentials) {
+  content::RenderFrameHost* frame_host =
+      content::RenderFrameHost::FromID(render_process_id_, render_frame_id_);
+  if (!frame_host)
+    return;
+
+  // Upstream rejects anything that isn't http(s) itself, and first-party
+  // hosts are left to the page.
+  const GURL tab_origin =
+      frame_host->GetMainFrame()->GetLastCommittedOrigin().GetURL();
+  if (!url.SchemeIsHTTPOrHTTPS() || !tab_origin.SchemeIsHTTPOrHTTPS() ||
+      net::registry_controlled_domains::SameDomainOrHost(
+          url, tab_origin,
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+    upstream_->Preconnect(url, allow_credentials);
+    return;
+  }
+
+  auto* map = HostContentSettingsMapFactory::GetForProfile(
+      Profile::FromBrowserContext(frame_host->GetBrowserContext()));
+  if (!GetBraveShieldsEnabled(map, tab_origin) ||
+      GetAdControlType(map, tab_origin) == ControlType::ALLOW) {
+    upstream_->Preconnect(url, allow_credentials);
+    return;
+  }
+  // See BraveRequestInfo for why aggressive mode is a cosmetic setting.
+  const bool aggressive_blocking =
+      GetCosmeticFilteringControlType(map, tab_origin) == ControlType::BLOCK;
+
+  g_brave_browser_process->ad_block_service()
+      ->GetTaskRunner()
+      ->PostTaskAndReplyWithResult(
+          FROM_HERE,
+          base::BindOnce(&ShouldBlockPreconnectOnTaskRunner, url.GetOrigin(),
+                         tab_origin.host(), aggressive_blocking),
+          base::BindOnce(&PreconnectFilteringHintsHandler::OnAdBlockDecision,
+                         weak_factory_.GetWeakPtr(), url, allow_credentials));
+}
+
+void PreconnectFilteringHintsHandler::OnAdBlockDecision(
+    const GURL& url,
+    bool allow_credentials,
+    bool should_block) {
+  if (should_block)
+    return;
+  upstream_->Preconnect(url, allow_credentials);
+}
+
+}  // namespace brave_shields
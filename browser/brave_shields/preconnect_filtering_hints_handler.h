@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_BRAVE_SHIELDS_PRECONNECT_FILTERING_HINTS_HANDLER_H_
+#define BRAVE_BROWSER_BRAVE_SHIELDS_PRECONNECT_FILTERING_HINTS_HANDLER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "components/network_hints/common/network_hints.mojom.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "url/gurl.h"
+
+namespace content {
+class RenderFrameHost;
+}  // namespace content
+
+namespace brave_shields {
+
+// Sits in front of the upstream network hints handler of a frame and drops
+// preconnects to hosts that adblock would block from the page, so that no
+// socket is opened to a tracker the page can't load from anyway. DNS
+// prefetches are passed through unchanged.
+//
+// Only the origin of a preconnect is known, so the decision is made for a
+// request to the root of that origin; rules that block particular paths on
+// an otherwise allowed host don't stop the preconnect.
+class PreconnectFilteringHintsHandler
+    : public network_hints::mojom::NetworkHintsHandler {
+ public:
+  explicit PreconnectFilteringHintsHandler(
+      content::RenderFrameHost* frame_host);
+  ~PreconnectFilteringHintsHandler() override;
+  PreconnectFilteringHintsHandler(const PreconnectFilteringHintsHandler&) =
+      delete;
+  PreconnectFilteringHintsHandler& operator=(
+      const PreconnectFilteringHintsHandler&) = delete;
+
+  static void Create(
+      content::RenderFrameHost* frame_host,
+      mojo::PendingReceiver<network_hints::mojom::NetworkHintsHandler>
+          receiver);
+
+  // network_hints::mojom::NetworkHintsHandler:
+  void PrefetchDNS(const std::vector<std::string>& names) override;
+  void Preconnect(const GURL& url, bool allow_credentials) override;
+
+ private:
+  void OnAdBlockDecision(const GURL& url,
+                         bool allow_credentials,
+                         bool should_block);
+
+  const int render_process_id_;
+  const int render_frame_id_;
+  mojo::Remote<network_hints::mojom::NetworkHintsHandler> upstream_;
+  base::WeakPtrFactory<PreconnectFilteringHintsHandler> weak_factory_{this};
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_BROWSER_BRAVE_SHIELDS_PRECONNECT_FILTERING_HINTS_HANDLER_H_
@@ -0,0 +1,158 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/brave_shields/ad_block_service_browsertest.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
+#include "chrome/test/base/ui_test_utils.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/common/content_switches.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/browser_test_utils.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// Loads a page with a news-site-like mix of first party, ad and tracker
+// requests with shields at their defaults, set to aggressive and turned off,
+// so the cost of the whole shields pipeline shows up as a difference between
+// the three stories.
+
+namespace {
+
+const char kMetricPrefix[] = "ShieldsPageLoad.";
+const char kMetricLoadTime[] = "page_load_time";
+const char kMetricDOMContentLoaded[] = "dom_content_loaded";
+const char kMetricLoadEvent[] = "load_event";
+const char kMetricBrowserCPUTime[] = "browser_cpu_time";
+const char kMetricJSHeapSize[] = "js_heap_size";
+const char kMetricAdsBlocked[] = "ads_blocked";
+
+const char kPerfTestPage[] = "/shields_perf.html";
+
+const char kRules[] =
+    "||ads.example.com^$third-party\n"
+    "||tracker.example.com^$third-party\n"
+    "##.ad-slot\n";
+
+// The first load of each story warms up the renderer and isn't reported.
+constexpr int kLoadIterations = 5;
+
+}  // namespace
+
+class ShieldsPageLoadPerfTest : public AdBlockServiceTest {
+ public:
+  ShieldsPageLoadPerfTest() {}
+
+  void SetUpCommandLine(base::CommandLine* command_line) override {
+    AdBlockServiceTest::SetUpCommandLine(command_line);
+    command_line->AppendSwitch(switches::kEnablePreciseMemoryInfo);
+  }
+
+  void SetUpOnMainThread() override {
+    AdBlockServiceTest::SetUpOnMainThread();
+    UpdateAdBlockInstanceWithRules(kRules);
+  }
+
+ protected:
+  // Loads the test page repeatedly and reports the averages under |story|.
+  void RunStory(const std::string& story) {
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    PrefService* prefs = browser()->profile()->GetPrefs();
+    std::unique_ptr<base::ProcessMetrics> browser_metrics =
+        base::ProcessMetrics::CreateCurrentProcessMetrics();
+
+    ui_test_utils::NavigateToURL(browser(), GetPageURL(story, 0));
+
+    double load_time = 0;
+    double dom_content_loaded = 0;
+    double load_event = 0;
+    double browser_cpu_time = 0;
+    double js_heap_size = 0;
+    double ads_blocked = 0;
+    for (int i = 1; i <= kLoadIterations; ++i) {
+      const uint64_t ads_blocked_before = prefs->GetUint64(kAdsBlocked);
+      const base::TimeDelta cpu_before =
+          browser_metrics->GetCumulativeCPUUsage();
+      base::ElapsedTimer timer;
+      ui_test_utils::NavigateToURL(browser(), GetPageURL(story, i));
+      load_time += timer.Elapsed().InMillisecondsF();
+      browser_cpu_time +=
+          (browser_metrics->GetCumulativeCPUUsage() - cpu_before)
+              .InMillisecondsF();
+      ads_blocked += prefs->GetUint64(kAdsBlocked) - ads_blocked_before;
+
+      dom_content_loaded +=
+          content::EvalJs(contents,
+                          "performance.getEntriesByType('navigation')[0]"
+                          ".domContentLoadedEventEnd")
+              .ExtractDouble();
+      load_event += content::EvalJs(contents,
+                                    "performance.getEntriesByType('navigation')"
+                                    "[0].loadEventEnd")
+                        .ExtractDouble();
+      js_heap_size +=
+          content::EvalJs(contents, "performance.memory.usedJSHeapSize")
+              .ExtractDouble();
+    }
+
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricLoadTime, "ms");
+    reporter.RegisterImportantMetric(kMetricDOMContentLoaded, "ms");
+    reporter.RegisterImportantMetric(kMetricLoadEvent, "ms");
+    reporter.RegisterImportantMetric(kMetricBrowserCPUTime, "ms");
+    reporter.RegisterImportantMetric(kMetricJSHeapSize, "bytes");
+    reporter.RegisterImportantMetric(kMetricAdsBlocked, "count");
+    reporter.AddResult(kMetricLoadTime, load_time / kLoadIterations);
+    reporter.AddResult(kMetricDOMContentLoaded,
+                       dom_content_loaded / kLoadIterations);
+    reporter.AddResult(kMetricLoadEvent, load_event / kLoadIterations);
+    reporter.AddResult(kMetricBrowserCPUTime,
+                       browser_cpu_time / kLoadIterations);
+    reporter.AddResult(kMetricJSHeapSize, js_heap_size / kLoadIterations);
+    reporter.AddResult(kMetricAdsBlocked, ads_blocked / kLoadIterations);
+  }
+
+  // Each story and load gets its own URL so no subresource is served from
+  // the cache.
+  GURL GetPageURL(const std::string& story, int iteration) {
+    return embedded_test_server()->GetURL(
+        "a.com", std::string(kPerfTestPage) + "?" + story +
+                     base::NumberToString(iteration));
+  }
+
+  GURL GetSiteURL() { return embedded_test_server()->GetURL("a.com", "/"); }
+};
+
+IN_PROC_BROWSER_TEST_F(ShieldsPageLoadPerfTest, Default) {
+  RunStory("default");
+}
+
+IN_PROC_BROWSER_TEST_F(ShieldsPageLoadPerfTest, Aggressive) {
+  const GURL url = GetSiteURL();
+  brave_shields::SetAdControlType(content_settings(),
+                                  brave_shields::ControlType::BLOCK, url);
+  brave_shields::SetCosmeticFilteringControlType(
+      content_settings(), brave_shields::ControlType::BLOCK, url);
+  brave_shields::SetFingerprintingControlType(
+      content_settings(), brave_shields::ControlType::BLOCK, url);
+  RunStory("aggressive");
+}
+
+IN_PROC_BROWSER_TEST_F(ShieldsPageLoadPerfTest, ShieldsOff) {
+  ShieldsDown(GetSiteURL());
+  RunStory("off");
+}
@@ -0,0 +1,46 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_BRAVE_SHIELDS_SHIELDS_SETTINGS_CACHE_FACTORY_H_
+#define BRAVE_BROWSER_BRAVE_SHIELDS_SHIELDS_SETTINGS_CACHE_FACTORY_H_
+
+#include "base/memory/singleton.h"
+#include "components/keyed_service/content/browser_context_keyed_service_factory.h"
+
+namespace brave_shields {
+
+class ShieldsSettingsCache;
+
+// Gives every profile, including off the record ones, a ShieldsSettingsCache
+// for its own HostContentSettingsMap.
+class ShieldsSettingsCacheFactory : public BrowserContextKeyedServiceFactory {
+ public:
+  static ShieldsSettingsCache* GetForBrowserContext(
+      content::BrowserContext* context);
+
+  static ShieldsSettingsCacheFactory* GetInstance();
+
+ private:
+  friend struct base::DefaultSingletonTraits<ShieldsSettingsCacheFactory>;
+
+  ShieldsSettingsCacheFactory();
+  ~ShieldsSettingsCacheFactory() override;
+
+  ShieldsSettingsCacheFactory(const ShieldsSettingsCacheFactory&) = delete;
+  ShieldsSettingsCacheFactory& operator=(const ShieldsSettingsCacheFactory&) =
+      delete;
+
+  // BrowserContextKeyedServiceFactory:
+  KeyedService* BuildServiceInstanceFor(
+      content::BrowserContext* context) const override;
+  content::BrowserContext* GetBrowserContextToUse(
+      content::BrowserContext* context) const override;
+  bool ServiceIsCreatedWithBrowserContext() const override;
+  bool ServiceIsNULLWhileTesting() const override;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_BROWSER_BRAVE_SHIELDS_SHIELDS_SETTINGS_CACHE_FACTORY_H_
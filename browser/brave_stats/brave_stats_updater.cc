@@ -156,17 +156,17 @@ void BraveStatsUpdater::Start() {
   QueueServerPing();
 
   // Periodic timer.
-  DCHECK(!server_ping_periodic_timer_);
-  server_ping_periodic_timer_ = std::make_unique<base::RepeatingTimer>();
-  server_ping_periodic_timer_->Start(
-      FROM_HERE,
+  DCHECK(!server_ping_periodic_task_);
+  server_ping_periodic_task_ = PeriodicTaskScheduler::GetInstance()->Register(
+      "BraveStatsUpdater",
       base::TimeDelta::FromSeconds(kUpdateServerPeriodicPingFrequencySeconds),
-      this, &BraveStatsUpdater::OnServerPingTimerFired);
+      base::BindRepeating(&BraveStatsUpdater::OnServerPingTimerFired,
+                          base::Unretained(this)));
 }
 
 void BraveStatsUpdater::Stop() {
   server_ping_startup_timer_.reset();
-  server_ping_periodic_timer_.reset();
+  server_ping_periodic_task_.reset();
 }
 
 bool BraveStatsUpdater::MaybeDoThresholdPing(int score) {
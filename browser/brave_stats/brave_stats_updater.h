@@ -13,6 +13,7 @@
 #include "base/macros.h"
 #include "base/memory/scoped_refptr.h"
 #include "brave/components/brave_stats/browser/brave_stats_updater_util.h"
+#include "brave/components/periodic_task_scheduler/periodic_task_scheduler.h"
 #include "chrome/browser/profiles/profile_manager_observer.h"
 #include "url/gurl.h"
 
@@ -24,7 +25,6 @@ class Profile;
 
 namespace base {
 class OneShotTimer;
-class RepeatingTimer;
 }  // namespace base
 
 namespace net {
@@ -96,7 +96,8 @@ class BraveStatsUpdater : public ProfileManagerObserver {
   std::string usage_server_;
   std::unique_ptr<network::SimpleURLLoader> simple_url_loader_;
   std::unique_ptr<base::OneShotTimer> server_ping_startup_timer_;
-  std::unique_ptr<base::RepeatingTimer> server_ping_periodic_timer_;
+  std::unique_ptr<PeriodicTaskScheduler::Registration>
+      server_ping_periodic_task_;
   std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
   base::RepeatingClosure stats_preconditions_barrier_;
 
@@ -69,7 +69,7 @@ class BraveWalletImporterDelegateImplUnitTest : public testing::Test {
         }),
         base::DictionaryValue::From(
             base::Value::ToUniquePtrValue(std::move(*json))));
-    base::RunLoop().RunUntilIdle();
+    browser_task_environment_.RunUntilIdle();
   }
 
  protected:
@@ -164,7 +164,7 @@ TEST_F(BraveWalletImporterDelegateImplUnitTest, OnGetLocalStorage) {
                                  EXPECT_TRUE(success);
                                  callback_is_called = true;
                                }));
-  base::RunLoop().RunUntilIdle();
+  browser_task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_is_called);
 
   callback_is_called = false;
@@ -173,7 +173,7 @@ TEST_F(BraveWalletImporterDelegateImplUnitTest, OnGetLocalStorage) {
         EXPECT_EQ(mnemonic, valid_mnemonic);
         callback_is_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  browser_task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_is_called);
 }
 
@@ -114,7 +114,7 @@ class BraveWalletProviderImplUnitTest : public testing::Test {
   void CreateWalletAndAccount() {
     keyring_controller()->CreateWallet(
         "testing123", base::DoNothing::Once<const std::string&>());
-    base::RunLoop().RunUntilIdle();
+    browser_task_environment_.RunUntilIdle();
     keyring_controller()->AddAccount("Account 1",
                                      base::DoNothing::Once<bool>());
     base::RunLoop().RunUntilIdle();
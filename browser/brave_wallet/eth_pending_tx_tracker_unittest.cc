@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/json/json_reader.h"
 #include "base/test/bind.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
@@ -23,6 +24,7 @@
 #include "components/prefs/pref_service.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "content/public/test/browser_task_environment.h"
+#include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
 #include "services/network/test/test_url_loader_factory.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -207,4 +209,60 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
             "0xb60e8dd61c5d32be8058bb8eb970870f07233155");
 }
 
+TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactionsSkipsOpenNonce) {
+  EthAddress addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a");
+  EthJsonRpcController controller(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), controller.MakeRemote());
+  EthNonceTracker nonce_tracker(&tx_state_manager, &controller);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &controller,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+  EthTxStateManager::TxMeta meta;
+  meta.id = "001";
+  meta.from = addr;
+  meta.tx_hash =
+      "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238";
+  meta.tx->set_nonce(uint256_t(4));
+  meta.status = mojom::TransactionStatus::Submitted;
+  tx_state_manager.AddOrUpdateTx(meta);
+  meta.id = "002";
+  meta.tx_hash =
+      "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568239";
+  meta.tx->set_nonce(uint256_t(5));
+  tx_state_manager.AddOrUpdateTx(meta);
+
+  size_t nonce_requests = 0;
+  std::vector<std::string> receipt_requests;
+  test_url_loader_factory()->SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        base::StringPiece request_string(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+        absl::optional<base::Value> request_value =
+            base::JSONReader::Read(request_string);
+        std::string* method = request_value->FindStringKey("method");
+        ASSERT_TRUE(method);
+        if (*method == "eth_getTransactionCount") {
+          nonce_requests++;
+          test_url_loader_factory()->AddResponse(
+              request.url.spec(),
+              "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x5\"}");
+        } else if (*method == "eth_getTransactionReceipt") {
+          receipt_requests.push_back(
+              request_value->FindListKey("params")->GetList()[0].GetString());
+        }
+      }));
+
+  pending_tx_tracker.UpdatePendingTransactions();
+  WaitForResponse();
+  // One nonce lookup for the address, and a receipt lookup only for the
+  // transaction whose nonce slot has been used.
+  EXPECT_EQ(nonce_requests, 1u);
+  ASSERT_EQ(receipt_requests.size(), 1u);
+  EXPECT_EQ(receipt_requests[0], tx_state_manager.GetTx("001")->tx_hash);
+  EXPECT_EQ(pending_tx_tracker.dropped_blocks_counter_[meta.tx_hash], 1);
+}
+
 }  // namespace brave_wallet
@@ -77,8 +77,9 @@ class KeyringControllerUnitTest : public testing::Test {
   bool bool_value() { return bool_value_; }
   const std::string string_value() { return string_value_; }
 
- private:
   content::BrowserTaskEnvironment task_environment_;
+
+ private:
   std::unique_ptr<TestingProfile> profile_;
   bool bool_value_;
   std::string string_value_;
@@ -340,7 +341,7 @@ TEST_F(KeyringControllerUnitTest, CreateDefaultKeyring) {
 TEST_F(KeyringControllerUnitTest, RestoreDefaultKeyring) {
   KeyringController controller(GetPrefs());
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   std::string salt = GetStringPrefForKeyring(kPasswordEncryptorSalt, "default");
   std::string encrypted_mnemonic =
       GetStringPrefForKeyring(kEncryptedMnemonic, "default");
@@ -400,7 +401,7 @@ TEST_F(KeyringControllerUnitTest, RestoreDefaultKeyring) {
   EXPECT_NE(GetStringPrefForKeyring(kPasswordEncryptorSalt, "default"), salt);
   EXPECT_NE(GetStringPrefForKeyring(kPasswordEncryptorNonce, "default"), nonce);
   controller.AddAccount("Account 1", base::DoNothing::Once<bool>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_EQ(controller.default_keyring_->GetAccountsNumber(), 1u);
   EXPECT_EQ(controller.default_keyring_->GetAddress(0),
             "0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db");
@@ -414,9 +415,9 @@ TEST_F(KeyringControllerUnitTest, UnlockResumesDefaultKeyring) {
     KeyringController controller(GetPrefs());
     controller.CreateWallet("brave",
                             base::DoNothing::Once<const std::string&>());
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     controller.AddAccount("Account2", base::DoNothing::Once<bool>());
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
 
     salt = GetStringPrefForKeyring(kPasswordEncryptorSalt, "default");
     nonce = GetStringPrefForKeyring(kPasswordEncryptorNonce, "default");
@@ -428,7 +429,7 @@ TEST_F(KeyringControllerUnitTest, UnlockResumesDefaultKeyring) {
     controller.Unlock(
         "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                 base::Unretained(this)));
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     ASSERT_EQ(true, bool_value());
     ASSERT_FALSE(controller.IsLocked());
 
@@ -445,11 +446,13 @@ TEST_F(KeyringControllerUnitTest, UnlockResumesDefaultKeyring) {
         "brave123",
         base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                        base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     ASSERT_TRUE(controller.IsLocked());
     // empty password
     controller.Unlock(
         "", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                            base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     ASSERT_TRUE(controller.IsLocked());
   }
 }
@@ -461,13 +464,13 @@ TEST_F(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring) {
   // no pref exists yet
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(string_value().empty());
 
   ASSERT_TRUE(controller.CreateDefaultKeyringInternal(kMnemonic1, false));
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_EQ(string_value(), kMnemonic1);
 
   // Lock controller
@@ -475,26 +478,28 @@ TEST_F(KeyringControllerUnitTest, GetMnemonicForDefaultKeyring) {
   EXPECT_TRUE(controller.IsLocked());
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(string_value().empty());
 
   // unlock with wrong password
   controller.Unlock(
       "brave123", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                  base::Unretained(this)));
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(controller.IsLocked());
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(string_value().empty());
 
   controller.Unlock(
       "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
+  task_environment_.RunUntilIdle();
   EXPECT_FALSE(controller.IsLocked());
   controller.GetMnemonicForDefaultKeyring(base::BindOnce(
       &KeyringControllerUnitTest::GetStringCallback, base::Unretained(this)));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_EQ(string_value(), kMnemonic1);
 }
 
@@ -509,11 +514,11 @@ TEST_F(KeyringControllerUnitTest, GetDefaultKeyringInfo) {
         EXPECT_TRUE(keyring_info->account_infos.empty());
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   callback_called = false;
   controller.GetDefaultKeyringInfo(
@@ -527,12 +532,12 @@ TEST_F(KeyringControllerUnitTest, GetDefaultKeyringInfo) {
         EXPECT_FALSE(keyring_info->account_infos[0]->is_imported);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.NotifyWalletBackupComplete();
   controller.AddAccount("Account5566", base::DoNothing::Once<bool>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   callback_called = false;
   controller.GetDefaultKeyringInfo(
@@ -547,7 +552,7 @@ TEST_F(KeyringControllerUnitTest, GetDefaultKeyringInfo) {
         EXPECT_EQ(keyring_info->account_infos[1]->name, "Account5566");
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 }
 
@@ -575,11 +580,13 @@ TEST_F(KeyringControllerUnitTest, LockAndUnlock) {
     controller.Unlock(
         "abc", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                               base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     EXPECT_TRUE(controller.IsLocked());
 
     controller.Unlock(
         "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                 base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     EXPECT_FALSE(controller.IsLocked());
     controller.default_keyring_->AddAccounts(1);
 
@@ -591,6 +598,7 @@ TEST_F(KeyringControllerUnitTest, LockAndUnlock) {
     controller.Unlock(
         "brave", base::BindOnce(&KeyringControllerUnitTest::GetBooleanCallback,
                                 base::Unretained(this)));
+    task_environment_.RunUntilIdle();
     EXPECT_FALSE(controller.IsLocked());
     controller.default_keyring_->AddAccounts(1);
   }
@@ -631,7 +639,7 @@ TEST_F(KeyringControllerUnitTest, BackupComplete) {
     EXPECT_FALSE(backed_up);
     callback_called = true;
   }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.NotifyWalletBackupComplete();
@@ -641,7 +649,7 @@ TEST_F(KeyringControllerUnitTest, BackupComplete) {
     EXPECT_TRUE(backed_up);
     callback_called = true;
   }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.Reset();
@@ -651,7 +659,7 @@ TEST_F(KeyringControllerUnitTest, BackupComplete) {
     EXPECT_FALSE(backed_up);
     callback_called = true;
   }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 }
 
@@ -708,6 +716,34 @@ TEST_F(KeyringControllerUnitTest, AccountMetasForKeyring) {
   EXPECT_EQ(account_infos[1]->name, name2);
 }
 
+TEST_F(KeyringControllerUnitTest, KeyringModelTracksPrefs) {
+  KeyringController controller(GetPrefs());
+  const std::string account_path1 = KeyringController::GetAccountPathByIndex(0);
+  const std::string account_path2 = KeyringController::GetAccountPathByIndex(1);
+  KeyringController::SetAccountMetaForKeyring(GetPrefs(), account_path1,
+                                              "Account1", "0x1", "default");
+
+  auto account_infos = controller.GetAccountInfosForKeyring("default");
+  ASSERT_EQ(account_infos.size(), 1u);
+  EXPECT_EQ(account_infos[0]->name, "Account1");
+  EXPECT_EQ(controller.keyring_models_.count("default"), 1u);
+
+  // Any write to the keyrings pref drops the cached model.
+  KeyringController::SetAccountMetaForKeyring(GetPrefs(), account_path2,
+                                              "Account2", "0x2", "default");
+  EXPECT_TRUE(controller.keyring_models_.empty());
+  KeyringController::SetAccountMetaForKeyring(
+      GetPrefs(), account_path1, "Renamed", absl::nullopt, "default");
+
+  account_infos = controller.GetAccountInfosForKeyring("default");
+  ASSERT_EQ(account_infos.size(), 2u);
+  EXPECT_EQ(account_infos[0]->name, "Renamed");
+  EXPECT_EQ(account_infos[0]->address, "0x1");
+  EXPECT_EQ(account_infos[1]->name, "Account2");
+  EXPECT_EQ(account_infos[1]->address, "0x2");
+  EXPECT_EQ(controller.GetAccountMetasNumberForKeyring("default"), 2u);
+}
+
 TEST_F(KeyringControllerUnitTest, CreateAndRestoreWallet) {
   KeyringController controller(GetPrefs());
   bool callback_called = false;
@@ -718,7 +754,7 @@ TEST_F(KeyringControllerUnitTest, CreateAndRestoreWallet) {
         mnemonic_to_be_restored = mnemonic;
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   std::vector<mojom::AccountInfoPtr> account_infos =
@@ -730,14 +766,14 @@ TEST_F(KeyringControllerUnitTest, CreateAndRestoreWallet) {
 
   controller.Reset();
   auto verify_restore_wallet = base::BindLambdaForTesting(
-      [&mnemonic_to_be_restored, &controller, &address0]() {
+      [this, &mnemonic_to_be_restored, &controller, &address0]() {
         bool callback_called = false;
         controller.RestoreWallet(mnemonic_to_be_restored, "brave1", false,
                                  base::BindLambdaForTesting([&](bool success) {
                                    EXPECT_TRUE(success);
                                    callback_called = true;
                                  }));
-        base::RunLoop().RunUntilIdle();
+        task_environment_.RunUntilIdle();
         EXPECT_TRUE(callback_called);
         {
           std::vector<mojom::AccountInfoPtr> account_infos =
@@ -755,14 +791,14 @@ TEST_F(KeyringControllerUnitTest, CreateAndRestoreWallet) {
 TEST_F(KeyringControllerUnitTest, AddAccount) {
   KeyringController controller(GetPrefs());
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   bool callback_called = false;
   controller.AddAccount("Account5566",
                         base::BindLambdaForTesting([&](bool success) {
                           EXPECT_TRUE(success);
                           callback_called = true;
                         }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   std::vector<mojom::AccountInfoPtr> account_infos =
@@ -846,7 +882,7 @@ TEST_F(KeyringControllerUnitTest, MigrationPrefsFailSafe) {
 TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
   KeyringController controller(GetPrefs());
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   const struct {
     const char* name;
     const char* private_key;
@@ -872,7 +908,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
               EXPECT_EQ(imported_accounts[i].address, address);
               callback_called = true;
             }));
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     EXPECT_TRUE(callback_called);
 
     callback_called = false;
@@ -884,7 +920,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
               EXPECT_EQ(imported_accounts[i].private_key, private_key);
               callback_called = true;
             }));
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     EXPECT_TRUE(callback_called);
   }
 
@@ -895,7 +931,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
         EXPECT_TRUE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // remove invalid address
@@ -904,7 +940,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -929,7 +965,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
         EXPECT_TRUE(keyring_info->account_infos[2]->is_imported);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.Lock();
@@ -943,11 +979,11 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
             EXPECT_TRUE(private_key.empty());
             callback_called = true;
           }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.Unlock("brave", base::DoNothing::Once<bool>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   callback_called = false;
   // Imported accounts should be restored
@@ -966,7 +1002,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
         EXPECT_TRUE(keyring_info->account_infos[2]->is_imported);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // private key should also be available now
@@ -979,7 +1015,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccounts) {
             EXPECT_EQ(imported_accounts[0].private_key, private_key);
             callback_called = true;
           }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // Imported accounts should also be restored in default keyring
@@ -1036,7 +1072,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
 
   KeyringController controller(GetPrefs());
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   bool callback_called = false;
   controller.ImportAccountFromJson(
@@ -1046,7 +1082,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
         EXPECT_TRUE(address.empty());
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1057,7 +1093,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
         EXPECT_TRUE(address.empty());
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1068,12 +1104,12 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
         EXPECT_EQ(address, expected_address);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.Lock();
   controller.Unlock("brave", base::DoNothing::Once<bool>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   // check restore by getting private key
   callback_called = false;
@@ -1084,7 +1120,7 @@ TEST_F(KeyringControllerUnitTest, ImportedAccountFromJson) {
                               EXPECT_EQ(expected_private_key, private_key);
                               callback_called = true;
                             }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // private key is encrypted
@@ -1117,7 +1153,7 @@ TEST_F(KeyringControllerUnitTest, GetPrivateKeyForDefaultKeyringAccount) {
             EXPECT_TRUE(private_key.empty());
             callback_called = true;
           }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.default_keyring_->AddAccounts(1);
@@ -1132,7 +1168,7 @@ TEST_F(KeyringControllerUnitTest, GetPrivateKeyForDefaultKeyringAccount) {
                 EXPECT_TRUE(private_key.empty());
                 callback_called = true;
               }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1143,7 +1179,7 @@ TEST_F(KeyringControllerUnitTest, GetPrivateKeyForDefaultKeyringAccount) {
                      EXPECT_TRUE(private_key.empty());
                      callback_called = true;
                    }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1157,7 +1193,7 @@ TEST_F(KeyringControllerUnitTest, GetPrivateKeyForDefaultKeyringAccount) {
             private_key);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 }
 
@@ -1171,7 +1207,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringDerivedAccountMeta) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   EXPECT_TRUE(controller.CreateEncryptorForKeyring("brave", "default"));
@@ -1207,7 +1243,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringDerivedAccountMeta) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1216,7 +1252,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringDerivedAccountMeta) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
@@ -1225,7 +1261,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringDerivedAccountMeta) {
         EXPECT_TRUE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   EXPECT_EQ(KeyringController::GetAccountNameForKeyring(
@@ -1239,7 +1275,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringDerivedAccountMeta) {
 TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
   KeyringController controller(GetPrefs());
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   const struct {
     const char* name;
@@ -1266,7 +1302,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // Add import accounts.
@@ -1281,7 +1317,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
               EXPECT_EQ(imported_accounts[i].address, address);
               callback_called = true;
             }));
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     EXPECT_TRUE(callback_called);
   }
 
@@ -1292,7 +1328,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // Empty name should fail.
@@ -1303,7 +1339,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
         EXPECT_FALSE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // Update second imported account's name.
@@ -1314,7 +1350,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
         EXPECT_TRUE(success);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   // Private key of imported accounts should not be changed.
@@ -1329,7 +1365,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
               EXPECT_EQ(imported_accounts[i].private_key, private_key);
               callback_called = true;
             }));
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     EXPECT_TRUE(callback_called);
   }
 
@@ -1360,7 +1396,7 @@ TEST_F(KeyringControllerUnitTest, SetDefaultKeyringImportedAccountName) {
         EXPECT_TRUE(keyring_info->account_infos[3]->is_imported);
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 }
 
@@ -1374,15 +1410,15 @@ TEST_F(KeyringControllerUnitTest, RestoreLegacyBraveWallet) {
       "crew where";
   KeyringController controller(GetPrefs());
   auto verify_restore_wallet = base::BindLambdaForTesting(
-      [&controller](const char* mnemonic, const char* address, bool is_legacy,
-                    bool expect_result) {
+      [this, &controller](const char* mnemonic, const char* address,
+                          bool is_legacy, bool expect_result) {
         bool callback_called = false;
         controller.RestoreWallet(mnemonic, "brave1", is_legacy,
                                  base::BindLambdaForTesting([&](bool success) {
                                    EXPECT_EQ(success, expect_result);
                                    callback_called = true;
                                  }));
-        base::RunLoop().RunUntilIdle();
+        task_environment_.RunUntilIdle();
         EXPECT_TRUE(callback_called);
         if (expect_result) {
           std::vector<mojom::AccountInfoPtr> account_infos =
@@ -1395,7 +1431,7 @@ TEST_F(KeyringControllerUnitTest, RestoreLegacyBraveWallet) {
           // legacy_brave_wallet pref so it will use the right seed
           controller.Lock();
           controller.Unlock("brave1", base::DoNothing::Once<bool>());
-          base::RunLoop().RunUntilIdle();
+          task_environment_.RunUntilIdle();
           account_infos.clear();
           account_infos = controller.GetAccountInfosForKeyring("default");
           ASSERT_EQ(account_infos.size(), 1u);
@@ -1415,7 +1451,7 @@ TEST_F(KeyringControllerUnitTest, RestoreLegacyBraveWallet) {
 TEST_F(KeyringControllerUnitTest, HardwareAccounts) {
   KeyringController controller(GetPrefs());
   controller.CreateWallet("brave", base::DoNothing::Once<const std::string&>());
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   std::vector<mojom::HardwareWalletAccountPtr> new_accounts;
   new_accounts.push_back(mojom::HardwareWalletAccount::New(
@@ -1426,7 +1462,7 @@ TEST_F(KeyringControllerUnitTest, HardwareAccounts) {
       "0xEA0", "m/44'/60'/3'/0/0", "name 3", "Ledger"));
 
   controller.AddHardwareAccounts(std::move(new_accounts));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   ASSERT_TRUE(GetPrefs()
                   ->GetDictionary(kBraveWalletKeyrings)
                   ->FindPath("hardware.Ledger4235202380.account_metas.0x111"));
@@ -1453,11 +1489,11 @@ TEST_F(KeyringControllerUnitTest, HardwareAccounts) {
 
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
 
   controller.RemoveHardwareAccount("0x111");
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   ASSERT_FALSE(GetPrefs()
                    ->GetDictionary(kBraveWalletKeyrings)
@@ -1472,7 +1508,7 @@ TEST_F(KeyringControllerUnitTest, HardwareAccounts) {
                   ->FindPath("hardware.Ledger4235202380.account_metas.0xEA0"));
 
   controller.RemoveHardwareAccount("0x264");
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   callback_called = false;
   controller.GetHardwareAccounts(base::BindLambdaForTesting(
@@ -1486,10 +1522,10 @@ TEST_F(KeyringControllerUnitTest, HardwareAccounts) {
 
         callback_called = true;
       }));
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
   EXPECT_TRUE(callback_called);
   controller.RemoveHardwareAccount("0xEA0");
-  base::RunLoop().RunUntilIdle();
+  task_environment_.RunUntilIdle();
 
   ASSERT_FALSE(GetPrefs()
                    ->GetDictionary(kBraveWalletKeyrings)
@@ -31,32 +31,6 @@ using InstallError = update_client::InstallError;
 }  // namespace
 
 namespace {
-bool RewriteManifestFile(
-    const base::FilePath& extension_root,
-    const base::DictionaryValue& manifest,
-    const std::string &public_key) {
-
-  // Add the public key
-  DCHECK(!public_key.empty());
-
-  std::unique_ptr<base::DictionaryValue> final_manifest(manifest.DeepCopy());
-  final_manifest->SetString("key", public_key);
-
-  std::string manifest_json;
-  JSONStringValueSerializer serializer(&manifest_json);
-  serializer.set_pretty_print(true);
-  if (!serializer.Serialize(*final_manifest)) {
-    return false;
-  }
-
-  base::FilePath manifest_path =
-    extension_root.Append(FILE_PATH_LITERAL("manifest.json"));
-  int size = base::checked_cast<int>(manifest_json.size());
-  if (base::WriteFile(manifest_path, manifest_json.data(), size) != size) {
-    return false;
-  }
-  return true;
-}
 
 std::string GetManifestString(std::unique_ptr<base::DictionaryValue> manifest,
     const std::string &public_key) {
@@ -91,12 +65,11 @@ BraveComponentInstallerPolicy::~BraveComponentInstallerPolicy() {}
 bool BraveComponentInstallerPolicy::VerifyInstallation(
     const base::DictionaryValue& manifest,
     const base::FilePath& install_dir) const {
-  // The manifest file will generate a random ID if we don't provide one.
-  // We want to write one with the actual extensions public key so we get
-  // the same extensionID which is generated from the public key.
-  if (!RewriteManifestFile(install_dir, manifest, base64_public_key_)) {
-    return false;
-  }
+  // The manifest is left as shipped. A differential update patches the files
+  // of the previous install and checks each result against the new package,
+  // so a manifest.json rewritten here would make every delta fail and fall
+  // back to a full download. Consumers get the manifest with the public key
+  // added from ComponentReady() instead.
   return base::PathExists(
       install_dir.Append(FILE_PATH_LITERAL("manifest.json")));
 }
@@ -5,6 +5,9 @@
 
 #include "brave/components/decentralized_dns/utils.h"
 
+#include <string>
+#include <vector>
+
 #include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "brave/components/decentralized_dns/constants.h"
@@ -105,6 +108,31 @@ TEST_P(UtilsUnitTest, IsENSResolveMethodDoH) {
   EXPECT_EQ(feature_enabled(), IsENSResolveMethodDoH(local_state()));
 }
 
+TEST_P(UtilsUnitTest, RecentlyResolvedHosts) {
+  local_state()->SetInteger(
+      kENSResolveMethod, static_cast<int>(ResolveMethodTypes::DNS_OVER_HTTPS));
+  const base::Time now = base::Time::Now();
+  RecordRecentlyResolvedHost(local_state(), "old.eth",
+                             now - base::TimeDelta::FromDays(8));
+  RecordRecentlyResolvedHost(local_state(), "a.eth", now);
+  RecordRecentlyResolvedHost(local_state(), "b.crypto", now);
+  RecordRecentlyResolvedHost(local_state(), "a.eth", now);
+
+  // Expired hosts are dropped and hosts whose TLD is no longer resolved over
+  // DoH are skipped.
+  std::vector<std::string> expected;
+  if (feature_enabled())
+    expected = {"a.eth"};
+  EXPECT_EQ(expected, GetRecentlyResolvedHosts(local_state(), now));
+
+  local_state()->SetInteger(
+      kUnstoppableDomainsResolveMethod,
+      static_cast<int>(ResolveMethodTypes::DNS_OVER_HTTPS));
+  if (feature_enabled())
+    expected = {"a.eth", "b.crypto"};
+  EXPECT_EQ(expected, GetRecentlyResolvedHosts(local_state(), now));
+}
+
 INSTANTIATE_TEST_SUITE_P(/* no prefix */, UtilsUnitTest, testing::Bool());
 
 }  // namespace decentralized_dns
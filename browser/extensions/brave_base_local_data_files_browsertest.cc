@@ -58,8 +58,8 @@ void BaseLocalDataFilesBrowserTest::MaybeSetUpEmbeddedTestServerOnMainThread() {
 }
 
 void BaseLocalDataFilesBrowserTest::WaitForService() {
-  scoped_refptr<base::ThreadTestHelper> tr_helper(new base::ThreadTestHelper(
-      g_brave_browser_process->local_data_files_service()->GetTaskRunner()));
+  scoped_refptr<base::ThreadTestHelper> tr_helper(
+      new base::ThreadTestHelper(service()->GetTaskRunner()));
   ASSERT_TRUE(tr_helper->Run());
   scoped_refptr<base::ThreadTestHelper> io_helper(new base::ThreadTestHelper(
       base::CreateSingleThreadTaskRunner({BrowserThread::IO}).get()));
@@ -5,6 +5,7 @@
 
 #include "base/path_service.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
@@ -231,3 +232,27 @@ IN_PROC_BROWSER_TEST_F(BraveWebGLFarblingBrowserTest, GetExtension) {
   NavigateToURLUntilLoadStop(url);
   EXPECT_EQ(EvalJs(contents(), kTitleScript).ExtractString(), actual);
 }
+
+IN_PROC_BROWSER_TEST_F(BraveWebGLFarblingBrowserTest, FarbleReadPixels) {
+  std::string domain = "a.com";
+  GURL url =
+      embedded_test_server()->GetURL(domain, "/readpixels-farbling.html");
+
+  // Farbling level: off
+  // The cleared pixels come back as they are.
+  AllowFingerprinting(domain);
+  NavigateToURLUntilLoadStop(url);
+  EXPECT_EQ(EvalJs(contents(), kTitleScript).ExtractString(), "0 true");
+
+  // Farbling level: default
+  // The rectangle that was read is farbled, the rest of the buffer is not.
+  SetFingerprintingDefault(domain);
+  NavigateToURLUntilLoadStop(url);
+  std::string farbled = EvalJs(contents(), kTitleScript).ExtractString();
+  EXPECT_NE(farbled, "0 true");
+  EXPECT_TRUE(base::EndsWith(farbled, " true"));
+
+  // The same pixels farble the same way within a session.
+  NavigateToURLUntilLoadStop(url);
+  EXPECT_EQ(EvalJs(contents(), kTitleScript).ExtractString(), farbled);
+}
@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/containers/flat_map.h"
+#include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/scoped_observation.h"
@@ -24,6 +25,7 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -231,6 +233,27 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ClearCache) {
   EXPECT_EQ(size, GetRulesSize());
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, GetRulesForURL) {
+  ASSERT_TRUE(InstallMockExtension());
+  GreaselionDownloadService* download_service =
+      g_brave_browser_process->greaselion_download_service();
+  auto rules = download_service->GetRulesForURL(
+      GURL("https://www.example.com/index.html"));
+  ASSERT_EQ(rules.size(), 1u);
+  EXPECT_EQ(rules[0]->url_patterns(),
+            std::vector<std::string>{"https://www.example.com/*"});
+  EXPECT_EQ(
+      download_service->GetRulesForURL(GURL("http://www.a.com:8080/")).size(),
+      1u);
+  EXPECT_TRUE(
+      download_service->GetRulesForURL(GURL("http://www.example.com/"))
+          .empty());
+  EXPECT_TRUE(
+      download_service->GetRulesForURL(GURL("https://example.com/")).empty());
+  EXPECT_TRUE(
+      download_service->GetRulesForURL(GURL("http://b.com/")).empty());
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ScriptInjection) {
   ASSERT_TRUE(InstallMockExtension());
   GURL url = embedded_test_server()->GetURL("www.a.com", "/simple.html");
@@ -356,6 +379,30 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsGreaselionExtension) {
   EXPECT_TRUE(greaselion_service->IsGreaselionExtension(extension_ids[0]));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ReusesConvertedExtensions) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+  const base::FilePath path =
+      registry->enabled_extensions().GetByID(extension_ids[0])->path();
+
+  // Reinstalling with unchanged rules loads the same cached conversion.
+  greaselion_service->UpdateInstalledExtensions();
+  GreaselionServiceWaiter(greaselion_service).Wait();
+  const extensions::Extension* extension =
+      registry->enabled_extensions().GetByID(extension_ids[0]);
+  ASSERT_TRUE(extension);
+  EXPECT_EQ(path, extension->path());
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  EXPECT_TRUE(base::DirectoryExists(path));
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   ASSERT_TRUE(InstallMockExtension());
 
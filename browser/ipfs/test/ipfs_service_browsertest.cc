@@ -8,6 +8,7 @@
 #include "base/run_loop.h"
 #include "base/strings/strcat.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
 #include "base/test/mock_callback.h"
 #include "base/test/scoped_feature_list.h"
 #include "brave/browser/brave_browser_process.h"
@@ -727,6 +728,25 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetNodeInfoServerSuccess) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetNodeInfoCached) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleGetNodeInfo, base::Unretained(this)));
+  ipfs_service()->GetNodeInfo(base::BindOnce(
+      &IpfsServiceBrowserTest::OnGetNodeInfoSuccess, base::Unretained(this)));
+  WaitForRequest();
+
+  // Answered from memory without asking the node again.
+  ShutDownTestServer();
+  bool called = false;
+  ipfs_service()->GetNodeInfo(base::BindLambdaForTesting(
+      [&called](bool success, const NodeInfo& info) {
+        called = true;
+        EXPECT_TRUE(success);
+        EXPECT_EQ(info.id, "idididid");
+      }));
+  EXPECT_TRUE(called);
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetNodeInfoServerError) {
   ResetTestServer(
       base::BindRepeating(&IpfsServiceBrowserTest::HandleRequestServerError,
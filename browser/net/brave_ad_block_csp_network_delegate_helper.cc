@@ -17,24 +17,33 @@
 
 namespace brave {
 
+namespace {
+
+// Returns the host CSP rules are matched against as the tab host, or
+// absl::nullopt if the request has none.
+absl::optional<std::string> GetSourceHost(const BraveRequestInfo& ctx) {
+  if (ctx.initiator_url.is_valid() && !ctx.initiator_url.host_piece().empty())
+    return ctx.initiator_url.host();
+  // Top-level document requests do not have a valid initiator URL, and
+  // requests from special schemes like file:// do not have host parts, so we
+  // use the request URL as the initiator.
+  if (ctx.request_url.is_valid())
+    return ctx.request_url.host();
+  return absl::nullopt;
+}
+
+}  // namespace
+
 absl::optional<std::string> GetCspDirectivesOnTaskRunner(
     std::shared_ptr<BraveRequestInfo> ctx,
     absl::optional<std::string> original_csp) {
-  std::string source_host;
-  if (ctx->initiator_url.is_valid() && !ctx->initiator_url.host().empty()) {
-    source_host = ctx->initiator_url.host();
-  } else if (ctx->request_url.is_valid()) {
-    // Top-level document requests do not have a valid initiator URL, and
-    // requests from special schemes like file:// do not have host parts, so we
-    // use the request URL as the initiator.
-    source_host = ctx->request_url.host();
-  } else {
+  absl::optional<std::string> source_host = GetSourceHost(*ctx);
+  if (!source_host)
     return absl::nullopt;
-  }
 
   absl::optional<std::string> csp_directives =
       g_brave_browser_process->ad_block_service()->GetCspDirectives(
-          ctx->request_url, ctx->resource_type, source_host);
+          ctx->request_url, ctx->resource_type, *source_host);
 
   brave_shields::MergeCspDirectiveInto(original_csp, &csp_directives);
   return csp_directives;
@@ -69,6 +78,15 @@ int OnHeadersReceived_AdBlockCspWork(
 
   if (ctx->resource_type == blink::mojom::ResourceType::kMainFrame ||
       ctx->resource_type == blink::mojom::ResourceType::kSubFrame) {
+    // Most documents can't be touched by any $csp rule, which the engines'
+    // rule summaries can tell without a trip to the adblock task runner.
+    absl::optional<std::string> source_host = GetSourceHost(*ctx);
+    if (!source_host ||
+        !g_brave_browser_process->ad_block_service()->CouldHaveCspDirectives(
+            ctx->request_url.host(), *source_host)) {
+      return net::OK;
+    }
+
     // If the override_response_headers have already been populated, we should
     // use those directly.  Otherwise, we populate them from the original
     // headers.
@@ -5,15 +5,24 @@
 
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/base64url.h"
+#include "base/callback_helpers.h"
 #include "base/feature_list.h"
+#include "base/memory/weak_ptr.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_util.h"
+#include "base/supports_user_data.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/url_context.h"
@@ -77,13 +86,10 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
 
  public:
   AdblockCnameResolveHostClient(
-      const ResponseCallback& next_callback,
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
       std::shared_ptr<BraveRequestInfo> ctx,
-      EngineFlags previous_result) {
+      base::OnceCallback<void(absl::optional<std::string>)> cb)
+      : cb_(std::move(cb)) {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-    cb_ = base::BindOnce(&UseCnameResult, task_runner, std::move(next_callback),
-                         ctx, previous_result);
 
     const auto network_isolation_key = ctx->network_isolation_key;
 
@@ -160,6 +166,127 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
   }
 };
 
+// Remembers CNAME resolutions per profile for a short while, and coalesces
+// concurrent resolutions for the same host, so pages that load many resources
+// from one host only wait on DNS once.
+class AdblockCnameCache : public base::SupportsUserData::Data {
+ public:
+  using CnameCallback = base::OnceCallback<void(absl::optional<std::string>)>;
+
+  static AdblockCnameCache* FromBrowserContext(
+      content::BrowserContext* browser_context) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    auto* cache = static_cast<AdblockCnameCache*>(
+        browser_context->GetUserData(kUserDataKey));
+    if (!cache) {
+      auto new_cache = std::make_unique<AdblockCnameCache>();
+      cache = new_cache.get();
+      browser_context->SetUserData(kUserDataKey, std::move(new_cache));
+    }
+    return cache;
+  }
+
+  static std::string KeyFor(const BraveRequestInfo& ctx) {
+    return base::StrCat({ctx.network_isolation_key.ToString(), " ",
+                         ctx.request_url.host_piece()});
+  }
+
+  bool Get(const std::string& key, absl::optional<std::string>* cname) {
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+      return false;
+    if (base::TimeTicks::Now() >= it->second.expiry) {
+      entries_.erase(it);
+      return false;
+    }
+    *cname = it->second.cname;
+    return true;
+  }
+
+  // Queues |callback| for the result of resolving |key|. Returns true if this
+  // is the first waiter, in which case the caller has to start the
+  // resolution and pass its result to OnResolved().
+  bool AddWaiter(const std::string& key, CnameCallback callback) {
+    auto& waiters = in_flight_[key];
+    waiters.push_back(std::move(callback));
+    return waiters.size() == 1;
+  }
+
+  void OnResolved(const std::string& key, absl::optional<std::string> cname) {
+    const base::TimeDelta ttl = base::TimeDelta::FromSeconds(
+        brave_shields::features::kBraveAdblockCnameCacheTtlSeconds.Get());
+    entries_[key] = {cname, base::TimeTicks::Now() + ttl};
+
+    auto it = in_flight_.find(key);
+    if (it == in_flight_.end())
+      return;
+    std::vector<CnameCallback> waiters = std::move(it->second);
+    in_flight_.erase(it);
+    for (auto& waiter : waiters)
+      std::move(waiter).Run(cname);
+  }
+
+  base::WeakPtr<AdblockCnameCache> AsWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ private:
+  static const char kUserDataKey[];
+
+  struct Entry {
+    absl::optional<std::string> cname;
+    base::TimeTicks expiry;
+  };
+
+  std::map<std::string, Entry> entries_;
+  std::map<std::string, std::vector<CnameCallback>> in_flight_;
+  base::WeakPtrFactory<AdblockCnameCache> weak_factory_{this};
+};
+
+const char AdblockCnameCache::kUserDataKey[] = "brave_adblock_cname_cache";
+
+void OnCnameResolvedForCache(base::WeakPtr<AdblockCnameCache> cache,
+                             const std::string& key,
+                             absl::optional<std::string> cname) {
+  if (cache)
+    cache->OnResolved(key, std::move(cname));
+}
+
+// Runs the CNAME check for |ctx| through the profile's AdblockCnameCache.
+void CheckCnameWithCache(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                         const ResponseCallback& next_callback,
+                         std::shared_ptr<BraveRequestInfo> ctx,
+                         EngineFlags result) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  AdblockCnameCache* cache =
+      AdblockCnameCache::FromBrowserContext(ctx->browser_context);
+  const std::string key = AdblockCnameCache::KeyFor(*ctx);
+
+  absl::optional<std::string> cname;
+  if (cache->Get(key, &cname)) {
+    UseCnameResult(task_runner, next_callback, ctx, result, std::move(cname));
+    return;
+  }
+
+  bool first_waiter;
+  if (brave_shields::features::kBraveAdblockCnameCacheOptimistic.Get()) {
+    // Let this request through right away; the result will only be applied
+    // to later requests for the same host.
+    first_waiter = cache->AddWaiter(key, base::DoNothing());
+    next_callback.Run();
+  } else {
+    first_waiter = cache->AddWaiter(
+        key, base::BindOnce(&UseCnameResult, task_runner, next_callback, ctx,
+                            result));
+  }
+
+  if (first_waiter) {
+    // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
+    new AdblockCnameResolveHostClient(
+        ctx, base::BindOnce(&OnCnameResolvedForCache, cache->AsWeakPtr(), key));
+  }
+}
+
 // If `canonical_url` is specified, this will only check if the CNAME-uncloaked
 // response should be blocked. Otherwise, it will run the check for the
 // original request URL.
@@ -167,6 +294,8 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
     std::shared_ptr<BraveRequestInfo> ctx,
     EngineFlags previous_result,
     absl::optional<GURL> canonical_url) {
+  TRACE_EVENT2("browser", "ShouldBlockRequestOnTaskRunner", "request_id",
+               ctx->request_identifier, "uncloaked", canonical_url.has_value());
   if (!ctx->initiator_url.is_valid()) {
     return previous_result;
   }
@@ -200,6 +329,68 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
   return previous_result;
 }
 
+// An adblock check waiting on the UI thread to be sent off as part of the
+// next batch.
+struct PendingAdBlockCheck {
+  ResponseCallback next_callback;
+  std::shared_ptr<BraveRequestInfo> ctx;
+  bool should_check_uncloaked;
+};
+
+std::vector<PendingAdBlockCheck>* GetPendingAdBlockChecks() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<std::vector<PendingAdBlockCheck>> pending_checks;
+  return pending_checks.get();
+}
+
+std::vector<EngineFlags> ShouldBlockRequestsOnTaskRunner(
+    std::vector<std::shared_ptr<BraveRequestInfo>> ctxs) {
+  UMA_HISTOGRAM_COUNTS_1000("Brave.Adblock.ShouldBlockRequestBatchSize",
+                            ctxs.size());
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.ShouldBlockRequestBatch");
+  TRACE_EVENT1("browser", "ShouldBlockRequestsOnTaskRunner", "batch_size",
+               ctxs.size());
+
+  std::vector<brave_shields::AdBlockRequest> requests(ctxs.size());
+  std::vector<brave_shields::AdBlockRequest*> valid_requests;
+  valid_requests.reserve(ctxs.size());
+  for (size_t i = 0; i < ctxs.size(); i++) {
+    const auto& ctx = ctxs[i];
+    if (!ctx->initiator_url.is_valid())
+      continue;
+    brave_shields::AdBlockRequest& request = requests[i];
+    request.url = ctx->request_url;
+    request.resource_type = ctx->resource_type;
+    request.tab_host = ctx->initiator_url.host();
+    request.aggressive_blocking =
+        ctx->aggressive_blocking ||
+        SameDomainOrHost(
+            ctx->initiator_url,
+            url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
+            net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+    request.ComputeDerivedFields();
+    valid_requests.push_back(&request);
+  }
+
+  g_brave_browser_process->ad_block_service()->ShouldStartRequests(
+      valid_requests);
+
+  std::vector<EngineFlags> results(ctxs.size());
+  for (size_t i = 0; i < ctxs.size(); i++) {
+    const brave_shields::AdBlockRequest& request = requests[i];
+    results[i].did_match_rule = request.did_match_rule;
+    results[i].did_match_exception = request.did_match_exception;
+    results[i].did_match_important = request.did_match_important;
+    if (!request.mock_data_url.empty())
+      ctxs[i]->mock_data_url = request.mock_data_url;
+    if (request.did_match_important ||
+        (request.did_match_rule && !request.did_match_exception)) {
+      ctxs[i]->blocked_by = kAdBlocked;
+    }
+  }
+  return results;
+}
+
 void OnShouldBlockRequestResult(
     bool then_check_uncloaked,
     scoped_refptr<base::SequencedTaskRunner> task_runner,
@@ -211,14 +402,57 @@ void OnShouldBlockRequestResult(
     brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         ctx->request_url, ctx->frame_tree_node_id, brave_shields::kAds);
   } else if (then_check_uncloaked) {
+    if (base::FeatureList::IsEnabled(
+            brave_shields::features::kBraveAdblockCnameCache) &&
+        ctx->browser_context) {
+      CheckCnameWithCache(task_runner, next_callback, ctx, result);
+      return;
+    }
     // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
-    new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
-                                      ctx, result);
+    new AdblockCnameResolveHostClient(
+        ctx, base::BindOnce(&UseCnameResult, task_runner, next_callback, ctx,
+                            result));
     return;
   }
   next_callback.Run();
 }
 
+void OnShouldBlockRequestsResult(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    std::vector<PendingAdBlockCheck> checks,
+    std::vector<EngineFlags> results) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_EQ(checks.size(), results.size());
+  for (size_t i = 0; i < checks.size(); i++) {
+    OnShouldBlockRequestResult(checks[i].should_check_uncloaked, task_runner,
+                               checks[i].next_callback, checks[i].ctx,
+                               results[i]);
+  }
+}
+
+// Sends every check queued up since the last flush to the adblock task runner
+// in a single task.
+void FlushPendingAdBlockChecks() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  std::vector<PendingAdBlockCheck> checks;
+  checks.swap(*GetPendingAdBlockChecks());
+  if (checks.empty())
+    return;
+
+  std::vector<std::shared_ptr<BraveRequestInfo>> ctxs;
+  ctxs.reserve(checks.size());
+  for (const auto& check : checks)
+    ctxs.push_back(check.ctx);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner =
+      g_brave_browser_process->ad_block_service()->GetTaskRunner();
+  task_runner->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ShouldBlockRequestsOnTaskRunner, std::move(ctxs)),
+      base::BindOnce(&OnShouldBlockRequestsResult, task_runner,
+                     std::move(checks)));
+}
+
 void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
@@ -226,7 +460,7 @@ void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     absl::optional<std::string> cname) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (cname.has_value() && ctx->request_url.host() != *cname &&
+  if (cname.has_value() && ctx->request_url.host_piece() != *cname &&
       !cname->empty()) {
     GURL::Replacements replacements;
     replacements.SetHost(cname->c_str(),
@@ -279,38 +513,87 @@ bool ProxySettingsAllowUncloaking(content::BrowserContext* browser_context) {
   return can_uncloak;
 }
 
-void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
-                                 std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  DCHECK_NE(ctx->request_identifier, 0UL);
-  DCHECK(!ctx->request_url.is_empty());
-  DCHECK(!ctx->initiator_url.is_empty());
-
-  scoped_refptr<base::SequencedTaskRunner> task_runner =
-      g_brave_browser_process->ad_block_service()->GetTaskRunner();
-
+bool ShouldCheckUncloaked(const BraveRequestInfo& ctx) {
   // DoH or standard DNS queries won't be routed through Tor, so we need to
   // skip it.
   // Also, skip CNAME uncloaking if there is currently a configured proxy.
   bool should_check_uncloaked =
       base::FeatureList::IsEnabled(
           brave_shields::features::kBraveAdblockCnameUncloaking) &&
-      ctx->browser_context && !ctx->browser_context->IsTor() &&
-      ProxySettingsAllowUncloaking(ctx->browser_context);
+      ctx.browser_context && !ctx.browser_context->IsTor() &&
+      ProxySettingsAllowUncloaking(ctx.browser_context);
 
   // When default 1p blocking is disabled, first-party requests should not be
   // CNAME uncloaked unless using aggressive blocking mode.
   if (!base::FeatureList::IsEnabled(
           brave_shields::features::kBraveAdblockDefault1pBlocking) &&
-      should_check_uncloaked && !ctx->aggressive_blocking &&
+      should_check_uncloaked && !ctx.aggressive_blocking &&
       SameDomainOrHost(
-          ctx->request_url,
+          ctx.request_url,
           url::Origin::CreateFromNormalizedTuple("https",
-                                                 ctx->initiator_url.host(), 80),
+                                                 ctx.initiator_url.host(), 80),
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
     should_check_uncloaked = false;
   }
 
+  return should_check_uncloaked;
+}
+
+// Whether |ctx| is a first-party request that none of the engines' rules
+// could match, so it can be allowed without a trip to the adblock task
+// runner. Requests that may still need CNAME uncloaking always take the slow
+// path, since the uncloaked host is usually third-party.
+bool CanSkipFirstPartyCheck(const BraveRequestInfo& ctx,
+                            bool should_check_uncloaked) {
+  if (should_check_uncloaked ||
+      !base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockFirstPartyFastPath)) {
+    return false;
+  }
+  if (!SameDomainOrHost(
+          ctx.request_url,
+          url::Origin::CreateFromNormalizedTuple("https",
+                                                 ctx.initiator_url.host(), 80),
+          net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
+    return false;
+  }
+
+  const bool force_aggressive = SameDomainOrHost(
+      ctx.initiator_url,
+      url::Origin::CreateFromNormalizedTuple("https", "youtube.com", 80),
+      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  const bool skip = !g_brave_browser_process->ad_block_service()
+                         ->CouldBlockFirstPartyRequest(
+                             ctx.request_url.host(), ctx.initiator_url.host(),
+                             ctx.aggressive_blocking || force_aggressive);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.FirstPartyFastPath", skip);
+  return skip;
+}
+
+void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
+                                 std::shared_ptr<BraveRequestInfo> ctx,
+                                 bool should_check_uncloaked) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_NE(ctx->request_identifier, 0UL);
+  DCHECK(!ctx->request_url.is_empty());
+  DCHECK(!ctx->initiator_url.is_empty());
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner =
+      g_brave_browser_process->ad_block_service()->GetTaskRunner();
+
+  if (base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockBatchMatching)) {
+    auto* pending_checks = GetPendingAdBlockChecks();
+    // The first check queued since the last flush schedules the next one, so
+    // everything else arriving in the meantime rides along.
+    if (pending_checks->empty()) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(&FlushPendingAdBlockChecks));
+    }
+    pending_checks->push_back({next_callback, ctx, should_check_uncloaked});
+    return;
+  }
+
   task_runner->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, EngineFlags(),
@@ -346,7 +629,11 @@ int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
     return net::OK;
   }
 
-  OnBeforeURLRequestAdBlockTP(next_callback, ctx);
+  const bool should_check_uncloaked = ShouldCheckUncloaked(*ctx);
+  if (CanSkipFirstPartyCheck(*ctx, should_check_uncloaked))
+    return net::OK;
+
+  OnBeforeURLRequestAdBlockTP(next_callback, ctx, should_check_uncloaked);
 
   return net::ERR_IO_PENDING;
 }
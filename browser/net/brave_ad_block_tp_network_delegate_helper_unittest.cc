@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "base/path_service.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/net/url_context.h"
@@ -17,6 +18,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_download_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/test/base/testing_brave_browser_process.h"
 #include "chrome/common/chrome_paths.h"
 #include "content/public/test/browser_task_environment.h"
@@ -89,7 +91,8 @@ class BraveAdBlockTPNetworkDelegateHelperTest : public testing::Test {
         std::make_unique<brave_shields::AdBlockSubscriptionServiceManager>(
             brave_component_updater_delegate_.get(),
             base::BindOnce(&FakeAdBlockSubscriptionDownloadManagerGetter),
-            user_data_dir));
+            user_data_dir),
+        base::FilePath());
 
     TestingBraveBrowserProcess::GetGlobal()->SetAdBlockService(
         std::move(adblock_service));
@@ -188,3 +191,40 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, SimpleBlocking) {
   // made (`browser_context` is `nullptr`).
   EXPECT_EQ(0ULL, host_resolver_->num_resolve());
 }
+
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, FirstPartyFastPath) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      brave_shields::features::kBraveAdblockFirstPartyFastPath);
+  ResetAdblockInstance(g_brave_browser_process->ad_block_service(),
+                       "||tracker.com^\n"
+                       "/ad_banner.$third-party\n"
+                       "||brave.com/ads.js\n",
+                       "");
+
+  // No rule can match a first-party request on example.com, so it's allowed
+  // without waiting on the engines.
+  auto request_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://cdn.example.com/ad_banner.png"));
+  request_info->resource_type = blink::mojom::ResourceType::kImage;
+  request_info->initiator_url = GURL("https://example.com");
+  EXPECT_FALSE(CheckRequest(request_info));
+  EXPECT_EQ(request_info->blocked_by, brave::kNotBlocked);
+
+  // A rule anchored to brave.com sends brave.com's own requests to the
+  // engines.
+  request_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://brave.com/ads.js"));
+  request_info->resource_type = blink::mojom::ResourceType::kScript;
+  request_info->initiator_url = GURL("https://brave.com");
+  EXPECT_TRUE(CheckRequest(request_info));
+  EXPECT_EQ(request_info->blocked_by, brave::kAdBlocked);
+
+  // Third-party requests always go to the engines.
+  request_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://tracker.com/pixel.gif"));
+  request_info->resource_type = blink::mojom::ResourceType::kImage;
+  request_info->initiator_url = GURL("https://example.com");
+  EXPECT_TRUE(CheckRequest(request_info));
+  EXPECT_EQ(request_info->blocked_by, brave::kAdBlocked);
+}
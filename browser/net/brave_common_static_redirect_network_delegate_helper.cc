@@ -5,14 +5,17 @@
 
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "brave/browser/net/url_pattern_host_filter.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_component_updater/browser/features.h"
 #include "brave/components/brave_component_updater/browser/switches.h"
@@ -47,25 +50,32 @@ std::string GetUpdateURLHost() {
   return UPDATER_DEV_ENDPOINT;
 }
 
+const std::vector<URLPattern>& GetUpdaterPatterns() {
+  static const base::NoDestructor<std::vector<URLPattern>> updater_patterns(
+      std::vector<URLPattern>{
+          URLPattern(
+              URLPattern::SCHEME_HTTPS,
+              std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
+          URLPattern(
+              URLPattern::SCHEME_HTTP,
+              std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+          URLPattern(
+              URLPattern::SCHEME_HTTPS,
+              std::string(extension_urls::kChromeWebstoreUpdateURL) + "*"),
+#endif
+      });
+  return *updater_patterns;
+}
+
 // Update server checks happen from the profile context for admin policy
 // installed extensions. Update server checks happen from the system context for
 // normal update operations.
 bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
-#if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
-#endif
-  });
+  const std::vector<URLPattern>& updater_patterns = GetUpdaterPatterns();
   return std::any_of(
       updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+      [&gurl](const URLPattern& pattern) { return pattern.MatchesURL(gurl); });
 }
 
 bool RewriteBugReportingURL(const GURL& request_url, GURL* new_url) {
@@ -123,6 +133,17 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
   static URLPattern bugsChromium_pattern(
       URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS,
       "*://bugs.chromium.org/p/chromium/issues/entry?*");
+  static const base::NoDestructor<URLPatternHostFilter> host_filter([] {
+    URLPatternHostFilter filter;
+    for (const URLPattern& pattern : GetUpdaterPatterns())
+      filter.Add(pattern);
+    filter.Add(chromecast_pattern);
+    filter.Add(clients4_pattern);
+    filter.Add(bugsChromium_pattern);
+    return filter;
+  }());
+  if (!host_filter->MayMatch(request_url))
+    return net::OK;
 
   if (IsUpdaterURL(request_url)) {
     auto update_host = GetUpdateURLHost();
@@ -11,6 +11,7 @@
 
 #include "base/task/post_task.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
@@ -24,6 +25,8 @@ using content::BrowserThread;
 namespace brave {
 
 void OnBeforeURLRequest_HttpseFileWork(std::shared_ptr<BraveRequestInfo> ctx) {
+  TRACE_EVENT1("browser", "OnBeforeURLRequest_HttpseFileWork", "request_id",
+               ctx->request_identifier);
   base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
                                                 base::BlockingType::WILL_BLOCK);
   DCHECK_NE(ctx->request_identifier, 0U);
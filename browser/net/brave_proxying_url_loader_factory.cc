@@ -38,7 +38,7 @@ namespace {
 // Helper struct for crafting responses.
 struct WriteData {
   base::WeakPtr<network::mojom::URLLoaderClient> client;
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   std::unique_ptr<mojo::DataPipeProducer> producer;
 };
 
@@ -48,9 +48,9 @@ void OnWrite(std::unique_ptr<WriteData> write_data, MojoResult result) {
   }
 
   network::URLLoaderCompletionStatus status(net::OK);
-  status.encoded_data_length = write_data->data.size();
-  status.encoded_body_length = write_data->data.size();
-  status.decoded_body_length = write_data->data.size();
+  status.encoded_data_length = write_data->data->size();
+  status.encoded_body_length = write_data->data->size();
+  status.decoded_body_length = write_data->data->size();
   write_data->client->OnComplete(status);
 }
 
@@ -358,7 +358,7 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
     }
 
     auto response = network::mojom::URLResponseHead::New();
-    std::string response_data;
+    scoped_refptr<base::RefCountedString> response_data;
     brave_shields::MakeStubResponse(ctx_->mock_data_url, request_, &response,
                                     &response_data);
 
@@ -378,11 +378,11 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
 
     auto write_data = std::make_unique<WriteData>();
     write_data->client = weak_factory_.GetWeakPtr();
-    write_data->data = response_data;
+    write_data->data = std::move(response_data);
     write_data->producer =
         std::make_unique<mojo::DataPipeProducer>(std::move(producer));
 
-    base::StringPiece string_piece(write_data->data);
+    base::StringPiece string_piece(write_data->data->data());
     write_data->producer->Write(
         std::make_unique<mojo::StringDataSource>(
             string_piece, mojo::StringDataSource::AsyncWritingMode::
@@ -395,9 +395,11 @@ void BraveProxyingURLLoaderFactory::InProgressRequest::
     auto continuation = base::BindRepeating(
         &InProgressRequest::ContinueToSendHeaders, weak_factory_.GetWeakPtr());
 
-    ctx_ = brave::BraveRequestInfo::MakeCTX(request_, render_process_id_,
-                                            frame_tree_node_id_, request_id_,
-                                            browser_context_, ctx_);
+    // |ctx_| was built for this very request in RestartInternal(), so only
+    // refresh what OnBeforeURLRequest may have changed instead of redoing
+    // the shields lookups.
+    ctx_->referrer = request_.referrer;
+    ctx_->new_referrer.reset();
     int result = factory_->request_handler_->OnBeforeStartTransaction(
         ctx_, continuation, &request_.headers);
 
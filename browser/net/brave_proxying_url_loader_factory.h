@@ -9,12 +9,12 @@
 #include <cstdint>
 #include <map>
 #include <memory>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/callback.h"
+#include "base/containers/flat_set.h"
 #include "base/containers/unique_ptr_adapters.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted_delete_on_sequence.h"
@@ -223,7 +223,7 @@ class BraveProxyingURLLoaderFactory
   mojo::ReceiverSet<network::mojom::URLLoaderFactory> proxy_receivers_;
   network::mojom::URLLoaderFactoryPtr target_factory_;
 
-  std::set<std::unique_ptr<InProgressRequest>, base::UniquePtrComparator>
+  base::flat_set<std::unique_ptr<InProgressRequest>, base::UniquePtrComparator>
       requests_;
 
   scoped_refptr<RequestIDGenerator> request_id_generator_;
@@ -206,7 +206,10 @@ void BraveProxyingWebSocket::OnConnectionEstablished(
       std::move(websocket), std::move(client_receiver), std::move(response),
       std::move(readable), std::move(writable));
 
-  OnError(net::ERR_FAILED);
+  // The WebSocket remote/receiver pair and both data pipes were handed to the
+  // renderer untouched above, so frames flow between it and the network
+  // service directly. Nothing is left for the proxy to do past the handshake.
+  OnError(net::OK);
 }
 
 void BraveProxyingWebSocket::OnAuthRequired(
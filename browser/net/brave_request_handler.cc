@@ -10,7 +10,9 @@
 
 #include "base/containers/contains.h"
 #include "base/feature_list.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/net/brave_ad_block_csp_network_delegate_helper.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
@@ -20,6 +22,7 @@
 #include "brave/browser/net/brave_stp_util.h"
 #include "brave/browser/net/global_privacy_control_network_delegate_helper.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
+#include "brave/common/brave_features.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "brave/components/brave_rewards/browser/net/network_delegate_helper.h"
@@ -50,6 +53,7 @@
 #if BUILDFLAG(ENABLE_IPFS)
 #include "brave/browser/net/ipfs_redirect_network_delegate_helper.h"
 #include "brave/components/ipfs/features.h"
+#include "brave/components/ipfs/ipfs_constants.h"
 #endif
 
 #if BUILDFLAG(DECENTRALIZED_DNS_ENABLED)
@@ -62,6 +66,70 @@ static bool IsInternalScheme(std::shared_ptr<brave::BraveRequestInfo> ctx) {
          ctx->request_url.SchemeIs(content::kChromeUIScheme);
 }
 
+// The predicates below mirror the early returns at the top of each helper.
+// Keep them in sync when changing those.
+
+static bool IsEligibleForAdBlock(const brave::BraveRequestInfo& ctx) {
+  return ctx.allow_brave_shields && !ctx.allow_ads &&
+         !ctx.request_url.is_empty() && ctx.initiator_url.has_host() &&
+         ctx.resource_type != brave::BraveRequestInfo::kInvalidResourceType &&
+         ctx.resource_type != blink::mojom::ResourceType::kMainFrame;
+}
+
+static bool IsEligibleForHttpse(const brave::BraveRequestInfo& ctx) {
+  return ctx.allow_brave_shields && !ctx.allow_http_upgradable_resource &&
+         !ctx.tab_origin.is_empty() && ctx.request_url.SchemeIsHTTPOrHTTPS();
+}
+
+static bool IsEligibleForRewards(const brave::BraveRequestInfo& ctx) {
+  return !ctx.upload_data.empty();
+}
+
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+static bool IsEligibleForTranslateRedirect(const brave::BraveRequestInfo& ctx) {
+  return brave::IsTranslateRedirectCandidate(ctx.request_url);
+}
+#endif
+
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+static bool IsEligibleForTorrentRedirect(const brave::BraveRequestInfo& ctx) {
+  return ctx.resource_type == blink::mojom::ResourceType::kMainFrame &&
+         !ctx.is_webtorrent_disabled;
+}
+#endif
+
+#if BUILDFLAG(ENABLE_IPFS)
+static bool IsEligibleForIPFS(const brave::BraveRequestInfo& ctx) {
+  return ctx.request_url.SchemeIs(ipfs::kIPFSScheme) ||
+         ctx.request_url.SchemeIs(ipfs::kIPNSScheme);
+}
+#endif
+
+BraveRequestHandler::BeforeURLRequestHelper::BeforeURLRequestHelper(
+    brave::OnBeforeURLRequestCallback callback,
+    const char* histogram_name,
+    EligibilityPredicate is_eligible)
+    : callback(std::move(callback)),
+      histogram_name(histogram_name),
+      is_eligible(is_eligible) {}
+
+BraveRequestHandler::BeforeURLRequestHelper::BeforeURLRequestHelper(
+    const BeforeURLRequestHelper&) = default;
+
+BraveRequestHandler::BeforeURLRequestHelper::~BeforeURLRequestHelper() =
+    default;
+
+BraveRequestHandler::HeadersReceivedHelper::HeadersReceivedHelper(
+    brave::OnHeadersReceivedCallback callback,
+    EligibilityPredicate is_eligible)
+    : callback(std::move(callback)), is_eligible(is_eligible) {}
+
+BraveRequestHandler::HeadersReceivedHelper::HeadersReceivedHelper(
+    const HeadersReceivedHelper&) = default;
+
+BraveRequestHandler::HeadersReceivedHelper::~HeadersReceivedHelper() =
+    default;
+
 BraveRequestHandler::BraveRequestHandler() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   SetupCallbacks();
@@ -69,43 +137,72 @@ BraveRequestHandler::BraveRequestHandler() {
 
 BraveRequestHandler::~BraveRequestHandler() = default;
 
+void BraveRequestHandler::AddBeforeURLRequestHelper(
+    brave::OnBeforeURLRequestCallback callback,
+    const char* histogram_name,
+    EligibilityPredicate is_eligible) {
+  if (!base::FeatureList::IsEnabled(
+          ::features::kBraveRequestHandlerEligibilityChecks)) {
+    is_eligible = nullptr;
+  }
+  before_url_request_callbacks_.emplace_back(std::move(callback),
+                                             histogram_name, is_eligible);
+}
+
+void BraveRequestHandler::AddHeadersReceivedHelper(
+    brave::OnHeadersReceivedCallback callback,
+    EligibilityPredicate is_eligible) {
+  if (!base::FeatureList::IsEnabled(
+          ::features::kBraveRequestHandlerEligibilityChecks)) {
+    is_eligible = nullptr;
+  }
+  headers_received_callbacks_.emplace_back(std::move(callback), is_eligible);
+}
+
 void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork),
+      "Brave.RequestHandler.OnBeforeURLRequest.SiteHacks", nullptr);
 
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork),
+      "Brave.RequestHandler.OnBeforeURLRequest.AdBlock", &IsEligibleForAdBlock);
 
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork),
+      "Brave.RequestHandler.OnBeforeURLRequest.Httpse", &IsEligibleForHttpse);
 
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork),
+      "Brave.RequestHandler.OnBeforeURLRequest.CommonStaticRedirect", nullptr);
 
 #if BUILDFLAG(DECENTRALIZED_DNS_ENABLED) && BUILDFLAG(BRAVE_WALLET_ENABLED)
-  callback = base::BindRepeating(
-      decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(
+          decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork),
+      "Brave.RequestHandler.OnBeforeURLRequest.DecentralizedDns", nullptr);
 #endif
 
-  callback = base::BindRepeating(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(brave_rewards::OnBeforeURLRequest),
+      "Brave.RequestHandler.OnBeforeURLRequest.Rewards", &IsEligibleForRewards);
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  AddBeforeURLRequestHelper(
+      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork),
+      "Brave.RequestHandler.OnBeforeURLRequest.TranslateRedirect",
+      &IsEligibleForTranslateRedirect);
 #endif
 
 #if BUILDFLAG(ENABLE_IPFS)
   if (base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature)) {
-    callback = base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork);
-    before_url_request_callbacks_.push_back(callback);
-    brave::OnHeadersReceivedCallback ipfs_headers_received_callback =
-        base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork);
-    headers_received_callbacks_.push_back(ipfs_headers_received_callback);
+    AddBeforeURLRequestHelper(
+        base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork),
+        "Brave.RequestHandler.OnBeforeURLRequest.IPFSRedirect",
+        &IsEligibleForIPFS);
+    AddHeadersReceivedHelper(
+        base::BindRepeating(ipfs::OnHeadersReceived_IPFSRedirectWork),
+        nullptr);
   }
 #endif
 
@@ -128,16 +225,16 @@ void BraveRequestHandler::SetupCallbacks() {
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+  AddHeadersReceivedHelper(
+      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork),
+      &IsEligibleForTorrentRedirect);
 #endif
 
   if (base::FeatureList::IsEnabled(
           ::brave_shields::features::kBraveAdblockCspRules)) {
-    brave::OnHeadersReceivedCallback headers_received_callback2 =
-        base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork);
-    headers_received_callbacks_.push_back(headers_received_callback2);
+    AddHeadersReceivedHelper(
+        base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork),
+        nullptr);
   }
 }
 
@@ -155,7 +252,8 @@ int BraveRequestHandler::OnBeforeURLRequest(
   }
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
+  ctx->next_url_request_index = 0;
+  AddCallback(*ctx, std::move(callback));
   RunNextCallback(ctx);
   return net::ERR_IO_PENDING;
 }
@@ -168,8 +266,9 @@ int BraveRequestHandler::OnBeforeStartTransaction(
     return net::OK;
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
+  ctx->next_url_request_index = 0;
   ctx->headers = headers;
-  callbacks_[ctx->request_identifier] = std::move(callback);
+  AddCallback(*ctx, std::move(callback));
   RunNextCallback(ctx);
   return net::ERR_IO_PENDING;
 }
@@ -192,8 +291,9 @@ int BraveRequestHandler::OnHeadersReceived(
     return net::OK;
   }
 
-  callbacks_[ctx->request_identifier] = std::move(callback);
   ctx->event_type = brave::kOnHeadersReceived;
+  AddCallback(*ctx, std::move(callback));
+  ctx->next_url_request_index = 0;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
@@ -204,16 +304,45 @@ int BraveRequestHandler::OnHeadersReceived(
 
 void BraveRequestHandler::OnURLRequestDestroyed(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  if (base::Contains(callbacks_, ctx->request_identifier)) {
-    callbacks_.erase(ctx->request_identifier);
+  auto it = callbacks_.find(ctx->request_identifier);
+  if (it != callbacks_.end()) {
+    if (it->second)
+      OnCallbackDone(ctx->request_identifier);
+    callbacks_.erase(it);
   }
 }
 
+void BraveRequestHandler::AddCallback(const brave::BraveRequestInfo& ctx,
+                                      net::CompletionOnceCallback callback) {
+  // A request only has one event in flight, so any earlier callback for it
+  // has already run.
+  DCHECK(!IsRequestIdentifierValid(ctx.request_identifier) ||
+         !callbacks_[ctx.request_identifier]);
+  callbacks_[ctx.request_identifier] = std::move(callback);
+  pending_callback_count_++;
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+      "browser", "BraveRequestHandler",
+      TRACE_ID_LOCAL(ctx.request_identifier), "event_type",
+      static_cast<int>(ctx.event_type));
+  TRACE_COUNTER1("browser", "BraveRequestHandler.PendingCallbacks",
+                 pending_callback_count_);
+}
+
+void BraveRequestHandler::OnCallbackDone(uint64_t request_identifier) {
+  DCHECK_GT(pending_callback_count_, 0u);
+  pending_callback_count_--;
+  TRACE_EVENT_NESTABLE_ASYNC_END0("browser", "BraveRequestHandler",
+                                  TRACE_ID_LOCAL(request_identifier));
+  TRACE_COUNTER1("browser", "BraveRequestHandler.PendingCallbacks",
+                 pending_callback_count_);
+}
+
 void BraveRequestHandler::RunCallbackForRequestIdentifier(
     uint64_t request_identifier,
     int rv) {
   std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
       callbacks_.find(request_identifier);
+  OnCallbackDone(request_identifier);
   // We intentionally do the async call to maintain the proper flow
   // of URLLoader callbacks.
   base::PostTask(FROM_HERE, {content::BrowserThread::UI},
@@ -236,12 +365,29 @@ void BraveRequestHandler::RunNextCallback(
   if (ctx->event_type == brave::kOnBeforeRequest) {
     while (before_url_request_callbacks_.size() !=
            ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
+      const BeforeURLRequestHelper& helper =
           before_url_request_callbacks_[ctx->next_url_request_index++];
+      if (helper.is_eligible && !helper.is_eligible(*ctx)) {
+        continue;
+      }
+      brave::OnBeforeURLRequestCallback callback = helper.callback;
+      const char* histogram_name = helper.histogram_name;
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(next_callback, ctx);
+      const base::TimeTicks start_time = base::TimeTicks::Now();
+      {
+        // The histogram names double as trace event names.
+        TRACE_EVENT1("browser", histogram_name, "request_id",
+                     ctx->request_identifier);
+        rv = callback.Run(next_callback, ctx);
+      }
+      // For helpers that go async this only covers the time spent on the UI
+      // thread before handing off.
+      base::UmaHistogramCustomMicrosecondsTimes(
+          histogram_name, base::TimeTicks::Now() - start_time,
+          base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+          50);
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -257,7 +403,13 @@ void BraveRequestHandler::RunNextCallback(
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
+      {
+        TRACE_EVENT2("browser",
+                     "BraveRequestHandler::OnBeforeStartTransaction helper",
+                     "request_id", ctx->request_identifier, "helper",
+                     ctx->next_url_request_index - 1);
+        rv = callback.Run(ctx->headers, next_callback, ctx);
+      }
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -267,14 +419,25 @@ void BraveRequestHandler::RunNextCallback(
     }
   } else if (ctx->event_type == brave::kOnHeadersReceived) {
     while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
+      const HeadersReceivedHelper& helper =
           headers_received_callbacks_[ctx->next_url_request_index++];
+      if (helper.is_eligible && !helper.is_eligible(*ctx)) {
+        continue;
+      }
+      brave::OnHeadersReceivedCallback callback = helper.callback;
       brave::ResponseCallback next_callback =
           base::BindRepeating(&BraveRequestHandler::RunNextCallback,
                               weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+      {
+        TRACE_EVENT2("browser",
+                     "BraveRequestHandler::OnHeadersReceived helper",
+                     "request_id", ctx->request_identifier, "helper",
+                     ctx->next_url_request_index - 1);
+        rv = callback.Run(ctx->original_response_headers,
+                          ctx->override_response_headers,
+                          ctx->allowed_unsafe_redirect_url, next_callback,
+                          ctx);
+      }
       if (rv == net::ERR_IO_PENDING) {
         return;
       }
@@ -44,15 +44,58 @@ class BraveRequestHandler {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
+  // Returns false for requests the helper is known to leave untouched, so the
+  // chain can skip it.
+  using EligibilityPredicate = bool (*)(const brave::BraveRequestInfo& ctx);
+
+  struct BeforeURLRequestHelper {
+    BeforeURLRequestHelper(brave::OnBeforeURLRequestCallback callback,
+                           const char* histogram_name,
+                           EligibilityPredicate is_eligible);
+    BeforeURLRequestHelper(const BeforeURLRequestHelper&);
+    ~BeforeURLRequestHelper();
+
+    brave::OnBeforeURLRequestCallback callback;
+    // Records the synchronous cost of |callback|.
+    const char* histogram_name;
+    // May be null, in which case the helper runs for every request.
+    EligibilityPredicate is_eligible;
+  };
+
+  struct HeadersReceivedHelper {
+    HeadersReceivedHelper(brave::OnHeadersReceivedCallback callback,
+                          EligibilityPredicate is_eligible);
+    HeadersReceivedHelper(const HeadersReceivedHelper&);
+    ~HeadersReceivedHelper();
+
+    brave::OnHeadersReceivedCallback callback;
+    // May be null, in which case the helper runs for every response.
+    EligibilityPredicate is_eligible;
+  };
+
   void SetupCallbacks();
+  void AddBeforeURLRequestHelper(brave::OnBeforeURLRequestCallback callback,
+                                 const char* histogram_name,
+                                 EligibilityPredicate is_eligible);
+  void AddHeadersReceivedHelper(brave::OnHeadersReceivedCallback callback,
+                                EligibilityPredicate is_eligible);
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Stores |callback| for |ctx| and opens the request's async trace span,
+  // which OnCallbackDone closes.
+  void AddCallback(const brave::BraveRequestInfo& ctx,
+                   net::CompletionOnceCallback callback);
+  void OnCallbackDone(uint64_t request_identifier);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
+  std::vector<BeforeURLRequestHelper> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  std::vector<HeadersReceivedHelper> headers_received_callbacks_;
 
+  // Entries stay until the request is destroyed; the callback is null once
+  // it has been run.
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  // The number of non-null callbacks in |callbacks_|, for tracing.
+  size_t pending_callback_count_ = 0;
 
   base::WeakPtrFactory<BraveRequestHandler> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(BraveRequestHandler);
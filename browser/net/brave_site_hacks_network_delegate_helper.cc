@@ -9,9 +9,8 @@
 #include <string>
 #include <vector>
 
-#include "base/lazy_instance.h"
+#include "base/containers/fixed_flat_set.h"
 #include "base/metrics/histogram_macros.h"
-#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "brave/common/url_constants.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -20,75 +19,56 @@
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/common/loader/network_utils.h"
 #include "third_party/blink/public/common/loader/referrer_utils.h"
-#include "third_party/re2/src/re2/re2.h"
 
 namespace brave {
 
 namespace {
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
-      std::vector<std::string>(
-          {// https://github.com/brave/brave-browser/issues/4239
-           "fbclid", "gclid", "msclkid", "mc_eid",
-           // https://github.com/brave/brave-browser/issues/9879
-           "dclid",
-           // https://github.com/brave/brave-browser/issues/13644
-           "oly_anon_id", "oly_enc_id",
-           // https://github.com/brave/brave-browser/issues/11579
-           "_openstat",
-           // https://github.com/brave/brave-browser/issues/11817
-           "vero_conv", "vero_id",
-           // https://github.com/brave/brave-browser/issues/13647
-           "wickedid",
-           // https://github.com/brave/brave-browser/issues/11578
-           "yclid",
-           // https://github.com/brave/brave-browser/issues/8975
-           "__s",
-           // https://github.com/brave/brave-browser/issues/17451
-           "rb_clickid",
-           // https://github.com/brave/brave-browser/issues/17452
-           "s_cid",
-           // https://github.com/brave/brave-browser/issues/17507
-           "ml_subscriber", "ml_subscriber_hash",
-           // https://github.com/brave/brave-browser/issues/18020
-           "twclid",
-           // https://github.com/brave/brave-browser/issues/9019
-           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}),
-      "|"));
-  return *trackers;
+// Lower-cased, since query keys are matched case-insensitively.
+constexpr auto kQueryStringTrackers = base::MakeFixedFlatSet<base::StringPiece>(
+    {// https://github.com/brave/brave-browser/issues/4239
+     "fbclid", "gclid", "msclkid", "mc_eid",
+     // https://github.com/brave/brave-browser/issues/9879
+     "dclid",
+     // https://github.com/brave/brave-browser/issues/13644
+     "oly_anon_id", "oly_enc_id",
+     // https://github.com/brave/brave-browser/issues/11579
+     "_openstat",
+     // https://github.com/brave/brave-browser/issues/11817
+     "vero_conv", "vero_id",
+     // https://github.com/brave/brave-browser/issues/13647
+     "wickedid",
+     // https://github.com/brave/brave-browser/issues/11578
+     "yclid",
+     // https://github.com/brave/brave-browser/issues/8975
+     "__s",
+     // https://github.com/brave/brave-browser/issues/17451
+     "rb_clickid",
+     // https://github.com/brave/brave-browser/issues/17452
+     "s_cid",
+     // https://github.com/brave/brave-browser/issues/17507
+     "ml_subscriber", "ml_subscriber_hash",
+     // https://github.com/brave/brave-browser/issues/18020
+     "twclid",
+     // https://github.com/brave/brave-browser/issues/9019
+     "_hsenc", "__hssc", "__hstc", "__hsfp", "hsctatracking"});
+
+// Longest entry in kQueryStringTrackers; longer keys are never lower-cased.
+constexpr size_t kMaxQueryStringTrackerLength = 18;
+
+// A parameter is only stripped when it has a non-empty value, e.g. "fbclid=1"
+// but not "fbclid" or "fbclid=".
+bool IsQueryStringTracker(base::StringPiece param) {
+  const size_t separator = param.find('=');
+  if (separator == base::StringPiece::npos || separator == 0 ||
+      separator > kMaxQueryStringTrackerLength ||
+      separator + 1 == param.size()) {
+    return false;
+  }
+  return kQueryStringTrackers.contains(
+      base::ToLowerASCII(param.substr(0, separator)));
 }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
-
 void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
 
@@ -118,26 +98,15 @@ void ApplyPotentialQueryStringFilter(std::shared_ptr<BraveRequestInfo> ctx) {
     return;
   }
 
-  // Regular expressions are dirty and error-prone, but unfortunately
-  // there is no right way to parse a query string, other than one
-  // generated by a URL-encoded HTML form submission. See
-  // https://github.com/brave/brave-core/pull/3239#issuecomment-524073918
-  // for more information on why this approach was selected.
-
-  std::string new_query = ctx->request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
-
-  if (replacement_count > 0) {
+  const absl::optional<std::string> new_query =
+      StripQueryStringTrackers(ctx->request_url.query_piece());
+  if (new_query) {
     url::Replacements<char> replacements;
-    if (new_query.empty()) {
+    if (new_query->empty()) {
       replacements.ClearQuery();
     } else {
-      replacements.SetQuery(new_query.c_str(),
-                            url::Component(0, new_query.size()));
+      replacements.SetQuery(new_query->c_str(),
+                            url::Component(0, new_query->size()));
     }
     ctx->new_url_spec = ctx->request_url.ReplaceComponents(replacements).spec();
   }
@@ -166,6 +135,40 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
 
 }  // namespace
 
+absl::optional<std::string> StripQueryStringTrackers(base::StringPiece query) {
+  // There is no right way to parse a query string, other than one generated
+  // by a URL-encoded HTML form submission, so this sticks to the narrowest
+  // reading: parameters are separated by '&' and everything else, including
+  // empty parameters and their order, is preserved byte for byte. See
+  // https://github.com/brave/brave-core/pull/3239#issuecomment-524073918
+  absl::optional<std::string> new_query;
+  bool has_kept_param = false;
+  size_t param_start = 0;
+  while (param_start <= query.size()) {
+    size_t param_end = query.find('&', param_start);
+    if (param_end == base::StringPiece::npos)
+      param_end = query.size();
+    const base::StringPiece param =
+        query.substr(param_start, param_end - param_start);
+
+    if (IsQueryStringTracker(param)) {
+      if (!new_query) {
+        // Everything before the first tracker is kept as is.
+        has_kept_param = param_start > 0;
+        new_query.emplace(
+            query.substr(0, has_kept_param ? param_start - 1 : 0));
+      }
+    } else if (new_query) {
+      if (has_kept_param)
+        new_query->push_back('&');
+      new_query->append(param.data(), param.size());
+      has_kept_param = true;
+    }
+    param_start = param_end + 1;
+  }
+  return new_query;
+}
+
 int OnBeforeURLRequest_SiteHacksWork(const ResponseCallback& next_callback,
                                      std::shared_ptr<BraveRequestInfo> ctx) {
   ApplyPotentialReferrerBlock(ctx);
@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/stl_util.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "third_party/re2/src/re2/re2.h"
+
+// Compares StripQueryStringTrackers against the three RE2::GlobalReplace
+// passes it replaced, over a mix of queries with and without trackers.
+
+namespace brave {
+
+namespace {
+
+const char kMetricPrefix[] = "QueryStringFilter.";
+const char kMetricTimePerQuery[] = "time_per_query";
+
+constexpr int kIterations = 20000;
+
+const char* const kQueries[] = {
+    "",
+    "foo=1&bar=2",
+    "q=brave+browser&source=hp&ei=abcdef&iflsig=123456&oq=brave&sclient=gws",
+    "fbclid=IwAR2abcdefghijklmnopqrstuvwxyz0123456789",
+    "utm_source=newsletter&utm_medium=email&mc_eid=12345&mc_cid=abcde",
+    "foo=1&gclid=Cj0KCQjw&bar=2&msclkid=abc&baz=3",
+    "fbclid=1&1==2&=msclkid&foo=bar&&a=b=c&",
+    "__hstc=1.2.3&__hssc=4.5&__hsfp=6&hsCtaTracking=7&_hsenc=8&page=2",
+};
+
+// The matching that StripQueryStringTrackers replaced.
+const char kRegexTrackers[] =
+    "fbclid|gclid|msclkid|mc_eid|dclid|oly_anon_id|oly_enc_id|_openstat|"
+    "vero_conv|vero_id|wickedid|yclid|__s|rb_clickid|s_cid|ml_subscriber|"
+    "ml_subscriber_hash|twclid|_hsenc|__hssc|__hstc|__hsfp|hsCtaTracking";
+
+class RegexQueryStringFilter {
+ public:
+  RegexQueryStringFilter()
+      : only_(std::string("^(") + kRegexTrackers + ")=[^&]+$", Options()),
+        first_(std::string("^(") + kRegexTrackers + ")=[^&]+&", Options()),
+        appended_(std::string("&(") + kRegexTrackers + ")=[^&]+",
+                  Options()) {}
+
+  bool Filter(std::string* query) const {
+    return re2::RE2::GlobalReplace(query, appended_, "") +
+               re2::RE2::GlobalReplace(query, first_, "") +
+               re2::RE2::GlobalReplace(query, only_, "") >
+           0;
+  }
+
+ private:
+  static re2::RE2::Options Options() {
+    re2::RE2::Options options;
+    options.set_case_sensitive(false);
+    return options;
+  }
+
+  re2::RE2 only_;
+  re2::RE2 first_;
+  re2::RE2 appended_;
+};
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricTimePerQuery, "ns");
+  return reporter;
+}
+
+}  // namespace
+
+TEST(QueryStringFilterPerfTest, MatchesRegex) {
+  RegexQueryStringFilter regex;
+  for (const char* query : kQueries) {
+    std::string expected = query;
+    const bool changed = regex.Filter(&expected);
+    const absl::optional<std::string> actual = StripQueryStringTrackers(query);
+    EXPECT_EQ(changed, actual.has_value()) << query;
+    if (actual)
+      EXPECT_EQ(expected, *actual) << query;
+  }
+}
+
+TEST(QueryStringFilterPerfTest, Regex) {
+  RegexQueryStringFilter regex;
+  perf_test::PerfResultReporter reporter = SetUpReporter("regex");
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (const char* query : kQueries) {
+      std::string copy = query;
+      regex.Filter(&copy);
+    }
+  }
+  reporter.AddResult(kMetricTimePerQuery,
+                     timer.Elapsed().InMicrosecondsF() * 1000 /
+                         (kIterations * base::size(kQueries)));
+}
+
+TEST(QueryStringFilterPerfTest, Tokenizer) {
+  perf_test::PerfResultReporter reporter = SetUpReporter("tokenizer");
+  base::ElapsedTimer timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (const char* query : kQueries)
+      StripQueryStringTrackers(query);
+  }
+  reporter.AddResult(kMetricTimePerQuery,
+                     timer.Elapsed().InMicrosecondsF() * 1000 /
+                         (kIterations * base::size(kQueries)));
+}
+
+}  // namespace brave
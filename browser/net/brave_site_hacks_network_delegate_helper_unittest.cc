@@ -247,3 +247,17 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
     EXPECT_EQ(brave_request_info->new_url_spec, "https://example.com/");
   }
 }
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest, StripQueryStringTrackers) {
+  EXPECT_FALSE(brave::StripQueryStringTrackers(""));
+  EXPECT_FALSE(brave::StripQueryStringTrackers("foo=1&bar=2"));
+  EXPECT_FALSE(brave::StripQueryStringTrackers("fbclid=&gclid"));
+  EXPECT_FALSE(brave::StripQueryStringTrackers("ml_subscriber_hash_x=1"));
+
+  EXPECT_EQ(brave::StripQueryStringTrackers("FBCLID=1"), "");
+  EXPECT_EQ(brave::StripQueryStringTrackers("hsCtaTracking=1&foo=2"), "foo=2");
+  EXPECT_EQ(brave::StripQueryStringTrackers("foo=1&fbclid=2&&bar=3&gclid=4"),
+            "foo=1&&bar=3");
+  EXPECT_EQ(brave::StripQueryStringTrackers("&fbclid=1&foo"), "&foo");
+  EXPECT_EQ(brave::StripQueryStringTrackers("fbclid=1&&"), "&");
+}
@@ -30,7 +30,7 @@ bool IsViewerURL(const GURL& url) {
 
 bool IsWebtorrentInitiated(std::shared_ptr<brave::BraveRequestInfo> ctx) {
   return ctx->initiator_url.scheme() == extensions::kExtensionScheme &&
-      ctx->initiator_url.host() == brave_webtorrent_extension_id;
+      ctx->initiator_url.host_piece() == brave_webtorrent_extension_id;
 }
 
 // Returns true if the resource type is a frame (i.e. a top level page) or a
@@ -8,15 +8,33 @@
 #include <memory>
 #include <string>
 #include <vector>
+
+#include "base/containers/fixed_flat_set.h"
+#include "base/strings/string_piece.h"
 #include "brave/common/translate_network_constants.h"
 #include "extensions/common/url_pattern.h"
+#include "url/url_constants.h"
 
 namespace {
 const char kTranslateElementLibQuery[] = "client=te_lib";
-}
+
+// The hosts of every pattern in translate_network_constants.h. Keep in sync
+// when adding a pattern.
+constexpr auto kTranslateRedirectHosts =
+    base::MakeFixedFlatSet<base::StringPiece>({
+        "translate.google.com",
+        "translate.googleapis.com",
+        "www.gstatic.com",
+    });
+}  // namespace
 
 namespace brave {
 
+bool IsTranslateRedirectCandidate(const GURL& url) {
+  return url.SchemeIs(url::kHttpsScheme) &&
+         kTranslateRedirectHosts.contains(url.host_piece());
+}
+
 bool IsTranslateScriptRequest(const GURL& gurl) {
   static std::vector<URLPattern> translate_patterns({
       URLPattern(URLPattern::SCHEME_HTTPS, kTranslateElementMainJSPattern),
@@ -57,6 +75,9 @@ bool IsTranslateGen204Request(const GURL& gurl) {
 int OnBeforeURLRequest_TranslateRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
+  if (!IsTranslateRedirectCandidate(ctx->request_url))
+    return net::OK;
+
   GURL::Replacements replacements;
 
   // Abort those gen204 requests triggered by translate element library.
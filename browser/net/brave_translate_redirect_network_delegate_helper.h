@@ -9,8 +9,14 @@
 #include <memory>
 #include "brave/browser/net/url_context.h"
 
+class GURL;
+
 namespace brave {
 
+// Whether |url| is on one of the hosts the translate redirect handles. A
+// single set lookup, so callers can skip the helper for everything else.
+bool IsTranslateRedirectCandidate(const GURL& url);
+
 int OnBeforeURLRequest_TranslateRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx);
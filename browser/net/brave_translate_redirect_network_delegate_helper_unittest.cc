@@ -220,4 +220,22 @@ TEST_F(BraveTranslateRedirectNetworkDelegateHelperTest,
   EXPECT_EQ(ret, net::OK);
 }
 
+TEST_F(BraveTranslateRedirectNetworkDelegateHelperTest,
+       RedirectCandidateHosts) {
+  EXPECT_TRUE(brave::IsTranslateRedirectCandidate(
+      GURL("https://translate.googleapis.com/translate_a/t")));
+  EXPECT_TRUE(brave::IsTranslateRedirectCandidate(
+      GURL("https://translate.google.com/gen204")));
+  EXPECT_TRUE(brave::IsTranslateRedirectCandidate(GURL(
+      "https://www.gstatic.com/images/branding/product/1x/"
+      "translate_24dp.png")));
+  EXPECT_FALSE(brave::IsTranslateRedirectCandidate(
+      GURL("http://translate.googleapis.com/translate_a/t")));
+  EXPECT_FALSE(brave::IsTranslateRedirectCandidate(
+      GURL("https://gstatic.com/images/branding/product/1x/"
+           "translate_24dp.png")));
+  EXPECT_FALSE(
+      brave::IsTranslateRedirectCandidate(GURL("https://www.brave.com/")));
+}
+
 }  // namespace
@@ -8,6 +8,11 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/memory/ptr_util.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_wallet/rpc_controller_factory.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
@@ -24,10 +29,181 @@ namespace decentralized_dns {
 
 namespace {
 
+// How long a resolved name is served without asking the chain again, and how
+// long past that it may still be served while a refresh runs.
+constexpr base::TimeDelta kResolvedTTL = base::TimeDelta::FromMinutes(10);
+constexpr base::TimeDelta kNoRecordTTL = base::TimeDelta::FromMinutes(1);
+constexpr base::TimeDelta kStaleWindow = base::TimeDelta::FromHours(1);
+
+const void* const kResolutionCacheKey = &kResolutionCacheKey;
+
+struct PendingRequest {
+  brave::ResponseCallback next_callback;
+  std::shared_ptr<brave::BraveRequestInfo> ctx;
+};
+
+// Per-profile cache of decentralized DNS lookups, keyed by host. An empty
+// |new_url_spec| records that the name has no usable record.
+class ResolutionCache : public base::SupportsUserData::Data {
+ public:
+  ResolutionCache() = default;
+  ~ResolutionCache() override = default;
+
+  static ResolutionCache* FromContext(content::BrowserContext* context) {
+    auto* cache = static_cast<ResolutionCache*>(
+        context->GetUserData(kResolutionCacheKey));
+    if (!cache) {
+      cache = new ResolutionCache();
+      context->SetUserData(kResolutionCacheKey, base::WrapUnique(cache));
+    }
+    return cache;
+  }
+
+  // Returns true if |host| has an entry; |stale| is set once it has expired
+  // and should be refreshed.
+  bool Lookup(const std::string& host, std::string* new_url_spec, bool* stale) {
+    auto it = entries_.find(host);
+    if (it == entries_.end())
+      return false;
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (now > it->second.expiration + kStaleWindow) {
+      entries_.erase(it);
+      return false;
+    }
+    *new_url_spec = it->second.new_url_spec;
+    *stale = now > it->second.expiration;
+    return true;
+  }
+
+  void Store(const std::string& host, const std::string& new_url_spec) {
+    const base::TimeDelta ttl =
+        new_url_spec.empty() ? kNoRecordTTL : kResolvedTTL;
+    entries_[host] = {new_url_spec, base::TimeTicks::Now() + ttl};
+  }
+
+  // Returns true if no lookup for |host| was in flight, i.e. the caller
+  // should start one.
+  bool AddPendingRequest(const std::string& host, PendingRequest request) {
+    auto& requests = pending_requests_[host];
+    requests.push_back(std::move(request));
+    return requests.size() == 1;
+  }
+
+  std::vector<PendingRequest> TakePendingRequests(const std::string& host) {
+    std::vector<PendingRequest> requests;
+    auto it = pending_requests_.find(host);
+    if (it != pending_requests_.end()) {
+      requests = std::move(it->second);
+      pending_requests_.erase(it);
+    }
+    return requests;
+  }
+
+  brave_wallet::mojom::EthJsonRpcController* GetRpcController(
+      content::BrowserContext* context) {
+    if (!rpc_controller_) {
+      auto pending =
+          brave_wallet::RpcControllerFactory::GetForContext(context);
+      if (!pending)
+        return nullptr;
+      rpc_controller_.Bind(std::move(pending));
+      rpc_controller_.reset_on_disconnect();
+    }
+    return rpc_controller_.get();
+  }
+
+  base::WeakPtr<ResolutionCache> GetWeakPtr() {
+    return weak_ptr_factory_.GetWeakPtr();
+  }
+
+ private:
+  struct Entry {
+    std::string new_url_spec;
+    base::TimeTicks expiration;
+  };
+
+  base::flat_map<std::string, Entry> entries_;
+  base::flat_map<std::string, std::vector<PendingRequest>> pending_requests_;
+  mojo::Remote<brave_wallet::mojom::EthJsonRpcController> rpc_controller_;
+  base::WeakPtrFactory<ResolutionCache> weak_ptr_factory_{this};
+};
+
 std::string GetValue(const std::vector<std::string>& arr, RecordKeys key) {
   return arr[static_cast<size_t>(key)];
 }
 
+void StoreResolution(std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  if (!ctx->browser_context)
+    return;
+  ResolutionCache::FromContext(ctx->browser_context)
+      ->Store(ctx->request_url.host(), ctx->new_url_spec);
+}
+
+void OnResolved(base::WeakPtr<ResolutionCache> cache,
+                const std::string& host,
+                bool is_ens,
+                bool success,
+                const std::string& result) {
+  if (!cache)
+    return;
+  for (auto& request : cache->TakePendingRequests(host)) {
+    if (is_ens) {
+      OnBeforeURLRequest_EnsRedirectWork(request.next_callback, request.ctx,
+                                         success, result);
+    } else {
+      OnBeforeURLRequest_DecentralizedDnsRedirectWork(
+          request.next_callback, request.ctx, success, result);
+    }
+  }
+}
+
+// Starts a lookup for |ctx|'s host unless one is already in flight, in which
+// case |ctx| waits on that one.
+void Resolve(ResolutionCache* cache,
+             const brave::ResponseCallback& next_callback,
+             std::shared_ptr<brave::BraveRequestInfo> ctx,
+             bool is_ens) {
+  const std::string host = ctx->request_url.host();
+  auto* rpc_controller = cache->GetRpcController(ctx->browser_context);
+  if (!rpc_controller ||
+      !cache->AddPendingRequest(host, {next_callback, std::move(ctx)})) {
+    return;
+  }
+
+  auto callback =
+      base::BindOnce(&OnResolved, cache->GetWeakPtr(), host, is_ens);
+  if (is_ens) {
+    rpc_controller->EnsProxyReaderGetResolverAddress(
+        kEnsRegistryContractAddress, host, std::move(callback));
+  } else {
+    auto keys = std::vector<std::string>(std::begin(kRecordKeys),
+                                         std::end(kRecordKeys));
+    rpc_controller->UnstoppableDomainsProxyReaderGetMany(
+        kProxyReaderContractAddress, host, keys, std::move(callback));
+  }
+}
+
+// Serves |ctx| from the cache if possible. A stale entry is still used, and
+// a refresh is started in the background.
+bool ResolveFromCache(ResolutionCache* cache,
+                      std::shared_ptr<brave::BraveRequestInfo> ctx,
+                      bool is_ens) {
+  std::string new_url_spec;
+  bool stale = false;
+  if (!cache->Lookup(ctx->request_url.host(), &new_url_spec, &stale))
+    return false;
+
+  if (!new_url_spec.empty())
+    ctx->new_url_spec = new_url_spec;
+  if (stale) {
+    auto refresh_ctx = std::make_shared<brave::BraveRequestInfo>(
+        ctx->request_url);
+    refresh_ctx->browser_context = ctx->browser_context;
+    Resolve(cache, brave::ResponseCallback(), std::move(refresh_ctx), is_ens);
+  }
+  return true;
+}
+
 }  // namespace
 
 int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
@@ -38,13 +214,8 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     return net::OK;
   }
 
-  auto pending =
-      brave_wallet::RpcControllerFactory::GetForContext(ctx->browser_context);
-
-  mojo::Remote<brave_wallet::mojom::EthJsonRpcController> rpc_controller;
-  rpc_controller.Bind(std::move(pending));
-
-  if (!rpc_controller)
+  auto* cache = ResolutionCache::FromContext(ctx->browser_context);
+  if (!cache->GetRpcController(ctx->browser_context))
     return net::OK;
 
   if (IsUnstoppableDomainsTLD(ctx->request_url) &&
@@ -57,11 +228,10 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
             keys, ctx->request_url.host(), &data))
       return net::OK;
 
-    rpc_controller->UnstoppableDomainsProxyReaderGetMany(
-        kProxyReaderContractAddress, ctx->request_url.host(), keys,
-        base::BindOnce(&OnBeforeURLRequest_DecentralizedDnsRedirectWork,
-                       next_callback, ctx));
+    if (ResolveFromCache(cache, ctx, false /* is_ens */))
+      return net::OK;
 
+    Resolve(cache, next_callback, ctx, false /* is_ens */);
     return net::ERR_IO_PENDING;
   }
 
@@ -71,11 +241,10 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     if (!brave_wallet::ens::GetResolverAddress(ctx->request_url.host(), &data))
       return net::OK;
 
-    rpc_controller->EnsProxyReaderGetResolverAddress(
-        kEnsRegistryContractAddress, ctx->request_url.host(),
-        base::BindOnce(&OnBeforeURLRequest_EnsRedirectWork, next_callback,
-                       ctx));
+    if (ResolveFromCache(cache, ctx, true /* is_ens */))
+      return net::OK;
 
+    Resolve(cache, next_callback, ctx, true /* is_ens */);
     return net::ERR_IO_PENDING;
   }
 
@@ -105,6 +274,7 @@ void OnBeforeURLRequest_EnsRedirectWork(
   if (ipfs_uri.is_valid()) {
     ctx->new_url_spec = ipfs_uri.spec();
   }
+  StoreResolution(ctx);
 
   if (!next_callback.is_null())
     next_callback.Run();
@@ -152,6 +322,7 @@ void OnBeforeURLRequest_DecentralizedDnsRedirectWork(
   } else if (!fallback_url.empty()) {
     ctx->new_url_spec = GURL(fallback_url).spec();
   }
+  StoreResolution(ctx);
 
   if (!next_callback.is_null())
     next_callback.Run();
@@ -267,6 +267,44 @@ TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
   EXPECT_EQ("https://fallback2.test.com/", brave_request_info->new_url_spec);
 }
 
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest, ResolutionIsCached) {
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  GURL url("http://brave.crypto");
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  brave_request_info->browser_context = profile();
+
+  std::string result =
+      // offset for array
+      "0x0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      // count for "https://fallback2.test.com"
+      "000000000000000000000000000000000000000000000000000000000000001a"
+      // encoding for "https://fallback2.test.com"
+      "68747470733a2f2f66616c6c6261636b322e746573742e636f6d000000000000";
+  OnBeforeURLRequest_DecentralizedDnsRedirectWork(
+      ResponseCallback(), brave_request_info, true, result);
+  EXPECT_EQ("https://fallback2.test.com/", brave_request_info->new_url_spec);
+
+  // The next visit is answered from the cache without an eth_call.
+  auto next_request_info = std::make_shared<brave::BraveRequestInfo>(url);
+  next_request_info->browser_context = profile();
+  int rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+      ResponseCallback(), next_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ("https://fallback2.test.com/", next_request_info->new_url_spec);
+
+  // Failed lookups are not cached.
+  auto other_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("http://other.crypto"));
+  other_request_info->browser_context = profile();
+  OnBeforeURLRequest_DecentralizedDnsRedirectWork(
+      ResponseCallback(), other_request_info, false, "");
+  rc = OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(ResponseCallback(),
+                                                          other_request_info);
+  EXPECT_EQ(rc, net::ERR_IO_PENDING);
+}
+
 TEST_F(DecentralizedDnsNetworkDelegateHelperTest, EnsRedirectWork) {
   GURL url("http://brave.eth");
   auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
@@ -40,7 +40,10 @@ int OnBeforeURLRequest_IPFSRedirectWork(
     if (ctx->resource_type == blink::mojom::ResourceType::kMainFrame ||
         (IsLocalGatewayURL(new_url) && IsLocalGatewayURL(ctx->initiator_url)) ||
         (IsDefaultGatewayURL(new_url, prefs) &&
-         IsDefaultGatewayURL(ctx->initiator_url, prefs))) {
+         IsDefaultGatewayURL(ctx->initiator_url, prefs)) ||
+        // Gateway racing may route to a gateway other than the default one.
+        (IsGatewayURL(new_url, ctx->ipfs_gateway_url) &&
+         IsGatewayURL(ctx->initiator_url, ctx->ipfs_gateway_url))) {
       ctx->new_url_spec = new_url.spec();
     } else {
       ctx->blocked_by = brave::kOtherBlocked;
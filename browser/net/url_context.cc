@@ -20,7 +20,9 @@
 #include "services/network/public/cpp/resource_request.h"
 
 #if BUILDFLAG(ENABLE_IPFS)
+#include "brave/browser/ipfs/ipfs_service_factory.h"
 #include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_service.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "brave/components/ipfs/pref_names.h"
 #include "chrome/common/channel_info.h"
@@ -122,6 +124,15 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   auto* prefs = user_prefs::UserPrefs::Get(browser_context);
   ctx->ipfs_gateway_url =
       ipfs::GetConfiguredBaseGateway(prefs, chrome::GetChannel());
+  if (!ipfs::IsLocalGatewayConfigured(prefs) &&
+      prefs->GetBoolean(kIPFSGatewayRacingEnabled)) {
+    auto* ipfs_service =
+        ipfs::IpfsServiceFactory::GetForContext(browser_context);
+    GURL raced_gateway =
+        ipfs_service ? ipfs_service->GetPreferredGateway() : GURL();
+    if (raced_gateway.is_valid())
+      ctx->ipfs_gateway_url = raced_gateway;
+  }
   ctx->ipfs_auto_fallback = prefs->GetBoolean(kIPFSAutoRedirectGateway);
 
   // ipfs:// navigations have no tab origin set, but we want it to be the tab
@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_filter.h"
+
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+URLPatternHostFilter::URLPatternHostFilter() = default;
+URLPatternHostFilter::~URLPatternHostFilter() = default;
+URLPatternHostFilter::URLPatternHostFilter(URLPatternHostFilter&&) = default;
+URLPatternHostFilter& URLPatternHostFilter::operator=(
+    URLPatternHostFilter&&) = default;
+
+void URLPatternHostFilter::Add(const URLPattern& pattern) {
+  if (pattern.host().empty()) {
+    match_all_hosts_ = true;
+    return;
+  }
+  if (pattern.match_subdomains())
+    subdomain_hosts_.insert(pattern.host());
+  else
+    hosts_.insert(pattern.host());
+}
+
+bool URLPatternHostFilter::MayMatch(const GURL& url) const {
+  if (match_all_hosts_)
+    return true;
+
+  base::StringPiece host = url.host_piece();
+  // URLPattern ignores a single trailing dot on the tested host.
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+
+  if (hosts_.contains(host))
+    return true;
+  if (subdomain_hosts_.empty())
+    return false;
+  while (true) {
+    if (subdomain_hosts_.contains(host))
+      return true;
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      return false;
+    host.remove_prefix(dot + 1);
+  }
+}
+
+}  // namespace brave
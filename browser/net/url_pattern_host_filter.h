@@ -0,0 +1,43 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_URL_PATTERN_HOST_FILTER_H_
+#define BRAVE_BROWSER_NET_URL_PATTERN_HOST_FILTER_H_
+
+#include <string>
+
+#include "base/containers/flat_set.h"
+
+class GURL;
+class URLPattern;
+
+namespace brave {
+
+// Host-keyed index over a fixed set of URLPatterns. MayMatch() answers with
+// a couple of set lookups whether a URL's host could be matched by any of
+// the added patterns, so callers can skip their pattern-by-pattern scan for
+// the vast majority of requests that go nowhere near those hosts.
+class URLPatternHostFilter {
+ public:
+  URLPatternHostFilter();
+  ~URLPatternHostFilter();
+  URLPatternHostFilter(URLPatternHostFilter&&);
+  URLPatternHostFilter& operator=(URLPatternHostFilter&&);
+
+  void Add(const URLPattern& pattern);
+
+  // False only if no added pattern can match |url|. Schemes, paths and
+  // queries are left for the patterns themselves to check.
+  bool MayMatch(const GURL& url) const;
+
+ private:
+  bool match_all_hosts_ = false;
+  base::flat_set<std::string> hosts_;
+  base::flat_set<std::string> subdomain_hosts_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_URL_PATTERN_HOST_FILTER_H_
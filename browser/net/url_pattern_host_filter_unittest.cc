@@ -0,0 +1,38 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/url_pattern_host_filter.h"
+
+#include "extensions/common/url_pattern.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+TEST(URLPatternHostFilterTest, MatchesExactAndSubdomainHosts) {
+  const int schemes = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  URLPatternHostFilter filter;
+  filter.Add(URLPattern(schemes, "*://dl.google.com/*"));
+  filter.Add(URLPattern(schemes, "*://*.gvt1.com/*"));
+
+  EXPECT_TRUE(filter.MayMatch(GURL("https://dl.google.com/foo")));
+  EXPECT_TRUE(filter.MayMatch(GURL("http://dl.google.com./foo")));
+  EXPECT_TRUE(filter.MayMatch(GURL("https://gvt1.com/")));
+  EXPECT_TRUE(filter.MayMatch(GURL("https://r1---sn.gvt1.com/edgedl/")));
+
+  EXPECT_FALSE(filter.MayMatch(GURL("https://www.google.com/")));
+  EXPECT_FALSE(filter.MayMatch(GURL("https://sub.dl.google.com/")));
+  EXPECT_FALSE(filter.MayMatch(GURL("https://notgvt1.com/")));
+  EXPECT_FALSE(filter.MayMatch(GURL("https://gvt1.com.evil.com/")));
+}
+
+TEST(URLPatternHostFilterTest, WildcardHostMatchesEverything) {
+  URLPatternHostFilter filter;
+  EXPECT_FALSE(filter.MayMatch(GURL("https://brave.com/")));
+  filter.Add(URLPattern(URLPattern::SCHEME_HTTPS, "https://*/*"));
+  EXPECT_TRUE(filter.MayMatch(GURL("https://brave.com/")));
+}
+
+}  // namespace brave
@@ -5,6 +5,12 @@
 
 #include "brave/browser/speedreader/speedreader_service_factory.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/feature_list.h"
+#include "brave/components/speedreader/features.h"
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
 #include "brave/components/speedreader/speedreader_service.h"
 #include "chrome/browser/profiles/incognito_helpers.h"
 #include "chrome/browser/profiles/profile.h"
@@ -38,8 +44,16 @@ SpeedreaderServiceFactory::GetBrowserContextToUse(
 
 KeyedService* SpeedreaderServiceFactory::BuildServiceInstanceFor(
     content::BrowserContext* context) const {
-  return new SpeedreaderService(
-      Profile::FromBrowserContext(context)->GetPrefs());
+  Profile* profile = Profile::FromBrowserContext(context);
+  std::unique_ptr<SpeedreaderDistilledCache> distilled_cache;
+  // Off-the-record profiles never write distilled pages to disk.
+  if (base::FeatureList::IsEnabled(kSpeedreaderDistilledCache) &&
+      !profile->IsOffTheRecord()) {
+    distilled_cache = std::make_unique<SpeedreaderDistilledCache>(
+        profile->GetPath().AppendASCII("Speedreader Cache"));
+  }
+  return new SpeedreaderService(profile->GetPrefs(),
+                                std::move(distilled_cache));
 }
 
 bool SpeedreaderServiceFactory::ServiceIsCreatedWithBrowserContext() const {
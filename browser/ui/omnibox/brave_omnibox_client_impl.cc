@@ -7,18 +7,36 @@
 
 #include <algorithm>
 
+#include "base/callback_helpers.h"
 #include "base/cxx17_backports.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/values.h"
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_search/common/brave_search_utils.h"
+#include "brave/components/brave_search/common/features.h"
+#include "brave/components/speedreader/buildflags.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
 #include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/search_engines/template_url_service_factory.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_edit_controller.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
+#include "components/search_engines/template_url.h"
+#include "components/search_engines/template_url_service.h"
+#include "content/public/browser/service_worker_context.h"
+#include "content/public/browser/storage_partition.h"
+#include "third_party/blink/public/common/storage_key/storage_key.h"
+#include "url/origin.h"
+
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+#include "brave/browser/brave_browser_process.h"
+#include "brave/components/speedreader/features.h"
+#include "brave/components/speedreader/speedreader_rewriter_service.h"
+#endif
 
 namespace {
 
@@ -90,3 +108,60 @@ void BraveOmniboxClientImpl::OnInputAccepted(const AutocompleteMatch& match) {
     RecordSearchEventP3A(storage.GetWeeklySum());
   }
 }
+
+void BraveOmniboxClientImpl::OnTextChanged(
+    const AutocompleteMatch& current_match,
+    bool user_input_in_progress,
+    const std::u16string& user_text,
+    const AutocompleteResult& result,
+    bool has_focus) {
+  ChromeOmniboxClient::OnTextChanged(current_match, user_input_in_progress,
+                                     user_text, result, has_focus);
+#if BUILDFLAG(ENABLE_SPEEDREADER)
+  // Like the preconnect done for the default match, get the Speedreader
+  // rewriter ready in case the destination gets distilled.
+  if (user_input_in_progress && has_focus &&
+      base::FeatureList::IsEnabled(speedreader::kSpeedreaderFeature) &&
+      current_match.destination_url.SchemeIsHTTPOrHTTPS() &&
+      g_brave_browser_process) {
+    g_brave_browser_process->speedreader_rewriter_service()->WarmUp(
+        current_match.destination_url);
+  }
+#endif
+}
+
+void BraveOmniboxClientImpl::OnFocusChanged(OmniboxFocusState state,
+                                            OmniboxFocusChangeReason reason) {
+  ChromeOmniboxClient::OnFocusChanged(state, reason);
+  if (state != OMNIBOX_FOCUS_NONE)
+    MaybeWarmUpBraveSearch();
+}
+
+void BraveOmniboxClientImpl::MaybeWarmUpBraveSearch() {
+  if (!base::FeatureList::IsEnabled(
+          brave_search::features::kBraveSearchServiceWorkerWarmupFeature))
+    return;
+
+  TemplateURLService* template_url_service =
+      TemplateURLServiceFactory::GetForProfile(profile_);
+  if (!template_url_service)
+    return;
+  const TemplateURL* default_provider =
+      template_url_service->GetDefaultSearchProvider();
+  if (!default_provider)
+    return;
+  const GURL search_url = default_provider->GenerateSearchURL(
+      template_url_service->search_terms_data());
+  if (!brave_search::IsAllowedHost(search_url))
+    return;
+
+  // Does nothing if the worker is already running. Starting it also sets up
+  // the JS handlers BraveSearchServiceWorkerHolder adds to the worker.
+  content::ServiceWorkerContext* service_worker_context =
+      profile_->GetDefaultStoragePartition()->GetServiceWorkerContext();
+  if (!service_worker_context)
+    return;
+  service_worker_context->StartServiceWorkerForNavigationHint(
+      search_url, blink::StorageKey(url::Origin::Create(search_url)),
+      base::DoNothing());
+}
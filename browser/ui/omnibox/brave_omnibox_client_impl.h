@@ -6,6 +6,8 @@
 #ifndef BRAVE_BROWSER_UI_OMNIBOX_BRAVE_OMNIBOX_CLIENT_IMPL_H_
 #define BRAVE_BROWSER_UI_OMNIBOX_BRAVE_OMNIBOX_CLIENT_IMPL_H_
 
+#include <string>
+
 #include "brave/browser/autocomplete/brave_autocomplete_scheme_classifier.h"
 #include "chrome/browser/ui/omnibox/chrome_omnibox_client.h"
 
@@ -24,8 +26,19 @@ class BraveOmniboxClientImpl : public ChromeOmniboxClient {
   bool IsAutocompleteEnabled() const override;
 
   void OnInputAccepted(const AutocompleteMatch& match) override;
+  void OnTextChanged(const AutocompleteMatch& current_match,
+                     bool user_input_in_progress,
+                     const std::u16string& user_text,
+                     const AutocompleteResult& result,
+                     bool has_focus) override;
+  void OnFocusChanged(OmniboxFocusState state,
+                      OmniboxFocusChangeReason reason) override;
 
  private:
+  // Starts the Brave Search service worker if Brave Search is the default
+  // search engine.
+  void MaybeWarmUpBraveSearch();
+
   Profile* profile_;
   BraveAutocompleteSchemeClassifier scheme_classifier_;
 
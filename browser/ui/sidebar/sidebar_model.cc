@@ -5,10 +5,13 @@
 
 #include "brave/browser/ui/sidebar/sidebar_model.h"
 
+#include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "base/logging.h"
+#include "base/supports_user_data.h"
 #include "base/time/time.h"
 #include "brave/browser/ui/sidebar/sidebar_model_data.h"
 #include "brave/browser/ui/sidebar/sidebar_service_factory.h"
@@ -36,6 +39,33 @@ SidebarService* GetSidebarService(Profile* profile) {
   return service;
 }
 
+constexpr char kFaviconCacheUserDataKey[] = "sidebar_favicon_cache";
+
+// Favicons of web type items, shared by the sidebar models of all windows of
+// a profile so that a new window doesn't look them up again.
+class FaviconCache : public base::SupportsUserData::Data {
+ public:
+  struct Entry {
+    gfx::ImageSkia image;
+    // Network favicons are replaced once the site is visited, as the visit
+    // puts the site's own favicon in the favicon service.
+    bool from_network = false;
+  };
+
+  static FaviconCache* GetOrCreate(Profile* profile) {
+    auto* cache = static_cast<FaviconCache*>(
+        profile->GetUserData(kFaviconCacheUserDataKey));
+    if (!cache) {
+      auto new_cache = std::make_unique<FaviconCache>();
+      cache = new_cache.get();
+      profile->SetUserData(kFaviconCacheUserDataKey, std::move(new_cache));
+    }
+    return cache;
+  }
+
+  std::map<GURL, Entry> entries;
+};
+
 constexpr char kImageFetcherUmaClientName[] = "SidebarFavicon";
 
 constexpr net::NetworkTrafficAnnotationTag kSidebarFaviconTrafficAnnotation =
@@ -139,6 +169,8 @@ void SidebarModel::OnItemMoved(const SidebarItem& item, int from, int to) {
 void SidebarModel::OnWillRemoveItem(const SidebarItem& item, int index) {
   if (index == active_index_)
     UpdateActiveIndexAndNotify(-1);
+
+  FaviconCache::GetOrCreate(profile_)->entries.erase(item.url);
 }
 
 void SidebarModel::OnItemRemoved(const SidebarItem& item, int index) {
@@ -150,12 +182,13 @@ void SidebarModel::OnURLVisited(history::HistoryService* history_service,
                                 const history::URLRow& row,
                                 const history::RedirectList& redirects,
                                 base::Time visit_time) {
-  const int item_count = GetAllSidebarItems().size();
-  const auto items = GetAllSidebarItems();
+  const auto& items = GetAllSidebarItems();
+  const int item_count = items.size();
   for (int i = 0; i < item_count; ++i) {
     // If same url is added to history service, try to fetch favicon to update
     // for item.
     if (items[i].url == row.url() && data_[i]->need_favicon_update()) {
+      FaviconCache::GetOrCreate(profile_)->entries.erase(items[i].url);
       // Favicon seems cached after this callback.
       // TODO(simonhong): Find more deterministic method instead of using
       // delayed task.
@@ -210,7 +243,7 @@ bool SidebarModel::IsSidebarWebContents(
   return false;
 }
 
-const std::vector<SidebarItem> SidebarModel::GetAllSidebarItems() const {
+const std::vector<SidebarItem>& SidebarModel::GetAllSidebarItems() const {
   return GetSidebarService(profile_)->items();
 }
 
@@ -253,6 +286,17 @@ void SidebarModel::UpdateActiveIndexAndNotify(int new_active_index) {
 }
 
 void SidebarModel::FetchFavicon(const sidebar::SidebarItem& item) {
+  const auto& entries = FaviconCache::GetOrCreate(profile_)->entries;
+  const auto iter = entries.find(item.url);
+  if (iter != entries.end()) {
+    const int index = GetIndexOf(item);
+    if (index != -1 && iter->second.from_network)
+      data_[index]->set_need_favicon_update(true);
+    for (Observer& obs : observers_)
+      obs.OnFaviconUpdatedForItem(item, iter->second.image);
+    return;
+  }
+
   // Use favicon as a web type icon's image.
   auto* favicon_service = FaviconServiceFactory::GetForProfile(
       profile_, ServiceAccessType::EXPLICIT_ACCESS);
@@ -274,11 +318,11 @@ void SidebarModel::OnGetLocalFaviconImage(
   // If history is cleared, favicon service can't give. Then, try to get from
   // network.
   if (bitmap_result.is_valid()) {
-    for (Observer& obs : observers_) {
-      obs.OnFaviconUpdatedForItem(
-          item, gfx::Image::CreateFrom1xPNGBytes(bitmap_result.bitmap_data)
-                    .AsImageSkia());
-    }
+    SetFaviconForItem(
+        item,
+        gfx::Image::CreateFrom1xPNGBytes(bitmap_result.bitmap_data)
+            .AsImageSkia(),
+        false);
   } else {
     // Flaging to try to update favicon again.
     data_[index]->set_need_favicon_update(true);
@@ -305,10 +349,17 @@ void SidebarModel::OnGetFaviconImageFromNetwork(
     const sidebar::SidebarItem& item,
     const gfx::Image& image,
     const image_fetcher::RequestMetadata& request_metadata) {
-  if (!image.IsEmpty()) {
-    for (Observer& obs : observers_)
-      obs.OnFaviconUpdatedForItem(item, image.AsImageSkia());
-  }
+  if (!image.IsEmpty())
+    SetFaviconForItem(item, image.AsImageSkia(), true);
+}
+
+void SidebarModel::SetFaviconForItem(const sidebar::SidebarItem& item,
+                                     const gfx::ImageSkia& image,
+                                     bool from_network) {
+  FaviconCache::GetOrCreate(profile_)->entries[item.url] = {image,
+                                                           from_network};
+  for (Observer& obs : observers_)
+    obs.OnFaviconUpdatedForItem(item, image);
 }
 
 }  // namespace sidebar
@@ -90,7 +90,7 @@ class SidebarModel : public SidebarService::Observer,
   bool IsSidebarWebContents(const content::WebContents* web_contents) const;
 
   // Don't cache item list. list can be changed during the runtime.
-  const std::vector<SidebarItem> GetAllSidebarItems() const;
+  const std::vector<SidebarItem>& GetAllSidebarItems() const;
 
   // Return -1 if sidebar panel is not opened.
   int active_index() const { return active_index_; }
@@ -130,6 +130,11 @@ class SidebarModel : public SidebarService::Observer,
       const gfx::Image& image,
       const image_fetcher::RequestMetadata& request_metadata);
 
+  // Caches |image| for the other windows of this profile and shows it.
+  void SetFaviconForItem(const sidebar::SidebarItem& item,
+                         const gfx::ImageSkia& image,
+                         bool from_network);
+
   // Non-negative if sidebar panel is opened.
   int active_index_ = -1;
   Profile* profile_ = nullptr;
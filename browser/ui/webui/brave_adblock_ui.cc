@@ -14,6 +14,7 @@
 #include "brave/common/webui_url_constants.h"
 #include "brave/components/brave_adblock/resources/grit/brave_adblock_generated_map.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_stats.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
@@ -60,6 +61,8 @@ class AdblockDOMHandler
   void HandleDeleteSubscription(const base::ListValue* args);
   void HandleRefreshSubscription(const base::ListValue* args);
   void HandleViewSubscriptionSource(const base::ListValue* args);
+  void HandleGetEngineStats(const base::ListValue* args);
+  void HandleResetEngineStats(const base::ListValue* args);
 
   void RefreshSubscriptionsList();
 
@@ -116,6 +119,14 @@ void AdblockDOMHandler::RegisterMessages() {
       "brave_adblock.viewSubscriptionSource",
       base::BindRepeating(&AdblockDOMHandler::HandleViewSubscriptionSource,
                           base::Unretained(this)));
+  web_ui()->RegisterMessageCallback(
+      "brave_adblock.getEngineStats",
+      base::BindRepeating(&AdblockDOMHandler::HandleGetEngineStats,
+                          base::Unretained(this)));
+  web_ui()->RegisterMessageCallback(
+      "brave_adblock.resetEngineStats",
+      base::BindRepeating(&AdblockDOMHandler::HandleResetEngineStats,
+                          base::Unretained(this)));
 }
 
 void AdblockDOMHandler::OnJavascriptAllowed() {
@@ -288,6 +299,22 @@ void AdblockDOMHandler::HandleViewSubscriptionSource(
 #endif
 }
 
+void AdblockDOMHandler::HandleGetEngineStats(const base::ListValue* args) {
+  DCHECK_EQ(args->GetSize(), 0U);
+  AllowJavascript();
+  CallJavascriptFunction("brave_adblock.onGetEngineStats",
+                         brave_shields::AdBlockEngineStats::GetInstance()
+                             ->GetStats());
+}
+
+void AdblockDOMHandler::HandleResetEngineStats(const base::ListValue* args) {
+  DCHECK_EQ(args->GetSize(), 0U);
+  AllowJavascript();
+  auto* stats = brave_shields::AdBlockEngineStats::GetInstance();
+  stats->Reset();
+  CallJavascriptFunction("brave_adblock.onGetEngineStats", stats->GetStats());
+}
+
 // Convenience method to push updated subscription information to the UI.
 void AdblockDOMHandler::RefreshSubscriptionsList() {
   DCHECK(IsJavascriptAllowed());
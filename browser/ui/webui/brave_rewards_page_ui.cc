@@ -69,6 +69,7 @@ class RewardsDOMHandler : public WebUIMessageHandler,
  private:
   void RestartBrowser(const base::ListValue* args);
   void IsInitialized(const base::ListValue* args);
+  void GetInitialData(const base::ListValue* args);
   void GetRewardsParameters(const base::ListValue* args);
   void GetAutoContributeProperties(const base::ListValue* args);
   void FetchPromotions(const base::ListValue* args);
@@ -350,6 +351,9 @@ void RewardsDOMHandler::RegisterMessages() {
   web_ui()->RegisterMessageCallback("brave_rewards.isInitialized",
       base::BindRepeating(&RewardsDOMHandler::IsInitialized,
       base::Unretained(this)));
+  web_ui()->RegisterMessageCallback("brave_rewards.getInitialData",
+      base::BindRepeating(&RewardsDOMHandler::GetInitialData,
+      base::Unretained(this)));
   web_ui()->RegisterMessageCallback("brave_rewards.getRewardsParameters",
       base::BindRepeating(&RewardsDOMHandler::GetRewardsParameters,
       base::Unretained(this)));
@@ -531,6 +535,34 @@ void RewardsDOMHandler::IsInitialized(const base::ListValue* args) {
   }
 }
 
+// Everything the page asks for once rewards is initialized, in a single
+// message. |args| are those of GetBalanceReport. The answers are sent as each
+// of them is ready, the same way as when they are asked for one at a time,
+// and are kept up to date by the service observers.
+void RewardsDOMHandler::GetInitialData(const base::ListValue* args) {
+  AllowJavascript();
+
+  const base::ListValue no_args;
+  GetBalanceReport(args);
+  GetRecurringTips(&no_args);
+  GetOneTimeTips(&no_args);
+  GetContributionList(&no_args);
+  GetPendingContributions(&no_args);
+  GetReconcileStamp(&no_args);
+  GetStatement(&no_args);
+  GetAdsData(&no_args);
+  GetExcludedSites(&no_args);
+  GetCountryCode(&no_args);
+  GetRewardsParameters(&no_args);
+  GetAutoContributionAmount(&no_args);
+  GetAutoContributeProperties(&no_args);
+  FetchBalance(&no_args);
+  FetchPromotions(&no_args);
+  GetExternalWallet(&no_args);
+  GetOnboardingStatus(&no_args);
+  GetEnabledInlineTippingPlatforms(&no_args);
+}
+
 void RewardsDOMHandler::OnJavascriptAllowed() {
   if (rewards_service_) {
     rewards_service_observation_.Reset();
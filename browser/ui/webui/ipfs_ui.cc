@@ -281,6 +281,10 @@ void IPFSDOMHandler::OnGetRepoStats(bool success,
                                          std::move(stats_value));
 }
 
+void IPFSDOMHandler::OnRepoStatsUpdated(const ipfs::RepoStats& stats) {
+  OnGetRepoStats(true, stats);
+}
+
 void IPFSDOMHandler::HandleGetNodeInfo(const base::ListValue* args) {
   DCHECK_EQ(args->GetSize(), 0U);
   if (!web_ui()->CanCallJavascript())
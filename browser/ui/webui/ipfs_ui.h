@@ -37,6 +37,7 @@ class IPFSDOMHandler : public content::WebUIMessageHandler,
   void OnGetConnectedPeers(bool success,
                            const std::vector<std::string>& peers) override;
   void OnInstallationEvent(ipfs::ComponentUpdaterEvents event) override;
+  void OnRepoStatsUpdated(const ipfs::RepoStats& stats) override;
 
  private:
   void HandleGetConnectedPeers(const base::ListValue* args);
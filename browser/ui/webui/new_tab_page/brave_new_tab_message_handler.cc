@@ -214,7 +214,9 @@ BraveNewTabMessageHandler* BraveNewTabMessageHandler::Create(
 }
 
 BraveNewTabMessageHandler::BraveNewTabMessageHandler(Profile* profile)
-    : profile_(profile), weak_ptr_factory_(this) {
+    : creation_time_(base::TimeTicks::Now()),
+      profile_(profile),
+      weak_ptr_factory_(this) {
 #if BUILDFLAG(ENABLE_TOR)
   tor_launcher_factory_ = TorLauncherFactory::GetInstance();
 #endif
@@ -234,6 +236,10 @@ void BraveNewTabMessageHandler::RegisterMessages() {
   // - Stats
   // - Preferences
   // - PrivatePage properties
+  web_ui()->RegisterMessageCallback(
+      "getNewTabPageInitialState",
+      base::BindRepeating(&BraveNewTabMessageHandler::HandleGetInitialState,
+                          base::Unretained(this)));
   web_ui()->RegisterMessageCallback(
       "getNewTabPagePreferences",
       base::BindRepeating(&BraveNewTabMessageHandler::HandleGetPreferences,
@@ -434,6 +440,21 @@ void BraveNewTabMessageHandler::OnJavascriptDisallowed() {
   weak_ptr_factory_.InvalidateWeakPtrs();
 }
 
+void BraveNewTabMessageHandler::HandleGetInitialState(
+    const base::ListValue* args) {
+  AllowJavascript();
+  PrefService* prefs = profile_->GetPrefs();
+  base::Value data(base::Value::Type::DICTIONARY);
+  data.SetKey("preferences", GetPreferencesDictionary(prefs));
+  data.SetKey("stats", GetStatsDictionary(prefs));
+  data.SetKey("privateTabData", GetPrivatePropertiesDictionary(prefs));
+  data.SetKey("torTabData",
+              GetTorPropertiesDictionary(IsTorConnected(), std::string()));
+  if (!IsPrivateNewTab(profile_))
+    data.SetKey("brandedWallpaperData", GetBrandedWallpaperForDisplay());
+  ResolveJavascriptCallback(args->GetList()[0], data);
+}
+
 void BraveNewTabMessageHandler::HandleGetPreferences(
         const base::ListValue* args) {
   AllowJavascript();
@@ -460,14 +481,17 @@ void BraveNewTabMessageHandler::HandleGetPrivateProperties(
 void BraveNewTabMessageHandler::HandleGetTorProperties(
         const base::ListValue* args) {
   AllowJavascript();
+  auto data = GetTorPropertiesDictionary(IsTorConnected(), "");
+  ResolveJavascriptCallback(args->GetList()[0], data);
+}
+
+bool BraveNewTabMessageHandler::IsTorConnected() const {
 #if BUILDFLAG(ENABLE_TOR)
-  auto data = GetTorPropertiesDictionary(
-      tor_launcher_factory_ ? tor_launcher_factory_->IsTorConnected() : false,
-      "");
+  return tor_launcher_factory_ ? tor_launcher_factory_->IsTorConnected()
+                               : false;
 #else
-  auto data = GetTorPropertiesDictionary(false, "");
+  return false;
 #endif
-  ResolveJavascriptCallback(args->GetList()[0], data);
 }
 
 void BraveNewTabMessageHandler::HandleToggleAlternativeSearchEngineProvider(
@@ -595,7 +619,11 @@ void BraveNewTabMessageHandler::HandleBrandedWallpaperLogoClicked(
 void BraveNewTabMessageHandler::HandleGetBrandedWallpaperData(
     const base::ListValue* args) {
   AllowJavascript();
+  ResolveJavascriptCallback(args->GetList()[0],
+                            GetBrandedWallpaperForDisplay());
+}
 
+base::Value BraveNewTabMessageHandler::GetBrandedWallpaperForDisplay() {
   auto* service = ViewCounterServiceFactory::GetForProfile(profile_);
   auto data = service ? service->GetCurrentWallpaperForDisplay()
                       : base::Value();
@@ -607,7 +635,9 @@ void BraveNewTabMessageHandler::HandleGetBrandedWallpaperData(
     service->BrandedWallpaperWillBeDisplayed(wallpaper_id);
   }
 
-  ResolveJavascriptCallback(args->GetList()[0], std::move(data));
+  UMA_HISTOGRAM_TIMES("Brave.NTP.BackgroundDataTime",
+                      base::TimeTicks::Now() - creation_time_);
+  return data;
 }
 
 void BraveNewTabMessageHandler::HandleCustomizeClicked(
@@ -9,6 +9,8 @@
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/values.h"
 #include "brave/components/tor/buildflags/buildflags.h"
 #include "brave/components/tor/tor_launcher_observer.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -16,10 +18,6 @@
 
 class Profile;
 
-namespace base {
-class Time;
-}  //  namespace base
-
 namespace content {
 class WebUIDataSource;
 }
@@ -52,6 +50,10 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void OnJavascriptAllowed() override;
   void OnJavascriptDisallowed() override;
 
+  // Answers with preferences, stats, private and Tor properties and the
+  // branded wallpaper in one message, so the page doesn't need a round trip
+  // for each of them before its first render.
+  void HandleGetInitialState(const base::ListValue* args);
   void HandleGetPreferences(const base::ListValue* args);
   void HandleGetStats(const base::ListValue* args);
   void HandleGetPrivateProperties(const base::ListValue* args);
@@ -73,6 +75,10 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void HandleTodayOnDisplayAdVisit(const base::ListValue* args);
   void HandleTodayOnDisplayAdView(const base::ListValue* args);
 
+  // Gets the wallpaper for this page and records that it will be displayed.
+  base::Value GetBrandedWallpaperForDisplay();
+  bool IsTorConnected() const;
+
   void OnStatsChanged();
   void OnPreferencesChanged();
   void OnPrivatePropertiesChanged();
@@ -82,6 +88,9 @@ class BraveNewTabMessageHandler : public content::WebUIMessageHandler,
   void OnTorInitializing(const std::string& percentage) override;
 
   PrefChangeRegistrar pref_change_registrar_;
+  // When the New Tab Page was created, used to time how long it waits for its
+  // background.
+  base::TimeTicks creation_time_;
   // Weak pointer.
   Profile* profile_;
 #if BUILDFLAG(ENABLE_TOR)
@@ -6,9 +6,15 @@
 #include "content/public/browser/tld_ephemeral_lifetime.h"
 
 #include <map>
+#include <utility>
 
+#include "base/containers/circular_deque.h"
 #include "base/no_destructor.h"
+#include "base/ranges/algorithm.h"
 #include "content/browser/dom_storage/dom_storage_context_wrapper.h"
+#include "content/browser/storage_partition_impl.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 #include "third_party/blink/public/common/storage_key/storage_key.h"
 
@@ -28,6 +34,92 @@ TLDEphemeralLifetimeMap& active_tld_storage_areas() {
   return *active_storage_areas.get();
 }
 
+// Upper bound on the number of ended lifetimes cleaned up per task, so
+// closing a window with many tabs doesn't monopolize the UI thread.
+constexpr size_t kMaxCleanupsPerTask = 16;
+
+// Storage cleanup for lifetimes that have ended. Cleanup is deferred to a
+// BEST_EFFORT task and done in batches grouped by storage type instead of
+// per lifetime as each tab goes away.
+class EphemeralStorageCleanupQueue {
+ public:
+  struct PendingCleanup {
+    TLDEphemeralLifetimeKey key;
+    base::WeakPtr<StoragePartitionImpl> storage_partition;
+    std::vector<url::Origin> opaque_origins;
+  };
+
+  static EphemeralStorageCleanupQueue& Get() {
+    static base::NoDestructor<EphemeralStorageCleanupQueue> queue;
+    return *queue;
+  }
+
+  void Add(PendingCleanup cleanup) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    pending_.push_back(std::move(cleanup));
+    ScheduleFlush();
+  }
+
+  // A new lifetime for |key| must not see the previous one's storage, and
+  // must not have its own storage wiped by a late cleanup, so anything still
+  // pending for |key| runs right away.
+  void RunNowFor(const TLDEphemeralLifetimeKey& key) {
+    DCHECK_CURRENTLY_ON(BrowserThread::UI);
+    auto it = base::ranges::find(pending_, key, &PendingCleanup::key);
+    if (it == pending_.end())
+      return;
+    std::vector<PendingCleanup> batch;
+    batch.push_back(std::move(*it));
+    pending_.erase(it);
+    RunBatch(std::move(batch));
+  }
+
+ private:
+  void ScheduleFlush() {
+    if (flush_scheduled_)
+      return;
+    flush_scheduled_ = true;
+    GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+        ->PostTask(FROM_HERE,
+                   base::BindOnce(&EphemeralStorageCleanupQueue::Flush,
+                                  base::Unretained(this)));
+  }
+
+  void Flush() {
+    flush_scheduled_ = false;
+    std::vector<PendingCleanup> batch;
+    while (!pending_.empty() && batch.size() < kMaxCleanupsPerTask) {
+      batch.push_back(std::move(pending_.front()));
+      pending_.pop_front();
+    }
+    RunBatch(std::move(batch));
+    if (!pending_.empty())
+      ScheduleFlush();
+  }
+
+  static void RunBatch(std::vector<PendingCleanup> batch) {
+    for (const auto& cleanup : batch) {
+      if (!cleanup.storage_partition)
+        continue;
+      auto filter = network::mojom::CookieDeletionFilter::New();
+      filter->ephemeral_storage_domain = cleanup.key.second;
+      cleanup.storage_partition->GetCookieManagerForBrowserProcess()
+          ->DeleteCookies(std::move(filter), base::NullCallback());
+    }
+    for (const auto& cleanup : batch) {
+      if (!cleanup.storage_partition)
+        continue;
+      for (const auto& opaque_origin : cleanup.opaque_origins) {
+        cleanup.storage_partition->GetDOMStorageContext()->DeleteLocalStorage(
+            blink::StorageKey(opaque_origin), base::DoNothing());
+      }
+    }
+  }
+
+  base::circular_deque<PendingCleanup> pending_;
+  bool flush_scheduled_ = false;
+};
+
 }  // namespace
 
 TLDEphemeralLifetime::TLDEphemeralLifetime(const TLDEphemeralLifetimeKey& key,
@@ -40,19 +132,15 @@ TLDEphemeralLifetime::TLDEphemeralLifetime(const TLDEphemeralLifetimeKey& key,
          active_tld_storage_areas().end());
   DCHECK(storage_partition_);
   DCHECK(delegate_);
+  EphemeralStorageCleanupQueue::Get().RunNowFor(key_);
   active_tld_storage_areas().emplace(key_, weak_factory_.GetWeakPtr());
 }
 
 TLDEphemeralLifetime::~TLDEphemeralLifetime() {
-  auto filter = network::mojom::CookieDeletionFilter::New();
-  filter->ephemeral_storage_domain = key_.second;
-  storage_partition_->GetCookieManagerForBrowserProcess()->DeleteCookies(
-      std::move(filter), base::NullCallback());
-  for (const auto& opaque_origin :
-       delegate_->TakeEphemeralStorageOpaqueOrigins(key_.second)) {
-    storage_partition_->GetDOMStorageContext()->DeleteLocalStorage(
-        blink::StorageKey(opaque_origin), base::DoNothing());
-  }
+  EphemeralStorageCleanupQueue::Get().Add(
+      {key_,
+       static_cast<StoragePartitionImpl*>(storage_partition_)->GetWeakPtr(),
+       delegate_->TakeEphemeralStorageOpaqueOrigins(key_.second)});
 
   if (!on_destroy_callbacks_.empty()) {
     auto on_destroy_callbacks = std::move(on_destroy_callbacks_);
@@ -29,18 +29,23 @@ CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
 
 CookieMonster::~CookieMonster() {}
 
+ChromiumCookieMonster* CookieMonster::GetEphemeralCookieStoreForTopFrameURL(
+    const GURL& top_frame_url) {
+  auto it =
+      ephemeral_cookie_stores_.find(URLToEphemeralStorageDomain(top_frame_url));
+  return it != ephemeral_cookie_stores_.end() ? it->second.get() : nullptr;
+}
+
 ChromiumCookieMonster*
 CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
     const GURL& top_frame_url) {
-  std::string domain = URLToEphemeralStorageDomain(top_frame_url);
-  auto it = ephemeral_cookie_stores_.find(domain);
-  if (it != ephemeral_cookie_stores_.end())
-    return it->second.get();
-
-  return ephemeral_cookie_stores_
-      .emplace(domain, new ChromiumCookieMonster(nullptr /* store */,
-                                                 net_log_.net_log()))
-      .first->second.get();
+  std::unique_ptr<ChromiumCookieMonster>& store =
+      ephemeral_cookie_stores_[URLToEphemeralStorageDomain(top_frame_url)];
+  if (!store) {
+    store = std::make_unique<ChromiumCookieMonster>(nullptr /* store */,
+                                                    net_log_.net_log());
+  }
+  return store.get();
 }
 
 void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
@@ -133,9 +138,16 @@ void CookieMonster::GetCookieListWithOptionsAsync(
                              CookieAccessResultList());
       return;
     }
+    // Reads are far more common than writes, and most third parties never
+    // set a cookie, so don't create a store just to find it empty.
     ChromiumCookieMonster* ephemeral_monster =
-        GetOrCreateEphemeralCookieStoreForTopFrameURL(
+        GetEphemeralCookieStoreForTopFrameURL(
             options.top_frame_origin()->GetURL());
+    if (!ephemeral_monster) {
+      MaybeRunCookieCallback(std::move(callback), CookieAccessResultList(),
+                             CookieAccessResultList());
+      return;
+    }
     ephemeral_monster->GetCookieListWithOptionsAsync(url, options,
                                                      std::move(callback));
     return;
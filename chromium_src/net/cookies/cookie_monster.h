@@ -6,6 +6,8 @@
 #ifndef BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 #define BRAVE_CHROMIUM_SRC_NET_COOKIES_COOKIE_MONSTER_H_
 
+#include "base/containers/flat_map.h"
+
 #define CookieMonster ChromiumCookieMonster
 #include "../../../../net/cookies/cookie_monster.h"
 #undef CookieMonster
@@ -47,8 +49,14 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
 
  private:
   NetLogWithSource net_log_;
-  std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
+  // Keyed by ephemeral storage domain (eTLD+1). A store is only created when
+  // a cookie is first set for the domain and is dropped as soon as the
+  // domain's ephemeral lifetime ends, so the map stays small.
+  base::flat_map<std::string, std::unique_ptr<ChromiumCookieMonster>>
       ephemeral_cookie_stores_;
+  // Returns nullptr if nothing has been stored for |top_frame_url| yet.
+  ChromiumCookieMonster* GetEphemeralCookieStoreForTopFrameURL(
+      const GURL& top_frame_url);
   ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
       const GURL& top_frame_url);
 };
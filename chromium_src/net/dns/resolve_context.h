@@ -12,6 +12,8 @@ class BraveResolveContext;
 
 #define GetDohServerAvailability virtual GetDohServerAvailability
 #define NumAvailableDohServers virtual NumAvailableDohServers
+#define NextDohFallbackPeriod virtual NextDohFallbackPeriod
+#define RecordRtt virtual RecordRtt
 #define BRAVE_RESOLVE_CONTEXT_H \
  private:                       \
   friend class BraveResolveContext;
@@ -19,6 +21,8 @@ class BraveResolveContext;
 #include "../../../../net/dns/resolve_context.h"
 #undef GetDohServerAvailability
 #undef NumAvailableDohServers
+#undef NextDohFallbackPeriod
+#undef RecordRtt
 #undef BRAVE_RESOLVE_CONTEXT_H
 
 #endif  // BRAVE_CHROMIUM_SRC_NET_DNS_RESOLVE_CONTEXT_H_
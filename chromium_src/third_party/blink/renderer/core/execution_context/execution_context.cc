@@ -8,6 +8,7 @@
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+#include "brave/third_party/blink/renderer/brave_farbling_pixels.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/renderer/core/dom/document.h"
@@ -23,38 +24,6 @@
 #include "third_party/blink/renderer/platform/supplementable.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
-namespace {
-
-const uint64_t zero = 0;
-
-inline uint64_t lfsr_next(uint64_t v) {
-  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
-}
-
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
-}
-
-}  // namespace
-
 namespace brave {
 
 const char kBraveSessionToken[] = "brave_session_token";
@@ -130,7 +99,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarbler BraveSessionCache::GetAudioFarbler(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -143,15 +112,19 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarbler::Scale(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
-        uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        if (!audio_noise_table_) {
+          // The sequence is seeded from the domain key.
+          uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
+          audio_noise_table_ = base::MakeRefCounted<AudioNoiseTable>(seed);
+        }
+        return AudioFarbler::Noise(audio_noise_table_);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarbler();
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -178,46 +151,22 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   if (!data || size == 0)
     return;
 
-  uint8_t* pixels = const_cast<uint8_t*>(data);
-  // This needs to be type size_t because we pass it to base::StringPiece
-  // later for content hashing. This is safe because the maximum canvas
-  // dimensions are less than SIZE_T_MAX. (Width and height are each
-  // limited to 32,767 pixels.)
-  // Four bits per pixel
-  const size_t pixel_count = size / 4;
-  // calculate initial seed to find first pixel to perturb, based on session
-  // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
+  // The seed combines the session and domain keys, the canvas contents are
+  // mixed in by FarblePixels.
+  const uint64_t session_plus_domain_key =
       session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
-               canvas_key, sizeof canvas_key));
-  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
-  uint64_t pixel_index;
-  // choose which channel (R, G, or B) to perturb
-  uint8_t channel;
-  // iterate through 32-byte canvas key and use each bit to determine how to
-  // perturb the current pixel
-  for (int i = 0; i < 32; i++) {
-    uint8_t bit = canvas_key[i];
-    for (int j = 0; j < 16; j++) {
-      if (j % 8 == 0)
-        bit = canvas_key[i];
-      channel = v % 3;
-      pixel_index = 4 * (v % pixel_count) + channel;
-      pixels[pixel_index] = pixels[pixel_index] ^ (bit & 0x1);
-      bit = bit >> 1;
-      // find next pixel to perturb
-      v = lfsr_next(v);
-    }
-  }
+  FarblePixels(session_plus_domain_key, const_cast<uint8_t*>(data), size);
 }
 
 WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
                                                     wtf_size_t length) {
+  const WTF::String cache_key =
+      WTF::String::FromUTF8(seed.data(), seed.size()) + ":" +
+      WTF::String::Number(length);
+  auto it = random_strings_.find(cache_key);
+  if (it != random_strings_.end())
+    return it->value;
+
   uint8_t key[32];
   crypto::HMAC h(crypto::HMAC::SHA256);
   CHECK(h.Init(reinterpret_cast<const unsigned char*>(&domain_key_),
@@ -230,24 +179,33 @@ WTF::String BraveSessionCache::GenerateRandomString(std::string seed,
   for (wtf_size_t i = 0; i < length; i++) {
     destination[i] =
         kLettersForRandomStrings[v % kLettersForRandomStringsLength];
-    v = lfsr_next(v);
+    v = brave::LfsrNext(v);
   }
+  random_strings_.insert(cache_key, value);
   return value;
 }
 
 WTF::String BraveSessionCache::FarbledUserAgent(WTF::String real_user_agent) {
+  if (!farbled_user_agent_.IsNull() && real_user_agent == real_user_agent_)
+    return farbled_user_agent_;
+
   std::mt19937_64 prng = MakePseudoRandomGenerator();
   WTF::StringBuilder result;
   result.Append(real_user_agent);
   int extra = prng() % kFarbledUserAgentMaxExtraSpaces;
   for (int i = 0; i < extra; i++)
     result.Append(" ");
-  return result.ToString();
+  real_user_agent_ = real_user_agent;
+  farbled_user_agent_ = result.ToString();
+  return farbled_user_agent_;
 }
 
 std::mt19937_64 BraveSessionCache::MakePseudoRandomGenerator() {
-  uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-  return std::mt19937_64(seed);
+  if (!prng_) {
+    uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
+    prng_.emplace(seed);
+  }
+  return *prng_;
 }
 
 }  // namespace brave
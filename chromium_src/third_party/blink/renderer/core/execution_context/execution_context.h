@@ -11,6 +11,11 @@
 #include <random>
 
 #include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+#include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_hash.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -23,8 +28,6 @@ using blink::Supplement;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
-
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
 
@@ -39,8 +42,27 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
-      blink::WebContentSettingsClient* settings);
+  // Farbled values that callers derive from MakePseudoRandomGenerator(). They
+  // can't change for the lifetime of the context, so GetFarbledValue() runs
+  // |compute| once per value and farbling level and returns the cached result
+  // afterwards.
+  enum class FarbledValue {
+    kHardwareConcurrency,
+    kDeviceMemory,
+    kMaxValue = kDeviceMemory
+  };
+  template <typename Compute>
+  double GetFarbledValue(FarbledValue value,
+                         BraveFarblingLevel level,
+                         Compute compute) {
+    absl::optional<double>& cached =
+        farbled_values_[static_cast<size_t>(value)][level];
+    if (!cached)
+      cached = compute();
+    return *cached;
+  }
+
+  AudioFarbler GetAudioFarbler(blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
                      size_t size);
@@ -53,6 +75,19 @@ class CORE_EXPORT BraveSessionCache final
   uint64_t session_key_;
   uint8_t domain_key_[32];
 
+  // Seeded from |domain_key_| on first use. MakePseudoRandomGenerator() hands
+  // out copies, which is cheaper than seeding a new generator.
+  absl::optional<std::mt19937_64> prng_;
+  // Keyed by seed and length.
+  WTF::HashMap<WTF::String, WTF::String> random_strings_;
+  scoped_refptr<AudioNoiseTable> audio_noise_table_;
+  WTF::String real_user_agent_;
+  WTF::String farbled_user_agent_;
+  static constexpr size_t kFarbledValueCount =
+      static_cast<size_t>(FarbledValue::kMaxValue) + 1;
+  absl::optional<double> farbled_values_[kFarbledValueCount]
+                                        [BraveFarblingLevel::MAXIMUM + 1];
+
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
 }  // namespace brave
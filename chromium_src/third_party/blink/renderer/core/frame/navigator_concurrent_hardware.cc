@@ -35,7 +35,8 @@ unsigned FarbleNumberOfProcessors(ExecutionContext* context) {
   if (!settings)
     return true_value;
   unsigned farbled_value = true_value;
-  switch (settings->GetBraveFarblingLevel()) {
+  const BraveFarblingLevel level = settings->GetBraveFarblingLevel();
+  switch (level) {
     case BraveFarblingLevel::OFF: {
       break;
     }
@@ -46,10 +47,13 @@ unsigned FarbleNumberOfProcessors(ExecutionContext* context) {
       U_FALLTHROUGH;
     }
     case BraveFarblingLevel::BALANCED: {
-      std::mt19937_64 prng =
-          BraveSessionCache::From(*context).MakePseudoRandomGenerator();
-      farbled_value =
-          kFakeMinProcessors + (prng() % (true_value + 1 - kFakeMinProcessors));
+      BraveSessionCache& cache = BraveSessionCache::From(*context);
+      farbled_value = static_cast<unsigned>(cache.GetFarbledValue(
+          BraveSessionCache::FarbledValue::kHardwareConcurrency, level, [&]() {
+            std::mt19937_64 prng = cache.MakePseudoRandomGenerator();
+            return kFakeMinProcessors +
+                   (prng() % (true_value + 1 - kFakeMinProcessors));
+          }));
       break;
     }
     default:
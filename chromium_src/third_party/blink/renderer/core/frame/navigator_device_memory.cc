@@ -50,10 +50,15 @@ float FarbleDeviceMemory(blink::ExecutionContext* context) {
     if (max_farbled_index <= min_farbled_index)
       return valid_values[min_farbled_index];
   }
-  std::mt19937_64 prng =
-      BraveSessionCache::From(*context).MakePseudoRandomGenerator();
-  return valid_values[min_farbled_index +
-                      (prng() % (max_farbled_index + 1 - min_farbled_index))];
+  BraveSessionCache& cache = BraveSessionCache::From(*context);
+  return static_cast<float>(cache.GetFarbledValue(
+      BraveSessionCache::FarbledValue::kDeviceMemory,
+      settings->GetBraveFarblingLevel(), [&]() {
+        std::mt19937_64 prng = cache.MakePseudoRandomGenerator();
+        return valid_values[min_farbled_index +
+                            (prng() %
+                             (max_farbled_index + 1 - min_farbled_index))];
+      }));
 }
 
 }  // namespace brave
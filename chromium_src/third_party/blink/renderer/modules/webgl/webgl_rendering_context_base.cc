@@ -4,6 +4,10 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "third_party/blink/renderer/modules/webgl/webgl_rendering_context_base.h"
+
+#include <algorithm>
+
+#include "base/numerics/checked_math.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
@@ -23,6 +27,47 @@ bool AllowFingerprintingForHost(blink::CanvasRenderingContextHost* host) {
   return !settings || settings->AllowFingerprinting(true);
 }
 
+// Farbles the pixels a successful readPixels() call wrote into |pixels|, in
+// place. Only the |width| x |height| rectangle the script asked for is hashed
+// and perturbed, so reading back a few pixels to pick an object stays cheap.
+// readPixels() returns early when fingerprinting is blocked, so this only
+// runs at the balanced level.
+void FarbleReadPixels(blink::CanvasRenderingContextHost* host,
+                      GLsizei width,
+                      GLsizei height,
+                      GLenum format,
+                      GLenum type,
+                      blink::DOMArrayBufferView* pixels,
+                      int64_t offset) {
+  if (!host || !pixels || format != GL_RGBA || type != GL_UNSIGNED_BYTE ||
+      width <= 0 || height <= 0)
+    return;
+  blink::ExecutionContext* context = host->GetTopExecutionContext();
+  if (!context)
+    return;
+  blink::WebContentSettingsClient* settings =
+      brave::GetContentSettingsClientFor(context);
+  if (!settings)
+    return;
+
+  base::CheckedNumeric<size_t> checked_begin = offset;
+  checked_begin *= pixels->TypeSize();
+  base::CheckedNumeric<size_t> checked_size = width;
+  checked_size *= height;
+  checked_size *= 4;
+  size_t begin;
+  size_t size;
+  if (!checked_begin.AssignIfValid(&begin) ||
+      !checked_size.AssignIfValid(&size) || begin >= pixels->byteLength())
+    return;
+  size = std::min(size, pixels->byteLength() - begin);
+  brave::BraveSessionCache::From(*context).PerturbPixels(
+      settings,
+      static_cast<const unsigned char*>(pixels->BaseAddressMaybeShared()) +
+          begin,
+      size);
+}
+
 }  // namespace
 
 #define BRAVE_WEBGL_RENDERING_CONTEXT_BASE_RETURN \
@@ -80,7 +125,11 @@ bool AllowFingerprintingForHost(blink::CanvasRenderingContextHost* host) {
 
 #define getExtension getExtension_ChromiumImpl
 #define getSupportedExtensions getSupportedExtensions_ChromiumImpl
+#define readPixels readPixels_ChromiumImpl
+#define ReadPixelsHelper ReadPixelsHelper_ChromiumImpl
 #include "../../../../../../../third_party/blink/renderer/modules/webgl/webgl_rendering_context_base.cc"
+#undef ReadPixelsHelper
+#undef readPixels
 #undef getSupportedExtensions
 #undef getExtension
 
@@ -112,6 +161,38 @@ ScriptValue WebGLRenderingContextBase::getExtension(ScriptState* script_state,
   return getExtension_ChromiumImpl(script_state, name);
 }
 
+// Both readback entry points farble what the Chromium implementation wrote,
+// unless it rejected the call. Every rejection synthesizes a GL error, so a
+// grown error list means the destination was left untouched.
+void WebGLRenderingContextBase::readPixels(
+    GLint x,
+    GLint y,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLenum type,
+    MaybeShared<DOMArrayBufferView> pixels) {
+  const wtf_size_t errors = synthesized_errors_list_.size();
+  readPixels_ChromiumImpl(x, y, width, height, format, type, pixels);
+  if (!isContextLost() && synthesized_errors_list_.size() == errors)
+    FarbleReadPixels(Host(), width, height, format, type, pixels.Get(), 0);
+}
+
+void WebGLRenderingContextBase::ReadPixelsHelper(GLint x,
+                                                 GLint y,
+                                                 GLsizei width,
+                                                 GLsizei height,
+                                                 GLenum format,
+                                                 GLenum type,
+                                                 DOMArrayBufferView* pixels,
+                                                 int64_t offset) {
+  const wtf_size_t errors = synthesized_errors_list_.size();
+  ReadPixelsHelper_ChromiumImpl(x, y, width, height, format, type, pixels,
+                                offset);
+  if (!isContextLost() && synthesized_errors_list_.size() == errors)
+    FarbleReadPixels(Host(), width, height, format, type, pixels, offset);
+}
+
 }  // namespace blink
 
 #undef BRAVE_WEBGL_GET_PARAMETER_UNMASKED_RENDERER
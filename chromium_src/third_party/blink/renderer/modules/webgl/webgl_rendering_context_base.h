@@ -14,8 +14,22 @@
   getSupportedExtensions_ChromiumImpl(); \
   absl::optional<Vector<String>> getSupportedExtensions
 
+#define readPixels                                                         \
+  readPixels_ChromiumImpl(GLint x, GLint y, GLsizei width, GLsizei height, \
+                          GLenum format, GLenum type,                      \
+                          MaybeShared<DOMArrayBufferView> pixels);         \
+  virtual void readPixels
+
+#define ReadPixelsHelper                                                     \
+  ReadPixelsHelper_ChromiumImpl(GLint x, GLint y, GLsizei width,             \
+                                GLsizei height, GLenum format, GLenum type,  \
+                                DOMArrayBufferView* pixels, int64_t offset); \
+  void ReadPixelsHelper
+
 #include "../../../../../../../third_party/blink/renderer/modules/webgl/webgl_rendering_context_base.h"
 
+#undef ReadPixelsHelper
+#undef readPixels
 #undef getSupportedExtensions
 #undef getExtension
 
@@ -8,6 +8,11 @@
 
 namespace features {
 
+// When enabled, BraveRequestHandler skips OnBeforeURLRequest and
+// OnHeadersReceived helpers whose eligibility predicate rules the request out.
+const base::Feature kBraveRequestHandlerEligibilityChecks{
+    "BraveRequestHandlerEligibilityChecks", base::FEATURE_DISABLED_BY_DEFAULT};
+
 #if defined(OS_ANDROID)
 //  Flag for Brave Rewards.
 #if defined(ARCH_CPU_X86_FAMILY) && defined(OFFICIAL_BUILD)
@@ -12,6 +12,9 @@
 
 namespace features {
 
+COMPONENT_EXPORT(CHROME_FEATURES)
+extern const base::Feature kBraveRequestHandlerEligibilityChecks;
+
 #if defined(OS_ANDROID)
 COMPONENT_EXPORT(CHROME_FEATURES)
 extern const base::Feature kBraveRewards;
@@ -159,6 +159,23 @@ void TestDeserialization() {
         "image");
 }
 
+void TestSerialization() {
+  adblock::Engine engine("-advertisement-icon.\n");
+  std::string serialized;
+  assert(engine.serialize(&serialized));
+  assert(!serialized.empty());
+
+  adblock::Engine engine2("");
+  assert(engine2.deserialize(serialized.data(), serialized.size()));
+  Check(true, false, false, "", "Basic match after a serialization round trip",
+        &engine2, "http://example.com/-advertisement-icon.", "example.com",
+        "example.com", false, "image");
+  Check(false, false, false, "",
+        "Basic not match after a serialization round trip", &engine2,
+        "https://brianbondy.com", "brianbondy.com", "example.com", true,
+        "image");
+}
+
 void TestTags() {
   adblock::Engine engine(
       "-advertisement-icon.$tag=abc\n"
@@ -231,6 +248,38 @@ void TestImportant() {
         "example.com", false, "image");
 }
 
+void TestBatchMatching() {
+  adblock::Engine engine(
+      "-advertisement-icon.\n"
+      "-advertisement-$redirect=test\n"
+      "@@good-advertisement\n");
+  engine.addResource("test", "application/javascript", "YWxlcnQoMSk=");
+  std::vector<adblock::MatchRequest> requests = {
+      {"http://example.com/-advertisement-icon.", "example.com",
+       "example.com", false, "image"},
+      {"https://brianbondy.com", "brianbondy.com", "example.com", true,
+       "image"},
+      {"http://example.com/good-advertisement-icon.", "example.com",
+       "example.com", false, "image"},
+      {"http://example.com/-advertisement-banner", "example.com",
+       "example.com", false, "script"},
+  };
+  std::vector<adblock::MatchResult> results(requests.size());
+  engine.matchesBatch(requests, &results);
+  std::cout << "Batch matching... ";
+  Assert(results[0].did_match_rule && !results[0].did_match_exception,
+         "Expected the first request to be blocked");
+  Assert(!results[1].did_match_rule && !results[1].did_match_exception,
+         "Expected the second request to be allowed");
+  Assert(results[2].did_match_exception,
+         "Expected the third request to match an exception");
+  Assert(results[3].redirect ==
+             "data:application/javascript;base64,YWxlcnQoMSk=",
+         "Expected the fourth request to be redirected");
+  std::cout << "Passed!" << std::endl;
+  num_passed++;
+}
+
 void TestException() {
   adblock::Engine engine("*banner.png\n");
   Check(true, false, false, "", "Without exception", &engine,
@@ -427,11 +476,13 @@ int main() {
 
   TestBasics();
   TestDeserialization();
+  TestSerialization();
   TestTags();
   TestRedirects();
   TestRedirect();
   TestThirdParty();
   TestImportant();
+  TestBatchMatching();
   TestException();
   TestClassId();
   TestUrlCosmetics();
@@ -58,6 +58,39 @@ void engine_match(struct C_Engine* engine,
                   bool* did_match_important,
                   char** redirect);
 
+/**
+ * A single network request to be checked as part of a batch.
+ */
+typedef struct C_MatchRequest {
+  const char* url;
+  const char* host;
+  const char* tab_host;
+  bool third_party;
+  const char* resource_type;
+} C_MatchRequest;
+
+/**
+ * Block results for a single request in a batch. Like `engine_match`, these
+ * are both inputs and outputs so that results accumulate across engines.
+ * `redirect` is only written when this engine found one, in which case it
+ * must be freed with `c_char_buffer_destroy`.
+ */
+typedef struct C_MatchResult {
+  bool did_match_rule;
+  bool did_match_exception;
+  bool did_match_important;
+  char* redirect;
+} C_MatchResult;
+
+/**
+ * Checks `count` requests against the specified `Engine` in a single call,
+ * writing the block results for `requests[i]` into `results[i]`.
+ */
+void engine_match_batch(struct C_Engine* engine,
+                        const C_MatchRequest* requests,
+                        C_MatchResult* results,
+                        size_t count);
+
 /**
  * Returns any CSP directives that should be added to a subdocument or document
  * request's response headers.
@@ -104,6 +137,18 @@ bool engine_deserialize(struct C_Engine* engine,
                         const char* data,
                         size_t data_size);
 
+/**
+ * Serializes the engine so it can later be restored with
+ * `engine_deserialize`. The buffer written to `data` must be released with
+ * `serialized_buffer_destroy`.
+ */
+bool engine_serialize(struct C_Engine* engine, char** data, size_t* data_size);
+
+/**
+ * Destroy a buffer returned by `engine_serialize` once you are done with it.
+ */
+void serialized_buffer_destroy(char* data, size_t data_size);
+
 /**
  * Destroy a `Engine` once you are done with it.
  */
@@ -115,6 +115,73 @@ pub unsafe extern "C" fn engine_match(
     };
 }
 
+/// A single network request to be checked as part of a batch.
+#[repr(C)]
+pub struct MatchRequest {
+    url: *const c_char,
+    host: *const c_char,
+    tab_host: *const c_char,
+    third_party: bool,
+    resource_type: *const c_char,
+}
+
+/// Block results for a single request in a batch. Like `engine_match`, these
+/// are both inputs and outputs so that results accumulate across engines.
+/// `redirect` is only written when this engine found one, in which case it
+/// must be freed with `c_char_buffer_destroy`.
+#[repr(C)]
+pub struct MatchResult {
+    did_match_rule: bool,
+    did_match_exception: bool,
+    did_match_important: bool,
+    redirect: *mut c_char,
+}
+
+/// Checks `count` requests against the specified `Engine` in a single call,
+/// writing the block results for `requests[i]` into `results[i]`.
+#[no_mangle]
+pub unsafe extern "C" fn engine_match_batch(
+    engine: *mut Engine,
+    requests: *const MatchRequest,
+    results: *mut MatchResult,
+    count: size_t,
+) {
+    assert!(!engine.is_null());
+    if count == 0 {
+        return;
+    }
+    let requests = std::slice::from_raw_parts(requests, count);
+    let results = std::slice::from_raw_parts_mut(results, count);
+    let engine = Box::leak(Box::from_raw(engine));
+    for (request, result) in requests.iter().zip(results.iter_mut()) {
+        // Nothing else can change the outcome of an important match.
+        if result.did_match_important {
+            continue;
+        }
+        let url = CStr::from_ptr(request.url).to_str().unwrap();
+        let host = CStr::from_ptr(request.host).to_str().unwrap();
+        let tab_host = CStr::from_ptr(request.tab_host).to_str().unwrap();
+        let resource_type = CStr::from_ptr(request.resource_type).to_str().unwrap();
+        let blocker_result = engine.check_network_urls_with_hostnames_subset(
+            url,
+            host,
+            tab_host,
+            resource_type,
+            Some(request.third_party),
+            result.did_match_rule || result.did_match_exception,
+            !result.did_match_exception,
+        );
+        result.did_match_rule |= blocker_result.matched;
+        result.did_match_exception |= blocker_result.exception.is_some();
+        result.did_match_important |= blocker_result.important;
+        if let Some(redirect) = blocker_result.redirect {
+            if let Ok(redirect) = CString::new(redirect) {
+                result.redirect = redirect.into_raw();
+            }
+        }
+    }
+}
+
 /// Returns any CSP directives that should be added to a subdocument or document request's response
 /// headers.
 #[no_mangle]
@@ -226,6 +293,43 @@ pub unsafe extern "C" fn engine_deserialize(
     ok
 }
 
+/// Serializes the engine so it can later be restored with
+/// `engine_deserialize`. The buffer written to `data` must be released with
+/// `serialized_buffer_destroy`.
+#[no_mangle]
+pub unsafe extern "C" fn engine_serialize(
+    engine: *mut Engine,
+    data: *mut *mut c_char,
+    data_size: *mut size_t,
+) -> bool {
+    assert!(!engine.is_null());
+    assert!(!data.is_null());
+    assert!(!data_size.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    match engine.serialize() {
+        Ok(serialized) => {
+            let serialized = serialized.into_boxed_slice();
+            *data_size = serialized.len();
+            *data = Box::into_raw(serialized) as *mut c_char;
+            true
+        }
+        Err(_) => {
+            eprintln!("Error serializing adblock engine");
+            *data = std::ptr::null_mut();
+            *data_size = 0;
+            false
+        }
+    }
+}
+
+/// Destroy a buffer returned by `engine_serialize` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn serialized_buffer_destroy(data: *mut c_char, data_size: size_t) {
+    if !data.is_null() {
+        drop(Box::from_raw(std::slice::from_raw_parts_mut(data as *mut u8, data_size)));
+    }
+}
+
 /// Destroy a `Engine` once you are done with it.
 #[no_mangle]
 pub unsafe extern "C" fn engine_destroy(engine: *mut Engine) {
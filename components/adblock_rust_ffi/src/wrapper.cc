@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "wrapper.h"  // NOLINT https://github.com/brave/brave-browser/issues/14821
+#include <assert.h>
 #include <iostream>
 
 extern "C" {
@@ -47,6 +48,12 @@ Engine::Engine(const std::string& rules) : raw(engine_create(rules.c_str())) {}
 Engine::Engine(const char* data, size_t data_size)
     : raw(engine_create_from_buffer(data, data_size)) {}
 
+Engine::Engine(const MappedRegion& region)
+    : raw(engine_create("")),
+      valid(engine_deserialize(raw,
+                               reinterpret_cast<const char*>(region.data),
+                               region.size)) {}
+
 void Engine::matches(const std::string& url,
                      const std::string& host,
                      const std::string& tab_host,
@@ -68,6 +75,31 @@ void Engine::matches(const std::string& url,
   }
 }
 
+void Engine::matchesBatch(const std::vector<MatchRequest>& requests,
+                          std::vector<MatchResult>* results) {
+  assert(results && results->size() == requests.size());
+  std::vector<C_MatchResult> raw_results;
+  raw_results.reserve(results->size());
+  for (const auto& result : *results) {
+    raw_results.push_back({result.did_match_rule, result.did_match_exception,
+                           result.did_match_important, nullptr});
+  }
+
+  engine_match_batch(raw, requests.data(), raw_results.data(),
+                     requests.size());
+
+  for (size_t i = 0; i < raw_results.size(); i++) {
+    MatchResult& result = (*results)[i];
+    result.did_match_rule = raw_results[i].did_match_rule;
+    result.did_match_exception = raw_results[i].did_match_exception;
+    result.did_match_important = raw_results[i].did_match_important;
+    if (raw_results[i].redirect) {
+      result.redirect = raw_results[i].redirect;
+      c_char_buffer_destroy(raw_results[i].redirect);
+    }
+  }
+}
+
 std::string Engine::getCspDirectives(const std::string& url,
                                      const std::string& host,
                                      const std::string& tab_host,
@@ -86,6 +118,16 @@ bool Engine::deserialize(const char* data, size_t data_size) {
   return engine_deserialize(raw, data, data_size);
 }
 
+bool Engine::serialize(std::string* data) {
+  char* data_raw = nullptr;
+  size_t data_size = 0;
+  if (!engine_serialize(raw, &data_raw, &data_size))
+    return false;
+  data->assign(data_raw, data_size);
+  serialized_buffer_destroy(data_raw, data_size);
+  return true;
+}
+
 void Engine::addTag(const std::string& tag) {
   engine_add_tag(raw, tag.c_str());
 }
@@ -5,6 +5,9 @@
 
 #ifndef BRAVE_COMPONENTS_ADBLOCK_RUST_FFI_SRC_WRAPPER_H_
 #define BRAVE_COMPONENTS_ADBLOCK_RUST_FFI_SRC_WRAPPER_H_
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -64,11 +67,34 @@ class ADBLOCK_EXPORT FilterList {
   static std::vector<FilterList> regional_list;
 };
 
+// A request to be checked by Engine::matchesBatch. The strings are borrowed
+// and must outlive the call.
+typedef C_MatchRequest MatchRequest;
+
+// Block results for one request of a batch. The flags are accumulated on top
+// of whatever they were set to before the call, just like Engine::matches.
+struct ADBLOCK_EXPORT MatchResult {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string redirect;
+};
+
 class ADBLOCK_EXPORT Engine {
  public:
+  // A read-only view of a serialized engine, typically a memory mapped DAT
+  // file. It only has to stay mapped for the duration of the constructor.
+  struct MappedRegion {
+    const uint8_t* data;
+    size_t size;
+  };
+
   Engine();
   explicit Engine(const std::string& rules);
   Engine(const char* data, size_t data_size);
+  // Deserializes straight out of |region| without copying it into an
+  // intermediate buffer first. Check isValid() for the result.
+  explicit Engine(const MappedRegion& region);
   void matches(const std::string& url,
                const std::string& host,
                const std::string& tab_host,
@@ -78,12 +104,19 @@ class ADBLOCK_EXPORT Engine {
                bool* did_match_exception,
                bool* did_match_important,
                std::string* redirect);
+  // Checks all of |requests| in a single call across the FFI boundary.
+  // |results| must have one entry per request.
+  void matchesBatch(const std::vector<MatchRequest>& requests,
+                    std::vector<MatchResult>* results);
   std::string getCspDirectives(const std::string& url,
                                const std::string& host,
                                const std::string& tab_host,
                                bool is_third_party,
                                const std::string& resource_type);
   bool deserialize(const char* data, size_t data_size);
+  // Writes a buffer that deserialize() accepts into |data|.
+  bool serialize(std::string* data);
+  bool isValid() const { return valid; }
   void addTag(const std::string& tag);
   void addResource(const std::string& key,
                    const std::string& content_type,
@@ -102,6 +135,7 @@ class ADBLOCK_EXPORT Engine {
   Engine(const Engine&) = delete;
   void operator=(const Engine&) = delete;
   C_Engine* raw;
+  bool valid = true;
 };
 
 }  // namespace adblock
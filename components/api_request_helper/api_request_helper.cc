@@ -7,6 +7,11 @@
 
 #include <utility>
 
+#include "base/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "crypto/sha2.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
@@ -15,77 +20,315 @@
 
 namespace api_request_helper {
 
+namespace {
+
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+std::string GetCacheKey(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const base::flat_map<std::string, std::string>& headers) {
+  std::string hashed = payload;
+  for (const auto& entry : headers)
+    hashed += "\n" + entry.first + ":" + entry.second;
+  return method + " " + url.spec() + " " +
+         base::HexEncode(crypto::SHA256HashString(hashed).data(),
+                         crypto::kSHA256Length);
+}
+
+}  // namespace
+
+APIRequestHelper::PendingRequest::PendingRequest() = default;
+APIRequestHelper::PendingRequest::PendingRequest(PendingRequest&&) = default;
+APIRequestHelper::PendingRequest& APIRequestHelper::PendingRequest::operator=(
+    PendingRequest&&) = default;
+APIRequestHelper::PendingRequest::~PendingRequest() = default;
+
+APIRequestHelper::ActiveRequest::ActiveRequest() = default;
+APIRequestHelper::ActiveRequest::ActiveRequest(ActiveRequest&&) = default;
+APIRequestHelper::ActiveRequest& APIRequestHelper::ActiveRequest::operator=(
+    ActiveRequest&&) = default;
+APIRequestHelper::ActiveRequest::~ActiveRequest() = default;
+
+APIRequestHelper::CachedResponse::CachedResponse() = default;
+APIRequestHelper::CachedResponse::CachedResponse(const CachedResponse&) =
+    default;
+APIRequestHelper::CachedResponse::~CachedResponse() = default;
+
 APIRequestHelper::APIRequestHelper(
     net::NetworkTrafficAnnotationTag annotation_tag,
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
     : annotation_tag_(annotation_tag),
-      url_loader_factory_(url_loader_factory) {}
+      url_loader_factory_(url_loader_factory),
+      response_cache_(ResponseCache::NO_AUTO_EVICT) {}
 
 APIRequestHelper::~APIRequestHelper() {}
 
-void APIRequestHelper::Request(
+APIRequestHelper::RequestId APIRequestHelper::Request(
     const std::string& method,
     const GURL& url,
     const std::string& payload,
     const std::string& payload_content_type,
     bool auto_retry_on_network_change,
     ResultCallback callback,
-    const base::flat_map<std::string, std::string>& headers) {
+    const base::flat_map<std::string, std::string>& headers,
+    net::RequestPriority priority) {
+  const RequestId id = next_request_id_++;
+  Schedule(id, method, url, payload, payload_content_type,
+           auto_retry_on_network_change, std::move(callback), headers,
+           priority);
+  return id;
+}
+
+APIRequestHelper::RequestId APIRequestHelper::RequestJson(
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    ValueResultCallback callback,
+    const base::flat_map<std::string, std::string>& headers,
+    net::RequestPriority priority) {
+  const RequestId id = next_request_id_++;
+  Schedule(id, method, url, payload, payload_content_type,
+           auto_retry_on_network_change,
+           base::BindOnce(&APIRequestHelper::ParseJsonResponse,
+                          weak_ptr_factory_.GetWeakPtr(), id,
+                          std::move(callback)),
+           headers, priority);
+  return id;
+}
+
+void APIRequestHelper::Schedule(
+    RequestId id,
+    const std::string& method,
+    const GURL& url,
+    const std::string& payload,
+    const std::string& payload_content_type,
+    bool auto_retry_on_network_change,
+    ResultCallback callback,
+    const base::flat_map<std::string, std::string>& headers,
+    net::RequestPriority priority) {
+  std::string cache_key;
+  if (!cache_ttl_.is_zero()) {
+    cache_key = GetCacheKey(method, url, payload, headers);
+    auto cached = response_cache_.Get(cache_key);
+    if (cached != response_cache_.end()) {
+      if (base::TimeTicks::Now() - cached->second.time < cache_ttl_) {
+        // Keep the callback asynchronous, as it is for network responses.
+        cached_deliveries_.insert(id);
+        base::SequencedTaskRunnerHandle::Get()->PostTask(
+            FROM_HERE, base::BindOnce(&APIRequestHelper::RunCachedResponse,
+                                      weak_ptr_factory_.GetWeakPtr(), id,
+                                      std::move(callback), cached->second));
+        return;
+      }
+      response_cache_.Erase(cached);
+    }
+  }
+
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = url;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
                         net::LOAD_DO_NOT_SAVE_COOKIES;
   request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   request->method = method;
+  request->priority = priority;
 
   if (!headers.empty()) {
     for (auto entry : headers)
       request->headers.SetHeader(entry.first, entry.second);
   }
 
-  auto url_loader =
-      network::SimpleURLLoader::Create(std::move(request), annotation_tag_);
-  if (!payload.empty()) {
-    url_loader->AttachStringForUpload(payload, payload_content_type);
+  PendingRequest pending;
+  pending.id = id;
+  pending.priority = priority;
+  pending.request = std::move(request);
+  pending.payload = payload;
+  pending.payload_content_type = payload_content_type;
+  pending.auto_retry_on_network_change = auto_retry_on_network_change;
+  pending.cache_key = std::move(cache_key);
+  pending.callback = std::move(callback);
+
+  if (max_concurrent_requests_ == 0 ||
+      url_loaders_.size() < max_concurrent_requests_) {
+    Start(std::move(pending));
+  } else {
+    Enqueue(std::move(pending));
+  }
+}
+
+void APIRequestHelper::Cancel(RequestId id) {
+  if (cached_deliveries_.erase(id) || json_parses_.erase(id))
+    return;
+
+  for (auto it = pending_requests_.begin(); it != pending_requests_.end();
+       ++it) {
+    if (it->id == id) {
+      pending_requests_.erase(it);
+      return;
+    }
+  }
+
+  for (auto it = url_loaders_.begin(); it != url_loaders_.end(); ++it) {
+    if (it->id == id) {
+      // Destroying the loader cancels the request and drops the callback.
+      url_loaders_.erase(it);
+      StartPendingRequests();
+      return;
+    }
+  }
+}
+
+void APIRequestHelper::CancelAll() {
+  cached_deliveries_.clear();
+  json_parses_.clear();
+  pending_requests_.clear();
+  url_loaders_.clear();
+}
+
+void APIRequestHelper::SetMaxConcurrentRequests(size_t max_requests) {
+  max_concurrent_requests_ = max_requests;
+  StartPendingRequests();
+}
+
+void APIRequestHelper::EnableResponseCache(base::TimeDelta ttl,
+                                           size_t max_entries) {
+  cache_ttl_ = ttl;
+  cache_max_entries_ = max_entries;
+  response_cache_.ShrinkToSize(cache_max_entries_);
+}
+
+void APIRequestHelper::SetJsonHistogramName(const std::string& name) {
+  json_histogram_name_ = name;
+}
+
+void APIRequestHelper::Enqueue(PendingRequest pending) {
+  auto it = pending_requests_.begin();
+  while (it != pending_requests_.end() && it->priority >= pending.priority)
+    ++it;
+  pending_requests_.insert(it, std::move(pending));
+}
+
+void APIRequestHelper::StartPendingRequests() {
+  while (!pending_requests_.empty() &&
+         (max_concurrent_requests_ == 0 ||
+          url_loaders_.size() < max_concurrent_requests_)) {
+    PendingRequest pending = std::move(pending_requests_.front());
+    pending_requests_.pop_front();
+    Start(std::move(pending));
+  }
+}
+
+void APIRequestHelper::Start(PendingRequest pending) {
+  auto url_loader = network::SimpleURLLoader::Create(
+      std::move(pending.request), annotation_tag_);
+  if (!pending.payload.empty()) {
+    url_loader->AttachStringForUpload(pending.payload,
+                                      pending.payload_content_type);
   }
   url_loader->SetRetryOptions(
       kRetriesCountOnNetworkChange,
-      auto_retry_on_network_change
+      pending.auto_retry_on_network_change
           ? network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE
           : network::SimpleURLLoader::RetryMode::RETRY_NEVER);
   url_loader->SetAllowHttpErrorResults(true);
-  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
-  iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+
+  ActiveRequest active;
+  active.id = pending.id;
+  active.cache_key = std::move(pending.cache_key);
+  active.loader = std::move(url_loader);
+  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(active));
+  iter->loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&APIRequestHelper::OnResponse, base::Unretained(this),
-                     iter, std::move(callback)));
+                     iter, std::move(pending.callback)));
 }
 
 void APIRequestHelper::OnResponse(
-    SimpleURLLoaderList::iterator iter,
+    ActiveRequestList::iterator iter,
     ResultCallback callback,
     const std::unique_ptr<std::string> response_body) {
-  auto* loader = iter->get();
+  auto* loader = iter->loader.get();
   auto response_code = -1;
   base::flat_map<std::string, std::string> headers;
   if (loader->ResponseInfo()) {
     auto headers_list = loader->ResponseInfo()->headers;
     if (headers_list) {
       response_code = headers_list->response_code();
-      size_t iter = 0;
+      size_t header_iter = 0;
       std::string key;
       std::string value;
-      while (headers_list->EnumerateHeaderLines(&iter, &key, &value)) {
+      while (headers_list->EnumerateHeaderLines(&header_iter, &key, &value)) {
         key = base::ToLowerASCII(key);
         headers[key] = value;
       }
     }
   }
+
+  if (!iter->cache_key.empty() && response_code >= 200 &&
+      response_code < 300 && response_body) {
+    CachedResponse cached;
+    cached.time = base::TimeTicks::Now();
+    cached.response_code = response_code;
+    cached.body = *response_body;
+    cached.headers = headers;
+    response_cache_.Put(iter->cache_key, std::move(cached));
+    response_cache_.ShrinkToSize(cache_max_entries_);
+  }
+
   url_loaders_.erase(iter);
+  // Start queued requests before running the callback, which may destroy
+  // this helper.
+  StartPendingRequests();
   std::move(callback).Run(response_code, response_body ? *response_body : "",
                           headers);
 }
 
+void APIRequestHelper::RunCachedResponse(RequestId id,
+                                         ResultCallback callback,
+                                         const CachedResponse& response) {
+  if (!cached_deliveries_.erase(id))
+    return;
+  std::move(callback).Run(response.response_code, response.body,
+                          response.headers);
+}
+
+void APIRequestHelper::ParseJsonResponse(
+    RequestId id,
+    ValueResultCallback callback,
+    const int response_code,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (!json_histogram_name_.empty()) {
+    base::UmaHistogramCounts10M(
+        "Brave.APIRequestHelper.JsonBodySize." + json_histogram_name_,
+        body.size());
+  }
+  json_parses_.insert(id);
+  data_decoder::DataDecoder::ParseJsonIsolated(
+      body, base::BindOnce(&APIRequestHelper::OnJsonParsed,
+                           weak_ptr_factory_.GetWeakPtr(), id,
+                           std::move(callback), response_code, headers,
+                           base::TimeTicks::Now()));
+}
+
+void APIRequestHelper::OnJsonParsed(
+    RequestId id,
+    ValueResultCallback callback,
+    const int response_code,
+    const base::flat_map<std::string, std::string>& headers,
+    base::TimeTicks start_time,
+    data_decoder::DataDecoder::ValueOrError result) {
+  if (!json_parses_.erase(id))
+    return;
+  if (!json_histogram_name_.empty()) {
+    base::UmaHistogramTimes(
+        "Brave.APIRequestHelper.JsonParseTime." + json_histogram_name_,
+        base::TimeTicks::Now() - start_time);
+  }
+  std::move(callback).Run(response_code, std::move(result.value), headers);
+}
+
 }  // namespace api_request_helper
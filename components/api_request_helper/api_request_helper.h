@@ -12,17 +12,32 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/base/request_priority.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/data_decoder/public/cpp/data_decoder.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
 class SharedURLLoaderFactory;
 class SimpleURLLoader;
+struct ResourceRequest;
 }  // namespace network
 
 namespace api_request_helper {
 
 // Anyone is welcome to use APIRequestHelper to reduce boilerplate
+//
+// By default every request is sent right away. Owners that issue bursts of
+// requests can cap how many run at once with SetMaxConcurrentRequests();
+// queued requests then start in priority order. Successful responses can be
+// kept for a while with EnableResponseCache(). RequestJson() parses the
+// body out of process with data_decoder instead of on the calling thread.
 class APIRequestHelper {
  public:
   APIRequestHelper(
@@ -30,30 +45,148 @@ class APIRequestHelper {
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
   ~APIRequestHelper();
 
+  // Identifies a request for Cancel(). Never 0.
+  using RequestId = int;
+
   using ResultCallback =
       base::OnceCallback<void(const int,
                               const std::string&,
                               const base::flat_map<std::string, std::string>&)>;
-  void Request(const std::string& method,
-               const GURL& url,
-               const std::string& payload,
-               const std::string& payload_content_type,
-               bool auto_retry_on_network_change,
-               ResultCallback callback,
-               const base::flat_map<std::string, std::string>& headers = {});
+  RequestId Request(
+      const std::string& method,
+      const GURL& url,
+      const std::string& payload,
+      const std::string& payload_content_type,
+      bool auto_retry_on_network_change,
+      ResultCallback callback,
+      const base::flat_map<std::string, std::string>& headers = {},
+      net::RequestPriority priority = net::IDLE);
+
+  // |value| is absl::nullopt when the body isn't valid JSON.
+  using ValueResultCallback = base::OnceCallback<void(
+      const int,
+      absl::optional<base::Value> value,
+      const base::flat_map<std::string, std::string>&)>;
+  RequestId RequestJson(
+      const std::string& method,
+      const GURL& url,
+      const std::string& payload,
+      const std::string& payload_content_type,
+      bool auto_retry_on_network_change,
+      ValueResultCallback callback,
+      const base::flat_map<std::string, std::string>& headers = {},
+      net::RequestPriority priority = net::IDLE);
+
+  // Drops the request, whether it is queued or in flight. Its callback is
+  // never run.
+  void Cancel(RequestId id);
+  void CancelAll();
+
+  // 0, the default, means no limit.
+  void SetMaxConcurrentRequests(size_t max_requests);
+
+  // Answers identical requests (same method, URL, payload and headers) from
+  // memory for |ttl| after a 2xx response. Keeps at most |max_entries|.
+  void EnableResponseCache(base::TimeDelta ttl, size_t max_entries);
+
+  // Makes RequestJson() record body size and parse time under
+  // Brave.APIRequestHelper.Json{BodySize,ParseTime}.|name|.
+  void SetJsonHistogramName(const std::string& name);
 
  private:
   APIRequestHelper(const APIRequestHelper&) = delete;
   APIRequestHelper& operator=(const APIRequestHelper&) = delete;
-  using SimpleURLLoaderList =
-      std::list<std::unique_ptr<network::SimpleURLLoader>>;
-  void OnResponse(SimpleURLLoaderList::iterator iter,
+
+  struct PendingRequest {
+    PendingRequest();
+    PendingRequest(PendingRequest&&);
+    PendingRequest& operator=(PendingRequest&&);
+    ~PendingRequest();
+
+    RequestId id = 0;
+    net::RequestPriority priority = net::IDLE;
+    std::unique_ptr<network::ResourceRequest> request;
+    std::string payload;
+    std::string payload_content_type;
+    bool auto_retry_on_network_change = false;
+    std::string cache_key;
+    ResultCallback callback;
+  };
+
+  struct ActiveRequest {
+    ActiveRequest();
+    ActiveRequest(ActiveRequest&&);
+    ActiveRequest& operator=(ActiveRequest&&);
+    ~ActiveRequest();
+
+    RequestId id = 0;
+    std::string cache_key;
+    std::unique_ptr<network::SimpleURLLoader> loader;
+  };
+
+  struct CachedResponse {
+    CachedResponse();
+    CachedResponse(const CachedResponse&);
+    ~CachedResponse();
+
+    base::TimeTicks time;
+    int response_code = -1;
+    std::string body;
+    base::flat_map<std::string, std::string> headers;
+  };
+
+  using ActiveRequestList = std::list<ActiveRequest>;
+  using ResponseCache = base::MRUCache<std::string, CachedResponse>;
+
+  void Schedule(RequestId id,
+                const std::string& method,
+                const GURL& url,
+                const std::string& payload,
+                const std::string& payload_content_type,
+                bool auto_retry_on_network_change,
+                ResultCallback callback,
+                const base::flat_map<std::string, std::string>& headers,
+                net::RequestPriority priority);
+  void Enqueue(PendingRequest pending);
+  void StartPendingRequests();
+  void Start(PendingRequest pending);
+  void OnResponse(ActiveRequestList::iterator iter,
                   ResultCallback callback,
                   const std::unique_ptr<std::string> response_body);
+  void RunCachedResponse(RequestId id,
+                         ResultCallback callback,
+                         const CachedResponse& response);
+  void ParseJsonResponse(
+      RequestId id,
+      ValueResultCallback callback,
+      const int response_code,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  void OnJsonParsed(RequestId id,
+                    ValueResultCallback callback,
+                    const int response_code,
+                    const base::flat_map<std::string, std::string>& headers,
+                    base::TimeTicks start_time,
+                    data_decoder::DataDecoder::ValueOrError result);
 
   net::NetworkTrafficAnnotationTag annotation_tag_;
-  SimpleURLLoaderList url_loaders_;
+  ActiveRequestList url_loaders_;
+  // Ordered by priority, highest first, and FIFO within a priority.
+  std::list<PendingRequest> pending_requests_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  size_t max_concurrent_requests_ = 0;
+  RequestId next_request_id_ = 1;
+
+  base::TimeDelta cache_ttl_;
+  size_t cache_max_entries_ = 0;
+  ResponseCache response_cache_;
+  // Requests answered from |response_cache_| whose callback hasn't run yet.
+  base::flat_set<RequestId> cached_deliveries_;
+  // RequestJson() requests whose body is being parsed.
+  base::flat_set<RequestId> json_parses_;
+  std::string json_histogram_name_;
+
+  base::WeakPtrFactory<APIRequestHelper> weak_ptr_factory_{this};
 };
 
 }  // namespace api_request_helper
@@ -0,0 +1,167 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/api_request_helper/api_request_helper.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace api_request_helper {
+
+class APIRequestHelperTest : public testing::Test {
+ public:
+  APIRequestHelperTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        helper_(TRAFFIC_ANNOTATION_FOR_TESTS, shared_url_loader_factory_) {}
+
+ protected:
+  APIRequestHelper::RequestId Request(const std::string& url,
+                                      net::RequestPriority priority) {
+    return helper_.Request(
+        "GET", GURL(url), "", "", false,
+        base::BindOnce(&APIRequestHelperTest::OnResponse,
+                       base::Unretained(this), url),
+        {}, priority);
+  }
+
+  void OnResponse(const std::string& url,
+                  const int status,
+                  const std::string& body,
+                  const base::flat_map<std::string, std::string>& headers) {
+    responses_.push_back(url + " " + body);
+  }
+
+  std::vector<std::string> PendingURLs() {
+    std::vector<std::string> urls;
+    for (const auto& pending : *url_loader_factory_.pending_requests()) {
+      if (pending.client.is_connected())
+        urls.push_back(pending.request.url.spec());
+    }
+    return urls;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  APIRequestHelper helper_;
+  std::vector<std::string> responses_;
+};
+
+TEST_F(APIRequestHelperTest, QueuesByPriority) {
+  helper_.SetMaxConcurrentRequests(1);
+  Request("https://a.example/", net::LOW);
+  Request("https://b.example/", net::LOW);
+  Request("https://c.example/", net::HIGHEST);
+  EXPECT_EQ(PendingURLs(), std::vector<std::string>{"https://a.example/"});
+
+  url_loader_factory_.SimulateResponseForPendingRequest("https://a.example/",
+                                                        "a");
+  EXPECT_EQ(PendingURLs(), std::vector<std::string>{"https://c.example/"});
+  url_loader_factory_.SimulateResponseForPendingRequest("https://c.example/",
+                                                        "c");
+  EXPECT_EQ(PendingURLs(), std::vector<std::string>{"https://b.example/"});
+  url_loader_factory_.SimulateResponseForPendingRequest("https://b.example/",
+                                                        "b");
+  EXPECT_EQ(responses_,
+            (std::vector<std::string>{"https://a.example/ a",
+                                      "https://c.example/ c",
+                                      "https://b.example/ b"}));
+}
+
+TEST_F(APIRequestHelperTest, Cancel) {
+  helper_.SetMaxConcurrentRequests(1);
+  auto active = Request("https://a.example/", net::LOW);
+  auto queued = Request("https://b.example/", net::LOW);
+  Request("https://c.example/", net::LOW);
+
+  helper_.Cancel(queued);
+  helper_.Cancel(active);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(PendingURLs(), std::vector<std::string>{"https://c.example/"});
+  url_loader_factory_.SimulateResponseForPendingRequest("https://c.example/",
+                                                        "c");
+  EXPECT_EQ(responses_, std::vector<std::string>{"https://c.example/ c"});
+}
+
+TEST_F(APIRequestHelperTest, ResponseCache) {
+  helper_.EnableResponseCache(base::TimeDelta::FromMinutes(1), 1);
+  Request("https://a.example/", net::LOW);
+  url_loader_factory_.SimulateResponseForPendingRequest("https://a.example/",
+                                                        "a");
+
+  // Answered from memory, still asynchronously.
+  Request("https://a.example/", net::LOW);
+  EXPECT_EQ(url_loader_factory_.NumPending(), 0);
+  EXPECT_EQ(responses_.size(), 1u);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(responses_.size(), 2u);
+  EXPECT_EQ(responses_[1], "https://a.example/ a");
+
+  // A cached delivery can be cancelled too.
+  helper_.Cancel(Request("https://a.example/", net::LOW));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(responses_.size(), 2u);
+
+  // Only one entry is kept.
+  Request("https://b.example/", net::LOW);
+  url_loader_factory_.SimulateResponseForPendingRequest("https://b.example/",
+                                                        "b");
+  Request("https://a.example/", net::LOW);
+  EXPECT_EQ(url_loader_factory_.NumPending(), 1);
+
+  task_environment_.AdvanceClock(base::TimeDelta::FromMinutes(2));
+  Request("https://b.example/", net::LOW);
+  EXPECT_EQ(url_loader_factory_.NumPending(), 2);
+}
+
+TEST_F(APIRequestHelperTest, RequestJson) {
+  base::HistogramTester histogram_tester;
+  helper_.SetJsonHistogramName("Test");
+  std::vector<absl::optional<base::Value>> values;
+  auto callback = [](std::vector<absl::optional<base::Value>>* values,
+                     const int status, absl::optional<base::Value> value,
+                     const base::flat_map<std::string, std::string>& headers) {
+    values->push_back(std::move(value));
+  };
+  helper_.RequestJson("GET", GURL("https://a.example/"), "", "", false,
+                      base::BindOnce(callback, &values));
+  helper_.RequestJson("GET", GURL("https://b.example/"), "", "", false,
+                      base::BindOnce(callback, &values));
+  auto cancelled =
+      helper_.RequestJson("GET", GURL("https://c.example/"), "", "", false,
+                          base::BindOnce(callback, &values));
+
+  url_loader_factory_.AddResponse("https://a.example/", R"({"a": 1})");
+  url_loader_factory_.AddResponse("https://b.example/", "not json");
+  url_loader_factory_.AddResponse("https://c.example/", "[]");
+  helper_.Cancel(cancelled);
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_EQ(values.size(), 2u);
+  ASSERT_TRUE(values[0]);
+  EXPECT_EQ(values[0]->FindIntKey("a"), 1);
+  EXPECT_FALSE(values[1]);
+  histogram_tester.ExpectTotalCount(
+      "Brave.APIRequestHelper.JsonBodySize.Test", 2);
+  histogram_tester.ExpectTotalCount(
+      "Brave.APIRequestHelper.JsonParseTime.Test", 2);
+}
+
+}  // namespace api_request_helper
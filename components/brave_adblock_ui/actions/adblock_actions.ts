@@ -64,3 +64,12 @@ export const viewSubscriptionSource = (listUrl: string) =>
   action(types.ADBLOCK_VIEW_SUBSCRIPTION_SOURCE, {
     listUrl
   })
+
+export const getEngineStats = () => action(types.ADBLOCK_GET_ENGINE_STATS)
+
+export const onGetEngineStats = (engineStats: AdBlock.EngineStats[]) =>
+  action(types.ADBLOCK_ON_GET_ENGINE_STATS, {
+    engineStats
+  })
+
+export const resetEngineStats = () => action(types.ADBLOCK_RESET_ENGINE_STATS)
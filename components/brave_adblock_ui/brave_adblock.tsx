@@ -29,10 +29,16 @@ function getListSubscriptions () {
   actions.getListSubscriptions()
 }
 
+function getEngineStats () {
+  const actions = bindActionCreators(adblockActions, store.dispatch.bind(store))
+  actions.getEngineStats()
+}
+
 function initialize () {
   getCustomFilters()
   getRegionalLists()
   getListSubscriptions()
+  getEngineStats()
   render(
     <Provider store={store}>
       <App />
@@ -55,13 +61,19 @@ function onGetListSubscriptions (listSubscriptions: AdBlock.SubscriptionInfo[])
   actions.onGetListSubscriptions(listSubscriptions)
 }
 
+function onGetEngineStats (engineStats: AdBlock.EngineStats[]) {
+  const actions = bindActionCreators(adblockActions, store.dispatch.bind(store))
+  actions.onGetEngineStats(engineStats)
+}
+
 // Expose functions to Page Handlers.
 // TODO(petemill): Use event listeners instead.
 // @ts-ignore
 window.brave_adblock = {
   onGetCustomFilters,
   onGetRegionalLists,
-  onGetListSubscriptions
+  onGetListSubscriptions,
+  onGetEngineStats
 }
 
 document.addEventListener('DOMContentLoaded', initialize)
@@ -10,6 +10,7 @@ import { connect } from 'react-redux'
 import { AdBlockItemList } from './adBlockItemList'
 import { CustomSubscriptions } from './customSubscriptions'
 import { CustomFilters } from './customFilters'
+import { EngineStats } from './engineStats'
 
 // Utils
 import * as adblockActions from '../actions/adblock_actions'
@@ -44,6 +45,10 @@ export class AdblockPage extends React.Component<Props, {}> {
           actions={actions}
           rules={adblockData.settings.customFilters || ''}
         />
+        <EngineStats
+          actions={actions}
+          stats={adblockData.engineStats || []}
+        />
       </div>
     )
   }
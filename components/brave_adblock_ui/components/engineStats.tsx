@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+import * as React from 'react'
+
+interface Props {
+  actions: any,
+  stats: AdBlock.EngineStats[]
+}
+
+// Sampled matching cost per engine, as collected when the
+// BraveAdblockEngineStats feature is enabled. Engines are listed slowest
+// first so the list worth looking at is at the top.
+export class EngineStats extends React.Component<Props, {}> {
+  constructor (props: Props) {
+    super(props)
+  }
+
+  onRefresh = (event: React.MouseEvent<HTMLButtonElement>) => {
+    this.props.actions.getEngineStats()
+  }
+
+  onReset = (event: React.MouseEvent<HTMLButtonElement>) => {
+    this.props.actions.resetEngineStats()
+  }
+
+  renderTable = (stats: AdBlock.EngineStats[]) => {
+    const columns = ['Engine', 'Samples', 'Requests', 'Matches', 'Total (ms)', 'Mean (us)', 'Max (us)']
+    const header = columns.map((column, i) => (
+      <div key={column} className='filterListGridCell' style={{ gridRow: 1, gridColumn: i + 1, fontWeight: 'bold' }}>{column}</div>
+    ))
+    const sorted = [...stats].sort((a, b) => b.total_time_ms - a.total_time_ms)
+    const rows = sorted.map((entry, i) => {
+      const values = [
+        entry.engine,
+        entry.samples,
+        entry.requests,
+        entry.matches,
+        entry.total_time_ms.toFixed(2),
+        entry.mean_time_us.toFixed(1),
+        entry.max_time_us.toFixed(1)
+      ]
+      return values.map((value, j) => (
+        <div key={entry.engine + j} className='filterListGridCell' style={{ gridRow: i + 2, gridColumn: j + 1 }}>{value}</div>
+      ))
+    })
+    return (
+      <div style={{ display: 'grid', gridTemplateColumns: 'auto repeat(6, max-content)', marginTop: '10px' }}>
+        {header}
+        {rows}
+      </div>
+    )
+  }
+
+  render () {
+    return (
+      <div>
+        <div
+          style={{ fontSize: '18px', marginTop: '20px' }}
+        >
+          {'Engine matching time'}
+        </div>
+        {this.props.stats.length === 0 ? (
+          <div>{'No samples recorded. Enable the BraveAdblockEngineStats feature to collect them.'}</div>
+        ) : this.renderTable(this.props.stats)}
+        <div style={{ marginTop: '10px' }}>
+          <button onClick={this.onRefresh}>{'Refresh'}</button>
+          <button onClick={this.onReset}>{'Reset'}</button>
+        </div>
+      </div>
+    )
+  }
+}
@@ -15,5 +15,8 @@ export const enum types {
   ADBLOCK_SET_SUBSCRIPTION_ENABLED = '@@adblock/ADBLOCK_SET_SUBSCRIPTION_ENABLED',
   ADBLOCK_DELETE_SUBSCRIPTION = '@@adblock/ADBLOCK_DELETE_SUBSCRIPTION',
   ADBLOCK_REFRESH_SUBSCRIPTION = '@@adblock/ADBLOCK_REFRESH_SUBSCRIPTION',
-  ADBLOCK_VIEW_SUBSCRIPTION_SOURCE = '@@adblock/ADBLOCK_VIEW_SUBSCRIPTION_SOURCE'
+  ADBLOCK_VIEW_SUBSCRIPTION_SOURCE = '@@adblock/ADBLOCK_VIEW_SUBSCRIPTION_SOURCE',
+  ADBLOCK_GET_ENGINE_STATS = '@@adblock/ADBLOCK_GET_ENGINE_STATS',
+  ADBLOCK_ON_GET_ENGINE_STATS = '@@adblock/ADBLOCK_ON_GET_ENGINE_STATS',
+  ADBLOCK_RESET_ENGINE_STATS = '@@adblock/ADBLOCK_RESET_ENGINE_STATS'
 }
@@ -58,6 +58,12 @@ const adblockReducer: Reducer<AdBlock.State | undefined> = (state: AdBlock.State
     case types.ADBLOCK_VIEW_SUBSCRIPTION_SOURCE:
       chrome.send('brave_adblock.viewSubscriptionSource', [action.payload.listUrl])
       break
+    case types.ADBLOCK_GET_ENGINE_STATS:
+      chrome.send('brave_adblock.getEngineStats')
+      break
+    case types.ADBLOCK_RESET_ENGINE_STATS:
+      chrome.send('brave_adblock.resetEngineStats')
+      break
     case types.ADBLOCK_ON_GET_CUSTOM_FILTERS:
       state = { ...state, settings: { ...state.settings, customFilters: action.payload.customFilters } }
       break
@@ -67,6 +73,9 @@ const adblockReducer: Reducer<AdBlock.State | undefined> = (state: AdBlock.State
     case types.ADBLOCK_ON_GET_LIST_SUBSCRIPTIONS:
       state = { ...state, settings: { ...state.settings, listSubscriptions: action.payload.listSubscriptions } }
       break
+    case types.ADBLOCK_ON_GET_ENGINE_STATS:
+      state = { ...state, engineStats: action.payload.engineStats }
+      break
     case types.ADBLOCK_UPDATE_CUSTOM_FILTERS:
       state = { ...state, settings: { ...state.settings, customFilters: action.payload.customFilters } }
       updateCustomFilters(state.settings.customFilters)
@@ -11,7 +11,8 @@ export const defaultState: AdBlock.State = {
     customFilters: '',
     regionalLists: [],
     listSubscriptions: []
-  }
+  },
+  engineStats: []
 }
 
 export const load = (): AdBlock.State => {
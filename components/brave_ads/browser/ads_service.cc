@@ -66,6 +66,7 @@ void AdsService::RegisterProfilePrefs(
   registry->RegisterInt64Pref(ads::prefs::kCatalogPing, 0);
   registry->RegisterDoublePref(ads::prefs::kCatalogLastUpdated,
                                base::Time().ToDoubleT());
+  registry->RegisterStringPref(ads::prefs::kCatalogETag, "");
 
   registry->RegisterStringPref(ads::prefs::kEpsilonGreedyBanditArms, "");
   registry->RegisterStringPref(ads::prefs::kEpsilonGreedyBanditEligibleSegments,
@@ -95,6 +95,7 @@
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/dom_distiller_js/dom_distiller.pb.h"
 #include "ui/base/l10n/l10n_util.h"
+#include "ui/base/page_transition_types.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "ui/message_center/public/cpp/notification.h"
 #include "ui/message_center/public/cpp/notification_types.h"
@@ -243,6 +244,9 @@ AdsServiceImpl::AdsServiceImpl(
   DCHECK(history_service_);
   DCHECK(brave::IsRegularProfile(profile_));
 
+  ads_client_pref_change_registrar_.Init(profile_->GetPrefs());
+  history_service_observation_.Observe(history_service_);
+
   MigratePrefs();
 
   MaybeInitialize();
@@ -267,6 +271,10 @@ void AdsServiceImpl::SetEnabled(const bool is_enabled) {
   SetBooleanPref(ads::prefs::kEnabled, is_enabled);
 }
 
+bool AdsServiceImpl::ShouldAllowConversionTracking() const {
+  return GetBooleanPref(ads::prefs::kShouldAllowConversionTracking);
+}
+
 void AdsServiceImpl::SetAllowConversionTracking(const bool should_allow) {
   SetBooleanPref(ads::prefs::kShouldAllowConversionTracking, should_allow);
 }
@@ -908,6 +916,12 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const uint32_t number_of_start,
       bat_ads_.BindNewEndpointAndPassReceiver(),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
+  const std::map<std::string, std::vector<double>> ad_events =
+      FrequencyCappingHelper::GetInstance()->GetAllAdEvents();
+  bat_ads_->SetAdEventHistory(
+      base::flat_map<std::string, std::vector<double>>(ad_events.begin(),
+                                                       ad_events.end()));
+
   const std::string locale = GetLocale();
   RegisterResourceComponentsForLocale(locale);
 
@@ -1848,7 +1862,31 @@ void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
   }
 }
 
-bool AdsServiceImpl::connected() {
+void AdsServiceImpl::ObserveAdsClientPref(const std::string& path) const {
+  if (ads_client_pref_change_registrar_.IsObserved(path)) {
+    return;
+  }
+
+  ads_client_pref_change_registrar_.Add(
+      path, base::BindRepeating(&AdsServiceImpl::OnAdsClientPrefChanged,
+                                base::Unretained(this)));
+}
+
+void AdsServiceImpl::OnAdsClientPrefChanged(const std::string& path) const {
+  if (!connected()) {
+    return;
+  }
+
+  const PrefService::Preference* pref =
+      profile_->GetPrefs()->FindPreference(path);
+  if (!pref) {
+    return;
+  }
+
+  bat_ads_->OnPrefValueChanged(path, pref->GetValue()->Clone());
+}
+
+bool AdsServiceImpl::connected() const {
   return bat_ads_.is_bound() && !g_browser_process->IsShuttingDown();
 }
 
@@ -2131,6 +2169,33 @@ void AdsServiceImpl::OnBrowsingHistorySearchComplete(
   callback(history);
 }
 
+void AdsServiceImpl::OnURLVisited(history::HistoryService* history_service,
+                                  ui::PageTransition transition,
+                                  const history::URLRow& row,
+                                  const history::RedirectList& redirects,
+                                  base::Time visit_time) {
+  if (!connected()) {
+    return;
+  }
+
+  // Subframe and mid-redirect visits aren't in GetBrowsingHistory results.
+  if (!ui::PageTransitionIsMainFrame(transition) ||
+      !(transition & ui::PAGE_TRANSITION_CHAIN_END)) {
+    return;
+  }
+
+  bat_ads_->OnBrowsingHistoryVisited(row.url().GetWithEmptyPath().spec());
+}
+
+void AdsServiceImpl::OnURLsDeleted(history::HistoryService* history_service,
+                                   const history::DeletionInfo& deletion_info) {
+  if (!connected()) {
+    return;
+  }
+
+  bat_ads_->OnBrowsingHistoryDeleted();
+}
+
 void AdsServiceImpl::RecordP2AEvent(const std::string& name,
                                     const ads::mojom::P2AEventType type,
                                     const std::string& value) {
@@ -2262,44 +2327,58 @@ void AdsServiceImpl::Log(const char* file,
 }
 
 bool AdsServiceImpl::GetBooleanPref(const std::string& path) const {
+  ObserveAdsClientPref(path);
+
   return profile_->GetPrefs()->GetBoolean(path);
 }
 
 void AdsServiceImpl::SetBooleanPref(const std::string& path, const bool value) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->SetBoolean(path, value);
   OnPrefChanged(path);
 }
 
 int AdsServiceImpl::GetIntegerPref(const std::string& path) const {
+  ObserveAdsClientPref(path);
+
   return profile_->GetPrefs()->GetInteger(path);
 }
 
 void AdsServiceImpl::SetIntegerPref(const std::string& path, const int value) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->SetInteger(path, value);
   OnPrefChanged(path);
 }
 
 double AdsServiceImpl::GetDoublePref(const std::string& path) const {
+  ObserveAdsClientPref(path);
+
   return profile_->GetPrefs()->GetDouble(path);
 }
 
 void AdsServiceImpl::SetDoublePref(const std::string& path,
                                    const double value) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->SetDouble(path, value);
   OnPrefChanged(path);
 }
 
 std::string AdsServiceImpl::GetStringPref(const std::string& path) const {
+  ObserveAdsClientPref(path);
+
   return profile_->GetPrefs()->GetString(path);
 }
 
 void AdsServiceImpl::SetStringPref(const std::string& path,
                                    const std::string& value) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->SetString(path, value);
   OnPrefChanged(path);
 }
 
 int64_t AdsServiceImpl::GetInt64Pref(const std::string& path) const {
+  ObserveAdsClientPref(path);
+
   const std::string integer_as_string = profile_->GetPrefs()->GetString(path);
   DCHECK(!integer_as_string.empty());
 
@@ -2310,11 +2389,14 @@ int64_t AdsServiceImpl::GetInt64Pref(const std::string& path) const {
 
 void AdsServiceImpl::SetInt64Pref(const std::string& path,
                                   const int64_t value) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->SetInt64(path, value);
   OnPrefChanged(path);
 }
 
 uint64_t AdsServiceImpl::GetUint64Pref(const std::string& path) const {
+  ObserveAdsClientPref(path);
+
   const std::string integer_as_string = profile_->GetPrefs()->GetString(path);
   DCHECK(!integer_as_string.empty());
 
@@ -2325,11 +2407,13 @@ uint64_t AdsServiceImpl::GetUint64Pref(const std::string& path) const {
 
 void AdsServiceImpl::SetUint64Pref(const std::string& path,
                                    const uint64_t value) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->SetUint64(path, value);
   OnPrefChanged(path);
 }
 
 void AdsServiceImpl::ClearPref(const std::string& path) {
+  ObserveAdsClientPref(path);
   profile_->GetPrefs()->ClearPref(path);
   OnPrefChanged(path);
 }
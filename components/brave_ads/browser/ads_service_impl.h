@@ -17,6 +17,7 @@
 
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
 #include "base/timer/timer.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/ads_client.h"
@@ -99,6 +100,7 @@ class AdsServiceImpl : public AdsService,
   bool IsEnabled() const override;
   void SetEnabled(const bool is_enabled) override;
 
+  bool ShouldAllowConversionTracking() const override;
   void SetAllowConversionTracking(const bool should_allow) override;
 
   int64_t GetAdsPerHour() const override;
@@ -347,6 +349,11 @@ class AdsServiceImpl : public AdsService,
   bool PrefExists(const std::string& path) const;
   void OnPrefsChanged(const std::string& pref);
 
+  // The utility process mirrors every pref it reads or writes, so changes to
+  // those prefs are pushed to it from here.
+  void ObserveAdsClientPref(const std::string& path) const;
+  void OnAdsClientPrefChanged(const std::string& path) const;
+
   std::string GetLocale() const;
 
   std::string LoadDataResourceAndDecompressIfNeeded(const int id) const;
@@ -354,7 +361,7 @@ class AdsServiceImpl : public AdsService,
   void StartNotificationTimeoutTimer(const std::string& uuid);
   bool StopNotificationTimeoutTimer(const std::string& uuid);
 
-  bool connected();
+  bool connected() const;
 
   bool IsBraveNewsEnabled() const;
   bool ShouldStart() const;
@@ -464,9 +471,21 @@ class AdsServiceImpl : public AdsService,
   void OnBackground() override;
   void OnForeground() override;
 
+  // history::HistoryServiceObserver implementation
+  void OnURLVisited(history::HistoryService* history_service,
+                    ui::PageTransition transition,
+                    const history::URLRow& row,
+                    const history::RedirectList& redirects,
+                    base::Time visit_time) override;
+  void OnURLsDeleted(history::HistoryService* history_service,
+                     const history::DeletionInfo& deletion_info) override;
+
   Profile* profile_;  // NOT OWNED
 
   history::HistoryService* history_service_;  // NOT OWNED
+  base::ScopedObservation<history::HistoryService,
+                          history::HistoryServiceObserver>
+      history_service_observation_{this};
 
 #if BUILDFLAG(BRAVE_ADAPTIVE_CAPTCHA_ENABLED)
   brave_adaptive_captcha::BraveAdaptiveCaptchaService*
@@ -502,6 +521,9 @@ class AdsServiceImpl : public AdsService,
 
   PrefChangeRegistrar profile_pref_change_registrar_;
 
+  // Mutable as prefs are observed from the const AdsClient getters.
+  mutable PrefChangeRegistrar ads_client_pref_change_registrar_;
+
   SimpleURLLoaderList url_loaders_;
 
   NotificationDisplayService* display_service_;     // NOT OWNED
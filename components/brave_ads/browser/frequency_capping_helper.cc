@@ -31,4 +31,9 @@ void FrequencyCappingHelper::ResetAdEvents() {
   history_.Reset();
 }
 
+std::map<std::string, std::vector<double>>
+FrequencyCappingHelper::GetAllAdEvents() const {
+  return history_.GetAll();
+}
+
 }  // namespace brave_ads
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_FREQUENCY_CAPPING_HELPER_H_
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_FREQUENCY_CAPPING_HELPER_H_
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,8 @@ class FrequencyCappingHelper {
 
   void ResetAdEvents();
 
+  std::map<std::string, std::vector<double>> GetAllAdEvents() const;
+
  private:
   friend struct base::DefaultSingletonTraits<FrequencyCappingHelper>;
 
@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
 
 namespace brave_component_updater {
 
@@ -50,6 +52,56 @@ LoadDATFileDataResult<T> LoadRawFileData(const base::FilePath& dat_file_path) {
   return LoadDATFileDataResult<T>(std::move(client), std::move(buffer));
 }
 
+// Concatenates the contents of every readable file in |file_paths|, one list
+// per line block, and builds a single |T| from the combined rules.
+template <typename T>
+LoadDATFileDataResult<T> LoadRawFilesData(
+    const std::vector<base::FilePath>& file_paths) {
+  DATFileDataBuffer buffer;
+  for (const auto& file_path : file_paths) {
+    DATFileDataBuffer file_buffer;
+    GetDATFileData(file_path, &file_buffer);
+    if (file_buffer.empty())
+      continue;
+    buffer.insert(buffer.end(), file_buffer.begin(), file_buffer.end());
+    buffer.push_back('\n');
+  }
+  std::unique_ptr<T> client;
+
+  if (!buffer.empty())
+    client = std::make_unique<T>(reinterpret_cast<char*>(&buffer.front()),
+                                 buffer.size());
+
+  return LoadDATFileDataResult<T>(std::move(client), std::move(buffer));
+}
+
+// The client and the number of bytes that were deserialized straight from
+// the memory mapped DAT file instead of a heap buffer.
+template <typename T>
+using LoadMappedDATFileDataResult = std::pair<std::unique_ptr<T>, size_t>;
+
+// Deserializes |T| directly out of a read-only mapping of |dat_file_path|.
+// |T| must be constructible from a |typename T::MappedRegion| and report
+// success through isValid(). The mapping is released before returning.
+template <typename T>
+LoadMappedDATFileDataResult<T> LoadMappedDATFileData(
+    const base::FilePath& dat_file_path) {
+  base::MemoryMappedFile mapped_file;
+  if (!mapped_file.Initialize(dat_file_path) || mapped_file.length() == 0) {
+    LOG(ERROR) << "LoadMappedDATFileData: cannot map dat file "
+               << dat_file_path;
+    return LoadMappedDATFileDataResult<T>(nullptr, 0);
+  }
+
+  auto client = std::make_unique<T>(
+      typename T::MappedRegion{mapped_file.data(), mapped_file.length()});
+  if (!client->isValid())
+    return LoadMappedDATFileDataResult<T>(nullptr, 0);
+
+  return LoadMappedDATFileDataResult<T>(std::move(client),
+                                        mapped_file.length());
+}
+
 }  // namespace brave_component_updater
 
 #endif  // BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
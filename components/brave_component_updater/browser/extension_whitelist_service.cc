@@ -66,7 +66,7 @@ void ExtensionWhitelistService::OnComponentReady(
           .AppendASCII(EXTENSION_DAT_FILE);
 
   base::PostTaskAndReplyWithResult(
-      local_data_files_service()->GetTaskRunner().get(), FROM_HERE,
+      GetTaskRunner().get(), FROM_HERE,
       base::BindOnce(
           &brave_component_updater::LoadDATFileData<ExtensionWhitelistParser>,
           dat_file_path),
@@ -87,6 +87,7 @@ void ExtensionWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
 
   extension_whitelist_client_ = std::move(result.first);
   buffer_ = std::move(result.second);
+  RecordLoadTime("ExtensionWhitelist");
 }
 
 ///////////////////////////////////////////////////////////////////////////////
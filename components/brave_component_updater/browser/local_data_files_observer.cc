@@ -5,6 +5,9 @@
 
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/strcat.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 
 namespace brave_component_updater {
@@ -26,5 +29,26 @@ LocalDataFilesService* LocalDataFilesObserver::local_data_files_service() {
   return local_data_files_service_;
 }
 
+scoped_refptr<base::SequencedTaskRunner>
+LocalDataFilesObserver::GetTaskRunner() {
+  if (!task_runner_) {
+    task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+  return task_runner_;
+}
+
+void LocalDataFilesObserver::RecordLoadTime(const char* name) {
+  // Loads that weren't started by the component, e.g. in dev mode, aren't
+  // timed.
+  if (load_start_time_.is_null())
+    return;
+  last_load_time_ = base::TimeTicks::Now() - load_start_time_;
+  load_start_time_ = base::TimeTicks();
+  base::UmaHistogramTimes(
+      base::StrCat({"Brave.LocalDataFiles.LoadTime.", name}), last_load_time_);
+}
+
 }  // namespace brave_component_updater
 
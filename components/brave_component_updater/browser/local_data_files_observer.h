@@ -9,7 +9,10 @@
 #include <string>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/scoped_observation.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 
 namespace brave_component_updater {
@@ -28,10 +31,29 @@ class LocalDataFilesObserver {
   virtual void OnLocalDataFilesServiceDestroyed();
   LocalDataFilesService* local_data_files_service();
 
+  // A sequence of this observer's own for reading and parsing its files, so
+  // that observers load in parallel rather than queued behind each other.
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
+
+  // How long the last load took, from the component being ready to
+  // RecordLoadTime(). Zero until then.
+  base::TimeDelta last_load_time() const { return last_load_time_; }
+
  protected:
+  // Called by subclasses once the files from the last OnComponentReady() are
+  // loaded. Records Brave.LocalDataFiles.LoadTime.<name>.
+  void RecordLoadTime(const char* name);
+
   LocalDataFilesService* local_data_files_service_;  // NOT OWNED
   base::ScopedObservation<LocalDataFilesService, LocalDataFilesObserver>
       local_data_files_observer_{this};
+
+ private:
+  friend class LocalDataFilesService;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  base::TimeTicks load_start_time_;
+  base::TimeDelta last_load_time_;
 };
 
 }  // namespace brave_component_updater
@@ -40,8 +40,11 @@ void LocalDataFilesService::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir,
     const std::string& manifest) {
-  for (auto& observer : observers_)
+  // Each observer loads on its own sequence, so this only starts the loads.
+  for (auto& observer : observers_) {
+    observer.load_start_time_ = base::TimeTicks::Now();
     observer.OnComponentReady(component_id, install_dir, manifest);
+  }
 }
 
 void LocalDataFilesService::AddObserver(LocalDataFilesObserver* observer) {
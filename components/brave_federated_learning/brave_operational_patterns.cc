@@ -3,6 +3,7 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -10,6 +11,7 @@
 #include "brave/components/brave_federated_learning/brave_operational_patterns.h"
 
 #include "base/json/json_writer.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
@@ -17,6 +19,7 @@
 #include "brave/components/brave_stats/browser/brave_stats_updater_util.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -32,6 +35,10 @@ constexpr char kLastCheckedSlotPrefName[] = "brave.federated.last_checked_slot";
 constexpr char kCollectionIdPrefName[] = "brave.federated.collection_id";
 constexpr char kCollectionIdExpirationPrefName[] =
     "brave.federated.collection_id_expiration";
+constexpr char kPendingSlotsPrefName[] = "brave.federated.pending_slots";
+
+// A day of the default 30 minute slots. Older slots are dropped.
+constexpr size_t kMaxPendingSlots = 48;
 
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("brave_operational_patterns", R"(
@@ -71,37 +78,35 @@ void BraveOperationalPatterns::RegisterLocalStatePrefs(
   registry->RegisterIntegerPref(kLastCheckedSlotPrefName, -1);
   registry->RegisterStringPref(kCollectionIdPrefName, {});
   registry->RegisterTimePref(kCollectionIdExpirationPrefName, base::Time());
+  registry->RegisterListPref(kPendingSlotsPrefName);
 }
 
 void BraveOperationalPatterns::Start() {
   DCHECK(!simulate_local_training_step_timer_);
-  DCHECK(!collection_slot_periodic_timer_);
+  DCHECK(!collection_slot_periodic_task_);
 
   LoadPrefs();
   MaybeResetCollectionId();
 
-  simulate_local_training_step_timer_ =
-      std::make_unique<base::RetainingOneShotTimer>();
-  simulate_local_training_step_timer_->Start(
-      FROM_HERE,
-      base::TimeDelta::FromSeconds(
-          operational_patterns::features::
-              GetSimulateLocalTrainingStepDurationValue() *
-          60),
-      this, &BraveOperationalPatterns::OnSimulateLocalTrainingStepTimerFired);
+  simulate_local_training_step_timer_ = std::make_unique<base::OneShotTimer>();
 
-  collection_slot_periodic_timer_ = std::make_unique<base::RepeatingTimer>();
-  collection_slot_periodic_timer_->Start(
-      FROM_HERE,
-      base::TimeDelta::FromSeconds(
-          operational_patterns::features::GetCollectionSlotSizeValue() * 60 /
-          2),
-      this, &BraveOperationalPatterns::OnCollectionSlotStartTimerFired);
+  collection_slot_periodic_task_ =
+      PeriodicTaskScheduler::GetInstance()->Register(
+          "BraveOperationalPatterns",
+          base::TimeDelta::FromSeconds(
+              operational_patterns::features::GetCollectionSlotSizeValue() *
+              60 / 2),
+          base::BindRepeating(
+              &BraveOperationalPatterns::OnCollectionSlotStartTimerFired,
+              base::Unretained(this)));
+
+  RecordCurrentCollectionSlot();
+  MaybeStartSimulateLocalTrainingStepTimer();
 }
 
 void BraveOperationalPatterns::Stop() {
   simulate_local_training_step_timer_.reset();
-  collection_slot_periodic_timer_.reset();
+  collection_slot_periodic_task_.reset();
 }
 
 void BraveOperationalPatterns::LoadPrefs() {
@@ -109,6 +114,13 @@ void BraveOperationalPatterns::LoadPrefs() {
   collection_id_ = local_state_->GetString(kCollectionIdPrefName);
   collection_id_expiration_time_ =
       local_state_->GetTime(kCollectionIdExpirationPrefName);
+  pending_slots_.clear();
+  const base::ListValue* pending_slots =
+      local_state_->GetList(kPendingSlotsPrefName);
+  for (const auto& slot : pending_slots->GetList()) {
+    if (slot.is_int())
+      pending_slots_.push_back(slot.GetInt());
+  }
 }
 
 void BraveOperationalPatterns::SavePrefs() {
@@ -116,21 +128,66 @@ void BraveOperationalPatterns::SavePrefs() {
   local_state_->SetString(kCollectionIdPrefName, collection_id_);
   local_state_->SetTime(kCollectionIdExpirationPrefName,
                         collection_id_expiration_time_);
+  ListPrefUpdate update(local_state_, kPendingSlotsPrefName);
+  update->ClearList();
+  for (int slot : pending_slots_)
+    update->Append(slot);
 }
 
 void BraveOperationalPatterns::OnCollectionSlotStartTimerFired() {
-  simulate_local_training_step_timer_->Reset();
+  RecordCurrentCollectionSlot();
+  MaybeStartSimulateLocalTrainingStepTimer();
 }
 
 void BraveOperationalPatterns::OnSimulateLocalTrainingStepTimerFired() {
+  if (ShouldDeferUpload())
+    return;
   SendCollectionSlot();
 }
 
-void BraveOperationalPatterns::SendCollectionSlot() {
-  current_collected_slot_ = GetCurrentCollectionSlot();
-  if (current_collected_slot_ == last_checked_slot_) {
+void BraveOperationalPatterns::RecordCurrentCollectionSlot() {
+  const int slot = GetCurrentCollectionSlot();
+  if (slot == last_checked_slot_)
     return;
+
+  last_checked_slot_ = slot;
+  pending_slots_.push_back(slot);
+  if (pending_slots_.size() > kMaxPendingSlots &&
+      uploading_slot_count_ < pending_slots_.size() - kMaxPendingSlots) {
+    pending_slots_.erase(pending_slots_.begin() + uploading_slot_count_);
   }
+  SavePrefs();
+}
+
+void BraveOperationalPatterns::MaybeStartSimulateLocalTrainingStepTimer() {
+  // The timer is only armed when there is something to send, so idle ticks
+  // don't cause a second wakeup.
+  if (!simulate_local_training_step_timer_ || pending_slots_.empty() ||
+      url_loader_ || simulate_local_training_step_timer_->IsRunning() ||
+      ShouldDeferUpload()) {
+    return;
+  }
+  simulate_local_training_step_timer_->Start(
+      FROM_HERE,
+      base::TimeDelta::FromSeconds(
+          operational_patterns::features::
+              GetSimulateLocalTrainingStepDurationValue() *
+          60),
+      this, &BraveOperationalPatterns::OnSimulateLocalTrainingStepTimerFired);
+}
+
+bool BraveOperationalPatterns::ShouldDeferUpload() const {
+  // Pending slots are kept, so on battery they can wait for AC power or a
+  // full day of slots.
+  return base::PowerMonitor::IsInitialized() &&
+         base::PowerMonitor::IsOnBatteryPower() &&
+         pending_slots_.size() < kMaxPendingSlots;
+}
+
+void BraveOperationalPatterns::SendCollectionSlot() {
+  DCHECK(!url_loader_);
+  if (pending_slots_.empty())
+    return;
 
   MaybeResetCollectionId();
 
@@ -143,7 +200,15 @@ void BraveOperationalPatterns::SendCollectionSlot() {
 
   url_loader_ = network::SimpleURLLoader::Create(
       std::move(resource_request), GetNetworkTrafficAnnotationTag());
-  url_loader_->AttachStringForUpload(BuildPayload(), "application/json");
+  uploading_slot_count_ = std::min(
+      pending_slots_.size(),
+      static_cast<size_t>(std::max(
+          1, operational_patterns::features::GetMaxSlotsPerUpload())));
+  url_loader_->AttachStringForUpload(
+      BuildPayload(std::vector<int>(
+          pending_slots_.begin(),
+          pending_slots_.begin() + uploading_slot_count_)),
+      "application/json");
 
   url_loader_->DownloadHeadersOnly(
       url_loader_factory_.get(),
@@ -153,21 +218,34 @@ void BraveOperationalPatterns::SendCollectionSlot() {
 
 void BraveOperationalPatterns::OnUploadComplete(
     scoped_refptr<net::HttpResponseHeaders> headers) {
+  url_loader_.reset();
   int response_code = -1;
   if (headers)
     response_code = headers->response_code();
   if (response_code == 200) {
-    last_checked_slot_ = current_collected_slot_;
+    pending_slots_.erase(pending_slots_.begin(),
+                         pending_slots_.begin() + uploading_slot_count_);
     SavePrefs();
   }
+  uploading_slot_count_ = 0;
+  MaybeStartSimulateLocalTrainingStepTimer();
 }
 
-std::string BraveOperationalPatterns::BuildPayload() const {
+std::string BraveOperationalPatterns::BuildPayload(
+    const std::vector<int>& slots) const {
+  DCHECK(!slots.empty());
   base::Value root(base::Value::Type::DICTIONARY);
 
   root.SetKey("collection_id", base::Value(collection_id_));
   root.SetKey("platform", base::Value(brave_stats::GetPlatformIdentifier()));
-  root.SetKey("collection_slot", base::Value(current_collected_slot_));
+  if (slots.size() == 1) {
+    root.SetKey("collection_slot", base::Value(slots.front()));
+  } else {
+    base::Value list(base::Value::Type::LIST);
+    for (int slot : slots)
+      list.Append(slot);
+    root.SetKey("collection_slots", std::move(list));
+  }
   root.SetKey("wiki-link", base::Value("https://github.com/brave/brave-browser/"
                                        "wiki/Operational-Patterns"));
 
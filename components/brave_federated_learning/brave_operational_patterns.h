@@ -7,13 +7,16 @@
 // |BraveOperationalPatterns| is a class for handling the collection of
 // operational patterns, which are are anonymous, minimal representations of how
 // users engage with the browser over a collection period. A collection period
-// is divided into collection slots (i.e. 30m intervals). Two timers are
-// instatiated at startup:
-// 1. |collection_slot_periodic_timer_| fires every |collection_slot_size_|/2
-// minutes (at most twice per collection slot) and starts the next timer.
-// 2. |simulate_local_training_step_timer_| fires a set number of minutes after
-// the |collection_slot_periodic_timer_|. When this timer fires, a ping is sent
-// to the server.
+// is divided into collection slots (i.e. 30m intervals). Two timers are used:
+// 1. |collection_slot_periodic_task_| runs every |collection_slot_size_|/2
+// minutes (at most twice per collection slot) on the shared
+// PeriodicTaskScheduler and records the current slot as pending, if it hasn't
+// been recorded yet.
+// 2. |simulate_local_training_step_timer_| is started only while slots are
+// pending and fires a set number of minutes later. When it fires, up to
+// GetMaxSlotsPerUpload() pending slots are sent to the server in one ping.
+// Uploads are held back while the device runs on battery, until enough slots
+// are pending.
 //
 // For more information see
 // https://github.com/brave/brave-browser/wiki/Operational-Patterns
@@ -25,9 +28,11 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/time/time.h"
 #include "base/timer/timer.h"
+#include "brave/components/periodic_task_scheduler/periodic_task_scheduler.h"
 
 class PrefRegistrySimple;
 class PrefService;
@@ -64,26 +69,32 @@ class BraveOperationalPatterns final {
   void OnSimulateLocalTrainingStepTimerFired();
   void OnUploadComplete(scoped_refptr<net::HttpResponseHeaders> headers);
 
+  void RecordCurrentCollectionSlot();
+  void MaybeStartSimulateLocalTrainingStepTimer();
+  bool ShouldDeferUpload() const;
   void SendCollectionSlot();
 
   void SavePrefs();
   void LoadPrefs();
 
-  std::string BuildPayload() const;
+  std::string BuildPayload(const std::vector<int>& slots) const;
   int GetCurrentCollectionSlot() const;
 
   void MaybeResetCollectionId();
 
   PrefService* local_state_;
-  std::unique_ptr<base::RepeatingTimer> collection_slot_periodic_timer_;
-  std::unique_ptr<base::RetainingOneShotTimer>
-      simulate_local_training_step_timer_;
+  std::unique_ptr<PeriodicTaskScheduler::Registration>
+      collection_slot_periodic_task_;
+  std::unique_ptr<base::OneShotTimer> simulate_local_training_step_timer_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
 
   base::Time collection_id_expiration_time_;
-  int current_collected_slot_ = 0;
   int last_checked_slot_ = 0;
+  // Recorded slots not yet accepted by the server, oldest first.
+  std::vector<int> pending_slots_;
+  // Number of |pending_slots_|, from the front, in the upload in flight.
+  size_t uploading_slot_count_ = 0;
   std::string collection_id_;
 };
 
@@ -25,6 +25,9 @@ const char kFieldTrialParameterCollectionIDLifetimeInDays[] =
     "collection_id_lifetime_in_days";
 const int kDefaultCollectionIDLifetimeInDays = 1;
 
+const char kFieldTrialParameterMaxSlotsPerUpload[] = "max_slots_per_upload";
+const int kDefaultMaxSlotsPerUpload = 1;
+
 }  // namespace
 
 const base::Feature kUserOperationalPatterns{kFeatureName,
@@ -53,5 +56,11 @@ int GetCollectionIdLifetime() {
       kDefaultCollectionIDLifetimeInDays);
 }
 
+int GetMaxSlotsPerUpload() {
+  return GetFieldTrialParamByFeatureAsInt(kUserOperationalPatterns,
+                                          kFieldTrialParameterMaxSlotsPerUpload,
+                                          kDefaultMaxSlotsPerUpload);
+}
+
 }  // namespace features
 }  // namespace operational_patterns
@@ -18,6 +18,7 @@ bool IsOperationalPatternsEnabled();
 int GetCollectionSlotSizeValue();
 int GetSimulateLocalTrainingStepDurationValue();
 int GetCollectionIdLifetime();
+int GetMaxSlotsPerUpload();
 
 }  // namespace features
 }  // namespace operational_patterns
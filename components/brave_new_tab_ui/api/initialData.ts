@@ -3,11 +3,10 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this file,
 // you can obtain one at http://mozilla.org/MPL/2.0/.
 
-import * as preferencesAPI from './preferences'
+import { sendWithPromise } from 'chrome://resources/js/cr.m'
 import * as statsAPI from './stats'
 import * as privateTabDataAPI from './privateTabData'
 import * as torTabDataAPI from './torTabData'
-import * as brandedWallpaper from './brandedWallpaper'
 
 export type InitialData = {
   preferences: NewTab.Preferences
@@ -22,6 +21,19 @@ export type InitialData = {
   ftxSupported: boolean
 }
 
+// Everything the browser knows about the page, sent in one message.
+type BrowserInitialState = {
+  preferences: NewTab.Preferences
+  stats: statsAPI.Stats
+  privateTabData: privateTabDataAPI.PrivateTabData
+  torTabData: torTabDataAPI.TorTabData
+  brandedWallpaperData?: null | NewTab.BrandedWallpaper
+}
+
+function getBrowserInitialState (): Promise<BrowserInitialState> {
+  return sendWithPromise('getNewTabPageInitialState')
+}
+
 export type PreInitialRewardsData = {
   enabledAds: boolean
   adsSupported: boolean
@@ -34,29 +46,19 @@ export type InitialRewardsData = {
   parameters: NewTab.RewardsParameters
 }
 
-const isIncognito: boolean = chrome.extension.inIncognitoContext
-
 // Gets all data required for the first render of the page
 export async function getInitialData (): Promise<InitialData> {
   try {
     console.timeStamp('Getting initial data...')
     const [
-      preferences,
-      stats,
-      privateTabData,
-      torTabData,
-      brandedWallpaperData,
+      browserState,
       braveTalkSupported,
       geminiSupported,
       cryptoDotComSupported,
       ftxSupported,
       binanceSupported
     ] = await Promise.all([
-      preferencesAPI.getPreferences(),
-      statsAPI.getStats(),
-      privateTabDataAPI.getPrivateTabData(),
-      torTabDataAPI.getTorTabData(),
-      !isIncognito ? brandedWallpaper.getBrandedWallpaper() : Promise.resolve(undefined),
+      getBrowserInitialState(),
       new Promise((resolve) => {
         if (!('braveTalk' in chrome)) {
           resolve(false)
@@ -90,11 +92,11 @@ export async function getInitialData (): Promise<InitialData> {
     ])
     console.timeStamp('Got all initial data.')
     return {
-      preferences,
-      stats,
-      privateTabData,
-      torTabData,
-      brandedWallpaperData,
+      preferences: browserState.preferences,
+      stats: browserState.stats,
+      privateTabData: browserState.privateTabData,
+      torTabData: browserState.torTabData,
+      brandedWallpaperData: browserState.brandedWallpaperData || undefined,
       braveTalkSupported,
       geminiSupported,
       cryptoDotComSupported,
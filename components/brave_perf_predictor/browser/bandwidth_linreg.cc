@@ -11,6 +11,8 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_util.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -37,6 +39,31 @@ bool StandardiseFeatsNoOutliers(
 
 }  // namespace
 
+absl::optional<size_t> GetThirdPartyFeatureIndex(base::StringPiece entity) {
+  static const base::NoDestructor<base::flat_map<std::string, size_t>>
+      indices([] {
+        constexpr base::StringPiece kPrefix = "thirdParties.";
+        constexpr base::StringPiece kSuffix = ".blocked";
+        std::vector<std::pair<std::string, size_t>> entries;
+        for (size_t i = kPageFeatureCount; i < feature_count; i++) {
+          const base::StringPiece name = feature_sequence[i];
+          if (!base::StartsWith(name, kPrefix) ||
+              !base::EndsWith(name, kSuffix))
+            continue;
+          entries.emplace_back(
+              name.substr(kPrefix.size(),
+                          name.size() - kPrefix.size() - kSuffix.size()),
+              i);
+        }
+        return base::flat_map<std::string, size_t>(std::move(entries));
+      }());
+
+  const auto it = indices->find(entity);
+  if (it == indices->end())
+    return absl::nullopt;
+  return it->second;
+}
+
 double LinregPredictVector(const std::array<double, feature_count>& features) {
   // Standardise numeric features
   std::array<double, standardise_feat_count> numeric_features;
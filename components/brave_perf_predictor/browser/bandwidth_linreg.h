@@ -6,11 +6,14 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
 
+#include <array>
 #include <string>
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_perf_predictor {
 
@@ -18,6 +21,44 @@ constexpr double kOutlierThreshold = 6;
 // if above 20MB _and_ more than 6x of the transfer size, probably an outlier
 constexpr double kSavingsAbsoluteOutlier = 20 << 20;
 
+// Positions of the page-level features in |feature_sequence|. They come first
+// and in this order in the generated parameters, followed by one "blocked"
+// feature per third party.
+enum Feature : size_t {
+  kAdblockRequests = 0,
+  kFirstMeaningfulPaint,
+  kObservedDomContentLoaded,
+  kObservedFirstVisualChange,
+  kObservedLoad,
+  kDocumentRequestCount,
+  kDocumentSize,
+  kFontRequestCount,
+  kFontSize,
+  kImageRequestCount,
+  kImageSize,
+  kMediaRequestCount,
+  kMediaSize,
+  kOtherRequestCount,
+  kOtherSize,
+  kScriptRequestCount,
+  kScriptSize,
+  kStylesheetRequestCount,
+  kStylesheetSize,
+  kThirdPartyRequestCount,
+  kThirdPartySize,
+  kTotalRequestCount,
+  kTotalSize,
+  kPageFeatureCount,
+};
+static_assert(kPageFeatureCount == standardise_feat_count,
+              "Page features must match the standardised features");
+
+using FeatureVector = std::array<double, feature_count>;
+
+// Returns the position of the "thirdParties.<entity>.blocked" feature, or
+// nullopt if the model doesn't use |entity|.
+absl::optional<size_t> GetThirdPartyFeatureIndex(base::StringPiece entity);
+
 // Computes prediction based on the provided feature vector.
 // It is the client's responsibility to provide features in
 // the exact order expected by the predictor.
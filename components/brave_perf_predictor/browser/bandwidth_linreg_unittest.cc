@@ -10,6 +10,26 @@
 
 namespace brave_perf_predictor {
 
+TEST(BraveSavingsPredictorTest, FeatureIndicesMatchSequence) {
+  // The enum has to follow the generated parameters.
+  EXPECT_EQ(feature_sequence[kAdblockRequests], "adblockRequests");
+  EXPECT_EQ(feature_sequence[kFirstMeaningfulPaint],
+            "metrics.firstMeaningfulPaint");
+  EXPECT_EQ(feature_sequence[kObservedLoad], "metrics.observedLoad");
+  EXPECT_EQ(feature_sequence[kDocumentRequestCount],
+            "resources.document.requestCount");
+  EXPECT_EQ(feature_sequence[kMediaSize], "resources.media.size");
+  EXPECT_EQ(feature_sequence[kStylesheetSize], "resources.stylesheet.size");
+  EXPECT_EQ(feature_sequence[kThirdPartyRequestCount],
+            "resources.third-party.requestCount");
+  EXPECT_EQ(feature_sequence[kTotalSize], "resources.total.size");
+
+  const auto facebook = GetThirdPartyFeatureIndex("Facebook");
+  ASSERT_TRUE(facebook);
+  EXPECT_EQ(feature_sequence[*facebook], "thirdParties.Facebook.blocked");
+  EXPECT_FALSE(GetThirdPartyFeatureIndex("Unknown Entity"));
+}
+
 TEST(BraveSavingsPredictorTest, FeatureArrayGetsPrediction) {
   const std::array<double, feature_count> features{};
   double result = LinregPredictVector(features);
@@ -8,8 +8,8 @@
 
 #include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -56,6 +56,12 @@ class BandwidthSavingsPredictor {
   double PredictSavingsBytes() const;
   void Reset();
 
+  // Measured values for the current page, accumulated alongside the features.
+  double transfer_total_size() const { return transfer_total_size_; }
+  double total_requests() const { return features_[kTotalRequestCount]; }
+  double blocked_requests() const { return features_[kAdblockRequests]; }
+  double load_time_ms() const { return features_[kObservedLoad]; }
+
  private:
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseBlocked);
   FRIEND_TEST_ALL_PREFIXES(BandwidthSavingsPredictorTest, FeaturiseTiming);
@@ -64,7 +70,11 @@ class BandwidthSavingsPredictor {
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Indexed by |Feature| and GetThirdPartyFeatureIndex(), so that updates on
+  // every resource are plain array increments.
+  FeatureVector features_{};
+  // Only used to sanity check the prediction, not a model feature.
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
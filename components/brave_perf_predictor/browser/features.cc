@@ -0,0 +1,19 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_perf_predictor/browser/features.h"
+
+#include "base/feature_list.h"
+
+namespace brave_perf_predictor {
+namespace features {
+
+// Records the measured cost of every page next to the predicted savings, so
+// the two can be compared.
+const base::Feature kBravePerfPredictorMeasuredSavings{
+    "BravePerfPredictorMeasuredSavings", base::FEATURE_DISABLED_BY_DEFAULT};
+
+}  // namespace features
+}  // namespace brave_perf_predictor
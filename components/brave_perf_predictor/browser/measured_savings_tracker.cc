@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_perf_predictor/browser/measured_savings_tracker.h"
+
+#include <memory>
+
+#include "base/logging.h"
+#include "brave/components/brave_perf_predictor/common/pref_names.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+
+namespace brave_perf_predictor {
+
+MeasuredSavingsTracker::MeasuredSavingsTracker(PrefService* user_prefs)
+    : pages_(std::make_unique<WeeklyStorage>(user_prefs,
+                                             prefs::kMeasuredPages)),
+      loaded_bytes_(std::make_unique<WeeklyStorage>(
+          user_prefs,
+          prefs::kMeasuredLoadedBytes)),
+      load_time_ms_(std::make_unique<WeeklyStorage>(
+          user_prefs,
+          prefs::kMeasuredLoadTimeMs)),
+      allowed_requests_(std::make_unique<WeeklyStorage>(
+          user_prefs,
+          prefs::kMeasuredAllowedRequests)),
+      blocked_requests_(std::make_unique<WeeklyStorage>(
+          user_prefs,
+          prefs::kMeasuredBlockedRequests)),
+      predicted_savings_bytes_(std::make_unique<WeeklyStorage>(
+          user_prefs,
+          prefs::kMeasuredPredictedSavingsBytes)) {}
+
+MeasuredSavingsTracker::~MeasuredSavingsTracker() = default;
+
+// static
+void MeasuredSavingsTracker::RegisterProfilePrefs(
+    PrefRegistrySimple* registry) {
+  registry->RegisterListPref(prefs::kMeasuredPages);
+  registry->RegisterListPref(prefs::kMeasuredLoadedBytes);
+  registry->RegisterListPref(prefs::kMeasuredLoadTimeMs);
+  registry->RegisterListPref(prefs::kMeasuredAllowedRequests);
+  registry->RegisterListPref(prefs::kMeasuredBlockedRequests);
+  registry->RegisterListPref(prefs::kMeasuredPredictedSavingsBytes);
+}
+
+void MeasuredSavingsTracker::RecordPage(const PageLoadCost& cost) {
+  VLOG(2) << "Measured page: " << cost.loaded_bytes << " bytes in "
+          << cost.load_time_ms << "ms, " << cost.allowed_requests
+          << " requests allowed, " << cost.blocked_requests
+          << " blocked, predicted saving " << cost.predicted_savings_bytes
+          << " bytes";
+  pages_->AddDelta(1);
+  loaded_bytes_->AddDelta(cost.loaded_bytes);
+  load_time_ms_->AddDelta(cost.load_time_ms);
+  allowed_requests_->AddDelta(cost.allowed_requests);
+  blocked_requests_->AddDelta(cost.blocked_requests);
+  predicted_savings_bytes_->AddDelta(cost.predicted_savings_bytes);
+}
+
+PageLoadCost MeasuredSavingsTracker::GetWeeklyCost() const {
+  PageLoadCost cost;
+  cost.loaded_bytes = loaded_bytes_->GetWeeklySum();
+  cost.load_time_ms = load_time_ms_->GetWeeklySum();
+  cost.allowed_requests = allowed_requests_->GetWeeklySum();
+  cost.blocked_requests = blocked_requests_->GetWeeklySum();
+  cost.predicted_savings_bytes = predicted_savings_bytes_->GetWeeklySum();
+  return cost;
+}
+
+uint64_t MeasuredSavingsTracker::GetWeeklyPageCount() const {
+  return pages_->GetWeeklySum();
+}
+
+}  // namespace brave_perf_predictor
@@ -0,0 +1,57 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_MEASURED_SAVINGS_TRACKER_H_
+#define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_MEASURED_SAVINGS_TRACKER_H_
+
+#include <cstdint>
+#include <memory>
+
+class PrefRegistrySimple;
+class PrefService;
+class WeeklyStorage;
+
+namespace brave_perf_predictor {
+
+// What a single page actually cost to load, together with the savings the
+// model predicted for it.
+struct PageLoadCost {
+  uint64_t loaded_bytes = 0;
+  uint64_t load_time_ms = 0;
+  uint64_t allowed_requests = 0;
+  uint64_t blocked_requests = 0;
+  uint64_t predicted_savings_bytes = 0;
+};
+
+// Keeps weekly sums of measured page costs while
+// features::kBravePerfPredictorMeasuredSavings is enabled, so predicted
+// savings can be compared against what pages really loaded.
+class MeasuredSavingsTracker {
+ public:
+  explicit MeasuredSavingsTracker(PrefService* user_prefs);
+  ~MeasuredSavingsTracker();
+  MeasuredSavingsTracker(const MeasuredSavingsTracker&) = delete;
+  MeasuredSavingsTracker& operator=(const MeasuredSavingsTracker&) = delete;
+
+  static void RegisterProfilePrefs(PrefRegistrySimple* registry);
+
+  void RecordPage(const PageLoadCost& cost);
+
+  // Sums over the last week.
+  PageLoadCost GetWeeklyCost() const;
+  uint64_t GetWeeklyPageCount() const;
+
+ private:
+  std::unique_ptr<WeeklyStorage> pages_;
+  std::unique_ptr<WeeklyStorage> loaded_bytes_;
+  std::unique_ptr<WeeklyStorage> load_time_ms_;
+  std::unique_ptr<WeeklyStorage> allowed_requests_;
+  std::unique_ptr<WeeklyStorage> blocked_requests_;
+  std::unique_ptr<WeeklyStorage> predicted_savings_bytes_;
+};
+
+}  // namespace brave_perf_predictor
+
+#endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_MEASURED_SAVINGS_TRACKER_H_
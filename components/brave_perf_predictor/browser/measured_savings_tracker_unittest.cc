@@ -0,0 +1,40 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_perf_predictor/browser/measured_savings_tracker.h"
+
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_perf_predictor {
+
+TEST(MeasuredSavingsTrackerTest, SumsPagesOverTheWeek) {
+  TestingPrefServiceSimple prefs;
+  MeasuredSavingsTracker::RegisterProfilePrefs(prefs.registry());
+
+  MeasuredSavingsTracker tracker(&prefs);
+  EXPECT_EQ(tracker.GetWeeklyPageCount(), 0u);
+
+  PageLoadCost cost;
+  cost.loaded_bytes = 1000;
+  cost.load_time_ms = 200;
+  cost.allowed_requests = 10;
+  cost.blocked_requests = 2;
+  cost.predicted_savings_bytes = 300;
+  tracker.RecordPage(cost);
+  tracker.RecordPage(cost);
+
+  // Sums are persisted and visible to a new tracker on the same prefs.
+  MeasuredSavingsTracker reloaded(&prefs);
+  EXPECT_EQ(reloaded.GetWeeklyPageCount(), 2u);
+  const PageLoadCost weekly = reloaded.GetWeeklyCost();
+  EXPECT_EQ(weekly.loaded_bytes, 2000u);
+  EXPECT_EQ(weekly.load_time_ms, 400u);
+  EXPECT_EQ(weekly.allowed_requests, 20u);
+  EXPECT_EQ(weekly.blocked_requests, 4u);
+  EXPECT_EQ(weekly.predicted_savings_bytes, 600u);
+}
+
+}  // namespace brave_perf_predictor
@@ -5,17 +5,26 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
-#include <tuple>
+#include <inttypes.h>
+
+#include <utility>
 
 #include "base/bind.h"
 #include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "components/grit/brave_components_resources.h"
@@ -28,17 +37,18 @@ namespace brave_perf_predictor {
 
 namespace {
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
-  base::flat_map<std::string, std::string> entity_by_domain;
-  base::flat_map<std::string, std::string> entity_by_root_domain;
+using EntityMappings = NamedThirdPartyRegistry::EntityMappings;
+
+scoped_refptr<const EntityMappings> ParseMappings(
+    const base::StringPiece entities,
+    bool discard_irrelevant) {
+  auto mappings = base::MakeRefCounted<EntityMappings>();
 
   // Parse the JSON
   absl::optional<base::Value> document = base::JSONReader::Read(entities);
   if (!document || !document->is_list()) {
     LOG(ERROR) << "Cannot parse the third-party entities list";
-    return {};
+    return mappings;
   }
 
   // Collect the mappings
@@ -54,6 +64,9 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
     if (!entity_domains)
       continue;
 
+    const size_t entity_index = mappings->entities.size();
+    mappings->entities.push_back(*entity_name);
+
     for (auto& entity_domain_it : entity_domains->GetList()) {
       if (!entity_domain_it.is_string()) {
         continue;
@@ -61,7 +74,7 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
       const base::StringPiece entity_domain(entity_domain_it.GetString());
 
       const auto inserted =
-          entity_by_domain.emplace(entity_domain, *entity_name);
+          mappings->entity_by_domain.emplace(entity_domain, entity_index);
       if (!inserted.second) {
         VLOG(2) << "Malformed data: duplicate domain " << entity_domain;
       }
@@ -69,25 +82,25 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
           entity_domain,
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
+      auto& entity_by_root_domain = mappings->entity_by_root_domain;
       auto root_entity_entry = entity_by_root_domain.find(root_domain);
       if (root_entity_entry != entity_by_root_domain.end() &&
-          root_entity_entry->second != *entity_name) {
+          mappings->entities[root_entity_entry->second] != *entity_name) {
         // If there is a clash at root domain level, neither is correct
         entity_by_root_domain.erase(root_entity_entry);
       } else {
-        entity_by_root_domain.emplace(root_domain, *entity_name);
+        entity_by_root_domain.emplace(root_domain, entity_index);
       }
     }
   }
 
-  entity_by_domain.shrink_to_fit();
-  entity_by_root_domain.shrink_to_fit();
-  return std::make_tuple(entity_by_domain, entity_by_root_domain);
+  mappings->entities.shrink_to_fit();
+  mappings->entity_by_domain.shrink_to_fit();
+  mappings->entity_by_root_domain.shrink_to_fit();
+  return mappings;
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
+scoped_refptr<const EntityMappings> ParseFromResource(int resource_id) {
   // TODO(AndriusA): insert trace event here
   SCOPED_UMA_HISTOGRAM_TIMER(
       "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
@@ -98,33 +111,60 @@ ParseFromResource(int resource_id) {
   return ParseMappings(data_resource, true);
 }
 
+// The default mappings never change, so once parsed they are kept for the
+// lifetime of the process and handed to every profile.
+scoped_refptr<const EntityMappings>& GetDefaultMappings() {
+  static base::NoDestructor<scoped_refptr<const EntityMappings>> mappings;
+  return *mappings;
+}
+
 }  // namespace
 
+NamedThirdPartyRegistry::EntityMappings::EntityMappings() = default;
+
+NamedThirdPartyRegistry::EntityMappings::~EntityMappings() = default;
+
+size_t NamedThirdPartyRegistry::EntityMappings::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(entities) +
+         base::trace_event::EstimateMemoryUsage(entity_by_domain) +
+         base::trace_event::EstimateMemoryUsage(entity_by_root_domain);
+}
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  mappings_.reset();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
-      ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  auto mappings = ParseMappings(entities, discard_irrelevant);
+  if (mappings->entity_by_domain.empty() ||
+      mappings->entity_by_root_domain.empty())
     return false;
 
+  mappings_ = std::move(mappings);
   initialized_ = true;
   return true;
 }
 
 void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
+    scoped_refptr<const EntityMappings> mappings) {
+  mappings_ = std::move(mappings);
+  VLOG(2) << "Loaded " << mappings_->entity_by_domain.size()
+          << " mappings by domain and "
+          << mappings_->entity_by_root_domain.size() << " by root domain for "
+          << mappings_->entities.size() << " entities";
   initialized_ = true;
 }
 
+void NamedThirdPartyRegistry::OnDefaultMappingsLoaded(
+    scoped_refptr<const EntityMappings> mappings) {
+  // Another profile may have finished loading first; keep a single copy.
+  auto& default_mappings = GetDefaultMappings();
+  if (!default_mappings)
+    default_mappings = std::move(mappings);
+  UpdateMappings(default_mappings);
+}
+
 absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     const base::StringPiece request_url) const {
   if (!IsInitialized()) {
@@ -137,16 +177,18 @@ absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     return absl::nullopt;
 
   if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+    const auto& entity_by_domain = mappings_->entity_by_domain;
+    auto domain_entry = entity_by_domain.find(url.host());
+    if (domain_entry != entity_by_domain.end())
+      return mappings_->entities[domain_entry->second];
 
     auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
         url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+    const auto& entity_by_root_domain = mappings_->entity_by_root_domain;
+    auto root_domain_entry = entity_by_root_domain.find(root_domain);
+    if (root_domain_entry != entity_by_root_domain.end())
+      return mappings_->entities[root_domain_entry->second];
   }
 
   return absl::nullopt;
@@ -154,13 +196,46 @@ absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
 
 NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 
-NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
+NamedThirdPartyRegistry::~NamedThirdPartyRegistry() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
+}
+
+bool NamedThirdPartyRegistry::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  if (!mappings_)
+    return true;
+  // Profiles share the default mappings, which must only be counted once.
+  const std::string dump_name = base::StringPrintf(
+      "brave/perf_predictor/third_party_mappings/0x%" PRIXPTR,
+      reinterpret_cast<uintptr_t>(mappings_.get()));
+  if (pmd->GetAllocatorDump(dump_name))
+    return true;
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump(dump_name);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  mappings_->EstimateMemoryUsage());
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  mappings_->entities.size());
+  return true;
+}
 
 void NamedThirdPartyRegistry::InitializeDefault() {
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "NamedThirdPartyRegistry", base::ThreadTaskRunnerHandle::Get());
+
+  if (GetDefaultMappings()) {
+    UpdateMappings(GetDefaultMappings());
+    return;
+  }
+
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
       base::BindOnce(&ParseFromResource, IDR_THIRD_PARTY_ENTITIES),
-      base::BindOnce(&NamedThirdPartyRegistry::UpdateMappings,
+      base::BindOnce(&NamedThirdPartyRegistry::OnDefaultMappingsLoaded,
                      weak_factory_.GetWeakPtr()));
 }
 
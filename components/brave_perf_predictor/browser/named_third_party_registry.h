@@ -7,20 +7,41 @@
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
 #include <string>
-#include <tuple>
+#include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/strings/string_piece.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "components/keyed_service/core/keyed_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_perf_predictor {
 
 // Retrieves publicly known Third Party (organisation) for a given URL, using
 // data from the Third Party Web repository
 // (https://github.com/patrickhulce/third-party-web).
-class NamedThirdPartyRegistry : public KeyedService {
+class NamedThirdPartyRegistry : public KeyedService,
+                                public base::trace_event::MemoryDumpProvider {
  public:
+  // Immutable domain to entity mappings. Each entity name is stored once and
+  // the domain maps refer to it by index. The default mappings are loaded
+  // once per process and shared by every profile's registry.
+  struct EntityMappings : public base::RefCountedThreadSafe<EntityMappings> {
+    EntityMappings();
+
+    size_t EstimateMemoryUsage() const;
+
+    std::vector<std::string> entities;
+    base::flat_map<std::string, size_t> entity_by_domain;
+    base::flat_map<std::string, size_t> entity_by_root_domain;
+
+   private:
+    friend class base::RefCountedThreadSafe<EntityMappings>;
+    ~EntityMappings();
+  };
+
   NamedThirdPartyRegistry();
   ~NamedThirdPartyRegistry() override;
 
@@ -31,21 +52,24 @@ class NamedThirdPartyRegistry : public KeyedService {
   // entities not relevant to the bandwith prediction model (i.e. those not
   // seen in training the model).
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
-  // Default initialization - asynchronously load from bundled resource
+  // Default initialization - asynchronously load from bundled resource, or
+  // reuse the mappings another profile has already loaded.
   void InitializeDefault();
   absl::optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
 
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
  private:
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  void UpdateMappings(scoped_refptr<const EntityMappings> mappings);
+  void OnDefaultMappingsLoaded(scoped_refptr<const EntityMappings> mappings);
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
+  scoped_refptr<const EntityMappings> mappings_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
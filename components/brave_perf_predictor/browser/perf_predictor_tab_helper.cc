@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
 
+#include "base/feature_list.h"
+#include "brave/components/brave_perf_predictor/browser/features.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry_factory.h"
 #include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -31,8 +33,12 @@ PerfPredictorTabHelper::PerfPredictorTabHelper(
   if (web_contents->GetBrowserContext()->IsOffTheRecord())
     return;
 
-  bandwidth_tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(
-      user_prefs::UserPrefs::Get(web_contents->GetBrowserContext()));
+  PrefService* prefs =
+      user_prefs::UserPrefs::Get(web_contents->GetBrowserContext());
+  bandwidth_tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(prefs);
+  if (base::FeatureList::IsEnabled(
+          features::kBravePerfPredictorMeasuredSavings))
+    measured_tracker_ = std::make_unique<MeasuredSavingsTracker>(prefs);
 }
 
 PerfPredictorTabHelper::~PerfPredictorTabHelper() = default;
@@ -71,6 +77,7 @@ void PerfPredictorTabHelper::RecordSavings() {
   if (web_contents()) {
     const uint64_t savings =
         static_cast<uint64_t>(bandwidth_predictor_->PredictSavingsBytes());
+    RecordMeasuredCost(savings);
     bandwidth_predictor_->Reset();
     VLOG(3) << "Saving computed bw saving = " << savings;
     if (savings > 0) {
@@ -95,6 +102,24 @@ void PerfPredictorTabHelper::RecordSavings() {
   }
 }
 
+void PerfPredictorTabHelper::RecordMeasuredCost(uint64_t predicted_savings) {
+  // Pages without a web main frame never accumulate any transfer size.
+  if (!measured_tracker_ || bandwidth_predictor_->transfer_total_size() <= 0)
+    return;
+
+  PageLoadCost cost;
+  cost.loaded_bytes =
+      static_cast<uint64_t>(bandwidth_predictor_->transfer_total_size());
+  cost.load_time_ms =
+      static_cast<uint64_t>(bandwidth_predictor_->load_time_ms());
+  cost.allowed_requests =
+      static_cast<uint64_t>(bandwidth_predictor_->total_requests());
+  cost.blocked_requests =
+      static_cast<uint64_t>(bandwidth_predictor_->blocked_requests());
+  cost.predicted_savings_bytes = predicted_savings;
+  measured_tracker_->RecordPage(cost);
+}
+
 void PerfPredictorTabHelper::OnBlockedSubresource(
     const std::string& subresource) {
   bandwidth_predictor_->OnSubresourceBlocked(subresource);
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_savings_predictor.h"
+#include "brave/components/brave_perf_predictor/browser/measured_savings_tracker.h"
 #include "brave/components/brave_perf_predictor/browser/p3a_bandwidth_savings_tracker.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
@@ -61,6 +62,7 @@ class PerfPredictorTabHelper
  private:
   friend class content::WebContentsUserData<PerfPredictorTabHelper>;
   void RecordSavings();
+  void RecordMeasuredCost(uint64_t predicted_savings);
   void OnBlockedSubresource(const std::string& subresource);
 
   // content::WebContentsObserver overrides.
@@ -90,6 +92,8 @@ class PerfPredictorTabHelper
   int64_t navigation_id_ = -1;
   std::unique_ptr<BandwidthSavingsPredictor> bandwidth_predictor_;
   std::unique_ptr<P3ABandwidthSavingsTracker> bandwidth_tracker_;
+  // Only set while features::kBravePerfPredictorMeasuredSavings is enabled.
+  std::unique_ptr<MeasuredSavingsTracker> measured_tracker_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
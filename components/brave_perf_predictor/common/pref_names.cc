@@ -12,6 +12,15 @@ namespace prefs {
 const char kBandwidthSavedBytes[] = "brave.stats.bandwidth_saved_bytes";
 const char kBandwidthSavedDailyBytes[] =
     "brave.stats.daily_saving_predictions_bytes";
+const char kMeasuredPages[] = "brave.stats.measured.pages";
+const char kMeasuredLoadedBytes[] = "brave.stats.measured.loaded_bytes";
+const char kMeasuredLoadTimeMs[] = "brave.stats.measured.load_time_ms";
+const char kMeasuredAllowedRequests[] =
+    "brave.stats.measured.allowed_requests";
+const char kMeasuredBlockedRequests[] =
+    "brave.stats.measured.blocked_requests";
+const char kMeasuredPredictedSavingsBytes[] =
+    "brave.stats.measured.predicted_savings_bytes";
 
 }  // namespace prefs
 
@@ -12,6 +12,12 @@ namespace prefs {
 
 extern const char kBandwidthSavedBytes[];
 extern const char kBandwidthSavedDailyBytes[];
+extern const char kMeasuredPages[];
+extern const char kMeasuredLoadedBytes[];
+extern const char kMeasuredLoadTimeMs[];
+extern const char kMeasuredAllowedRequests[];
+extern const char kMeasuredBlockedRequests[];
+extern const char kMeasuredPredictedSavingsBytes[];
 
 }  // namespace prefs
 
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 
+#include <memory>
 #include <vector>
 
 #include "base/containers/flat_set.h"
@@ -35,6 +36,25 @@ MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEQCeVJbcADloHb8bwftIi1UO0smiz
 8ObdAFQ8j3U9cMehGqI3zXgS8APvBW/9XxMkb4XWQe+t9h6qHq82P6zcBg==
 -----END PUBLIC KEY-----)";
 
+// Parsing the PEM keys is the expensive part of the crypto setup and the
+// keys never change, so it is done once per process. Returns null if a key
+// fails to load.
+BraveProchloCrypto* GetCrypto() {
+  static BraveProchloCrypto* crypto = []() -> BraveProchloCrypto* {
+    auto crypto = std::make_unique<BraveProchloCrypto>();
+    const std::vector<char> shuffler_key(
+        &kShufflerKey[0], &kShufflerKey[0] + base::size(kShufflerKey));
+    const std::vector<char> analyzer_key(
+        &kAnalyzerKey[0], &kAnalyzerKey[0] + base::size(kAnalyzerKey));
+    if (!crypto->load_shuffler_key_from_bytes(shuffler_key) ||
+        !crypto->load_analyzer_key_from_bytes(analyzer_key)) {
+      return nullptr;
+    }
+    return crypto.release();
+  }();
+  return crypto;
+}
+
 bool MakeProchlomation(uint64_t metric,
                        const uint8_t* data,
                        const uint8_t* crowd_id,
@@ -46,19 +66,9 @@ bool MakeProchlomation(uint64_t metric,
   // to src/base/trace_event/builtin_categories.h
   // TRACE_EVENT0("brave_p3a", "MakeProchlomation");
 
-  BraveProchloCrypto crypto;
-
-  const std::vector<char> shuffler_key(
-      &kShufflerKey[0], &kShufflerKey[0] + base::size(kShufflerKey));
-  if (!crypto.load_shuffler_key_from_bytes(shuffler_key)) {
+  BraveProchloCrypto* crypto = GetCrypto();
+  if (!crypto)
     return false;
-  }
-
-  const std::vector<char> analyzer_key(
-      &kAnalyzerKey[0], &kAnalyzerKey[0] + base::size(kAnalyzerKey));
-  if (!crypto.load_analyzer_key_from_bytes(analyzer_key)) {
-    return false;
-  }
 
   // We have to create a Prochlomation and a PlainShufflerItem to encrypt them
   // both into an AnalyzerItea and a ShufflerItem, respectively. We'll stage
@@ -71,7 +81,7 @@ bool MakeProchlomation(uint64_t metric,
   memcpy(prochlomation.data, data, kProchlomationDataLength);
 
   // Then the AnalyzerItem of the PlainShufflerItem
-  if (!crypto.EncryptForAnalyzer(prochlomation,
+  if (!crypto->EncryptForAnalyzer(prochlomation,
                                  &plain_shuffler_item.analyzer_item)) {
     NOTREACHED();
     return false;
@@ -81,7 +91,7 @@ bool MakeProchlomation(uint64_t metric,
   memcpy(plain_shuffler_item.crowd_id, crowd_id, kCrowdIdLength);
 
   // And create the ShufflerItem
-  if (!crypto.EncryptForShuffler(plain_shuffler_item, shuffler_item)) {
+  if (!crypto->EncryptForShuffler(plain_shuffler_item, shuffler_item)) {
     NOTREACHED();
     return false;
   }
@@ -334,6 +334,7 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
   content::URLDataSource::Add(profile_,
                               std::make_unique<BraveRewardsSource>(profile_));
   ready_ = std::make_unique<base::OneShotEvent>();
+  ledger_state_pref_change_registrar_.Init(profile_->GetPrefs());
 
   if (base::FeatureList::IsEnabled(features::kVerboseLoggingFeature))
     persist_log_level_ = kDiagnosticLogMaxVerboseLevel;
@@ -442,6 +443,30 @@ void RewardsServiceImpl::OnPreferenceChanged(const std::string& key) {
   }
 }
 
+void RewardsServiceImpl::ObserveLedgerState(const std::string& name) const {
+  const std::string path = GetPrefPath(name);
+  if (ledger_state_pref_change_registrar_.IsObserved(path))
+    return;
+
+  ledger_state_pref_change_registrar_.Add(
+      path, base::BindRepeating(&RewardsServiceImpl::OnLedgerStatePrefChanged,
+                                base::Unretained(this), name));
+}
+
+void RewardsServiceImpl::OnLedgerStatePrefChanged(
+    const std::string& name,
+    const std::string& path) const {
+  if (!Connected())
+    return;
+
+  const PrefService::Preference* pref =
+      profile_->GetPrefs()->FindPreference(path);
+  if (!pref)
+    return;
+
+  bat_ledger_->OnStateValueChanged(name, pref->GetValue()->Clone());
+}
+
 void RewardsServiceImpl::CheckPreferences() {
   const bool is_ac_enabled = profile_->GetPrefs()->GetBoolean(
       brave_rewards::prefs::kAutoContributeEnabled);
@@ -774,6 +799,14 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
     return;
   }
 
+  // Most resource loads are not media the ledger tracks, so drop them here
+  // instead of sending each one to the utility process.
+  if (!ledger::Ledger::IsMediaResource(url.spec(),
+                                       first_party_url.spec(),
+                                       referrer.spec())) {
+    return;
+  }
+
   base::flat_map<std::string, std::string> parts;
 
   for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
@@ -1460,6 +1493,8 @@ void RewardsServiceImpl::OnDiagnosticLogDeletedForCompleteReset(
     ledger_state_path_,
     publisher_state_path_,
     publisher_info_db_path_,
+    base::FilePath(publisher_info_db_path_.value() + FILE_PATH_LITERAL("-wal")),
+    base::FilePath(publisher_info_db_path_.value() + FILE_PATH_LITERAL("-shm")),
     publisher_list_path_,
   };
   base::PostTaskAndReplyWithResult(
@@ -1481,6 +1516,8 @@ void RewardsServiceImpl::Reset() {
   }
 
   current_media_fetchers_.clear();
+  panel_publisher_snapshots_.Clear();
+  pending_panel_urls_.clear();
   bat_ledger_.reset();
   bat_ledger_client_receiver_.reset();
   bat_ledger_service_.reset();
@@ -1492,56 +1529,69 @@ void RewardsServiceImpl::Reset() {
 }
 
 void RewardsServiceImpl::SetBooleanState(const std::string& name, bool value) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->SetBoolean(GetPrefPath(name), value);
 }
 
 bool RewardsServiceImpl::GetBooleanState(const std::string& name) const {
+  ObserveLedgerState(name);
   return profile_->GetPrefs()->GetBoolean(GetPrefPath(name));
 }
 
 void RewardsServiceImpl::SetIntegerState(const std::string& name, int value) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->SetInteger(GetPrefPath(name), value);
 }
 
 int RewardsServiceImpl::GetIntegerState(const std::string& name) const {
+  ObserveLedgerState(name);
   return profile_->GetPrefs()->GetInteger(GetPrefPath(name));
 }
 
 void RewardsServiceImpl::SetDoubleState(const std::string& name, double value) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->SetDouble(GetPrefPath(name), value);
 }
 
 double RewardsServiceImpl::GetDoubleState(const std::string& name) const {
+  ObserveLedgerState(name);
   return profile_->GetPrefs()->GetDouble(GetPrefPath(name));
 }
 
 void RewardsServiceImpl::SetStringState(const std::string& name,
                                         const std::string& value) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->SetString(GetPrefPath(name), value);
 }
 
 std::string RewardsServiceImpl::GetStringState(const std::string& name) const {
+  ObserveLedgerState(name);
   return profile_->GetPrefs()->GetString(GetPrefPath(name));
 }
 
 void RewardsServiceImpl::SetInt64State(const std::string& name, int64_t value) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->SetInt64(GetPrefPath(name), value);
 }
 
 int64_t RewardsServiceImpl::GetInt64State(const std::string& name) const {
+  ObserveLedgerState(name);
   return profile_->GetPrefs()->GetInt64(GetPrefPath(name));
 }
 
 void RewardsServiceImpl::SetUint64State(const std::string& name,
                                         uint64_t value) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->SetUint64(GetPrefPath(name), value);
 }
 
 uint64_t RewardsServiceImpl::GetUint64State(const std::string& name) const {
+  ObserveLedgerState(name);
   return profile_->GetPrefs()->GetUint64(GetPrefPath(name));
 }
 
 void RewardsServiceImpl::ClearState(const std::string& name) {
+  ObserveLedgerState(name);
   profile_->GetPrefs()->ClearPref(GetPrefPath(name));
 }
 
@@ -1816,6 +1866,16 @@ void RewardsServiceImpl::GetPublisherActivityFromUrl(
     return;
   }
 
+  auto snapshot = panel_publisher_snapshots_.Get(url);
+  if (snapshot != panel_publisher_snapshots_.end()) {
+    for (auto& observer : private_observers_)
+      observer.OnPanelPublisherInfo(this,
+                                    ledger::type::Result::LEDGER_OK,
+                                    snapshot->second.get(),
+                                    windowId);
+  }
+  pending_panel_urls_[windowId] = url;
+
   ledger::type::VisitDataPtr visit_data = ledger::type::VisitData::New();
   visit_data->domain = visit_data->name = baseDomain;
   visit_data->path = path;
@@ -1837,6 +1897,18 @@ void RewardsServiceImpl::OnPanelPublisherInfo(
     return;
   }
 
+  auto pending = pending_panel_urls_.find(windowId);
+  if (pending != pending_panel_urls_.end()) {
+    if (result == ledger::type::Result::LEDGER_OK && info) {
+      panel_publisher_snapshots_.Put(pending->second, info->Clone());
+    } else {
+      auto snapshot = panel_publisher_snapshots_.Peek(pending->second);
+      if (snapshot != panel_publisher_snapshots_.end())
+        panel_publisher_snapshots_.Erase(snapshot);
+    }
+    pending_panel_urls_.erase(pending);
+  }
+
   for (auto& observer : private_observers_)
     observer.OnPanelPublisherInfo(this,
                                   result,
@@ -2172,6 +2244,10 @@ void RewardsServiceImpl::SetPublisherExclude(
       ? ledger::type::PublisherExclude::EXCLUDED
       : ledger::type::PublisherExclude::INCLUDED;
 
+  // Snapshots carry the exclude state, so drop them rather than show a stale
+  // toggle before the next lookup completes.
+  panel_publisher_snapshots_.Clear();
+
   bat_ledger_->SetPublisherExclude(
     publisher_key,
     status,
@@ -2619,6 +2695,7 @@ void RewardsServiceImpl::RefreshPublisher(
     std::move(callback).Run(ledger::type::PublisherStatus::NOT_VERIFIED, "");
     return;
   }
+  panel_publisher_snapshots_.Clear();
   bat_ledger_->RefreshPublisher(
       publisher_key,
       base::BindOnce(&RewardsServiceImpl::OnRefreshPublisher,
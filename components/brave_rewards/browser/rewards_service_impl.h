@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
@@ -372,6 +373,12 @@ class RewardsServiceImpl : public RewardsService,
 
   void OnPreferenceChanged(const std::string& key);
 
+  // The ledger process mirrors every state pref it reads or writes, so
+  // changes to those prefs are pushed to it from here.
+  void ObserveLedgerState(const std::string& name) const;
+  void OnLedgerStatePrefChanged(const std::string& name,
+                                const std::string& path) const;
+
   void CheckPreferences();
 
   void StartLedgerProcessIfNecessary();
@@ -789,9 +796,19 @@ class RewardsServiceImpl : public RewardsService,
   SimpleURLLoaderList url_loaders_;
   std::map<std::string, BitmapFetcherService::RequestId>
       current_media_fetchers_;
+
+  // The last panel publisher info the ledger returned for each page URL,
+  // so that the panel can render at once while a fresh lookup runs.
+  static constexpr size_t kMaxPanelPublisherSnapshots = 32;
+  base::MRUCache<std::string, ledger::type::PublisherInfoPtr>
+      panel_publisher_snapshots_{kMaxPanelPublisherSnapshots};
+  // The page URL of the latest panel lookup for each window
+  std::map<uint64_t, std::string> pending_panel_urls_;
   std::unique_ptr<base::OneShotTimer> notification_startup_timer_;
   std::unique_ptr<base::RepeatingTimer> notification_periodic_timer_;
   PrefChangeRegistrar profile_pref_change_registrar_;
+  // Mutable as state prefs are observed from the const LedgerClient getters.
+  mutable PrefChangeRegistrar ledger_state_pref_change_registrar_;
 
   uint32_t next_timer_id_;
   int32_t country_id_ = 0;
@@ -127,6 +127,11 @@ export const onCurrentTips = (list: Rewards.Publisher[]) => action(types.ON_CURR
   list
 })
 
+export const getInitialData = (month: number, year: number) => action(types.GET_INITIAL_DATA, {
+  month,
+  year
+})
+
 export const getTipTable = () => action(types.GET_TIP_TABLE)
 
 export const getContributeList = () => action(types.GET_CONTRIBUTE_LIST)
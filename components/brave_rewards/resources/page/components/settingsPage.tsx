@@ -54,18 +54,6 @@ class SettingsPage extends React.Component<Props, State> {
     return this.props.actions
   }
 
-  refreshActions () {
-    this.actions.getBalanceReport(new Date().getMonth() + 1, new Date().getFullYear())
-    this.actions.getTipTable()
-    this.actions.getContributeList()
-    this.actions.getPendingContributions()
-    this.actions.getReconcileStamp()
-    this.actions.getStatement()
-    this.actions.getAdsData()
-    this.actions.getExcludedSites()
-    this.actions.getCountryCode()
-  }
-
   componentDidMount () {
     if (!this.props.rewardsData.initializing) {
       this.startRewards()
@@ -119,21 +107,11 @@ class SettingsPage extends React.Component<Props, State> {
   }
 
   startRewards () {
-    this.refreshActions()
-
-    this.actions.getRewardsParameters()
-    this.actions.getContributionAmount()
-    this.actions.getAutoContributeProperties()
-    this.actions.getBalance()
+    this.actions.getInitialData(new Date().getMonth() + 1, new Date().getFullYear())
     this.balanceTimerId = window.setInterval(() => {
       this.actions.getBalance()
     }, 60000)
 
-    this.actions.fetchPromotions()
-    this.actions.getExternalWallet()
-    this.actions.getOnboardingStatus()
-    this.actions.getEnabledInlineTippingPlatforms()
-
     this.handleURL()
   }
 
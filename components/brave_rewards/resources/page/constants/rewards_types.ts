@@ -32,6 +32,7 @@ export const enum types {
   ON_RECURRING_TIPS = '@@rewards/ON_RECURRING_TIPS',
   REMOVE_RECURRING_TIP = '@@rewards/REMOVE_RECURRING_TIP',
   ON_CURRENT_TIPS = '@@rewards/ON_CURRENT_TIPS',
+  GET_INITIAL_DATA = '@@rewards/GET_INITIAL_DATA',
   GET_TIP_TABLE = '@@rewards/GET_TIP_TABLE',
   GET_CONTRIBUTE_LIST = '@@rewards/GET_CONTRIBUTE_LIST',
   INIT_AUTOCONTRIBUTE_SETTINGS = '@@rewards/INIT_AUTOCONTRIBUTE_SETTINGS',
@@ -110,6 +110,13 @@ const rewardsReducer: Reducer<Rewards.State | undefined> = (state: Rewards.State
       state.reconcileStamp = parseInt(action.payload.stamp, 10)
       break
     }
+    case types.GET_INITIAL_DATA: {
+      chrome.send('brave_rewards.getInitialData', [
+        action.payload.month,
+        action.payload.year
+      ])
+      break
+    }
     case types.GET_TIP_TABLE: {
       chrome.send('brave_rewards.getRecurringTips')
       chrome.send('brave_rewards.getOneTimeTips')
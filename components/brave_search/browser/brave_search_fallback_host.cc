@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "brave/components/brave_search/browser/brave_search_fallback_prefetcher.h"
 #include "net/base/load_flags.h"
 #include "net/base/url_util.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -49,8 +50,11 @@ void BraveSearchFallbackHost::SetBackupProviderForTest(
 }
 
 BraveSearchFallbackHost::BraveSearchFallbackHost(
-    scoped_refptr<network::SharedURLLoaderFactory> factory)
-    : shared_url_loader_factory_(std::move(factory)), weak_factory_(this) {}
+    scoped_refptr<network::SharedURLLoaderFactory> factory,
+    base::WeakPtr<BraveSearchFallbackPrefetcher> prefetcher)
+    : shared_url_loader_factory_(std::move(factory)),
+      prefetcher_(std::move(prefetcher)),
+      weak_factory_(this) {}
 
 BraveSearchFallbackHost::~BraveSearchFallbackHost() {}
 
@@ -75,20 +79,19 @@ GURL BraveSearchFallbackHost::GetBackupResultURL(const GURL& baseURL,
   return url;
 }
 
-void BraveSearchFallbackHost::FetchBackupResults(
-    const std::string& query,
-    const std::string& lang,
-    const std::string& country,
-    const std::string& geo,
-    bool filter_explicit_results,
-    FetchBackupResultsCallback callback) {
+// [static]
+GURL BraveSearchFallbackHost::GetBackupProvider() {
+  if (!backup_provider_for_test.is_empty())
+    return backup_provider_for_test;
+  return GURL("https://www.google.com/search");
+}
+
+// [static]
+std::unique_ptr<network::SimpleURLLoader>
+BraveSearchFallbackHost::CreateURLLoader(const GURL& url,
+                                         const std::string& geo) {
   auto request = std::make_unique<network::ResourceRequest>();
-  request->url = GURL("https://www.google.com/search");
-  if (!backup_provider_for_test.is_empty()) {
-    request->url = backup_provider_for_test;
-  }
-  request->url = GetBackupResultURL(request->url, query, lang, country, geo,
-                                    filter_explicit_results);
+  request->url = url;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE;
   request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   request->load_flags |= net::LOAD_DO_NOT_SAVE_COOKIES;
@@ -100,7 +103,26 @@ void BraveSearchFallbackHost::FetchBackupResults(
   url_loader->SetRetryOptions(
       kRetriesCountOnNetworkChange,
       network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
-  auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
+  return url_loader;
+}
+
+void BraveSearchFallbackHost::FetchBackupResults(
+    const std::string& query,
+    const std::string& lang,
+    const std::string& country,
+    const std::string& geo,
+    bool filter_explicit_results,
+    FetchBackupResultsCallback callback) {
+  if (prefetcher_ &&
+      prefetcher_->TakePrefetchedResults(query, lang, country, geo,
+                                         filter_explicit_results, &callback)) {
+    return;
+  }
+
+  const GURL url = GetBackupResultURL(GetBackupProvider(), query, lang,
+                                      country, geo, filter_explicit_results);
+  auto iter = url_loaders_.insert(url_loaders_.begin(),
+                                  CreateURLLoader(url, geo));
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       shared_url_loader_factory_.get(),
       base::BindOnce(&BraveSearchFallbackHost::OnURLLoaderComplete,
@@ -22,13 +22,17 @@ class SimpleURLLoader;
 
 namespace brave_search {
 
+class BraveSearchFallbackPrefetcher;
+
 class BraveSearchFallbackHost final
     : public brave_search::mojom::BraveSearchFallback {
  public:
   BraveSearchFallbackHost(const BraveSearchFallbackHost&) = delete;
   BraveSearchFallbackHost& operator=(const BraveSearchFallbackHost&) = delete;
+  // |prefetcher| is optional; requests it has prefetched are answered by it.
   explicit BraveSearchFallbackHost(
-      scoped_refptr<network::SharedURLLoaderFactory> factory);
+      scoped_refptr<network::SharedURLLoaderFactory> factory,
+      base::WeakPtr<BraveSearchFallbackPrefetcher> prefetcher = nullptr);
   ~BraveSearchFallbackHost() override;
 
   void FetchBackupResults(const std::string& query_string,
@@ -44,6 +48,10 @@ class BraveSearchFallbackHost final
                                  const std::string& country,
                                  const std::string& geo,
                                  bool filter_explicit_results);
+  static GURL GetBackupProvider();
+  static std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(
+      const GURL& url,
+      const std::string& geo);
   static void SetBackupProviderForTest(const GURL&);
 
  private:
@@ -60,6 +68,7 @@ class BraveSearchFallbackHost final
       const std::unique_ptr<std::string> response_body);
   SimpleURLLoaderList url_loaders_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  base::WeakPtr<BraveSearchFallbackPrefetcher> prefetcher_;
   base::WeakPtrFactory<BraveSearchFallbackHost> weak_factory_;
 };
 
@@ -0,0 +1,152 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_search/browser/brave_search_fallback_prefetcher.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "brave/components/brave_search/browser/brave_search_fallback_host.h"
+#include "brave/components/brave_search/common/features.h"
+#include "net/base/url_util.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+
+namespace brave_search {
+
+namespace {
+
+const char kUserDataKey[] = "brave_search_fallback_prefetcher";
+const char kSearchPath[] = "/search";
+
+// A results page rarely has more than one query in flight; this only bounds
+// the work done for pages that keep navigating.
+constexpr size_t kMaxPendingFetches = 4;
+
+}  // namespace
+
+BraveSearchFallbackPrefetcher::PendingFetch::PendingFetch() = default;
+BraveSearchFallbackPrefetcher::PendingFetch::~PendingFetch() = default;
+
+BraveSearchFallbackPrefetcher::BraveSearchFallbackPrefetcher(
+    scoped_refptr<network::SharedURLLoaderFactory> factory,
+    base::TimeDelta ttl)
+    : shared_url_loader_factory_(std::move(factory)), ttl_(ttl) {}
+
+BraveSearchFallbackPrefetcher::~BraveSearchFallbackPrefetcher() = default;
+
+// static
+BraveSearchFallbackPrefetcher* BraveSearchFallbackPrefetcher::GetOrCreate(
+    base::SupportsUserData* holder,
+    scoped_refptr<network::SharedURLLoaderFactory> factory) {
+  auto* prefetcher = static_cast<BraveSearchFallbackPrefetcher*>(
+      holder->GetUserData(kUserDataKey));
+  if (!prefetcher) {
+    auto new_prefetcher = std::make_unique<BraveSearchFallbackPrefetcher>(
+        std::move(factory),
+        base::TimeDelta::FromSeconds(
+            features::kBraveSearchFallbackPrefetchTTL.Get()));
+    prefetcher = new_prefetcher.get();
+    holder->SetUserData(kUserDataKey, std::move(new_prefetcher));
+  }
+  return prefetcher;
+}
+
+// static
+std::string BraveSearchFallbackPrefetcher::GetKey(const GURL& url,
+                                                  const std::string& geo) {
+  return url.spec() + " " + geo;
+}
+
+void BraveSearchFallbackPrefetcher::Prefetch(const GURL& search_url) {
+  if (!last_settings_ || search_url.path_piece() != kSearchPath)
+    return;
+  std::string query;
+  if (!net::GetValueForKeyInQuery(search_url, "q", &query) || query.empty())
+    return;
+
+  const GURL url = BraveSearchFallbackHost::GetBackupResultURL(
+      BraveSearchFallbackHost::GetBackupProvider(), query,
+      last_settings_->lang, last_settings_->country, last_settings_->geo,
+      last_settings_->filter_explicit_results);
+  const std::string key = GetKey(url, last_settings_->geo);
+  if (prefetches_.count(key) || prefetches_.size() >= kMaxPendingFetches)
+    return;
+
+  auto pending = std::make_unique<PendingFetch>();
+  pending->url_loader =
+      BraveSearchFallbackHost::CreateURLLoader(url, last_settings_->geo);
+  pending->url_loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      shared_url_loader_factory_.get(),
+      base::BindOnce(&BraveSearchFallbackPrefetcher::OnURLLoaderComplete,
+                     weak_factory_.GetWeakPtr(), key));
+  // The timer is owned by |this| through |prefetches_|.
+  pending->expiry_timer.Start(
+      FROM_HERE, ttl_,
+      base::BindOnce(&BraveSearchFallbackPrefetcher::OnExpired,
+                     base::Unretained(this), key));
+  prefetches_[key] = std::move(pending);
+}
+
+bool BraveSearchFallbackPrefetcher::TakePrefetchedResults(
+    const std::string& query,
+    const std::string& lang,
+    const std::string& country,
+    const std::string& geo,
+    bool filter_explicit_results,
+    FetchBackupResultsCallback* callback) {
+  DCHECK(callback);
+  last_settings_ = Settings{lang, country, geo, filter_explicit_results};
+
+  const GURL url = BraveSearchFallbackHost::GetBackupResultURL(
+      BraveSearchFallbackHost::GetBackupProvider(), query, lang, country, geo,
+      filter_explicit_results);
+  auto it = prefetches_.find(GetKey(url, geo));
+  if (it == prefetches_.end() || it->second->callback)
+    return false;
+
+  PendingFetch* pending = it->second.get();
+  if (pending->url_loader) {
+    // Still in flight; answered from OnURLLoaderComplete.
+    pending->callback = std::move(*callback);
+    pending->expiry_timer.Stop();
+    return true;
+  }
+
+  std::string response = std::move(pending->response);
+  prefetches_.erase(it);
+  std::move(*callback).Run(response);
+  return true;
+}
+
+void BraveSearchFallbackPrefetcher::OnURLLoaderComplete(
+    const std::string& key,
+    std::unique_ptr<std::string> response_body) {
+  auto it = prefetches_.find(key);
+  DCHECK(it != prefetches_.end());
+  PendingFetch* pending = it->second.get();
+  pending->url_loader.reset();
+
+  if (pending->callback) {
+    FetchBackupResultsCallback callback = std::move(pending->callback);
+    prefetches_.erase(it);
+    std::move(callback).Run(response_body ? *response_body : "");
+    return;
+  }
+
+  // Failures aren't kept, so that the page's own request tries again.
+  if (!response_body) {
+    prefetches_.erase(it);
+    return;
+  }
+  pending->response = std::move(*response_body);
+}
+
+void BraveSearchFallbackPrefetcher::OnExpired(const std::string& key) {
+  // Cancels the fetch if it is still in flight.
+  prefetches_.erase(key);
+}
+
+}  // namespace brave_search
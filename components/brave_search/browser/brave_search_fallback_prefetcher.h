@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_PREFETCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_PREFETCHER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "brave/components/brave_search/common/brave_search_fallback.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace brave_search {
+
+// Fetches backup results for a Brave Search query while its results page
+// loads, so that BraveSearchFallbackHost can answer the page without a
+// network round trip of its own. One instance per browser context.
+//
+// Only the query comes from the page URL. The language, country, geo and
+// filter settings are those of the last request the page made in this
+// browser context, so nothing is prefetched until the page has used the
+// fallback once. Prefetches that aren't claimed in time are cancelled.
+class BraveSearchFallbackPrefetcher : public base::SupportsUserData::Data {
+ public:
+  using FetchBackupResultsCallback =
+      mojom::BraveSearchFallback::FetchBackupResultsCallback;
+
+  BraveSearchFallbackPrefetcher(
+      scoped_refptr<network::SharedURLLoaderFactory> factory,
+      base::TimeDelta ttl);
+  ~BraveSearchFallbackPrefetcher() override;
+  BraveSearchFallbackPrefetcher(const BraveSearchFallbackPrefetcher&) =
+      delete;
+  BraveSearchFallbackPrefetcher& operator=(
+      const BraveSearchFallbackPrefetcher&) = delete;
+
+  // Returns the prefetcher attached to |holder|, attaching one first if
+  // needed. For a browser context.
+  static BraveSearchFallbackPrefetcher* GetOrCreate(
+      base::SupportsUserData* holder,
+      scoped_refptr<network::SharedURLLoaderFactory> factory);
+
+  // Starts fetching backup results for the query of |search_url|, a Brave
+  // Search results page, unless there is no query or no settings yet.
+  void Prefetch(const GURL& search_url);
+
+  // Answers a request with a matching prefetch, now or when it completes,
+  // and returns true. Otherwise returns false and leaves |callback| alone.
+  // The request's settings are kept for later prefetches either way.
+  bool TakePrefetchedResults(const std::string& query,
+                             const std::string& lang,
+                             const std::string& country,
+                             const std::string& geo,
+                             bool filter_explicit_results,
+                             FetchBackupResultsCallback* callback);
+
+  size_t pending_count_for_testing() const { return prefetches_.size(); }
+
+  base::WeakPtr<BraveSearchFallbackPrefetcher> AsWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ private:
+  struct Settings {
+    std::string lang;
+    std::string country;
+    std::string geo;
+    bool filter_explicit_results = false;
+  };
+
+  struct PendingFetch {
+    PendingFetch();
+    ~PendingFetch();
+
+    // Null once the fetch has completed.
+    std::unique_ptr<network::SimpleURLLoader> url_loader;
+    std::string response;
+    // Set when a request claimed the prefetch before it completed.
+    FetchBackupResultsCallback callback;
+    base::OneShotTimer expiry_timer;
+  };
+
+  static std::string GetKey(const GURL& url, const std::string& geo);
+  void OnURLLoaderComplete(const std::string& key,
+                           std::unique_ptr<std::string> response_body);
+  void OnExpired(const std::string& key);
+
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  const base::TimeDelta ttl_;
+  absl::optional<Settings> last_settings_;
+  // Keyed by backup result URL and geo.
+  std::map<std::string, std::unique_ptr<PendingFetch>> prefetches_;
+  base::WeakPtrFactory<BraveSearchFallbackPrefetcher> weak_factory_{this};
+};
+
+}  // namespace brave_search
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_PREFETCHER_H_
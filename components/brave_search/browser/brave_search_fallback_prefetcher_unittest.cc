@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_search/browser/brave_search_fallback_prefetcher.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_search {
+
+namespace {
+
+const char kSearchURL[] = "https://search.brave.com/search?q=brave";
+const char kBackupURL[] = "https://www.google.com/search?q=brave&hl=en&gl=ca";
+
+}  // namespace
+
+class BraveSearchFallbackPrefetcherTest : public testing::Test {
+ public:
+  BraveSearchFallbackPrefetcherTest()
+      : prefetcher_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_),
+            base::TimeDelta::FromSeconds(10)) {}
+
+ protected:
+  // Asks for backup results the way the host does, recording the answer in
+  // |responses_| if the prefetcher takes the request.
+  bool Take(const std::string& query) {
+    BraveSearchFallbackPrefetcher::FetchBackupResultsCallback callback =
+        base::BindOnce(
+            [](std::vector<std::string>* responses,
+               const std::string& response) {
+              responses->push_back(response);
+            },
+            &responses_);
+    return prefetcher_.TakePrefetchedResults(query, "en", "ca", "1,2", false,
+                                             &callback);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  network::TestURLLoaderFactory url_loader_factory_;
+  BraveSearchFallbackPrefetcher prefetcher_;
+  std::vector<std::string> responses_;
+};
+
+TEST_F(BraveSearchFallbackPrefetcherTest, NeedsSettingsFromAnEarlierRequest) {
+  prefetcher_.Prefetch(GURL(kSearchURL));
+  EXPECT_EQ(url_loader_factory_.NumPending(), 0);
+
+  EXPECT_FALSE(Take("brave"));
+  prefetcher_.Prefetch(GURL(kSearchURL));
+  EXPECT_EQ(url_loader_factory_.NumPending(), 1);
+  EXPECT_TRUE(url_loader_factory_.IsPending(kBackupURL));
+
+  // Other pages and pages without a query aren't prefetched.
+  prefetcher_.Prefetch(GURL("https://search.brave.com/settings?q=brave"));
+  prefetcher_.Prefetch(GURL("https://search.brave.com/search"));
+  EXPECT_EQ(prefetcher_.pending_count_for_testing(), 1u);
+}
+
+TEST_F(BraveSearchFallbackPrefetcherTest, AnswersFromCompletedPrefetch) {
+  EXPECT_FALSE(Take("brave"));
+  prefetcher_.Prefetch(GURL(kSearchURL));
+  url_loader_factory_.SimulateResponseForPendingRequest(kBackupURL, "results");
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(Take("other"));
+  EXPECT_TRUE(Take("brave"));
+  EXPECT_EQ(responses_, std::vector<std::string>{"results"});
+  EXPECT_EQ(prefetcher_.pending_count_for_testing(), 0u);
+
+  // A prefetch answers one request only.
+  EXPECT_FALSE(Take("brave"));
+}
+
+TEST_F(BraveSearchFallbackPrefetcherTest, AnswersWhenInFlightPrefetchEnds) {
+  EXPECT_FALSE(Take("brave"));
+  prefetcher_.Prefetch(GURL(kSearchURL));
+  EXPECT_TRUE(Take("brave"));
+  EXPECT_TRUE(responses_.empty());
+
+  // Claimed prefetches don't expire.
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(20));
+  url_loader_factory_.SimulateResponseForPendingRequest(kBackupURL, "results");
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(responses_, std::vector<std::string>{"results"});
+  EXPECT_EQ(prefetcher_.pending_count_for_testing(), 0u);
+}
+
+TEST_F(BraveSearchFallbackPrefetcherTest, CancelsUnclaimedPrefetch) {
+  EXPECT_FALSE(Take("brave"));
+  prefetcher_.Prefetch(GURL(kSearchURL));
+  EXPECT_EQ(prefetcher_.pending_count_for_testing(), 1u);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(11));
+  EXPECT_EQ(prefetcher_.pending_count_for_testing(), 0u);
+  EXPECT_FALSE(Take("brave"));
+  EXPECT_TRUE(responses_.empty());
+}
+
+}  // namespace brave_search
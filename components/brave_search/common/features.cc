@@ -19,5 +19,14 @@ const base::FeatureParam<int> kBraveSearchDefaultAPIDailyLimit{
 const base::FeatureParam<int> kBraveSearchDefaultAPITotalLimit{
     &kBraveSearchDefaultAPIFeature, kBraveSearchDefaultAPITotalLimitName, 10};
 
+const base::Feature kBraveSearchFallbackPrefetchFeature{
+    "BraveSearchFallbackPrefetch", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kBraveSearchFallbackPrefetchTTL{
+    &kBraveSearchFallbackPrefetchFeature, "ttl_seconds", 10};
+
+const base::Feature kBraveSearchServiceWorkerWarmupFeature{
+    "BraveSearchServiceWorkerWarmup", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace brave_search
@@ -20,6 +20,17 @@ extern const base::Feature kBraveSearchDefaultAPIFeature;
 extern const base::FeatureParam<int> kBraveSearchDefaultAPIDailyLimit;
 extern const base::FeatureParam<int> kBraveSearchDefaultAPITotalLimit;
 
+// Starts the backup results fetch for a Brave Search query as soon as its
+// results page starts loading, rather than when the page asks for them.
+extern const base::Feature kBraveSearchFallbackPrefetchFeature;
+// How long an unclaimed prefetch is kept, in seconds.
+extern const base::FeatureParam<int> kBraveSearchFallbackPrefetchTTL;
+
+// Starts the Brave Search service worker when the omnibox gets focus and
+// Brave Search is the default search engine, so that it is running by the
+// time the results page loads.
+extern const base::Feature kBraveSearchServiceWorkerWarmupFeature;
+
 }  // namespace features
 }  // namespace brave_search
 
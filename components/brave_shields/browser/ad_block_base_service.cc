@@ -12,16 +12,22 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -34,8 +40,10 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
-std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
-  std::string filter_option = "";
+// Returns a static string so that it can be handed to the adblock engine
+// without a copy.
+const char* ResourceTypeToString(blink::mojom::ResourceType resource_type) {
+  const char* filter_option = "";
   switch (resource_type) {
     // top level page
     case blink::mojom::ResourceType::kMainFrame:
@@ -100,13 +108,69 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   return filter_option;
 }
 
+using GetMappedDATFileDataResult =
+    brave_shields::AdBlockBaseService::GetMappedDATFileDataResult;
+
+// Loads the engine snapshot left by the previous run, if there is one.
+GetMappedDATFileDataResult LoadEngineSnapshot(
+    const base::FilePath& snapshot_path) {
+  if (!base::PathExists(snapshot_path))
+    return GetMappedDATFileDataResult(nullptr, 0);
+  return brave_component_updater::LoadMappedDATFileData<adblock::Engine>(
+      snapshot_path);
+}
+
+// Copies |dat_file_path| over |snapshot_path| unless the snapshot was already
+// taken from it. The file naming the source is written last, so an
+// interrupted copy is taken again next time.
+void WriteEngineSnapshot(const base::FilePath& dat_file_path,
+                         const base::FilePath& snapshot_path) {
+  const base::FilePath source_file =
+      snapshot_path.AddExtension(FILE_PATH_LITERAL("source"));
+  const std::string source = dat_file_path.AsUTF8Unsafe();
+  std::string snapshot_source;
+  if (base::ReadFileToString(source_file, &snapshot_source) &&
+      snapshot_source == source && base::PathExists(snapshot_path)) {
+    return;
+  }
+
+  const base::FilePath snapshot_dir = snapshot_path.DirName();
+  base::FilePath temp_path;
+  if (!base::CreateDirectory(snapshot_dir) ||
+      !base::CreateTemporaryFileInDir(snapshot_dir, &temp_path)) {
+    return;
+  }
+  if (!base::CopyFile(dat_file_path, temp_path) ||
+      !base::ReplaceFile(temp_path, snapshot_path, nullptr)) {
+    base::DeleteFile(temp_path);
+    return;
+  }
+  base::ImportantFileWriter::WriteFileAtomically(source_file, source);
+}
+
 }  // namespace
 
 namespace brave_shields {
 
+AdBlockRequest::AdBlockRequest() = default;
+
+AdBlockRequest::AdBlockRequest(const AdBlockRequest&) = default;
+
+AdBlockRequest::~AdBlockRequest() = default;
+
+void AdBlockRequest::ComputeDerivedFields() {
+  url_host = url.host();
+  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
+  // a URL or origin and not a string to a host name.
+  is_third_party = !SameDomainOrHost(
+      url, url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+      INCLUDE_PRIVATE_REGISTRIES);
+}
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new adblock::Engine()),
+      first_party_summary_(std::make_unique<AdBlockFirstPartySummary>()),
       weak_factory_(this) {}
 
 AdBlockBaseService::~AdBlockBaseService() {
@@ -144,11 +208,54 @@ void AdBlockBaseService::ShouldStartRequest(
   //  << ", url.spec(): " << url.spec();
 }
 
+void AdBlockBaseService::ShouldStartRequests(
+    const std::vector<AdBlockRequest*>& requests) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+
+  std::vector<AdBlockRequest*> pending;
+  pending.reserve(requests.size());
+  for (AdBlockRequest* request : requests) {
+    if (!request->did_match_important)
+      pending.push_back(request);
+  }
+  if (pending.empty())
+    return;
+
+  // The engine borrows the request strings, so |requests| has to stay alive
+  // for the whole batch.
+  std::vector<adblock::MatchRequest> match_requests;
+  match_requests.reserve(pending.size());
+  std::vector<adblock::MatchResult> match_results(pending.size());
+  for (size_t i = 0; i < pending.size(); i++) {
+    const AdBlockRequest* request = pending[i];
+    match_requests.push_back({request->url.spec().c_str(),
+                              request->url_host.c_str(),
+                              request->tab_host.c_str(), request->is_third_party,
+                              ResourceTypeToString(request->resource_type)});
+    match_results[i].did_match_rule = request->did_match_rule;
+    match_results[i].did_match_exception = request->did_match_exception;
+    match_results[i].did_match_important = request->did_match_important;
+  }
+
+  ad_block_client_->matchesBatch(match_requests, &match_results);
+
+  for (size_t i = 0; i < pending.size(); i++) {
+    AdBlockRequest* request = pending[i];
+    request->did_match_rule = match_results[i].did_match_rule;
+    request->did_match_exception = match_results[i].did_match_exception;
+    request->did_match_important = match_results[i].did_match_important;
+    if (!match_results[i].redirect.empty())
+      request->mock_data_url = std::move(match_results[i].redirect);
+  }
+}
+
 absl::optional<std::string> AdBlockBaseService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
     const std::string& tab_host) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  if (!MayHaveCspDirectives(url.host(), tab_host))
+    return absl::nullopt;
 
   // Determine third-party here so the library doesn't need to figure it out.
   // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
@@ -168,6 +275,21 @@ absl::optional<std::string> AdBlockBaseService::GetCspDirectives(
   }
 }
 
+bool AdBlockBaseService::MayMatchFirstPartyRequest(
+    const std::string& request_host,
+    const std::string& tab_host) {
+  base::AutoLock lock(first_party_summary_lock_);
+  return !first_party_summary_ ||
+         first_party_summary_->MayMatch(request_host, tab_host);
+}
+
+bool AdBlockBaseService::MayHaveCspDirectives(const std::string& request_host,
+                                              const std::string& tab_host) {
+  base::AutoLock lock(first_party_summary_lock_);
+  return !first_party_summary_ ||
+         first_party_summary_->MayHaveCspDirectives(request_host, tab_host);
+}
+
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
   if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
     GetTaskRunner()->PostTask(
@@ -176,18 +298,20 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  // Every profile applies its shields prefs to the shared engines, so most
+  // calls find the tag already in the requested state. Those leave the engine
+  // and the decision cache alone.
+  if (enabled == (tags_.find(tag) != tags_.end())) {
+    return;
+  }
+
+  AdBlockDecisionCache::BumpEngineGeneration();
   if (enabled) {
-    if (tags_.find(tag) == tags_.end()) {
-      ad_block_client_->addTag(tag);
-      tags_.insert(tag);
-    }
+    ad_block_client_->addTag(tag);
+    tags_.insert(tag);
   } else {
     ad_block_client_->removeTag(tag);
-    std::set<std::string>::iterator it =
-        std::find(tags_.begin(), tags_.end(), tag);
-    if (it != tags_.end()) {
-      tags_.erase(it);
-    }
+    tags_.erase(tag);
   }
 }
 
@@ -201,6 +325,7 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
 
   ad_block_client_->addResources(resources);
   resources_ = resources;
+  AdBlockDecisionCache::BumpEngineGeneration();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -224,13 +349,62 @@ absl::optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
   //   return;
 
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+  if (!base::FeatureList::IsEnabled(
+          features::kBraveAdblockHiddenSelectorCache)) {
+    return base::JSONReader::Read(
+        ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+  }
+
+  std::vector<std::string> unknown_classes;
+  std::vector<std::string> unknown_ids;
+  hidden_selector_cache_.FilterKnownMisses(classes, ids, &unknown_classes,
+                                           &unknown_ids);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.HiddenSelectorCacheSkippedEngine",
+                        unknown_classes.empty() && unknown_ids.empty());
+  if (unknown_classes.empty() && unknown_ids.empty())
+    return base::Value(base::Value::Type::LIST);
+
+  const std::string selectors = ad_block_client_->hiddenClassIdSelectors(
+      unknown_classes, unknown_ids, exceptions);
+  if (selectors == "[]") {
+    // With exceptions applied an empty result doesn't mean the engine has no
+    // rules for these, only that this page excepted them.
+    if (exceptions.empty())
+      hidden_selector_cache_.AddMisses(unknown_classes, unknown_ids);
+    return base::Value(base::Value::Type::LIST);
+  }
+  return base::JSONReader::Read(selectors);
+}
+
+void AdBlockBaseService::EnableEngineSnapshot(
+    const base::FilePath& snapshot_path) {
+  DCHECK(!IsInitialized());
+  snapshot_path_ = snapshot_path;
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path,
                                         bool deserialize,
                                         base::OnceClosure callback) {
+  // Only serialized engines are snapshotted: they are ready to map as they
+  // are, where an engine compiled from list text would need serializing.
+  if (deserialize && !snapshot_path_.empty()) {
+    callback = base::BindOnce(&AdBlockBaseService::OnSnapshotSourceLoaded,
+                              weak_factory_.GetWeakPtr(), dat_file_path,
+                              std::move(callback));
+  }
+
+  if (deserialize &&
+      base::FeatureList::IsEnabled(features::kBraveAdblockMappedDATFiles)) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock()},
+        base::BindOnce(
+            &brave_component_updater::LoadMappedDATFileData<adblock::Engine>,
+            dat_file_path),
+        base::BindOnce(&AdBlockBaseService::OnGetMappedDATFileData,
+                       weak_factory_.GetWeakPtr(), std::move(callback)));
+    return;
+  }
+
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
       base::BindOnce(
@@ -239,10 +413,22 @@ void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path,
               : &brave_component_updater::LoadRawFileData<adblock::Engine>,
           dat_file_path),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_factory_.GetWeakPtr(), std::move(callback),
+                     !deserialize));
+}
+
+void AdBlockBaseService::GetEngineData(
+    scoped_refptr<base::TaskRunner> task_runner,
+    base::OnceCallback<GetDATFileDataResult()> load,
+    base::OnceClosure callback) {
+  task_runner->PostTaskAndReplyWithResult(
+      FROM_HERE, std::move(load),
+      base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
+                     weak_factory_.GetWeakPtr(), std::move(callback), true));
 }
 
 void AdBlockBaseService::OnGetDATFileData(base::OnceClosure callback,
+                                          bool rules_are_text,
                                           GetDATFileDataResult result) {
   if (result.second.empty()) {
     LOG(ERROR) << "Could not obtain ad block data";
@@ -252,20 +438,96 @@ void AdBlockBaseService::OnGetDATFileData(base::OnceClosure callback,
     LOG(ERROR) << "Failed to deserialize ad block data";
     return;
   }
+  engine_data_size_ = result.second.size();
+  OnAdBlockClientLoaded(
+      std::move(callback), std::move(result.first),
+      rules_are_text ? std::move(result.second)
+                     : brave_component_updater::DATFileDataBuffer());
+}
+
+void AdBlockBaseService::OnGetMappedDATFileData(
+    base::OnceClosure callback,
+    GetMappedDATFileDataResult result) {
+  if (!result.first.get()) {
+    LOG(ERROR) << "Failed to deserialize memory mapped ad block data";
+    return;
+  }
+  // The serialized engine never had to be copied to the heap, so the whole
+  // mapped size is memory the buffered path would have allocated.
+  UMA_HISTOGRAM_MEMORY_KB("Brave.Adblock.MappedDATFileSavedKB",
+                          result.second / 1024);
+  engine_data_size_ = result.second;
+  OnAdBlockClientLoaded(std::move(callback), std::move(result.first),
+                        brave_component_updater::DATFileDataBuffer());
+}
+
+void AdBlockBaseService::OnAdBlockClientLoaded(
+    base::OnceClosure callback,
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    brave_component_updater::DATFileDataBuffer rules) {
+  has_fresh_engine_ = true;
   GetTaskRunner()->PostTask(
-      FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
-                                std::move(result.first)));
+      FROM_HERE,
+      base::BindOnce(&AdBlockBaseService::UpdateAdBlockClientWithRules,
+                     base::Unretained(this), std::move(ad_block_client),
+                     std::move(rules)));
   // TODO(bridiver) this needs to happen after adblock client is actually reset
   std::move(callback).Run();
 }
 
+void AdBlockBaseService::OnGetEngineSnapshot(
+    GetMappedDATFileDataResult result) {
+  if (has_fresh_engine_ || !result.first)
+    return;
+  engine_data_size_ = result.second;
+  // Nothing is known about the rules the snapshot was compiled from.
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
+                     base::Unretained(this), std::move(result.first),
+                     std::unique_ptr<AdBlockFirstPartySummary>()));
+}
+
+void AdBlockBaseService::OnSnapshotSourceLoaded(
+    const base::FilePath& dat_file_path,
+    base::OnceClosure callback) {
+  std::move(callback).Run();
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&WriteEngineSnapshot, dat_file_path, snapshot_path_));
+}
+
+void AdBlockBaseService::UpdateAdBlockClientWithRules(
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    brave_component_updater::DATFileDataBuffer rules) {
+  std::unique_ptr<AdBlockFirstPartySummary> first_party_summary;
+  if (!rules.empty()) {
+    first_party_summary = AdBlockFirstPartySummary::FromRules(
+        base::StringPiece(reinterpret_cast<const char*>(rules.data()),
+                          rules.size()));
+  }
+  UpdateAdBlockClient(std::move(ad_block_client),
+                      std::move(first_party_summary));
+}
+
 void AdBlockBaseService::UpdateAdBlockClient(
-    std::unique_ptr<adblock::Engine> ad_block_client) {
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    std::unique_ptr<AdBlockFirstPartySummary> first_party_summary) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
   ad_block_client_ = std::move(ad_block_client);
+  SetFirstPartySummary(std::move(first_party_summary));
+  hidden_selector_cache_.Clear();
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  AdBlockDecisionCache::BumpEngineGeneration();
+}
+
+void AdBlockBaseService::SetFirstPartySummary(
+    std::unique_ptr<AdBlockFirstPartySummary> first_party_summary) {
+  base::AutoLock lock(first_party_summary_lock_);
+  first_party_summary_ = std::move(first_party_summary);
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -278,6 +540,13 @@ void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
 }
 
 bool AdBlockBaseService::Init() {
+  if (!snapshot_path_.empty()) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&LoadEngineSnapshot, snapshot_path_),
+        base::BindOnce(&AdBlockBaseService::OnGetEngineSnapshot,
+                       weak_factory_.GetWeakPtr()));
+  }
   return true;
 }
 
@@ -288,11 +557,14 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
   ad_block_client_.reset(new adblock::Engine(rules));
+  SetFirstPartySummary(AdBlockFirstPartySummary::FromRules(rules));
+  hidden_selector_cache_.Clear();
   AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
     resources_ = resources;
   }
   AddKnownResourcesToAdBlockInstance();
+  AdBlockDecisionCache::BumpEngineGeneration();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
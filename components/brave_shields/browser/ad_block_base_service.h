@@ -17,8 +17,13 @@
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
+#include "base/task_runner.h"
+#include "base/thread_annotations.h"
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_first_party_summary.h"
+#include "brave/components/brave_shields/browser/ad_block_hidden_selector_cache.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
@@ -33,12 +38,41 @@ class Engine;
 
 namespace brave_shields {
 
+// A network request checked as part of a batch. The match flags and
+// |mock_data_url| accumulate across engines, the same way the out-params of
+// ShouldStartRequest do.
+struct AdBlockRequest {
+  AdBlockRequest();
+  AdBlockRequest(const AdBlockRequest&);
+  ~AdBlockRequest();
+
+  // Fills |url_host| and |is_third_party| from |url| and |tab_host|. Call this
+  // once after setting them, so the engines in the chain don't each re-derive
+  // them.
+  void ComputeDerivedFields();
+
+  GURL url;
+  blink::mojom::ResourceType resource_type;
+  std::string tab_host;
+  bool aggressive_blocking = false;
+
+  std::string url_host;
+  bool is_third_party = false;
+
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+};
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
   using GetDATFileDataResult =
       brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
+  using GetMappedDATFileDataResult =
+      brave_component_updater::LoadMappedDATFileDataResult<adblock::Engine>;
 
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
@@ -55,6 +89,32 @@ class AdBlockBaseService : public BaseBraveShieldsService {
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
+  // Checks every request in |requests| with a single engine call. Requests
+  // that already matched an important rule are left untouched.
+  virtual void ShouldStartRequests(
+      const std::vector<AdBlockRequest*>& requests);
+  // Whether the current engine could match a first-party request to
+  // |request_host| from a page on |tab_host|, judged from the rules it was
+  // compiled from. Always true for engines loaded from a serialized DAT.
+  // Safe to call from any thread.
+  bool MayMatchFirstPartyRequest(const std::string& request_host,
+                                 const std::string& tab_host);
+  // Whether the current engine could have CSP directives for a document from
+  // |request_host| on |tab_host|, judged the same way. Safe to call from any
+  // thread.
+  bool MayHaveCspDirectives(const std::string& request_host,
+                            const std::string& tab_host);
+  // Keeps a copy of every engine this service loads from a serialized DAT at
+  // |snapshot_path|, and has Init() load the copy left by the previous run so
+  // requests are filtered before the component is ready. A fresh engine
+  // always replaces the snapshot one. Call before Start().
+  void EnableEngineSnapshot(const base::FilePath& snapshot_path);
+
+  // The size of the data the current engine was loaded from, which is as
+  // close as we can get to its memory use without asking adblock-rust. Only
+  // up to date on the UI thread.
+  size_t engine_data_size() const { return engine_data_size_; }
+
   void AddResources(const std::string& resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
@@ -76,20 +136,64 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void GetDATFileData(const base::FilePath& dat_file_path,
                       bool deserialize = true,
                       base::OnceClosure callback = base::DoNothing());
+  // Runs |load| on |task_runner| and swaps in the engine it returns, the same
+  // way GetDATFileData does for its built-in loaders.
+  void GetEngineData(scoped_refptr<base::TaskRunner> task_runner,
+                     base::OnceCallback<GetDATFileDataResult()> load,
+                     base::OnceClosure callback);
   void AddKnownTagsToAdBlockInstance();
   void AddKnownResourcesToAdBlockInstance();
   void ResetForTest(const std::string& rules, const std::string& resources);
 
+  // Swaps in |ad_block_client| on the task runner, re-applying known tags
+  // and resources. |first_party_summary| describes the rules it was compiled
+  // from, or is null when those aren't known.
+  void UpdateAdBlockClient(
+      std::unique_ptr<adblock::Engine> ad_block_client,
+      std::unique_ptr<AdBlockFirstPartySummary> first_party_summary);
+  // Same as above, summarizing |rules|, the list text |ad_block_client| was
+  // compiled from. An empty |rules| means the text isn't known.
+  void UpdateAdBlockClientWithRules(
+      std::unique_ptr<adblock::Engine> ad_block_client,
+      brave_component_updater::DATFileDataBuffer rules);
+  // Replaces the first-party summary; must accompany every engine swap.
+  void SetFirstPartySummary(
+      std::unique_ptr<AdBlockFirstPartySummary> first_party_summary);
+
   std::unique_ptr<adblock::Engine> ad_block_client_;
+  // Only used on the UI thread.
+  size_t engine_data_size_ = 0;
+  // Must be cleared whenever |ad_block_client_| is replaced.
+  AdBlockHiddenSelectorCache hidden_selector_cache_;
 
  private:
-  void UpdateAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client);
+  // |rules_are_text| is set when |result| holds the list text rather than a
+  // serialized engine.
   void OnGetDATFileData(base::OnceClosure callback,
+                        bool rules_are_text,
                         GetDATFileDataResult result);
+  void OnGetMappedDATFileData(base::OnceClosure callback,
+                              GetMappedDATFileDataResult result);
+  void OnAdBlockClientLoaded(
+      base::OnceClosure callback,
+      std::unique_ptr<adblock::Engine> ad_block_client,
+      brave_component_updater::DATFileDataBuffer rules);
+  void OnGetEngineSnapshot(GetMappedDATFileDataResult result);
+  // Runs |callback|, then copies |dat_file_path| to the snapshot.
+  void OnSnapshotSourceLoaded(const base::FilePath& dat_file_path,
+                              base::OnceClosure callback);
   void OnPreferenceChanges(const std::string& pref_name);
 
   std::set<std::string> tags_;
   std::string resources_;
+  base::FilePath snapshot_path_;
+  // Set once an engine other than the snapshot has been loaded, after which
+  // a late snapshot must not replace it.
+  bool has_fresh_engine_ = false;
+  base::Lock first_party_summary_lock_;
+  // Null when the engine came from a serialized DAT.
+  std::unique_ptr<AdBlockFirstPartySummary> first_party_summary_
+      GUARDED_BY(first_party_summary_lock_);
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
@@ -7,6 +7,7 @@
 
 #include "base/logging.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_service.h"
@@ -55,6 +56,9 @@ void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
   ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+  SetFirstPartySummary(AdBlockFirstPartySummary::FromRules(custom_filters));
+  hidden_selector_cache_.Clear();
+  AdBlockDecisionCache::BumpEngineGeneration();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
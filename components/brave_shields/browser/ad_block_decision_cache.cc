@@ -0,0 +1,104 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include <atomic>
+
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::atomic<uint64_t> g_engine_generation{0};
+
+std::string MakeKey(const GURL& url,
+                    blink::mojom::ResourceType resource_type,
+                    const std::string& tab_host,
+                    bool aggressive_blocking) {
+  std::string key;
+  key.reserve(url.spec().size() + tab_host.size() + 8);
+  key.append(base::NumberToString(static_cast<int>(resource_type)));
+  key.push_back(aggressive_blocking ? 'a' : 's');
+  key.append(tab_host);
+  key.push_back(' ');
+  key.append(url.spec());
+  return key;
+}
+
+}  // namespace
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t max_size)
+    : decisions_(max_size), generation_(g_engine_generation.load()) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() = default;
+
+// static
+void AdBlockDecisionCache::BumpEngineGeneration() {
+  g_engine_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+// static
+uint64_t AdBlockDecisionCache::GetEngineGeneration() {
+  return g_engine_generation.load(std::memory_order_relaxed);
+}
+
+bool AdBlockDecisionCache::MaybeInvalidate() {
+  const uint64_t generation =
+      g_engine_generation.load(std::memory_order_relaxed);
+  if (generation == generation_)
+    return true;
+  decisions_.Clear();
+  generation_ = generation;
+  return false;
+}
+
+void AdBlockDecisionCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  decisions_.Clear();
+}
+
+bool AdBlockDecisionCache::Get(const GURL& url,
+                               blink::mojom::ResourceType resource_type,
+                               const std::string& tab_host,
+                               bool aggressive_blocking,
+                               Decision* decision) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  MaybeInvalidate();
+
+  auto it =
+      decisions_.Get(MakeKey(url, resource_type, tab_host, aggressive_blocking));
+  const bool hit = it != decisions_.end();
+  UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.DecisionCacheHit", hit);
+  if (!hit)
+    return false;
+
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.Adblock.DecisionCacheSavedTime", it->second.lookup_time,
+      base::TimeDelta::FromMicroseconds(1), base::TimeDelta::FromSeconds(1),
+      50);
+  *decision = it->second;
+  return true;
+}
+
+void AdBlockDecisionCache::Put(const GURL& url,
+                               blink::mojom::ResourceType resource_type,
+                               const std::string& tab_host,
+                               bool aggressive_blocking,
+                               const Decision& decision) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // If the engines changed since the lookup started, |decision| may already
+  // be stale, so don't keep it.
+  if (!MaybeInvalidate())
+    return;
+  decisions_.Put(MakeKey(url, resource_type, tab_host, aggressive_blocking),
+                 decision);
+}
+
+}  // namespace brave_shields
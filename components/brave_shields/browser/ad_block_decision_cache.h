@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+// Remembers the combined result of checking a request against all adblock
+// engines, keyed on (url, resource type, tab host, aggressive blocking).
+//
+// The cache is only touched from the adblock task runner, so unlike
+// HTTPSERecentlyUsedCache it needs no lock at all. Entries are tied to a
+// process-wide engine generation which is bumped whenever an engine is
+// swapped or its tags/resources change; a generation mismatch drops the
+// whole cache on the next access.
+class AdBlockDecisionCache {
+ public:
+  struct Decision {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+    // How long the uncached engine lookup took, reported as saved time on
+    // every later hit.
+    base::TimeDelta lookup_time;
+  };
+
+  explicit AdBlockDecisionCache(size_t max_size = 1000);
+  ~AdBlockDecisionCache();
+
+  // Invalidates every cached decision in every cache. Safe to call from any
+  // thread.
+  static void BumpEngineGeneration();
+  // Returns the current engine generation, for other caches of engine
+  // output that need the same invalidation.
+  static uint64_t GetEngineGeneration();
+
+  bool Get(const GURL& url,
+           blink::mojom::ResourceType resource_type,
+           const std::string& tab_host,
+           bool aggressive_blocking,
+           Decision* decision);
+  void Put(const GURL& url,
+           blink::mojom::ResourceType resource_type,
+           const std::string& tab_host,
+           bool aggressive_blocking,
+           const Decision& decision);
+
+  void Clear();
+
+  size_t size() const { return decisions_.size(); }
+
+ private:
+  // Clears the cache if the engine generation moved on. Returns false when
+  // that happened.
+  bool MaybeInvalidate();
+
+  base::MRUCache<std::string, Decision> decisions_;
+  uint64_t generation_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  AdBlockDecisionCache(const AdBlockDecisionCache&) = delete;
+  AdBlockDecisionCache& operator=(const AdBlockDecisionCache&) = delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
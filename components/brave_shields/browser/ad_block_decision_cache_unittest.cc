@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+TEST(AdBlockDecisionCacheTest, HitAndMiss) {
+  AdBlockDecisionCache cache(2);
+  const GURL url("https://tracker.example.com/pixel.gif");
+  AdBlockDecisionCache::Decision decision;
+  decision.did_match_rule = true;
+  decision.mock_data_url = "data:image/gif;base64,R0lGODlh";
+
+  EXPECT_FALSE(cache.Get(url, blink::mojom::ResourceType::kImage,
+                         "news.example.org", false, &decision));
+  cache.Put(url, blink::mojom::ResourceType::kImage, "news.example.org", false,
+            decision);
+
+  AdBlockDecisionCache::Decision cached;
+  ASSERT_TRUE(cache.Get(url, blink::mojom::ResourceType::kImage,
+                        "news.example.org", false, &cached));
+  EXPECT_TRUE(cached.did_match_rule);
+  EXPECT_FALSE(cached.did_match_exception);
+  EXPECT_EQ(cached.mock_data_url, decision.mock_data_url);
+
+  // Every part of the key matters.
+  EXPECT_FALSE(cache.Get(url, blink::mojom::ResourceType::kScript,
+                         "news.example.org", false, &cached));
+  EXPECT_FALSE(cache.Get(url, blink::mojom::ResourceType::kImage,
+                         "other.example.org", false, &cached));
+  EXPECT_FALSE(cache.Get(url, blink::mojom::ResourceType::kImage,
+                         "news.example.org", true, &cached));
+}
+
+TEST(AdBlockDecisionCacheTest, EvictsLeastRecentlyUsed) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecisionCache::Decision decision;
+  const GURL a("https://a.example.com/");
+  const GURL b("https://b.example.com/");
+  const GURL c("https://c.example.com/");
+  cache.Put(a, blink::mojom::ResourceType::kImage, "tab.com", false, decision);
+  cache.Put(b, blink::mojom::ResourceType::kImage, "tab.com", false, decision);
+  ASSERT_TRUE(cache.Get(a, blink::mojom::ResourceType::kImage, "tab.com",
+                        false, &decision));
+  cache.Put(c, blink::mojom::ResourceType::kImage, "tab.com", false, decision);
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_TRUE(cache.Get(a, blink::mojom::ResourceType::kImage, "tab.com",
+                        false, &decision));
+  EXPECT_FALSE(cache.Get(b, blink::mojom::ResourceType::kImage, "tab.com",
+                         false, &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, InvalidatedByEngineGeneration) {
+  AdBlockDecisionCache cache;
+  AdBlockDecisionCache::Decision decision;
+  const GURL url("https://tracker.example.com/");
+  EXPECT_FALSE(cache.Get(url, blink::mojom::ResourceType::kXhr, "tab.com",
+                         false, &decision));
+  cache.Put(url, blink::mojom::ResourceType::kXhr, "tab.com", false, decision);
+  ASSERT_TRUE(cache.Get(url, blink::mojom::ResourceType::kXhr, "tab.com",
+                        false, &decision));
+
+  AdBlockDecisionCache::BumpEngineGeneration();
+  EXPECT_FALSE(cache.Get(url, blink::mojom::ResourceType::kXhr, "tab.com",
+                         false, &decision));
+  EXPECT_EQ(cache.size(), 0u);
+
+  // A decision computed before the bump must not be stored afterwards.
+  AdBlockDecisionCache::BumpEngineGeneration();
+  cache.Put(url, blink::mojom::ResourceType::kXhr, "tab.com", false, decision);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine_stats.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/feature_list.h"
+#include "base/trace_event/trace_event.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/common/features.h"
+
+namespace brave_shields {
+
+namespace {
+
+bool IsMatched(const AdBlockRequest* request) {
+  return request->did_match_rule || request->did_match_exception ||
+         request->did_match_important;
+}
+
+}  // namespace
+
+AdBlockEngineStats::ScopedSample::~ScopedSample() {
+  if (engine_.empty())
+    return;
+  TRACE_EVENT_END0("browser", "AdBlockEngine::ShouldStartRequest");
+  const bool matched = !matched_before_ && Matched();
+  GetInstance()->Record(engine_, base::TimeTicks::Now() - start_, 1,
+                        matched ? 1 : 0);
+}
+
+void AdBlockEngineStats::ScopedSample::Begin(std::string engine) {
+  engine_ = std::move(engine);
+  TRACE_EVENT_BEGIN1("browser", "AdBlockEngine::ShouldStartRequest", "engine",
+                     engine_);
+  matched_before_ = Matched();
+  start_ = base::TimeTicks::Now();
+}
+
+bool AdBlockEngineStats::ScopedSample::Matched() const {
+  return (did_match_rule_ && *did_match_rule_) ||
+         (did_match_exception_ && *did_match_exception_) ||
+         (did_match_important_ && *did_match_important_);
+}
+
+AdBlockEngineStats::ScopedBatchSample::~ScopedBatchSample() {
+  if (engine_.empty())
+    return;
+  TRACE_EVENT_END0("browser", "AdBlockEngine::ShouldStartRequests");
+  GetInstance()->Record(engine_, base::TimeTicks::Now() - start_,
+                        requests_.size(), CountMatched() - matched_before_);
+}
+
+void AdBlockEngineStats::ScopedBatchSample::Begin(std::string engine) {
+  engine_ = std::move(engine);
+  TRACE_EVENT_BEGIN2("browser", "AdBlockEngine::ShouldStartRequests",
+                     "engine", engine_, "requests", requests_.size());
+  matched_before_ = CountMatched();
+  start_ = base::TimeTicks::Now();
+}
+
+size_t AdBlockEngineStats::ScopedBatchSample::CountMatched() const {
+  return std::count_if(requests_.begin(), requests_.end(), IsMatched);
+}
+
+// static
+AdBlockEngineStats* AdBlockEngineStats::GetInstance() {
+  static base::NoDestructor<AdBlockEngineStats> instance;
+  return instance.get();
+}
+
+AdBlockEngineStats::AdBlockEngineStats()
+    : enabled_(
+          base::FeatureList::IsEnabled(features::kBraveAdblockEngineStats)),
+      sample_rate_(static_cast<uint32_t>(
+          std::max(1, features::kBraveAdblockEngineStatsSampleRate.Get()))) {}
+
+AdBlockEngineStats::~AdBlockEngineStats() = default;
+
+// static
+bool AdBlockEngineStats::IsTracing() {
+  bool enabled = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED("browser", &enabled);
+  return enabled;
+}
+
+bool AdBlockEngineStats::ShouldSample() {
+  if (!enabled_)
+    return false;
+  return counter_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ == 0;
+}
+
+void AdBlockEngineStats::Record(const std::string& engine,
+                                base::TimeDelta elapsed,
+                                size_t requests,
+                                size_t matches) {
+  base::AutoLock lock(lock_);
+  Entry& entry = entries_[engine];
+  entry.samples++;
+  entry.requests += requests;
+  entry.matches += matches;
+  entry.total_time += elapsed;
+  entry.max_time = std::max(entry.max_time, elapsed);
+}
+
+base::Value AdBlockEngineStats::GetStats() const {
+  base::Value list(base::Value::Type::LIST);
+  base::AutoLock lock(lock_);
+  for (const auto& it : entries_) {
+    const Entry& entry = it.second;
+    base::Value dict(base::Value::Type::DICTIONARY);
+    dict.SetStringKey("engine", it.first);
+    dict.SetDoubleKey("samples", static_cast<double>(entry.samples));
+    dict.SetDoubleKey("requests", static_cast<double>(entry.requests));
+    dict.SetDoubleKey("matches", static_cast<double>(entry.matches));
+    dict.SetDoubleKey("total_time_ms", entry.total_time.InMillisecondsF());
+    dict.SetDoubleKey("mean_time_us",
+                      entry.requests ? entry.total_time.InMicrosecondsF() /
+                                           entry.requests
+                                     : 0);
+    dict.SetDoubleKey("max_time_us", entry.max_time.InMicrosecondsF());
+    list.Append(std::move(dict));
+  }
+  return list;
+}
+
+void AdBlockEngineStats::Reset() {
+  base::AutoLock lock(lock_);
+  entries_.clear();
+}
+
+}  // namespace brave_shields
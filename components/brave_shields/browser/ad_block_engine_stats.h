@@ -0,0 +1,137 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_STATS_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_STATS_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace brave_shields {
+
+struct AdBlockRequest;
+
+// Attributes adblock matching time and match counts to the individual
+// engines: the default list, each regional list and subscription, and the
+// custom filters. The Brave.Adblock.ShouldBlockRequest histogram only covers
+// all of them together.
+//
+// Only one in |sample_rate| engine checks is timed, so the cost of an
+// unsampled check is one atomic increment. Every check is also a trace event
+// in the "browser" category, named after the engine. brave://adblock shows
+// the collected numbers.
+class AdBlockEngineStats {
+ public:
+  struct Entry {
+    uint64_t samples = 0;
+    uint64_t requests = 0;
+    uint64_t matches = 0;
+    base::TimeDelta total_time;
+    base::TimeDelta max_time;
+  };
+
+  // Times one engine check of a single request, if it is sampled.
+  class ScopedSample {
+   public:
+    // |engine| is only called when the check is sampled or traced.
+    template <typename EngineName>
+    ScopedSample(EngineName engine,
+                 const bool* did_match_rule,
+                 const bool* did_match_exception,
+                 const bool* did_match_important)
+        : did_match_rule_(did_match_rule),
+          did_match_exception_(did_match_exception),
+          did_match_important_(did_match_important) {
+      if (GetInstance()->ShouldSample() || IsTracing())
+        Begin(engine());
+    }
+    ~ScopedSample();
+
+   private:
+    void Begin(std::string engine);
+    bool Matched() const;
+
+    const bool* did_match_rule_;
+    const bool* did_match_exception_;
+    const bool* did_match_important_;
+    std::string engine_;
+    bool matched_before_ = false;
+    base::TimeTicks start_;
+
+    ScopedSample(const ScopedSample&) = delete;
+    ScopedSample& operator=(const ScopedSample&) = delete;
+  };
+
+  // Times one engine check of a batch of requests, if it is sampled.
+  class ScopedBatchSample {
+   public:
+    template <typename EngineName>
+    ScopedBatchSample(EngineName engine,
+                      const std::vector<AdBlockRequest*>& requests)
+        : requests_(requests) {
+      if (GetInstance()->ShouldSample() || IsTracing())
+        Begin(engine());
+    }
+    ~ScopedBatchSample();
+
+   private:
+    void Begin(std::string engine);
+    size_t CountMatched() const;
+
+    const std::vector<AdBlockRequest*>& requests_;
+    std::string engine_;
+    size_t matched_before_ = 0;
+    base::TimeTicks start_;
+
+    ScopedBatchSample(const ScopedBatchSample&) = delete;
+    ScopedBatchSample& operator=(const ScopedBatchSample&) = delete;
+  };
+
+  static AdBlockEngineStats* GetInstance();
+
+  // Returns whether the next engine check should be timed. Always false when
+  // kBraveAdblockEngineStats is disabled.
+  bool ShouldSample();
+
+  void Record(const std::string& engine,
+              base::TimeDelta elapsed,
+              size_t requests,
+              size_t matches);
+
+  // Returns a list with one dictionary per engine, in engine name order.
+  base::Value GetStats() const;
+  void Reset();
+
+ private:
+  friend class base::NoDestructor<AdBlockEngineStats>;
+
+  AdBlockEngineStats();
+  ~AdBlockEngineStats();
+
+  static bool IsTracing();
+
+  const bool enabled_;
+  const uint32_t sample_rate_;
+  std::atomic<uint32_t> counter_{0};
+
+  mutable base::Lock lock_;
+  base::flat_map<std::string, Entry> entries_;
+
+  AdBlockEngineStats(const AdBlockEngineStats&) = delete;
+  AdBlockEngineStats& operator=(const AdBlockEngineStats&) = delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_STATS_H_
@@ -0,0 +1,198 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_first_party_summary.h"
+
+#include <utility>
+
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+
+namespace brave_shields {
+
+namespace {
+
+bool IsCosmeticRule(base::StringPiece rule) {
+  return rule.find("##") != base::StringPiece::npos ||
+         rule.find("#@#") != base::StringPiece::npos ||
+         rule.find("#?#") != base::StringPiece::npos ||
+         rule.find("#@?#") != base::StringPiece::npos ||
+         rule.find("#$#") != base::StringPiece::npos ||
+         rule.find("#@$#") != base::StringPiece::npos;
+}
+
+// Options are only trusted when every one of them looks like an option, so a
+// literal '$' inside a pattern isn't mistaken for the option separator.
+bool IsOption(base::StringPiece option) {
+  base::StringPiece name = option.substr(0, option.find('='));
+  if (base::StartsWith(name, "~"))
+    name.remove_prefix(1);
+  if (name.empty())
+    return false;
+  for (char c : name) {
+    if (!base::IsAsciiLower(c) && !base::IsAsciiDigit(c) && c != '-')
+      return false;
+  }
+  return true;
+}
+
+// Returns the host of a ||host^ or ||host/ anchored pattern, or an empty
+// string when the pattern could match more than one host.
+std::string GetAnchoredHost(base::StringPiece pattern) {
+  if (!base::StartsWith(pattern, "||"))
+    return std::string();
+  pattern.remove_prefix(2);
+  const size_t end = pattern.find_first_of("^/*|$:?");
+  if (end == base::StringPiece::npos || end == 0)
+    return std::string();
+  if (pattern[end] != '^' && pattern[end] != '/')
+    return std::string();
+  base::StringPiece host = pattern.substr(0, end);
+  if (base::EndsWith(host, "."))
+    return std::string();
+  return base::ToLowerASCII(host);
+}
+
+bool HasHostOrParent(const base::flat_set<std::string>& hosts,
+                     base::StringPiece host) {
+  while (!host.empty()) {
+    if (hosts.find(host) != hosts.end())
+      return true;
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+  return false;
+}
+
+}  // namespace
+
+AdBlockFirstPartySummary::HostDigest::HostDigest() = default;
+
+AdBlockFirstPartySummary::HostDigest::~HostDigest() = default;
+
+void AdBlockFirstPartySummary::HostDigest::AddRule(
+    base::StringPiece pattern,
+    const std::vector<base::StringPiece>& options) {
+  const size_t tab_hosts_before = pending_tab_hosts.size();
+  for (base::StringPiece option : options) {
+    if (!base::StartsWith(option, "domain="))
+      continue;
+    for (base::StringPiece domain :
+         base::SplitStringPiece(option.substr(7), "|", base::TRIM_WHITESPACE,
+                                base::SPLIT_WANT_NONEMPTY)) {
+      // Negated domains don't narrow where the rule applies, and entity
+      // wildcards like example.* can't be looked up by host.
+      if (base::StartsWith(domain, "~"))
+        continue;
+      if (domain.find('*') != base::StringPiece::npos) {
+        matches_any_host = true;
+        return;
+      }
+      pending_tab_hosts.push_back(base::ToLowerASCII(domain));
+    }
+  }
+  if (pending_tab_hosts.size() != tab_hosts_before)
+    return;
+
+  std::string host = GetAnchoredHost(pattern);
+  if (host.empty()) {
+    matches_any_host = true;
+    return;
+  }
+  pending_request_hosts.push_back(std::move(host));
+}
+
+void AdBlockFirstPartySummary::HostDigest::Finalize() {
+  request_hosts = base::flat_set<std::string>(std::move(pending_request_hosts));
+  tab_hosts = base::flat_set<std::string>(std::move(pending_tab_hosts));
+  pending_request_hosts.clear();
+  pending_tab_hosts.clear();
+}
+
+bool AdBlockFirstPartySummary::HostDigest::MayMatch(
+    const std::string& request_host,
+    const std::string& tab_host) const {
+  return matches_any_host || HasHostOrParent(request_hosts, request_host) ||
+         HasHostOrParent(tab_hosts, tab_host);
+}
+
+AdBlockFirstPartySummary::AdBlockFirstPartySummary() = default;
+
+AdBlockFirstPartySummary::~AdBlockFirstPartySummary() = default;
+
+// static
+std::unique_ptr<AdBlockFirstPartySummary> AdBlockFirstPartySummary::FromRules(
+    base::StringPiece rules) {
+  auto summary = std::make_unique<AdBlockFirstPartySummary>();
+  for (base::StringPiece line : base::SplitStringPiece(
+           rules, "\r\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    summary->AddRule(line);
+    // Nothing later in the list can narrow the summary down again.
+    if (summary->blocking_.matches_any_host && summary->csp_.matches_any_host)
+      break;
+  }
+  summary->blocking_.Finalize();
+  summary->csp_.Finalize();
+  return summary;
+}
+
+void AdBlockFirstPartySummary::AddRule(base::StringPiece rule) {
+  if (base::StartsWith(rule, "!") || base::StartsWith(rule, "[") ||
+      IsCosmeticRule(rule)) {
+    return;
+  }
+  // Exceptions can only ever unblock requests or drop directives.
+  if (base::StartsWith(rule, "@@"))
+    return;
+
+  base::StringPiece pattern = rule;
+  std::vector<base::StringPiece> options;
+  const size_t options_start = rule.rfind('$');
+  if (options_start != base::StringPiece::npos) {
+    options = base::SplitStringPiece(rule.substr(options_start + 1), ",",
+                                     base::TRIM_WHITESPACE,
+                                     base::SPLIT_WANT_NONEMPTY);
+    bool all_options = !options.empty();
+    for (base::StringPiece option : options)
+      all_options = all_options && IsOption(option);
+    if (all_options)
+      pattern = rule.substr(0, options_start);
+    else
+      options.clear();
+  }
+
+  bool third_party_only = false;
+  bool is_csp = false;
+  for (base::StringPiece option : options) {
+    if (option == "third-party" || option == "3p" || option == "badfilter")
+      third_party_only = true;
+    if (base::StartsWith(option, "csp="))
+      is_csp = true;
+  }
+
+  // $csp rules add directives rather than block, whoever the request is for.
+  if (is_csp) {
+    if (!csp_.matches_any_host)
+      csp_.AddRule(pattern, options);
+    return;
+  }
+  if (!third_party_only && !blocking_.matches_any_host)
+    blocking_.AddRule(pattern, options);
+}
+
+bool AdBlockFirstPartySummary::MayMatch(const std::string& request_host,
+                                        const std::string& tab_host) const {
+  return blocking_.MayMatch(request_host, tab_host);
+}
+
+bool AdBlockFirstPartySummary::MayHaveCspDirectives(
+    const std::string& request_host,
+    const std::string& tab_host) const {
+  return csp_.MayMatch(request_host, tab_host);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FIRST_PARTY_SUMMARY_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FIRST_PARTY_SUMMARY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// A conservative digest of the blocking rules in one filter list that can
+// apply to first-party requests. It can only ever say that no rule could
+// match, never that one does: every rule it can't prove is third-party only
+// or tied to specific hosts makes MayMatch() return true for every request.
+// The same pass also digests the list's $csp rules, which lets callers skip
+// asking the engine for CSP directives on pages none of them could touch.
+//
+// Engines loaded from a serialized DAT have no rule text to summarize, so
+// they have no summary at all and always have to be asked.
+class AdBlockFirstPartySummary {
+ public:
+  AdBlockFirstPartySummary();
+  ~AdBlockFirstPartySummary();
+
+  static std::unique_ptr<AdBlockFirstPartySummary> FromRules(
+      base::StringPiece rules);
+
+  // Whether some rule of the list could match a first-party request to
+  // |request_host| made from a page on |tab_host|.
+  bool MayMatch(const std::string& request_host,
+                const std::string& tab_host) const;
+
+  // Whether some $csp rule of the list could apply to a document from
+  // |request_host| loaded on |tab_host|, first- or third-party alike.
+  bool MayHaveCspDirectives(const std::string& request_host,
+                            const std::string& tab_host) const;
+
+  bool matches_any_host() const { return blocking_.matches_any_host; }
+
+ private:
+  // The hosts a group of rules is limited to.
+  struct HostDigest {
+    HostDigest();
+    ~HostDigest();
+
+    // Records where a rule with |pattern| and |options| can apply.
+    void AddRule(base::StringPiece pattern,
+                 const std::vector<base::StringPiece>& options);
+    // Moves the hosts collected by AddRule() into the flat sets.
+    void Finalize();
+    bool MayMatch(const std::string& request_host,
+                  const std::string& tab_host) const;
+
+    // Set by any rule that isn't limited to known request or tab hosts.
+    bool matches_any_host = false;
+    // Hosts from ||host^ anchored rules; the rule can only match requests to
+    // one of these hosts or their subdomains.
+    base::flat_set<std::string> request_hosts;
+    // Hosts from $domain= options; the rule can only match on pages from one
+    // of these hosts or their subdomains.
+    base::flat_set<std::string> tab_hosts;
+
+    std::vector<std::string> pending_request_hosts;
+    std::vector<std::string> pending_tab_hosts;
+  };
+
+  void AddRule(base::StringPiece rule);
+
+  HostDigest blocking_;
+  HostDigest csp_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_FIRST_PARTY_SUMMARY_H_
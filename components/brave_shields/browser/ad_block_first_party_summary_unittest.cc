@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_first_party_summary.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(AdBlockFirstPartySummaryTest, EmptyListMatchesNothing) {
+  auto summary = AdBlockFirstPartySummary::FromRules(
+      "! Title: nothing to block\n"
+      "[Adblock Plus 2.0]\n"
+      "example.com##.ad\n"
+      "@@||example.com/ads.js\n");
+  EXPECT_FALSE(summary->matches_any_host());
+  EXPECT_FALSE(summary->MayMatch("example.com", "example.com"));
+}
+
+TEST(AdBlockFirstPartySummaryTest, ThirdPartyRulesAreIgnored) {
+  auto summary = AdBlockFirstPartySummary::FromRules(
+      "/ad_banner.$third-party\n"
+      "||tracker.com^$script,3p\n");
+  EXPECT_FALSE(summary->MayMatch("example.com", "example.com"));
+}
+
+TEST(AdBlockFirstPartySummaryTest, AnchoredHosts) {
+  auto summary = AdBlockFirstPartySummary::FromRules(
+      "||ads.example.com^\n"
+      "||metrics.example.org/collect$image\n");
+  EXPECT_TRUE(summary->MayMatch("ads.example.com", "example.com"));
+  EXPECT_TRUE(summary->MayMatch("eu.ads.example.com", "example.com"));
+  EXPECT_TRUE(summary->MayMatch("metrics.example.org", "example.org"));
+  EXPECT_FALSE(summary->MayMatch("www.example.com", "www.example.com"));
+  EXPECT_FALSE(summary->MayMatch("example.org", "example.org"));
+}
+
+TEST(AdBlockFirstPartySummaryTest, DomainOptions) {
+  auto summary = AdBlockFirstPartySummary::FromRules(
+      "/banner/*$domain=news.example.com|~sports.example.com\n");
+  EXPECT_TRUE(summary->MayMatch("cdn.example.com", "news.example.com"));
+  EXPECT_TRUE(summary->MayMatch("cdn.example.com", "eu.news.example.com"));
+  EXPECT_FALSE(summary->MayMatch("cdn.example.com", "example.com"));
+
+  // Only negated domains still apply almost everywhere.
+  summary = AdBlockFirstPartySummary::FromRules(
+      "/banner/*$domain=~sports.example.com\n");
+  EXPECT_TRUE(summary->MayMatch("cdn.example.com", "example.com"));
+}
+
+TEST(AdBlockFirstPartySummaryTest, UnrestrictedRules) {
+  for (const char* rules :
+       {"/ad_banner.\n", "||ads.\n", "||example.com\n", "|https://ads.\n",
+        "/^https?:\\/\\/ads\\./\n", "/ads$/$domain=ex*.com\n",
+        "||ads.example.com^$domain=example.*\n"}) {
+    auto summary = AdBlockFirstPartySummary::FromRules(rules);
+    EXPECT_TRUE(summary->matches_any_host()) << rules;
+    EXPECT_TRUE(summary->MayMatch("example.com", "example.com")) << rules;
+  }
+}
+
+TEST(AdBlockFirstPartySummaryTest, CspRules) {
+  auto summary = AdBlockFirstPartySummary::FromRules(
+      "||ads.example.com^\n"
+      "||news.example.com^$csp=script-src 'self'\n"
+      "$csp=worker-src 'none',domain=video.example.org|~eu.example.org\n"
+      "@@||example.net^$csp\n");
+  EXPECT_TRUE(summary->MayHaveCspDirectives("news.example.com", "a.com"));
+  EXPECT_TRUE(summary->MayHaveCspDirectives("a.com", "video.example.org"));
+  EXPECT_FALSE(summary->MayHaveCspDirectives("ads.example.com", "a.com"));
+  EXPECT_FALSE(summary->MayHaveCspDirectives("example.net", "example.net"));
+
+  // $csp rules never block, and blocking rules never add directives.
+  EXPECT_FALSE(summary->MayMatch("news.example.com", "news.example.com"));
+  EXPECT_TRUE(summary->MayMatch("ads.example.com", "example.com"));
+
+  // Third-party $csp rules still apply to third-party frames.
+  summary = AdBlockFirstPartySummary::FromRules("$csp=img-src 'none',3p\n");
+  EXPECT_TRUE(summary->MayHaveCspDirectives("a.com", "b.com"));
+  EXPECT_FALSE(summary->matches_any_host());
+}
+
+}  // namespace brave_shields
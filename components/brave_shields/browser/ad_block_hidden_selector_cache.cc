@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_hidden_selector_cache.h"
+
+#include "base/strings/strcat.h"
+
+namespace brave_shields {
+
+namespace {
+
+void FilterWithPrefix(const std::unordered_set<std::string>& misses,
+                      const char* prefix,
+                      const std::vector<std::string>& input,
+                      std::vector<std::string>* output) {
+  std::string key;
+  for (const std::string& value : input) {
+    key = base::StrCat({prefix, value});
+    if (misses.find(key) == misses.end())
+      output->push_back(value);
+  }
+}
+
+}  // namespace
+
+AdBlockHiddenSelectorCache::AdBlockHiddenSelectorCache(size_t max_size)
+    : max_size_(max_size) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+AdBlockHiddenSelectorCache::~AdBlockHiddenSelectorCache() = default;
+
+void AdBlockHiddenSelectorCache::FilterKnownMisses(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    std::vector<std::string>* unknown_classes,
+    std::vector<std::string>* unknown_ids) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FilterWithPrefix(misses_, ".", classes, unknown_classes);
+  FilterWithPrefix(misses_, "#", ids, unknown_ids);
+}
+
+void AdBlockHiddenSelectorCache::AddMisses(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Pages with generated class names would otherwise grow this without
+  // bound; starting over is cheap since misses are relearned on demand.
+  if (misses_.size() + classes.size() + ids.size() > max_size_)
+    misses_.clear();
+  for (const std::string& value : classes)
+    misses_.insert(base::StrCat({".", value}));
+  for (const std::string& value : ids)
+    misses_.insert(base::StrCat({"#", value}));
+}
+
+void AdBlockHiddenSelectorCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  misses_.clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,59 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_HIDDEN_SELECTOR_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_HIDDEN_SELECTOR_CACHE_H_
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/sequence_checker.h"
+
+namespace brave_shields {
+
+// Remembers the classes and ids for which a single engine has no generic
+// hide rules, so repeated HiddenClassIdSelectors calls from DOM-heavy pages
+// can skip the engine entirely once only known misses are left.
+//
+// Entries are exact strings: a false "known miss" would let an element that
+// should be hidden through, so a probabilistic filter isn't an option here.
+// Like AdBlockDecisionCache it lives on the adblock task runner and needs no
+// lock. The owner has to Clear() it whenever the engine is replaced.
+class AdBlockHiddenSelectorCache {
+ public:
+  explicit AdBlockHiddenSelectorCache(size_t max_size = 10000);
+  ~AdBlockHiddenSelectorCache();
+
+  // Copies the entries of |classes| and |ids| that aren't known misses into
+  // |unknown_classes| and |unknown_ids|.
+  void FilterKnownMisses(const std::vector<std::string>& classes,
+                         const std::vector<std::string>& ids,
+                         std::vector<std::string>* unknown_classes,
+                         std::vector<std::string>* unknown_ids) const;
+  // Records every entry of |classes| and |ids| as a miss. Only call this
+  // after the engine returned no selectors for them with no exceptions
+  // applied.
+  void AddMisses(const std::vector<std::string>& classes,
+                 const std::vector<std::string>& ids);
+  void Clear();
+
+  size_t size() const { return misses_.size(); }
+
+ private:
+  const size_t max_size_;
+  // Classes are stored with a "." prefix and ids with a "#" prefix.
+  std::unordered_set<std::string> misses_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  AdBlockHiddenSelectorCache(const AdBlockHiddenSelectorCache&) = delete;
+  AdBlockHiddenSelectorCache& operator=(const AdBlockHiddenSelectorCache&) =
+      delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_HIDDEN_SELECTOR_CACHE_H_
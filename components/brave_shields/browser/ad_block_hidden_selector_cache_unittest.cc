@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_hidden_selector_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(AdBlockHiddenSelectorCacheTest, FiltersKnownMisses) {
+  AdBlockHiddenSelectorCache cache;
+  cache.AddMisses({"article", "header"}, {"main"});
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  cache.FilterKnownMisses({"article", "banner-ad"}, {"main", "sponsored"},
+                          &classes, &ids);
+  EXPECT_EQ(classes, std::vector<std::string>({"banner-ad"}));
+  EXPECT_EQ(ids, std::vector<std::string>({"sponsored"}));
+}
+
+TEST(AdBlockHiddenSelectorCacheTest, ClassesAndIdsAreSeparate) {
+  AdBlockHiddenSelectorCache cache;
+  cache.AddMisses({"ad"}, {});
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  cache.FilterKnownMisses({"ad"}, {"ad"}, &classes, &ids);
+  EXPECT_TRUE(classes.empty());
+  EXPECT_EQ(ids, std::vector<std::string>({"ad"}));
+}
+
+TEST(AdBlockHiddenSelectorCacheTest, ClearsWhenFull) {
+  AdBlockHiddenSelectorCache cache(3);
+  cache.AddMisses({"a", "b"}, {"c"});
+  EXPECT_EQ(cache.size(), 3u);
+  cache.AddMisses({"d"}, {});
+  EXPECT_EQ(cache.size(), 1u);
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  cache.FilterKnownMisses({"a", "d"}, {}, &classes, &ids);
+  EXPECT_EQ(classes, std::vector<std::string>({"a"}));
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+}  // namespace brave_shields
@@ -17,12 +17,16 @@
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 
 namespace brave_shields {
 
@@ -69,10 +73,11 @@ bool AdBlockRegionalService::Init() {
 void AdBlockRegionalService::OnComponentReady(const std::string& component_id,
                                               const base::FilePath& install_dir,
                                               const std::string& manifest) {
-  base::FilePath dat_file_path =
-      install_dir.AppendASCII(std::string("rs-") + uuid_)
-          .AddExtension(FILE_PATH_LITERAL(".dat"));
-  GetDATFileData(dat_file_path);
+  dat_file_path_ = install_dir.AppendASCII(std::string("rs-") + uuid_)
+                       .AddExtension(FILE_PATH_LITERAL(".dat"));
+  // The new version replaces an unloaded engine as well.
+  reload_timer_.Stop();
+  GetDATFileData(dat_file_path_);
   base::FilePath resources_file_path =
       install_dir.AppendASCII(kAdBlockResourcesFilename);
 
@@ -89,6 +94,90 @@ void AdBlockRegionalService::OnResourcesFileDataReady(
   resoures_file_ready_callback_.Run(resources);
 }
 
+void AdBlockRegionalService::ShouldStartRequest(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
+  // The flags may already be set by an earlier engine in the chain, so only
+  // a change counts as a match of this one.
+  auto matched = [&] {
+    return (did_match_rule && *did_match_rule) ||
+           (did_match_exception && *did_match_exception);
+  };
+  const bool matched_before = matched();
+  AdBlockBaseService::ShouldStartRequest(
+      url, resource_type, tab_host, aggressive_blocking, did_match_rule,
+      did_match_exception, did_match_important, mock_data_url);
+  if (!matched_before && matched())
+    last_match_time_ = base::TimeTicks::Now();
+}
+
+void AdBlockRegionalService::ShouldStartRequests(
+    const std::vector<AdBlockRequest*>& requests) {
+  size_t matched_before = 0;
+  for (const AdBlockRequest* request : requests) {
+    if (request->did_match_rule || request->did_match_exception)
+      matched_before++;
+  }
+  AdBlockBaseService::ShouldStartRequests(requests);
+  size_t matched_after = 0;
+  for (const AdBlockRequest* request : requests) {
+    if (request->did_match_rule || request->did_match_exception)
+      matched_after++;
+  }
+  if (matched_after != matched_before)
+    last_match_time_ = base::TimeTicks::Now();
+}
+
+void AdBlockRegionalService::UnloadEngineIfIdle(base::TimeDelta idle_time,
+                                                base::TimeDelta reload_delay) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (dat_file_path_.empty() || reload_timer_.IsRunning())
+    return;
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockRegionalService::UnloadEngineIfIdleOnTaskRunner,
+                     base::Unretained(this), idle_time, reload_delay));
+}
+
+void AdBlockRegionalService::UnloadEngineIfIdleOnTaskRunner(
+    base::TimeDelta idle_time,
+    base::TimeDelta reload_delay) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (!last_match_time_.is_null() && now - last_match_time_ < idle_time)
+    return;
+
+  // An empty engine still takes the known tags and resources, so reloading
+  // needs nothing but the DAT file. Nothing is known about its rules.
+  UpdateAdBlockClient(std::make_unique<adblock::Engine>(),
+                      std::unique_ptr<AdBlockFirstPartySummary>());
+  // Gives the reloaded engine a full idle period of its own.
+  last_match_time_ = now;
+  base::PostTask(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&AdBlockRegionalService::OnEngineUnloaded,
+                     weak_factory_.GetWeakPtr(), reload_delay));
+}
+
+void AdBlockRegionalService::OnEngineUnloaded(base::TimeDelta reload_delay) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  engine_data_size_ = 0;
+  reload_timer_.Start(FROM_HERE, reload_delay,
+                      base::BindOnce(&AdBlockRegionalService::ReloadEngine,
+                                     base::Unretained(this)));
+}
+
+void AdBlockRegionalService::ReloadEngine() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  GetDATFileData(dat_file_path_);
+}
+
 // static
 void AdBlockRegionalService::SetComponentIdAndBase64PublicKeyForTest(
     const std::string& component_id,
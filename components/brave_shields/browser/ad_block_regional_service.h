@@ -14,6 +14,8 @@
 
 #include "base/callback.h"
 #include "base/files/file_path.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
@@ -39,12 +41,33 @@ class AdBlockRegionalService : public AdBlockBaseService {
   std::string GetUUID() const { return uuid_; }
   std::string GetTitle() const { return title_; }
 
+  void ShouldStartRequest(const GURL& url,
+                          blink::mojom::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool aggressive_blocking,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* mock_data_url) override;
+  void ShouldStartRequests(
+      const std::vector<AdBlockRequest*>& requests) override;
+
+  // Swaps the engine for an empty one if none of its rules matched within
+  // |idle_time|, and loads it again from the component after |reload_delay|.
+  // Does nothing before the component is ready.
+  void UnloadEngineIfIdle(base::TimeDelta idle_time,
+                          base::TimeDelta reload_delay);
+
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
                         const std::string& manifest) override;
   void OnResourcesFileDataReady(const std::string& resources);
+  void UnloadEngineIfIdleOnTaskRunner(base::TimeDelta idle_time,
+                                      base::TimeDelta reload_delay);
+  void OnEngineUnloaded(base::TimeDelta reload_delay);
+  void ReloadEngine();
 
  private:
   friend class ::AdBlockServiceTest;
@@ -61,6 +84,13 @@ class AdBlockRegionalService : public AdBlockBaseService {
   std::string title_;
   std::string component_id_;
   std::string base64_public_key_;
+  base::FilePath dat_file_path_;
+
+  // Only used on the task runner.
+  base::TimeTicks last_match_time_;
+
+  // Running while the engine is unloaded.
+  base::OneShotTimer reload_timer_;
 
   base::WeakPtrFactory<AdBlockRegionalService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalService);
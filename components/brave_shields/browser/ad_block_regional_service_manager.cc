@@ -13,6 +13,8 @@
 #include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_stats.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
@@ -26,6 +28,15 @@ using adblock::FilterList;
 
 namespace brave_shields {
 
+namespace {
+
+// A regional list whose rules haven't matched for this long is unloaded
+// under critical memory pressure, and loaded again after the same delay.
+constexpr base::TimeDelta kRegionalEngineIdleTime =
+    base::TimeDelta::FromHours(1);
+
+}  // namespace
+
 AdBlockRegionalServiceManager::AdBlockRegionalServiceManager(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : delegate_(delegate),
@@ -35,6 +46,26 @@ AdBlockRegionalServiceManager::AdBlockRegionalServiceManager(
 AdBlockRegionalServiceManager::~AdBlockRegionalServiceManager() {
 }
 
+void AdBlockRegionalServiceManager::SetEngineSnapshotDir(
+    const base::FilePath& snapshot_dir) {
+  snapshot_dir_ = snapshot_dir;
+}
+
+std::unique_ptr<AdBlockRegionalService>
+AdBlockRegionalServiceManager::CreateRegionalService(
+    const adblock::FilterList& catalog_entry) {
+  auto regional_service = AdBlockRegionalServiceFactory(
+      catalog_entry, delegate_,
+      base::BindRepeating(&AdBlockRegionalServiceManager::AddResources,
+                          base::Unretained(this)));
+  if (!snapshot_dir_.empty()) {
+    regional_service->EnableEngineSnapshot(
+        snapshot_dir_.AppendASCII("rs-" + catalog_entry.uuid)
+            .AddExtension(FILE_PATH_LITERAL(".dat")));
+  }
+  return regional_service;
+}
+
 void AdBlockRegionalServiceManager::StartRegionalServices() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   PrefService* local_state = delegate_->local_state();
@@ -74,10 +105,7 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
       auto catalog_entry = brave_shields::FindAdBlockFilterListByUUID(
           regional_catalog_, uuid);
       if (catalog_entry != regional_catalog_.end()) {
-        auto regional_service = AdBlockRegionalServiceFactory(
-            *catalog_entry, delegate_,
-            base::BindRepeating(&AdBlockRegionalServiceManager::AddResources,
-                                base::Unretained(this)));
+        auto regional_service = CreateRegionalService(*catalog_entry);
         regional_service->Start();
         regional_services_.insert(
             std::make_pair(uuid, std::move(regional_service)));
@@ -85,9 +113,26 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
     }
   }
 
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE,
+      base::BindRepeating(&AdBlockRegionalServiceManager::OnMemoryPressure,
+                          base::Unretained(this)));
+
   initialized_ = true;
 }
 
+void AdBlockRegionalServiceManager::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (level != base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL)
+    return;
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    regional_service.second->UnloadEngineIfIdle(kRegionalEngineIdleTime,
+                                                kRegionalEngineIdleTime);
+  }
+}
+
 void AdBlockRegionalServiceManager::UpdateFilterListPrefs(
     const std::string& uuid,
     bool enabled) {
@@ -130,6 +175,9 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
   base::AutoLock lock(regional_services_lock_);
 
   for (const auto& regional_service : regional_services_) {
+    AdBlockEngineStats::ScopedSample sample(
+        [&] { return "regional:" + regional_service.first; }, did_match_rule,
+        did_match_exception, did_match_important);
     regional_service.second->ShouldStartRequest(
         url, resource_type, tab_host, aggressive_blocking, did_match_rule,
         did_match_exception, did_match_important, mock_data_url);
@@ -139,6 +187,51 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockRegionalServiceManager::ShouldStartRequests(
+    const std::vector<AdBlockRequest*>& requests) {
+  if (!IsInitialized())
+    return;
+
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    AdBlockEngineStats::ScopedBatchSample sample(
+        [&] { return "regional:" + regional_service.first; }, requests);
+    regional_service.second->ShouldStartRequests(requests);
+  }
+}
+
+bool AdBlockRegionalServiceManager::MayMatchFirstPartyRequest(
+    const std::string& request_host,
+    const std::string& tab_host) {
+  if (!IsInitialized())
+    return false;
+
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    if (regional_service.second->MayMatchFirstPartyRequest(request_host,
+                                                           tab_host)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AdBlockRegionalServiceManager::MayHaveCspDirectives(
+    const std::string& request_host,
+    const std::string& tab_host) {
+  if (!IsInitialized())
+    return false;
+
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    if (regional_service.second->MayHaveCspDirectives(request_host,
+                                                      tab_host)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 absl::optional<std::string> AdBlockRegionalServiceManager::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -183,10 +276,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
     auto it = regional_services_.find(uuid);
     if (enabled) {
       DCHECK(it == regional_services_.end());
-      auto regional_service = AdBlockRegionalServiceFactory(
-          *catalog_entry, delegate_,
-          base::BindRepeating(&AdBlockRegionalServiceManager::AddResources,
-                              base::Unretained(this)));
+      auto regional_service = CreateRegionalService(*catalog_entry);
       regional_service->Start();
       regional_services_.insert(
           std::make_pair(uuid, std::move(regional_service)));
@@ -195,6 +285,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       it->second->Unregister();
       regional_services_.erase(it);
     }
+    AdBlockDecisionCache::BumpEngineGeneration();
   }
 
   // Update preferences to reflect enabled/disabled state of specified
@@ -318,6 +409,16 @@ AdBlockRegionalServiceManager::GetRegionalLists() {
   return list_value;
 }
 
+std::map<std::string, size_t>
+AdBlockRegionalServiceManager::GetEngineDataSizes() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  std::map<std::string, size_t> sizes;
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_)
+    sizes[regional_service.first] = regional_service.second->engine_data_size();
+  return sizes;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<AdBlockRegionalServiceManager>
@@ -11,7 +11,9 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/values.h"
@@ -32,6 +34,7 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 class AdBlockRegionalService;
+struct AdBlockRequest;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
@@ -42,6 +45,10 @@ class AdBlockRegionalServiceManager {
 
   std::unique_ptr<base::ListValue> GetRegionalLists();
 
+  // Has every regional service keep an engine snapshot in |snapshot_dir|.
+  // See AdBlockBaseService::EnableEngineSnapshot.
+  void SetEngineSnapshotDir(const base::FilePath& snapshot_dir);
+
   void SetRegionalCatalog(std::vector<adblock::FilterList> catalog);
   const std::vector<adblock::FilterList>& GetRegionalCatalog();
 
@@ -55,6 +62,13 @@ class AdBlockRegionalServiceManager {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  void ShouldStartRequests(const std::vector<AdBlockRequest*>& requests);
+  // See AdBlockBaseService::MayMatchFirstPartyRequest.
+  bool MayMatchFirstPartyRequest(const std::string& request_host,
+                                 const std::string& tab_host);
+  // See AdBlockBaseService::MayHaveCspDirectives.
+  bool MayHaveCspDirectives(const std::string& request_host,
+                            const std::string& tab_host);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -69,10 +83,18 @@ class AdBlockRegionalServiceManager {
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
 
+  // The engine data size of every regional service, keyed by list uuid.
+  // See AdBlockBaseService::engine_data_size.
+  std::map<std::string, size_t> GetEngineDataSizes();
+
  private:
   friend class ::AdBlockServiceTest;
   void StartRegionalServices();
+  std::unique_ptr<AdBlockRegionalService> CreateRegionalService(
+      const adblock::FilterList& catalog_entry);
   void UpdateFilterListPrefs(const std::string& uuid, bool enabled);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
 
   brave_component_updater::BraveComponent::Delegate* delegate_;  // NOT OWNED
   bool initialized_;
@@ -81,6 +103,8 @@ class AdBlockRegionalServiceManager {
       regional_services_;
 
   std::vector<adblock::FilterList> regional_catalog_;
+  base::FilePath snapshot_dir_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockRegionalServiceManager);
 };
@@ -12,14 +12,23 @@
 #include "base/bind.h"
 #include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_stats.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
@@ -58,6 +67,26 @@ void AdBlockServiceDomainResolver(const char* host,
   }
 }
 
+// Returns the contents of a snapshot file, or an empty string if there is
+// none yet.
+std::string ReadSnapshotFile(const base::FilePath& path) {
+  std::string contents;
+  base::ReadFileToString(path, &contents);
+  return contents;
+}
+
+void WriteSnapshotFile(const base::FilePath& path,
+                       const std::string& contents) {
+  std::string old_contents;
+  if (contents.empty() ||
+      (base::ReadFileToString(path, &old_contents) &&
+       old_contents == contents)) {
+    return;
+  }
+  if (base::CreateDirectory(path.DirName()))
+    base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
 }  // namespace
 
 std::string AdBlockService::g_ad_block_component_id_(kAdBlockComponentId);
@@ -76,15 +105,60 @@ void AdBlockService::ShouldStartRequest(
   if (!IsInitialized())
     return;
 
+  // Decisions are only cached for fresh checks; follow-up checks (e.g. after
+  // CNAME uncloaking) start from a previous engine result.
+  if (!decision_cache_ || *did_match_rule || *did_match_exception ||
+      *did_match_important) {
+    ShouldStartRequestUncached(url, resource_type, tab_host,
+                               aggressive_blocking, did_match_rule,
+                               did_match_exception, did_match_important,
+                               mock_data_url);
+    return;
+  }
+
+  AdBlockDecisionCache::Decision decision;
+  if (!decision_cache_->Get(url, resource_type, tab_host, aggressive_blocking,
+                            &decision)) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    ShouldStartRequestUncached(
+        url, resource_type, tab_host, aggressive_blocking,
+        &decision.did_match_rule, &decision.did_match_exception,
+        &decision.did_match_important, &decision.mock_data_url);
+    decision.lookup_time = base::TimeTicks::Now() - start;
+    decision_cache_->Put(url, resource_type, tab_host, aggressive_blocking,
+                         decision);
+  }
+
+  *did_match_rule = decision.did_match_rule;
+  *did_match_exception = decision.did_match_exception;
+  *did_match_important = decision.did_match_important;
+  if (mock_data_url && !decision.mock_data_url.empty())
+    *mock_data_url = decision.mock_data_url;
+}
+
+void AdBlockService::ShouldStartRequestUncached(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
   if (aggressive_blocking ||
       base::FeatureList::IsEnabled(
           brave_shields::features::kBraveAdblockDefault1pBlocking) ||
       !SameDomainOrHost(
           url, url::Origin::CreateFromNormalizedTuple("https", tab_host, 80),
           net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES)) {
-    AdBlockBaseService::ShouldStartRequest(
-        url, resource_type, tab_host, aggressive_blocking, did_match_rule,
-        did_match_exception, did_match_important, mock_data_url);
+    {
+      AdBlockEngineStats::ScopedSample sample(
+          [] { return std::string("default"); }, did_match_rule,
+          did_match_exception, did_match_important);
+      AdBlockBaseService::ShouldStartRequest(
+          url, resource_type, tab_host, aggressive_blocking, did_match_rule,
+          did_match_exception, did_match_important, mock_data_url);
+    }
     if (did_match_important && *did_match_important) {
       return;
     }
@@ -104,11 +178,72 @@ void AdBlockService::ShouldStartRequest(
     return;
   }
 
+  AdBlockEngineStats::ScopedSample sample(
+      [] { return std::string("custom"); }, did_match_rule,
+      did_match_exception, did_match_important);
   custom_filters_service()->ShouldStartRequest(
       url, resource_type, tab_host, aggressive_blocking, did_match_rule,
       did_match_exception, did_match_important, mock_data_url);
 }
 
+void AdBlockService::ShouldStartRequests(
+    const std::vector<AdBlockRequest*>& requests) {
+  if (!IsInitialized())
+    return;
+
+  const bool default_1p_blocking = base::FeatureList::IsEnabled(
+      brave_shields::features::kBraveAdblockDefault1pBlocking);
+  std::vector<AdBlockRequest*> default_requests;
+  default_requests.reserve(requests.size());
+  for (AdBlockRequest* request : requests) {
+    if (request->aggressive_blocking || default_1p_blocking ||
+        request->is_third_party) {
+      default_requests.push_back(request);
+    }
+  }
+  {
+    AdBlockEngineStats::ScopedBatchSample sample(
+        [] { return std::string("default"); }, default_requests);
+    AdBlockBaseService::ShouldStartRequests(default_requests);
+  }
+
+  // Each of these skips requests that already matched an important rule.
+  regional_service_manager()->ShouldStartRequests(requests);
+  subscription_service_manager()->ShouldStartRequests(requests);
+  AdBlockEngineStats::ScopedBatchSample sample(
+      [] { return std::string("custom"); }, requests);
+  custom_filters_service()->ShouldStartRequests(requests);
+}
+
+bool AdBlockService::CouldBlockFirstPartyRequest(
+    const std::string& request_host,
+    const std::string& tab_host,
+    bool aggressive_blocking) {
+  // Mirrors the engine order of ShouldStartRequestUncached, where the default
+  // engine only sees first-party requests in some modes.
+  if ((aggressive_blocking ||
+       base::FeatureList::IsEnabled(
+           brave_shields::features::kBraveAdblockDefault1pBlocking)) &&
+      MayMatchFirstPartyRequest(request_host, tab_host)) {
+    return true;
+  }
+  return regional_service_manager()->MayMatchFirstPartyRequest(request_host,
+                                                               tab_host) ||
+         subscription_service_manager()->MayMatchFirstPartyRequest(
+             request_host, tab_host) ||
+         custom_filters_service()->MayMatchFirstPartyRequest(request_host,
+                                                             tab_host);
+}
+
+bool AdBlockService::CouldHaveCspDirectives(const std::string& request_host,
+                                            const std::string& tab_host) {
+  return MayHaveCspDirectives(request_host, tab_host) ||
+         regional_service_manager()->MayHaveCspDirectives(request_host,
+                                                          tab_host) ||
+         custom_filters_service()->MayHaveCspDirectives(request_host,
+                                                        tab_host);
+}
+
 absl::optional<std::string> AdBlockService::GetCspDirectives(
     const GURL& url,
     blink::mojom::ResourceType resource_type,
@@ -238,31 +373,109 @@ AdBlockService::subscription_service_manager() {
   return subscription_service_manager_.get();
 }
 
+void AdBlockService::EnableTagInAllEngines(const std::string& tag,
+                                           bool enabled) {
+  EnableTag(tag, enabled);
+  regional_service_manager()->EnableTag(tag, enabled);
+  custom_filters_service()->EnableTag(tag, enabled);
+  subscription_service_manager()->EnableTag(tag, enabled);
+}
+
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate,
     std::unique_ptr<AdBlockSubscriptionServiceManager>
-        subscription_service_manager)
+        subscription_service_manager,
+    const base::FilePath& snapshot_dir)
     : AdBlockBaseService(delegate),
       component_delegate_(delegate),
-      subscription_service_manager_(std::move(subscription_service_manager)) {}
+      subscription_service_manager_(std::move(subscription_service_manager)) {
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockEngineSnapshot))
+    snapshot_dir_ = snapshot_dir;
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockDecisionCache))
+    decision_cache_ = std::make_unique<AdBlockDecisionCache>();
+}
 
-AdBlockService::~AdBlockService() {}
+AdBlockService::~AdBlockService() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
+  if (decision_cache_)
+    GetTaskRunner()->DeleteSoon(FROM_HERE, decision_cache_.release());
+}
 
 bool AdBlockService::Init() {
   // Initializes adblock-rust's domain resolution implementation
   adblock::SetDomainResolver(AdBlockServiceDomainResolver);
 
+  if (!snapshot_dir_.empty()) {
+    EnableEngineSnapshot(snapshot_dir_.AppendASCII(DAT_FILE));
+    regional_service_manager()->SetEngineSnapshotDir(snapshot_dir_);
+    base::PostTaskAndReplyWithResult(
+        GetTaskRunner().get(), FROM_HERE,
+        base::BindOnce(&ReadSnapshotFile,
+                       snapshot_dir_.AppendASCII(kAdBlockResourcesFilename)),
+        base::BindOnce(&AdBlockService::OnResourcesSnapshotReady,
+                       weak_factory_.GetWeakPtr()));
+    base::PostTaskAndReplyWithResult(
+        GetTaskRunner().get(), FROM_HERE,
+        base::BindOnce(&ReadSnapshotFile,
+                       snapshot_dir_.AppendASCII(REGIONAL_CATALOG)),
+        base::BindOnce(&AdBlockService::OnRegionalCatalogSnapshotReady,
+                       weak_factory_.GetWeakPtr()));
+  }
+
   if (!AdBlockBaseService::Init())
     return false;
 
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE, base::BindRepeating(&AdBlockService::OnMemoryPressure,
+                                     base::Unretained(this)));
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "AdBlock", base::ThreadTaskRunnerHandle::Get());
+
   Register(kAdBlockComponentName, g_ad_block_component_id_,
            g_ad_block_component_base64_public_key_);
   return true;
 }
 
+bool AdBlockService::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  auto add_engine_dump = [pmd](const std::string& name, size_t size) {
+    base::trace_event::MemoryAllocatorDump* dump =
+        pmd->CreateAllocatorDump("brave/adblock/" + name);
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                    base::trace_event::MemoryAllocatorDump::kUnitsBytes, size);
+  };
+  add_engine_dump("default", engine_data_size());
+  add_engine_dump("custom_filters",
+                  custom_filters_service()->engine_data_size());
+  for (const auto& regional_size :
+       regional_service_manager()->GetEngineDataSizes()) {
+    add_engine_dump("regional/" + regional_size.first, regional_size.second);
+  }
+  return true;
+}
+
+void AdBlockService::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  GetTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(&AdBlockService::ClearCachesOnTaskRunner,
+                                base::Unretained(this)));
+}
+
+void AdBlockService::ClearCachesOnTaskRunner() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  if (decision_cache_)
+    decision_cache_->Clear();
+  hidden_selector_cache_.Clear();
+}
+
 void AdBlockService::OnComponentReady(const std::string& component_id,
                                       const base::FilePath& install_dir,
                                       const std::string& manifest) {
+  component_ready_ = true;
   // Regional service manager depends on regional catalog loading
   custom_filters_service()->Start();
   subscription_service_manager()->Start();
@@ -292,6 +505,13 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
 void AdBlockService::OnResourcesFileDataReady(const std::string& resources) {
   AddResources(resources);
   custom_filters_service()->AddResources(resources);
+  if (component_ready_ && !snapshot_dir_.empty()) {
+    base::ThreadPool::PostTask(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+        base::BindOnce(&WriteSnapshotFile,
+                       snapshot_dir_.AppendASCII(kAdBlockResourcesFilename),
+                       resources));
+  }
 }
 
 void AdBlockService::OnRegionalCatalogFileDataReady(
@@ -299,6 +519,30 @@ void AdBlockService::OnRegionalCatalogFileDataReady(
   regional_service_manager()->SetRegionalCatalog(
       RegionalCatalogFromJSON(catalog_json));
   regional_service_manager()->Start();
+  if (component_ready_ && !snapshot_dir_.empty()) {
+    base::ThreadPool::PostTask(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+        base::BindOnce(&WriteSnapshotFile,
+                       snapshot_dir_.AppendASCII(REGIONAL_CATALOG),
+                       catalog_json));
+  }
+}
+
+void AdBlockService::OnResourcesSnapshotReady(const std::string& resources) {
+  if (component_ready_ || resources.empty())
+    return;
+  OnResourcesFileDataReady(resources);
+}
+
+void AdBlockService::OnRegionalCatalogSnapshotReady(
+    const std::string& catalog_json) {
+  if (component_ready_ || catalog_json.empty())
+    return;
+  // Start what OnComponentReady would, so that the regional engines can load
+  // their own snapshots.
+  custom_filters_service()->Start();
+  subscription_service_manager()->Start();
+  OnRegionalCatalogFileDataReady(catalog_json);
 }
 
 // static
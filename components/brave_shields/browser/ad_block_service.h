@@ -12,6 +12,9 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -28,6 +31,7 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class AdBlockDecisionCache;
 class AdBlockRegionalServiceManager;
 class AdBlockCustomFiltersService;
 class AdBlockSubscriptionServiceManager;
@@ -45,13 +49,21 @@ const char kAdBlockComponentBase64PublicKey[] =
     "VwIDAQAB";
 
 // The brave shields service in charge of ad-block checking and init.
-class AdBlockService : public AdBlockBaseService {
+class AdBlockService : public AdBlockBaseService,
+                       public base::trace_event::MemoryDumpProvider {
  public:
-  explicit AdBlockService(
-      BraveComponent::Delegate* delegate,
-      std::unique_ptr<AdBlockSubscriptionServiceManager> manager);
+  // |snapshot_dir| holds the engine snapshots, resources and regional
+  // catalog loaded before the components are ready. Snapshots are disabled
+  // when it is empty.
+  AdBlockService(BraveComponent::Delegate* delegate,
+                 std::unique_ptr<AdBlockSubscriptionServiceManager> manager,
+                 const base::FilePath& snapshot_dir);
   ~AdBlockService() override;
 
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
   void ShouldStartRequest(const GURL& url,
                           blink::mojom::ResourceType resource_type,
                           const std::string& tab_host,
@@ -60,6 +72,20 @@ class AdBlockService : public AdBlockBaseService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url) override;
+  void ShouldStartRequests(
+      const std::vector<AdBlockRequest*>& requests) override;
+  // Whether any engine ShouldStartRequest() would consult could match a
+  // first-party request to |request_host| from a page on |tab_host|. A false
+  // result means the engines don't need to be asked at all. Safe to call
+  // from any thread.
+  bool CouldBlockFirstPartyRequest(const std::string& request_host,
+                                   const std::string& tab_host,
+                                   bool aggressive_blocking);
+  // Whether any engine GetCspDirectives() would consult could have
+  // directives for a document from |request_host| on |tab_host|. Safe to call
+  // from any thread.
+  bool CouldHaveCspDirectives(const std::string& request_host,
+                              const std::string& tab_host);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -71,6 +97,11 @@ class AdBlockService : public AdBlockBaseService {
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions) override;
 
+  // Enables or disables |tag| in the default, regional, custom filter and
+  // subscription engines. The engines are shared by all profiles, including
+  // off-the-record and Tor ones, which have no engines of their own.
+  void EnableTagInAllEngines(const std::string& tag, bool enabled);
+
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
   AdBlockSubscriptionServiceManager* subscription_service_manager();
@@ -82,6 +113,8 @@ class AdBlockService : public AdBlockBaseService {
                         const std::string& manifest) override;
   void OnResourcesFileDataReady(const std::string& resources);
   void OnRegionalCatalogFileDataReady(const std::string& catalog_json);
+  void OnResourcesSnapshotReady(const std::string& resources);
+  void OnRegionalCatalogSnapshotReady(const std::string& catalog_json);
 
  private:
   friend class ::AdBlockServiceTest;
@@ -93,7 +126,27 @@ class AdBlockService : public AdBlockBaseService {
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
+  // Runs the request through every engine, bypassing |decision_cache_|.
+  void ShouldStartRequestUncached(const GURL& url,
+                                  blink::mojom::ResourceType resource_type,
+                                  const std::string& tab_host,
+                                  bool aggressive_blocking,
+                                  bool* did_match_rule,
+                                  bool* did_match_exception,
+                                  bool* did_match_important,
+                                  std::string* mock_data_url);
+
+  // Drops the decision and hidden selector caches of the default engine.
+  // Engines are left alone; see AdBlockRegionalServiceManager for those.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  void ClearCachesOnTaskRunner();
+
   BraveComponent::Delegate* component_delegate_;
+  base::FilePath snapshot_dir_;
+  // Set once the component is ready, after which the snapshot files are
+  // stale.
+  bool component_ready_ = false;
 
   std::unique_ptr<brave_shields::AdBlockRegionalServiceManager>
       regional_service_manager_;
@@ -101,6 +154,9 @@ class AdBlockService : public AdBlockBaseService {
       custom_filters_service_;
   std::unique_ptr<brave_shields::AdBlockSubscriptionServiceManager>
       subscription_service_manager_;
+  // Only used on the adblock task runner.
+  std::unique_ptr<AdBlockDecisionCache> decision_cache_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   base::WeakPtrFactory<AdBlockService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
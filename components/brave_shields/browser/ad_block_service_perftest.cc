@@ -0,0 +1,233 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/check.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// Replays recorded page request traces through the same engines the shields
+// services hold: the default list, a regional list and custom filters. Pass
+// --adblock-request-trace=<path> to replay a trace other than the checked in
+// sample; each line is "url<TAB>resource type<TAB>tab host".
+
+namespace brave_shields {
+
+namespace {
+
+const char kAdBlockRequestTraceSwitch[] = "adblock-request-trace";
+
+const char kMetricPrefix[] = "AdBlockService.";
+const char kMetricLoadTime[] = "engine_load_time";
+const char kMetricMemory[] = "engine_memory";
+const char kMetricLatencyP50[] = "request_latency_p50";
+const char kMetricLatencyP90[] = "request_latency_p90";
+const char kMetricLatencyP99[] = "request_latency_p99";
+const char kMetricBatchLatency[] = "batch_latency_per_request";
+
+// The trace is replayed this many times so the percentiles aren't dominated
+// by cold caches on the first pass.
+constexpr int kReplayIterations = 20;
+
+const char kCustomFilters[] =
+    "||googletagservices.com^$third-party\n"
+    "||doubleclick.net^\n"
+    "||chartbeat.com^$third-party\n"
+    "||taboola.com^\n"
+    "/ad_banner.\n"
+    "@@||fonts.googleapis.com^\n"
+    "example.com##.sponsored\n";
+
+struct TraceEntry {
+  AdBlockRequest request;
+  std::string resource_type;
+};
+
+base::FilePath GetTestDataDir() {
+  base::FilePath source_root;
+  base::PathService::Get(base::DIR_SOURCE_ROOT, &source_root);
+  return source_root.AppendASCII("brave")
+      .AppendASCII("test")
+      .AppendASCII("data")
+      .AppendASCII("adblock-data");
+}
+
+std::vector<TraceEntry> LoadTrace() {
+  base::FilePath trace_path =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+          kAdBlockRequestTraceSwitch);
+  if (trace_path.empty())
+    trace_path = GetTestDataDir().AppendASCII("perf").AppendASCII(
+        "request_trace.tsv");
+
+  std::string contents;
+  if (!base::ReadFileToString(trace_path, &contents))
+    return {};
+
+  std::vector<TraceEntry> trace;
+  for (const auto& line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(line, "#"))
+      continue;
+    std::vector<std::string> fields = base::SplitString(
+        line, "\t", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+    if (fields.size() != 3)
+      continue;
+    TraceEntry entry;
+    entry.request.url = GURL(fields[0]);
+    if (!entry.request.url.is_valid())
+      continue;
+    entry.resource_type = fields[1];
+    entry.request.tab_host = fields[2];
+    entry.request.ComputeDerivedFields();
+    trace.push_back(entry);
+  }
+  return trace;
+}
+
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
+base::TimeDelta Percentile(std::vector<base::TimeDelta>* samples,
+                           double fraction) {
+  DCHECK(!samples->empty());
+  size_t index = static_cast<size_t>(fraction * (samples->size() - 1));
+  std::nth_element(samples->begin(), samples->begin() + index, samples->end());
+  return (*samples)[index];
+}
+
+}  // namespace
+
+class AdBlockServicePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    trace_ = LoadTrace();
+    ASSERT_FALSE(trace_.empty());
+  }
+
+  perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricLoadTime, "ms");
+    reporter.RegisterImportantMetric(kMetricMemory, "bytes");
+    reporter.RegisterImportantMetric(kMetricLatencyP50, "us");
+    reporter.RegisterImportantMetric(kMetricLatencyP90, "us");
+    reporter.RegisterImportantMetric(kMetricLatencyP99, "us");
+    reporter.RegisterImportantMetric(kMetricBatchLatency, "us");
+    return reporter;
+  }
+
+  std::unique_ptr<adblock::Engine> LoadEngineFromDAT(
+      const base::FilePath& dat_path) {
+    std::string data;
+    if (!base::ReadFileToString(dat_path, &data))
+      return nullptr;
+    return std::make_unique<adblock::Engine>(data.data(), data.size());
+  }
+
+  // Loads an engine with |load|, then reports its load time, memory and the
+  // latency of matching every trace request against it.
+  template <typename LoadCallback>
+  void RunStory(const std::string& story, LoadCallback load) {
+    perf_test::PerfResultReporter reporter = SetUpReporter(story);
+
+    size_t memory_before = GetMallocUsage();
+    base::ElapsedTimer load_timer;
+    std::unique_ptr<adblock::Engine> engine = load();
+    reporter.AddResult(kMetricLoadTime, load_timer.Elapsed());
+    ASSERT_TRUE(engine);
+    size_t memory_after = GetMallocUsage();
+    reporter.AddResult(kMetricMemory,
+                       memory_after > memory_before
+                           ? static_cast<size_t>(memory_after - memory_before)
+                           : 0u);
+
+    std::vector<base::TimeDelta> samples;
+    samples.reserve(trace_.size() * kReplayIterations);
+    for (int i = 0; i < kReplayIterations; i++) {
+      for (const TraceEntry& entry : trace_) {
+        bool did_match_rule = false;
+        bool did_match_exception = false;
+        bool did_match_important = false;
+        std::string redirect;
+        base::ElapsedTimer timer;
+        engine->matches(entry.request.url.spec(), entry.request.url_host,
+                        entry.request.tab_host, entry.request.is_third_party,
+                        entry.resource_type, &did_match_rule,
+                        &did_match_exception, &did_match_important,
+                        &redirect);
+        samples.push_back(timer.Elapsed());
+      }
+    }
+    reporter.AddResult(kMetricLatencyP50,
+                       Percentile(&samples, 0.5).InMicrosecondsF());
+    reporter.AddResult(kMetricLatencyP90,
+                       Percentile(&samples, 0.9).InMicrosecondsF());
+    reporter.AddResult(kMetricLatencyP99,
+                       Percentile(&samples, 0.99).InMicrosecondsF());
+
+    // The same trace through matchesBatch, the way batched network checks
+    // reach the engine.
+    std::vector<adblock::MatchRequest> match_requests;
+    match_requests.reserve(trace_.size());
+    for (const TraceEntry& entry : trace_) {
+      match_requests.push_back(
+          {entry.request.url.spec().c_str(), entry.request.url_host.c_str(),
+           entry.request.tab_host.c_str(), entry.request.is_third_party,
+           entry.resource_type.c_str()});
+    }
+    base::ElapsedTimer batch_timer;
+    for (int i = 0; i < kReplayIterations; i++) {
+      std::vector<adblock::MatchResult> match_results(match_requests.size());
+      engine->matchesBatch(match_requests, &match_results);
+    }
+    reporter.AddResult(kMetricBatchLatency,
+                       batch_timer.Elapsed().InMicrosecondsF() /
+                           (kReplayIterations * match_requests.size()));
+  }
+
+  std::vector<TraceEntry> trace_;
+};
+
+TEST_F(AdBlockServicePerfTest, DefaultList) {
+  RunStory("default_list", [this]() {
+    return LoadEngineFromDAT(GetTestDataDir()
+                                 .AppendASCII("adblock-default")
+                                 .AppendASCII("rs-ABPFilterParserData.dat"));
+  });
+}
+
+TEST_F(AdBlockServicePerfTest, RegionalList) {
+  RunStory("regional_list", [this]() {
+    return LoadEngineFromDAT(
+        GetTestDataDir()
+            .AppendASCII("adblock-regional")
+            .AppendASCII("9852EFC4-99E4-4F2D-A915-9C3196C7A1DE")
+            .AppendASCII("rs-9852EFC4-99E4-4F2D-A915-9C3196C7A1DE.dat"));
+  });
+}
+
+TEST_F(AdBlockServicePerfTest, CustomFilters) {
+  RunStory("custom_filters",
+           []() { return std::make_unique<adblock::Engine>(kCustomFilters); });
+}
+
+}  // namespace brave_shields
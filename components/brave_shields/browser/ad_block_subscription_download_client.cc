@@ -19,6 +19,8 @@
 #include "brave/components/brave_shields/browser/ad_block_subscription_download_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
 #include "components/download/public/background_service/download_metadata.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/resource_request_body.h"
 
 namespace brave_shields {
@@ -71,8 +73,19 @@ void AdBlockSubscriptionDownloadClient::OnDownloadFailed(
     download::Client::FailureReason reason) {
   AdBlockSubscriptionDownloadManager* download_manager =
       GetAdBlockSubscriptionDownloadManager();
-  if (download_manager)
-    download_manager->OnDownloadFailed(guid);
+  if (!download_manager)
+    return;
+
+  // A conditional request for a list that hasn't changed comes back as a
+  // non-2xx response, which the download service reports as a failure.
+  if (completion_info.response_headers &&
+      completion_info.response_headers->response_code() ==
+          net::HTTP_NOT_MODIFIED) {
+    download_manager->OnDownloadNotModified(guid);
+    return;
+  }
+
+  download_manager->OnDownloadFailed(guid);
 }
 
 void AdBlockSubscriptionDownloadClient::OnDownloadSucceeded(
@@ -94,7 +107,8 @@ void AdBlockSubscriptionDownloadClient::OnDownloadSucceeded(
     return;
   }
 
-  download_manager->OnDownloadSucceeded(guid, completion_info.path);
+  download_manager->OnDownloadSucceeded(guid, completion_info.path,
+                                        completion_info.response_headers);
 }
 
 bool AdBlockSubscriptionDownloadClient::CanServiceRemoveDownloadedFile(
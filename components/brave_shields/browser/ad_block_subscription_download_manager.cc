@@ -9,17 +9,27 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/guid.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/metrics/histogram_functions.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/task/post_task.h"
+#include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "build/build_config.h"
 #include "components/download/public/background_service/background_download_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
+#include "crypto/sha2.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 
 namespace brave_shields {
@@ -54,6 +64,94 @@ const net::NetworkTrafficAnnotationTag
           policy_exception_justification: "Not yet implemented."
         })");
 
+using ListValidators = AdBlockSubscriptionDownloadManager::ListValidators;
+using ListUpdateResult = AdBlockSubscriptionDownloadManager::ListUpdateResult;
+
+const char kValidatorsETagKey[] = "etag";
+const char kValidatorsLastModifiedKey[] = "last_modified";
+const char kValidatorsSha256Key[] = "sha256";
+
+// Reads the validators stored next to a previously downloaded list. Missing or
+// malformed sidecars yield empty validators, which results in an
+// unconditional request.
+ListValidators ReadListValidators(const base::FilePath& subscription_dir) {
+  ListValidators validators;
+  // Validators are useless without the list they describe.
+  if (!base::PathExists(subscription_dir.Append(kCustomSubscriptionListText)))
+    return validators;
+
+  std::string contents;
+  if (!base::ReadFileToString(
+          subscription_dir.Append(kCustomSubscriptionListValidators),
+          &contents)) {
+    return validators;
+  }
+
+  absl::optional<base::Value> value = base::JSONReader::Read(contents);
+  if (!value || !value->is_dict())
+    return validators;
+
+  if (const std::string* etag = value->FindStringKey(kValidatorsETagKey))
+    validators.etag = *etag;
+  if (const std::string* last_modified =
+          value->FindStringKey(kValidatorsLastModifiedKey))
+    validators.last_modified = *last_modified;
+  if (const std::string* sha256 = value->FindStringKey(kValidatorsSha256Key))
+    validators.sha256 = *sha256;
+  return validators;
+}
+
+bool WriteListValidators(const base::FilePath& subscription_dir,
+                         const ListValidators& validators) {
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetStringKey(kValidatorsETagKey, validators.etag);
+  value.SetStringKey(kValidatorsLastModifiedKey, validators.last_modified);
+  value.SetStringKey(kValidatorsSha256Key, validators.sha256);
+  std::string contents;
+  if (!base::JSONWriter::Write(value, &contents))
+    return false;
+  return base::ImportantFileWriter::WriteFileAtomically(
+      subscription_dir.Append(kCustomSubscriptionListValidators), contents);
+}
+
+// Moves |downloaded_file| into place as the list text for the subscription in
+// |subscription_dir|, unless its content hash shows it is identical to the
+// list already there.
+ListUpdateResult UpdateListFile(const base::FilePath& downloaded_file,
+                                const base::FilePath& subscription_dir,
+                                ListValidators validators) {
+  const base::FilePath list_path =
+      subscription_dir.Append(kCustomSubscriptionListText);
+
+  if (!base::FeatureList::IsEnabled(
+          features::kBraveAdblockSubscriptionConditionalDownloads)) {
+    return base::ReplaceFile(downloaded_file, list_path, nullptr)
+               ? ListUpdateResult::kUpdated
+               : ListUpdateResult::kFailed;
+  }
+
+  std::string contents;
+  if (!base::ReadFileToString(downloaded_file, &contents))
+    return ListUpdateResult::kFailed;
+  validators.sha256 =
+      base::HexEncode(crypto::SHA256HashString(contents).data(),
+                      crypto::kSHA256Length);
+
+  const ListValidators previous = ReadListValidators(subscription_dir);
+  if (!previous.sha256.empty() && previous.sha256 == validators.sha256) {
+    base::DeleteFile(downloaded_file);
+    // Keep the fresh validators so the next request can be conditional even
+    // if the server rotated its ETag for identical content.
+    WriteListValidators(subscription_dir, validators);
+    return ListUpdateResult::kUnchanged;
+  }
+
+  if (!base::ReplaceFile(downloaded_file, list_path, nullptr))
+    return ListUpdateResult::kFailed;
+  WriteListValidators(subscription_dir, validators);
+  return ListUpdateResult::kUpdated;
+}
+
 }  // namespace
 
 AdBlockSubscriptionDownloadManager::AdBlockSubscriptionDownloadManager(
@@ -68,6 +166,28 @@ AdBlockSubscriptionDownloadManager::~AdBlockSubscriptionDownloadManager() =
 
 void AdBlockSubscriptionDownloadManager::StartDownload(const GURL& download_url,
                                                        bool from_ui) {
+  if (!base::FeatureList::IsEnabled(
+          features::kBraveAdblockSubscriptionConditionalDownloads)) {
+    StartDownloadWithValidators(download_url, from_ui, ListValidators());
+    return;
+  }
+
+  background_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&ReadListValidators,
+                     subscription_path_callback_.Run(download_url)),
+      base::BindOnce(
+          &AdBlockSubscriptionDownloadManager::StartDownloadWithValidators,
+          AsWeakPtr(), download_url, from_ui));
+}
+
+void AdBlockSubscriptionDownloadManager::StartDownloadWithValidators(
+    const GURL& download_url,
+    bool from_ui,
+    ListValidators validators) {
+  if (!is_available_for_downloads_)
+    return;
+
   download::DownloadParams download_params;
   download_params.client = download::DownloadClient::CUSTOM_LIST_SUBSCRIPTIONS;
   download_params.guid = base::GenerateGUID();
@@ -78,6 +198,14 @@ void AdBlockSubscriptionDownloadManager::StartDownload(const GURL& download_url,
       kBraveShieldsAdBlockSubscriptionTrafficAnnotation);
   download_params.request_params.url = download_url;
   download_params.request_params.method = "GET";
+  if (!validators.etag.empty()) {
+    download_params.request_params.request_headers.SetHeader(
+        net::HttpRequestHeaders::kIfNoneMatch, validators.etag);
+  }
+  if (!validators.last_modified.empty()) {
+    download_params.request_params.request_headers.SetHeader(
+        net::HttpRequestHeaders::kIfModifiedSince, validators.last_modified);
+  }
   if (from_ui) {
     // This triggers a high priority download with no network restrictions to
     // provide status feedback as quickly as possible.
@@ -154,13 +282,29 @@ void AdBlockSubscriptionDownloadManager::OnDownloadFailed(
   on_download_failed_callback_.Run(download_url);
 }
 
+void AdBlockSubscriptionDownloadManager::OnDownloadNotModified(
+    const std::string& guid) {
+  auto it = pending_download_guids_.find(guid);
+  if (it == pending_download_guids_.end()) {
+    return;
+  }
+  GURL download_url = it->second;
+  pending_download_guids_.erase(guid);
+
+  base::UmaHistogramBoolean(
+      "BraveShields.AdBlockSubscriptionDownloadManager.NotModified", true);
+
+  on_download_not_modified_callback_.Run(download_url);
+}
+
 bool EnsureDirExists(const base::FilePath& destination_dir) {
   return base::CreateDirectory(destination_dir);
 }
 
 void AdBlockSubscriptionDownloadManager::OnDownloadSucceeded(
     const std::string& guid,
-    base::FilePath downloaded_file) {
+    base::FilePath downloaded_file,
+    scoped_refptr<const net::HttpResponseHeaders> response_headers) {
   auto it = pending_download_guids_.find(guid);
   if (it == pending_download_guids_.end()) {
     return;
@@ -172,43 +316,62 @@ void AdBlockSubscriptionDownloadManager::OnDownloadSucceeded(
       "BraveShields.AdBlockSubscriptionDownloadManager.DownloadSucceeded",
       true);
 
+  ListValidators validators;
+  if (response_headers) {
+    response_headers->EnumerateHeader(nullptr, "ETag", &validators.etag);
+    response_headers->EnumerateHeader(nullptr, "Last-Modified",
+                                      &validators.last_modified);
+  }
+
   background_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&EnsureDirExists,
                      subscription_path_callback_.Run(download_url)),
       base::BindOnce(&AdBlockSubscriptionDownloadManager::OnDirCreated,
-                     AsWeakPtr(), downloaded_file, download_url));
+                     AsWeakPtr(), downloaded_file, download_url,
+                     std::move(validators)));
 }
 
 void AdBlockSubscriptionDownloadManager::OnDirCreated(
     base::FilePath downloaded_file,
     const GURL& download_url,
+    ListValidators validators,
     bool created) {
   if (!created) {
     on_download_failed_callback_.Run(download_url);
     return;
   }
 
-  base::FilePath list_path = subscription_path_callback_.Run(download_url)
-                                 .Append(kCustomSubscriptionListText);
-
   background_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&base::ReplaceFile, downloaded_file, list_path, nullptr),
-      base::BindOnce(&AdBlockSubscriptionDownloadManager::ReplaceFileCallback,
+      base::BindOnce(&UpdateListFile, downloaded_file,
+                     subscription_path_callback_.Run(download_url),
+                     std::move(validators)),
+      base::BindOnce(&AdBlockSubscriptionDownloadManager::OnListUpdated,
                      AsWeakPtr(), download_url));
 }
 
-void AdBlockSubscriptionDownloadManager::ReplaceFileCallback(
+void AdBlockSubscriptionDownloadManager::OnListUpdated(
     const GURL& download_url,
-    bool success) {
-  if (!success) {
-    on_download_failed_callback_.Run(download_url);
-    return;
+    ListUpdateResult result) {
+  switch (result) {
+    case ListUpdateResult::kFailed:
+      on_download_failed_callback_.Run(download_url);
+      return;
+    case ListUpdateResult::kUnchanged:
+      base::UmaHistogramBoolean(
+          "BraveShields.AdBlockSubscriptionDownloadManager.NotModified",
+          true);
+      on_download_not_modified_callback_.Run(download_url);
+      return;
+    case ListUpdateResult::kUpdated:
+      base::UmaHistogramBoolean(
+          "BraveShields.AdBlockSubscriptionDownloadManager.NotModified",
+          false);
+      // this should send the data to subscription manager
+      on_download_succeeded_callback_.Run(download_url);
+      return;
   }
-
-  // this should send the data to subscription manager
-  on_download_succeeded_callback_.Run(download_url);
 }
 
 }  // namespace brave_shields
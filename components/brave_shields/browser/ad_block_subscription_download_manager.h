@@ -14,6 +14,7 @@
 
 #include "base/callback.h"
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "components/download/public/background_service/download_params.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -24,6 +25,10 @@ namespace download {
 class BackgroundDownloadService;
 }  // namespace download
 
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
 namespace brave_shields {
 
 class AdBlockSubscriptionServiceManager;
@@ -74,9 +79,31 @@ class AdBlockSubscriptionDownloadManager
     on_download_failed_callback_ = on_download_failed_callback;
   }
 
+  // Invoked instead of the succeeded callback when the server or the content
+  // hash shows that the cached list is still current.
+  void set_on_download_not_modified_callback(
+      base::RepeatingCallback<void(const GURL&)>
+          on_download_not_modified_callback) {
+    on_download_not_modified_callback_ = on_download_not_modified_callback;
+  }
+
+  // The HTTP validators and content hash remembered for a downloaded list.
+  struct ListValidators {
+    std::string etag;
+    std::string last_modified;
+    std::string sha256;
+  };
+
+  // The outcome of moving a finished download into place.
+  enum class ListUpdateResult { kFailed, kUpdated, kUnchanged };
+
  private:
   friend class AdBlockSubscriptionDownloadClient;
 
+  void StartDownloadWithValidators(const GURL& download_url,
+                                   bool from_ui,
+                                   ListValidators validators);
+
   bool service_ready_;
 
   // KeyedService implementation
@@ -103,19 +130,26 @@ class AdBlockSubscriptionDownloadManager
                          download::DownloadParams::StartResult start_result);
 
   // Invoked when the download as specified by |downloaded_guid| succeeded.
-  void OnDownloadSucceeded(const std::string& downloaded_guid,
-                           base::FilePath downloaded_file);
+  void OnDownloadSucceeded(
+      const std::string& downloaded_guid,
+      base::FilePath downloaded_file,
+      scoped_refptr<const net::HttpResponseHeaders> response_headers);
 
   // Invoked when the download as specified by |failed_download_guid| failed.
   void OnDownloadFailed(const std::string& failed_download_guid);
 
+  // Invoked when a conditional request for |guid| came back with 304 Not
+  // Modified.
+  void OnDownloadNotModified(const std::string& guid);
+
   void OnDirCreated(base::FilePath downloaded_file,
                     const GURL& download_url,
+                    ListValidators validators,
                     bool created);
 
-  // Invoked after ReplaceFile to report the status of moving the temporary
-  // download file to its destination path.
-  void ReplaceFileCallback(const GURL& download_url, bool success);
+  // Invoked after the temporary download file has been moved to its
+  // destination path, or dropped because it matched the cached list.
+  void OnListUpdated(const GURL& download_url, ListUpdateResult result);
 
   // GUIDs that are still pending download, mapped to the corresponding URLs of
   // their subscription services.
@@ -143,6 +177,7 @@ class AdBlockSubscriptionDownloadManager
       subscription_path_callback_;
   base::RepeatingCallback<void(const GURL&)> on_download_succeeded_callback_;
   base::RepeatingCallback<void(const GURL&)> on_download_failed_callback_;
+  base::RepeatingCallback<void(const GURL&)> on_download_not_modified_callback_;
 };
 
 }  // namespace brave_shields
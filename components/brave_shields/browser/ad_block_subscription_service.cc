@@ -5,14 +5,26 @@
 
 #include "brave/components/brave_shields/browser/ad_block_subscription_service.h"
 
+#include <atomic>
+#include <utility>
+
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/json/json_value_converter.h"
 #include "base/json/values_util.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
+#include "crypto/sha2.h"
 
 namespace brave_shields {
 
@@ -29,6 +41,73 @@ bool ParseTimeValue(const base::Value* value, base::Time* field) {
   *field = *time;
   return true;
 }
+
+// Lists are compiled on a handful of sequences instead of one task per list,
+// so users with many large subscriptions don't flood the thread pool at
+// startup.
+constexpr size_t kMaxConcurrentListCompiles = 3;
+
+scoped_refptr<base::SequencedTaskRunner> GetListCompileTaskRunner() {
+  static base::NoDestructor<
+      std::vector<scoped_refptr<base::SequencedTaskRunner>>>
+      task_runners([] {
+        std::vector<scoped_refptr<base::SequencedTaskRunner>> runners;
+        for (size_t i = 0; i < kMaxConcurrentListCompiles; i++) {
+          runners.push_back(base::ThreadPool::CreateSequencedTaskRunner(
+              {base::MayBlock(), base::TaskPriority::USER_VISIBLE}));
+        }
+        return runners;
+      }());
+  static std::atomic<size_t> next_task_runner{0};
+  return (*task_runners)[next_task_runner++ % task_runners->size()];
+}
+
+// Builds an engine for |list_file|, reusing the serialized engine cached
+// next to it when the list hasn't changed since it was written.
+AdBlockBaseService::GetDATFileDataResult LoadSubscriptionEngine(
+    const base::FilePath& list_file) {
+  brave_component_updater::DATFileDataBuffer buffer;
+  brave_component_updater::GetDATFileData(list_file, &buffer);
+  if (buffer.empty())
+    return AdBlockBaseService::GetDATFileDataResult(nullptr, std::move(buffer));
+
+  const base::FilePath engine_file =
+      list_file.AddExtension(FILE_PATH_LITERAL("dat"));
+  const base::FilePath hash_file =
+      list_file.AddExtension(FILE_PATH_LITERAL("sha256"));
+  const std::string list_hash = base::HexEncode(crypto::SHA256HashString(
+      base::StringPiece(reinterpret_cast<const char*>(buffer.data()),
+                        buffer.size())));
+
+  std::string cached_hash;
+  if (base::ReadFileToString(hash_file, &cached_hash) &&
+      cached_hash == list_hash) {
+    brave_component_updater::DATFileDataBuffer engine_buffer;
+    brave_component_updater::GetDATFileData(engine_file, &engine_buffer);
+    auto engine = std::make_unique<adblock::Engine>();
+    if (!engine_buffer.empty() &&
+        engine->deserialize(reinterpret_cast<char*>(engine_buffer.data()),
+                            engine_buffer.size())) {
+      UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.SubscriptionEngineCacheHit", true);
+      return AdBlockBaseService::GetDATFileDataResult(std::move(engine),
+                                                      std::move(buffer));
+    }
+  }
+  UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.SubscriptionEngineCacheHit", false);
+
+  auto engine = std::make_unique<adblock::Engine>(
+      reinterpret_cast<char*>(buffer.data()), buffer.size());
+  std::string serialized;
+  // The hash goes last so a partially written cache is never trusted.
+  if (engine->serialize(&serialized) &&
+      base::ImportantFileWriter::WriteFileAtomically(engine_file,
+                                                     serialized)) {
+    base::ImportantFileWriter::WriteFileAtomically(hash_file, list_hash);
+  }
+  return AdBlockBaseService::GetDATFileDataResult(std::move(engine),
+                                                  std::move(buffer));
+}
+
 }  // namespace
 
 void SubscriptionInfo::RegisterJSONConverter(
@@ -75,6 +154,14 @@ bool AdBlockSubscriptionService::Init() {
 }
 
 void AdBlockSubscriptionService::ReloadList() {
+  if (base::FeatureList::IsEnabled(
+          features::kBraveAdblockSubscriptionEngineCache)) {
+    GetEngineData(GetListCompileTaskRunner(),
+                  base::BindOnce(&LoadSubscriptionEngine, list_file_),
+                  base::BindOnce(&AdBlockSubscriptionService::OnListLoaded,
+                                 weak_factory_.GetWeakPtr()));
+    return;
+  }
   GetDATFileData(list_file_, false,
                  base::BindOnce(&AdBlockSubscriptionService::OnListLoaded,
                                 weak_factory_.GetWeakPtr()));
@@ -11,6 +11,7 @@
 
 #include "base/base64url.h"
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/json/json_value_converter.h"
 #include "base/json/values_util.h"
@@ -20,10 +21,14 @@
 #include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_engine_stats.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager_observer.h"
+#include "brave/components/brave_shields/browser/ad_block_subscription_unified_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -70,6 +75,11 @@ AdBlockSubscriptionServiceManager::AdBlockSubscriptionServiceManager(
       subscriptions_(new base::DictionaryValue()),
       subscription_update_timer_(
           std::make_unique<component_updater::TimerUpdateScheduler>()) {
+  if (base::FeatureList::IsEnabled(
+          features::kBraveAdblockUnifiedSubscriptionEngine)) {
+    unified_service_ =
+        std::make_unique<AdBlockSubscriptionUnifiedService>(delegate_);
+  }
   std::move(download_manager_getter)
       .Run(base::BindOnce(
           &AdBlockSubscriptionServiceManager::OnGetDownloadManager,
@@ -202,6 +212,8 @@ void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
   info->enabled = enabled;
 
   UpdateSubscriptionPrefs(sub_url, *info);
+  AdBlockDecisionCache::BumpEngineGeneration();
+  RebuildUnifiedService();
 }
 
 void AdBlockSubscriptionServiceManager::DeleteSubscription(
@@ -214,6 +226,8 @@ void AdBlockSubscriptionServiceManager::DeleteSubscription(
     subscription_services_.erase(it);
   }
   ClearSubscriptionPrefs(sub_url);
+  AdBlockDecisionCache::BumpEngineGeneration();
+  RebuildUnifiedService();
 
   base::ThreadPool::PostTask(
       FROM_HERE,
@@ -244,9 +258,13 @@ void AdBlockSubscriptionServiceManager::OnGetDownloadManager(
   download_manager_->set_on_download_failed_callback(base::BindRepeating(
       &AdBlockSubscriptionServiceManager::OnSubscriptionDownloadFailure,
       base::Unretained(this)));
+  download_manager_->set_on_download_not_modified_callback(base::BindRepeating(
+      &AdBlockSubscriptionServiceManager::OnSubscriptionNotModified,
+      base::Unretained(this)));
 
   download_manager_->CancelAllPendingDownloads();
   LoadSubscriptionServices();
+  RebuildUnifiedService();
 
   subscription_update_timer_->Schedule(
       kListCheckInitialDelay, kListRetryInterval,
@@ -308,6 +326,22 @@ void AdBlockSubscriptionServiceManager::LoadSubscriptionServices() {
   }
 }
 
+void AdBlockSubscriptionServiceManager::RebuildUnifiedService() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (!unified_service_)
+    return;
+
+  std::vector<base::FilePath> list_files;
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (info && info->enabled) {
+      list_files.push_back(GetSubscriptionPath(subscription_service.first)
+                               .Append(kCustomSubscriptionListText));
+    }
+  }
+  unified_service_->Rebuild(list_files);
+}
+
 // Updates preferences to reflect a new state for the specified filter list
 // subscription. Creates the entry if it does not yet exist.
 void AdBlockSubscriptionServiceManager::UpdateSubscriptionPrefs(
@@ -359,6 +393,10 @@ bool AdBlockSubscriptionServiceManager::Start() {
   for (const auto& subscription_service : subscription_services_) {
     subscription_service.second->Start();
   }
+  if (unified_service_) {
+    unified_service_->Start();
+    RebuildUnifiedService();
+  }
   return true;
 }
 
@@ -371,10 +409,23 @@ void AdBlockSubscriptionServiceManager::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
+  if (unified_service_) {
+    AdBlockEngineStats::ScopedSample sample(
+        [] { return std::string("subscriptions:unified"); }, did_match_rule,
+        did_match_exception, did_match_important);
+    unified_service_->ShouldStartRequest(
+        url, resource_type, tab_host, aggressive_blocking, did_match_rule,
+        did_match_exception, did_match_important, mock_data_url);
+    return;
+  }
+
   base::AutoLock lock(subscription_services_lock_);
   for (const auto& subscription_service : subscription_services_) {
     auto info = GetInfo(subscription_service.first);
     if (info && info->enabled) {
+      AdBlockEngineStats::ScopedSample sample(
+          [&] { return "subscription:" + subscription_service.first.spec(); },
+          did_match_rule, did_match_exception, did_match_important);
       subscription_service.second->ShouldStartRequest(
           url, resource_type, tab_host, aggressive_blocking, did_match_rule,
           did_match_exception, did_match_important, mock_data_url);
@@ -385,12 +436,53 @@ void AdBlockSubscriptionServiceManager::ShouldStartRequest(
   }
 }
 
+void AdBlockSubscriptionServiceManager::ShouldStartRequests(
+    const std::vector<AdBlockRequest*>& requests) {
+  if (unified_service_) {
+    AdBlockEngineStats::ScopedBatchSample sample(
+        [] { return std::string("subscriptions:unified"); }, requests);
+    unified_service_->ShouldStartRequests(requests);
+    return;
+  }
+
+  base::AutoLock lock(subscription_services_lock_);
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (info && info->enabled) {
+      AdBlockEngineStats::ScopedBatchSample sample(
+          [&] { return "subscription:" + subscription_service.first.spec(); },
+          requests);
+      subscription_service.second->ShouldStartRequests(requests);
+    }
+  }
+}
+
+bool AdBlockSubscriptionServiceManager::MayMatchFirstPartyRequest(
+    const std::string& request_host,
+    const std::string& tab_host) {
+  if (unified_service_)
+    return unified_service_->MayMatchFirstPartyRequest(request_host, tab_host);
+
+  base::AutoLock lock(subscription_services_lock_);
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (info && info->enabled &&
+        subscription_service.second->MayMatchFirstPartyRequest(request_host,
+                                                               tab_host)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void AdBlockSubscriptionServiceManager::EnableTag(const std::string& tag,
                                                   bool enabled) {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   for (const auto& subscription_service : subscription_services_) {
     subscription_service.second->EnableTag(tag, enabled);
   }
+  if (unified_service_)
+    unified_service_->EnableTag(tag, enabled);
 }
 
 void AdBlockSubscriptionServiceManager::AddResources(
@@ -399,6 +491,30 @@ void AdBlockSubscriptionServiceManager::AddResources(
   for (const auto& subscription_service : subscription_services_) {
     subscription_service.second->AddResources(resources);
   }
+  if (unified_service_)
+    unified_service_->AddResources(resources);
+}
+
+absl::optional<GURL> AdBlockSubscriptionServiceManager::GetBlockingSubscription(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking) {
+  base::AutoLock lock(subscription_services_lock_);
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (!info || !info->enabled)
+      continue;
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    subscription_service.second->ShouldStartRequest(
+        url, resource_type, tab_host, aggressive_blocking, &did_match_rule,
+        &did_match_exception, &did_match_important, nullptr);
+    if (did_match_important || (did_match_rule && !did_match_exception))
+      return subscription_service.first;
+  }
+  return absl::nullopt;
 }
 
 absl::optional<base::Value>
@@ -472,6 +588,23 @@ void AdBlockSubscriptionServiceManager::OnSubscriptionDownloaded(
   UpdateSubscriptionPrefs(sub_url, *info);
 
   it->second->ReloadList();
+  RebuildUnifiedService();
+
+  NotifyObserversOfServiceEvent();
+}
+
+// The cached list is still current, so the update counts as successful but
+// the already compiled engines are kept as they are.
+void AdBlockSubscriptionServiceManager::OnSubscriptionNotModified(
+    const GURL& sub_url) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  auto info = GetInfo(sub_url);
+  if (!info)
+    return;
+
+  info->last_update_attempt = base::Time::Now();
+  info->last_successful_update_attempt = info->last_update_attempt;
+  UpdateSubscriptionPrefs(sub_url, *info);
 
   NotifyObserversOfServiceEvent();
 }
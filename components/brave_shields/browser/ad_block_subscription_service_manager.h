@@ -29,6 +29,7 @@ class PrefService;
 
 namespace brave_shields {
 class AdBlockSubscriptionServiceManagerObserver;
+class AdBlockSubscriptionUnifiedService;
 }
 
 class AdBlockServiceTest;
@@ -66,9 +67,23 @@ class AdBlockSubscriptionServiceManager {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url);
+  void ShouldStartRequests(const std::vector<AdBlockRequest*>& requests);
+  // See AdBlockBaseService::MayMatchFirstPartyRequest.
+  bool MayMatchFirstPartyRequest(const std::string& request_host,
+                                 const std::string& tab_host);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
 
+  // Attribution side channel for the unified engine. Returns the enabled
+  // subscription whose own engine blocks the request, if any. This walks
+  // every subscription, so it should only be used once a request is already
+  // known to be blocked.
+  absl::optional<GURL> GetBlockingSubscription(
+      const GURL& url,
+      blink::mojom::ResourceType resource_type,
+      const std::string& tab_host,
+      bool aggressive_blocking);
+
   absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
   absl::optional<base::Value> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
@@ -81,6 +96,7 @@ class AdBlockSubscriptionServiceManager {
 
   void OnSubscriptionDownloadFailure(const GURL& sub_url);
   void OnSubscriptionDownloaded(const GURL& sub_url);
+  void OnSubscriptionNotModified(const GURL& sub_url);
 
   void AddObserver(AdBlockSubscriptionServiceManagerObserver* observer);
   void RemoveObserver(AdBlockSubscriptionServiceManagerObserver* observer);
@@ -104,6 +120,10 @@ class AdBlockSubscriptionServiceManager {
   void OnGetDownloadManager(
       AdBlockSubscriptionDownloadManager* download_manager);
 
+  // Recompiles the unified engine from the currently enabled subscriptions
+  // when kBraveAdblockUnifiedSubscriptionEngine is on.
+  void RebuildUnifiedService();
+
   absl::optional<SubscriptionInfo> GetInfo(const GURL& sub_url);
   void NotifyObserversOfServiceEvent();
 
@@ -119,6 +139,7 @@ class AdBlockSubscriptionServiceManager {
       subscription_services_;
   std::unique_ptr<component_updater::TimerUpdateScheduler>
       subscription_update_timer_;
+  std::unique_ptr<AdBlockSubscriptionUnifiedService> unified_service_;
 
   base::ObserverList<AdBlockSubscriptionServiceManagerObserver> observers_;
   base::Lock subscription_services_lock_;
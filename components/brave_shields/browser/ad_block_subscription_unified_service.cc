@@ -0,0 +1,68 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_subscription_unified_service.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/task/thread_pool.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_component_updater/browser/dat_file_util.h"
+
+namespace brave_shields {
+
+AdBlockSubscriptionUnifiedService::AdBlockSubscriptionUnifiedService(
+    brave_component_updater::BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate) {}
+
+AdBlockSubscriptionUnifiedService::~AdBlockSubscriptionUnifiedService() {}
+
+bool AdBlockSubscriptionUnifiedService::Init() {
+  return AdBlockBaseService::Init();
+}
+
+void AdBlockSubscriptionUnifiedService::Rebuild(
+    const std::vector<base::FilePath>& list_files) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(
+          &brave_component_updater::LoadRawFilesData<adblock::Engine>,
+          list_files),
+      base::BindOnce(&AdBlockSubscriptionUnifiedService::OnRulesLoaded,
+                     weak_factory_.GetWeakPtr(), ++generation_));
+}
+
+void AdBlockSubscriptionUnifiedService::OnRulesLoaded(
+    uint64_t generation,
+    GetDATFileDataResult result) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // A newer rebuild was requested while this one was compiling.
+  if (generation != generation_)
+    return;
+
+  // No enabled subscription had any rules, so fall back to an empty engine,
+  // which can't match anything.
+  std::unique_ptr<adblock::Engine> engine = std::move(result.first);
+  if (!engine) {
+    GetTaskRunner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&AdBlockSubscriptionUnifiedService::UpdateAdBlockClient,
+                       base::Unretained(this),
+                       std::make_unique<adblock::Engine>(),
+                       std::make_unique<AdBlockFirstPartySummary>()));
+    return;
+  }
+
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          &AdBlockSubscriptionUnifiedService::UpdateAdBlockClientWithRules,
+          base::Unretained(this), std::move(engine),
+          std::move(result.second)));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SUBSCRIPTION_UNIFIED_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SUBSCRIPTION_UNIFIED_SERVICE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+
+namespace brave_shields {
+
+// Compiles the filter list text of every enabled subscription into a single
+// adblock engine, so network requests only need one match call regardless of
+// how many subscriptions are enabled.
+class AdBlockSubscriptionUnifiedService : public AdBlockBaseService {
+ public:
+  explicit AdBlockSubscriptionUnifiedService(
+      brave_component_updater::BraveComponent::Delegate* delegate);
+  ~AdBlockSubscriptionUnifiedService() override;
+
+  // Rebuilds the engine off-thread from |list_files|. Rebuilds requested
+  // while another one is still in flight supersede it.
+  void Rebuild(const std::vector<base::FilePath>& list_files);
+
+ protected:
+  bool Init() override;
+
+ private:
+  void OnRulesLoaded(uint64_t generation, GetDATFileDataResult result);
+
+  uint64_t generation_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<AdBlockSubscriptionUnifiedService> weak_factory_{this};
+
+  AdBlockSubscriptionUnifiedService(const AdBlockSubscriptionUnifiedService&) =
+      delete;
+  AdBlockSubscriptionUnifiedService& operator=(
+      const AdBlockSubscriptionUnifiedService&) = delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_SUBSCRIPTION_UNIFIED_SERVICE_H_
@@ -10,8 +10,12 @@
 
 #include "base/compiler_specific.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "net/base/data_url.h"
 #include "net/http/http_util.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -94,40 +98,104 @@ const unsigned char kJpeg1x1[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xda, 0x00, 0x08,
     0x01, 0x01, 0x00, 0x00, 0x3f, 0x00, 0x37, 0xff, 0xd9};
 
+// Redirect resources are a small fixed set, so this comfortably holds every
+// stub a session serves.
+constexpr size_t kMaxDecodedDataURLs = 64;
+
+scoped_refptr<base::RefCountedString> MakeBody(const unsigned char* begin,
+                                               const unsigned char* end) {
+  std::string body(begin, end);
+  return base::RefCountedString::TakeString(&body);
+}
+
+scoped_refptr<base::RefCountedString> EmptyBody() {
+  static const base::NoDestructor<scoped_refptr<base::RefCountedString>> empty(
+      base::MakeRefCounted<base::RefCountedString>());
+  return *empty;
+}
+
 // Basically, for now all Chromium image resource requests use hardcoded
 // 'Accept' header that starts with "image/webp". However, it is possible to
 // craft a custom 'Accept', for example, using XHR, so we provide stubs for
 // other popular mime types.
-std::string GetContentForMimeType(const std::string& mime_type) {
-  static const base::NoDestructor<base::flat_map<std::string, std::string>>
-      content({
-          {"image/avif", {kAvif1x1, std::end(kAvif1x1)}},
-          {"image/webp", {kWebp1x1, std::end(kWebp1x1)}},
-          {"image/*", {kPng1x1, std::end(kPng1x1)}},
-          {"image/apng", {kPng1x1, std::end(kPng1x1)}},
-          {"image/png", {kPng1x1, std::end(kPng1x1)}},
-          {"image/x-png", {kPng1x1, std::end(kPng1x1)}},
-          {"image/gif", {kGif1x1, std::end(kGif1x1)}},
-          {"image/jpeg", {kJpeg1x1, std::end(kJpeg1x1)}},
-      });
+scoped_refptr<base::RefCountedString> GetContentForMimeType(
+    const std::string& mime_type) {
+  static const base::NoDestructor<
+      base::flat_map<std::string, scoped_refptr<base::RefCountedString>>>
+      content([] {
+        auto png = MakeBody(kPng1x1, std::end(kPng1x1));
+        return base::flat_map<std::string,
+                              scoped_refptr<base::RefCountedString>>({
+            {"image/avif", MakeBody(kAvif1x1, std::end(kAvif1x1))},
+            {"image/webp", MakeBody(kWebp1x1, std::end(kWebp1x1))},
+            {"image/*", png},
+            {"image/apng", png},
+            {"image/png", png},
+            {"image/x-png", png},
+            {"image/gif", MakeBody(kGif1x1, std::end(kGif1x1))},
+            {"image/jpeg", MakeBody(kJpeg1x1, std::end(kJpeg1x1))},
+        });
+      }());
   auto it = content->find(mime_type);
   if (it == content->end()) {
-    return {};
+    return EmptyBody();
   }
   return it->second;
 }
 
+struct DecodedDataURL {
+  // Empty when the data URL doesn't name a type of its own.
+  std::string mime_type;
+  scoped_refptr<base::RefCountedString> body;
+};
+
+// The same few redirect resources are served over and over, so each data URL
+// is only parsed and base64-decoded the first time it's seen.
+class DecodedDataURLCache {
+ public:
+  DecodedDataURLCache() : decoded_(kMaxDecodedDataURLs) {}
+
+  absl::optional<DecodedDataURL> Get(const std::string& data_url) {
+    {
+      base::AutoLock lock(lock_);
+      auto it = decoded_.Get(data_url);
+      if (it != decoded_.end())
+        return it->second;
+    }
+
+    std::string charset;
+    std::string mime_type;
+    std::string body;
+    if (!net::DataURL::Parse(GURL(data_url), &mime_type, &charset, &body)) {
+      LOG(ERROR) << "Could not parse ad-block data URL: " << data_url;
+      return absl::nullopt;
+    }
+    DecodedDataURL decoded;
+    if (!base::StartsWith(data_url, "data:,"))
+      decoded.mime_type = std::move(mime_type);
+    decoded.body = base::RefCountedString::TakeString(&body);
+
+    base::AutoLock lock(lock_);
+    decoded_.Put(data_url, decoded);
+    return decoded;
+  }
+
+ private:
+  base::Lock lock_;
+  base::MRUCache<std::string, DecodedDataURL> decoded_ GUARDED_BY(lock_);
+};
+
 }  // namespace
 
 void MakeStubResponse(const absl::optional<std::string>& data_url,
                       const network::ResourceRequest& request,
                       network::mojom::URLResponseHeadPtr* response,
-                      std::string* data) {
+                      scoped_refptr<base::RefCountedString>* data) {
   DCHECK(response && *response);
   DCHECK(data);
 
   (*response)->mime_type = "text/html";
-  *data = {};
+  *data = EmptyBody();
 
   // Possibly overwrite mime and stub data.
   std::string accept_header;
@@ -145,16 +213,13 @@ void MakeStubResponse(const absl::optional<std::string>& data_url,
   }
 
   if (data_url.has_value() && !data_url->empty()) {
-    std::string charset;
-    std::string mime_type;
-    std::string url_data;
-    if (!net::DataURL::Parse(GURL(data_url.value()), &mime_type, &charset,
-                             &url_data)) {
-      LOG(ERROR) << "Could not parse ad-block data URL: " << data_url.value();
-    } else {
-      *data = std::move(url_data);
-      if (!mime_type.empty() && data_url.value().find("data:,") != 0) {
-        (*response)->mime_type = mime_type;
+    static base::NoDestructor<DecodedDataURLCache> decoded_data_urls;
+    absl::optional<DecodedDataURL> decoded =
+        decoded_data_urls->Get(data_url.value());
+    if (decoded) {
+      *data = std::move(decoded->body);
+      if (!decoded->mime_type.empty()) {
+        (*response)->mime_type = std::move(decoded->mime_type);
       }
     }
   }
@@ -7,6 +7,9 @@
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_ADBLOCK_STUB_RESPONSE_H_
 
 #include <string>
+
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/scoped_refptr.h"
 #include "services/network/public/mojom/url_response_head.mojom-forward.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
@@ -17,11 +20,13 @@ struct ResourceRequest;
 namespace brave_shields {
 
 // Intercepts certain requests and blocks them by silently returning 200 OK
-// and not allowing them to hit the network.
+// and not allowing them to hit the network. |data| is set to the body, which
+// is shared between every stub served from the same resource and must not be
+// modified.
 void MakeStubResponse(const absl::optional<std::string>& data_url,
                       const network::ResourceRequest& request,
                       network::mojom::URLResponseHeadPtr* response,
-                      std::string* data);
+                      scoped_refptr<base::RefCountedString>* data);
 
 }  // namespace brave_shields
 
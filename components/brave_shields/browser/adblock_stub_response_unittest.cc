@@ -11,50 +11,63 @@
 TEST(AdBlockStubResponse, ScriptDataURL) {
   std::string data_url =
       "data:application/script,<script>alert('hi');</script>";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, {}, &resource_response, &data);
-  ASSERT_EQ(data, "<script>alert('hi');</script>");
+  ASSERT_EQ(data->data(), "<script>alert('hi');</script>");
   ASSERT_EQ(resource_response->mime_type, "application/script");
 }
 
 TEST(AdBlockStubResponse, HTMLDataURL) {
   std::string data_url = "data:text/html,<strong>π</strong>";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, {}, &resource_response, &data);
-  ASSERT_EQ(data, "<strong>π</strong>");
+  ASSERT_EQ(data->data(), "<strong>π</strong>");
   ASSERT_EQ(resource_response->mime_type, "text/html");
 }
 
 TEST(AdBlockStubResponse, HTMLDataURLPrioritizedOverRequestInfo) {
   std::string data_url = "data:text/xml,pi";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   network::ResourceRequest request;
   request.headers.AddHeadersFromString("Accept: image/svg");
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, request, &resource_response, &data);
-  ASSERT_EQ(data, "pi");
+  ASSERT_EQ(data->data(), "pi");
   ASSERT_EQ(resource_response->mime_type, "text/xml");
 }
 
 TEST(AdBlockStubResponse, AcceptHeaderUsedNoDataURL) {
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   network::ResourceRequest request;
   request.headers.AddHeadersFromString("Accept: text/xml");
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse("", request, &resource_response, &data);
-  ASSERT_EQ(data, "");
+  ASSERT_EQ(data->data(), "");
   ASSERT_EQ(resource_response->mime_type, "text/xml");
 }
 
 TEST(AdBlockStubResponse, HTMLDataURLNoMimeTypeUsesAcceptHeader) {
   std::string data_url = "data:,<num>pi</num>";
-  std::string data;
+  scoped_refptr<base::RefCountedString> data;
   network::ResourceRequest request;
   request.headers.AddHeadersFromString("Accept: text/xml");
   auto resource_response = network::mojom::URLResponseHead::New();
   brave_shields::MakeStubResponse(data_url, request, &resource_response, &data);
-  ASSERT_EQ(data, "<num>pi</num>");
+  ASSERT_EQ(data->data(), "<num>pi</num>");
   ASSERT_EQ(resource_response->mime_type, "text/xml");
 }
+
+TEST(AdBlockStubResponse, DataURLDecodedOnce) {
+  std::string data_url =
+      "data:text/javascript;base64,KGZ1bmN0aW9uKCkge30pKCk=";
+  scoped_refptr<base::RefCountedString> first;
+  scoped_refptr<base::RefCountedString> second;
+  auto resource_response = network::mojom::URLResponseHead::New();
+  brave_shields::MakeStubResponse(data_url, {}, &resource_response, &first);
+  brave_shields::MakeStubResponse(data_url, {}, &resource_response, &second);
+  ASSERT_EQ(first->data(), "(function() {})()");
+  ASSERT_EQ(first.get(), second.get());
+  ASSERT_EQ(resource_response->mime_type, "text/javascript");
+}
@@ -10,6 +10,7 @@
 #include "base/feature_list.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_shields/browser/brave_shields_p3a.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
 #include "brave/components/brave_shields/common/features.h"
@@ -55,6 +56,27 @@ ContentSetting GetDefaultBlockFromControlType(ControlType type) {
                                     : CONTENT_SETTING_BLOCK;
 }
 
+// Resolves |setting| for |url| through the profile's settings cache, if it has
+// one.
+template <typename Compute>
+ContentSetting GetCachedSetting(HostContentSettingsMap* map,
+                                const GURL& url,
+                                ShieldsSettingsCache::Setting setting,
+                                Compute compute) {
+  ShieldsSettingsCache* cache = ShieldsSettingsCache::FromMap(map);
+  return cache ? cache->Get(url, setting, compute) : compute();
+}
+
+ContentSetting GetCachedContentSetting(HostContentSettingsMap* map,
+                                       const GURL& url,
+                                       const GURL& secondary_url,
+                                       ContentSettingsType type,
+                                       ShieldsSettingsCache::Setting setting) {
+  return GetCachedSetting(map, url, setting, [&]() {
+    return map->GetContentSetting(url, secondary_url, type);
+  });
+}
+
 }  // namespace
 
 ContentSettingsPattern GetPatternFromURL(const GURL& url) {
@@ -140,8 +162,9 @@ bool GetBraveShieldsEnabled(HostContentSettingsMap* map, const GURL& url) {
   if (url.is_valid() && !url.SchemeIsHTTPOrHTTPS())
     return false;
 
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_SHIELDS);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_SHIELDS,
+      ShieldsSettingsCache::Setting::kShields);
 
   // see EnableBraveShields - allow and default == true
   return setting == CONTENT_SETTING_BLOCK ? false : true;
@@ -170,8 +193,9 @@ void SetAdControlType(HostContentSettingsMap* map,
 }
 
 ControlType GetAdControlType(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_ADS);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_ADS,
+      ShieldsSettingsCache::Setting::kAds);
 
   return setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
                                           : ControlType::BLOCK;
@@ -203,12 +227,14 @@ void SetCosmeticFilteringControlType(HostContentSettingsMap* map,
 
 ControlType GetCosmeticFilteringControlType(HostContentSettingsMap* map,
                                             const GURL& url) {
-  ContentSetting setting = map->GetContentSetting(
-      url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_COSMETIC_FILTERING,
+      ShieldsSettingsCache::Setting::kCosmeticFiltering);
 
-  ContentSetting fp_setting =
-      map->GetContentSetting(url, GURL("https://firstParty/"),
-                             ContentSettingsType::BRAVE_COSMETIC_FILTERING);
+  ContentSetting fp_setting = GetCachedContentSetting(
+      map, url, GURL("https://firstParty/"),
+      ContentSettingsType::BRAVE_COSMETIC_FILTERING,
+      ShieldsSettingsCache::Setting::kCosmeticFilteringFirstParty);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -295,11 +321,13 @@ void SetCookieControlType(HostContentSettingsMap* map,
 // TODO(bridiver) - convert cookie settings to ContentSettingsType::COOKIES
 // while maintaining read backwards compat
 ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_COOKIES);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_COOKIES,
+      ShieldsSettingsCache::Setting::kCookies);
 
-  ContentSetting fp_setting = map->GetContentSetting(
-      url, GURL("https://firstParty/"), ContentSettingsType::BRAVE_COOKIES);
+  ContentSetting fp_setting = GetCachedContentSetting(
+      map, url, GURL("https://firstParty/"), ContentSettingsType::BRAVE_COOKIES,
+      ShieldsSettingsCache::Setting::kCookiesFirstParty);
 
   if (setting == CONTENT_SETTING_ALLOW) {
     return ControlType::ALLOW;
@@ -311,8 +339,9 @@ ControlType GetCookieControlType(HostContentSettingsMap* map, const GURL& url) {
 }
 
 bool AllowReferrers(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::BRAVE_REFERRERS);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_REFERRERS,
+      ShieldsSettingsCache::Setting::kReferrers);
 
   return setting == CONTENT_SETTING_ALLOW;
 }
@@ -352,12 +381,13 @@ void SetFingerprintingControlType(HostContentSettingsMap* map,
 
 ControlType GetFingerprintingControlType(HostContentSettingsMap* map,
                                          const GURL& url) {
-  ContentSettingsForOneType fingerprinting_rules;
-  map->GetSettingsForOneType(ContentSettingsType::BRAVE_FINGERPRINTING_V2,
-                             &fingerprinting_rules);
-
-  ContentSetting fp_setting =
-      GetBraveFPContentSettingFromRules(fingerprinting_rules, url);
+  ContentSetting fp_setting = GetCachedSetting(
+      map, url, ShieldsSettingsCache::Setting::kFingerprinting, [&]() {
+        ContentSettingsForOneType fingerprinting_rules;
+        map->GetSettingsForOneType(ContentSettingsType::BRAVE_FINGERPRINTING_V2,
+                                   &fingerprinting_rules);
+        return GetBraveFPContentSettingFromRules(fingerprinting_rules, url);
+      });
   if (fp_setting == CONTENT_SETTING_DEFAULT)
     return ControlType::DEFAULT;
   return fp_setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
@@ -398,8 +428,9 @@ void ResetHTTPSEverywhereEnabled(HostContentSettingsMap* map,
 }
 
 bool GetHTTPSEverywhereEnabled(HostContentSettingsMap* map, const GURL& url) {
-  ContentSetting setting = map->GetContentSetting(
-      url, GURL(), ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES,
+      ShieldsSettingsCache::Setting::kHTTPSEverywhere);
 
   return setting == CONTENT_SETTING_ALLOW ? false : true;
 }
@@ -424,8 +455,9 @@ void SetNoScriptControlType(HostContentSettingsMap* map,
 
 ControlType GetNoScriptControlType(HostContentSettingsMap* map,
                                    const GURL& url) {
-  ContentSetting setting =
-      map->GetContentSetting(url, GURL(), ContentSettingsType::JAVASCRIPT);
+  ContentSetting setting = GetCachedContentSetting(
+      map, url, GURL(), ContentSettingsType::JAVASCRIPT,
+      ShieldsSettingsCache::Setting::kNoScript);
 
   return setting == CONTENT_SETTING_ALLOW ? ControlType::ALLOW
                                           : ControlType::BLOCK;
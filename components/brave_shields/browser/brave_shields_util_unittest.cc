@@ -6,7 +6,9 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/test/scoped_feature_list.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "build/build_config.h"
@@ -21,7 +23,9 @@ using brave_shields::ControlType;
 using brave_shields::ControlTypeFromString;
 using brave_shields::ControlTypeToString;
 using brave_shields::GetPatternFromURL;
+using brave_shields::ShieldsSettingsCache;
 using brave_shields::features::kBraveDomainBlock;
+using brave_shields::features::kBraveShieldsSettingsCache;
 
 class BraveShieldsUtilTest : public testing::Test {
  public:
@@ -49,6 +53,27 @@ class BraveShieldsUtilDomainBlockFeatureTest : public BraveShieldsUtilTest {
   base::test::ScopedFeatureList feature_list_;
 };
 
+class BraveShieldsUtilSettingsCacheTest : public BraveShieldsUtilTest {
+ public:
+  BraveShieldsUtilSettingsCacheTest() {
+    feature_list_.InitAndEnableFeature(kBraveShieldsSettingsCache);
+  }
+
+  void SetUp() override {
+    BraveShieldsUtilTest::SetUp();
+    cache_ = std::make_unique<ShieldsSettingsCache>(
+        HostContentSettingsMapFactory::GetForProfile(profile()));
+  }
+
+  void TearDown() override { cache_.reset(); }
+
+  ShieldsSettingsCache* cache() { return cache_.get(); }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+  std::unique_ptr<ShieldsSettingsCache> cache_;
+};
+
 TEST_F(BraveShieldsUtilTest, GetPatternFromURL) {
   // wildcard
   auto pattern = GetPatternFromURL(GURL());
@@ -929,3 +954,50 @@ TEST_F(BraveShieldsUtilTest, ShouldDoDomainBlocking_ControlTypes) {
   setting = brave_shields::ShouldDoDomainBlocking(map, url);
   EXPECT_EQ(true, setting);
 }
+
+TEST_F(BraveShieldsUtilSettingsCacheTest, CachesPerOrigin) {
+  auto* map = HostContentSettingsMapFactory::GetForProfile(profile());
+  EXPECT_EQ(cache(), ShieldsSettingsCache::FromMap(map));
+
+  const GURL url("https://brave.com/page");
+  EXPECT_TRUE(brave_shields::GetBraveShieldsEnabled(map, url));
+  EXPECT_EQ(ControlType::DEFAULT,
+            brave_shields::GetFingerprintingControlType(map, url));
+  EXPECT_EQ(2u, cache()->size());
+
+  // Other paths of the same origin hit the same entries.
+  EXPECT_TRUE(
+      brave_shields::GetBraveShieldsEnabled(map, GURL("https://brave.com/")));
+  EXPECT_EQ(2u, cache()->size());
+
+  // Defaults and non-http(s) URLs aren't cached.
+  brave_shields::GetFingerprintingControlType(map, GURL());
+  brave_shields::GetBraveShieldsEnabled(map, GURL("chrome://settings"));
+  EXPECT_EQ(2u, cache()->size());
+}
+
+TEST_F(BraveShieldsUtilSettingsCacheTest, InvalidatedBySettingChanges) {
+  auto* map = HostContentSettingsMapFactory::GetForProfile(profile());
+  const GURL url("https://brave.com");
+  const uint64_t generation = cache()->generation();
+
+  EXPECT_TRUE(brave_shields::GetBraveShieldsEnabled(map, url));
+  EXPECT_EQ(ControlType::DEFAULT,
+            brave_shields::GetFingerprintingControlType(map, url));
+
+  brave_shields::SetBraveShieldsEnabled(map, false, url);
+  EXPECT_NE(generation, cache()->generation());
+  EXPECT_FALSE(brave_shields::GetBraveShieldsEnabled(map, url));
+
+  brave_shields::SetFingerprintingControlType(map, ControlType::BLOCK, url);
+  EXPECT_EQ(ControlType::BLOCK,
+            brave_shields::GetFingerprintingControlType(map, url));
+
+  // A default change applies to every cached origin.
+  const GURL other_url("https://example.com");
+  EXPECT_EQ(ControlType::DEFAULT,
+            brave_shields::GetFingerprintingControlType(map, other_url));
+  brave_shields::SetFingerprintingControlType(map, ControlType::ALLOW, GURL());
+  EXPECT_EQ(ControlType::ALLOW,
+            brave_shields::GetFingerprintingControlType(map, other_url));
+}
@@ -28,3 +28,34 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Sharded) {
+  using Cache = HTTPSERecentlyUsedCache<std::string>;
+  Cache cache(64, 8);
+
+  for (int i = 0; i < 64; i++) {
+    const std::string key = "k" + std::to_string(i);
+    cache.add(key, "v" + std::to_string(i));
+  }
+  // Every key lands in exactly one shard, so whatever is still cached has
+  // to come back with its own value.
+  size_t hits = 0;
+  for (int i = 0; i < 64; i++) {
+    std::string v;
+    if (cache.get("k" + std::to_string(i), &v)) {
+      ASSERT_EQ(v, "v" + std::to_string(i));
+      hits++;
+    }
+  }
+  ASSERT_GT(hits, 0u);
+  ASSERT_EQ(cache.size(), hits);
+
+  cache.remove("k0");
+  std::string v;
+  ASSERT_FALSE(cache.get("k0", &v));
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0u);
+  for (int i = 0; i < 64; i++)
+    ASSERT_FALSE(cache.get("k" + std::to_string(i), &v));
+}
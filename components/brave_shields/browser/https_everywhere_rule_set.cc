@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+HTTPSERuleSet::Rule::Rule() = default;
+HTTPSERuleSet::Rule::Rule(Rule&&) = default;
+HTTPSERuleSet::Rule::~Rule() = default;
+
+HTTPSERuleSet::RuleSet::RuleSet() = default;
+HTTPSERuleSet::RuleSet::RuleSet(RuleSet&&) = default;
+HTTPSERuleSet::RuleSet::~RuleSet() = default;
+
+HTTPSERuleSet::HTTPSERuleSet() = default;
+HTTPSERuleSet::~HTTPSERuleSet() = default;
+
+// static
+std::string HTTPSERuleSet::CorrectToRuleForRE2(const std::string& to) {
+  std::string corrected_to(to);
+  size_t pos = corrected_to.find("$");
+  while (std::string::npos != pos) {
+    corrected_to[pos] = '\\';
+    pos = corrected_to.find("$", pos + 1);
+  }
+  return corrected_to;
+}
+
+// static
+std::unique_ptr<HTTPSERuleSet> HTTPSERuleSet::Parse(const std::string& json) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return nullptr;
+
+  auto rule_set = base::WrapUnique(new HTTPSERuleSet());
+  for (const auto& top_value : json_object->GetList()) {
+    if (!top_value.is_dict())
+      continue;
+
+    RuleSet compiled;
+    if (const base::Value* exclusions = top_value.FindListKey("e")) {
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        compiled.exclusions.push_back(
+            std::make_unique<re2::RE2>(CorrectToRuleForRE2(*pattern)));
+      }
+    }
+
+    const base::Value* rules = top_value.FindListKey("r");
+    compiled.has_rules = rules != nullptr;
+    if (rules) {
+      for (const auto& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict())
+          continue;
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.upgrade_scheme = true;
+          compiled.rules.push_back(std::move(rule));
+          continue;
+        }
+        const std::string* from = rule_value.FindStringKey("f");
+        const std::string* to = rule_value.FindStringKey("t");
+        if (!from || !to)
+          continue;
+        rule.from = std::make_unique<re2::RE2>(*from);
+        rule.to = CorrectToRuleForRE2(*to);
+        compiled.rules.push_back(std::move(rule));
+      }
+    }
+
+    rule_set->rule_sets_.push_back(std::move(compiled));
+  }
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& original_url) const {
+  for (const auto& rule_set : rule_sets_) {
+    for (const auto& exclusion : rule_set.exclusions) {
+      if (re2::RE2::FullMatch(original_url, *exclusion))
+        return "";
+    }
+
+    if (!rule_set.has_rules)
+      return "";
+
+    for (const auto& rule : rule_set.rules) {
+      if (rule.upgrade_scheme) {
+        std::string new_url(original_url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(original_url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != original_url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
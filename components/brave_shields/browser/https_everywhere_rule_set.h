@@ -0,0 +1,71 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The compiled form of the JSON rules stored in the HTTPS Everywhere database
+// for a single lookup domain. All exclusion and rewrite patterns are turned
+// into RE2 objects once, so applying the rules to a URL is just a series of
+// regex matches with no JSON parsing.
+class HTTPSERuleSet {
+ public:
+  ~HTTPSERuleSet();
+
+  // Returns nullptr if |json| isn't a list of rulesets.
+  static std::unique_ptr<HTTPSERuleSet> Parse(const std::string& json);
+
+  // Converts the `$1` backreferences used by HTTPS Everywhere into the `\1`
+  // syntax understood by RE2.
+  static std::string CorrectToRuleForRE2(const std::string& to);
+
+  // Returns the rewritten URL, or an empty string if no rule applies.
+  std::string Apply(const std::string& original_url) const;
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    ~Rule();
+
+    // Rules with a "d" key simply upgrade the scheme.
+    bool upgrade_scheme = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct RuleSet {
+    RuleSet();
+    RuleSet(RuleSet&&);
+    ~RuleSet();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // Mirrors the original lookup: a ruleset without an "r" entry stops
+    // evaluation altogether.
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERuleSet();
+
+  std::vector<RuleSet> rule_sets_;
+
+  HTTPSERuleSet(const HTTPSERuleSet&) = delete;
+  HTTPSERuleSet& operator=(const HTTPSERuleSet&) = delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
@@ -0,0 +1,48 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(HTTPSERuleSetTest, InvalidJson) {
+  EXPECT_FALSE(HTTPSERuleSet::Parse("not json"));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{\"r\": []}"));
+}
+
+TEST(HTTPSERuleSetTest, RewriteRules) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      "[{\"r\": [{\"f\": \"^http://(www\\\\.)?example\\\\.com/\","
+      "\"t\": \"https://$1example.com/\"}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://www.example.com/path"),
+            "https://www.example.com/path");
+  EXPECT_EQ(rule_set->Apply("http://other.com/"), "");
+}
+
+TEST(HTTPSERuleSetTest, DefaultRuleUpgradesScheme) {
+  auto rule_set = HTTPSERuleSet::Parse("[{\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/"), "https://example.com/");
+}
+
+TEST(HTTPSERuleSetTest, ExclusionsWin) {
+  auto rule_set = HTTPSERuleSet::Parse(
+      "[{\"e\": [{\"p\": \"^http://example\\\\.com/plain.*\"}],"
+      "\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/plain/page"), "");
+  EXPECT_EQ(rule_set->Apply("http://example.com/secure"),
+            "https://example.com/secure");
+}
+
+TEST(HTTPSERuleSetTest, CorrectToRuleForRE2) {
+  EXPECT_EQ(HTTPSERuleSet::CorrectToRuleForRE2("https://$1.example.com/$2"),
+            "https://\\1.example.com/\\2");
+}
+
+}  // namespace brave_shields
@@ -12,16 +12,20 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
@@ -101,11 +105,19 @@ HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
+      recently_used_cache_(features::kBraveHTTPSEverywhereCacheSize.Get(),
+                           features::kBraveHTTPSEverywhereCacheShards.Get()),
+      no_rule_hosts_cache_(features::kBraveHTTPSEverywhereCacheSize.Get(),
+                           features::kBraveHTTPSEverywhereCacheShards.Get()),
+      rule_set_cache_(features::kBraveHTTPSEverywhereCacheSize.Get(),
+                      features::kBraveHTTPSEverywhereCacheShards.Get()),
       level_db_(nullptr) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
   GetTaskRunner()->DeleteSoon(FROM_HERE, level_db_);
 }
 
@@ -113,6 +125,37 @@ bool HTTPSEverywhereService::Init() {
   Register(kHTTPSEverywhereComponentName,
            g_https_everywhere_component_id_,
            g_https_everywhere_component_base64_public_key_);
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE, base::BindRepeating(&HTTPSEverywhereService::OnMemoryPressure,
+                                     base::Unretained(this)));
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "HTTPSEverywhere", base::ThreadTaskRunnerHandle::Get());
+  return true;
+}
+
+void HTTPSEverywhereService::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  // Everything cached can be looked up again in the database.
+  recently_used_cache_.clear();
+  no_rule_hosts_cache_.clear();
+  rule_set_cache_.clear();
+}
+
+bool HTTPSEverywhereService::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  auto add_cache_dump = [pmd](const char* name, size_t count) {
+    base::trace_event::MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(
+        std::string("brave/https_everywhere/") + name);
+    dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                    base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                    count);
+  };
+  add_cache_dump("recently_used_cache", recently_used_cache_.size());
+  add_cache_dump("no_rule_hosts_cache", no_rule_hosts_cache_.size());
+  add_cache_dump("rule_set_cache", rule_set_cache_.size());
   return true;
 }
 
@@ -129,6 +172,10 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
   }
 
   CloseDatabase();
+  // Cached results belong to the previous version of the rules.
+  recently_used_cache_.clear();
+  no_rule_hosts_cache_.clear();
+  rule_set_cache_.clear();
 
   leveldb::Options options;
   leveldb::Status status =
@@ -181,13 +228,21 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
+  bool no_rule = false;
+  if (no_rule_hosts_cache_.get(candidate_url.host(), &no_rule))
+    return false;
+
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.GetHTTPSURL");
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
+  bool found_rule = false;
   for (auto domain : domains) {
     std::string value = leveldbGet(level_db_, domain);
     if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
+      found_rule = true;
+      std::shared_ptr<const HTTPSERuleSet> rule_set =
+          GetRuleSet(domain, value);
+      *new_url = rule_set ? rule_set->Apply(candidate_url.spec()) : "";
       if (0 != new_url->length()) {
         recently_used_cache_.add(candidate_url.spec(), *new_url);
         AddHTTPSEUrlToRedirectList(request_identifier);
@@ -195,6 +250,10 @@ bool HTTPSEverywhereService::GetHTTPSURL(
       }
     }
   }
+  // Only remember hosts without any rule. A rule that exists but doesn't
+  // rewrite this particular URL may still rewrite other URLs on the host.
+  if (!found_rule)
+    no_rule_hosts_cache_.add(candidate_url.host(), true);
   recently_used_cache_.remove(candidate_url.spec());
   return false;
 }
@@ -262,116 +321,17 @@ void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
   }
 }
 
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (absl::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  base::Value::ConstListView topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
+std::shared_ptr<const HTTPSERuleSet> HTTPSEverywhereService::GetRuleSet(
+    const std::string& domain,
+    const std::string& rules_json) {
+  std::shared_ptr<const HTTPSERuleSet> rule_set;
+  if (rule_set_cache_.get(domain, &rule_set))
+    return rule_set;
+
+  rule_set = HTTPSERuleSet::Parse(rules_json);
+  if (rule_set)
+    rule_set_cache_.add(domain, rule_set);
+  return rule_set;
 }
 
 void HTTPSEverywhereService::CloseDatabase() {
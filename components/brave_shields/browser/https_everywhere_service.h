@@ -11,9 +11,11 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
 
@@ -23,6 +25,10 @@ class DB;
 
 class HTTPSEverywhereServiceTest;
 
+namespace brave_shields {
+class HTTPSERuleSet;
+}  // namespace brave_shields
+
 using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
@@ -44,10 +50,15 @@ struct HTTPSE_REDIRECTS_COUNT_ST {
 };
 
 class HTTPSEverywhereService : public BaseBraveShieldsService,
+                         public base::trace_event::MemoryDumpProvider,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
  public:
   explicit HTTPSEverywhereService(BraveComponent::Delegate* delegate);
   ~HTTPSEverywhereService() override;
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
   bool GetHTTPSURL(const GURL* url,
                    const uint64_t& request_id,
                    std::string* new_url);
@@ -63,9 +74,11 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled form of the rules stored for |domain|, compiling
+  // and caching |rules_json| on first use.
+  std::shared_ptr<const HTTPSERuleSet> GetRuleSet(
+      const std::string& domain,
+      const std::string& rules_json);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -78,13 +91,23 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
       const std::string& component_base64_public_key);
 
   void CloseDatabase();
+  // The caches are locked, so this doesn't need the task runner.
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
 
   void InitDB(const base::FilePath& install_dir);
 
   base::Lock httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  // Hosts for which none of the lookup domains has a rule in the database.
+  HTTPSERecentlyUsedCache<bool> no_rule_hosts_cache_;
+  // Compiled rules keyed on lookup domain, so JSON parsing and RE2
+  // compilation only happen once per domain.
+  HTTPSERecentlyUsedCache<std::shared_ptr<const HTTPSERuleSet>>
+      rule_set_cache_;
   leveldb::DB* level_db_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
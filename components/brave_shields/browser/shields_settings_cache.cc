@@ -0,0 +1,80 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include <map>
+
+#include "base/feature_list.h"
+#include "base/no_destructor.h"
+#include "brave/components/brave_shields/common/features.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Only touched on the UI thread.
+std::map<HostContentSettingsMap*, ShieldsSettingsCache*>& GetCaches() {
+  static base::NoDestructor<
+      std::map<HostContentSettingsMap*, ShieldsSettingsCache*>>
+      caches;
+  return *caches;
+}
+
+}  // namespace
+
+ShieldsSettingsCache::ShieldsSettingsCache(HostContentSettingsMap* map,
+                                           size_t max_size)
+    : map_(map), entries_(max_size) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(map_);
+  DCHECK(!GetCaches().count(map_));
+  GetCaches()[map_] = this;
+  map_->AddObserver(this);
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() {
+  Shutdown();
+}
+
+// static
+ShieldsSettingsCache* ShieldsSettingsCache::FromMap(
+    HostContentSettingsMap* map) {
+  if (!map ||
+      !base::FeatureList::IsEnabled(features::kBraveShieldsSettingsCache) ||
+      !content::BrowserThread::CurrentlyOn(content::BrowserThread::UI))
+    return nullptr;
+  auto it = GetCaches().find(map);
+  return it == GetCaches().end() ? nullptr : it->second;
+}
+
+void ShieldsSettingsCache::Shutdown() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!map_)
+    return;
+  map_->RemoveObserver(this);
+  GetCaches().erase(map_);
+  map_ = nullptr;
+  entries_.Clear();
+}
+
+void ShieldsSettingsCache::MaybeInvalidate() {
+  if (entries_generation_ == generation_)
+    return;
+  entries_.Clear();
+  entries_generation_ = generation_;
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  generation_++;
+}
+
+}  // namespace brave_shields
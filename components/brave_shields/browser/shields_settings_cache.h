@@ -0,0 +1,107 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "base/containers/mru_cache.h"
+#include "base/sequence_checker.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+
+// Remembers the content settings brave_shields_util.cc resolves for a site,
+// keyed on (primary URL origin, setting), so the request, frame and API hot
+// paths don't repeat HostContentSettingsMap pattern matching for every
+// request and frame of a page.
+//
+// There is one cache per profile, observing that profile's map. Any content
+// settings change bumps the generation, and a generation mismatch drops the
+// whole cache on the next access. The cache is only used on the UI thread;
+// lookups from other threads go straight to the map.
+class ShieldsSettingsCache : public KeyedService,
+                             public content_settings::Observer {
+ public:
+  // A setting as read by one of the brave_shields_util.cc getters. Some
+  // getters read the same content settings type with two secondary URLs.
+  enum class Setting {
+    kShields,
+    kAds,
+    kCosmeticFiltering,
+    kCosmeticFilteringFirstParty,
+    kCookies,
+    kCookiesFirstParty,
+    kReferrers,
+    kFingerprinting,
+    kHTTPSEverywhere,
+    kNoScript,
+  };
+
+  explicit ShieldsSettingsCache(HostContentSettingsMap* map,
+                                size_t max_size = 1000);
+  ~ShieldsSettingsCache() override;
+
+  // Returns the cache observing |map|, or null if there is none, the cache is
+  // disabled or this isn't the UI thread.
+  static ShieldsSettingsCache* FromMap(HostContentSettingsMap* map);
+
+  // Returns the cached |setting| for |url|'s origin, resolving it with
+  // |compute| on a miss. URLs other than http(s) are never cached.
+  template <typename Compute>
+  ContentSetting Get(const GURL& url, Setting setting, Compute compute) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    if (!url.SchemeIsHTTPOrHTTPS())
+      return compute();
+    MaybeInvalidate();
+    Key key(url::Origin::Create(url), setting);
+    auto it = entries_.Get(key);
+    if (it != entries_.end())
+      return it->second;
+    ContentSetting value = compute();
+    entries_.Put(std::move(key), value);
+    return value;
+  }
+
+  uint64_t generation() const { return generation_; }
+  size_t size() const { return entries_.size(); }
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  using Key = std::pair<url::Origin, Setting>;
+
+  // Clears the cache if the generation moved on since it was filled.
+  void MaybeInvalidate();
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  HostContentSettingsMap* map_;
+  base::MRUCache<Key, ContentSetting> entries_;
+  uint64_t generation_ = 0;
+  uint64_t entries_generation_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  ShieldsSettingsCache(const ShieldsSettingsCache&) = delete;
+  ShieldsSettingsCache& operator=(const ShieldsSettingsCache&) = delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_CACHE_H_
@@ -38,6 +38,11 @@ const char kObsoleteFingerprinting[] = "fingerprinting";
 const base::FilePath::CharType kCustomSubscriptionListText[] =
     FPL("list_text.txt");
 
+// Filename for the HTTP validators and content hash of the cached list text,
+// used to make conditional requests for list updates
+const base::FilePath::CharType kCustomSubscriptionListValidators[] =
+    FPL("list_validators.json");
+
 }  // namespace brave_shields
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_CONSTANTS_H_
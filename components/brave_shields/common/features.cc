@@ -21,6 +21,16 @@ const base::Feature kBraveAdblockDefault1pBlocking{
 // substituted for any canonical name found.
 const base::Feature kBraveAdblockCnameUncloaking{
     "BraveAdblockCnameUncloaking", base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, CNAME uncloaking results are cached per profile for
+// `ttl_seconds`, and concurrent lookups of the same host share one DNS query.
+// With `optimistic` set, requests don't wait for an uncached lookup; its
+// result is only applied to later requests for that host.
+const base::Feature kBraveAdblockCnameCache{"BraveAdblockCnameCache",
+                                            base::FEATURE_DISABLED_BY_DEFAULT};
+const base::FeatureParam<int> kBraveAdblockCnameCacheTtlSeconds{
+    &kBraveAdblockCnameCache, "ttl_seconds", 60};
+const base::FeatureParam<bool> kBraveAdblockCnameCacheOptimistic{
+    &kBraveAdblockCnameCache, "optimistic", false};
 // When enabled, Brave will apply HTML element collapsing to all images and
 // iframes that initiate a blocked network request.
 const base::Feature kBraveAdblockCollapseBlockedElements{
@@ -28,8 +38,60 @@ const base::Feature kBraveAdblockCollapseBlockedElements{
 const base::Feature kBraveAdblockCosmeticFiltering{
     "BraveAdblockCosmeticFiltering",
     base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, each adblock engine remembers the classes and ids it has no
+// hide rules for, and skips the engine when a page only reports those.
+const base::Feature kBraveAdblockHiddenSelectorCache{
+    "BraveAdblockHiddenSelectorCache", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, filter list subscriptions are compiled on a small pool of
+// sequences and the compiled engine is cached next to the downloaded list.
+// The list is only re-parsed when its content hash changes.
+const base::Feature kBraveAdblockSubscriptionEngineCache{
+    "BraveAdblockSubscriptionEngineCache", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, filter list subscription updates are requested with the
+// ETag and Last-Modified validators of the cached list, and a downloaded list
+// whose content hash is unchanged does not trigger a reload.
+const base::Feature kBraveAdblockSubscriptionConditionalDownloads{
+    "BraveAdblockSubscriptionConditionalDownloads",
+    base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, adblock checks for network requests that arrive within the
+// same task are coalesced and sent to the adblock engines as one batch.
+const base::Feature kBraveAdblockBatchMatching{
+    "BraveAdblockBatchMatching", base::FEATURE_DISABLED_BY_DEFAULT};
 const base::Feature kBraveAdblockCspRules{
     "BraveAdblockCspRules", base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, the combined adblock decision for a (url, resource type, tab
+// host) tuple is cached until any engine, tag or resource changes.
+const base::Feature kBraveAdblockDecisionCache{
+    "BraveAdblockDecisionCache", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, one in sample_rate adblock engine checks is timed and
+// attributed to its engine for brave://adblock.
+const base::Feature kBraveAdblockEngineStats{"BraveAdblockEngineStats",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+const base::FeatureParam<int> kBraveAdblockEngineStatsSampleRate{
+    &kBraveAdblockEngineStats, "sample_rate", 100};
+// When enabled, first-party requests that no engine's rules could match are
+// allowed right away instead of being sent to the adblock task runner.
+const base::Feature kBraveAdblockFirstPartyFastPath{
+    "BraveAdblockFirstPartyFastPath", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, serialized adblock engines are deserialized directly from a
+// memory mapping of the DAT file instead of being read into a heap buffer
+// first.
+const base::Feature kBraveAdblockMappedDATFiles{
+    "BraveAdblockMappedDATFiles", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, the default and regional adblock engines, resources and
+// regional catalog from the last run are loaded at startup, so that early
+// navigations are filtered before the adblock components are ready.
+const base::Feature kBraveAdblockEngineSnapshot{
+    "BraveAdblockEngineSnapshot", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, rel=preconnect hints to hosts that adblock would block from
+// the page are dropped instead of opening sockets.
+const base::Feature kBraveAdblockPreconnectFiltering{
+    "BraveAdblockPreconnectFiltering", base::FEATURE_DISABLED_BY_DEFAULT};
+// When enabled, all enabled filter list subscriptions are compiled into one
+// adblock engine for network request matching instead of being checked one
+// engine at a time.
+const base::Feature kBraveAdblockUnifiedSubscriptionEngine{
+    "BraveAdblockUnifiedSubscriptionEngine", base::FEATURE_DISABLED_BY_DEFAULT};
 // When enabled, Brave will block domains listed in the user's selected adblock
 // filters and present a security interstitial with choice to proceed and
 // optionally whitelist the domain.
@@ -44,5 +106,17 @@ const base::Feature kBraveExtensionNetworkBlocking{
 // When enabled, Brave will always report Light in Fingerprinting: Strict mode
 const base::Feature kBraveDarkModeBlock{"BraveDarkModeBlock",
                                         base::FEATURE_ENABLED_BY_DEFAULT};
+// Controls the size and sharding of the HTTPS Everywhere rewrite cache and of
+// the cache of hosts known to have no HTTPS Everywhere rule.
+const base::Feature kBraveHTTPSEverywhereCache{
+    "BraveHTTPSEverywhereCache", base::FEATURE_ENABLED_BY_DEFAULT};
+const base::FeatureParam<int> kBraveHTTPSEverywhereCacheSize{
+    &kBraveHTTPSEverywhereCache, "cache_size", 4096};
+const base::FeatureParam<int> kBraveHTTPSEverywhereCacheShards{
+    &kBraveHTTPSEverywhereCache, "shards", 16};
+// When enabled, shields settings resolved for a site are cached per profile
+// until any content setting changes.
+const base::Feature kBraveShieldsSettingsCache{
+    "BraveShieldsSettingsCache", base::FEATURE_DISABLED_BY_DEFAULT};
 }  // namespace features
 }  // namespace brave_shields
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_FEATURES_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_FEATURES_H_
 
+#include "base/metrics/field_trial_params.h"
+
 namespace base {
 struct Feature;
 }  // namespace base
@@ -14,12 +16,31 @@ namespace brave_shields {
 namespace features {
 extern const base::Feature kBraveAdblockDefault1pBlocking;
 extern const base::Feature kBraveAdblockCnameUncloaking;
+extern const base::Feature kBraveAdblockCnameCache;
+extern const base::FeatureParam<int> kBraveAdblockCnameCacheTtlSeconds;
+extern const base::FeatureParam<bool> kBraveAdblockCnameCacheOptimistic;
 extern const base::Feature kBraveAdblockCollapseBlockedElements;
 extern const base::Feature kBraveAdblockCosmeticFiltering;
+extern const base::Feature kBraveAdblockHiddenSelectorCache;
+extern const base::Feature kBraveAdblockSubscriptionEngineCache;
+extern const base::Feature kBraveAdblockSubscriptionConditionalDownloads;
+extern const base::Feature kBraveAdblockBatchMatching;
 extern const base::Feature kBraveAdblockCspRules;
+extern const base::Feature kBraveAdblockDecisionCache;
+extern const base::Feature kBraveAdblockEngineStats;
+extern const base::FeatureParam<int> kBraveAdblockEngineStatsSampleRate;
+extern const base::Feature kBraveAdblockFirstPartyFastPath;
+extern const base::Feature kBraveAdblockMappedDATFiles;
+extern const base::Feature kBraveAdblockEngineSnapshot;
+extern const base::Feature kBraveAdblockPreconnectFiltering;
+extern const base::Feature kBraveAdblockUnifiedSubscriptionEngine;
 extern const base::Feature kBraveDomainBlock;
 extern const base::Feature kBraveExtensionNetworkBlocking;
 extern const base::Feature kBraveDarkModeBlock;
+extern const base::Feature kBraveHTTPSEverywhereCache;
+extern const base::FeatureParam<int> kBraveHTTPSEverywhereCacheSize;
+extern const base::FeatureParam<int> kBraveHTTPSEverywhereCacheShards;
+extern const base::Feature kBraveShieldsSettingsCache;
 }  // namespace features
 }  // namespace brave_shields
 
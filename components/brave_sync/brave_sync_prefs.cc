@@ -9,6 +9,7 @@
 
 #include "base/base64.h"
 #include "base/logging.h"
+#include "brave/components/brave_sync/crypto/crypto.h"
 #include "components/os_crypt/os_crypt.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
@@ -61,7 +62,9 @@ const char kDuplicatedBookmarksMigrateVersion[] =
 
 Prefs::Prefs(PrefService* pref_service) : pref_service_(pref_service) {}
 
-Prefs::~Prefs() {}
+Prefs::~Prefs() {
+  crypto::SecureZero(&cached_seed_);
+}
 
 // static
 void Prefs::RegisterProfilePrefs(PrefRegistrySimple* registry) {
@@ -103,7 +106,10 @@ std::string Prefs::GetSeedPath() {
 }
 
 std::string Prefs::GetSeed() const {
-  const std::string encoded_seed = pref_service_->GetString(kSyncV2Seed);
+  const std::string& encoded_seed = pref_service_->GetString(kSyncV2Seed);
+  if (!cached_seed_.empty() && encoded_seed == cached_encoded_seed_)
+    return cached_seed_;
+
   std::string encrypted_seed;
   if (!base::Base64Decode(encoded_seed, &encrypted_seed)) {
     LOG(ERROR) << "base64 decode sync seed failure";
@@ -114,6 +120,9 @@ std::string Prefs::GetSeed() const {
     LOG(ERROR) << "Decrypt sync seed failure";
     return std::string();
   }
+  crypto::SecureZero(&cached_seed_);
+  cached_seed_ = seed;
+  cached_encoded_seed_ = encoded_seed;
   return seed;
 }
 
@@ -166,6 +175,9 @@ void Prefs::SetDismissSyncMigrateNotice(bool is_dismissed) {
 }
 
 void Prefs::Clear() {
+  crypto::SecureZero(&cached_seed_);
+  cached_seed_.clear();
+  cached_encoded_seed_.clear();
   pref_service_->ClearPref(kSyncV2Seed);
 }
 
@@ -31,6 +31,8 @@ class Prefs {
 
   static std::string GetSeedPath();
 
+  // Decrypts the seed once per pref value; later calls return a copy held
+  // until the pref changes, Clear() or destruction.
   std::string GetSeed() const;
   bool SetSeed(const std::string& seed);
 
@@ -55,6 +57,8 @@ class Prefs {
 
  private:
   PrefService* const pref_service_;
+  mutable std::string cached_encoded_seed_;
+  mutable std::string cached_seed_;
 
   DISALLOW_COPY_AND_ASSIGN(Prefs);
 };
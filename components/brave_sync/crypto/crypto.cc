@@ -5,19 +5,227 @@
 
 #include "brave/components/brave_sync/crypto/crypto.h"
 
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
+#include "base/barrier_closure.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/atomic_flag.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/vendor/bat-native-tweetnacl/tweetnacl.h"
 #include "brave/vendor/bip39wally-core-native/include/wally_bip39.h"
 #include "crypto/random.h"
 #include "third_party/boringssl/src/include/openssl/curve25519.h"
 #include "third_party/boringssl/src/include/openssl/digest.h"
 #include "third_party/boringssl/src/include/openssl/hkdf.h"
+#include "third_party/boringssl/src/include/openssl/mem.h"
 
 namespace brave_sync {
 namespace crypto {
 
+static_assert(kSecretboxOverhead ==
+                  crypto_secretbox_ZEROBYTES - crypto_secretbox_BOXZEROBYTES,
+              "kSecretboxOverhead must match tweetnacl");
+
+namespace {
+
+// A worker pool task handles at least this many records, so that small
+// batches don't pay for more thread hops than they save.
+constexpr size_t kMinRecordsPerTask = 64;
+
+// crypto_secretbox wants the message prefixed with ZEROBYTES zeros and
+// crypto_secretbox_open the ciphertext with BOXZEROBYTES zeros. These
+// buffers are sized once for the largest record of a batch and reused; the
+// prefixes are never written to.
+class SecretboxScratch {
+ public:
+  explicit SecretboxScratch(size_t max_record_size)
+      : m_(crypto_secretbox_ZEROBYTES + max_record_size), c_(m_.size()) {}
+
+  bool Seal(base::span<const uint8_t> message,
+            base::span<const uint8_t> nonce,
+            base::span<const uint8_t> secretbox_key,
+            base::span<uint8_t> ciphertext) {
+    DCHECK_EQ(ciphertext.size(), message.size() + kSecretboxOverhead);
+    const size_t size = crypto_secretbox_ZEROBYTES + message.size();
+    DCHECK_LE(size, m_.size());
+    std::copy(message.begin(), message.end(),
+              m_.begin() + crypto_secretbox_ZEROBYTES);
+    if (crypto_secretbox(c_.data(), m_.data(), size, nonce.data(),
+                         secretbox_key.data()) != 0)
+      return false;
+    std::copy(c_.begin() + crypto_secretbox_BOXZEROBYTES, c_.begin() + size,
+              ciphertext.begin());
+    return true;
+  }
+
+  bool Open(base::span<const uint8_t> ciphertext,
+            base::span<const uint8_t> nonce,
+            base::span<const uint8_t> secretbox_key,
+            base::span<uint8_t> message) {
+    const size_t size = crypto_secretbox_BOXZEROBYTES + ciphertext.size();
+    if (size < crypto_secretbox_ZEROBYTES)
+      return false;
+    DCHECK_EQ(message.size(), ciphertext.size() - kSecretboxOverhead);
+    DCHECK_LE(size, c_.size());
+    std::copy(ciphertext.begin(), ciphertext.end(),
+              c_.begin() + crypto_secretbox_BOXZEROBYTES);
+    if (crypto_secretbox_open(m_.data(), c_.data(), size, nonce.data(),
+                              secretbox_key.data()) != 0)
+      return false;
+    std::copy(m_.begin() + crypto_secretbox_ZEROBYTES, m_.begin() + size,
+              message.begin());
+    return true;
+  }
+
+ private:
+  std::vector<uint8_t> m_;
+  std::vector<uint8_t> c_;
+};
+
+size_t GetMaxRecordSize(const std::vector<base::span<const uint8_t>>& records) {
+  size_t max_size = 0;
+  for (const auto& record : records)
+    max_size = std::max(max_size, record.size());
+  return max_size;
+}
+
+// Encrypts or decrypts |inputs| into |output|, which callers have sized as
+// the sum of |inputs| sizes, plus or minus kSecretboxOverhead per record.
+bool RunBatch(bool encrypt,
+              const std::vector<base::span<const uint8_t>>& inputs,
+              base::span<const uint8_t> nonces,
+              base::span<const uint8_t> secretbox_key,
+              base::span<uint8_t> output) {
+  DCHECK_EQ(secretbox_key.size(), (size_t)crypto_secretbox_KEYBYTES);
+  if (nonces.size() != inputs.size() * crypto_secretbox_NONCEBYTES)
+    return false;
+
+  SecretboxScratch scratch(GetMaxRecordSize(inputs));
+  size_t offset = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!encrypt && inputs[i].size() < kSecretboxOverhead)
+      return false;
+    const size_t output_size = encrypt
+                                   ? inputs[i].size() + kSecretboxOverhead
+                                   : inputs[i].size() - kSecretboxOverhead;
+    if (offset + output_size > output.size())
+      return false;
+    auto nonce = nonces.subspan(i * crypto_secretbox_NONCEBYTES,
+                                crypto_secretbox_NONCEBYTES);
+    auto record_output = output.subspan(offset, output_size);
+    if (!(encrypt ? scratch.Seal(inputs[i], nonce, secretbox_key,
+                                 record_output)
+                  : scratch.Open(inputs[i], nonce, secretbox_key,
+                                 record_output)))
+      return false;
+    offset += output_size;
+  }
+  return offset == output.size();
+}
+
+// A batch split over the thread pool. Every task writes its own range of
+// |output|, which is sized before the first task is posted.
+struct WorkerPoolBatch : public base::RefCountedThreadSafe<WorkerPoolBatch> {
+  bool encrypt = true;
+  std::vector<std::vector<uint8_t>> inputs;
+  std::vector<uint8_t> nonces;
+  std::vector<uint8_t> secretbox_key;
+  std::vector<uint8_t> output;
+  base::AtomicFlag failed;
+
+ private:
+  friend class base::RefCountedThreadSafe<WorkerPoolBatch>;
+  ~WorkerPoolBatch() = default;
+};
+
+void RunWorkerPoolBatchRange(scoped_refptr<WorkerPoolBatch> batch,
+                             size_t begin,
+                             size_t end,
+                             size_t output_offset,
+                             size_t output_size) {
+  std::vector<base::span<const uint8_t>> inputs(batch->inputs.begin() + begin,
+                                                batch->inputs.begin() + end);
+  if (!RunBatch(batch->encrypt, inputs,
+                base::make_span(batch->nonces)
+                    .subspan(begin * crypto_secretbox_NONCEBYTES,
+                             (end - begin) * crypto_secretbox_NONCEBYTES),
+                batch->secretbox_key,
+                base::make_span(batch->output)
+                    .subspan(output_offset, output_size))) {
+    batch->failed.Set();
+  }
+}
+
+void OnWorkerPoolBatchDone(scoped_refptr<WorkerPoolBatch> batch,
+                           BatchCallback callback) {
+  if (batch->failed.IsSet()) {
+    std::move(callback).Run(false, {});
+    return;
+  }
+  std::move(callback).Run(true, std::move(batch->output));
+}
+
+void RunBatchOnWorkerPool(bool encrypt,
+                          std::vector<std::vector<uint8_t>> inputs,
+                          std::vector<uint8_t> nonces,
+                          std::vector<uint8_t> secretbox_key,
+                          BatchCallback callback) {
+  DCHECK_EQ(secretbox_key.size(), (size_t)crypto_secretbox_KEYBYTES);
+  auto batch = base::MakeRefCounted<WorkerPoolBatch>();
+  batch->encrypt = encrypt;
+
+  // Output offsets of every record, so that tasks can start anywhere.
+  bool valid = nonces.size() == inputs.size() * crypto_secretbox_NONCEBYTES;
+  std::vector<size_t> offsets(inputs.size() + 1);
+  for (size_t i = 0; valid && i < inputs.size(); ++i) {
+    if (encrypt) {
+      offsets[i + 1] = offsets[i] + inputs[i].size() + kSecretboxOverhead;
+    } else {
+      valid = inputs[i].size() >= kSecretboxOverhead;
+      offsets[i + 1] = offsets[i] + inputs[i].size() - kSecretboxOverhead;
+    }
+  }
+  if (!valid) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), false, std::vector<uint8_t>()));
+    return;
+  }
+
+  batch->inputs = std::move(inputs);
+  batch->nonces = std::move(nonces);
+  batch->secretbox_key = std::move(secretbox_key);
+  batch->output.resize(offsets.back());
+
+  const size_t record_count = batch->inputs.size();
+  const size_t task_count = std::max<size_t>(
+      1, std::min<size_t>(base::SysInfo::NumberOfProcessors(),
+                          record_count / kMinRecordsPerTask));
+  const size_t records_per_task = (record_count + task_count - 1) / task_count;
+
+  // Replies run on this sequence, and so does |callback| after the last one.
+  base::RepeatingClosure done = base::BarrierClosure(
+      task_count,
+      base::BindOnce(&OnWorkerPoolBatchDone, batch, std::move(callback)));
+  for (size_t task = 0; task < task_count; ++task) {
+    const size_t begin = std::min(task * records_per_task, record_count);
+    const size_t end = std::min(begin + records_per_task, record_count);
+    base::ThreadPool::PostTaskAndReply(
+        FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(&RunWorkerPoolBatchRange, batch, begin, end,
+                       offsets[begin], offsets[end] - offsets[begin]),
+        done);
+  }
+}
+
+}  // namespace
+
 std::vector<uint8_t> GetSeed(size_t size) {
   std::vector<uint8_t> bytes(size);
   ::crypto::RandBytes(&bytes[0], bytes.size());
@@ -51,6 +259,7 @@ void DeriveSigningKeysFromSeed(const std::vector<uint8_t>& seed,
   private_key->resize(ED25519_PRIVATE_KEY_LEN);
   ED25519_keypair_from_seed(public_key->data(), private_key->data(),
                             output.data());
+  SecureZero(&output);
 }
 
 bool Sign(const std::vector<uint8_t>& message,
@@ -72,16 +281,57 @@ bool Verify(const std::vector<uint8_t>& message,
                         public_key.data());
 }
 
+SigningKeys::SigningKeys() = default;
+
+SigningKeys::~SigningKeys() {
+  Reset();
+}
+
+void SigningKeys::Derive(const std::vector<uint8_t>& seed,
+                         const std::vector<uint8_t>* salt,
+                         const std::vector<uint8_t>* info) {
+  Reset();
+  DeriveSigningKeysFromSeed(seed, salt, info, &public_key_, &private_key_);
+}
+
+void SigningKeys::Reset() {
+  SecureZero(&public_key_);
+  SecureZero(&private_key_);
+  public_key_.clear();
+  private_key_.clear();
+}
+
+void SecureZero(std::vector<uint8_t>* bytes) {
+  DCHECK(bytes);
+  if (!bytes->empty())
+    OPENSSL_cleanse(bytes->data(), bytes->size());
+}
+
+void SecureZero(std::string* bytes) {
+  DCHECK(bytes);
+  if (!bytes->empty())
+    OPENSSL_cleanse(&(*bytes)[0], bytes->size());
+}
+
 std::vector<uint8_t> GetNonce(uint16_t counter,
                               const std::vector<uint8_t>& nonce_bytes) {
-  DCHECK_EQ(nonce_bytes.size(), (size_t)20);
   std::vector<uint8_t> nonce(crypto_secretbox_NONCEBYTES);
+  GetNonce(counter, nonce_bytes, nonce);
+  return nonce;
+}
+
+void GetNonce(uint16_t counter,
+              base::span<const uint8_t> nonce_bytes,
+              base::span<uint8_t> nonce) {
+  DCHECK_EQ(nonce_bytes.size(), (size_t)20);
+  DCHECK_EQ(nonce.size(), (size_t)crypto_secretbox_NONCEBYTES);
   nonce[0] = std::floor(counter / 256);
   nonce[1] = counter % 256;
   for (size_t i = 0; i < nonce_bytes.size(); ++i) {
     nonce[i + 2] = nonce_bytes[i];
   }
-  return nonce;
+  nonce[22] = 0;
+  nonce[23] = 0;
 }
 
 bool Encrypt(const std::vector<uint8_t>& message,
@@ -91,16 +341,11 @@ bool Encrypt(const std::vector<uint8_t>& message,
   DCHECK(ciphertext);
   DCHECK_EQ(secretbox_key.size(), (size_t)crypto_secretbox_KEYBYTES);
   DCHECK_EQ(nonce.size(), (size_t)crypto_secretbox_NONCEBYTES);
-  std::vector<uint8_t> m(crypto_secretbox_ZEROBYTES + message.size());
-  std::vector<uint8_t> c(m.size());
-  for (size_t i = 0; i < message.size(); ++i) {
-    m[i + crypto_secretbox_ZEROBYTES] = message[i];
-  }
-  if (crypto_secretbox(c.data(), m.data(), m.size(), nonce.data(),
-                       secretbox_key.data()) != 0)
+  std::vector<uint8_t> out(message.size() + kSecretboxOverhead);
+  if (!SecretboxScratch(message.size()).Seal(message, nonce, secretbox_key,
+                                             out))
     return false;
-  *ciphertext =
-      std::vector<uint8_t>(c.begin() + crypto_secretbox_BOXZEROBYTES, c.end());
+  *ciphertext = std::move(out);
   return true;
 }
 
@@ -111,21 +356,46 @@ bool Decrypt(const std::vector<uint8_t>& ciphertext,
   DCHECK(message);
   DCHECK_EQ(secretbox_key.size(), (size_t)crypto_secretbox_KEYBYTES);
   DCHECK_EQ(nonce.size(), (size_t)crypto_secretbox_NONCEBYTES);
-  std::vector<uint8_t> c(crypto_secretbox_BOXZEROBYTES + ciphertext.size());
-  if (c.size() < 32)
+  if (ciphertext.size() < kSecretboxOverhead)
     return false;
-  std::vector<uint8_t> m(c.size());
-  for (size_t i = 0; i < ciphertext.size(); ++i) {
-    c[i + crypto_secretbox_BOXZEROBYTES] = ciphertext[i];
-  }
-  if (crypto_secretbox_open(m.data(), c.data(), c.size(), nonce.data(),
-                            secretbox_key.data()) != 0)
+  std::vector<uint8_t> out(ciphertext.size() - kSecretboxOverhead);
+  if (!SecretboxScratch(ciphertext.size())
+           .Open(ciphertext, nonce, secretbox_key, out))
     return false;
-  *message =
-      std::vector<uint8_t>(m.begin() + crypto_secretbox_ZEROBYTES, m.end());
+  *message = std::move(out);
   return true;
 }
 
+bool EncryptBatch(const std::vector<base::span<const uint8_t>>& messages,
+                  base::span<const uint8_t> nonces,
+                  base::span<const uint8_t> secretbox_key,
+                  base::span<uint8_t> ciphertexts) {
+  return RunBatch(true, messages, nonces, secretbox_key, ciphertexts);
+}
+
+bool DecryptBatch(const std::vector<base::span<const uint8_t>>& ciphertexts,
+                  base::span<const uint8_t> nonces,
+                  base::span<const uint8_t> secretbox_key,
+                  base::span<uint8_t> messages) {
+  return RunBatch(false, ciphertexts, nonces, secretbox_key, messages);
+}
+
+void EncryptBatchOnWorkerPool(std::vector<std::vector<uint8_t>> messages,
+                              std::vector<uint8_t> nonces,
+                              std::vector<uint8_t> secretbox_key,
+                              BatchCallback callback) {
+  RunBatchOnWorkerPool(true, std::move(messages), std::move(nonces),
+                       std::move(secretbox_key), std::move(callback));
+}
+
+void DecryptBatchOnWorkerPool(std::vector<std::vector<uint8_t>> ciphertexts,
+                              std::vector<uint8_t> nonces,
+                              std::vector<uint8_t> secretbox_key,
+                              BatchCallback callback) {
+  RunBatchOnWorkerPool(false, std::move(ciphertexts), std::move(nonces),
+                       std::move(secretbox_key), std::move(callback));
+}
+
 std::string PassphraseFromBytes32(const std::vector<uint8_t>& bytes) {
   DCHECK_EQ(bytes.size(), (size_t)DEFAULT_SEED_SIZE);
   char* words = nullptr;
@@ -8,6 +8,9 @@
 #include <string>
 #include <vector>
 
+#include "base/callback_forward.h"
+#include "base/containers/span.h"
+
 namespace brave_sync {
 namespace crypto {
 
@@ -30,6 +33,35 @@ void DeriveSigningKeysFromSeed(const std::vector<uint8_t>& seed,
                                std::vector<uint8_t>* public_key,
                                std::vector<uint8_t>* private_key);
 
+// Holds an Ed25519 keypair from DeriveSigningKeysFromSeed for as long as the
+// seed is in use, so that it is derived once per session rather than on
+// every use. The key material is zeroed on Reset and on destruction.
+class SigningKeys {
+ public:
+  SigningKeys();
+  ~SigningKeys();
+  SigningKeys(const SigningKeys&) = delete;
+  SigningKeys& operator=(const SigningKeys&) = delete;
+
+  // Replaces the held keys with the ones derived from |seed|.
+  void Derive(const std::vector<uint8_t>& seed,
+              const std::vector<uint8_t>* salt,
+              const std::vector<uint8_t>* info);
+  void Reset();
+
+  bool empty() const { return public_key_.empty(); }
+  const std::vector<uint8_t>& public_key() const { return public_key_; }
+  const std::vector<uint8_t>& private_key() const { return private_key_; }
+
+ private:
+  std::vector<uint8_t> public_key_;
+  std::vector<uint8_t> private_key_;
+};
+
+// Overwrites |bytes| with zeros in a way the compiler won't optimize away.
+void SecureZero(std::vector<uint8_t>* bytes);
+void SecureZero(std::string* bytes);
+
 // Signs a message using Ed25519.
 // It returns true on success or false on allocation failure.
 bool Sign(const std::vector<uint8_t>& message,
@@ -53,6 +85,15 @@ bool Verify(const std::vector<uint8_t>& message,
 std::vector<uint8_t> GetNonce(uint16_t counter,
                               const std::vector<uint8_t>& nonce_bytes);
 
+/**
+ * Same as above but writes the nonce into |nonce|, e.g. a slot of the nonce
+ * buffer passed to EncryptBatch.
+ * @param nonce 24 bytes
+ */
+void GetNonce(uint16_t counter,
+              base::span<const uint8_t> nonce_bytes,
+              base::span<uint8_t> nonce);
+
 /**
  * Encrypts and authenticates a message using Nacl secretbox.
  * (xsalsa20-poly1305)
@@ -80,6 +121,58 @@ bool Decrypt(const std::vector<uint8_t>& ciphertext,
              const std::vector<uint8_t>& nonce,
              const std::vector<uint8_t>& secretbox_key,
              std::vector<uint8_t>* message);
+
+// Number of bytes Encrypt adds to a message.
+constexpr size_t kSecretboxOverhead = 16;
+
+/**
+ * Encrypts many records with one key, without allocating per record.
+ * Record i is encrypted with the i-th 24-byte nonce of |nonces| and its
+ * ciphertext is written right after record i-1's into |ciphertexts|, which
+ * must hold the message sizes plus kSecretboxOverhead per record.
+ * @param messages records to be encrypted
+ * @param nonces one nonce per record, back to back
+ * @param secretbox_key
+ * @param ciphertexts preallocated output
+ * @returns success or failure
+ */
+bool EncryptBatch(const std::vector<base::span<const uint8_t>>& messages,
+                  base::span<const uint8_t> nonces,
+                  base::span<const uint8_t> secretbox_key,
+                  base::span<uint8_t> ciphertexts);
+
+/**
+ * Decrypts many records with one key, the inverse of EncryptBatch.
+ * |messages| must hold the ciphertext sizes less kSecretboxOverhead per
+ * record.
+ * @returns true when all records verify, false otherwise
+ */
+bool DecryptBatch(const std::vector<base::span<const uint8_t>>& ciphertexts,
+                  base::span<const uint8_t> nonces,
+                  base::span<const uint8_t> secretbox_key,
+                  base::span<uint8_t> messages);
+
+// Runs with the success of a batch and its output.
+using BatchCallback =
+    base::OnceCallback<void(bool success, std::vector<uint8_t> output)>;
+
+/**
+ * Same as EncryptBatch, but splits the records over the thread pool and
+ * runs |callback| on the calling sequence with the ciphertexts, laid out
+ * as EncryptBatch lays them out. For large batches, e.g. the initial sync
+ * of a new device.
+ */
+void EncryptBatchOnWorkerPool(std::vector<std::vector<uint8_t>> messages,
+                              std::vector<uint8_t> nonces,
+                              std::vector<uint8_t> secretbox_key,
+                              BatchCallback callback);
+
+// The inverse of EncryptBatchOnWorkerPool.
+void DecryptBatchOnWorkerPool(std::vector<std::vector<uint8_t>> ciphertexts,
+                              std::vector<uint8_t> nonces,
+                              std::vector<uint8_t> secretbox_key,
+                              BatchCallback callback);
+
 /**
  * Convert a 32 bytes array into passphrase using bip39
  * @param bytes
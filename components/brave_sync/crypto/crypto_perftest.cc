@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_sync/crypto/crypto.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// Encrypts and decrypts a set of records the size of a new device's initial
+// sync, one record at a time and in batches, and reports the throughput of
+// each.
+
+namespace brave_sync {
+namespace crypto {
+
+namespace {
+
+const char kMetricPrefix[] = "SyncCrypto.";
+const char kMetricEncryptThroughput[] = "encrypt_throughput";
+const char kMetricDecryptThroughput[] = "decrypt_throughput";
+
+constexpr size_t kRecordCount = 20000;
+// Roughly a serialized bookmark or history entry.
+constexpr size_t kRecordSize = 512;
+
+}  // namespace
+
+class SyncCryptoPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    key_ = GetSeed(32);
+    for (size_t i = 0; i < kRecordCount; ++i) {
+      messages_.push_back(GetSeed(kRecordSize));
+      std::vector<uint8_t> nonce =
+          GetNonce(static_cast<uint16_t>(i), GetSeed(20));
+      nonces_.insert(nonces_.end(), nonce.begin(), nonce.end());
+    }
+  }
+
+  perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricEncryptThroughput, "records/s");
+    reporter.RegisterImportantMetric(kMetricDecryptThroughput, "records/s");
+    return reporter;
+  }
+
+  static double Throughput(base::TimeDelta elapsed) {
+    return kRecordCount / elapsed.InSecondsF();
+  }
+
+  std::vector<uint8_t> GetNonceAt(size_t i) const {
+    return std::vector<uint8_t>(nonces_.begin() + i * 24,
+                                nonces_.begin() + (i + 1) * 24);
+  }
+
+  std::vector<uint8_t> key_;
+  std::vector<std::vector<uint8_t>> messages_;
+  std::vector<uint8_t> nonces_;
+};
+
+TEST_F(SyncCryptoPerfTest, PerRecord) {
+  perf_test::PerfResultReporter reporter = SetUpReporter("per_record");
+
+  std::vector<std::vector<uint8_t>> ciphertexts(kRecordCount);
+  base::ElapsedTimer encrypt_timer;
+  for (size_t i = 0; i < kRecordCount; ++i)
+    ASSERT_TRUE(Encrypt(messages_[i], GetNonceAt(i), key_, &ciphertexts[i]));
+  reporter.AddResult(kMetricEncryptThroughput,
+                     Throughput(encrypt_timer.Elapsed()));
+
+  base::ElapsedTimer decrypt_timer;
+  for (size_t i = 0; i < kRecordCount; ++i) {
+    std::vector<uint8_t> message;
+    ASSERT_TRUE(Decrypt(ciphertexts[i], GetNonceAt(i), key_, &message));
+  }
+  reporter.AddResult(kMetricDecryptThroughput,
+                     Throughput(decrypt_timer.Elapsed()));
+}
+
+TEST_F(SyncCryptoPerfTest, Batch) {
+  perf_test::PerfResultReporter reporter = SetUpReporter("batch");
+
+  std::vector<base::span<const uint8_t>> messages(messages_.begin(),
+                                                  messages_.end());
+  std::vector<uint8_t> ciphertexts(kRecordCount *
+                                   (kRecordSize + kSecretboxOverhead));
+  base::ElapsedTimer encrypt_timer;
+  ASSERT_TRUE(EncryptBatch(messages, nonces_, key_, ciphertexts));
+  reporter.AddResult(kMetricEncryptThroughput,
+                     Throughput(encrypt_timer.Elapsed()));
+
+  std::vector<base::span<const uint8_t>> records;
+  for (size_t i = 0; i < kRecordCount; ++i) {
+    records.push_back(base::make_span(ciphertexts)
+                          .subspan(i * (kRecordSize + kSecretboxOverhead),
+                                   kRecordSize + kSecretboxOverhead));
+  }
+  std::vector<uint8_t> out_messages(kRecordCount * kRecordSize);
+  base::ElapsedTimer decrypt_timer;
+  ASSERT_TRUE(DecryptBatch(records, nonces_, key_, out_messages));
+  reporter.AddResult(kMetricDecryptThroughput,
+                     Throughput(decrypt_timer.Elapsed()));
+}
+
+TEST_F(SyncCryptoPerfTest, WorkerPool) {
+  base::test::TaskEnvironment task_environment;
+  perf_test::PerfResultReporter reporter = SetUpReporter("worker_pool");
+
+  auto run_batch = [](auto batch_function,
+                      std::vector<std::vector<uint8_t>> inputs,
+                      const std::vector<uint8_t>& nonces,
+                      const std::vector<uint8_t>& key) {
+    std::vector<uint8_t> output;
+    base::RunLoop run_loop;
+    batch_function(
+        std::move(inputs), nonces, key,
+        base::BindOnce(
+            [](base::OnceClosure quit, std::vector<uint8_t>* out,
+               bool success, std::vector<uint8_t> result) {
+              EXPECT_TRUE(success);
+              *out = std::move(result);
+              std::move(quit).Run();
+            },
+            run_loop.QuitClosure(), &output));
+    run_loop.Run();
+    return output;
+  };
+
+  // Copies of the input are made up front, as a caller handing its records
+  // over would have them.
+  std::vector<std::vector<uint8_t>> messages = messages_;
+  base::ElapsedTimer encrypt_timer;
+  std::vector<uint8_t> ciphertexts = run_batch(
+      &EncryptBatchOnWorkerPool, std::move(messages), nonces_, key_);
+  reporter.AddResult(kMetricEncryptThroughput,
+                     Throughput(encrypt_timer.Elapsed()));
+
+  std::vector<std::vector<uint8_t>> records;
+  const size_t ciphertext_size = kRecordSize + kSecretboxOverhead;
+  for (size_t i = 0; i < kRecordCount; ++i) {
+    records.emplace_back(ciphertexts.begin() + i * ciphertext_size,
+                         ciphertexts.begin() + (i + 1) * ciphertext_size);
+  }
+  base::ElapsedTimer decrypt_timer;
+  std::vector<uint8_t> out_messages = run_batch(
+      &DecryptBatchOnWorkerPool, std::move(records), nonces_, key_);
+  reporter.AddResult(kMetricDecryptThroughput,
+                     Throughput(decrypt_timer.Elapsed()));
+  EXPECT_EQ(out_messages.size(), kRecordCount * kRecordSize);
+}
+
+}  // namespace crypto
+}  // namespace brave_sync
@@ -7,9 +7,14 @@
 
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/bind.h"
+#include "base/run_loop.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/test/task_environment.h"
 #include "crypto/random.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -152,6 +157,28 @@ TEST(CryptoTest, Ed25519KeyDerivation) {
   EXPECT_TRUE(Verify(message, signature, public_key));
 }
 
+TEST(CryptoTest, SigningKeys) {
+  const std::vector<uint8_t> seed = GetSeed();
+  const std::vector<uint8_t> info = {0};
+  std::vector<uint8_t> public_key;
+  std::vector<uint8_t> private_key;
+  DeriveSigningKeysFromSeed(seed, nullptr, &info, &public_key, &private_key);
+
+  SigningKeys keys;
+  EXPECT_TRUE(keys.empty());
+  keys.Derive(seed, nullptr, &info);
+  EXPECT_FALSE(keys.empty());
+  EXPECT_EQ(keys.public_key(), public_key);
+  EXPECT_EQ(keys.private_key(), private_key);
+
+  keys.Derive(GetSeed(), nullptr, &info);
+  EXPECT_NE(keys.public_key(), public_key);
+
+  keys.Reset();
+  EXPECT_TRUE(keys.empty());
+  EXPECT_TRUE(keys.private_key().empty());
+}
+
 TEST(CryptoTest, GetNonce) {
   std::set<std::string> previous_nonces;
   std::vector<uint8_t> nonce_bytes(20);
@@ -220,6 +247,142 @@ TEST(CryptoTest, EncryptAndDecrypt) {
             base::HexEncode(out_message.data(), out_message.size()));
 }
 
+TEST(CryptoTest, EncryptBatchAndDecryptBatch) {
+  const std::vector<uint8_t> key = GetSeed(32);
+  std::vector<std::vector<uint8_t>> messages;
+  for (size_t size : {0u, 1u, 64u, 300u, 17u})
+    messages.push_back(std::vector<uint8_t>(size, static_cast<uint8_t>(size)));
+
+  std::vector<base::span<const uint8_t>> message_spans;
+  size_t total_size = 0;
+  for (const auto& message : messages) {
+    message_spans.push_back(message);
+    total_size += message.size();
+  }
+  std::vector<uint8_t> nonces(messages.size() * 24);
+  for (size_t i = 0; i < messages.size(); ++i) {
+    GetNonce(static_cast<uint16_t>(i), GetSeed(20),
+             base::make_span(nonces).subspan(i * 24, 24));
+  }
+
+  // Every record matches what Encrypt gives it on its own.
+  std::vector<uint8_t> ciphertexts(total_size +
+                                   messages.size() * kSecretboxOverhead);
+  ASSERT_TRUE(EncryptBatch(message_spans, nonces, key, ciphertexts));
+  std::vector<base::span<const uint8_t>> ciphertext_spans;
+  size_t offset = 0;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    const size_t size = messages[i].size() + kSecretboxOverhead;
+    std::vector<uint8_t> nonce(nonces.begin() + i * 24,
+                               nonces.begin() + (i + 1) * 24);
+    std::vector<uint8_t> ciphertext;
+    ASSERT_TRUE(Encrypt(messages[i], nonce, key, &ciphertext));
+    EXPECT_EQ(ciphertext, std::vector<uint8_t>(ciphertexts.begin() + offset,
+                                               ciphertexts.begin() + offset +
+                                                   size));
+    ciphertext_spans.push_back(
+        base::make_span(ciphertexts).subspan(offset, size));
+    offset += size;
+  }
+
+  std::vector<uint8_t> out_messages(total_size);
+  ASSERT_TRUE(DecryptBatch(ciphertext_spans, nonces, key, out_messages));
+  offset = 0;
+  for (const auto& message : messages) {
+    EXPECT_EQ(message,
+              std::vector<uint8_t>(out_messages.begin() + offset,
+                                   out_messages.begin() + offset +
+                                       message.size()));
+    offset += message.size();
+  }
+
+  // A wrong output size, a missing nonce or a tampered record fails.
+  std::vector<uint8_t> short_output(ciphertexts.size() - 1);
+  EXPECT_FALSE(EncryptBatch(message_spans, nonces, key, short_output));
+  EXPECT_FALSE(EncryptBatch(message_spans,
+                            base::make_span(nonces).first(nonces.size() - 24),
+                            key, ciphertexts));
+  ciphertexts.back() ^= 1;
+  EXPECT_FALSE(DecryptBatch(ciphertext_spans, nonces, key, out_messages));
+}
+
+TEST(CryptoTest, BatchOnWorkerPool) {
+  base::test::TaskEnvironment task_environment;
+  const std::vector<uint8_t> key = GetSeed(32);
+  // Enough records to be split over several tasks.
+  std::vector<std::vector<uint8_t>> messages;
+  std::vector<uint8_t> nonces;
+  for (size_t i = 0; i < 1000; ++i) {
+    messages.push_back(GetSeed(1 + i % 97));
+    std::vector<uint8_t> nonce =
+        GetNonce(static_cast<uint16_t>(i), GetSeed(20));
+    nonces.insert(nonces.end(), nonce.begin(), nonce.end());
+  }
+
+  std::vector<uint8_t> ciphertexts;
+  {
+    base::RunLoop run_loop;
+    EncryptBatchOnWorkerPool(
+        messages, nonces, key,
+        base::BindOnce(
+            [](base::OnceClosure quit, std::vector<uint8_t>* out,
+               bool success, std::vector<uint8_t> output) {
+              EXPECT_TRUE(success);
+              *out = std::move(output);
+              std::move(quit).Run();
+            },
+            run_loop.QuitClosure(), &ciphertexts));
+    run_loop.Run();
+  }
+
+  std::vector<base::span<const uint8_t>> message_spans(messages.begin(),
+                                                       messages.end());
+  std::vector<uint8_t> expected(ciphertexts.size());
+  ASSERT_TRUE(EncryptBatch(message_spans, nonces, key, expected));
+  EXPECT_EQ(ciphertexts, expected);
+
+  std::vector<std::vector<uint8_t>> records;
+  size_t offset = 0;
+  for (const auto& message : messages) {
+    const size_t size = message.size() + kSecretboxOverhead;
+    records.emplace_back(ciphertexts.begin() + offset,
+                         ciphertexts.begin() + offset + size);
+    offset += size;
+  }
+  std::vector<uint8_t> expected_messages;
+  for (const auto& message : messages)
+    expected_messages.insert(expected_messages.end(), message.begin(),
+                             message.end());
+
+  base::RunLoop run_loop;
+  DecryptBatchOnWorkerPool(
+      records, nonces, key,
+      base::BindOnce(
+          [](base::OnceClosure quit, const std::vector<uint8_t>& expected,
+             bool success, std::vector<uint8_t> output) {
+            EXPECT_TRUE(success);
+            EXPECT_EQ(output, expected);
+            std::move(quit).Run();
+          },
+          run_loop.QuitClosure(), expected_messages));
+  run_loop.Run();
+
+  // One bad record fails the whole batch.
+  records[500][0] ^= 1;
+  base::RunLoop failed_run_loop;
+  DecryptBatchOnWorkerPool(
+      records, nonces, key,
+      base::BindOnce(
+          [](base::OnceClosure quit, bool success,
+             std::vector<uint8_t> output) {
+            EXPECT_FALSE(success);
+            EXPECT_TRUE(output.empty());
+            std::move(quit).Run();
+          },
+          failed_run_loop.QuitClosure()));
+  failed_run_loop.Run();
+}
+
 TEST(CryptoTest, Passphrase) {
   // original seed can be recovered
   std::vector<uint8_t> bytes(32);
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_OS_CONNECTION_API_MAC_H_
 
 #import <Foundation/Foundation.h>
+#import <NetworkExtension/NetworkExtension.h>
 #include <string>
 
 #include "base/no_destructor.h"
@@ -35,6 +36,7 @@ class BraveVPNOSConnectionAPIMac : public BraveVPNOSConnectionAPI {
   void Disconnect(const std::string& name) override;
   void CheckConnection(const std::string& name) override;
   void ObserveVPNConnectionChange();
+  void NotifyConnectionStatus(const std::string& name, NEVPNStatus status);
 
   id vpn_observer_ = nil;
   BraveVPNConnectionInfo info_;
@@ -265,31 +265,37 @@ void BraveVPNOSConnectionAPIMac::CheckConnection(const std::string& name) {
 
     NEVPNStatus current_status = [[vpn_manager connection] status];
     VLOG(2) << "CheckConnection: " << current_status;
-    switch (current_status) {
-      case NEVPNStatusConnected:
-        for (Observer& obs : observers_)
-          obs.OnConnected(name);
-        break;
-      case NEVPNStatusConnecting:
-      case NEVPNStatusReasserting:
-        for (Observer& obs : observers_)
-          obs.OnIsConnecting(name);
-        break;
-      case NEVPNStatusDisconnected:
-      case NEVPNStatusInvalid:
-        for (Observer& obs : observers_)
-          obs.OnDisconnected(name);
-        break;
-      case NEVPNStatusDisconnecting:
-        for (Observer& obs : observers_)
-          obs.OnIsDisconnecting(name);
-        break;
-      default:
-        break;
-    }
+    NotifyConnectionStatus(name, current_status);
   }];
 }
 
+void BraveVPNOSConnectionAPIMac::NotifyConnectionStatus(
+    const std::string& name,
+    NEVPNStatus status) {
+  switch (status) {
+    case NEVPNStatusConnected:
+      for (Observer& obs : observers_)
+        obs.OnConnected(name);
+      break;
+    case NEVPNStatusConnecting:
+    case NEVPNStatusReasserting:
+      for (Observer& obs : observers_)
+        obs.OnIsConnecting(name);
+      break;
+    case NEVPNStatusDisconnected:
+    case NEVPNStatusInvalid:
+      for (Observer& obs : observers_)
+        obs.OnDisconnected(name);
+      break;
+    case NEVPNStatusDisconnecting:
+      for (Observer& obs : observers_)
+        obs.OnIsDisconnecting(name);
+      break;
+    default:
+      break;
+  }
+}
+
 void BraveVPNOSConnectionAPIMac::ObserveVPNConnectionChange() {
   vpn_observer_ = [[NSNotificationCenter defaultCenter]
       addObserverForName:NEVPNStatusDidChangeNotification
@@ -297,7 +303,16 @@ void BraveVPNOSConnectionAPIMac::ObserveVPNConnectionChange() {
                    queue:nil
               usingBlock:^(NSNotification* notification) {
                 VLOG(2) << "Received VPN connection status change notification";
-                CheckConnection(std::string());
+                // The notification comes from the connection itself, so its
+                // status is already current and reloading the preferences
+                // for every transition isn't needed.
+                NEVPNConnection* connection = base::mac::ObjCCast<
+                    NEVPNConnection>(notification.object);
+                if (!connection) {
+                  CheckConnection(std::string());
+                  return;
+                }
+                NotifyConnectionStatus(std::string(), [connection status]);
               }];
 }
 
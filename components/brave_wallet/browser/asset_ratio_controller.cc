@@ -78,6 +78,19 @@ std::string TimeFrameKeyToString(
   return timeframe_key;
 }
 
+// Live and intraday figures move quickly; longer charts barely change
+// between refreshes.
+base::TimeDelta GetCacheTTL(
+    brave_wallet::mojom::AssetPriceTimeframe timeframe) {
+  switch (timeframe) {
+    case brave_wallet::mojom::AssetPriceTimeframe::Live:
+    case brave_wallet::mojom::AssetPriceTimeframe::OneDay:
+      return base::TimeDelta::FromMinutes(1);
+    default:
+      return base::TimeDelta::FromMinutes(10);
+  }
+}
+
 }  // namespace
 
 namespace brave_wallet {
@@ -91,6 +104,13 @@ AssetRatioController::AssetRatioController(
 
 AssetRatioController::~AssetRatioController() {}
 
+AssetRatioController::CachedResponse::CachedResponse() = default;
+AssetRatioController::CachedResponse::CachedResponse(
+    const std::string& body,
+    base::TimeTicks expiration)
+    : body(body), expiration(expiration) {}
+AssetRatioController::CachedResponse::~CachedResponse() = default;
+
 mojo::PendingRemote<mojom::AssetRatioController>
 AssetRatioController::MakeRemote() {
   mojo::PendingRemote<mojom::AssetRatioController> remote;
@@ -142,9 +162,8 @@ void AssetRatioController::GetPrice(
   auto internal_callback = base::BindOnce(
       &AssetRatioController::OnGetPrice, weak_ptr_factory_.GetWeakPtr(),
       from_assets, to_assets, std::move(callback));
-  api_request_helper_.Request("GET",
-                              GetPriceURL(from_assets, to_assets, timeframe),
-                              "", "", true, std::move(internal_callback));
+  RequestCached(GetPriceURL(from_assets, to_assets, timeframe),
+                GetCacheTTL(timeframe), std::move(internal_callback));
 }
 
 void AssetRatioController::OnGetPrice(
@@ -174,8 +193,55 @@ void AssetRatioController::GetPriceHistory(
   auto internal_callback =
       base::BindOnce(&AssetRatioController::OnGetPriceHistory,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_.Request("GET", GetPriceHistoryURL(asset, timeframe), "",
-                              "", true, std::move(internal_callback));
+  RequestCached(GetPriceHistoryURL(asset, timeframe), GetCacheTTL(timeframe),
+                std::move(internal_callback));
+}
+
+void AssetRatioController::RequestCached(
+    const GURL& url,
+    base::TimeDelta ttl,
+    api_request_helper::APIRequestHelper::ResultCallback callback) {
+  const std::string key = url.spec();
+  auto cache_it = response_cache_.find(key);
+  if (cache_it != response_cache_.end()) {
+    if (cache_it->second.expiration > base::TimeTicks::Now()) {
+      std::move(callback).Run(200, cache_it->second.body,
+                              base::flat_map<std::string, std::string>());
+      return;
+    }
+    response_cache_.erase(cache_it);
+  }
+
+  // Several wallet panels ask for the same figures at once; only the first
+  // caller goes to the network.
+  auto& pending = pending_requests_[key];
+  pending.push_back(std::move(callback));
+  if (pending.size() > 1)
+    return;
+
+  api_request_helper_.Request(
+      "GET", url, "", "", true,
+      base::BindOnce(&AssetRatioController::OnRequestCached,
+                     weak_ptr_factory_.GetWeakPtr(), key, ttl));
+}
+
+void AssetRatioController::OnRequestCached(
+    const std::string& key,
+    base::TimeDelta ttl,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  if (status >= 200 && status <= 299) {
+    response_cache_[key] = CachedResponse(body, base::TimeTicks::Now() + ttl);
+  }
+
+  auto it = pending_requests_.find(key);
+  if (it == pending_requests_.end())
+    return;
+  auto callbacks = std::move(it->second);
+  pending_requests_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(status, body, headers);
 }
 
 void AssetRatioController::OnGetPriceHistory(
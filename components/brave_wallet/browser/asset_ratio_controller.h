@@ -66,13 +66,39 @@ class AssetRatioController : public KeyedService,
                   const int status,
                   const std::string& body,
                   const base::flat_map<std::string, std::string>& headers);
+  // Serves |url| from |response_cache_| while fresh and coalesces concurrent
+  // requests for it.
+  void RequestCached(
+      const GURL& url,
+      base::TimeDelta ttl,
+      api_request_helper::APIRequestHelper::ResultCallback callback);
+  void OnRequestCached(const std::string& key,
+                       base::TimeDelta ttl,
+                       const int status,
+                       const std::string& body,
+                       const base::flat_map<std::string, std::string>& headers);
   void OnGetPriceHistory(
       GetPriceHistoryCallback callback,
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
+  struct CachedResponse {
+    CachedResponse();
+    CachedResponse(const std::string& body, base::TimeTicks expiration);
+    ~CachedResponse();
+    std::string body;
+    base::TimeTicks expiration;
+  };
+
   mojo::ReceiverSet<mojom::AssetRatioController> receivers_;
+  // Keyed by request URL, which encodes the assets, vs currencies and
+  // timeframe.
+  base::flat_map<std::string, CachedResponse> response_cache_;
+  base::flat_map<
+      std::string,
+      std::vector<api_request_helper::APIRequestHelper::ResultCallback>>
+      pending_requests_;
 
   static GURL base_url_for_test_;
   api_request_helper::APIRequestHelper api_request_helper_;
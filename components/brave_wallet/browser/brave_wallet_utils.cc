@@ -282,7 +282,10 @@ bool ConcatHexStrings(const std::string& hex_input1,
   if (!IsValidHexString(hex_input1) || !IsValidHexString(hex_input2)) {
     return false;
   }
-  *out = hex_input1 + hex_input2.substr(2);
+  out->clear();
+  out->reserve(hex_input1.size() + hex_input2.size() - 2);
+  out->append(hex_input1);
+  out->append(hex_input2, 2, std::string::npos);
   return true;
 }
 
@@ -294,16 +297,19 @@ bool ConcatHexStrings(const std::vector<std::string>& hex_inputs,
   if (hex_inputs.empty()) {
     return false;
   }
-  if (!IsValidHexString(hex_inputs[0])) {
-    return false;
+  size_t size = 0;
+  for (const auto& hex_input : hex_inputs) {
+    if (!IsValidHexString(hex_input)) {
+      return false;
+    }
+    size += hex_input.size() - 2;
   }
 
-  *out = hex_inputs[0];
+  out->clear();
+  out->reserve(size + 2);
+  out->append(hex_inputs[0]);
   for (size_t i = 1; i < hex_inputs.size(); i++) {
-    if (!IsValidHexString(hex_inputs[i])) {
-      return false;
-    }
-    *out += hex_inputs[i].substr(2);
+    out->append(hex_inputs[i], 2, std::string::npos);
   }
 
   return true;
@@ -6,15 +6,24 @@
 #include "brave/components/brave_wallet/browser/erc_token_registry.h"
 
 #include <algorithm>
+#include <set>
 #include <utility>
 
+#include "base/strings/string_util.h"
+#include "base/trace_event/memory_allocator_dump.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "base/trace_event/process_memory_dump.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 
 namespace brave_wallet {
 
 ERCTokenRegistry::ERCTokenRegistry() = default;
 
-ERCTokenRegistry::~ERCTokenRegistry() {}
+ERCTokenRegistry::~ERCTokenRegistry() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
+}
 
 ERCTokenRegistry* ERCTokenRegistry::GetInstance() {
   return base::Singleton<ERCTokenRegistry>::get();
@@ -34,35 +43,87 @@ void ERCTokenRegistry::Bind(
 void ERCTokenRegistry::UpdateTokenList(
     std::vector<mojom::ERCTokenPtr> erc_tokens) {
   erc_tokens_ = std::move(erc_tokens);
+
+  std::vector<std::pair<std::string, size_t>> contracts;
+  std::vector<std::pair<std::string, size_t>> symbols;
+  search_index_.clear();
+  contracts.reserve(erc_tokens_.size());
+  symbols.reserve(erc_tokens_.size());
+  search_index_.reserve(erc_tokens_.size() * 2);
+  for (size_t i = 0; i < erc_tokens_.size(); ++i) {
+    const auto& token = erc_tokens_[i];
+    contracts.emplace_back(token->contract_address, i);
+    symbols.emplace_back(token->symbol, i);
+    search_index_.emplace_back(base::ToLowerASCII(token->symbol), i);
+    search_index_.emplace_back(base::ToLowerASCII(token->name), i);
+  }
+  contract_index_ = base::flat_map<std::string, size_t>(std::move(contracts));
+  symbol_index_ = base::flat_map<std::string, size_t>(std::move(symbols));
+  std::sort(search_index_.begin(), search_index_.end());
+}
+
+bool ERCTokenRegistry::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  size_t size = erc_tokens_.capacity() * sizeof(mojom::ERCTokenPtr);
+  for (const auto& token : erc_tokens_) {
+    size += sizeof(mojom::ERCToken) +
+            base::trace_event::EstimateMemoryUsage(token->contract_address) +
+            base::trace_event::EstimateMemoryUsage(token->name) +
+            base::trace_event::EstimateMemoryUsage(token->logo) +
+            base::trace_event::EstimateMemoryUsage(token->symbol);
+  }
+  size += base::trace_event::EstimateMemoryUsage(contract_index_) +
+          base::trace_event::EstimateMemoryUsage(symbol_index_) +
+          base::trace_event::EstimateMemoryUsage(search_index_);
+
+  base::trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump("brave/wallet/erc_token_registry");
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                  base::trace_event::MemoryAllocatorDump::kUnitsBytes, size);
+  dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  erc_tokens_.size());
+  return true;
 }
 
 void ERCTokenRegistry::GetTokenByContract(const std::string& contract,
                                           GetTokenByContractCallback callback) {
-  auto token_it =
-      std::find_if(erc_tokens_.begin(), erc_tokens_.end(),
-                   [&](const mojom::ERCTokenPtr& current_token) {
-                     return current_token->contract_address == contract;
-                   });
-  if (token_it == erc_tokens_.end()) {
+  auto it = contract_index_.find(contract);
+  if (it == contract_index_.end()) {
     std::move(callback).Run(nullptr);
     return;
   }
-  std::move(callback).Run(token_it->Clone());
+  std::move(callback).Run(erc_tokens_[it->second].Clone());
 }
 
 void ERCTokenRegistry::GetTokenBySymbol(const std::string& symbol,
                                         GetTokenBySymbolCallback callback) {
-  auto token_it = std::find_if(erc_tokens_.begin(), erc_tokens_.end(),
-                               [&](const mojom::ERCTokenPtr& current_token) {
-                                 return current_token->symbol == symbol;
-                               });
-
-  if (token_it == erc_tokens_.end()) {
+  auto it = symbol_index_.find(symbol);
+  if (it == symbol_index_.end()) {
     std::move(callback).Run(nullptr);
     return;
   }
 
-  std::move(callback).Run(token_it->Clone());
+  std::move(callback).Run(erc_tokens_[it->second].Clone());
+}
+
+void ERCTokenRegistry::SearchTokens(const std::string& query,
+                                    SearchTokensCallback callback) {
+  const std::string prefix = base::ToLowerASCII(query);
+  std::set<size_t> matches;
+  for (auto it = std::lower_bound(search_index_.begin(), search_index_.end(),
+                                  std::make_pair(prefix, size_t(0)));
+       it != search_index_.end() && base::StartsWith(it->first, prefix);
+       ++it) {
+    matches.insert(it->second);
+  }
+
+  std::vector<mojom::ERCTokenPtr> erc_tokens;
+  erc_tokens.reserve(matches.size());
+  for (size_t index : matches)
+    erc_tokens.push_back(erc_tokens_[index].Clone());
+  std::move(callback).Run(std::move(erc_tokens));
 }
 
 void ERCTokenRegistry::GetAllTokens(GetAllTokensCallback callback) {
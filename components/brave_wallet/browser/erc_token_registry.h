@@ -7,10 +7,13 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ERC_TOKEN_REGISTRY_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/memory/singleton.h"
+#include "base/trace_event/memory_dump_provider.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "build/build_config.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
@@ -19,7 +22,8 @@
 
 namespace brave_wallet {
 
-class ERCTokenRegistry : public mojom::ERCTokenRegistry {
+class ERCTokenRegistry : public mojom::ERCTokenRegistry,
+                         public base::trace_event::MemoryDumpProvider {
  public:
   ERCTokenRegistry(const ERCTokenRegistry&) = delete;
   ~ERCTokenRegistry() override;
@@ -31,16 +35,29 @@ class ERCTokenRegistry : public mojom::ERCTokenRegistry {
 
   void UpdateTokenList(std::vector<mojom::ERCTokenPtr> erc_tokens);
 
+  // base::trace_event::MemoryDumpProvider. Register on the thread that calls
+  // UpdateTokenList.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
   // ERCTokenRegistry interface methods
   void GetTokenByContract(const std::string& contract,
                           GetTokenByContractCallback callback) override;
   void GetTokenBySymbol(const std::string& symbol,
                         GetTokenBySymbolCallback callback) override;
+  void SearchTokens(const std::string& query,
+                    SearchTokensCallback callback) override;
   void GetAllTokens(GetAllTokensCallback callback) override;
   void GetBuyTokens(GetBuyTokensCallback callback) override;
 
  protected:
   std::vector<mojom::ERCTokenPtr> erc_tokens_;
+  // Indexes into |erc_tokens_|, rebuilt by UpdateTokenList. The first token
+  // in list order wins for duplicate contracts and symbols.
+  base::flat_map<std::string, size_t> contract_index_;
+  base::flat_map<std::string, size_t> symbol_index_;
+  // <lower-cased symbol or name, token index>, sorted for prefix search.
+  std::vector<std::pair<std::string, size_t>> search_index_;
   friend struct base::DefaultSingletonTraits<ERCTokenRegistry>;
 
   ERCTokenRegistry();
@@ -117,4 +117,37 @@ TEST(ERCTokenRegistryUnitTest, GetTokenBySymbol) {
       base::BindOnce([](mojom::ERCTokenPtr token) { ASSERT_FALSE(token); }));
 }
 
+TEST(ERCTokenRegistryUnitTest, SearchTokens) {
+  auto* registry = ERCTokenRegistry::GetInstance();
+  std::vector<mojom::ERCTokenPtr> input_erc_tokens;
+  ASSERT_TRUE(ParseTokenList(token_list_json, &input_erc_tokens));
+  registry->UpdateTokenList(std::move(input_erc_tokens));
+
+  // Matches symbol and name prefixes, ignoring case.
+  registry->SearchTokens(
+      "ba", base::BindOnce([](std::vector<mojom::ERCTokenPtr> tokens) {
+        ASSERT_EQ(tokens.size(), 1UL);
+        EXPECT_EQ(tokens[0]->symbol, "BAT");
+      }));
+  registry->SearchTokens(
+      "Crypto", base::BindOnce([](std::vector<mojom::ERCTokenPtr> tokens) {
+        ASSERT_EQ(tokens.size(), 1UL);
+        EXPECT_EQ(tokens[0]->symbol, "CK");
+      }));
+
+  // Results keep list order.
+  registry->SearchTokens(
+      "", base::BindOnce([](std::vector<mojom::ERCTokenPtr> tokens) {
+        ASSERT_EQ(tokens.size(), 3UL);
+        EXPECT_EQ(tokens[0]->symbol, "CK");
+        EXPECT_EQ(tokens[1]->symbol, "BAT");
+        EXPECT_EQ(tokens[2]->symbol, "UNI");
+      }));
+
+  registry->SearchTokens(
+      "xyz", base::BindOnce([](std::vector<mojom::ERCTokenPtr> tokens) {
+        EXPECT_TRUE(tokens.empty());
+      }));
+}
+
 }  // namespace brave_wallet
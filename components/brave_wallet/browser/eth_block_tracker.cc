@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/cxx17_backports.h"
 #include "base/logging.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 
@@ -20,13 +21,20 @@ EthBlockTracker::EthBlockTracker(EthJsonRpcController* rpc_controller)
 EthBlockTracker::~EthBlockTracker() = default;
 
 void EthBlockTracker::Start(base::TimeDelta interval) {
-  timer_.Start(
-      FROM_HERE, interval,
-      base::BindRepeating(
-          &EthBlockTracker::SendGetBlockNumber, weak_factory_.GetWeakPtr(),
-          base::Passed(base::BindOnce(&EthBlockTracker::OnGetBlockNumber,
-                                      weak_factory_.GetWeakPtr()))));
+  adaptive_ = false;
+  interval_ = interval;
+  ScheduleNextPoll();
 }
+
+void EthBlockTracker::StartAdaptive(base::TimeDelta min_interval,
+                                    base::TimeDelta max_interval) {
+  DCHECK_LE(min_interval, max_interval);
+  adaptive_ = true;
+  min_interval_ = min_interval;
+  max_interval_ = max_interval;
+  ScheduleNextPoll();
+}
+
 void EthBlockTracker::Stop() {
   timer_.Stop();
 }
@@ -35,6 +43,37 @@ bool EthBlockTracker::IsRunning() const {
   return timer_.IsRunning();
 }
 
+void EthBlockTracker::SetHasPendingWork(bool has_pending_work) {
+  if (has_pending_work_ == has_pending_work)
+    return;
+  has_pending_work_ = has_pending_work;
+  // Pick up new work right away rather than after a long idle interval.
+  if (adaptive_ && IsRunning())
+    ScheduleNextPoll();
+}
+
+base::TimeDelta EthBlockTracker::GetPollingInterval() const {
+  if (!adaptive_)
+    return interval_;
+  if (!has_pending_work_)
+    return max_interval_;
+  if (average_block_time_.is_zero())
+    return min_interval_;
+  return base::clamp(average_block_time_, min_interval_, max_interval_);
+}
+
+void EthBlockTracker::ScheduleNextPoll() {
+  timer_.Start(FROM_HERE, GetPollingInterval(),
+               base::BindOnce(&EthBlockTracker::OnTimer,
+                              weak_factory_.GetWeakPtr()));
+}
+
+void EthBlockTracker::OnTimer() {
+  ScheduleNextPoll();
+  SendGetBlockNumber(base::BindOnce(&EthBlockTracker::OnGetBlockNumber,
+                                    weak_factory_.GetWeakPtr()));
+}
+
 void EthBlockTracker::AddObserver(EthBlockTracker::Observer* observer) {
   observers_.AddObserver(observer);
 }
@@ -55,6 +94,19 @@ void EthBlockTracker::SendGetBlockNumber(
 
 void EthBlockTracker::OnGetBlockNumber(bool status, uint256_t block_num) {
   if (status) {
+    if (block_num > current_block_) {
+      const base::TimeTicks now = base::TimeTicks::Now();
+      if (!last_block_time_.is_null() && current_block_ != 0) {
+        const base::TimeDelta block_time =
+            (now - last_block_time_) /
+            static_cast<int64_t>(block_num - current_block_);
+        average_block_time_ =
+            average_block_time_.is_zero()
+                ? block_time
+                : (average_block_time_ * 3 + block_time) / 4;
+      }
+      last_block_time_ = now;
+    }
     current_block_ = block_num;
     for (auto& observer : observers_)
       observer.OnLatestBlock(block_num);
@@ -9,6 +9,7 @@
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
+#include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
 
@@ -30,9 +31,19 @@ class EthBlockTracker {
 
   // If timer is already running, it will be replaced with new interval
   void Start(base::TimeDelta interval);
+  // Polls at the observed block time, bounded to [min_interval, max_interval],
+  // while there is pending work and at |max_interval| otherwise. If timer is
+  // already running, it will be replaced.
+  void StartAdaptive(base::TimeDelta min_interval,
+                     base::TimeDelta max_interval);
   void Stop();
   bool IsRunning() const;
 
+  // Lets the owner report whether anything (e.g. submitted transactions)
+  // is waiting on the next block. Only affects adaptive polling.
+  void SetHasPendingWork(bool has_pending_work);
+  base::TimeDelta GetPollingInterval() const;
+
   void AddObserver(Observer* observer);
   void RemoveObserver(Observer* observer);
 
@@ -42,12 +53,24 @@ class EthBlockTracker {
       base::OnceCallback<void(bool status, uint256_t block_num)>);
 
  private:
+  void ScheduleNextPoll();
+  void OnTimer();
   void SendGetBlockNumber(
       base::OnceCallback<void(bool status, uint256_t block_num)>);
   void OnGetBlockNumber(bool status, uint256_t block_num);
 
   uint256_t current_block_ = 0;
-  base::RepeatingTimer timer_;
+  base::OneShotTimer timer_;
+
+  bool adaptive_ = false;
+  base::TimeDelta interval_;
+  base::TimeDelta min_interval_;
+  base::TimeDelta max_interval_;
+  bool has_pending_work_ = false;
+  // Moving average of the time between observed blocks, zero until two
+  // blocks have been seen.
+  base::TimeDelta average_block_time_;
+  base::TimeTicks last_block_time_;
 
   base::ObserverList<Observer> observers_;
 
@@ -136,6 +136,45 @@ TEST_F(EthBlockTrackerUnitTest, GetBlockNumber) {
   EXPECT_EQ(tracker.GetCurrentBlock(), uint256_t(3));
 }
 
+TEST_F(EthBlockTrackerUnitTest, AdaptivePolling) {
+  EthBlockTracker tracker(rpc_controller_.get());
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(),
+                                        GetResponseString());
+      }));
+  response_block_num_ = 1;
+  TrackerObserver observer;
+  tracker.AddObserver(&observer);
+
+  // Nothing is waiting on a block, so poll at the slowest rate.
+  tracker.StartAdaptive(base::TimeDelta::FromSeconds(1),
+                        base::TimeDelta::FromSeconds(60));
+  EXPECT_EQ(tracker.GetPollingInterval(), base::TimeDelta::FromSeconds(60));
+
+  // No block time observed yet, so poll at the fastest rate.
+  tracker.SetHasPendingWork(true);
+  EXPECT_EQ(tracker.GetPollingInterval(), base::TimeDelta::FromSeconds(1));
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(tracker.GetCurrentBlock(), uint256_t(1));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(11));
+  response_block_num_ = 2;
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(tracker.GetCurrentBlock(), uint256_t(2));
+  EXPECT_EQ(tracker.GetPollingInterval(), base::TimeDelta::FromSeconds(12));
+
+  tracker.SetHasPendingWork(false);
+  EXPECT_EQ(tracker.GetPollingInterval(), base::TimeDelta::FromSeconds(60));
+
+  // Fixed interval start ignores pending work.
+  tracker.Start(base::TimeDelta::FromSeconds(5));
+  tracker.SetHasPendingWork(true);
+  EXPECT_EQ(tracker.GetPollingInterval(), base::TimeDelta::FromSeconds(5));
+  tracker.Stop();
+}
+
 TEST_F(EthBlockTrackerUnitTest, GetBlockNumberError) {
   EthBlockTracker tracker(rpc_controller_.get());
   url_loader_factory_.SetInterceptor(
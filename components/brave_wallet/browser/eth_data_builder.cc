@@ -10,13 +10,25 @@
 
 namespace brave_wallet {
 
+namespace {
+
+// Function selectors, i.e. GetFunctionHash() of each signature. They are
+// constant, so there is no need to run Keccak for every call we build.
+constexpr char kTransferSelector[] = "0xa9059cbb";  // transfer(address,uint256)
+constexpr char kBalanceOfSelector[] = "0x70a08231";  // balanceOf(address)
+constexpr char kApproveSelector[] = "0x095ea7b3";  // approve(address,uint256)
+constexpr char kGetManySelector[] = "0x1bd8cc1a";  // getMany(string[],uint256)
+constexpr char kResolverSelector[] = "0x0178b8bf";  // resolver(bytes32)
+constexpr char kContentHashSelector[] = "0xbc1c58d1";  // contenthash(bytes32)
+
+}  // namespace
+
 namespace erc20 {
 
 bool Transfer(const std::string& to_address,
               uint256_t amount,
               std::string* data) {
-  const std::string function_hash =
-      GetFunctionHash("transfer(address,uint256)");
+  const std::string function_hash = kTransferSelector;
   std::string padded_address;
   if (!brave_wallet::PadHexEncodedParameter(to_address, &padded_address)) {
     return false;
@@ -31,7 +43,7 @@ bool Transfer(const std::string& to_address,
 }
 
 bool BalanceOf(const std::string& address, std::string* data) {
-  const std::string function_hash = GetFunctionHash("balanceOf(address)");
+  const std::string function_hash = kBalanceOfSelector;
   std::string params;
   if (!brave_wallet::PadHexEncodedParameter(address, &params)) {
     return false;
@@ -42,7 +54,7 @@ bool BalanceOf(const std::string& address, std::string* data) {
 bool Approve(const std::string& spender_address,
              uint256_t amount,
              std::string* data) {
-  const std::string function_hash = GetFunctionHash("approve(address,uint256)");
+  const std::string function_hash = kApproveSelector;
   std::string padded_address;
   if (!brave_wallet::PadHexEncodedParameter(spender_address, &padded_address)) {
     return false;
@@ -63,8 +75,7 @@ namespace unstoppable_domains {
 bool GetMany(const std::vector<std::string>& keys,
              const std::string& domain,
              std::string* data) {
-  const std::string function_hash =
-      GetFunctionHash("getMany(string[],uint256)");
+  const std::string function_hash = kGetManySelector;
 
   std::string offset_for_array;
   if (!PadHexEncodedParameter(Uint256ValueToHex(64), &offset_for_array)) {
@@ -92,14 +103,14 @@ bool GetMany(const std::vector<std::string>& keys,
 namespace ens {
 
 bool GetResolverAddress(const std::string& domain, std::string* data) {
-  const std::string function_hash = GetFunctionHash("resolver(bytes32)");
+  const std::string function_hash = kResolverSelector;
   std::string tokenID = Namehash(domain);
   std::vector<std::string> hex_strings = {function_hash, tokenID};
   return ConcatHexStrings(hex_strings, data);
 }
 
 bool GetContentHashAddress(const std::string& domain, std::string* data) {
-  const std::string function_hash = GetFunctionHash("contenthash(bytes32)");
+  const std::string function_hash = kContentHashSelector;
   std::string tokenID = Namehash(domain);
   std::vector<std::string> hex_strings = {function_hash, tokenID};
   return ConcatHexStrings(hex_strings, data);
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
 
+#include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_wallet {
@@ -98,4 +99,25 @@ TEST(EthCallDataBuilderTest, GetMany) {
 
 }  // namespace unstoppable_domains
 
+TEST(EthCallDataBuilderTest, FunctionSelectors) {
+  // The builders use precomputed selectors; make sure they still match the
+  // hashed signatures.
+  std::string data;
+  ASSERT_TRUE(ens::GetResolverAddress("brave.eth", &data));
+  EXPECT_EQ(data.substr(0, 10), GetFunctionHash("resolver(bytes32)"));
+  ASSERT_TRUE(ens::GetContentHashAddress("brave.eth", &data));
+  EXPECT_EQ(data.substr(0, 10), GetFunctionHash("contenthash(bytes32)"));
+  ASSERT_TRUE(erc20::BalanceOf("0x4e02f254184E904300e0775E4b8eeCB1", &data));
+  EXPECT_EQ(data.substr(0, 10), GetFunctionHash("balanceOf(address)"));
+  ASSERT_TRUE(erc20::Transfer("0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f",
+                              0xde0b6b3a7640000, &data));
+  EXPECT_EQ(data.substr(0, 10), GetFunctionHash("transfer(address,uint256)"));
+  ASSERT_TRUE(erc20::Approve("0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f",
+                             0xde0b6b3a7640000, &data));
+  EXPECT_EQ(data.substr(0, 10), GetFunctionHash("approve(address,uint256)"));
+  ASSERT_TRUE(unstoppable_domains::GetMany({"crypto.ETH.address"},
+                                           "brave.crypto", &data));
+  EXPECT_EQ(data.substr(0, 10), GetFunctionHash("getMany(string[],uint256)"));
+}
+
 }  // namespace brave_wallet
@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
@@ -44,6 +45,10 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
     )");
 }
 
+// Upper bound on how long a block-scoped response is served if the block
+// tracker stops reporting new blocks.
+constexpr base::TimeDelta kBlockCacheMaxAge = base::TimeDelta::FromSeconds(30);
+
 }  // namespace
 
 namespace brave_wallet {
@@ -84,6 +89,87 @@ void EthJsonRpcController::Request(const std::string& json_payload,
                               std::move(callback));
 }
 
+void EthJsonRpcController::RequestDeduplicated(const std::string& json_payload,
+                                               RequestCallback callback) {
+  // An identical read-only call that is still in flight shares its response
+  // instead of hitting the node again.
+  const std::string key = network_url_.spec() + json_payload;
+  auto it = in_flight_requests_.find(key);
+  if (it != in_flight_requests_.end()) {
+    it->second.push_back(std::move(callback));
+    return;
+  }
+
+  in_flight_requests_[key].push_back(std::move(callback));
+  Request(json_payload, true,
+          base::BindOnce(&EthJsonRpcController::OnRequestDeduplicated,
+                         weak_ptr_factory_.GetWeakPtr(), key));
+}
+
+void EthJsonRpcController::OnRequestDeduplicated(
+    const std::string& key,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  auto it = in_flight_requests_.find(key);
+  if (it == in_flight_requests_.end())
+    return;
+
+  std::vector<RequestCallback> callbacks = std::move(it->second);
+  in_flight_requests_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(status, body, headers);
+}
+
+void EthJsonRpcController::RequestBlockCached(const std::string& json_payload,
+                                              RequestCallback callback) {
+  // Results are only cached once a block number has been observed for the
+  // current chain, so that a new block can invalidate them.
+  if (latest_block_number_ == 0) {
+    RequestDeduplicated(json_payload, std::move(callback));
+    return;
+  }
+
+  if (base::TimeTicks::Now() - latest_block_time_ > kBlockCacheMaxAge)
+    block_cache_.clear();
+
+  const std::string key = chain_id_ + json_payload;
+  auto it = block_cache_.find(key);
+  if (it != block_cache_.end()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), 200, it->second,
+                       base::flat_map<std::string, std::string>()));
+    return;
+  }
+
+  RequestDeduplicated(
+      json_payload,
+      base::BindOnce(&EthJsonRpcController::OnRequestBlockCached,
+                     weak_ptr_factory_.GetWeakPtr(), key, latest_block_number_,
+                     std::move(callback)));
+}
+
+void EthJsonRpcController::OnRequestBlockCached(
+    const std::string& key,
+    uint256_t block_number,
+    RequestCallback callback,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  std::string result;
+  if (status >= 200 && status <= 299 && block_number == latest_block_number_ &&
+      ParseEthCall(body, &result)) {
+    block_cache_[key] = body;
+  }
+  std::move(callback).Run(status, body, headers);
+}
+
+void EthJsonRpcController::ClearBlockCache() {
+  latest_block_number_ = 0;
+  block_cache_.clear();
+}
+
 void EthJsonRpcController::FirePendingRequestCompleted(
     const std::string& chain_id,
     const std::string& error) {
@@ -152,6 +238,7 @@ void EthJsonRpcController::SetNetwork(const std::string& chain_id) {
     return;
   chain_id_ = chain_id;
   network_url_ = network_url;
+  ClearBlockCache();
   prefs_->SetString(kBraveWalletCurrentChainId, chain_id);
   FireNetworkChanged();
 }
@@ -192,18 +279,21 @@ void EthJsonRpcController::SetCustomNetworkForTesting(
     const GURL& network_url) {
   chain_id_ = chain_id;
   network_url_ = network_url;
+  ClearBlockCache();
   FireNetworkChanged();
 }
 
 void EthJsonRpcController::GetBlockNumber(GetBlockNumberCallback callback) {
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetBlockNumber,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback),
+                     chain_id_);
   return Request(eth_blockNumber(), true, std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetBlockNumber(
     GetBlockNumberCallback callback,
+    const std::string& chain_id,
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
@@ -217,6 +307,16 @@ void EthJsonRpcController::OnGetBlockNumber(
     return;
   }
 
+  // A new block invalidates every block-scoped result. Responses that arrive
+  // after a network switch belong to the previous chain and are ignored here.
+  if (chain_id == chain_id_) {
+    if (block_number != latest_block_number_) {
+      latest_block_number_ = block_number;
+      block_cache_.clear();
+    }
+    latest_block_time_ = base::TimeTicks::Now();
+  }
+
   std::move(callback).Run(true, block_number);
 }
 
@@ -226,8 +326,8 @@ void EthJsonRpcController::GetBalance(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  return Request(eth_getBalance(address, "latest"), true,
-                 std::move(internal_callback));
+  return RequestBlockCached(eth_getBalance(address, "latest"),
+                            std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetBalance(
@@ -253,8 +353,8 @@ void EthJsonRpcController::GetTransactionCount(const std::string& address,
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetTransactionCount,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  return Request(eth_getTransactionCount(address, "latest"), true,
-                 std::move(internal_callback));
+  return RequestDeduplicated(eth_getTransactionCount(address, "latest"),
+                             std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetTransactionCount(
@@ -281,8 +381,8 @@ void EthJsonRpcController::GetTransactionReceipt(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetTransactionReceipt,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  return Request(eth_getTransactionReceipt(tx_hash), true,
-                 std::move(internal_callback));
+  return RequestDeduplicated(eth_getTransactionReceipt(tx_hash),
+                             std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetTransactionReceipt(
@@ -343,8 +443,8 @@ void EthJsonRpcController::GetERC20TokenBalance(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetERC20TokenBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  Request(eth_call("", contract, "", "", "", data, "latest"), true,
-          std::move(internal_callback));
+  RequestBlockCached(eth_call("", contract, "", "", "", data, "latest"),
+                     std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetERC20TokenBalance(
@@ -376,8 +476,8 @@ void EthJsonRpcController::EnsProxyReaderGetResolverAddress(
   auto internal_callback = base::BindOnce(
       &EthJsonRpcController::OnEnsProxyReaderGetResolverAddress,
       weak_ptr_factory_.GetWeakPtr(), std::move(callback), domain);
-  Request(eth_call("", contract_address, "", "", "", data, "latest"), true,
-          std::move(internal_callback));
+  RequestBlockCached(eth_call("", contract_address, "", "", "", data, "latest"),
+                     std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnEnsProxyReaderGetResolverAddress(
@@ -417,8 +517,8 @@ bool EthJsonRpcController::EnsProxyReaderResolveAddress(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnEnsProxyReaderResolveAddress,
                      base::Unretained(this), std::move(callback));
-  Request(eth_call("", contract_address, "", "", "", data, "latest"), true,
-          std::move(internal_callback));
+  RequestBlockCached(eth_call("", contract_address, "", "", "", data, "latest"),
+                     std::move(internal_callback));
   return true;
 }
 
@@ -453,8 +553,8 @@ void EthJsonRpcController::UnstoppableDomainsProxyReaderGetMany(
   auto internal_callback = base::BindOnce(
       &EthJsonRpcController::OnUnstoppableDomainsProxyReaderGetMany,
       weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  Request(eth_call("", contract_address, "", "", "", data, "latest"), true,
-          std::move(internal_callback));
+  RequestBlockCached(eth_call("", contract_address, "", "", "", data, "latest"),
+                     std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnUnstoppableDomainsProxyReaderGetMany(
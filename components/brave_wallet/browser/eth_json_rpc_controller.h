@@ -16,6 +16,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
+#include "base/time/time.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
@@ -147,8 +148,26 @@ class EthJsonRpcController : public KeyedService,
                                    const std::string& error);
   bool HasRequestFromOrigin(const GURL& origin) const;
   void RemoveChainIdRequest(const std::string& chain_id);
+  void RequestDeduplicated(const std::string& json_payload,
+                           RequestCallback callback);
+  void RequestBlockCached(const std::string& json_payload,
+                          RequestCallback callback);
+  void OnRequestBlockCached(
+      const std::string& key,
+      uint256_t block_number,
+      RequestCallback callback,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  void ClearBlockCache();
+  void OnRequestDeduplicated(
+      const std::string& key,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
   void OnGetBlockNumber(
       GetBlockNumberCallback callback,
+      const std::string& chain_id,
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
@@ -213,6 +232,14 @@ class EthJsonRpcController : public KeyedService,
   // <chain_id, EthereumChainRequest>
   base::flat_map<std::string, EthereumChainRequest> add_chain_pending_requests_;
   mojo::RemoteSet<mojom::EthJsonRpcControllerObserver> observers_;
+  // <network url + json payload, callbacks waiting on that response>
+  base::flat_map<std::string, std::vector<RequestCallback>>
+      in_flight_requests_;
+  // <chain id + json payload, response body> for results that are stable
+  // within the block |latest_block_number_|.
+  base::flat_map<std::string, std::string> block_cache_;
+  uint256_t latest_block_number_ = 0;
+  base::TimeTicks latest_block_time_;
 
   mojo::ReceiverSet<mojom::EthJsonRpcController> receivers_;
   PrefService* prefs_ = nullptr;
@@ -157,6 +157,15 @@ class EthJsonRpcControllerUnitTest : public testing::Test {
         }));
   }
 
+  void SetCountingInterceptor(const std::string& content, int* count) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, content, count](const network::ResourceRequest& request) {
+          (*count)++;
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(request.url.spec(), content);
+        }));
+  }
+
   void SetErrorInterceptor() {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&](const network::ResourceRequest& request) {
@@ -503,6 +512,75 @@ TEST_F(EthJsonRpcControllerUnitTest, GetBalance) {
   EXPECT_TRUE(callback_called);
 }
 
+TEST_F(EthJsonRpcControllerUnitTest, GetBalanceDeduplicatesInFlightRequests) {
+  int request_count = 0;
+  bool callback_called = false;
+  bool callback_called2 = false;
+  SetCountingInterceptor(
+      "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0xb539d5\"}",
+      &request_count);
+  rpc_controller_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindOnce(&OnStringResponse, &callback_called, true, "0xb539d5"));
+  rpc_controller_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindOnce(&OnStringResponse, &callback_called2, true, "0xb539d5"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  EXPECT_TRUE(callback_called2);
+  EXPECT_EQ(request_count, 1);
+
+  // Once the response is in, the next call goes to the network again.
+  callback_called = false;
+  rpc_controller_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindOnce(&OnStringResponse, &callback_called, true, "0xb539d5"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  EXPECT_EQ(request_count, 2);
+}
+
+TEST_F(EthJsonRpcControllerUnitTest, GetBalanceCachedWithinBlock) {
+  int request_count = 0;
+  SetCountingInterceptor(
+      "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0xb539d5\"}",
+      &request_count);
+  rpc_controller_->GetBlockNumber(
+      base::BindLambdaForTesting([](bool status, uint256_t block_num) {
+        EXPECT_TRUE(status);
+        EXPECT_EQ(block_num, uint256_t(11876821));
+      }));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(request_count, 1);
+
+  bool callback_called = false;
+  rpc_controller_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindOnce(&OnStringResponse, &callback_called, true, "0xb539d5"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  EXPECT_EQ(request_count, 2);
+
+  // Same block, so the response is served from the cache.
+  callback_called = false;
+  rpc_controller_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindOnce(&OnStringResponse, &callback_called, true, "0xb539d5"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  EXPECT_EQ(request_count, 2);
+
+  // Switching networks drops the cached result.
+  rpc_controller_->SetNetwork(mojom::kRopstenChainId);
+  callback_called = false;
+  rpc_controller_->GetBalance(
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      base::BindOnce(&OnStringResponse, &callback_called, true, "0xb539d5"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_called);
+  EXPECT_EQ(request_count, 3);
+}
+
 TEST_F(EthJsonRpcControllerUnitTest, GetERC20TokenBalance) {
   bool callback_called = false;
   SetInterceptor(
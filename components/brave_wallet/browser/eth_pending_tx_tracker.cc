@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/synchronization/lock.h"
@@ -31,6 +32,9 @@ void EthPendingTxTracker::UpdatePendingTransactions() {
   if (!nonce_lock->Try())
     return;
 
+  // Group pending transactions by sender so each address costs one nonce
+  // lookup per pass instead of one receipt lookup per transaction.
+  base::flat_map<std::string, std::vector<std::string>> pending_by_address;
   auto pending_transactions = tx_state_manager_->GetTransactionsByStatus(
       mojom::TransactionStatus::Submitted, absl::nullopt);
   for (const auto& pending_transaction : pending_transactions) {
@@ -38,14 +42,66 @@ void EthPendingTxTracker::UpdatePendingTransactions() {
       DropTransaction(pending_transaction.get());
       continue;
     }
-    std::string id = pending_transaction->id;
-    rpc_controller_->GetTransactionReceipt(
-        pending_transaction->tx_hash,
-        base::BindOnce(&EthPendingTxTracker::OnGetTxReceipt,
-                       weak_factory_.GetWeakPtr(), std::move(id)));
+    pending_by_address[pending_transaction->from.ToHex()].push_back(
+        pending_transaction->id);
   }
 
   nonce_lock->Release();
+
+  for (auto& entry : pending_by_address) {
+    const std::string& address = entry.first;
+    rpc_controller_->GetTransactionCount(
+        address,
+        base::BindOnce(&EthPendingTxTracker::OnGetNetworkNonceForPending,
+                       weak_factory_.GetWeakPtr(), address,
+                       std::move(entry.second)));
+  }
+}
+
+void EthPendingTxTracker::OnGetNetworkNonceForPending(
+    std::string address,
+    std::vector<std::string> ids,
+    bool status,
+    uint256_t network_nonce) {
+  if (!status) {
+    // Without the network nonce we can't tell which transactions could have
+    // been mined, so check every receipt.
+    for (auto& id : ids)
+      GetTxReceipt(std::move(id));
+    return;
+  }
+
+  base::Lock* nonce_lock = nonce_tracker_->GetLock();
+  if (!nonce_lock->Try())
+    return;
+
+  for (auto& id : ids) {
+    std::unique_ptr<EthTxStateManager::TxMeta> meta =
+        tx_state_manager_->GetTx(id);
+    if (!meta || meta->status != mojom::TransactionStatus::Submitted)
+      continue;
+    if (meta->tx->nonce() < network_nonce) {
+      // The nonce slot was used, either by this transaction or by one that
+      // replaced it; the receipt tells which.
+      GetTxReceipt(std::move(id));
+    } else if (IsDroppedAfterBlocks(meta->tx_hash)) {
+      // The slot is still open, so this transaction can't have a receipt
+      // yet and there is nothing to ask the node about.
+      DropTransaction(meta.get());
+    }
+  }
+
+  nonce_lock->Release();
+}
+
+void EthPendingTxTracker::GetTxReceipt(std::string id) {
+  std::unique_ptr<EthTxStateManager::TxMeta> meta =
+      tx_state_manager_->GetTx(id);
+  if (!meta)
+    return;
+  rpc_controller_->GetTransactionReceipt(
+      meta->tx_hash, base::BindOnce(&EthPendingTxTracker::OnGetTxReceipt,
+                                    weak_factory_.GetWeakPtr(), std::move(id)));
 }
 
 void EthPendingTxTracker::ResubmitPendingTransactions() {
@@ -127,7 +183,10 @@ bool EthPendingTxTracker::ShouldTxDropped(
       return true;
   }
 
-  const std::string tx_hash = meta.tx_hash;
+  return IsDroppedAfterBlocks(meta.tx_hash);
+}
+
+bool EthPendingTxTracker::IsDroppedAfterBlocks(const std::string& tx_hash) {
   if (dropped_blocks_counter_.find(tx_hash) == dropped_blocks_counter_.end()) {
     dropped_blocks_counter_[tx_hash] = 0;
   }
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_PENDING_TX_TRACKER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
@@ -35,13 +36,23 @@ class EthPendingTxTracker {
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, IsNonceTaken);
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, ShouldTxDropped);
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, DropTransaction);
-
+  FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest,
+                           UpdatePendingTransactionsSkipsOpenNonce);
+
+  void OnGetNetworkNonceForPending(std::string address,
+                                   std::vector<std::string> ids,
+                                   bool status,
+                                   uint256_t network_nonce);
+  void GetTxReceipt(std::string id);
   void OnGetTxReceipt(std::string id, bool status, TransactionReceipt receipt);
   void OnGetNetworkNonce(std::string address, bool status, uint256_t result);
   void OnSendRawTransaction(bool status, const std::string& tx_hash);
 
   bool IsNonceTaken(const EthTxStateManager::TxMeta&);
   bool ShouldTxDropped(const EthTxStateManager::TxMeta&);
+  // Counts the blocks |tx_hash| has gone unmined and returns true once it
+  // should be given up on.
+  bool IsDroppedAfterBlocks(const std::string& tx_hash);
 
   void DropTransaction(EthTxStateManager::TxMeta*);
 
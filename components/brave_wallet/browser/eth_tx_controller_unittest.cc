@@ -167,7 +167,7 @@ class EthTxControllerUnitTest : public testing::Test {
     rpc_controller_->SetNetwork(brave_wallet::mojom::kLocalhostChainId);
     keyring_controller_->CreateWallet(
         "testing123", base::DoNothing::Once<const std::string&>());
-    base::RunLoop().RunUntilIdle();
+    task_environment_.RunUntilIdle();
     keyring_controller_->AddAccount("Account 1", base::DoNothing::Once<bool>());
     base::RunLoop().RunUntilIdle();
 
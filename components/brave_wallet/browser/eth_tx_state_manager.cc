@@ -7,6 +7,8 @@
 
 #include <utility>
 
+#include "base/auto_reset.h"
+#include "base/bind.h"
 #include "base/guid.h"
 #include "base/json/values_util.h"
 #include "base/logging.h"
@@ -26,6 +28,38 @@ namespace brave_wallet {
 namespace {
 constexpr size_t kMaxConfirmedTxNum = 10;
 constexpr size_t kMaxRejectedTxNum = 10;
+
+std::unique_ptr<EthTransaction> CloneTransaction(const EthTransaction& tx) {
+  switch (tx.type()) {
+    case 1:
+      // When type is 1 it's always Eip2930Transaction
+      return std::make_unique<Eip2930Transaction>(
+          static_cast<const Eip2930Transaction&>(tx));
+    case 2:
+      // When type is 2 it's always Eip1559Transaction
+      return std::make_unique<Eip1559Transaction>(
+          static_cast<const Eip1559Transaction&>(tx));
+    default:
+      return std::make_unique<EthTransaction>(tx);
+  }
+}
+
+std::unique_ptr<EthTxStateManager::TxMeta> CloneTxMeta(
+    const EthTxStateManager::TxMeta& meta) {
+  auto clone = std::make_unique<EthTxStateManager::TxMeta>(
+      CloneTransaction(*meta.tx));
+  clone->id = meta.id;
+  clone->status = meta.status;
+  clone->from = meta.from;
+  clone->last_gas_price = meta.last_gas_price;
+  clone->created_time = meta.created_time;
+  clone->submitted_time = meta.submitted_time;
+  clone->confirmed_time = meta.confirmed_time;
+  clone->tx_receipt = meta.tx_receipt;
+  clone->tx_hash = meta.tx_hash;
+  return clone;
+}
+
 }  // namespace
 
 EthTxStateManager::EthTxStateManager(
@@ -40,6 +74,11 @@ EthTxStateManager::EthTxStateManager(
   rpc_controller_->AddObserver(observer_receiver_.BindNewPipeAndPassRemote());
   rpc_controller_->GetChainId(base::BindOnce(&EthTxStateManager::OnGetChainId,
                                              weak_factory_.GetWeakPtr()));
+  pref_change_registrar_.Init(prefs_);
+  pref_change_registrar_.Add(
+      kBraveWalletTransactions,
+      base::BindRepeating(&EthTxStateManager::OnTransactionsPrefChanged,
+                          base::Unretained(this)));
 }
 EthTxStateManager::~EthTxStateManager() = default;
 
@@ -225,11 +264,18 @@ std::unique_ptr<EthTxStateManager::TxMeta> EthTxStateManager::ValueToTxMeta(
 }
 
 void EthTxStateManager::AddOrUpdateTx(const TxMeta& meta) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::DictionaryValue* dict = update.Get();
-  const std::string path = GetNetworkId(prefs_, chain_id_) + "." + meta.id;
-  bool is_add = dict->FindPath(path) == nullptr;
-  dict->SetPath(path, TxMetaToValue(meta));
+  const std::string network_id = GetNetworkId(prefs_, chain_id_);
+  bool is_add;
+  {
+    base::AutoReset<bool> updating_prefs(&updating_prefs_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::DictionaryValue* dict = update.Get();
+    const std::string path = network_id + "." + meta.id;
+    is_add = dict->FindPath(path) == nullptr;
+    dict->SetPath(path, TxMetaToValue(meta));
+  }
+  if (cache_loaded_ && cached_network_id_ == network_id)
+    CacheTx(CloneTxMeta(meta));
   if (!is_add)
     return;
   // We only keep most recent 10 confirmed and rejected tx metas per network
@@ -239,22 +285,24 @@ void EthTxStateManager::AddOrUpdateTx(const TxMeta& meta) {
 
 std::unique_ptr<EthTxStateManager::TxMeta> EthTxStateManager::GetTx(
     const std::string& id) {
-  const base::DictionaryValue* dict =
-      prefs_->GetDictionary(kBraveWalletTransactions);
-  if (!dict)
-    return nullptr;
-  const base::Value* value =
-      dict->FindPath(GetNetworkId(prefs_, chain_id_) + "." + id);
-  if (!value)
+  EnsureCacheLoaded();
+  auto it = tx_cache_.find(id);
+  if (it == tx_cache_.end())
     return nullptr;
 
-  return ValueToTxMeta(*value);
+  return CloneTxMeta(*it->second);
 }
 
 void EthTxStateManager::DeleteTx(const std::string& id) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::DictionaryValue* dict = update.Get();
-  dict->RemovePath(GetNetworkId(prefs_, chain_id_) + "." + id);
+  const std::string network_id = GetNetworkId(prefs_, chain_id_);
+  {
+    base::AutoReset<bool> updating_prefs(&updating_prefs_, true);
+    DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
+    base::DictionaryValue* dict = update.Get();
+    dict->RemovePath(network_id + "." + id);
+  }
+  if (cache_loaded_ && cached_network_id_ == network_id)
+    UncacheTx(id);
 }
 
 void EthTxStateManager::WipeTxs() {
@@ -266,25 +314,76 @@ EthTxStateManager::GetTransactionsByStatus(
     absl::optional<mojom::TransactionStatus> status,
     absl::optional<EthAddress> from) {
   std::vector<std::unique_ptr<EthTxStateManager::TxMeta>> result;
+  EnsureCacheLoaded();
+
+  auto add_if_from_matches = [&](const TxMeta& meta) {
+    if (from.has_value() && meta.from != *from)
+      return;
+    result.push_back(CloneTxMeta(meta));
+  };
+
+  if (!status.has_value()) {
+    for (const auto& entry : tx_cache_)
+      add_if_from_matches(*entry.second);
+    return result;
+  }
+
+  auto index_it = status_index_.find(*status);
+  if (index_it == status_index_.end())
+    return result;
+  for (const auto& id : index_it->second)
+    add_if_from_matches(*tx_cache_[id]);
+  return result;
+}
+
+void EthTxStateManager::EnsureCacheLoaded() {
+  const std::string network_id = GetNetworkId(prefs_, chain_id_);
+  if (cache_loaded_ && cached_network_id_ == network_id)
+    return;
+
+  tx_cache_.clear();
+  status_index_.clear();
+  cached_network_id_ = network_id;
+  cache_loaded_ = true;
+
   const base::DictionaryValue* dict =
       prefs_->GetDictionary(kBraveWalletTransactions);
-  const base::Value* network_dict =
-      dict->FindKey(GetNetworkId(prefs_, chain_id_));
+  const base::Value* network_dict = dict->FindKey(network_id);
   if (!network_dict)
-    return result;
+    return;
 
   for (const auto it : network_dict->DictItems()) {
     std::unique_ptr<EthTxStateManager::TxMeta> meta = ValueToTxMeta(it.second);
     if (!meta) {
       continue;
     }
-    if (!status.has_value() || meta->status == *status) {
-      if (from.has_value() && meta->from != *from)
-        continue;
-      result.push_back(std::move(meta));
-    }
+    CacheTx(std::move(meta));
   }
-  return result;
+}
+
+void EthTxStateManager::CacheTx(std::unique_ptr<TxMeta> meta) {
+  UncacheTx(meta->id);
+  status_index_[meta->status].insert(meta->id);
+  const std::string id = meta->id;
+  tx_cache_[id] = std::move(meta);
+}
+
+void EthTxStateManager::UncacheTx(const std::string& id) {
+  auto it = tx_cache_.find(id);
+  if (it == tx_cache_.end())
+    return;
+  status_index_[it->second->status].erase(id);
+  tx_cache_.erase(it);
+}
+
+void EthTxStateManager::OnTransactionsPrefChanged() {
+  // Writes made through this class keep the cache in sync themselves;
+  // anything else (e.g. WipeTxs or a pref reset) invalidates it.
+  if (updating_prefs_)
+    return;
+  cache_loaded_ = false;
+  tx_cache_.clear();
+  status_index_.clear();
 }
 
 void EthTxStateManager::ChainChangedEvent(const std::string& chain_id) {
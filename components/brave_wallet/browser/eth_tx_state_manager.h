@@ -6,16 +6,20 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_TX_STATE_MANAGER_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_TX_STATE_MANAGER_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/time/time.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
 #include "brave/components/brave_wallet/browser/eth_address.h"
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 #include "brave/components/brave_wallet/browser/eth_transaction.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 class PrefService;
@@ -83,6 +87,13 @@ class EthTxStateManager : public mojom::EthJsonRpcControllerObserver {
   // only support REJECTED and CONFIRMED
   void RetireTxByStatus(mojom::TransactionStatus status, size_t max_num);
 
+  // Loads the transactions of the current network from prefs into
+  // |tx_cache_| unless they are already there.
+  void EnsureCacheLoaded();
+  void CacheTx(std::unique_ptr<TxMeta> meta);
+  void UncacheTx(const std::string& id);
+  void OnTransactionsPrefChanged();
+
   void OnConnectionError();
   void OnGetNetworkUrl(const std::string& url);
   void OnGetChainId(const std::string& chain_id);
@@ -93,6 +104,17 @@ class EthTxStateManager : public mojom::EthJsonRpcControllerObserver {
   std::string chain_id_;
   std::string network_url_;
   base::OnceClosure chain_callback_for_testing_;
+
+  // Deserialized transactions of |cached_network_id_|, indexed by status, so
+  // lookups don't have to parse the pref every time.
+  bool cache_loaded_ = false;
+  std::string cached_network_id_;
+  std::map<std::string, std::unique_ptr<TxMeta>> tx_cache_;
+  base::flat_map<mojom::TransactionStatus, std::set<std::string>>
+      status_index_;
+  bool updating_prefs_ = false;
+  PrefChangeRegistrar pref_change_registrar_;
+
   base::WeakPtrFactory<EthTxStateManager> weak_factory_;
 };
 
@@ -32,11 +32,17 @@ void HDKeyring::ConstructRootHDKey(const std::vector<uint8_t>& seed,
 }
 
 void HDKeyring::AddAccounts(size_t number) {
+  if (!root_)
+    return;
+  // Accounts are siblings under |root_|, so each one is a single
+  // non-hardened derivation from the already derived account-level key
   size_t cur_accounts_number = accounts_.size();
+  accounts_.reserve(cur_accounts_number + number);
+  account_addresses_.reserve(cur_accounts_number + number);
   for (size_t i = cur_accounts_number; i < cur_accounts_number + number; ++i) {
-    if (root_) {
-      accounts_.push_back(root_->DeriveChild(i));
-    }
+    accounts_.push_back(root_->DeriveChild(i));
+    if (account_addresses_.size() == i)
+      account_addresses_.push_back(GetAddressInternal(accounts_.back().get()));
   }
 }
 
@@ -63,6 +69,8 @@ size_t HDKeyring::GetAccountsNumber() const {
 }
 
 void HDKeyring::RemoveAccount() {
+  if (account_addresses_.size() == accounts_.size())
+    account_addresses_.pop_back();
   accounts_.pop_back();
 }
 
@@ -96,6 +104,8 @@ bool HDKeyring::RemoveImportedAccount(const std::string& address) {
 std::string HDKeyring::GetAddress(size_t index) const {
   if (accounts_.empty() || index >= accounts_.size())
     return std::string();
+  if (index < account_addresses_.size())
+    return account_addresses_[index];
   return GetAddressInternal(accounts_[index].get());
 }
 
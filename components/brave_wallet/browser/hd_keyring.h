@@ -65,6 +65,9 @@ class HDKeyring {
   std::unique_ptr<HDKey> root_;
   std::unique_ptr<HDKey> master_key_;
   std::vector<std::unique_ptr<HDKey>> accounts_;
+  // Checksum addresses of |accounts_| computed once when they are derived, so
+  // address lookups don't redo the public key and keccak for every account
+  std::vector<std::string> account_addresses_;
   // (address, key)
   base::flat_map<std::string, std::unique_ptr<HDKey>> imported_accounts_;
 
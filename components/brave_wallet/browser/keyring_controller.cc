@@ -8,9 +8,12 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -79,6 +82,19 @@
  */
 
 namespace brave_wallet {
+
+// Everything the UI sequence needs to (re)construct the default keyring once
+// the password has been stretched. A null |seed| means the password was wrong
+// or the mnemonic couldn't be turned into a seed.
+struct DerivedKeyring {
+  std::unique_ptr<PasswordEncryptor> encryptor;
+  std::string mnemonic;
+  std::unique_ptr<std::vector<uint8_t>> seed;
+  // Set when restoring found a different wallet and |encryptor| was derived
+  // with the fresh salt instead of the stored one
+  bool uses_new_salt = false;
+};
+
 namespace {
 const size_t kSaltSize = 32;
 const size_t kNonceSize = 12;
@@ -99,6 +115,8 @@ const char kEncryptedPrivateKey[] = "encrypted_private_key";
 const char kLegacyBraveWallet[] = "legacy_brave_wallet";
 const char kHardwareKeyrings[] = "hardware";
 const char kHardwareDerivationPath[] = "derivation_path";
+const size_t kPbkdf2Iterations = 100000;
+const size_t kPbkdf2KeySize = 256;
 
 static base::span<const uint8_t> ToSpan(base::StringPiece sp) {
   return base::as_bytes(base::make_span(sp));
@@ -131,14 +149,94 @@ void SerializeHardwareAccounts(const base::Value* account_value,
   }
 }
 
+std::unique_ptr<std::vector<uint8_t>> MnemonicToKeyringSeed(
+    const std::string& mnemonic,
+    bool is_legacy_brave_wallet) {
+  std::unique_ptr<std::vector<uint8_t>> seed = nullptr;
+  if (is_legacy_brave_wallet)
+    seed = MnemonicToEntropy(mnemonic);
+  else
+    seed = MnemonicToSeed(mnemonic, "");
+  if (!seed)
+    return nullptr;
+  if (is_legacy_brave_wallet && seed->size() != 32) {
+    VLOG(1) << __func__
+            << "mnemonic for legacy brave wallet must be 24 words which will "
+               "produce 32 bytes seed";
+    return nullptr;
+  }
+  return seed;
+}
+
+// Runs on the key derivation sequence. Derives the password key with |salt|
+// and, unless |mnemonic| is given, recovers the mnemonic from
+// |encrypted_mnemonic|. When |new_salt| is not empty and the stored mnemonic
+// doesn't match |mnemonic| and |is_legacy_brave_wallet|, the key is derived
+// again with |new_salt| for the wallet that replaces it.
+std::unique_ptr<DerivedKeyring> DeriveKeyring(
+    const std::string& password,
+    const std::vector<uint8_t>& salt,
+    const std::vector<uint8_t>& nonce,
+    const std::vector<uint8_t>& encrypted_mnemonic,
+    const std::string& mnemonic,
+    bool is_legacy_brave_wallet,
+    bool stored_is_legacy_brave_wallet,
+    const std::vector<uint8_t>& new_salt) {
+  auto result = std::make_unique<DerivedKeyring>();
+  result->encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  if (!result->encryptor)
+    return result;
+
+  std::string stored_mnemonic;
+  std::vector<uint8_t> decrypted;
+  if (!encrypted_mnemonic.empty() &&
+      result->encryptor->Decrypt(encrypted_mnemonic, nonce, &decrypted)) {
+    stored_mnemonic = std::string(decrypted.begin(), decrypted.end());
+  }
+
+  if (!new_salt.empty() &&
+      (stored_mnemonic.empty() || stored_mnemonic != mnemonic ||
+       stored_is_legacy_brave_wallet != is_legacy_brave_wallet)) {
+    result->uses_new_salt = true;
+    result->encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+        password, new_salt, kPbkdf2Iterations, kPbkdf2KeySize);
+    if (!result->encryptor)
+      return result;
+  }
+
+  result->mnemonic = mnemonic.empty() ? stored_mnemonic : mnemonic;
+  if (result->mnemonic.empty())
+    return result;
+
+  result->seed =
+      MnemonicToKeyringSeed(result->mnemonic, is_legacy_brave_wallet);
+  return result;
+}
+
 }  // namespace
 
-KeyringController::KeyringController(PrefService* prefs) : prefs_(prefs) {
+KeyringController::KeyringController(PrefService* prefs)
+    : prefs_(prefs),
+      key_derivation_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN})) {
   DCHECK(prefs);
+  pref_change_registrar_.Init(prefs_);
+  pref_change_registrar_.Add(
+      kBraveWalletKeyrings,
+      base::BindRepeating(&KeyringController::OnKeyringsPrefChanged,
+                          base::Unretained(this)));
 }
 
 KeyringController::~KeyringController() {}
 
+KeyringController::KeyringModel::KeyringModel() = default;
+KeyringController::KeyringModel::~KeyringModel() = default;
+KeyringController::KeyringModel::KeyringModel(KeyringModel&&) = default;
+KeyringController::KeyringModel& KeyringController::KeyringModel::operator=(
+    KeyringModel&&) = default;
+
 mojo::PendingRemote<mojom::KeyringController> KeyringController::MakeRemote() {
   mojo::PendingRemote<mojom::KeyringController> remote;
   receivers_.Add(this, remote.InitWithNewPipeAndPassReceiver());
@@ -426,15 +524,24 @@ HDKeyring* KeyringController::ResumeDefaultKeyring(
   }
 
   const std::string mnemonic = GetMnemonicForDefaultKeyringImpl();
-  bool is_legacy_brave_wallet = false;
-  const base::Value* value =
-      GetPrefForKeyring(prefs_, kLegacyBraveWallet, kDefaultKeyringId);
-  if (value)
-    is_legacy_brave_wallet = value->GetBool();
-  if (mnemonic.empty() ||
-      !CreateDefaultKeyringInternal(mnemonic, is_legacy_brave_wallet)) {
+  if (mnemonic.empty())
     return nullptr;
-  }
+
+  const bool is_legacy_brave_wallet = IsLegacyBraveWallet();
+  auto seed = MnemonicToKeyringSeed(mnemonic, is_legacy_brave_wallet);
+  if (!seed)
+    return nullptr;
+
+  return ResumeDefaultKeyringFromSeed(mnemonic, *seed, is_legacy_brave_wallet);
+}
+
+HDKeyring* KeyringController::ResumeDefaultKeyringFromSeed(
+    const std::string& mnemonic,
+    const std::vector<uint8_t>& seed,
+    bool is_legacy_brave_wallet) {
+  if (!CreateDefaultKeyringFromSeed(mnemonic, seed, is_legacy_brave_wallet))
+    return nullptr;
+
   size_t account_no = GetAccountMetasNumberForKeyring(kDefaultKeyringId);
   if (account_no)
     default_keyring_->AddAccounts(account_no);
@@ -448,8 +555,11 @@ HDKeyring* KeyringController::ResumeDefaultKeyring(
                              kDefaultKeyringId);
   }
 
-  for (const auto& imported_account_info :
-       GetImportedAccountsForKeyring(prefs_, kDefaultKeyringId)) {
+  // Copied since GetOrCreateNonceForKeyring may write the pref and drop the
+  // model while iterating.
+  const std::vector<ImportedAccountInfo> imported_accounts =
+      GetKeyringModel(kDefaultKeyringId).imported_accounts;
+  for (const auto& imported_account_info : imported_accounts) {
     std::string private_key_decoded;
     if (!base::Base64Decode(imported_account_info.encrypted_private_key,
                             &private_key_decoded))
@@ -484,7 +594,12 @@ HDKeyring* KeyringController::RestoreDefaultKeyring(
         GetPrefForKeyring(prefs_, kLegacyBraveWallet, kDefaultKeyringId);
     if (!current_mnemonic.empty() && current_mnemonic == mnemonic && value &&
         value->GetBool() == is_legacy_brave_wallet) {
-      return ResumeDefaultKeyring(password);
+      // The key derived above is the one Resume would derive again
+      auto seed = MnemonicToKeyringSeed(mnemonic, is_legacy_brave_wallet);
+      if (!seed)
+        return nullptr;
+      return ResumeDefaultKeyringFromSeed(mnemonic, *seed,
+                                          is_legacy_brave_wallet);
     } else {
       // We have no way to check if new mnemonic is same as current mnemonic so
       // we need to clear all prefs for fresh start
@@ -529,8 +644,33 @@ void KeyringController::GetMnemonicForDefaultKeyring(
 
 void KeyringController::CreateWallet(const std::string& password,
                                      CreateWalletCallback callback) {
-  auto* keyring = CreateDefaultKeyring(password);
-  if (keyring) {
+  if (password.empty()) {
+    std::move(callback).Run(GetMnemonicForDefaultKeyringImpl());
+    return;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      key_derivation_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&DeriveKeyring, password,
+                     GetOrCreateSaltForKeyring(kDefaultKeyringId),
+                     std::vector<uint8_t>(), std::vector<uint8_t>(),
+                     GenerateMnemonic(16), false, false,
+                     std::vector<uint8_t>()),
+      base::BindOnce(&KeyringController::OnCreateWalletKeyringDerived,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void KeyringController::OnCreateWalletKeyringDerived(
+    CreateWalletCallback callback,
+    std::unique_ptr<DerivedKeyring> derived) {
+  if (derived->encryptor)
+    encryptor_ = std::move(derived->encryptor);
+
+  if (derived->seed &&
+      CreateDefaultKeyringFromSeed(derived->mnemonic, *derived->seed, false)) {
+    for (const auto& observer : observers_) {
+      observer->KeyringCreated();
+    }
     AddAccountForDefaultKeyring(kFirstAccountName);
   }
 
@@ -541,8 +681,59 @@ void KeyringController::RestoreWallet(const std::string& mnemonic,
                                       const std::string& password,
                                       bool is_legacy_brave_wallet,
                                       RestoreWalletCallback callback) {
-  auto* keyring =
-      RestoreDefaultKeyring(mnemonic, password, is_legacy_brave_wallet);
+  if (!IsValidMnemonic(mnemonic) || password.empty()) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  // A fresh salt is only used when the stored wallet turns out to be a
+  // different one, in which case it is reset before the new one is saved
+  std::vector<uint8_t> new_salt(kSaltSize);
+  crypto::RandBytes(new_salt);
+
+  std::vector<uint8_t> encrypted_mnemonic;
+  GetPrefInBytesForKeyring(kEncryptedMnemonic, &encrypted_mnemonic,
+                           kDefaultKeyringId);
+
+  base::PostTaskAndReplyWithResult(
+      key_derivation_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&DeriveKeyring, password,
+                     GetOrCreateSaltForKeyring(kDefaultKeyringId),
+                     GetOrCreateNonceForKeyring(kDefaultKeyringId),
+                     std::move(encrypted_mnemonic), mnemonic,
+                     is_legacy_brave_wallet, IsLegacyBraveWallet(), new_salt),
+      base::BindOnce(&KeyringController::OnRestoreWalletKeyringDerived,
+                     weak_ptr_factory_.GetWeakPtr(), is_legacy_brave_wallet,
+                     new_salt, std::move(callback)));
+}
+
+void KeyringController::OnRestoreWalletKeyringDerived(
+    bool is_legacy_brave_wallet,
+    const std::vector<uint8_t>& new_salt,
+    RestoreWalletCallback callback,
+    std::unique_ptr<DerivedKeyring> derived) {
+  HDKeyring* keyring = nullptr;
+  if (derived->uses_new_salt) {
+    // We have no way to check if new mnemonic is same as current mnemonic so
+    // we need to clear all prefs for fresh start
+    Reset();
+    SetPrefInBytesForKeyring(kPasswordEncryptorSalt, new_salt,
+                             kDefaultKeyringId);
+    encryptor_ = std::move(derived->encryptor);
+    if (derived->seed &&
+        CreateDefaultKeyringFromSeed(derived->mnemonic, *derived->seed,
+                                     is_legacy_brave_wallet)) {
+      for (const auto& observer : observers_) {
+        observer->KeyringRestored();
+      }
+      keyring = default_keyring_.get();
+    }
+  } else if (derived->encryptor && derived->seed) {
+    encryptor_ = std::move(derived->encryptor);
+    keyring = ResumeDefaultKeyringFromSeed(derived->mnemonic, *derived->seed,
+                                           is_legacy_brave_wallet);
+  }
+
   if (keyring && !keyring->GetAccountsNumber()) {
     AddAccountForDefaultKeyring(kFirstAccountName);
   }
@@ -656,8 +847,9 @@ void KeyringController::GetPrivateKeyForImportedAccount(
     std::move(callback).Run(false, "");
     return;
   }
-  for (const auto& imported_account_info :
-       GetImportedAccountsForKeyring(prefs_, kDefaultKeyringId)) {
+  const std::vector<ImportedAccountInfo> imported_accounts =
+      GetKeyringModel(kDefaultKeyringId).imported_accounts;
+  for (const auto& imported_account_info : imported_accounts) {
     if (imported_account_info.account_address == address) {
       std::string private_key_decoded;
       if (!base::Base64Decode(imported_account_info.encrypted_private_key,
@@ -752,12 +944,44 @@ absl::optional<std::string> KeyringController::ImportAccountForDefaultKeyring(
 
 size_t KeyringController::GetAccountMetasNumberForKeyring(
     const std::string& id) {
+  return GetKeyringModel(id).derived_accounts.size();
+}
+
+const KeyringController::KeyringModel& KeyringController::GetKeyringModel(
+    const std::string& id) {
+  auto it = keyring_models_.find(id);
+  if (it != keyring_models_.end())
+    return it->second;
+
+  KeyringModel model;
   const base::Value* account_metas =
       GetPrefForKeyring(prefs_, kAccountMetas, id);
-  if (!account_metas)
-    return 0;
+  if (account_metas && account_metas->is_dict()) {
+    size_t account_no = account_metas->DictSize();
+    model.derived_accounts.reserve(account_no);
+    for (size_t i = 0; i < account_no; ++i) {
+      KeyringModel::DerivedAccount account;
+      const base::Value* account_meta =
+          account_metas->FindKey(GetAccountPathByIndex(i));
+      if (account_meta) {
+        const std::string* name = account_meta->FindStringKey(kAccountName);
+        if (name)
+          account.name = *name;
+        const std::string* address =
+            account_meta->FindStringKey(kAccountAddress);
+        if (address)
+          account.address = *address;
+      }
+      model.derived_accounts.push_back(std::move(account));
+    }
+  }
+  model.imported_accounts = GetImportedAccountsForKeyring(prefs_, id);
 
-  return account_metas->DictSize();
+  return keyring_models_.emplace(id, std::move(model)).first->second;
+}
+
+void KeyringController::OnKeyringsPrefChanged() {
+  keyring_models_.clear();
 }
 
 // This member function should not assume that the wallet is unlocked!
@@ -765,19 +989,18 @@ std::vector<mojom::AccountInfoPtr> KeyringController::GetAccountInfosForKeyring(
     const std::string& id) {
   std::vector<mojom::AccountInfoPtr> result;
 
-  size_t account_no = GetAccountMetasNumberForKeyring(kDefaultKeyringId);
-  for (size_t i = 0; i < account_no; ++i) {
+  const KeyringModel& model = GetKeyringModel(id);
+  result.reserve(model.derived_accounts.size() +
+                 model.imported_accounts.size());
+  for (const auto& derived_account : model.derived_accounts) {
     mojom::AccountInfoPtr account_info = mojom::AccountInfo::New();
-    account_info->address =
-        GetAccountAddressForKeyring(prefs_, GetAccountPathByIndex(i), id);
-    account_info->name =
-        GetAccountNameForKeyring(prefs_, GetAccountPathByIndex(i), id);
+    account_info->address = derived_account.address;
+    account_info->name = derived_account.name;
     account_info->is_imported = false;
     result.push_back(std::move(account_info));
   }
   // append imported account info
-  for (const auto& imported_account_info :
-       GetImportedAccountsForKeyring(prefs_, id)) {
+  for (const auto& imported_account_info : model.imported_accounts) {
     mojom::AccountInfoPtr account_info = mojom::AccountInfo::New();
     account_info->address = imported_account_info.account_address;
     account_info->name = imported_account_info.account_name;
@@ -904,7 +1127,36 @@ void KeyringController::Lock() {
 
 void KeyringController::Unlock(const std::string& password,
                                UnlockCallback callback) {
-  if (!ResumeDefaultKeyring(password)) {
+  std::vector<uint8_t> encrypted_mnemonic;
+  if (password.empty() ||
+      !GetPrefInBytesForKeyring(kEncryptedMnemonic, &encrypted_mnemonic,
+                                kDefaultKeyringId)) {
+    encryptor_.reset();
+    std::move(callback).Run(false);
+    return;
+  }
+
+  base::PostTaskAndReplyWithResult(
+      key_derivation_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&DeriveKeyring, password,
+                     GetOrCreateSaltForKeyring(kDefaultKeyringId),
+                     GetOrCreateNonceForKeyring(kDefaultKeyringId),
+                     std::move(encrypted_mnemonic), std::string(),
+                     IsLegacyBraveWallet(), IsLegacyBraveWallet(),
+                     std::vector<uint8_t>()),
+      base::BindOnce(&KeyringController::OnUnlockKeyringDerived,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void KeyringController::OnUnlockKeyringDerived(
+    UnlockCallback callback,
+    std::unique_ptr<DerivedKeyring> derived) {
+  if (derived->seed) {
+    encryptor_ = std::move(derived->encryptor);
+  }
+  if (!derived->seed ||
+      !ResumeDefaultKeyringFromSeed(derived->mnemonic, *derived->seed,
+                                    IsLegacyBraveWallet())) {
     encryptor_.reset();
     std::move(callback).Run(false);
     return;
@@ -968,17 +1220,23 @@ std::vector<uint8_t> KeyringController::GetOrCreateNonceForKeyring(
   return nonce;
 }
 
-bool KeyringController::CreateEncryptorForKeyring(const std::string& password,
-                                                  const std::string& id) {
-  if (password.empty())
-    return false;
+std::vector<uint8_t> KeyringController::GetOrCreateSaltForKeyring(
+    const std::string& id) {
   std::vector<uint8_t> salt(kSaltSize);
   if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt, id)) {
     crypto::RandBytes(salt);
     SetPrefInBytesForKeyring(kPasswordEncryptorSalt, salt, id);
   }
+  return salt;
+}
+
+bool KeyringController::CreateEncryptorForKeyring(const std::string& password,
+                                                  const std::string& id) {
+  if (password.empty())
+    return false;
   encryptor_ = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, 100000, 256);
+      password, GetOrCreateSaltForKeyring(id), kPbkdf2Iterations,
+      kPbkdf2KeySize);
   return encryptor_ != nullptr;
 }
 
@@ -988,19 +1246,19 @@ bool KeyringController::CreateDefaultKeyringInternal(
   if (!encryptor_)
     return false;
 
-  std::unique_ptr<std::vector<uint8_t>> seed = nullptr;
-  if (is_legacy_brave_wallet)
-    seed = MnemonicToEntropy(mnemonic);
-  else
-    seed = MnemonicToSeed(mnemonic, "");
+  auto seed = MnemonicToKeyringSeed(mnemonic, is_legacy_brave_wallet);
   if (!seed)
     return false;
-  if (is_legacy_brave_wallet && seed->size() != 32) {
-    VLOG(1) << __func__
-            << "mnemonic for legacy brave wallet must be 24 words which will "
-               "produce 32 bytes seed";
+
+  return CreateDefaultKeyringFromSeed(mnemonic, *seed, is_legacy_brave_wallet);
+}
+
+bool KeyringController::CreateDefaultKeyringFromSeed(
+    const std::string& mnemonic,
+    const std::vector<uint8_t>& seed,
+    bool is_legacy_brave_wallet) {
+  if (!encryptor_)
     return false;
-  }
 
   std::vector<uint8_t> encrypted_mnemonic;
   if (!encryptor_->Encrypt(ToSpan(mnemonic),
@@ -1019,12 +1277,18 @@ bool KeyringController::CreateDefaultKeyringInternal(
                       kDefaultKeyringId);
 
   default_keyring_ = std::make_unique<HDKeyring>();
-  default_keyring_->ConstructRootHDKey(*seed, kRootPath);
+  default_keyring_->ConstructRootHDKey(seed, kRootPath);
   UpdateLastUnlockPref(prefs_);
 
   return true;
 }
 
+bool KeyringController::IsLegacyBraveWallet() const {
+  const base::Value* value =
+      GetPrefForKeyring(prefs_, kLegacyBraveWallet, kDefaultKeyringId);
+  return value && value->GetBool();
+}
+
 bool KeyringController::IsDefaultKeyringCreated() {
   return HasPrefForKeyring(prefs_, kEncryptedMnemonic, kDefaultKeyringId);
 }
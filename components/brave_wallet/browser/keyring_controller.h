@@ -10,12 +10,16 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_types.h"
 #include "brave/components/brave_wallet/browser/password_encryptor.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/keyed_service/core/keyed_service.h"
+#include "components/prefs/pref_change_registrar.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "mojo/public/cpp/bindings/remote_set.h"
@@ -23,14 +27,21 @@
 
 class PrefService;
 
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
 namespace brave_wallet {
 
 class HDKeyring;
+struct DerivedKeyring;
 class EthTransaction;
 class KeyringControllerUnitTest;
 class BraveWalletProviderImplUnitTest;
 
-// This class is not thread-safe and should have single owner
+// This class is not thread-safe and should have single owner. Password key
+// and seed derivation for CreateWallet, RestoreWallet and Unlock runs on a
+// thread pool sequence and the mojo callbacks are replied asynchronously.
 class KeyringController : public KeyedService, public mojom::KeyringController {
  public:
   explicit KeyringController(PrefService* prefs);
@@ -179,9 +190,29 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest,
                            SetDefaultKeyringDerivedAccountMeta);
   FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, RestoreLegacyBraveWallet);
+  FRIEND_TEST_ALL_PREFIXES(KeyringControllerUnitTest, KeyringModelTracksPrefs);
   friend class BraveWalletProviderImplUnitTest;
   friend class EthTxControllerUnitTest;
 
+  // In-memory view of the accounts stored in kBraveWalletKeyrings for one
+  // keyring. Built on first read and dropped whenever the pref changes.
+  struct KeyringModel {
+    KeyringModel();
+    ~KeyringModel();
+    KeyringModel(KeyringModel&&);
+    KeyringModel& operator=(KeyringModel&&);
+
+    struct DerivedAccount {
+      std::string name;
+      std::string address;
+    };
+    // Indexed by derivation index, see GetAccountPathByIndex.
+    std::vector<DerivedAccount> derived_accounts;
+    std::vector<ImportedAccountInfo> imported_accounts;
+  };
+  const KeyringModel& GetKeyringModel(const std::string& id);
+  void OnKeyringsPrefChanged();
+
   void AddAccountForDefaultKeyring(const std::string& account_name);
 
   // Address will be returned when success
@@ -203,10 +234,16 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
                                 base::span<const uint8_t> bytes,
                                 const std::string& id);
   std::vector<uint8_t> GetOrCreateNonceForKeyring(const std::string& id);
+  std::vector<uint8_t> GetOrCreateSaltForKeyring(const std::string& id);
   bool CreateEncryptorForKeyring(const std::string& password,
                                  const std::string& id);
   bool CreateDefaultKeyringInternal(const std::string& mnemonic,
                                     bool is_legacy_brave_wallet);
+  // Same as above with the seed already derived from |mnemonic|
+  bool CreateDefaultKeyringFromSeed(const std::string& mnemonic,
+                                    const std::vector<uint8_t>& seed,
+                                    bool is_legacy_brave_wallet);
+  bool IsLegacyBraveWallet() const;
 
   // Currently only support one default keyring, `CreateDefaultKeyring` and
   // `RestoreDefaultKeyring` will overwrite existing one if success
@@ -217,6 +254,18 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
                                    bool is_legacy_brave_wallet);
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeDefaultKeyring(const std::string& password);
+  HDKeyring* ResumeDefaultKeyringFromSeed(const std::string& mnemonic,
+                                          const std::vector<uint8_t>& seed,
+                                          bool is_legacy_brave_wallet);
+
+  void OnCreateWalletKeyringDerived(CreateWalletCallback callback,
+                                    std::unique_ptr<DerivedKeyring> derived);
+  void OnRestoreWalletKeyringDerived(bool is_legacy_brave_wallet,
+                                     const std::vector<uint8_t>& new_salt,
+                                     RestoreWalletCallback callback,
+                                     std::unique_ptr<DerivedKeyring> derived);
+  void OnUnlockKeyringDerived(UnlockCallback callback,
+                              std::unique_ptr<DerivedKeyring> derived);
 
   void NotifyAccountsChanged();
 
@@ -227,10 +276,15 @@ class KeyringController : public KeyedService, public mojom::KeyringController {
   // std::vector<std::unique_ptr<HDKeyring>> keyrings_;
 
   PrefService* prefs_;
+  PrefChangeRegistrar pref_change_registrar_;
+  base::flat_map<std::string, KeyringModel> keyring_models_;
+  scoped_refptr<base::SequencedTaskRunner> key_derivation_task_runner_;
 
   mojo::RemoteSet<mojom::KeyringControllerObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringController> receivers_;
 
+  base::WeakPtrFactory<KeyringController> weak_ptr_factory_{this};
+
   KeyringController(const KeyringController&) = delete;
   KeyringController& operator=(const KeyringController&) = delete;
 };
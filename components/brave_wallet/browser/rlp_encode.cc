@@ -8,33 +8,110 @@
 #include <algorithm>
 #include <utility>
 
+namespace brave_wallet {
+
 namespace {
 
-std::string RLPToBinary(size_t x) {
-  if (x == 0) {
-    return "";
+// Number of big-endian bytes needed for |x|, zero for zero.
+size_t RLPByteCount(uint256_t x) {
+  size_t count = 0;
+  while (x > static_cast<uint256_t>(0)) {
+    ++count;
+    x >>= 8;
+  }
+  return count;
+}
+
+void RLPAppendBigEndian(uint256_t x, size_t byte_count, std::string* out) {
+  for (size_t i = byte_count; i > 0; --i) {
+    const uint256_t byte = (x >> (8 * (i - 1))) & static_cast<uint256_t>(0xFF);
+    out->push_back(static_cast<char>(static_cast<uint8_t>(byte)));
   }
-  std::string ret = RLPToBinary(x / 256);
-  ret.push_back(x % 256);
-  return ret;
 }
 
-std::string RLPEncodeLength(size_t length, size_t offset) {
-  char sz[2] = {0};
+size_t RLPLengthPrefixSize(size_t length) {
+  return length < 56 ? 1 : 1 + RLPByteCount(length);
+}
+
+void RLPAppendLength(size_t length, size_t offset, std::string* out) {
   if (length < 56) {
-    sz[0] = length + offset;
-    return sz;
+    out->push_back(static_cast<char>(length + offset));
+    return;
   }
-  std::string BL = RLPToBinary(length);
-  sz[0] = BL.length() + offset + 55;
-  std::string ret(sz);
-  ret.append(BL);
-  return ret;
+  const size_t byte_count = RLPByteCount(length);
+  out->push_back(static_cast<char>(byte_count + offset + 55));
+  RLPAppendBigEndian(length, byte_count, out);
 }
 
-}  // namespace
+size_t RLPBytesEncodedSize(const uint8_t* data, size_t size) {
+  if (size == 1 && data[0] < 0x80)
+    return 1;
+  return RLPLengthPrefixSize(size) + size;
+}
 
-namespace brave_wallet {
+void RLPAppendBytes(const uint8_t* data, size_t size, std::string* out) {
+  if (size == 1 && data[0] < 0x80) {
+    out->push_back(static_cast<char>(data[0]));
+    return;
+  }
+  RLPAppendLength(size, 0x80, out);
+  out->append(reinterpret_cast<const char*>(data), size);
+}
+
+size_t RLPEncodedSize(const base::Value& val);
+
+size_t RLPListPayloadSize(const base::Value& val) {
+  size_t size = 0;
+  for (const auto& item : val.GetList())
+    size += RLPEncodedSize(item);
+  return size;
+}
+
+size_t RLPEncodedSize(const base::Value& val) {
+  if (val.is_int()) {
+    const uint256_t i = (uint256_t)val.GetInt();
+    const size_t byte_count = RLPByteCount(i);
+    if (byte_count == 1 && i < static_cast<uint256_t>(0x80))
+      return 1;
+    return RLPLengthPrefixSize(byte_count) + byte_count;
+  } else if (val.is_blob()) {
+    return RLPBytesEncodedSize(val.GetBlob().data(), val.GetBlob().size());
+  } else if (val.is_string()) {
+    const std::string& s = val.GetString();
+    return RLPBytesEncodedSize(reinterpret_cast<const uint8_t*>(s.data()),
+                               s.size());
+  } else if (val.is_list()) {
+    const size_t payload_size = RLPListPayloadSize(val);
+    return RLPLengthPrefixSize(payload_size) + payload_size;
+  }
+  return 0;
+}
+
+// Appends the encoding of |val| to |out| without building intermediate
+// strings or Values for nested items.
+void RLPAppend(const base::Value& val, std::string* out) {
+  if (val.is_int()) {
+    const uint256_t i = (uint256_t)val.GetInt();
+    const size_t byte_count = RLPByteCount(i);
+    if (byte_count == 1 && i < static_cast<uint256_t>(0x80)) {
+      RLPAppendBigEndian(i, 1, out);
+      return;
+    }
+    RLPAppendLength(byte_count, 0x80, out);
+    RLPAppendBigEndian(i, byte_count, out);
+  } else if (val.is_blob()) {
+    RLPAppendBytes(val.GetBlob().data(), val.GetBlob().size(), out);
+  } else if (val.is_string()) {
+    const std::string& s = val.GetString();
+    RLPAppendBytes(reinterpret_cast<const uint8_t*>(s.data()), s.size(), out);
+  } else if (val.is_list()) {
+    RLPAppendLength(RLPListPayloadSize(val), 0xc0, out);
+    for (const auto& item : val.GetList())
+      RLPAppend(item, out);
+  }
+}
+
+}  // namespace
 
 base::Value RLPUint256ToBlobValue(uint256_t input) {
   base::Value::BlobStorage output;
@@ -49,28 +126,10 @@ base::Value RLPUint256ToBlobValue(uint256_t input) {
 }
 
 std::string RLPEncode(base::Value val) {
-  if (val.is_int()) {
-    int i = val.GetInt();
-    return RLPEncode(base::Value(RLPUint256ToBlobValue((uint256_t)i)));
-  } else if (val.is_blob()) {
-    base::Value::BlobStorage blob = val.GetBlob();
-    std::string s(blob.begin(), blob.end());
-    if (blob.size() == 1 && static_cast<uint8_t>(blob[0]) < 0x80) {
-      return s;
-    }
-    return RLPEncodeLength(blob.size(), 0x80) + s;
-  } else if (val.is_string()) {
-    std::string s;
-    val.GetAsString(&s);
-    return RLPEncode(base::Value(base::Value::BlobStorage(s.begin(), s.end())));
-  } else if (val.is_list()) {
-    std::string output;
-    for (auto& item : val.GetList()) {
-      output += RLPEncode(std::move(item));
-    }
-    return RLPEncodeLength(output.length(), 0xc0) + output;
-  }
-  return "";
+  std::string output;
+  output.reserve(RLPEncodedSize(val));
+  RLPAppend(val, &output);
+  return output;
 }
 
 }  // namespace brave_wallet
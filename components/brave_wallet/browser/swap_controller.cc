@@ -71,10 +71,12 @@ GURL AppendSwapParams(const GURL& swap_url,
 namespace brave_wallet {
 
 GURL SwapController::base_url_for_test_;
+constexpr base::TimeDelta SwapController::kPriceQuoteDebounce;
 
 SwapController::SwapController(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
-    : api_request_helper_(GetNetworkTrafficAnnotationTag(), url_loader_factory),
+    : url_loader_factory_(url_loader_factory),
+      api_request_helper_(GetNetworkTrafficAnnotationTag(), url_loader_factory),
       weak_ptr_factory_(this) {}
 
 SwapController::~SwapController() {}
@@ -119,18 +121,50 @@ GURL SwapController::GetTransactionPayloadURL(
 
 void SwapController::GetPriceQuote(mojom::SwapParamsPtr swap_params,
                                    GetPriceQuoteCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&SwapController::OnGetPriceQuote,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_.Request("GET", GetPriceQuoteURL(std::move(swap_params)),
-                              "", "", true, std::move(internal_callback));
+  const bool idle = !pending_price_quote_callback_;
+  if (!idle) {
+    // Drop the loader of the superseded request and answer it right away so
+    // that its stale quote is never delivered.
+    price_quote_request_helper_.reset();
+    std::move(pending_price_quote_callback_)
+        .Run(false, nullptr, "Superseded by a newer price quote request");
+  }
+  pending_price_quote_params_ = std::move(swap_params);
+  pending_price_quote_callback_ = std::move(callback);
+
+  // The first request of a burst goes out immediately, later ones wait for
+  // the input to settle.
+  if (idle) {
+    price_quote_timer_.Stop();
+    SendPriceQuoteRequest();
+    return;
+  }
+  price_quote_timer_.Start(
+      FROM_HERE, kPriceQuoteDebounce,
+      base::BindOnce(&SwapController::SendPriceQuoteRequest,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void SwapController::SendPriceQuoteRequest() {
+  DCHECK(pending_price_quote_params_);
+  if (!price_quote_request_helper_) {
+    price_quote_request_helper_ =
+        std::make_unique<api_request_helper::APIRequestHelper>(
+            GetNetworkTrafficAnnotationTag(), url_loader_factory_);
+  }
+  auto internal_callback = base::BindOnce(&SwapController::OnGetPriceQuote,
+                                          weak_ptr_factory_.GetWeakPtr());
+  price_quote_request_helper_->Request(
+      "GET", GetPriceQuoteURL(std::move(pending_price_quote_params_)), "", "",
+      true, std::move(internal_callback));
 }
 
 void SwapController::OnGetPriceQuote(
-    GetPriceQuoteCallback callback,
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
+  DCHECK(pending_price_quote_callback_);
+  auto callback = std::move(pending_price_quote_callback_);
   if (status < 200 || status > 299) {
     std::move(callback).Run(false, nullptr, body);
     return;
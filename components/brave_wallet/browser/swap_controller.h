@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_SWAP_CONTROLLER_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_SWAP_CONTROLLER_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/asset_ratio_response_parser.h"
 #include "url/gurl.h"
@@ -41,7 +43,9 @@ class SwapController : public KeyedService, public mojom::SwapController {
   mojo::PendingRemote<mojom::SwapController> MakeRemote();
   void Bind(mojo::PendingReceiver<mojom::SwapController> receiver);
 
-  // Obtians a quote for the specified asset
+  // Obtians a quote for the specified asset. Only the most recent request is
+  // answered with a quote: a newer call cancels the one in flight, answers
+  // it with an error, and is itself debounced by kPriceQuoteDebounce.
   void GetPriceQuote(mojom::SwapParamsPtr swap_params,
                      GetPriceQuoteCallback callback) override;
   // Obtains the transaction payload to be signed.
@@ -52,9 +56,12 @@ class SwapController : public KeyedService, public mojom::SwapController {
   static GURL GetTransactionPayloadURL(mojom::SwapParamsPtr swap_params);
   static void SetBaseURLForTest(const GURL& base_url_for_test);
 
+  static constexpr base::TimeDelta kPriceQuoteDebounce =
+      base::TimeDelta::FromMilliseconds(300);
+
  private:
-  void OnGetPriceQuote(GetPriceQuoteCallback callback,
-                       const int status,
+  void SendPriceQuoteRequest();
+  void OnGetPriceQuote(const int status,
                        const std::string& body,
                        const base::flat_map<std::string, std::string>& headers);
   void OnGetTransactionPayload(
@@ -64,7 +71,15 @@ class SwapController : public KeyedService, public mojom::SwapController {
       const base::flat_map<std::string, std::string>& headers);
 
   static GURL base_url_for_test_;
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   api_request_helper::APIRequestHelper api_request_helper_;
+  // Price quotes get their own helper so a superseded request can be
+  // cancelled by resetting it.
+  std::unique_ptr<api_request_helper::APIRequestHelper>
+      price_quote_request_helper_;
+  mojom::SwapParamsPtr pending_price_quote_params_;
+  GetPriceQuoteCallback pending_price_quote_callback_;
+  base::OneShotTimer price_quote_timer_;
 
   mojo::ReceiverSet<mojom::SwapController> receivers_;
 
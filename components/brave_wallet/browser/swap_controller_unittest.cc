@@ -46,7 +46,9 @@ namespace brave_wallet {
 class SwapControllerUnitTest : public testing::Test {
  public:
   SwapControllerUnitTest()
-      : browser_context_(new content::TestBrowserContext()),
+      : browser_task_environment_(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        browser_context_(new content::TestBrowserContext()),
         shared_url_loader_factory_(
             base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
                 &url_loader_factory_)) {
@@ -78,9 +80,9 @@ class SwapControllerUnitTest : public testing::Test {
 
  protected:
   std::unique_ptr<SwapController> swap_controller_;
+  content::BrowserTaskEnvironment browser_task_environment_;
 
  private:
-  content::BrowserTaskEnvironment browser_task_environment_;
   std::unique_ptr<content::TestBrowserContext> browser_context_;
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
@@ -158,6 +160,29 @@ TEST_F(SwapControllerUnitTest, GetPriceQuoteUnexpectedReturn) {
   EXPECT_TRUE(callback_run);
 }
 
+TEST_F(SwapControllerUnitTest, GetPriceQuoteSupersededAndDebounced) {
+  std::string error = "Could not parse response body: Woot";
+  SetInterceptor("Woot");
+  bool first_callback_run = false;
+  bool second_callback_run = false;
+  swap_controller_->GetPriceQuote(
+      GetCannedSwapParams(),
+      base::BindOnce(&OnRequestResponse, &first_callback_run, false, nullptr,
+                     "Superseded by a newer price quote request"));
+  swap_controller_->GetPriceQuote(
+      GetCannedSwapParams(),
+      base::BindOnce(&OnRequestResponse, &second_callback_run, false, nullptr,
+                     error));
+  EXPECT_TRUE(first_callback_run);
+
+  // The newer request waits for the debounce interval before it is sent.
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(second_callback_run);
+  browser_task_environment_.FastForwardBy(SwapController::kPriceQuoteDebounce);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(second_callback_run);
+}
+
 TEST_F(SwapControllerUnitTest, GetTransactionPayload) {
   SetInterceptor(R"(
     {
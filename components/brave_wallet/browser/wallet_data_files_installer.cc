@@ -16,6 +16,8 @@
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/task/thread_pool.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/memory_dump_manager.h"
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/brave_on_demand_updater.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -183,6 +185,9 @@ void WalletDataFilesInstallerPolicy::UpdateTokenRegistry(
 void RegisterWalletDataFilesComponent(
     component_updater::ComponentUpdateService* cus) {
   if (brave_wallet::IsNativeWalletEnabled()) {
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        ERCTokenRegistry::GetInstance(), "ERCTokenRegistry",
+        base::ThreadTaskRunnerHandle::Get());
     auto installer =
         base::MakeRefCounted<component_updater::ComponentInstaller>(
             std::make_unique<WalletDataFilesInstallerPolicy>());
@@ -10,6 +10,7 @@
 
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
@@ -241,10 +242,11 @@ BraveWalletJSHandler::BraveWalletJSHandler(content::RenderFrame* render_frame)
     *g_provider_script =
         LoadDataResource(IDR_BRAVE_WALLET_SCRIPT_BRAVE_WALLET_SCRIPT_BUNDLE_JS);
   }
-  EnsureConnected();
 }
 
-BraveWalletJSHandler::~BraveWalletJSHandler() = default;
+BraveWalletJSHandler::~BraveWalletJSHandler() {
+  RecordProviderUsage();
+}
 
 bool BraveWalletJSHandler::EnsureConnected() {
   if (!brave_wallet_provider_.is_bound()) {
@@ -276,25 +278,65 @@ void BraveWalletJSHandler::AddJavaScriptObjectToFrame(
   v8::MicrotasksScope microtasks(isolate,
                                  v8::MicrotasksScope::kDoNotRunMicrotasks);
 
-  CreateEthereumObject(isolate, context);
-  InjectInitScript();
+  RecordProviderUsage();
+  provider_installed_ = false;
+  provider_accessed_ = false;
+
+  v8::Local<v8::Object> global = context->Global();
+  v8::Local<v8::Value> ethereum_value;
+  if (global->Get(context, gin::StringToV8(isolate, "ethereum"))
+          .ToLocal(&ethereum_value) &&
+      ethereum_value->IsObject()) {
+    return;
+  }
+
+  provider_installed_ =
+      global
+          ->SetLazyDataProperty(context,
+                                gin::StringToSymbol(isolate, "ethereum"),
+                                &BraveWalletJSHandler::OnEthereumAccessed,
+                                v8::External::New(isolate, this))
+          .FromMaybe(false);
+}
+
+// static
+void BraveWalletJSHandler::OnEthereumAccessed(
+    v8::Local<v8::Name> property,
+    const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* self = static_cast<BraveWalletJSHandler*>(
+      info.Data().As<v8::External>()->Value());
+  v8::Isolate* isolate = info.GetIsolate();
+  info.GetReturnValue().Set(
+      self->CreateEthereumObject(isolate, isolate->GetCurrentContext()));
 }
 
-void BraveWalletJSHandler::CreateEthereumObject(
-    v8::Isolate* isolate, v8::Local<v8::Context> context) {
+v8::Local<v8::Object> BraveWalletJSHandler::CreateEthereumObject(
+    v8::Isolate* isolate,
+    v8::Local<v8::Context> context) {
+  provider_accessed_ = true;
+  EnsureConnected();
+
+  v8::Local<v8::Object> ethereum_obj = v8::Object::New(isolate);
+  BindFunctionsToObject(isolate, context, ethereum_obj);
+
+  // The init script reads window.ethereum, so the lazy accessor has to be
+  // replaced with the real object before it runs.
   v8::Local<v8::Object> global = context->Global();
-  v8::Local<v8::Object> cosmetic_filters_obj;
-  v8::Local<v8::Value> cosmetic_filters_value;
-  if (!global->Get(context, gin::StringToV8(isolate, "ethereum"))
-           .ToLocal(&cosmetic_filters_value) ||
-      !cosmetic_filters_value->IsObject()) {
-    cosmetic_filters_obj = v8::Object::New(isolate);
-    global
-        ->Set(context, gin::StringToSymbol(isolate, "ethereum"),
-              cosmetic_filters_obj)
-        .Check();
-    BindFunctionsToObject(isolate, context, cosmetic_filters_obj);
+  if (global
+          ->CreateDataProperty(context,
+                               gin::StringToSymbol(isolate, "ethereum"),
+                               ethereum_obj)
+          .FromMaybe(false)) {
+    InjectInitScript();
+    ConnectEvent();
   }
+  return ethereum_obj;
+}
+
+void BraveWalletJSHandler::RecordProviderUsage() {
+  if (!provider_installed_)
+    return;
+  UMA_HISTOGRAM_BOOLEAN("Brave.Wallet.ProviderAccessed", provider_accessed_);
 }
 
 void BraveWalletJSHandler::BindFunctionsToObject(
@@ -578,6 +620,9 @@ void BraveWalletJSHandler::InjectInitScript() {
 
 void BraveWalletJSHandler::FireEvent(const std::string& event,
                                      base::Value event_args) {
+  // Reading window.ethereum here would instantiate the lazy provider.
+  if (!provider_accessed_)
+    return;
   base::Value args = base::Value(base::Value::Type::LIST);
   args.Append(event);
   args.Append(std::move(event_args));
@@ -27,6 +27,9 @@ class BraveWalletJSHandler : public mojom::EventsListener {
   explicit BraveWalletJSHandler(content::RenderFrame* render_frame);
   ~BraveWalletJSHandler() override;
 
+  // Installs window.ethereum as a lazy data property. The provider object,
+  // the mojo connection and the init script are only set up once the page
+  // first reads the property.
   void AddJavaScriptObjectToFrame(v8::Local<v8::Context> context);
   void FireEvent(const std::string& event, base::Value event_args);
   void ConnectEvent();
@@ -47,8 +50,12 @@ class BraveWalletJSHandler : public mojom::EventsListener {
                             v8::Local<v8::Object> javascript_object,
                             const std::string& name,
                             const base::RepeatingCallback<Sig>& callback);
-  void CreateEthereumObject(v8::Isolate* isolate,
-                            v8::Local<v8::Context> context);
+  static void OnEthereumAccessed(
+      v8::Local<v8::Name> property,
+      const v8::PropertyCallbackInfo<v8::Value>& info);
+  v8::Local<v8::Object> CreateEthereumObject(v8::Isolate* isolate,
+                                             v8::Local<v8::Context> context);
+  void RecordProviderUsage();
   bool EnsureConnected();
   void OnRemoteDisconnect();
   void InjectInitScript();
@@ -76,6 +83,9 @@ class BraveWalletJSHandler : public mojom::EventsListener {
   mojo::Remote<mojom::BraveWalletProvider> brave_wallet_provider_;
   mojo::Receiver<mojom::EventsListener> receiver_{this};
   bool is_connected_;
+  // Whether the current document got the lazy provider and has read it.
+  bool provider_installed_ = false;
+  bool provider_accessed_ = false;
   std::string chain_id_;
   base::WeakPtrFactory<BraveWalletJSHandler> weak_ptr_factory_{this};
 };
@@ -90,6 +90,8 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  cached_shields_down_.reset();
+  cached_farbling_level_.reset();
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -118,7 +120,7 @@ bool BraveContentSettingsAgentImpl::AllowScript(bool enabled_per_settings) {
   const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
 
   bool allow = ContentSettingsAgentImpl::AllowScript(enabled_per_settings);
-  allow = allow || IsBraveShieldsDown(frame, secondary_url) ||
+  allow = allow || IsBraveShieldsDownForFrame() ||
           IsScriptTemporilyAllowed(secondary_url);
 
   return allow;
@@ -216,13 +218,24 @@ bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
              frame, secondary_url, content_setting_rules_->brave_shields_rules);
 }
 
+bool BraveContentSettingsAgentImpl::IsBraveShieldsDownForFrame() {
+  // Without rules shields are treated as down, but the rules may still
+  // arrive, so that answer isn't cached.
+  if (!content_setting_rules_)
+    return true;
+  if (!cached_shields_down_) {
+    blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+    cached_shields_down_ = IsBraveShieldsDown(
+        frame, url::Origin(frame->GetSecurityOrigin()).GetURL());
+  }
+  return *cached_shields_down_;
+}
+
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
     bool enabled_per_settings) {
   if (!enabled_per_settings)
     return false;
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
+  if (IsBraveShieldsDownForFrame()) {
     return true;
   }
 
@@ -230,29 +243,34 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+  if (cached_farbling_level_)
+    return *cached_farbling_level_;
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
+    if (IsBraveShieldsDownForFrame()) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
       setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
+          content_setting_rules_->fingerprinting_rules,
+          GetOriginOrURL(render_frame()->GetWebFrame()));
     }
   }
 
+  BraveFarblingLevel level;
   if (setting == CONTENT_SETTING_BLOCK) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
+    level = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
+    level = BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    level = BraveFarblingLevel::BALANCED;
   }
+  if (content_setting_rules_)
+    cached_farbling_level_ = level;
+  return level;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
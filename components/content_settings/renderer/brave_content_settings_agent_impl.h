@@ -21,6 +21,7 @@
 #include "mojo/public/cpp/bindings/associated_receiver_set.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 #include "url/gurl.h"
 
@@ -67,6 +68,10 @@ class BraveContentSettingsAgentImpl
       const blink::WebFrame* frame,
       const GURL& secondary_url);
 
+  // IsBraveShieldsDown() for the frame's own origin, resolved once per
+  // document.
+  bool IsBraveShieldsDownForFrame();
+
   // RenderFrameObserver
   void DidCommitProvisionalLoad(ui::PageTransition transition) override;
 
@@ -98,6 +103,13 @@ class BraveContentSettingsAgentImpl
   base::flat_map<url::Origin, blink::WebSecurityOrigin>
       cached_ephemeral_storage_origins_;
 
+  // Shields settings resolved from |content_setting_rules_| for the current
+  // document. Farbling checks run on every fingerprinting API call, so they
+  // are resolved once and reset when a new document commits; a settings
+  // change takes effect on the next load, which the shields UI triggers.
+  absl::optional<bool> cached_shields_down_;
+  absl::optional<BraveFarblingLevel> cached_farbling_level_;
+
   mojo::AssociatedRemote<brave_shields::mojom::BraveShieldsHost>
       brave_shields_remote_;
 
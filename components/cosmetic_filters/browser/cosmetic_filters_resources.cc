@@ -7,15 +7,64 @@
 
 #include <utility>
 
+#include "base/containers/mru_cache.h"
 #include "base/json/json_reader.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_resources_payload.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace cosmetic_filters {
 
+namespace {
+
+// Serialized payloads shared by every frame, keyed on URL. The engines
+// decide $generichide from the full URL, so the host alone isn't enough.
+// Only touched on the adblock task runner.
+struct PayloadCache {
+  PayloadCache() : payloads(100) {}
+
+  base::MRUCache<std::string, base::ReadOnlySharedMemoryRegion> payloads;
+  uint64_t generation = 0;
+};
+
+base::ReadOnlySharedMemoryRegion GetUrlCosmeticResourcesPayload(
+    brave_shields::AdBlockService* ad_block_service,
+    const std::string& url) {
+  DCHECK(ad_block_service->GetTaskRunner()->RunsTasksInCurrentSequence());
+  static base::NoDestructor<PayloadCache> cache;
+
+  const uint64_t generation =
+      brave_shields::AdBlockDecisionCache::GetEngineGeneration();
+  if (generation != cache->generation) {
+    cache->payloads.Clear();
+    cache->generation = generation;
+  }
+
+  auto it = cache->payloads.Get(url);
+  if (it != cache->payloads.end())
+    return it->second.Duplicate();
+
+  absl::optional<base::Value> resources =
+      ad_block_service->UrlCosmeticResources(url);
+  base::ReadOnlySharedMemoryRegion region =
+      CosmeticResourcesPayload::FromValue(resources ? *resources
+                                                    : base::Value())
+          .Serialize();
+  if (!region.IsValid())
+    return region;
+  base::ReadOnlySharedMemoryRegion result = region.Duplicate();
+  cache->payloads.Put(url, std::move(region));
+  return result;
+}
+
+}  // namespace
+
 CosmeticFiltersResources::CosmeticFiltersResources(
     HostContentSettingsMap* settings_map,
     brave_shields::AdBlockService* ad_block_service)
@@ -62,6 +111,8 @@ void CosmeticFiltersResources::HiddenClassIdSelectors(
       ids.push_back(ids_list->GetList()[i].GetString());
     }
   }
+  UMA_HISTOGRAM_COUNTS_1000("Brave.CosmeticFilters.ClassIdQuerySize",
+                            classes.size() + ids.size());
 
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE,
@@ -80,10 +131,9 @@ void CosmeticFiltersResources::HiddenClassIdSelectorsOnUI(
 }
 
 void CosmeticFiltersResources::UrlCosmeticResourcesOnUI(
-    base::OnceCallback<void(base::Value)> callback,
-    absl::optional<base::Value> resources) {
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
+    base::OnceCallback<void(base::ReadOnlySharedMemoryRegion)> callback,
+    base::ReadOnlySharedMemoryRegion resources) {
+  std::move(callback).Run(std::move(resources));
 }
 
 void CosmeticFiltersResources::UrlCosmeticResources(
@@ -93,7 +143,8 @@ void CosmeticFiltersResources::UrlCosmeticResources(
       brave_shields::ShouldDoCosmeticFiltering(settings_map_, GURL(url));
 
   if (!enabled) {
-    std::move(callback).Run(enabled, false, base::Value());
+    std::move(callback).Run(enabled, false,
+                            base::ReadOnlySharedMemoryRegion());
     return;
   }
 
@@ -103,7 +154,7 @@ void CosmeticFiltersResources::UrlCosmeticResources(
 
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&brave_shields::AdBlockService::UrlCosmeticResources,
+      base::BindOnce(&GetUrlCosmeticResourcesPayload,
                      base::Unretained(ad_block_service_), url),
       base::BindOnce(
           &CosmeticFiltersResources::UrlCosmeticResourcesOnUI,
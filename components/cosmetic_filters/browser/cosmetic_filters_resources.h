@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
@@ -54,8 +55,9 @@ class CosmeticFiltersResources final
   void HiddenClassIdSelectorsOnUI(HiddenClassIdSelectorsCallback callback,
                                   absl::optional<base::Value> resources);
 
-  void UrlCosmeticResourcesOnUI(base::OnceCallback<void(base::Value)> callback,
-                                absl::optional<base::Value> resources);
+  void UrlCosmeticResourcesOnUI(
+      base::OnceCallback<void(base::ReadOnlySharedMemoryRegion)> callback,
+      base::ReadOnlySharedMemoryRegion resources);
 
   HostContentSettingsMap* settings_map_;             // Not owned
   brave_shields::AdBlockService* ad_block_service_;  // Not owned
@@ -0,0 +1,133 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/common/cosmetic_resources_payload.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/pickle.h"
+#include "base/values.h"
+
+namespace cosmetic_filters {
+
+namespace {
+
+// Bumped whenever the layout written by Serialize() changes.
+const int kPayloadVersion = 1;
+
+std::string WriteNonEmptyList(const base::Value* list) {
+  std::string json;
+  if (list && list->is_list() && !list->GetList().empty())
+    base::JSONWriter::Write(*list, &json);
+  return json;
+}
+
+}  // namespace
+
+CosmeticResourcesPayload::CosmeticResourcesPayload() = default;
+
+CosmeticResourcesPayload::CosmeticResourcesPayload(
+    const CosmeticResourcesPayload&) = default;
+
+CosmeticResourcesPayload::~CosmeticResourcesPayload() = default;
+
+// static
+CosmeticResourcesPayload CosmeticResourcesPayload::FromValue(
+    const base::Value& resources) {
+  CosmeticResourcesPayload payload;
+  if (!resources.is_dict())
+    return payload;
+
+  payload.generichide = resources.FindBoolKey("generichide").value_or(false);
+
+  const base::Value* injected_script = resources.FindKey("injected_script");
+  if (injected_script)
+    base::JSONWriter::Write(*injected_script, &payload.injected_script_json);
+
+  payload.hide_selectors_json =
+      WriteNonEmptyList(resources.FindListKey("hide_selectors"));
+  payload.force_hide_selectors_json =
+      WriteNonEmptyList(resources.FindListKey("force_hide_selectors"));
+
+  const base::Value* style_selectors = resources.FindDictKey("style_selectors");
+  if (style_selectors &&
+      (!base::JSONWriter::Write(*style_selectors,
+                                &payload.style_selectors_json) ||
+       payload.style_selectors_json.empty())) {
+    payload.style_selectors_json = "[]";
+  }
+
+  const base::Value* exceptions = resources.FindListKey("exceptions");
+  if (exceptions) {
+    for (const base::Value& exception : exceptions->GetList()) {
+      if (exception.is_string())
+        payload.exceptions.push_back(exception.GetString());
+    }
+  }
+
+  return payload;
+}
+
+base::ReadOnlySharedMemoryRegion CosmeticResourcesPayload::Serialize() const {
+  base::Pickle pickle;
+  pickle.WriteInt(kPayloadVersion);
+  pickle.WriteBool(generichide);
+  pickle.WriteString(injected_script_json);
+  pickle.WriteString(hide_selectors_json);
+  pickle.WriteString(force_hide_selectors_json);
+  pickle.WriteString(style_selectors_json);
+  pickle.WriteInt(static_cast<int>(exceptions.size()));
+  for (const std::string& exception : exceptions)
+    pickle.WriteString(exception);
+
+  base::MappedReadOnlyRegion region =
+      base::ReadOnlySharedMemoryRegion::Create(pickle.size());
+  if (!region.IsValid())
+    return base::ReadOnlySharedMemoryRegion();
+  memcpy(region.mapping.memory(), pickle.data(), pickle.size());
+  return std::move(region.region);
+}
+
+// static
+bool CosmeticResourcesPayload::Deserialize(
+    const base::ReadOnlySharedMemoryRegion& region,
+    CosmeticResourcesPayload* payload) {
+  DCHECK(payload);
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return false;
+
+  base::Pickle pickle(static_cast<const char*>(mapping.memory()),
+                      mapping.size());
+  base::PickleIterator iter(pickle);
+  int version;
+  if (!iter.ReadInt(&version) || version != kPayloadVersion)
+    return false;
+
+  int exceptions_size;
+  if (!iter.ReadBool(&payload->generichide) ||
+      !iter.ReadString(&payload->injected_script_json) ||
+      !iter.ReadString(&payload->hide_selectors_json) ||
+      !iter.ReadString(&payload->force_hide_selectors_json) ||
+      !iter.ReadString(&payload->style_selectors_json) ||
+      !iter.ReadInt(&exceptions_size) || exceptions_size < 0) {
+    return false;
+  }
+
+  payload->exceptions.clear();
+  for (int i = 0; i < exceptions_size; i++) {
+    std::string exception;
+    if (!iter.ReadString(&exception))
+      return false;
+    payload->exceptions.push_back(std::move(exception));
+  }
+  return true;
+}
+
+}  // namespace cosmetic_filters
@@ -0,0 +1,50 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_COMMON_COSMETIC_RESOURCES_PAYLOAD_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_COMMON_COSMETIC_RESOURCES_PAYLOAD_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/read_only_shared_memory_region.h"
+
+namespace base {
+class Value;
+}
+
+namespace cosmetic_filters {
+
+// The merged result of UrlCosmeticResources in the form the renderer
+// consumes it. Selector sets are kept as the JSON fragments that get spliced
+// into the injected scripts, so neither side has to build base::Value trees
+// per frame. An empty fragment means there is nothing to inject.
+struct CosmeticResourcesPayload {
+  CosmeticResourcesPayload();
+  CosmeticResourcesPayload(const CosmeticResourcesPayload&);
+  ~CosmeticResourcesPayload();
+
+  // Builds a payload from the dictionary returned by
+  // AdBlockService::UrlCosmeticResources.
+  static CosmeticResourcesPayload FromValue(const base::Value& resources);
+
+  // Packs the payload into a read-only shared memory region that can be
+  // handed to any number of renderers. Returns an invalid region on failure.
+  base::ReadOnlySharedMemoryRegion Serialize() const;
+  // Returns false if |region| doesn't hold a payload written by Serialize().
+  static bool Deserialize(const base::ReadOnlySharedMemoryRegion& region,
+                          CosmeticResourcesPayload* payload);
+
+  bool generichide = false;
+  std::string injected_script_json;
+  std::string hide_selectors_json;
+  std::string force_hide_selectors_json;
+  std::string style_selectors_json;
+  std::vector<std::string> exceptions;
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_COMMON_COSMETIC_RESOURCES_PAYLOAD_H_
@@ -5,6 +5,7 @@
 
 #include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_handler.h"
 
+#include <memory>
 #include <utility>
 
 #include "base/bind.h"
@@ -12,6 +13,7 @@
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "brave/components/cosmetic_filters/renderer/cosmetic_resources_cache.h"
 #include "brave/components/cosmetic_filters/resources/grit/cosmetic_filters_generated_map.h"
 #include "content/public/renderer/render_frame.h"
 #include "gin/arguments.h"
@@ -299,12 +301,23 @@ void CosmeticFiltersJSHandler::OnRemoteDisconnect() {
 
 void CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
                                           base::OnceClosure callback) {
-  resources_dict_.reset();
+  resources_.reset();
   url_ = url;
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
     return;
 
+  CosmeticResourcesCache::Entry cached;
+  if (!render_frame_->IsMainFrame() &&
+      CosmeticResourcesCache::GetInstance()->Get(url_, &cached)) {
+    if (!cached.enabled)
+      return;
+    enabled_1st_party_cf_ = cached.first_party_enabled;
+    resources_ = cached.resources;
+    std::move(callback).Run();
+    return;
+  }
+
   cosmetic_filters_resources_->UrlCosmeticResources(
       url_.spec(),
       base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
@@ -315,26 +328,32 @@ void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
     base::OnceClosure callback,
     bool enabled,
     bool first_party_enabled,
-    base::Value result) {
+    base::ReadOnlySharedMemoryRegion result) {
+  CosmeticResourcesCache::Entry entry;
+  entry.enabled = enabled;
+  entry.first_party_enabled = first_party_enabled;
+  entry.fetch_time = base::TimeTicks::Now();
+  auto resources = std::make_shared<CosmeticResourcesPayload>();
+  if (enabled && CosmeticResourcesPayload::Deserialize(result, resources.get()))
+    entry.resources = std::move(resources);
+  CosmeticResourcesCache::GetInstance()->Put(url_, entry);
+
   if (!enabled || !EnsureConnected())
     return;
   enabled_1st_party_cf_ = first_party_enabled;
-  resources_dict_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(result)));
+  resources_ = entry.resources;
   std::move(callback).Run();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules() {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
   std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
+  if (!resources_->injected_script_json.empty()) {
+    scriptlet_script = base::StringPrintf(
+        kScriptletInitScript, resources_->injected_script_json.c_str());
   }
   if (!scriptlet_script.empty()) {
     web_frame->ExecuteScriptInIsolatedWorld(
@@ -346,11 +365,9 @@ void CosmeticFiltersJSHandler::ApplyRules() {
     return;
 
   // Working on css rules, we do that on a main frame only
-  bool generichide = false;
-  resources_dict_->GetBoolean("generichide", &generichide);
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
+      resources_->generichide ? "true" : "false");
   std::string pre_init_script = base::StringPrintf(
       kPreInitScript, cosmetic_filtering_init_script.c_str());
 
@@ -359,77 +376,45 @@ void CosmeticFiltersJSHandler::ApplyRules() {
       blink::BackForwardCacheAware::kAllow);
   ExecuteObservingBundleEntryPoint();
 
-  CSSRulesRoutine(resources_dict_.get());
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    base::DictionaryValue* resources_dict) {
+    const CosmeticResourcesPayload& resources) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
   // mode, also don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  base::ListValue* cf_exceptions_list;
-  if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
-    for (size_t i = 0; i < cf_exceptions_list->GetSize(); i++) {
-      exceptions_.push_back(cf_exceptions_list->GetList()[i].GetString());
-    }
-  }
-  base::ListValue* hide_selectors_list;
-  if (!resources_dict->GetList("hide_selectors", &hide_selectors_list)) {
-    hide_selectors_list = nullptr;
-  }
-  base::ListValue* force_hide_selectors_list;
-  if (!resources_dict->GetList("force_hide_selectors",
-                               &force_hide_selectors_list)) {
-    force_hide_selectors_list = nullptr;
-  }
+  exceptions_.insert(exceptions_.end(), resources.exceptions.begin(),
+                     resources.exceptions.end());
 
-  if (hide_selectors_list && hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.hide_selectors_json.empty()) {
     // Building a script for stylesheet modifications
-    std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+    std::string new_selectors_script = base::StringPrintf(
+        kHideSelectorsInjectScript, resources.hide_selectors_json.c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  if (force_hide_selectors_list && force_hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.force_hide_selectors_json.empty()) {
     // Building a script for stylesheet modifications
-    std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
+    std::string new_selectors_script =
+        base::StringPrintf(kForceHideSelectorsInjectScript,
+                           resources.force_hide_selectors_json.c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  base::DictionaryValue* style_selectors_dictionary = nullptr;
-  if (resources_dict->GetDictionary("style_selectors",
-                                    &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-          blink::BackForwardCacheAware::kAllow);
-    }
+  if (!resources.style_selectors_json.empty()) {
+    std::string new_selectors_script = base::StringPrintf(
+        kStyleSelectorsInjectScript, resources.style_selectors_json.c_str());
+    web_frame->ExecuteScriptInIsolatedWorld(
+        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
+        blink::BackForwardCacheAware::kAllow);
   }
 
   if (!enabled_1st_party_cf_)
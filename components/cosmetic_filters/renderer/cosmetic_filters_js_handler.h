@@ -10,8 +10,10 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_resources_payload.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -60,8 +62,8 @@ class CosmeticFiltersJSHandler {
   void OnUrlCosmeticResources(base::OnceClosure callback,
                               bool enabled,
                               bool first_party_enabled,
-                              base::Value result);
-  void CSSRulesRoutine(base::DictionaryValue* resources_dict);
+                              base::ReadOnlySharedMemoryRegion result);
+  void CSSRulesRoutine(const CosmeticResourcesPayload& resources);
   void OnHiddenClassIdSelectors(base::Value result);
   bool OnIsFirstParty(const std::string& url_string);
 
@@ -72,7 +74,7 @@ class CosmeticFiltersJSHandler {
   bool enabled_1st_party_cf_;
   std::vector<std::string> exceptions_;
   GURL url_;
-  std::unique_ptr<base::DictionaryValue> resources_dict_;
+  std::shared_ptr<const CosmeticResourcesPayload> resources_;
 
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
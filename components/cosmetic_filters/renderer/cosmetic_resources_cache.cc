@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/cosmetic_resources_cache.h"
+
+#include "base/no_destructor.h"
+#include "url/gurl.h"
+
+namespace cosmetic_filters {
+
+CosmeticResourcesCache::Entry::Entry() = default;
+
+CosmeticResourcesCache::Entry::Entry(const Entry&) = default;
+
+CosmeticResourcesCache::Entry::~Entry() = default;
+
+// static
+CosmeticResourcesCache* CosmeticResourcesCache::GetInstance() {
+  static base::NoDestructor<CosmeticResourcesCache> instance;
+  return instance.get();
+}
+
+CosmeticResourcesCache::CosmeticResourcesCache(size_t max_size,
+                                               base::TimeDelta max_age)
+    : entries_(max_size), max_age_(max_age) {}
+
+CosmeticResourcesCache::~CosmeticResourcesCache() = default;
+
+bool CosmeticResourcesCache::Get(const GURL& url, Entry* entry) {
+  // The engines match $generichide and hostname rules against the full URL,
+  // so that's the key rather than the site.
+  auto it = entries_.Get(url.spec());
+  if (it == entries_.end())
+    return false;
+  if (base::TimeTicks::Now() - it->second.fetch_time > max_age_) {
+    entries_.Erase(it);
+    return false;
+  }
+  *entry = it->second;
+  return true;
+}
+
+void CosmeticResourcesCache::Put(const GURL& url, const Entry& entry) {
+  entries_.Put(url.spec(), entry);
+}
+
+}  // namespace cosmetic_filters
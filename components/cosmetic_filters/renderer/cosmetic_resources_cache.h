@@ -0,0 +1,60 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_COSMETIC_RESOURCES_CACHE_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_COSMETIC_RESOURCES_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/time/time.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_resources_payload.h"
+
+class GURL;
+
+namespace cosmetic_filters {
+
+// Per-renderer cache of UrlCosmeticResources results, so same-site subframes
+// can apply rules synchronously instead of waiting for a browser round trip.
+//
+// Main frames always ask the browser and refresh the entry, which picks up
+// engine updates and shields toggles on the next page load. Subframes only
+// reuse entries younger than |max_age|. Main thread only.
+class CosmeticResourcesCache {
+ public:
+  struct Entry {
+    Entry();
+    Entry(const Entry&);
+    ~Entry();
+
+    bool enabled = false;
+    bool first_party_enabled = false;
+    // Null if the browser didn't send a payload.
+    std::shared_ptr<const CosmeticResourcesPayload> resources;
+    base::TimeTicks fetch_time;
+  };
+
+  static CosmeticResourcesCache* GetInstance();
+
+  explicit CosmeticResourcesCache(size_t max_size = 32,
+                                  base::TimeDelta max_age =
+                                      base::TimeDelta::FromSeconds(30));
+  ~CosmeticResourcesCache();
+
+  bool Get(const GURL& url, Entry* entry);
+  void Put(const GURL& url, const Entry& entry);
+
+ private:
+  base::MRUCache<std::string, Entry> entries_;
+  const base::TimeDelta max_age_;
+
+  CosmeticResourcesCache(const CosmeticResourcesCache&) = delete;
+  CosmeticResourcesCache& operator=(const CosmeticResourcesCache&) = delete;
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_COSMETIC_RESOURCES_CACHE_H_
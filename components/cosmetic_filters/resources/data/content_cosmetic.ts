@@ -20,6 +20,14 @@ const maxTimeMSBeforeStart = 2500
 const minAdTextChars = 30
 const minAdTextWords = 5
 
+// New classes and ids are batched up and sent to the browser when the thread
+// is idle, but at most this long after the first one was found.
+const maxTimeMSBeforeClassIdQuery = 200
+
+// The most classes and ids sent in one query; anything beyond that waits for
+// the next idle period.
+const maxClassIdQuerySize = 1000
+
 const queriedIds = new Set<string>()
 const queriedClasses = new Set<string>()
 
@@ -27,6 +35,7 @@ const queriedClasses = new Set<string>()
 let notYetQueriedClasses: string[]
 let notYetQueriedIds: string[]
 let cosmeticObserver: MutationObserver | undefined = undefined
+let classIdQueryIdleId: number | undefined = undefined
 
 window.content_cosmetic = window.content_cosmetic || {}
 const CC = window.content_cosmetic
@@ -93,19 +102,38 @@ const asHTMLElement = (node: Node): HTMLElement | null => {
   return isHTMLElement(node) ? node as HTMLElement : null
 }
 
+const hasNotYetQueriedClassesOrIds = (): boolean => {
+  return (notYetQueriedClasses && notYetQueriedClasses.length > 0) ||
+    (notYetQueriedIds && notYetQueriedIds.length > 0)
+}
+
 const fetchNewClassIdRules = () => {
-  if ((!notYetQueriedClasses || notYetQueriedClasses.length === 0) &&
-    (!notYetQueriedIds || notYetQueriedIds.length === 0)) {
+  if (!hasNotYetQueriedClassesOrIds()) {
     return
   }
+  const classes = notYetQueriedClasses.splice(0, maxClassIdQuerySize)
+  const ids = notYetQueriedIds.splice(0, maxClassIdQuerySize - classes.length)
   // Callback to c++ renderer process
   // @ts-ignore
   cf_worker.hiddenClassIdSelectors(
-      JSON.stringify({
-        classes: notYetQueriedClasses, ids: notYetQueriedIds
-      }))
-  notYetQueriedClasses = []
-  notYetQueriedIds = []
+      JSON.stringify({ classes, ids }))
+}
+
+const scheduleFetchNewClassIdRules = () => {
+  if (classIdQueryIdleId !== undefined || !hasNotYetQueriedClassesOrIds()) {
+    return
+  }
+  classIdQueryIdleId = window.requestIdleCallback((deadline) => {
+    classIdQueryIdleId = undefined
+    // Wait for a less busy moment unless we've already waited long enough.
+    if (!deadline.didTimeout && deadline.timeRemaining() <= 0) {
+      scheduleFetchNewClassIdRules()
+      return
+    }
+    fetchNewClassIdRules()
+    // Anything over the cap goes out in a later idle period.
+    scheduleFetchNewClassIdRules()
+  }, { timeout: maxTimeMSBeforeClassIdQuery })
 }
 
 const handleMutations: MutationCallback = (mutations: MutationRecord[]) => {
@@ -156,7 +184,7 @@ const handleMutations: MutationCallback = (mutations: MutationRecord[]) => {
     }
   }
 
-  fetchNewClassIdRules()
+  scheduleFetchNewClassIdRules()
 }
 
 const isFirstPartyUrl = (url: string): boolean => {
@@ -497,6 +525,7 @@ const startObserving = () => {
   notYetQueriedClasses = Array.from(queriedClasses)
   notYetQueriedIds = Array.from(queriedIds)
   fetchNewClassIdRules()
+  scheduleFetchNewClassIdRules()
 
   // Second, set up a mutation observer to handle any new ids or classes
   // that are added to the document.
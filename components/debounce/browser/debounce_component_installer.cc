@@ -5,6 +5,9 @@
 
 #include "brave/components/debounce/browser/debounce_component_installer.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <utility>
 
@@ -14,7 +17,7 @@
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
-#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -35,8 +38,8 @@ DebounceComponentInstaller::~DebounceComponentInstaller() {}
 
 void DebounceComponentInstaller::LoadDirectlyFromResourcePath() {
   base::FilePath dat_file_path = resource_dir_.AppendASCII(kDebounceConfigFile);
-  base::ThreadPool::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::MayBlock()},
+  base::PostTaskAndReplyWithResult(
+      GetTaskRunner().get(), FROM_HERE,
       base::BindOnce(&brave_component_updater::GetDATFileAsString,
                      dat_file_path),
       base::BindOnce(&DebounceComponentInstaller::OnDATFileDataReady,
@@ -56,29 +59,69 @@ void DebounceComponentInstaller::OnDATFileDataReady(
   }
   rules_.clear();
   host_cache_.clear();
+  rule_index_.clear();
+  sitewide_rules_.clear();
   std::vector<std::string> hosts;
+  std::map<std::string, std::vector<size_t>> rule_index;
   base::JSONValueConverter<DebounceRule> converter;
   for (base::Value& it : root->GetList()) {
     std::unique_ptr<DebounceRule> rule = std::make_unique<DebounceRule>();
     if (!converter.Convert(it, rule.get()))
       continue;
+    const size_t rule_index_in_list = rules_.size();
+    bool sitewide = false;
+    std::vector<std::string> rule_sites;
     for (const URLPattern& pattern : rule->include_pattern_set()) {
+      std::string etldp1;
       if (!pattern.host().empty()) {
-        std::string etldp1 =
-            net::registry_controlled_domains::GetDomainAndRegistry(
-                pattern.host(),
-                net::registry_controlled_domains::PrivateRegistryFilter::
-                    INCLUDE_PRIVATE_REGISTRIES);
-        hosts.push_back(std::move(etldp1));
+        etldp1 = net::registry_controlled_domains::GetDomainAndRegistry(
+            pattern.host(),
+            net::registry_controlled_domains::PrivateRegistryFilter::
+                INCLUDE_PRIVATE_REGISTRIES);
+        hosts.push_back(etldp1);
+      }
+      // Patterns without a registrable host (e.g. "*://*/*" or a bare public
+      // suffix) can match any site.
+      if (etldp1.empty())
+        sitewide = true;
+      else
+        rule_sites.push_back(std::move(etldp1));
+    }
+    if (sitewide) {
+      sitewide_rules_.push_back(rule_index_in_list);
+    } else {
+      for (const std::string& site : rule_sites) {
+        std::vector<size_t>& indices = rule_index[site];
+        if (indices.empty() || indices.back() != rule_index_in_list)
+          indices.push_back(rule_index_in_list);
       }
     }
     rules_.push_back(std::move(rule));
   }
   host_cache_ = std::move(hosts);
+  rule_index_ = base::flat_map<std::string, std::vector<size_t>>(
+      std::make_move_iterator(rule_index.begin()),
+      std::make_move_iterator(rule_index.end()));
+  RecordLoadTime("Debounce");
   for (Observer& observer : observers_)
     observer.OnRulesReady(this);
 }
 
+std::vector<size_t> DebounceComponentInstaller::GetCandidateRules(
+    const std::string& etldp1) const {
+  auto it = rule_index_.find(etldp1);
+  if (it == rule_index_.end())
+    return sitewide_rules_;
+  if (sitewide_rules_.empty())
+    return it->second;
+
+  std::vector<size_t> candidates;
+  candidates.reserve(it->second.size() + sitewide_rules_.size());
+  std::merge(it->second.begin(), it->second.end(), sitewide_rules_.begin(),
+             sitewide_rules_.end(), std::back_inserter(candidates));
+  return candidates;
+}
+
 void DebounceComponentInstaller::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir,
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
 #include "base/json/json_value_converter.h"
@@ -19,7 +20,6 @@
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/debounce/browser/debounce_rule.h"
-#include "brave/components/debounce/browser/debounce_service.h"
 
 namespace debounce {
 
@@ -45,6 +45,11 @@ class DebounceComponentInstaller
   }
   const base::flat_set<std::string>& host_cache() const { return host_cache_; }
 
+  // Returns the indices into rules(), in rule order, of the rules that can
+  // apply to a URL whose eTLD+1 is |etldp1|. Rules with an include pattern
+  // that isn't tied to a single site are candidates for every URL.
+  std::vector<size_t> GetCandidateRules(const std::string& etldp1) const;
+
   // implementation of brave_component_updater::LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir,
@@ -71,6 +76,10 @@ class DebounceComponentInstaller
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<DebounceRule>> rules_;
   base::flat_set<std::string> host_cache_;
+  // Indices of the rules keyed by the eTLD+1 of their include patterns, built
+  // once per component update so navigations don't scan every rule.
+  base::flat_map<std::string, std::vector<size_t>> rule_index_;
+  std::vector<size_t> sitewide_rules_;
   base::FilePath resource_dir_;
 
   base::WeakPtrFactory<DebounceComponentInstaller> weak_factory_{this};
@@ -5,14 +5,18 @@
 
 #include "brave/components/debounce/browser/debounce_service.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/containers/contains.h"
 #include "base/containers/flat_set.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "brave/components/debounce/browser/debounce_component_installer.h"
+#include "brave/components/debounce/common/features.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "url/origin.h"
 
@@ -20,10 +24,21 @@ namespace debounce {
 
 DebounceService::DebounceService(
     DebounceComponentInstaller* component_installer)
-    : component_installer_(component_installer) {}
+    : component_installer_(component_installer),
+      chain_cache_(features::kBraveDebounceChainCacheSize.Get()) {
+  if (component_installer_)
+    component_installer_observation_.Observe(component_installer_);
+}
 
 DebounceService::~DebounceService() {}
 
+void DebounceService::OnRulesReady(
+    DebounceComponentInstaller* component_installer) {
+  // Chains resolved with the previous rules may no longer be valid.
+  base::AutoLock lock(chain_cache_lock_);
+  chain_cache_.Clear();
+}
+
 bool DebounceService::Debounce(const GURL& original_url,
                                GURL* final_url) const {
   // Check host cache to see if this URL needs to have any debounce rules
@@ -37,22 +52,80 @@ bool DebounceService::Debounce(const GURL& original_url,
   if (!base::Contains(host_cache, etldp1))
     return false;
 
+  if (!base::FeatureList::IsEnabled(features::kBraveDebounceChainCache)) {
+    int hops = 0;
+    return ApplyRules(original_url, etldp1, final_url, &hops);
+  }
+
+  GURL::Replacements remove_ref;
+  remove_ref.ClearRef();
+  const std::string key = original_url.ReplaceComponents(remove_ref).spec();
+  const base::TimeTicks now = base::TimeTicks::Now();
+  {
+    base::AutoLock lock(chain_cache_lock_);
+    auto it = chain_cache_.Get(key);
+    if (it != chain_cache_.end()) {
+      if (it->second.expiration > now) {
+        UMA_HISTOGRAM_EXACT_LINEAR("Brave.Debounce.ChainCacheHopsAvoided",
+                                   it->second.hops, 10);
+        if (it->second.final_url.is_empty())
+          return false;
+        *final_url = it->second.final_url;
+        return true;
+      }
+      chain_cache_.Erase(it);
+    }
+  }
+
+  ChainCacheEntry entry;
+  GURL debounced_url;
+  if (ApplyRules(original_url, etldp1, &debounced_url, &entry.hops)) {
+    entry.final_url = debounced_url;
+    *final_url = debounced_url;
+  }
+  entry.expiration =
+      now + base::TimeDelta::FromSeconds(
+                features::kBraveDebounceChainCacheTtlSeconds.Get());
+  const bool changed = !entry.final_url.is_empty();
+
+  base::AutoLock lock(chain_cache_lock_);
+  chain_cache_.Put(key, std::move(entry));
+  return changed;
+}
+
+bool DebounceService::ApplyRules(const GURL& original_url,
+                                 const std::string& etldp1,
+                                 GURL* final_url,
+                                 int* hops) const {
   bool changed = false;
   GURL current_url = original_url;
   const std::vector<std::unique_ptr<DebounceRule>>& rules =
       component_installer_->rules();
 
-  // Debounce rules are applied in order. All rules are checked on every URL. If
-  // one rule applies, the URL is changed to the debounced URL and we continue
-  // to apply the rest of the rules to the new URL. Previously checked rules are
-  // not reapplied; i.e. we never restart the loop.
-  for (const std::unique_ptr<DebounceRule>& rule : rules) {
-    if (rule->Apply(current_url, final_url)) {
-      if (current_url != *final_url) {
-        changed = true;
-        current_url = *final_url;
-      }
+  // Debounce rules are applied in order. Every rule that can match the URL's
+  // site is checked. If one rule applies, the URL is changed to the debounced
+  // URL and we continue to apply the rest of the rules to the new URL, looking
+  // up the candidates for its site. Previously checked rules are not
+  // reapplied; i.e. we never restart the loop.
+  std::vector<size_t> candidates =
+      component_installer_->GetCandidateRules(etldp1);
+  auto it = candidates.begin();
+  while (it != candidates.end()) {
+    const size_t rule_index = *it;
+    if (!rules[rule_index]->Apply(current_url, final_url) ||
+        current_url == *final_url) {
+      ++it;
+      continue;
     }
+    changed = true;
+    (*hops)++;
+    current_url = *final_url;
+    candidates = component_installer_->GetCandidateRules(
+        net::registry_controlled_domains::GetDomainAndRegistry(
+            current_url,
+            net::registry_controlled_domains::PrivateRegistryFilter::
+                INCLUDE_PRIVATE_REGISTRIES));
+    it = std::upper_bound(candidates.begin(), candidates.end(), rule_index);
   }
   return changed;
 }
@@ -6,16 +6,22 @@
 #ifndef BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_SERVICE_H_
 #define BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_SERVICE_H_
 
+#include <string>
+
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+#include "brave/components/debounce/browser/debounce_component_installer.h"
 #include "components/keyed_service/core/keyed_service.h"
-
-class GURL;
+#include "url/gurl.h"
 
 namespace debounce {
 
-class DebounceComponentInstaller;
-
-class DebounceService : public KeyedService {
+class DebounceService : public KeyedService,
+                        public DebounceComponentInstaller::Observer {
  public:
   explicit DebounceService(DebounceComponentInstaller* component_installer);
   DebounceService(const DebounceService&) = delete;
@@ -23,8 +29,34 @@ class DebounceService : public KeyedService {
   ~DebounceService() override;
   bool Debounce(const GURL& original_url, GURL* final_url) const;
 
+  // DebounceComponentInstaller::Observer:
+  void OnRulesReady(DebounceComponentInstaller* component_installer) override;
+
  private:
+  // A resolved debounce chain. |final_url| is empty when no rule applied.
+  struct ChainCacheEntry {
+    GURL final_url;
+    int hops = 0;
+    base::TimeTicks expiration;
+  };
+
+  // Runs the rules against |original_url|, whose eTLD+1 is |etldp1|, counting
+  // the redirects applied in |hops|.
+  bool ApplyRules(const GURL& original_url,
+                  const std::string& etldp1,
+                  GURL* final_url,
+                  int* hops) const;
+
   DebounceComponentInstaller* component_installer_ = nullptr;  // NOT OWNED
+  base::ScopedObservation<DebounceComponentInstaller,
+                          DebounceComponentInstaller::Observer>
+      component_installer_observation_{this};
+  // Resolved chains keyed by the original URL without its fragment, only for
+  // URLs on a site some rule mentions. Debounce is called from URL loader
+  // throttles, so guard the cache with a lock.
+  mutable base::Lock chain_cache_lock_;
+  mutable base::MRUCache<std::string, ChainCacheEntry> chain_cache_
+      GUARDED_BY(chain_cache_lock_);
   base::WeakPtrFactory<DebounceService> weak_factory_{this};
 };
 
@@ -17,5 +17,15 @@ namespace features {
 const base::Feature kBraveDebounce{"BraveDebounce",
                                    base::FEATURE_DISABLED_BY_DEFAULT};
 
+// When enabled, the result of debouncing a URL, including every hop of a
+// multi-hop redirector chain, is remembered per profile so repeated
+// redirector URLs don't re-run the rules.
+const base::Feature kBraveDebounceChainCache{"BraveDebounceChainCache",
+                                             base::FEATURE_ENABLED_BY_DEFAULT};
+const base::FeatureParam<int> kBraveDebounceChainCacheTtlSeconds{
+    &kBraveDebounceChainCache, "ttl_seconds", 300};
+const base::FeatureParam<int> kBraveDebounceChainCacheSize{
+    &kBraveDebounceChainCache, "cache_size", 256};
+
 }  // namespace features
 }  // namespace debounce
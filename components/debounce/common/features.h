@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_DEBOUNCE_COMMON_FEATURES_H_
 #define BRAVE_COMPONENTS_DEBOUNCE_COMMON_FEATURES_H_
 
+#include "base/metrics/field_trial_params.h"
+
 namespace base {
 
 struct Feature;
@@ -16,6 +18,9 @@ namespace debounce {
 namespace features {
 
 extern const base::Feature kBraveDebounce;
+extern const base::Feature kBraveDebounceChainCache;
+extern const base::FeatureParam<int> kBraveDebounceChainCacheTtlSeconds;
+extern const base::FeatureParam<int> kBraveDebounceChainCacheSize;
 
 }  // namespace features
 }  // namespace debounce
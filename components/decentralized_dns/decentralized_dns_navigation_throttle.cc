@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
 #include "brave/components/decentralized_dns/decentralized_dns_interstitial_controller_client.h"
 #include "brave/components/decentralized_dns/decentralized_dns_opt_in_page.h"
 #include "brave/components/decentralized_dns/utils.h"
@@ -65,6 +66,9 @@ DecentralizedDnsNavigationThrottle::WillStartRequest() {
     return content::NavigationThrottle::DEFER;
   }
 
+  if (IsResolvedOverDoH(url, local_state_))
+    RecordRecentlyResolvedHost(local_state_, url.host(), base::Time::Now());
+
   return content::NavigationThrottle::PROCEED;
 }
 
@@ -5,22 +5,90 @@
 
 #include "brave/components/decentralized_dns/decentralized_dns_service.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
+#include "base/task/post_task.h"
+#include "base/task/task_traits.h"
+#include "base/time/time.h"
 #include "brave/components/decentralized_dns/constants.h"
 #include "brave/components/decentralized_dns/decentralized_dns_service_delegate.h"
 #include "brave/components/decentralized_dns/pref_names.h"
+#include "brave/components/decentralized_dns/utils.h"
 #include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/base/network_isolation_key.h"
+#include "net/base/schemeful_site.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+#include "url/url_constants.h"
 
 namespace decentralized_dns {
 
+namespace {
+
+// Resolves one host and deletes itself once the result is in the host cache.
+// The result itself is not needed.
+class WarmUpResolveHostClient : public network::mojom::ResolveHostClient {
+ public:
+  WarmUpResolveHostClient(network::mojom::NetworkContext* network_context,
+                          const std::string& host) {
+    const GURL url(std::string(url::kHttpsScheme) + "://" + host);
+    const net::SchemefulSite site(url);
+    network::mojom::ResolveHostParametersPtr parameters =
+        network::mojom::ResolveHostParameters::New();
+    parameters->source = net::HostResolverSource::DNS;
+    network_context->ResolveHost(
+        net::HostPortPair::FromURL(url), net::NetworkIsolationKey(site, site),
+        std::move(parameters), receiver_.BindNewPipeAndPassRemote());
+    receiver_.set_disconnect_handler(base::BindOnce(
+        &WarmUpResolveHostClient::OnComplete, base::Unretained(this),
+        net::ERR_FAILED, net::ResolveErrorInfo(net::ERR_FAILED),
+        absl::nullopt));
+  }
+  WarmUpResolveHostClient(const WarmUpResolveHostClient&) = delete;
+  WarmUpResolveHostClient& operator=(const WarmUpResolveHostClient&) = delete;
+
+  void OnComplete(
+      int32_t result,
+      const net::ResolveErrorInfo& resolve_error_info,
+      const absl::optional<net::AddressList>& resolved_addresses) override {
+    delete this;
+  }
+  void OnTextResults(const std::vector<std::string>& text_results) override {}
+  void OnHostnameResults(const std::vector<net::HostPortPair>& hosts) override {
+  }
+
+ private:
+  ~WarmUpResolveHostClient() override = default;
+
+  mojo::Receiver<network::mojom::ResolveHostClient> receiver_{this};
+};
+
+// Startup is busy enough; the warm-up only has to beat the user's first
+// navigation to one of these hosts.
+constexpr base::TimeDelta kPreResolveDelay = base::TimeDelta::FromSeconds(5);
+
+}  // namespace
+
 DecentralizedDnsService::DecentralizedDnsService(
     std::unique_ptr<DecentralizedDnsServiceDelegate> delegate,
     content::BrowserContext* context,
     PrefService* local_state)
-    : delegate_(std::move(delegate)) {
+    : context_(context),
+      local_state_(local_state),
+      delegate_(std::move(delegate)) {
   pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
   pref_change_registrar_->Init(local_state);
   pref_change_registrar_->Add(
@@ -31,6 +99,15 @@ DecentralizedDnsService::DecentralizedDnsService(
       kENSResolveMethod,
       base::BindRepeating(&DecentralizedDnsService::OnPreferenceChanged,
                           base::Unretained(this)));
+
+  if (context_ && local_state_ && !context_->IsOffTheRecord()) {
+    content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+        ->PostDelayedTask(
+            FROM_HERE,
+            base::BindOnce(&DecentralizedDnsService::PreResolveRecentHosts,
+                           weak_ptr_factory_.GetWeakPtr()),
+            kPreResolveDelay);
+  }
 }
 
 DecentralizedDnsService::~DecentralizedDnsService() = default;
@@ -42,10 +119,23 @@ void DecentralizedDnsService::RegisterLocalStatePrefs(
                                 static_cast<int>(ResolveMethodTypes::ASK));
   registry->RegisterIntegerPref(kENSResolveMethod,
                                 static_cast<int>(ResolveMethodTypes::ASK));
+  registry->RegisterListPref(kRecentlyResolvedHosts);
 }
 
 void DecentralizedDnsService::OnPreferenceChanged() {
   delegate_->UpdateNetworkService();
 }
 
+void DecentralizedDnsService::PreResolveRecentHosts() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  const std::vector<std::string> hosts =
+      GetRecentlyResolvedHosts(local_state_, base::Time::Now());
+  if (hosts.empty())
+    return;
+  network::mojom::NetworkContext* network_context =
+      context_->GetDefaultStoragePartition()->GetNetworkContext();
+  for (const auto& host : hosts)
+    new WarmUpResolveHostClient(network_context, host);
+}
+
 }  // namespace decentralized_dns
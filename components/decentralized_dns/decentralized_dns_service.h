@@ -8,6 +8,7 @@
 
 #include <memory>
 
+#include "base/memory/weak_ptr.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace content {
@@ -37,9 +38,16 @@ class DecentralizedDnsService : public KeyedService {
 
  private:
   void OnPreferenceChanged();
+  // Resolves recently visited DoH hosts again so their host cache entries are
+  // warm by the time the user navigates to them.
+  void PreResolveRecentHosts();
 
+  content::BrowserContext* context_ = nullptr;
+  PrefService* local_state_ = nullptr;
   std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
   std::unique_ptr<DecentralizedDnsServiceDelegate> delegate_;
+
+  base::WeakPtrFactory<DecentralizedDnsService> weak_ptr_factory_{this};
 };
 
 }  // namespace decentralized_dns
@@ -23,6 +23,12 @@ constexpr char kUnstoppableDomainsResolveMethod[] =
 // DNS Over HTTPS: Resolve domain name using a public DNS over HTTPS server.
 constexpr char kENSResolveMethod[] = "brave.ens.resolve_method";
 
+// Most recently visited ENS and Unstoppable Domains hosts resolved over DNS
+// over HTTPS, newest first, each with the time of its last visit. They are
+// resolved again at startup so their first navigation hits a warm host cache.
+constexpr char kRecentlyResolvedHosts[] =
+    "brave.decentralized_dns.recently_resolved_hosts";
+
 }  // namespace decentralized_dns
 
 #endif  // BRAVE_COMPONENTS_DECENTRALIZED_DNS_PREF_NAMES_H_
@@ -5,8 +5,11 @@
 
 #include "brave/components/decentralized_dns/utils.h"
 
+#include <utility>
+
 #include "base/feature_list.h"
 #include "base/strings/string_util.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/decentralized_dns/constants.h"
 #include "brave/components/decentralized_dns/features.h"
@@ -14,6 +17,7 @@
 #include "brave/net/decentralized_dns/constants.h"
 #include "components/grit/brave_components_strings.h"
 #include "components/prefs/pref_service.h"
+#include "components/prefs/scoped_user_pref_update.h"
 #include "ui/base/l10n/l10n_util.h"
 #include "url/gurl.h"
 
@@ -21,6 +25,21 @@ namespace decentralized_dns {
 
 namespace {
 
+constexpr char kHostKey[] = "host";
+constexpr char kLastUsedKey[] = "last_used";
+
+// Bounds for kRecentlyResolvedHosts.
+constexpr size_t kMaxRecentlyResolvedHosts = 16;
+constexpr base::TimeDelta kRecentlyResolvedHostLifetime =
+    base::TimeDelta::FromDays(7);
+
+bool IsRecent(const base::Value& entry, base::Time now) {
+  absl::optional<double> last_used = entry.FindDoubleKey(kLastUsedKey);
+  return last_used &&
+         now - base::Time::FromDoubleT(*last_used) <
+             kRecentlyResolvedHostLifetime;
+}
+
 base::Value MakeSelectValue(ResolveMethodTypes value,
                             const std::u16string& name) {
   base::Value item(base::Value::Type::DICTIONARY);
@@ -119,4 +138,44 @@ base::Value GetResolveMethodList(Provider provider) {
   return list;
 }
 
+bool IsResolvedOverDoH(const GURL& url, PrefService* local_state) {
+  return (IsUnstoppableDomainsTLD(url) &&
+          IsUnstoppableDomainsResolveMethodDoH(local_state)) ||
+         (IsENSTLD(url) && IsENSResolveMethodDoH(local_state));
+}
+
+void RecordRecentlyResolvedHost(PrefService* local_state,
+                                const std::string& host,
+                                base::Time now) {
+  ListPrefUpdate update(local_state, kRecentlyResolvedHosts);
+  base::Value::ListStorage hosts;
+  base::Value entry(base::Value::Type::DICTIONARY);
+  entry.SetStringKey(kHostKey, host);
+  entry.SetDoubleKey(kLastUsedKey, now.ToDoubleT());
+  hosts.push_back(std::move(entry));
+  for (auto& old_entry : update->GetList()) {
+    if (hosts.size() == kMaxRecentlyResolvedHosts)
+      break;
+    const std::string* old_host = old_entry.FindStringKey(kHostKey);
+    if (!old_host || *old_host == host || !IsRecent(old_entry, now))
+      continue;
+    hosts.push_back(std::move(old_entry));
+  }
+  *update.Get() = base::Value(std::move(hosts));
+}
+
+std::vector<std::string> GetRecentlyResolvedHosts(PrefService* local_state,
+                                                  base::Time now) {
+  std::vector<std::string> hosts;
+  for (const auto& entry :
+       local_state->GetList(kRecentlyResolvedHosts)->GetList()) {
+    const std::string* host = entry.FindStringKey(kHostKey);
+    if (host && IsRecent(entry, now) &&
+        IsResolvedOverDoH(GURL("https://" + *host), local_state)) {
+      hosts.push_back(*host);
+    }
+  }
+  return hosts;
+}
+
 }  // namespace decentralized_dns
@@ -6,12 +6,16 @@
 #ifndef BRAVE_COMPONENTS_DECENTRALIZED_DNS_UTILS_H_
 #define BRAVE_COMPONENTS_DECENTRALIZED_DNS_UTILS_H_
 
+#include <string>
+#include <vector>
+
 class GURL;
 class PrefService;
 
 namespace base {
+class Time;
 class Value;
-}
+}  // namespace base
 
 namespace decentralized_dns {
 
@@ -30,6 +34,20 @@ bool IsENSResolveMethodDoH(PrefService* local_state);
 bool IsENSResolveMethodEthereum(PrefService* local_state);
 base::Value GetResolveMethodList(Provider provider);
 
+// Whether navigations to |url| are resolved by one of the decentralized DNS
+// DoH resolvers.
+bool IsResolvedOverDoH(const GURL& url, PrefService* local_state);
+
+// Moves |host| to the front of kRecentlyResolvedHosts, dropping entries that
+// are too old or over the size limit.
+void RecordRecentlyResolvedHost(PrefService* local_state,
+                                const std::string& host,
+                                base::Time now);
+// Returns the hosts in kRecentlyResolvedHosts that are still recent enough
+// and still resolved over DoH, newest first.
+std::vector<std::string> GetRecentlyResolvedHosts(PrefService* local_state,
+                                                  base::Time now);
+
 }  // namespace decentralized_dns
 
 #endif  // BRAVE_COMPONENTS_DECENTRALIZED_DNS_UTILS_H_
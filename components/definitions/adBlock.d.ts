@@ -9,6 +9,7 @@ declare namespace AdBlock {
       regionalLists: FilterList[]
       listSubscriptions: SubscriptionInfo[]
     }
+    engineStats: EngineStats[]
   }
 
   export interface FilterList {
@@ -27,4 +28,14 @@ declare namespace AdBlock {
     last_successful_update_attempt: number
     enabled: boolean
   }
+
+  export interface EngineStats {
+    engine: string
+    samples: number
+    requests: number
+    matches: number
+    total_time_ms: number
+    mean_time_us: number
+    max_time_us: number
+  }
 }
@@ -11,11 +11,13 @@
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/containers/flat_set.h"
 #include "base/files/file_path_watcher.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -122,9 +124,11 @@ void GreaselionRule::Parse(base::DictionaryValue* preconditions_value,
     if (pattern.Parse(pattern_string) != URLPattern::ParseResult::kSuccess) {
       LOG(ERROR) << "Malformed pattern in Greaselion configuration";
       url_patterns_.clear();
+      parsed_url_patterns_.clear();
       return;
     }
     url_patterns_.push_back(pattern_string);
+    parsed_url_patterns_.push_back(pattern);
   }
   for (const auto& scripts_it : scripts_value->GetList()) {
     base::FilePath script_path = resource_dir.AppendASCII(
@@ -193,6 +197,14 @@ bool GreaselionRule::Matches(
   return true;
 }
 
+bool GreaselionRule::MatchesURL(const GURL& url) const {
+  for (const auto& pattern : parsed_url_patterns_) {
+    if (pattern.MatchesURL(url))
+      return true;
+  }
+  return false;
+}
+
 GreaselionDownloadService::GreaselionDownloadService(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service), weak_factory_(this) {
@@ -278,6 +290,8 @@ void GreaselionDownloadService::LoadDirectlyFromResourcePath() {
 void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_by_host_.clear();
+  rules_for_any_host_.clear();
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
@@ -316,6 +330,8 @@ void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
         minimum_brave_version_value, messages_path, resource_dir_);
     rules_.push_back(std::move(rule));
   }
+  BuildHostIndex();
+  RecordLoadTime("Greaselion");
   for (Observer& observer : observers_)
     observer.OnRulesReady(this);
 }
@@ -337,9 +353,48 @@ GreaselionDownloadService::rules() {
   return &rules_;
 }
 
-scoped_refptr<base::SequencedTaskRunner>
-GreaselionDownloadService::GetTaskRunner() {
-  return local_data_files_service()->GetTaskRunner();
+std::vector<GreaselionRule*> GreaselionDownloadService::GetRulesForURL(
+    const GURL& url) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::vector<GreaselionRule*> matches;
+  if (!url.is_valid() || !url.SchemeIsHTTPOrHTTPS())
+    return matches;
+
+  // Sorted, so the result keeps the configuration order.
+  base::flat_set<size_t> candidates(rules_for_any_host_.begin(),
+                                    rules_for_any_host_.end());
+  // Patterns with subdomain wildcards are indexed under their base host, so
+  // look up the host and each of its parent domains.
+  base::StringPiece host = url.host_piece();
+  while (!host.empty()) {
+    auto it = rules_by_host_.find(std::string(host));
+    if (it != rules_by_host_.end())
+      candidates.insert(it->second.begin(), it->second.end());
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+
+  for (size_t index : candidates) {
+    GreaselionRule* rule = rules_[index].get();
+    if (rule->MatchesURL(url))
+      matches.push_back(rule);
+  }
+  return matches;
+}
+
+void GreaselionDownloadService::BuildHostIndex() {
+  for (size_t index = 0; index < rules_.size(); ++index) {
+    for (const auto& pattern : rules_[index]->parsed_url_patterns()) {
+      std::vector<size_t>& bucket = pattern.host().empty()
+                                        ? rules_for_any_host_
+                                        : rules_by_host_[pattern.host()];
+      // A rule may list several patterns for the same host.
+      if (bucket.empty() || bucket.back() != index)
+        bucket.push_back(index);
+    }
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,7 +21,7 @@
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "content/public/browser/notification_types.h"
-#include "extensions/common/url_pattern_set.h"
+#include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
 class GreaselionServiceTest;
@@ -65,8 +66,13 @@ class GreaselionRule {
              const base::FilePath& resource_dir);
   bool Matches(
       GreaselionFeatures state, const base::Version& browser_version) const;
+  // Whether |url| matches one of the rule's URL patterns.
+  bool MatchesURL(const GURL& url) const;
   std::string name() const { return name_; }
   std::vector<std::string> url_patterns() const { return url_patterns_; }
+  const std::vector<URLPattern>& parsed_url_patterns() const {
+    return parsed_url_patterns_;
+  }
   std::vector<base::FilePath> scripts() const { return scripts_; }
   std::string run_at() const {
     return run_at_;
@@ -84,6 +90,7 @@ class GreaselionRule {
 
   std::string name_;
   std::vector<std::string> url_patterns_;
+  std::vector<URLPattern> parsed_url_patterns_;
   std::vector<base::FilePath> scripts_;
   std::string run_at_;
   std::string minimum_brave_version_;
@@ -102,7 +109,10 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   ~GreaselionDownloadService() override;
 
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
-  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
+  // Rules with a URL pattern matching |url|, in configuration order. Only
+  // the rules indexed under the URL's host and its parent domains are
+  // checked, so the cost doesn't grow with the size of the rule set.
+  std::vector<GreaselionRule*> GetRulesForURL(const GURL& url) const;
 
   // implementation of LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
@@ -126,9 +136,14 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   void OnDevModeLocalFileChanged(bool error);
   void LoadOnTaskRunner();
   void LoadDirectlyFromResourcePath();
+  void BuildHostIndex();
 
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  // Indices into |rules_|, keyed by the host of each URL pattern. Rules with
+  // a pattern matching any host are kept in |rules_for_any_host_|.
+  std::map<std::string, std::vector<size_t>> rules_by_host_;
+  std::vector<size_t> rules_for_any_host_;
   base::FilePath resource_dir_;
   bool is_dev_mode_ = false;
   scoped_refptr<base::SequencedTaskRunner> dev_mode_task_runner_;
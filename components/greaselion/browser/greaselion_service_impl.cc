@@ -6,6 +6,7 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -16,11 +17,15 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/containers/contains.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -33,6 +38,7 @@
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/extension_registry.h"
@@ -52,6 +58,7 @@ using extensions::mojom::ManifestLocation;
 namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
+constexpr char kCacheDirName[] = "Cache";
 
 bool ShouldComputeHashesForResource(
     const base::FilePath& relative_resource_path) {
@@ -60,37 +67,71 @@ bool ShouldComputeHashesForResource(
   return !components.empty() && components[0] != extensions::kMetadataFolder;
 }
 
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
-//
-// NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-absl::optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
+// Hashes everything the converted extension is built from, so that a cached
+// conversion is reused only while all of it is unchanged. Returns
+// absl::nullopt if a file can't be read.
+absl::optional<std::string> ComputeRuleCacheKey(
     const greaselion::GreaselionRule& rule,
-    const base::FilePath& install_dir) {
-  base::FilePath install_temp_dir =
-      extensions::file_util::GetInstallTempDir(install_dir);
-  if (install_temp_dir.empty()) {
-    LOG(ERROR) << "Could not get path to profile temp directory";
-    return absl::nullopt;
+    const std::string& public_key,
+    const std::string& browser_version) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  auto update = [&hash](const std::string& value) {
+    // Length-prefix each value so that adjacent values can't run together.
+    const uint64_t size = value.size();
+    hash->Update(&size, sizeof(size));
+    hash->Update(value.data(), value.size());
+  };
+
+  update(browser_version);
+  update(rule.name());
+  update(public_key);
+  update(rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    update(url_pattern);
+  for (const auto& script : rule.scripts()) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents))
+      return absl::nullopt;
+    update(script.BaseName().AsUTF8Unsafe());
+    update(contents);
   }
-
-  base::ScopedTempDir temp_dir;
-  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
-    LOG(ERROR) << "Could not create Greaselion temp directory";
-    return absl::nullopt;
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+    for (const auto& path : message_files) {
+      std::string contents;
+      if (!base::ReadFileToString(path, &contents))
+        return absl::nullopt;
+      base::FilePath relative_path;
+      rule.messages().AppendRelativePath(path, &relative_path);
+      update(relative_path.AsUTF8Unsafe());
+      update(contents);
+    }
   }
 
-  // Create the manifest
-  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
-
-  // manifest version is always 2
-  // see kModernManifestVersion in src/extensions/common/extension.cc
-  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::HexEncode(digest, sizeof(digest));
+}
 
+// Wraps a Greaselion rule in a component. The component is stored as
+// an unpacked extension under |install_dir|/Cache, in a directory named
+// after ComputeRuleCacheKey(), and is reused as long as the rule, its files
+// and the browser version are unchanged. Returns a valid extension, or
+// nullptr.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
+    const greaselion::GreaselionRule& rule,
+    const base::FilePath& install_dir,
+    const std::string& browser_version) {
   // Create the public key.
   // Greaselion scripts are not signed, but the public key for an extension
   // doubles as its unique identity, and we need one of those, so we add the
@@ -114,6 +155,46 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   }
   base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
 
+  absl::optional<std::string> cache_key =
+      ComputeRuleCacheKey(rule, key, browser_version);
+  if (!cache_key) {
+    LOG(ERROR) << "Could not read Greaselion rule " << script_name;
+    return nullptr;
+  }
+  const base::FilePath cache_dir =
+      install_dir.AppendASCII(kCacheDirName).AppendASCII(*cache_key);
+
+  std::string error;
+  if (base::DirectoryExists(cache_dir)) {
+    scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+        cache_dir, ManifestLocation::kComponent, Extension::NO_FLAGS, &error);
+    if (extension)
+      return extension;
+    // Fall through and convert again.
+    LOG(ERROR) << "Could not load cached Greaselion extension: " << error;
+    base::DeletePathRecursively(cache_dir);
+  }
+
+  base::FilePath install_temp_dir =
+      extensions::file_util::GetInstallTempDir(install_dir);
+  if (install_temp_dir.empty()) {
+    LOG(ERROR) << "Could not get path to profile temp directory";
+    return nullptr;
+  }
+
+  base::ScopedTempDir temp_dir;
+  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
+    LOG(ERROR) << "Could not create Greaselion temp directory";
+    return nullptr;
+  }
+
+  // Create the manifest
+  std::unique_ptr<base::DictionaryValue> root(new base::DictionaryValue);
+
+  // manifest version is always 2
+  // see kModernManifestVersion in src/extensions/common/extension.cc
+  root->SetIntPath(extensions::manifest_keys::kManifestVersion, 2);
+
   root->SetStringPath(extensions::manifest_keys::kName, script_name);
   root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
   root->SetStringPath(extensions::manifest_keys::kDescription, "");
@@ -159,7 +240,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return absl::nullopt;
+    return nullptr;
   }
 
   // Copy the messages directory to our extension directory.
@@ -169,7 +250,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
             temp_dir.GetPath().AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
                  << rule.messages().LossyDisplayName();
-      return absl::nullopt;
+      return nullptr;
     }
   }
 
@@ -179,36 +260,53 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
                         temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
-      return absl::nullopt;
+      return nullptr;
     }
   }
 
-  std::string error;
-  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), ManifestLocation::kComponent, Extension::NO_FLAGS,
-      &error);
-  if (!extension.get()) {
-    LOG(ERROR) << "Could not load Greaselion extension";
-    LOG(ERROR) << error;
-    return absl::nullopt;
-  }
-
   // Calculate and write computed hashes.
   absl::optional<extensions::ComputedHashes::Data> computed_hashes_data =
       extensions::ComputedHashes::Compute(
-          extension->path(),
+          temp_dir.GetPath(),
           extension_misc::kContentVerificationDefaultBlockSize,
           extensions::IsCancelledCallback(),
           base::BindRepeating(&ShouldComputeHashesForResource));
   if (computed_hashes_data) {
     extensions::ComputedHashes(std::move(*computed_hashes_data))
         .WriteToFile(
-            extensions::file_util::GetComputedHashesPath(extension->path()));
+            extensions::file_util::GetComputedHashesPath(temp_dir.GetPath()));
   }
 
-  // Take ownership of this temporary directory so it's deleted when
-  // the service exits
-  return std::make_pair(extension, std::move(temp_dir));
+  // Move the finished conversion into the cache in one step, so that an
+  // interrupted conversion is never picked up on the next startup.
+  if (!base::CreateDirectory(cache_dir.DirName()) ||
+      !base::Move(temp_dir.GetPath(), cache_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension into the cache";
+    return nullptr;
+  }
+  ignore_result(temp_dir.Take());
+
+  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+      cache_dir, ManifestLocation::kComponent, Extension::NO_FLAGS, &error);
+  if (!extension.get()) {
+    LOG(ERROR) << "Could not load Greaselion extension";
+    LOG(ERROR) << error;
+    return nullptr;
+  }
+  return extension;
+}
+
+// Removes cached conversions that no rule uses anymore.
+void PruneGreaselionCacheOnTaskRunner(
+    const base::FilePath& install_dir,
+    const std::vector<base::FilePath>& used_dirs) {
+  base::FileEnumerator enumerator(install_dir.AppendASCII(kCacheDirName),
+                                  false, base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (!base::Contains(used_dirs, path))
+      base::DeletePathRecursively(path);
+  }
 }
 }  // namespace
 
@@ -295,6 +393,8 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
       pending_installs_ += 1;
     }
   }
+  pending_conversions_ = pending_installs_;
+  converted_extension_dirs_.clear();
   if (!pending_installs_) {
     // no rules match, nothing else to do
     MaybeNotifyObservers();
@@ -309,7 +409,8 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
       base::PostTaskAndReplyWithResult(
           task_runner_.get(), FROM_HERE,
           base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
+                         rule_copy, install_directory_,
+                         browser_version_.GetString()),
           base::BindOnce(&GreaselionServiceImpl::PostConvert,
                          weak_factory_.GetWeakPtr()));
     }
@@ -317,19 +418,31 @@ void GreaselionServiceImpl::CreateAndInstallExtensions() {
 }
 
 void GreaselionServiceImpl::PostConvert(
-    absl::optional<GreaselionConvertedExtension> converted_extension) {
-  if (!converted_extension) {
+    scoped_refptr<extensions::Extension> extension) {
+  if (extension)
+    converted_extension_dirs_.push_back(extension->path());
+  pending_conversions_ -= 1;
+  if (!pending_conversions_ && all_rules_installed_successfully_ &&
+      extension) {
+    // Every rule has a converted extension now, so anything else in the
+    // cache is stale.
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&PruneGreaselionCacheOnTaskRunner,
+                                          install_directory_,
+                                          converted_extension_dirs_));
+  }
+
+  if (!extension) {
     all_rules_installed_successfully_ = false;
     pending_installs_ -= 1;
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    greaselion_extensions_.push_back(extension->id());
     extension_system_->ready().Post(
-        FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
-                                  weak_factory_.GetWeakPtr(),
-                                  std::move(converted_extension->first)));
+        FROM_HERE,
+        base::BindOnce(&GreaselionServiceImpl::Install,
+                       weak_factory_.GetWeakPtr(), std::move(extension)));
   }
 }
 
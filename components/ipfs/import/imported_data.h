@@ -37,6 +37,9 @@ struct ImportedData {
 
 using ImportCompletedCallback =
     base::OnceCallback<void(const ipfs::ImportedData&)>;
+// Reports how many bytes of the request body have been sent to the node.
+using ImportProgressCallback =
+    base::RepeatingCallback<void(uint64_t position, uint64_t total)>;
 
 }  // namespace ipfs
 
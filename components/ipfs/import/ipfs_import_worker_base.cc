@@ -8,8 +8,10 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/containers/flat_set.h"
 #include "base/files/file_util.h"
 #include "base/guid.h"
+#include "base/no_destructor.h"
 #include "base/strings/strcat.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
@@ -51,6 +53,13 @@ std::string TimeFormatDate(const base::Time& time) {
                             exploded_time.month, exploded_time.day_of_month);
 }
 
+// Import directories known to exist on a node, keyed by node endpoint and
+// directory, so only the first import of the day pays for the mkdir call.
+base::flat_set<std::string>& GetCreatedDirectories() {
+  static base::NoDestructor<base::flat_set<std::string>> directories;
+  return *directories;
+}
+
 }  // namespace
 
 namespace ipfs {
@@ -118,6 +127,12 @@ void IpfsImportWorkerBase::ImportText(const std::string& text,
                        std::move(upload_callback));
 }
 
+void IpfsImportWorkerBase::SetProgressCallback(
+    ImportProgressCallback callback) {
+  DCHECK(!url_loader_);
+  progress_callback_ = std::move(callback);
+}
+
 void IpfsImportWorkerBase::UploadData(
     std::unique_ptr<network::ResourceRequest> request) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -134,6 +149,8 @@ void IpfsImportWorkerBase::UploadData(
 
   DCHECK(!url_loader_);
   url_loader_ = CreateURLLoader(url, "POST", std::move(request));
+  if (progress_callback_)
+    url_loader_->SetOnUploadProgressCallback(progress_callback_);
 
   url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_,
@@ -176,6 +193,10 @@ void IpfsImportWorkerBase::OnImportAddComplete(
   }
   url_loader_.reset();
   if (success && !data_->hash.empty()) {
+    if (key_to_publish_.empty())
+      publish_state_ = IPFS_IMPORT_SUCCESS;
+    else
+      PublishContent();
     CreateBraveDirectory();
     return;
   }
@@ -183,12 +204,20 @@ void IpfsImportWorkerBase::OnImportAddComplete(
 }
 
 void IpfsImportWorkerBase::CreateBraveDirectory() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   DCHECK(!url_loader_);
-  GURL url = net::AppendQueryParameter(
-      server_endpoint_.Resolve(kImportMakeDirectoryPath), "parents", "true");
   std::string directory = kImportDirectory;
   directory += TimeFormatDate(base::Time::Now());
   directory += "/";
+  if (GetCreatedDirectories().contains(server_endpoint_.spec() + directory)) {
+    data_->directory = directory;
+    directory_from_cache_ = true;
+    CopyFilesToBraveDirectory();
+    return;
+  }
+
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportMakeDirectoryPath), "parents", "true");
   url = net::AppendQueryParameter(url, "arg", directory);
 
   url_loader_ = CreateURLLoader(url, "POST");
@@ -208,11 +237,13 @@ void IpfsImportWorkerBase::OnImportDirectoryCreated(
   url_loader_.reset();
   bool success = (error_code == net::OK && response_code == net::HTTP_OK);
   if (success) {
+    GetCreatedDirectories().insert(server_endpoint_.spec() + directory);
     data_->directory = directory;
     CopyFilesToBraveDirectory();
     return;
   }
-  NotifyImportCompleted(IPFS_IMPORT_ERROR_MKDIR_FAILED);
+  directory_state_ = IPFS_IMPORT_ERROR_MKDIR_FAILED;
+  MaybeNotifyImportCompleted();
 }
 
 void IpfsImportWorkerBase::CopyFilesToBraveDirectory() {
@@ -238,27 +269,32 @@ void IpfsImportWorkerBase::OnImportFilesMoved(
     response_code = url_loader_->ResponseInfo()->headers->response_code();
   url_loader_.reset();
   bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success && directory_from_cache_) {
+    // The directory may have been removed from the node since it was cached,
+    // create it again before giving up.
+    GetCreatedDirectories().erase(server_endpoint_.spec() + data_->directory);
+    directory_from_cache_ = false;
+    CreateBraveDirectory();
+    return;
+  }
   if (!success) {
     VLOG(1) << "error_code:" << error_code << " response_code:" << response_code
             << " response_body:" << *response_body;
   }
-  if (!data_->hash.empty() && !key_to_publish_.empty()) {
-    PublishContent();
-    return;
-  }
-  NotifyImportCompleted(success ? IPFS_IMPORT_SUCCESS
-                                : IPFS_IMPORT_ERROR_MOVE_FAILED);
+  directory_state_ =
+      success ? IPFS_IMPORT_SUCCESS : IPFS_IMPORT_ERROR_MOVE_FAILED;
+  MaybeNotifyImportCompleted();
 }
 
 void IpfsImportWorkerBase::PublishContent() {
-  DCHECK(!url_loader_);
+  DCHECK(!publish_url_loader_);
   std::string from = "/ipfs/" + data_->hash;
   GURL url = net::AppendQueryParameter(
       server_endpoint_.Resolve(kAPIPublishNameEndpoint), "arg", from);
   url = net::AppendQueryParameter(url, "key", key_to_publish_);
 
-  url_loader_ = CreateURLLoader(url, "POST");
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+  publish_url_loader_ = CreateURLLoader(url, "POST");
+  publish_url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_,
       base::BindOnce(&IpfsImportWorkerBase::OnContentPublished,
                      base::Unretained(this)));
@@ -266,11 +302,14 @@ void IpfsImportWorkerBase::PublishContent() {
 
 void IpfsImportWorkerBase::OnContentPublished(
     std::unique_ptr<std::string> response_body) {
-  int error_code = url_loader_->NetError();
+  int error_code = publish_url_loader_->NetError();
   int response_code = -1;
-  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
-    response_code = url_loader_->ResponseInfo()->headers->response_code();
-  url_loader_.reset();
+  if (publish_url_loader_->ResponseInfo() &&
+      publish_url_loader_->ResponseInfo()->headers) {
+    response_code =
+        publish_url_loader_->ResponseInfo()->headers->response_code();
+  }
+  publish_url_loader_.reset();
   bool success = (error_code == net::OK && response_code == net::HTTP_OK);
   if (success)
     data_->published_key = key_to_publish_;
@@ -279,8 +318,20 @@ void IpfsImportWorkerBase::OnContentPublished(
             << " response_body:" << *response_body;
   }
 
-  NotifyImportCompleted(success ? IPFS_IMPORT_SUCCESS
-                                : IPFS_IMPORT_ERROR_PUBLISH_FAILED);
+  publish_state_ =
+      success ? IPFS_IMPORT_SUCCESS : IPFS_IMPORT_ERROR_PUBLISH_FAILED;
+  MaybeNotifyImportCompleted();
+}
+
+void IpfsImportWorkerBase::MaybeNotifyImportCompleted() {
+  if (!directory_state_ || !publish_state_)
+    return;
+  // A failed copy is not reported when the content was published, the
+  // published name is what the user asked for.
+  ImportState state = *directory_state_;
+  if (state != IPFS_IMPORT_ERROR_MKDIR_FAILED && !key_to_publish_.empty())
+    state = *publish_state_;
+  NotifyImportCompleted(state);
 }
 
 void IpfsImportWorkerBase::NotifyImportCompleted(ipfs::ImportState state) {
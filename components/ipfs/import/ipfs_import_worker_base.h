@@ -20,6 +20,7 @@
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_network_utils.h"
 #include "components/version_info/channel.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -40,8 +41,11 @@ namespace ipfs {
 // IpfsImportWorkerBase:
 //   2. Sends blob to ifps using IPFS api (/api/v0/add)
 //   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
+//      unless an earlier import in this session already created it
 //   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
 //   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
+// The upload in step 2 streams the blob's file items from disk. Step 5 only
+// needs the hash from step 2, so it runs alongside steps 3 and 4.
 class IpfsImportWorkerBase {
  public:
   IpfsImportWorkerBase(BlobContextGetterFactory* blob_context_getter_factory,
@@ -61,6 +65,9 @@ class IpfsImportWorkerBase {
   void ImportText(const std::string& text, const std::string& host);
   void ImportFolder(const base::FilePath folder_path);
 
+  // Must be set before the upload starts.
+  void SetProgressCallback(ImportProgressCallback callback);
+
  protected:
   network::mojom::URLLoaderFactory* GetUrlLoaderFactory();
 
@@ -80,12 +87,22 @@ class IpfsImportWorkerBase {
                          ipfs::ImportedData* data);
   void PublishContent();
   void OnContentPublished(std::unique_ptr<std::string> response_body);
+  void MaybeNotifyImportCompleted();
+
   ImportCompletedCallback callback_;
+  ImportProgressCallback progress_callback_;
+  // Results of steps 3-4 and of step 5, set as each branch finishes.
+  absl::optional<ImportState> directory_state_;
+  absl::optional<ImportState> publish_state_;
+  // Whether step 3 was skipped because the directory was created earlier in
+  // this session.
+  bool directory_from_cache_ = false;
   std::unique_ptr<ipfs::ImportedData> data_;
 
   BlobContextGetterFactory* blob_context_getter_factory_ = nullptr;
   network::mojom::URLLoaderFactory* url_loader_factory_;
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
+  std::unique_ptr<network::SimpleURLLoader> publish_url_loader_;
   GURL server_endpoint_;
   std::string key_to_publish_;
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
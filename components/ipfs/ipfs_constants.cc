@@ -21,6 +21,7 @@ const char kIPFSScheme[] = "ipfs";
 const char kIPNSScheme[] = "ipns";
 const char kDefaultIPFSGateway[] = "https://dweb.link";
 const char kDefaultIPFSLocalGateway[] = "http://localhost";
+const char kGatewayValidationCID[] = "bafkqae2xmvwgg33nmuqhi3zajfiemuzahiwss";
 const char kIPFSSettingsURL[] = "brave://settings/ipfs";
 const char kIPFSLearnMorePrivacyURL[] =
     "https://support.brave.com/hc/en-us/articles/"
@@ -21,6 +21,7 @@ extern const char kIPFSScheme[];
 extern const char kIPNSScheme[];
 extern const char kDefaultIPFSGateway[];
 extern const char kDefaultIPFSLocalGateway[];
+extern const char kGatewayValidationCID[];
 extern const char kIPFSLearnMorePrivacyURL[];
 extern const char kIPFSLearnMoreURL[];
 extern const char kIPFSSettingsURL[];
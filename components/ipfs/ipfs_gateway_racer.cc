@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_gateway_racer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_network_utils.h"
+#include "brave/components/ipfs/ipfs_utils.h"
+#include "brave/components/ipfs/pref_names.h"
+#include "components/prefs/pref_service.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+
+namespace ipfs {
+
+namespace {
+
+// Public gateways raced against the configured one.
+const char* const kGatewayCandidates[] = {
+    kDefaultIPFSGateway,
+    "https://cf-ipfs.com",
+    "https://nftstorage.link",
+};
+
+constexpr base::TimeDelta kProbeInterval = base::TimeDelta::FromMinutes(10);
+constexpr base::TimeDelta kProbeTimeout = base::TimeDelta::FromSeconds(10);
+
+// Weight of the newest sample in the rolling latency score.
+constexpr double kLatencySampleWeight = 0.3;
+
+// A challenger has to beat the current gateway by this factor before
+// requests move over, so close scores don't make the gateway flap.
+constexpr double kSwitchThreshold = 0.8;
+
+}  // namespace
+
+IpfsGatewayRacer::IpfsGatewayRacer(
+    PrefService* prefs,
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    : prefs_(prefs), url_loader_factory_(std::move(url_loader_factory)) {
+  DCHECK(prefs_);
+  pref_change_registrar_.Init(prefs_);
+  pref_change_registrar_.Add(
+      kIPFSGatewayRacingEnabled,
+      base::BindRepeating(&IpfsGatewayRacer::OnRacingPrefChanged,
+                          base::Unretained(this)));
+  OnRacingPrefChanged();
+}
+
+IpfsGatewayRacer::~IpfsGatewayRacer() = default;
+
+GURL IpfsGatewayRacer::GetFastestGateway() const {
+  if (!prefs_->GetBoolean(kIPFSGatewayRacingEnabled))
+    return GURL();
+  return fastest_gateway_;
+}
+
+void IpfsGatewayRacer::OnRacingPrefChanged() {
+  if (!prefs_->GetBoolean(kIPFSGatewayRacingEnabled)) {
+    probe_timer_.Stop();
+    url_loaders_.clear();
+    scores_.clear();
+    fastest_gateway_ = GURL();
+    return;
+  }
+  if (probe_timer_.IsRunning())
+    return;
+  probe_timer_.Start(FROM_HERE, kProbeInterval,
+                     base::BindRepeating(&IpfsGatewayRacer::ProbeGateways,
+                                         base::Unretained(this)));
+  ProbeGateways();
+}
+
+std::vector<GURL> IpfsGatewayRacer::GetCandidates() const {
+  std::vector<GURL> candidates;
+  GURL configured = GetDefaultIPFSGateway(prefs_);
+  if (configured.is_valid())
+    candidates.push_back(configured.GetOrigin());
+  for (const char* spec : kGatewayCandidates) {
+    GURL candidate(spec);
+    if (candidate.GetOrigin() != configured.GetOrigin())
+      candidates.push_back(candidate.GetOrigin());
+  }
+  return candidates;
+}
+
+void IpfsGatewayRacer::ProbeGateways() {
+  GURL::Replacements replacements;
+  std::string path = "/ipfs/";
+  path += kGatewayValidationCID;
+  replacements.SetPathStr(path);
+  for (const auto& gateway : GetCandidates()) {
+    auto url_loader =
+        CreateURLLoader(gateway.ReplaceComponents(replacements), "HEAD");
+    url_loader->SetTimeoutDuration(kProbeTimeout);
+    auto iter =
+        url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
+    iter->get()->DownloadHeadersOnly(
+        url_loader_factory_.get(),
+        base::BindOnce(&IpfsGatewayRacer::OnProbeComplete,
+                       weak_ptr_factory_.GetWeakPtr(), iter, gateway,
+                       base::TimeTicks::Now()));
+  }
+}
+
+void IpfsGatewayRacer::OnProbeComplete(
+    SimpleURLLoaderList::iterator iter,
+    const GURL& gateway,
+    base::TimeTicks start_time,
+    scoped_refptr<net::HttpResponseHeaders> headers) {
+  int error_code = iter->get()->NetError();
+  int response_code = headers ? headers->response_code() : -1;
+  url_loaders_.erase(iter);
+
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success) {
+    VLOG(1) << "Gateway probe failed for " << gateway
+            << ", error_code = " << error_code
+            << " response_code = " << response_code;
+  }
+  RecordProbe(gateway, success, base::TimeTicks::Now() - start_time);
+}
+
+void IpfsGatewayRacer::RecordProbe(const GURL& gateway,
+                                   bool success,
+                                   base::TimeDelta latency) {
+  GatewayScore& score = scores_[gateway];
+  score.healthy = success;
+  if (success) {
+    score.latency = score.latency.is_zero()
+                        ? latency
+                        : score.latency * (1 - kLatencySampleWeight) +
+                              latency * kLatencySampleWeight;
+    base::UmaHistogramMediumTimes("Brave.IPFS.GatewayProbeTime", latency);
+  }
+  SelectFastestGateway();
+}
+
+void IpfsGatewayRacer::SelectFastestGateway() {
+  const GatewayScore* current = nullptr;
+  auto current_it = scores_.find(fastest_gateway_);
+  if (current_it != scores_.end() && current_it->second.healthy)
+    current = &current_it->second;
+
+  const GURL* best = nullptr;
+  base::TimeDelta best_latency;
+  for (const auto& entry : scores_) {
+    if (!entry.second.healthy)
+      continue;
+    if (!best || entry.second.latency < best_latency) {
+      best = &entry.first;
+      best_latency = entry.second.latency;
+    }
+  }
+
+  if (!best) {
+    fastest_gateway_ = GURL();
+    return;
+  }
+  if (current && best_latency > current->latency * kSwitchThreshold)
+    return;
+  fastest_gateway_ = *best;
+}
+
+}  // namespace ipfs
@@ -0,0 +1,91 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IPFS_GATEWAY_RACER_H_
+#define BRAVE_COMPONENTS_IPFS_IPFS_GATEWAY_RACER_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/gtest_prod_util.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "url/gurl.h"
+
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+class PrefService;
+
+namespace ipfs {
+
+// Periodically sends HEAD probes to a set of public gateways while
+// kIPFSGatewayRacingEnabled is set, keeps a rolling latency score for each
+// of them and reports the fastest healthy one. The configured public gateway
+// is always one of the candidates.
+class IpfsGatewayRacer {
+ public:
+  IpfsGatewayRacer(
+      PrefService* prefs,
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+  ~IpfsGatewayRacer();
+  IpfsGatewayRacer(const IpfsGatewayRacer&) = delete;
+  IpfsGatewayRacer& operator=(const IpfsGatewayRacer&) = delete;
+
+  // Returns the gateway requests should be routed to, or an empty GURL when
+  // racing is disabled or no probe has succeeded yet.
+  GURL GetFastestGateway() const;
+
+  // Sends one round of probes to every candidate gateway.
+  void ProbeGateways();
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(IpfsGatewayRacerTest, PicksFastestHealthyGateway);
+  FRIEND_TEST_ALL_PREFIXES(IpfsGatewayRacerTest, KeepsCurrentGatewayWhenClose);
+
+  using SimpleURLLoaderList =
+      std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  struct GatewayScore {
+    // Exponentially weighted moving average of the probe latency.
+    base::TimeDelta latency;
+    bool healthy = false;
+  };
+
+  void OnRacingPrefChanged();
+  std::vector<GURL> GetCandidates() const;
+  void OnProbeComplete(SimpleURLLoaderList::iterator iter,
+                       const GURL& gateway,
+                       base::TimeTicks start_time,
+                       scoped_refptr<net::HttpResponseHeaders> headers);
+  void RecordProbe(const GURL& gateway, bool success, base::TimeDelta latency);
+  void SelectFastestGateway();
+
+  PrefService* prefs_ = nullptr;
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  PrefChangeRegistrar pref_change_registrar_;
+  base::RepeatingTimer probe_timer_;
+  SimpleURLLoaderList url_loaders_;
+  base::flat_map<GURL, GatewayScore> scores_;
+  GURL fastest_gateway_;
+
+  base::WeakPtrFactory<IpfsGatewayRacer> weak_ptr_factory_{this};
+};
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IPFS_GATEWAY_RACER_H_
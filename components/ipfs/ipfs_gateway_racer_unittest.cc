@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/ipfs_gateway_racer.h"
+
+#include <memory>
+
+#include "base/test/task_environment.h"
+#include "brave/components/ipfs/ipfs_service.h"
+#include "brave/components/ipfs/pref_names.h"
+#include "components/prefs/testing_pref_service.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ipfs {
+
+class IpfsGatewayRacerTest : public testing::Test {
+ public:
+  IpfsGatewayRacerTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+  void SetUp() override {
+    IpfsService::RegisterProfilePrefs(pref_service_.registry());
+    racer_ = std::make_unique<IpfsGatewayRacer>(&pref_service_,
+                                                shared_url_loader_factory_);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  TestingPrefServiceSimple pref_service_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  std::unique_ptr<IpfsGatewayRacer> racer_;
+};
+
+TEST_F(IpfsGatewayRacerTest, PicksFastestHealthyGateway) {
+  EXPECT_EQ(url_loader_factory_.NumPending(), 0);
+  pref_service_.SetBoolean(kIPFSGatewayRacingEnabled, true);
+  EXPECT_GT(url_loader_factory_.NumPending(), 0);
+  EXPECT_TRUE(racer_->GetFastestGateway().is_empty());
+
+  const GURL a("https://a.example");
+  const GURL b("https://b.example");
+  const GURL c("https://c.example");
+  racer_->RecordProbe(a, true, base::TimeDelta::FromMilliseconds(300));
+  EXPECT_EQ(racer_->GetFastestGateway(), a);
+  racer_->RecordProbe(b, true, base::TimeDelta::FromMilliseconds(100));
+  racer_->RecordProbe(c, false, base::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(racer_->GetFastestGateway(), b);
+
+  // An unhealthy gateway is dropped until it answers again.
+  racer_->RecordProbe(b, false, base::TimeDelta());
+  EXPECT_EQ(racer_->GetFastestGateway(), a);
+  racer_->RecordProbe(a, false, base::TimeDelta());
+  EXPECT_TRUE(racer_->GetFastestGateway().is_empty());
+
+  racer_->RecordProbe(c, true, base::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(racer_->GetFastestGateway(), c);
+  pref_service_.SetBoolean(kIPFSGatewayRacingEnabled, false);
+  EXPECT_TRUE(racer_->GetFastestGateway().is_empty());
+}
+
+TEST_F(IpfsGatewayRacerTest, KeepsCurrentGatewayWhenClose) {
+  pref_service_.SetBoolean(kIPFSGatewayRacingEnabled, true);
+
+  const GURL a("https://a.example");
+  const GURL b("https://b.example");
+  racer_->RecordProbe(a, true, base::TimeDelta::FromMilliseconds(100));
+  racer_->RecordProbe(b, true, base::TimeDelta::FromMilliseconds(90));
+  EXPECT_EQ(racer_->GetFastestGateway(), a);
+
+  // 90 * 0.7 + 10 * 0.3 = 66ms, clearly faster than a.
+  racer_->RecordProbe(b, true, base::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(racer_->GetFastestGateway(), b);
+}
+
+}  // namespace ipfs
@@ -10,6 +10,7 @@
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
 #include "base/rand_util.h"
@@ -82,9 +83,12 @@ class ReentrancyCheck {
 const int kMinimalPeersRetryIntervalMs = 350;
 const int kPeersRetryRate = 3;
 
-const char kGatewayValidationCID[] = "bafkqae2xmvwgg33nmuqhi3zajfiemuzahiwss";
 const char kGatewayValidationResult[] = "Welcome to IPFS :-)";
 
+// `repo stat` walks the whole datastore, so brave://ipfs polling is answered
+// from memory and the node is asked again at most this often.
+constexpr base::TimeDelta kRepoStatsMaxAge = base::TimeDelta::FromSeconds(10);
+
 std::pair<bool, std::string> LoadConfigFileOnFileTaskRunner(
     const base::FilePath& path) {
   std::string data;
@@ -119,6 +123,7 @@ IpfsService::IpfsService(
           {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       ipfs_p3a_(this, prefs),
+      gateway_racer_(prefs, url_loader_factory),
       weak_factory_(this) {
   DCHECK(!user_data_dir.empty());
 
@@ -158,6 +163,8 @@ void IpfsService::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   registry->RegisterIntegerPref(kIPFSInfobarCount, 0);
   registry->RegisterIntegerPref(kIpfsStorageMax, 1);
   registry->RegisterStringPref(kIPFSPublicGatewayAddress, kDefaultIPFSGateway);
+  registry->RegisterBooleanPref(kIPFSGatewayRacingEnabled, false);
+  registry->RegisterIntegerPref(kIPFSIdleShutdownMinutes, 0);
   registry->RegisterFilePathPref(kIPFSBinaryPath, base::FilePath());
 }
 
@@ -177,6 +184,10 @@ void IpfsService::OnExecutableReady(const base::FilePath& path) {
 
   prefs_->SetFilePath(kIPFSBinaryPath, path);
 
+  // With an idle shutdown configured the daemon is only started on demand,
+  // unless something is already waiting for it.
+  if (!GetIdleShutdownDelay().is_zero() && pending_launch_callbacks_.empty())
+    return;
   LaunchIfNotRunning(path);
 }
 
@@ -271,10 +282,17 @@ void IpfsService::NotifyDaemonLaunched(bool result, int64_t pid) {
 void IpfsService::OnIpfsLaunched(bool result, int64_t pid) {
   if (result) {
     ipfs_pid_ = pid;
+    if (!launch_start_time_.is_null()) {
+      base::UmaHistogramMediumTimes(
+          "Brave.IPFS.DaemonColdStartTime",
+          base::TimeTicks::Now() - launch_start_time_);
+    }
+    ResetIdleShutdownTimer();
   } else {
     VLOG(0) << "Failed to launch IPFS";
     Shutdown();
   }
+  launch_start_time_ = base::TimeTicks();
   RegisterIpfsClientUpdater();
   NotifyDaemonLaunched(result, pid);
 }
@@ -285,6 +303,14 @@ void IpfsService::Shutdown() {
   }
   ipfs_service_.reset();
   ipfs_pid_ = -1;
+  idle_shutdown_timer_.Stop();
+  ClearNodeCache();
+}
+
+void IpfsService::ClearNodeCache() {
+  addresses_config_.reset();
+  node_info_.reset();
+  repo_stats_.reset();
 }
 
 #if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
@@ -483,6 +509,8 @@ void IpfsService::OnImportFinished(ipfs::ImportCompletedCallback callback,
     std::move(callback).Run(data);
 
   importers_.erase(key);
+  repo_stats_time_ = base::TimeTicks();
+  ResetIdleShutdownTimer();
 }
 #endif
 void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
@@ -492,6 +520,7 @@ void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
       std::move(callback).Run(false, std::vector<std::string>{});
     return;
   }
+  ResetIdleShutdownTimer();
 
   if (skip_get_connected_peers_callback_for_test_) {
     // Early return for tests that wish to  manually run the callback with
@@ -563,6 +592,10 @@ void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
     std::move(callback).Run(false, AddressesConfig());
     return;
   }
+  if (addresses_config_) {
+    std::move(callback).Run(true, *addresses_config_);
+    return;
+  }
 
   GURL gurl = net::AppendQueryParameter(server_endpoint_.Resolve(kConfigPath),
                                         kArgQueryParam, kAddressesField);
@@ -596,6 +629,8 @@ void IpfsService::OnGetAddressesConfig(
 
   bool success = IPFSJSONParser::GetAddressesConfigFromJSON(*response_body,
                                                             &addresses_config);
+  if (success)
+    addresses_config_ = addresses_config;
   std::move(callback).Run(success, addresses_config);
 }
 
@@ -637,6 +672,7 @@ void IpfsService::LaunchDaemon(BoolCallback callback) {
   }
   if (callback)
     pending_launch_callbacks_.push(std::move(callback));
+  launch_start_time_ = base::TimeTicks::Now();
   base::FilePath path(GetIpfsExecutablePath());
   if (path.empty()) {
     // Daemon will be launched later in OnExecutableReady.
@@ -659,6 +695,31 @@ void IpfsService::ShutdownDaemon(BoolCallback callback) {
     std::move(callback).Run(!IsDaemonLaunched());
 }
 
+base::TimeDelta IpfsService::GetIdleShutdownDelay() const {
+  return base::TimeDelta::FromMinutes(
+      prefs_->GetInteger(kIPFSIdleShutdownMinutes));
+}
+
+void IpfsService::ResetIdleShutdownTimer() {
+  const base::TimeDelta delay = GetIdleShutdownDelay();
+  if (delay <= base::TimeDelta() || !IsDaemonLaunched()) {
+    idle_shutdown_timer_.Stop();
+    return;
+  }
+  idle_shutdown_timer_.Start(FROM_HERE, delay, this,
+                             &IpfsService::OnIdleShutdownTimer);
+}
+
+void IpfsService::OnIdleShutdownTimer() {
+#if BUILDFLAG(ENABLE_IPFS_LOCAL_NODE)
+  // Imports report back through OnImportFinished, which restarts the timer.
+  if (!importers_.empty())
+    return;
+#endif
+  VLOG(1) << "Stopping idle IPFS daemon";
+  ShutdownDaemon(base::NullCallback());
+}
+
 void IpfsService::GetConfig(GetConfigCallback callback) {
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
@@ -705,6 +766,7 @@ void IpfsService::SetAllowIpfsLaunchForTest(bool launched) {
 
 void IpfsService::SetServerEndpointForTest(const GURL& gurl) {
   server_endpoint_ = gurl;
+  ClearNodeCache();
 }
 
 void IpfsService::RunLaunchDaemonCallbackForTest(bool result) {
@@ -733,6 +795,18 @@ void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
     std::move(callback).Run(false, RepoStats());
     return;
   }
+  bool notify_observers = false;
+  if (repo_stats_) {
+    std::move(callback).Run(true, *repo_stats_);
+    if (base::TimeTicks::Now() - repo_stats_time_ < kRepoStatsMaxAge)
+      return;
+    notify_observers = true;
+  } else {
+    pending_repo_stats_callbacks_.push_back(std::move(callback));
+  }
+  if (repo_stats_fetching_)
+    return;
+  repo_stats_fetching_ = true;
 
   GURL gurl =
       net::AppendQueryParameter(server_endpoint_.Resolve(ipfs::kRepoStatsPath),
@@ -744,11 +818,11 @@ void IpfsService::GetRepoStats(GetRepoStatsCallback callback) {
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnRepoStats, base::Unretained(this), iter,
-                     std::move(callback)));
+                     notify_observers));
 }
 
 void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
-                              GetRepoStatsCallback callback,
+                              bool notify_observers,
                               std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
   int error_code = url_loader->NetError();
@@ -756,18 +830,31 @@ void IpfsService::OnRepoStats(SimpleURLLoaderList::iterator iter,
   if (url_loader->ResponseInfo() && url_loader->ResponseInfo()->headers)
     response_code = url_loader->ResponseInfo()->headers->response_code();
   url_loaders_.erase(iter);
+  repo_stats_fetching_ = false;
 
   ipfs::RepoStats repo_stats;
-  if (error_code != net::OK || response_code != net::HTTP_OK) {
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (!success) {
     VLOG(1) << "Fail to get repro stats, error_code = " << error_code
             << " response_code = " << response_code;
-    std::move(callback).Run(false, repo_stats);
-    return;
+  } else {
+    success =
+        IPFSJSONParser::GetRepoStatsFromJSON(*response_body, &repo_stats);
+  }
+  // The daemon may have been shut down while the request was running.
+  if (success && IsDaemonLaunched()) {
+    repo_stats_ = repo_stats;
+    repo_stats_time_ = base::TimeTicks::Now();
+    if (notify_observers) {
+      for (auto& observer : observers_)
+        observer.OnRepoStatsUpdated(repo_stats);
+    }
   }
 
-  bool success =
-      IPFSJSONParser::GetRepoStatsFromJSON(*response_body, &repo_stats);
-  std::move(callback).Run(success, repo_stats);
+  std::vector<GetRepoStatsCallback> callbacks;
+  callbacks.swap(pending_repo_stats_callbacks_);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, repo_stats);
 }
 
 void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
@@ -775,6 +862,10 @@ void IpfsService::GetNodeInfo(GetNodeInfoCallback callback) {
     std::move(callback).Run(false, NodeInfo());
     return;
   }
+  if (node_info_) {
+    std::move(callback).Run(true, *node_info_);
+    return;
+  }
 
   GURL gurl = server_endpoint_.Resolve(ipfs::kNodeInfoPath);
   auto url_loader = CreateURLLoader(gurl, "POST");
@@ -806,6 +897,8 @@ void IpfsService::OnNodeInfo(SimpleURLLoaderList::iterator iter,
 
   bool success =
       IPFSJSONParser::GetNodeInfoFromJSON(*response_body, &node_info);
+  if (success)
+    node_info_ = node_info;
   std::move(callback).Run(success, node_info);
 }
 
@@ -849,6 +942,7 @@ void IpfsService::OnGarbageCollection(
     if (!body.empty())
       IPFSJSONParser::GetGarbageCollectionFromJSON(body, &error);
   }
+  repo_stats_time_ = base::TimeTicks();
   std::move(callback).Run(success && error.empty(), error);
 }
 
@@ -884,6 +978,14 @@ void IpfsService::ValidateGateway(const GURL& url, BoolCallback callback) {
                      std::move(callback), url));
 }
 
+GURL IpfsService::GetPreferredGateway() const {
+  if (!prefs_->GetBoolean(kIPFSGatewayRacingEnabled))
+    return GURL();
+  if (IsDaemonLaunched())
+    return GetDefaultIPFSLocalGateway(channel_);
+  return gateway_racer_.GetFastestGateway();
+}
+
 void IpfsService::OnGatewayValidationComplete(
     SimpleURLLoaderList::iterator iter,
     BoolCallback callback,
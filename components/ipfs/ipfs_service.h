@@ -16,12 +16,15 @@
 #include "base/containers/queue.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/ipfs/addresses_config.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/brave_ipfs_client_updater.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
 #include "brave/components/ipfs/import/imported_data.h"
 #include "brave/components/ipfs/ipfs_constants.h"
+#include "brave/components/ipfs/ipfs_gateway_racer.h"
 #include "brave/components/ipfs/ipfs_p3a.h"
 #include "brave/components/ipfs/node_info.h"
 #include "brave/components/ipfs/repo_stats.h"
@@ -29,6 +32,7 @@
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/version_info/channel.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace base {
@@ -101,6 +105,10 @@ class IpfsService : public KeyedService,
   void RestartDaemon();
   void RotateKey(const std::string& oldkey, BoolCallback callback);
   void ValidateGateway(const GURL& url, BoolCallback callback);
+  // Returns the gateway picked by gateway racing: the local node while it is
+  // running, otherwise the fastest healthy public gateway. Returns an empty
+  // GURL when racing is disabled or nothing has been measured yet.
+  GURL GetPreferredGateway() const;
 
   virtual void PreWarmShareableLink(const GURL& url);
 
@@ -193,8 +201,10 @@ class IpfsService : public KeyedService,
                             GetAddressesConfigCallback callback,
                             std::unique_ptr<std::string> response_body);
   void OnRepoStats(SimpleURLLoaderList::iterator iter,
-                   GetRepoStatsCallback callback,
+                   bool notify_observers,
                    std::unique_ptr<std::string> response_body);
+  // Drops cached daemon answers, e.g. when the daemon goes away.
+  void ClearNodeCache();
   void OnNodeInfo(SimpleURLLoaderList::iterator iter,
                   GetNodeInfoCallback callback,
                   std::unique_ptr<std::string> response_body);
@@ -204,6 +214,10 @@ class IpfsService : public KeyedService,
   void OnPreWarmComplete(SimpleURLLoaderList::iterator iter,
                          std::unique_ptr<std::string> response_body);
   std::string GetStorageSize();
+  base::TimeDelta GetIdleShutdownDelay() const;
+  // Restarts the idle shutdown countdown, if one is configured.
+  void ResetIdleShutdownTimer();
+  void OnIdleShutdownTimer();
   // The remote to the ipfs service running on an utility process. The browser
   // will not launch a new ipfs service process if this remote is already
   // bound.
@@ -218,6 +232,20 @@ class IpfsService : public KeyedService,
   BlobContextGetterFactoryPtr blob_context_getter_factory_;
 
   base::queue<BoolCallback> pending_launch_callbacks_;
+  // Set while a launch requested through LaunchDaemon is in progress.
+  base::TimeTicks launch_start_time_;
+  base::OneShotTimer idle_shutdown_timer_;
+
+  // Daemon answers that only change when it restarts.
+  absl::optional<AddressesConfig> addresses_config_;
+  absl::optional<NodeInfo> node_info_;
+  // Repo stats are served from here and refreshed in the background once
+  // they are older than kRepoStatsMaxAge. Callers that arrive while a fetch
+  // is running wait for it instead of starting another one.
+  absl::optional<RepoStats> repo_stats_;
+  base::TimeTicks repo_stats_time_;
+  bool repo_stats_fetching_ = false;
+  std::vector<GetRepoStatsCallback> pending_repo_stats_callbacks_;
 
   bool allow_ipfs_launch_for_test_ = false;
   bool skip_get_connected_peers_callback_for_test_ = false;
@@ -239,6 +267,7 @@ class IpfsService : public KeyedService,
 #endif
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   IpfsP3A ipfs_p3a_;
+  IpfsGatewayRacer gateway_racer_;
   base::WeakPtrFactory<IpfsService> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(IpfsService);
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/observer_list_types.h"
+#include "brave/components/ipfs/repo_stats.h"
 #include "components/component_updater/component_updater_service.h"
 
 namespace ipfs {
@@ -25,6 +26,8 @@ class IpfsServiceObserver : public base::CheckedObserver {
   virtual void OnGetConnectedPeers(bool succes,
                                    const std::vector<std::string>& peers) {}
   virtual void OnIpnsKeysLoaded(bool success) {}
+  // Called when stats served from the cache were refreshed in the background.
+  virtual void OnRepoStatsUpdated(const RepoStats& stats) {}
 };
 
 }  // namespace ipfs
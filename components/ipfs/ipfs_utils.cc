@@ -127,7 +127,11 @@ bool HasIPFSPath(const GURL& gurl) {
 
 bool IsDefaultGatewayURL(const GURL& url, PrefService* prefs) {
   DCHECK(prefs);
-  std::string gateway_host = GetDefaultIPFSGateway(prefs).host();
+  return IsGatewayURL(url, GetDefaultIPFSGateway(prefs));
+}
+
+bool IsGatewayURL(const GURL& url, const GURL& gateway_url) {
+  std::string gateway_host = gateway_url.host();
   return url.DomainIs(gateway_host) &&
          (HasIPFSPath(url) ||
           url.DomainIs(std::string("ipfs.") + gateway_host) ||
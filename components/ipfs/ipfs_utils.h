@@ -21,6 +21,7 @@ bool IsIpfsDisabledByPolicy(PrefService* prefs);
 bool IsValidCID(const std::string& cid);
 bool HasIPFSPath(const GURL& url);
 bool IsDefaultGatewayURL(const GURL& url, PrefService* prefs);
+bool IsGatewayURL(const GURL& url, const GURL& gateway_url);
 bool IsLocalGatewayURL(const GURL& url);
 bool IsIPFSScheme(const GURL& url);
 // Extracts cid and path from ipfs URLs like:
@@ -38,3 +38,12 @@ const char kIPFSEnabled[] = "brave.ipfs.enabled";
 
 // Stores IPFS public gateway address to be used when translating IPFS URLs.
 const char kIPFSPublicGatewayAddress[] = "brave.ipfs.public_gateway_address";
+
+// Used to route gateway requests to whichever public gateway currently
+// answers fastest instead of always using kIPFSPublicGatewayAddress.
+const char kIPFSGatewayRacingEnabled[] = "brave.ipfs.gateway_racing_enabled";
+
+// Minutes without local node activity after which the daemon is stopped.
+// When set, the daemon is also no longer started with the browser but on
+// first use. 0 keeps it running for the whole session.
+const char kIPFSIdleShutdownMinutes[] = "brave.ipfs.idle_shutdown_minutes";
@@ -14,6 +14,8 @@ extern const char kIPFSAutoRedirectDNSLink[];
 extern const char kIPFSInfobarCount[];
 extern const char kIPFSEnabled[];
 extern const char kIPFSPublicGatewayAddress[];
+extern const char kIPFSGatewayRacingEnabled[];
+extern const char kIPFSIdleShutdownMinutes[];
 extern const char kIpfsStorageMax[];
 
 #endif  // BRAVE_COMPONENTS_IPFS_PREF_NAMES_H_
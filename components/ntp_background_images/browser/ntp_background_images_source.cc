@@ -32,6 +32,10 @@ absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
   return contents;
 }
 
+// Sponsored wallpapers are around 1MB each, so this keeps the current and
+// next wallpaper with their logos without growing unbounded.
+constexpr size_t kMaxImageCacheBytes = 4 * 1024 * 1024;
+
 bool IsSuperReferralPath(const std::string& path) {
   return path.rfind(kSuperReferralPath, 0) == 0;
 }
@@ -41,6 +45,7 @@ bool IsSuperReferralPath(const std::string& path) {
 NTPBackgroundImagesSource::NTPBackgroundImagesSource(
     NTPBackgroundImagesService* service)
     : service_(service),
+      image_cache_(ImageCache::NO_AUTO_EVICT),
       weak_factory_(this) {
 }
 
@@ -69,7 +74,8 @@ void NTPBackgroundImagesSource::StartDataRequest(
     return;
   }
 
-  auto* images_data = service_->GetBrandedImagesData(IsSuperReferralPath(path));
+  const bool is_super_referral = IsSuperReferralPath(path);
+  auto* images_data = service_->GetBrandedImagesData(is_super_referral);
 
   if (!images_data) {
     content::GetUIThreadTaskRunner({})->PostTask(
@@ -89,33 +95,96 @@ void NTPBackgroundImagesSource::StartDataRequest(
     }
   } else {
     DCHECK(IsWallpaperPath(path));
-    image_file_path =
-        images_data->backgrounds[GetWallpaperIndexFromPath(path)].image_file;
+    const int index = GetWallpaperIndexFromPath(path);
+    image_file_path = images_data->backgrounds[index].image_file;
+    GetImageFile(image_file_path, std::move(callback));
+    // Wallpapers are shown in order, so warm up the one for the next tab.
+    PreloadNextWallpaper(is_super_referral, index);
+    return;
   }
 
   GetImageFile(image_file_path, std::move(callback));
 }
 
+void NTPBackgroundImagesSource::PreloadNextWallpaper(bool super_referral,
+                                                     int index) {
+  auto* images_data = service_->GetBrandedImagesData(super_referral);
+  if (!images_data || images_data->backgrounds.size() < 2)
+    return;
+
+  const auto& next =
+      images_data->backgrounds[(index + 1) % images_data->backgrounds.size()];
+  PreloadImageFile(next.image_file);
+  if (next.logo)
+    PreloadImageFile(next.logo->image_file);
+}
+
+void NTPBackgroundImagesSource::PreloadImageFile(
+    const base::FilePath& image_file_path) {
+  if (image_cache_.Peek(image_file_path) != image_cache_.end())
+    return;
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::BEST_EFFORT},
+      base::BindOnce(&ReadFileToString, image_file_path),
+      base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     GotDataCallback()));
+}
+
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  auto it = image_cache_.Get(image_file_path);
+  if (it != image_cache_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
       base::BindOnce(&ReadFileToString, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_factory_.GetWeakPtr(), image_file_path,
+                     std::move(callback)));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
+    const base::FilePath& image_file_path,
     GotDataCallback callback,
     absl::optional<std::string> input) {
-  if (!input)
+  if (!input) {
+    if (callback)
+      std::move(callback).Run(nullptr);
     return;
+  }
+
+  scoped_refptr<base::RefCountedMemory> bytes =
+      base::RefCountedString::TakeString(&*input);
+  CacheImage(image_file_path, bytes);
+  if (callback)
+    std::move(callback).Run(std::move(bytes));
+}
 
-  scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+void NTPBackgroundImagesSource::CacheImage(
+    const base::FilePath& image_file_path,
+    scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes->size() > kMaxImageCacheBytes)
+    return;
+
+  auto it = image_cache_.Peek(image_file_path);
+  if (it != image_cache_.end()) {
+    image_cache_bytes_ -= it->second->size();
+    image_cache_.Erase(it);
+  }
+
+  image_cache_bytes_ += bytes->size();
+  image_cache_.Put(image_file_path, std::move(bytes));
+  while (image_cache_bytes_ > kMaxImageCacheBytes) {
+    auto oldest = image_cache_.rbegin();
+    image_cache_bytes_ -= oldest->second->size();
+    image_cache_.Erase(oldest);
+  }
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
@@ -8,19 +8,20 @@
 
 #include <string>
 
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/url_data_source.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
-
 namespace ntp_background_images {
 
 class NTPBackgroundImagesService;
 
-// This serves background image data.
+// This serves background image data. Recently served images and the ones
+// likely to be shown next are kept in a small in-memory cache so that a new
+// tab doesn't have to wait for the file to be read.
 class NTPBackgroundImagesSource : public content::URLDataSource {
  public:
   explicit NTPBackgroundImagesSource(NTPBackgroundImagesService* service);
@@ -35,6 +36,11 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
+                           ImageCacheIsBounded);
+
+  using ImageCache =
+      base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>;
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -46,8 +52,14 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
 
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      GotDataCallback callback,
                       absl::optional<std::string> input);
+  // Reads the wallpaper following |index| and its logo into |image_cache_|.
+  void PreloadNextWallpaper(bool super_referral, int index);
+  void PreloadImageFile(const base::FilePath& image_file_path);
+  void CacheImage(const base::FilePath& image_file_path,
+                  scoped_refptr<base::RefCountedMemory> bytes);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsDefaultLogoPath(const std::string& path) const;
@@ -58,6 +70,8 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   base::FilePath GetTopSiteFaviconFilePath(const std::string& path) const;
 
   NTPBackgroundImagesService* service_;  // not owned
+  ImageCache image_cache_;
+  size_t image_cache_bytes_ = 0;
   base::WeakPtrFactory<NTPBackgroundImagesSource> weak_factory_;
 };
 
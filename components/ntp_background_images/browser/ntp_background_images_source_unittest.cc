@@ -6,6 +6,8 @@
 #include <memory>
 #include <string>
 
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
@@ -144,4 +146,29 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicSuperReferralDataTest) {
 
 #endif  // ENABLE_BRAVE_REFERRALS
 
+TEST_F(NTPBackgroundImagesSourceTest, ImageCacheIsBounded) {
+  auto make_image = [](size_t size) {
+    std::string data(size, 'x');
+    return base::RefCountedString::TakeString(&data);
+  };
+  const base::FilePath first(FILE_PATH_LITERAL("wallpaper-0.jpg"));
+  const base::FilePath second(FILE_PATH_LITERAL("wallpaper-1.jpg"));
+  const base::FilePath third(FILE_PATH_LITERAL("wallpaper-2.jpg"));
+  const size_t image_size = 1536 * 1024;
+
+  source_->CacheImage(first, make_image(image_size));
+  source_->CacheImage(second, make_image(image_size));
+  EXPECT_EQ(2u, source_->image_cache_.size());
+
+  // Adding a third image goes over the limit and drops the oldest one.
+  source_->CacheImage(third, make_image(image_size));
+  EXPECT_EQ(2u, source_->image_cache_.size());
+  EXPECT_EQ(source_->image_cache_.end(), source_->image_cache_.Peek(first));
+  EXPECT_EQ(2 * image_size, source_->image_cache_bytes_);
+
+  // Images larger than the whole cache are never kept.
+  source_->CacheImage(first, make_image(8 * 1024 * 1024));
+  EXPECT_EQ(source_->image_cache_.end(), source_->image_cache_.Peek(first));
+}
+
 }  // namespace ntp_background_images
@@ -90,11 +90,19 @@ ViewCounterService::ViewCounterService(NTPBackgroundImagesService* service,
   pref_change_registrar_.Add(prefs::kNewTabPageSuperReferralThemesOption,
       base::BindRepeating(&ViewCounterService::OnPreferenceChanged,
       base::Unretained(this)));
+  pref_change_registrar_.Add(prefs::kNewTabPageShowBackgroundImage,
+      base::BindRepeating(&ViewCounterService::OnPreferenceChanged,
+      base::Unretained(this)));
+  pref_change_registrar_.Add(
+      prefs::kNewTabPageShowSponsoredImagesBackgroundImage,
+      base::BindRepeating(&ViewCounterService::OnPreferenceChanged,
+      base::Unretained(this)));
 
   OnUpdated(GetCurrentBrandedWallpaperData());
 #if BUILDFLAG(ENABLE_NTP_BACKGROUND_IMAGES)
   OnUpdated(GetCurrentWallpaperData());
 #endif
+  UpdateWallpaperForDisplay();
 }
 
 ViewCounterService::~ViewCounterService() = default;
@@ -132,6 +140,14 @@ NTPSponsoredImagesData* ViewCounterService::GetCurrentBrandedWallpaperData()
 }
 
 base::Value ViewCounterService::GetCurrentWallpaperForDisplay() const {
+  return wallpaper_for_display_.Clone();
+}
+
+void ViewCounterService::UpdateWallpaperForDisplay() {
+  wallpaper_for_display_ = ComputeWallpaperForDisplay();
+}
+
+base::Value ViewCounterService::ComputeWallpaperForDisplay() const {
   if (ShouldShowBrandedWallpaper()) {
     return GetCurrentBrandedWallpaper();
   } else {
@@ -145,7 +161,9 @@ base::Value ViewCounterService::GetCurrentWallpaperForDisplay() const {
 
 #if BUILDFLAG(ENABLE_NTP_BACKGROUND_IMAGES)
 base::Value ViewCounterService::GetCurrentWallpaper() const {
-  if (IsBackgroundWallpaperActive()) {
+  // The wallpaper is now computed ahead of time, possibly before background
+  // images data has been loaded.
+  if (IsBackgroundWallpaperActive() && GetCurrentWallpaperData()) {
     return GetCurrentWallpaperData()->GetBackgroundAt(
         model_.current_wallpaper_image_index());
   }
@@ -195,6 +213,7 @@ void ViewCounterService::OnUpdated(NTPBackgroundImagesData* data) {
     model_.ResetCurrentWallpaperImageIndex();
     model_.set_total_image_count(data->backgrounds.size());
   }
+  UpdateWallpaperForDisplay();
 }
 #endif
 
@@ -219,6 +238,7 @@ void ViewCounterService::OnUpdated(NTPSponsoredImagesData* data) {
     model_.set_total_branded_image_count(data->backgrounds.size());
     model_.set_ignore_count_to_branded_wallpaper(data->IsSuperReferral());
   }
+  UpdateWallpaperForDisplay();
 }
 
 void ViewCounterService::OnSuperReferralEnded() {
@@ -239,6 +259,7 @@ void ViewCounterService::ResetModel() {
   if (auto* data = GetCurrentWallpaperData())
     model_.set_total_image_count(data->backgrounds.size());
 #endif
+  UpdateWallpaperForDisplay();
 }
 
 void ViewCounterService::OnPreferenceChanged(const std::string& pref_name) {
@@ -248,8 +269,11 @@ void ViewCounterService::OnPreferenceChanged(const std::string& pref_name) {
     return;
   }
 
-  // Other prefs changes are used for notification state.
-  ResetNotificationState();
+  // Ads prefs changes are used for notification state.
+  if (pref_name == ads::prefs::kEnabled)
+    ResetNotificationState();
+
+  UpdateWallpaperForDisplay();
 }
 
 void ViewCounterService::ResetNotificationState() {
@@ -266,6 +290,9 @@ void ViewCounterService::RegisterPageView() {
   if (IsBrandedWallpaperActive()) {
     model_.RegisterPageView();
   }
+
+  // Decide on the next tab's wallpaper now rather than when it asks for it.
+  UpdateWallpaperForDisplay();
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
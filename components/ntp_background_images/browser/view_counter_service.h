@@ -63,6 +63,8 @@ class ViewCounterService : public KeyedService,
                                    const std::string& destination_url,
                                    const std::string& wallpaper_id);
 
+  // Returns the wallpaper precomputed for the next New Tab Page, so the page
+  // can get its background without evaluating the current data and prefs.
   base::Value GetCurrentWallpaperForDisplay() const;
 #if BUILDFLAG(ENABLE_NTP_BACKGROUND_IMAGES)
   base::Value GetCurrentWallpaper() const;
@@ -108,6 +110,8 @@ class ViewCounterService : public KeyedService,
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
                            ActiveOptedInWithNTPBackgoundOption);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest, ModelTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
+                           WallpaperForDisplayIsPrecomputed);
 #if BUILDFLAG(ENABLE_NTP_BACKGROUND_IMAGES)
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesViewCounterTest,
                            BINotActiveInitially);
@@ -145,6 +149,11 @@ class ViewCounterService : public KeyedService,
 
   void ResetModel();
 
+  // Recomputes |wallpaper_for_display_| from the model, data and prefs. Called
+  // whenever any of them changes.
+  void UpdateWallpaperForDisplay();
+  base::Value ComputeWallpaperForDisplay() const;
+
   void UpdateP3AValues() const;
 
   NTPBackgroundImagesService* service_ = nullptr;  // not owned
@@ -153,6 +162,7 @@ class ViewCounterService : public KeyedService,
   bool is_supported_locale_ = false;
   PrefChangeRegistrar pref_change_registrar_;
   ViewCounterModel model_;
+  base::Value wallpaper_for_display_;
 
   // If P3A is enabled, these will track number of tabs created
   // and the ratio of those which are branded images.
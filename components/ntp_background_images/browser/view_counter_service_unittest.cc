@@ -15,6 +15,7 @@
 #include "brave/components/ntp_background_images/browser/features.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/ntp_sponsored_images_data.h"
+#include "brave/components/ntp_background_images/browser/url_constants.h"
 #include "brave/components/ntp_background_images/browser/view_counter_model.h"
 #include "brave/components/ntp_background_images/browser/view_counter_service.h"
 #include "brave/components/ntp_background_images/buildflags/buildflags.h"
@@ -217,6 +218,25 @@ TEST_F(NTPBackgroundImagesViewCounterTest, ActiveInitiallyOptedIn) {
   EXPECT_TRUE(view_counter_->IsBrandedWallpaperActive());
 }
 
+TEST_F(NTPBackgroundImagesViewCounterTest, WallpaperForDisplayIsPrecomputed) {
+  auto is_sponsored = [](const base::Value& data) {
+    return data.is_dict() &&
+           data.FindBoolKey(kIsSponsoredKey).value_or(false);
+  };
+  service_->si_images_data_ = GetDemoBrandedWallpaper(false);
+  view_counter_->OnUpdated(service_->si_images_data_.get());
+  // The first tab never shows a sponsored image.
+  EXPECT_FALSE(is_sponsored(view_counter_->GetCurrentWallpaperForDisplay()));
+
+  // The decision for the next tab is made when the page view is registered.
+  view_counter_->RegisterPageView();
+  EXPECT_TRUE(is_sponsored(view_counter_->GetCurrentWallpaperForDisplay()));
+
+  // Opting out drops the precomputed sponsored image right away.
+  EnableSIPref(false);
+  EXPECT_FALSE(is_sponsored(view_counter_->GetCurrentWallpaperForDisplay()));
+}
+
 #if !defined(OS_LINUX)
 // Super referral feature is disabled on linux.
 TEST_F(NTPBackgroundImagesViewCounterTest, ModelTest) {
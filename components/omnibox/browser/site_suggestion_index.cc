@@ -0,0 +1,77 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_suggestion_index.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/strings/string_util.h"
+
+SiteSuggestionIndex::SiteSuggestionIndex(std::vector<std::string> sites,
+                                         bool index_substrings)
+    : sites_(std::move(sites)) {
+  for (size_t site = 0; site < sites_.size(); ++site) {
+    const size_t suffix_count = index_substrings ? sites_[site].size() : 1;
+    for (size_t offset = 0; offset < suffix_count; ++offset)
+      entries_.push_back({site, offset});
+  }
+  std::sort(entries_.begin(), entries_.end(),
+            [this](const Entry& a, const Entry& b) {
+              return GetSuffix(a) < GetSuffix(b);
+            });
+}
+
+SiteSuggestionIndex::~SiteSuggestionIndex() = default;
+
+base::StringPiece SiteSuggestionIndex::GetSuffix(const Entry& entry) const {
+  return base::StringPiece(sites_[entry.site]).substr(entry.offset);
+}
+
+std::pair<std::vector<SiteSuggestionIndex::Entry>::const_iterator,
+          std::vector<SiteSuggestionIndex::Entry>::const_iterator>
+SiteSuggestionIndex::EqualRange(base::StringPiece text) const {
+  auto begin = std::lower_bound(entries_.begin(), entries_.end(), text,
+                                [this](const Entry& entry,
+                                       base::StringPiece value) {
+                                  return GetSuffix(entry) < value;
+                                });
+  // Suffixes starting with |text| sort right after it and next to each other.
+  auto end = std::partition_point(begin, entries_.end(),
+                                  [this, text](const Entry& entry) {
+                                    return base::StartsWith(GetSuffix(entry),
+                                                            text);
+                                  });
+  return {begin, end};
+}
+
+std::vector<size_t> SiteSuggestionIndex::FindPrefix(
+    base::StringPiece prefix) const {
+  auto range = EqualRange(prefix);
+  std::vector<size_t> result;
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->offset == 0)
+      result.push_back(it->site);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<std::pair<size_t, size_t>> SiteSuggestionIndex::FindSubstring(
+    base::StringPiece text) const {
+  auto range = EqualRange(text);
+  std::vector<std::pair<size_t, size_t>> result;
+  for (auto it = range.first; it != range.second; ++it)
+    result.emplace_back(it->site, it->offset);
+  // Sorted by site then offset, so the first entry of each site is the one
+  // to keep.
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end(),
+                           [](const auto& a, const auto& b) {
+                             return a.first == b.first;
+                           }),
+               result.end());
+  return result;
+}
@@ -0,0 +1,53 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_SUGGESTION_INDEX_H_
+#define BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_SUGGESTION_INDEX_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+
+// A sorted index over a fixed list of sites, built once, so that providers
+// look up the sites matching each keystroke with a binary search rather than
+// comparing the input against every site. Results are indices into the list,
+// in list order.
+class SiteSuggestionIndex {
+ public:
+  // With |index_substrings|, every suffix of every site is indexed too, so
+  // that FindSubstring can be used.
+  SiteSuggestionIndex(std::vector<std::string> sites, bool index_substrings);
+  ~SiteSuggestionIndex();
+  SiteSuggestionIndex(const SiteSuggestionIndex&) = delete;
+  SiteSuggestionIndex& operator=(const SiteSuggestionIndex&) = delete;
+
+  // Sites that start with |prefix|.
+  std::vector<size_t> FindPrefix(base::StringPiece prefix) const;
+
+  // Sites that contain |text|, each with the position of the first
+  // occurrence, as std::string::find would give it.
+  std::vector<std::pair<size_t, size_t>> FindSubstring(
+      base::StringPiece text) const;
+
+ private:
+  struct Entry {
+    size_t site;
+    size_t offset;
+  };
+
+  base::StringPiece GetSuffix(const Entry& entry) const;
+  // The entries whose suffix starts with |text|.
+  std::pair<std::vector<Entry>::const_iterator,
+            std::vector<Entry>::const_iterator>
+  EqualRange(base::StringPiece text) const;
+
+  const std::vector<std::string> sites_;
+  // Sorted by suffix.
+  std::vector<Entry> entries_;
+};
+
+#endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_SUGGESTION_INDEX_H_
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_suggestion_index.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<std::string> GetSites() {
+  return {"google.com", "gmail.com",  "mail.google.com",
+          "amazon.com", "amazon.ca", "go.com"};
+}
+
+// What a scan with std::string::find gives, for comparison.
+std::vector<std::pair<size_t, size_t>> FindByScan(const std::string& text) {
+  const std::vector<std::string> sites = GetSites();
+  std::vector<std::pair<size_t, size_t>> result;
+  for (size_t i = 0; i < sites.size(); ++i) {
+    size_t pos = sites[i].find(text);
+    if (pos != std::string::npos)
+      result.emplace_back(i, pos);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(SiteSuggestionIndexTest, FindPrefix) {
+  SiteSuggestionIndex index(GetSites(), false);
+  EXPECT_EQ(index.FindPrefix("g"), (std::vector<size_t>{0, 1, 5}));
+  EXPECT_EQ(index.FindPrefix("go"), (std::vector<size_t>{0, 5}));
+  EXPECT_EQ(index.FindPrefix("amazon.c"), (std::vector<size_t>{3, 4}));
+  EXPECT_EQ(index.FindPrefix("mail.google.com"), (std::vector<size_t>{2}));
+  EXPECT_TRUE(index.FindPrefix("oogle").empty());
+  EXPECT_TRUE(index.FindPrefix("mail.google.com.").empty());
+}
+
+TEST(SiteSuggestionIndexTest, FindSubstringMatchesScan) {
+  SiteSuggestionIndex index(GetSites(), true);
+  for (const char* text : {"g", "o", "oogle", "mail", ".c", "com", "amazon.ca",
+                           "a", "x", "google.com.", "m"}) {
+    EXPECT_EQ(index.FindSubstring(text), FindByScan(text)) << text;
+  }
+}
@@ -5,12 +5,15 @@
 
 #include "brave/components/omnibox/browser/suggested_sites_provider.h"
 
-#include <algorithm>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/omnibox/browser/site_suggestion_index.h"
 #include "components/omnibox/browser/autocomplete_input.h"
 #include "components/omnibox/browser/autocomplete_provider_client.h"
 #include "components/prefs/pref_service.h"
@@ -41,32 +44,37 @@ void SuggestedSitesProvider::Start(const AutocompleteInput& input,
 
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
-  auto check_add_match =
-      [&](const SuggestedSitesMatch& match) {
-    // Don't bother matching until 4 chars, or less if it's an exact match
+  const auto& suggested_sites = GetSuggestedSites();
+  for (size_t i : GetSuggestedSitesIndex().FindPrefix(input_text)) {
+    const SuggestedSitesMatch& match = suggested_sites[i];
+    // Don't bother matching until 4 chars, or less if it's an exact match.
+    // Only prefixes match, since we want only people that really want these
+    // suggestions. Example don't suggest bitcoin and litecoin for just a coin
+    // search.
     if (input_text.length() < 4 &&
         match.match_string_.length() != input_text.length()) {
-      return;
-    }
-    size_t foundPos = match.match_string_.find(input_text);
-    // We'd normally check for npos here but we want only people that
-    // really want these suggestions. Example don't suggest bitcoin and
-    // litecoin for just a coin search.
-    if (foundPos == 0) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text,
-              base::UTF16ToASCII(match.display_));
-      AddMatch(match, styles);
+      continue;
     }
-  };
-
-  const auto& suggested_sites = GetSuggestedSites();
-  std::for_each(suggested_sites.begin(), suggested_sites.end(),
-      check_add_match);
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, base::UTF16ToASCII(match.display_));
+    AddMatch(match, styles);
+  }
 }
 
 SuggestedSitesProvider::~SuggestedSitesProvider() {}
 
+const SiteSuggestionIndex& SuggestedSitesProvider::GetSuggestedSitesIndex() {
+  static const base::NoDestructor<SiteSuggestionIndex> index(
+      [this]() {
+        std::vector<std::string> match_strings;
+        for (const auto& match : GetSuggestedSites())
+          match_strings.push_back(match.match_string_);
+        return match_strings;
+      }(),
+      false);
+  return *index;
+}
+
 // static
 ACMatchClassifications SuggestedSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
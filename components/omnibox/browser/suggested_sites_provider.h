@@ -16,6 +16,7 @@
 #include "components/omnibox/browser/autocomplete_provider.h"
 
 class AutocompleteProviderClient;
+class SiteSuggestionIndex;
 
 // This is the provider for Brave Suggested Sites
 class SuggestedSitesProvider : public AutocompleteProvider {
@@ -31,6 +32,8 @@ class SuggestedSitesProvider : public AutocompleteProvider {
   static const int kRelevance;
 
   const std::vector<SuggestedSitesMatch>& GetSuggestedSites();
+  // Built from the match strings of GetSuggestedSites() on first use.
+  const SiteSuggestionIndex& GetSuggestedSitesIndex();
   void AddMatch(const SuggestedSitesMatch& match,
                 const ACMatchClassifications& styles);
 
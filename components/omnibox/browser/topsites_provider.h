@@ -15,6 +15,7 @@
 #include "components/omnibox/browser/autocomplete_provider.h"
 
 class AutocompleteProviderClient;
+class SiteSuggestionIndex;
 
 // This is the provider for top Alexa 500 sites URLs
 class TopSitesProvider : public AutocompleteProvider {
@@ -31,6 +32,9 @@ class TopSitesProvider : public AutocompleteProvider {
 
   static std::vector<std::string> top_sites_;
 
+  // Built from |top_sites_| on first use.
+  static const SiteSuggestionIndex& GetTopSitesIndex();
+
   void AddMatch(const std::u16string& match_string,
                 const ACMatchClassifications& styles);
 
@@ -51,6 +51,11 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
+  // Nothing to persist if the bucket did not change.
+  auto it = log_.find(histogram_name);
+  if (it != log_.end() && it->second.value == value)
+    return;
+
   LogEntry& entry = log_[histogram_name];
   entry.value = value;
   if (!entry.sent) {
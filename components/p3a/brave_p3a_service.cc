@@ -55,6 +55,10 @@ constexpr char kP2AServerUrl[] = "https://p2a.brave.com/";
 
 constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
+// How long histogram changes are collected before they go to the log store.
+constexpr base::TimeDelta kHistogramFlushDelay =
+    base::TimeDelta::FromSeconds(5);
+
 // TODO(iefremov): Provide moar histograms!
 // Whitelist for histograms that we collect. Will be replaced with something
 // updating on the fly.
@@ -384,9 +388,9 @@ void BraveP3AService::UpdatePyxisMeta() {
 void BraveP3AService::StartScheduledUpload() {
   VLOG(2) << "BraveP3AService::StartScheduledUpload at " << base::Time::Now();
   if (!log_store_->has_unsent_logs()) {
-    // We continue to schedule next uploads since new histogram values can
-    // come up at any moment. Maybe it's worth to add a method with more
-    // appropriate name for this situation.
+    // Everything is sent, stop waking up until HandleHistogramChange() or
+    // DoRotation() produce something new to send.
+    upload_scheduler_->Stop();
     upload_scheduler_->UploadFinished(true);
     // Nothing to stage.
     VLOG(2) << "StartScheduledUpload - Nothing to stage.";
@@ -420,12 +424,7 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
-    base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                   base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this,
-                                  histogram_name,
-                                  kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+    QueueHistogramValue(histogram_name, kSuspendedMetricBucket);
     return;
   }
 
@@ -454,21 +453,40 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
   }
 
-  base::PostTask(FROM_HERE, {content::BrowserThread::UI},
-                 base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  QueueHistogramValue(histogram_name, bucket);
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
-  if (!initialized_) {
-    // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+void BraveP3AService::QueueHistogramValue(const char* histogram_name,
+                                          size_t bucket) {
+  {
+    base::AutoLock lock(pending_values_lock_);
+    pending_values_[histogram_name] = bucket;
+    if (flush_scheduled_)
+      return;
+    flush_scheduled_ = true;
+  }
+  base::PostDelayedTask(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&BraveP3AService::FlushHistogramValues, this),
+      kHistogramFlushDelay);
+}
+
+void BraveP3AService::FlushHistogramValues() {
+  base::flat_map<base::StringPiece, size_t> values;
+  {
+    base::AutoLock lock(pending_values_lock_);
+    values.swap(pending_values_);
+    flush_scheduled_ = false;
+  }
+  for (const auto& entry : values) {
+    VLOG(2) << "BraveP3AService::FlushHistogramValues: histogram_name = "
+            << entry.first << " bucket = " << entry.second;
+    if (!initialized_) {
+      // Will handle it later when ready.
+      histogram_values_[entry.first] = entry.second;
+    } else {
+      HandleHistogramChange(entry.first, entry.second);
+    }
   }
 }
 
@@ -479,6 +497,13 @@ void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
     return;
   }
   log_store_->UpdateValue(std::string(histogram_name), bucket);
+  MaybeResumeUploads();
+}
+
+void BraveP3AService::MaybeResumeUploads() {
+  // The scheduler does not exist yet while Init() replays early values.
+  if (upload_scheduler_ && log_store_->has_unsent_logs())
+    upload_scheduler_->Start();
 }
 
 void BraveP3AService::OnLogUploadComplete(int response_code,
@@ -501,6 +526,7 @@ void BraveP3AService::OnLogUploadComplete(int response_code,
 void BraveP3AService::DoRotation() {
   VLOG(2) << "BraveP3AService doing rotation at " << base::Time::Now();
   log_store_->ResetUploadStamps();
+  MaybeResumeUploads();
   UpdateRotationTimer();
 
   local_state_->SetTime(kLastRotationTimeStampPref, base::Time::Now());
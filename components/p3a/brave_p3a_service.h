@@ -14,6 +14,8 @@
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -72,20 +74,26 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method only queues the new bucket and
+  // leaves the rest to FlushHistogramValues() on the UI thread.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  void QueueHistogramValue(const char* histogram_name, size_t bucket);
+
+  // Moves the queued buckets into the log store.
+  void FlushHistogramValues();
 
   // Updates or removes a metric from the log.
   void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
+  // Restarts the upload scheduler, which stops itself once everything has
+  // been sent, if there is something new to send.
+  void MaybeResumeUploads();
+
   // Restart the uploading process (i.e. mark all values as unsent).
   void DoRotation();
 
@@ -116,6 +124,14 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Latest bucket of each histogram recorded since the last flush. Hot
+  // histograms are recorded many times in a row, only the last value of a
+  // burst reaches the log store and prefs.
+  base::Lock pending_values_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_values_
+      GUARDED_BY(pending_values_lock_);
+  bool flush_scheduled_ GUARDED_BY(pending_values_lock_) = false;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/metrics/histogram_macros.h"
 #include "net/base/load_flags.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
@@ -103,6 +104,7 @@ void BraveP3AUploader::UploadLog(const std::string& compressed_log_data,
   std::string base64;
   base::Base64Encode(compressed_log_data, &base64);
   url_loader_->AttachStringForUpload(base64, "application/base64");
+  upload_start_time_ = base::TimeTicks::Now();
 
   url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
@@ -120,6 +122,8 @@ void BraveP3AUploader::OnUploadComplete(
 
   bool was_https = url_loader_->GetFinalURL().SchemeIs(url::kHttpsScheme);
   url_loader_.reset();
+  UMA_HISTOGRAM_MEDIUM_TIMES("Brave.P3A.UploadTime",
+                             base::TimeTicks::Now() - upload_start_time_);
   on_upload_complete_.Run(response_code, error_code, was_https);
 }
 
@@ -11,6 +11,7 @@
 
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -44,6 +45,7 @@ class BraveP3AUploader {
   const GURL p2a_endpoint_;
   const UploadCallback on_upload_complete_;
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
+  base::TimeTicks upload_start_time_;
   DISALLOW_COPY_AND_ASSIGN(BraveP3AUploader);
 };
 
@@ -0,0 +1,154 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/periodic_task_scheduler/periodic_task_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
+#include "base/power_monitor/power_monitor.h"
+#include "base/rand_util.h"
+#include "base/timer/elapsed_timer.h"
+
+namespace {
+
+// How late, as a fraction of its period, a task may run.
+constexpr double kSlackFraction = 0.2;
+constexpr double kBatterySlackFraction = 0.5;
+// Upper bound of the random delay added to the first run.
+constexpr double kJitterFraction = 0.1;
+
+}  // namespace
+
+PeriodicTaskScheduler::Registration::Registration(
+    base::WeakPtr<PeriodicTaskScheduler> scheduler,
+    int id)
+    : scheduler_(std::move(scheduler)), id_(id) {}
+
+PeriodicTaskScheduler::Registration::~Registration() {
+  if (scheduler_)
+    scheduler_->Unregister(id_);
+}
+
+PeriodicTaskScheduler::Task::Task() = default;
+PeriodicTaskScheduler::Task::Task(Task&&) = default;
+PeriodicTaskScheduler::Task& PeriodicTaskScheduler::Task::operator=(Task&&) =
+    default;
+PeriodicTaskScheduler::Task::~Task() = default;
+
+PeriodicTaskScheduler::PeriodicTaskScheduler() {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+PeriodicTaskScheduler::~PeriodicTaskScheduler() = default;
+
+// static
+PeriodicTaskScheduler* PeriodicTaskScheduler::GetInstance() {
+  static base::NoDestructor<PeriodicTaskScheduler> instance;
+  return instance.get();
+}
+
+std::unique_ptr<PeriodicTaskScheduler::Registration>
+PeriodicTaskScheduler::Register(const std::string& name,
+                                base::TimeDelta period,
+                                base::RepeatingClosure task) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_GT(period, base::TimeDelta());
+
+  Task entry;
+  entry.name = name;
+  entry.period = period;
+  entry.callback = std::move(task);
+  entry.next_run = base::TimeTicks::Now() + period;
+  if (jitter_)
+    entry.next_run += period * (base::RandDouble() * kJitterFraction);
+
+  const int id = next_id_++;
+  tasks_[id] = std::move(entry);
+  ScheduleWakeup();
+  return base::WrapUnique(
+      new Registration(weak_ptr_factory_.GetWeakPtr(), id));
+}
+
+base::Value PeriodicTaskScheduler::GetTasksInfo() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::Value list(base::Value::Type::LIST);
+  for (const auto& entry : tasks_) {
+    const Task& task = entry.second;
+    base::Value info(base::Value::Type::DICTIONARY);
+    info.SetStringKey("name", task.name);
+    info.SetDoubleKey("period", task.period.InSecondsF());
+    info.SetDoubleKey("nextRun", (task.next_run - now).InSecondsF());
+    info.SetIntKey("runCount", task.run_count);
+    info.SetDoubleKey("totalRunTime", task.total_run_time.InMillisecondsF());
+    list.Append(std::move(info));
+  }
+  return list;
+}
+
+void PeriodicTaskScheduler::Unregister(int id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  tasks_.erase(id);
+  ScheduleWakeup();
+}
+
+base::TimeDelta PeriodicTaskScheduler::GetSlack(const Task& task) const {
+  const bool on_battery = base::PowerMonitor::IsInitialized() &&
+                          base::PowerMonitor::IsOnBatteryPower();
+  return task.period * (on_battery ? kBatterySlackFraction : kSlackFraction);
+}
+
+void PeriodicTaskScheduler::ScheduleWakeup() {
+  timer_.Stop();
+  if (tasks_.empty()) {
+    // A stopped timer may be restarted on another sequence, and so may the
+    // scheduler, e.g. across unit tests.
+    DETACH_FROM_SEQUENCE(sequence_checker_);
+    return;
+  }
+
+  // Wake up as late as every task allows. Everything due by then runs.
+  base::TimeTicks wakeup = base::TimeTicks::Max();
+  for (const auto& entry : tasks_)
+    wakeup = std::min(wakeup, entry.second.next_run + GetSlack(entry.second));
+  timer_.Start(FROM_HERE,
+               std::max(wakeup - base::TimeTicks::Now(), base::TimeDelta()),
+               base::BindOnce(&PeriodicTaskScheduler::OnWakeup,
+                              base::Unretained(this)));
+}
+
+void PeriodicTaskScheduler::OnWakeup() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<int> due;
+  for (const auto& entry : tasks_) {
+    if (entry.second.next_run <= now)
+      due.push_back(entry.first);
+  }
+
+  auto weak_this = weak_ptr_factory_.GetWeakPtr();
+  for (int id : due) {
+    // A task may unregister itself or others while running.
+    auto it = tasks_.find(id);
+    if (it == tasks_.end())
+      continue;
+    it->second.next_run = now + it->second.period;
+    it->second.run_count++;
+    base::RepeatingClosure callback = it->second.callback;
+    base::ElapsedTimer run_timer;
+    callback.Run();
+    if (!weak_this)
+      return;
+    it = tasks_.find(id);
+    if (it != tasks_.end())
+      it->second.total_run_time += run_timer.Elapsed();
+  }
+  ScheduleWakeup();
+}
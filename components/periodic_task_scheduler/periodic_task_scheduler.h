@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_PERIODIC_TASK_SCHEDULER_PERIODIC_TASK_SCHEDULER_H_
+#define BRAVE_COMPONENTS_PERIODIC_TASK_SCHEDULER_PERIODIC_TASK_SCHEDULER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "base/values.h"
+
+// Runs low-frequency periodic background tasks from one timer, so that they
+// share wakeups instead of each waking the process on its own schedule.
+//
+// A task may run late by a fraction of its period (more on battery power),
+// which lets the scheduler wait for the latest deadline it can and run every
+// task that is due at that point. A task never runs early. The first run is
+// jittered so that clients don't all run in step.
+//
+// Use GetInstance() on the UI thread. Tests may create their own instance.
+class PeriodicTaskScheduler {
+ public:
+  // Unregisters the task when destroyed.
+  class Registration {
+   public:
+    ~Registration();
+    Registration(const Registration&) = delete;
+    Registration& operator=(const Registration&) = delete;
+
+   private:
+    friend class PeriodicTaskScheduler;
+    Registration(base::WeakPtr<PeriodicTaskScheduler> scheduler, int id);
+
+    base::WeakPtr<PeriodicTaskScheduler> scheduler_;
+    const int id_;
+  };
+
+  PeriodicTaskScheduler();
+  ~PeriodicTaskScheduler();
+  PeriodicTaskScheduler(const PeriodicTaskScheduler&) = delete;
+  PeriodicTaskScheduler& operator=(const PeriodicTaskScheduler&) = delete;
+
+  static PeriodicTaskScheduler* GetInstance();
+
+  // Runs |task| about every |period| until the returned registration is
+  // destroyed. |name| identifies the task in GetTasksInfo().
+  std::unique_ptr<Registration> Register(const std::string& name,
+                                         base::TimeDelta period,
+                                         base::RepeatingClosure task);
+
+  // A list with one dictionary per task: name, period and time to the next
+  // run in seconds, run count and total run time in milliseconds. For
+  // internals pages.
+  base::Value GetTasksInfo() const;
+
+  void set_jitter_for_testing(bool jitter) { jitter_ = jitter; }
+
+ private:
+  struct Task {
+    Task();
+    Task(Task&&);
+    Task& operator=(Task&&);
+    ~Task();
+
+    std::string name;
+    base::TimeDelta period;
+    base::RepeatingClosure callback;
+    base::TimeTicks next_run;
+    int run_count = 0;
+    base::TimeDelta total_run_time;
+  };
+
+  void Unregister(int id);
+  base::TimeDelta GetSlack(const Task& task) const;
+  void ScheduleWakeup();
+  void OnWakeup();
+
+  base::flat_map<int, Task> tasks_;
+  int next_id_ = 1;
+  bool jitter_ = true;
+  base::OneShotTimer timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<PeriodicTaskScheduler> weak_ptr_factory_{this};
+};
+
+#endif  // BRAVE_COMPONENTS_PERIODIC_TASK_SCHEDULER_PERIODIC_TASK_SCHEDULER_H_
@@ -0,0 +1,71 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/periodic_task_scheduler/periodic_task_scheduler.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PeriodicTaskSchedulerTest : public testing::Test {
+ public:
+  PeriodicTaskSchedulerTest() { scheduler_.set_jitter_for_testing(false); }
+
+ protected:
+  std::unique_ptr<PeriodicTaskScheduler::Registration> Register(
+      base::TimeDelta period,
+      int* runs) {
+    return scheduler_.Register(
+        "test", period,
+        base::BindRepeating([](int* runs) { (*runs)++; }, runs));
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  PeriodicTaskScheduler scheduler_;
+};
+
+TEST_F(PeriodicTaskSchedulerTest, RunsWithinSlack) {
+  int runs = 0;
+  auto registration = Register(base::TimeDelta::FromMinutes(10), &runs);
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(9));
+  EXPECT_EQ(runs, 0);
+  // Runs at most 20% late.
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(3));
+  EXPECT_EQ(runs, 1);
+
+  registration.reset();
+  task_environment_.FastForwardBy(base::TimeDelta::FromHours(1));
+  EXPECT_EQ(runs, 1);
+}
+
+TEST_F(PeriodicTaskSchedulerTest, CoalescesWakeups) {
+  int short_runs = 0;
+  int long_runs = 0;
+  auto short_task = Register(base::TimeDelta::FromMinutes(5), &short_runs);
+  auto long_task = Register(base::TimeDelta::FromMinutes(6), &long_runs);
+
+  // The 5 minute task may wait until 6 minutes, when the other one is due,
+  // so both run in the same wakeup.
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(6));
+  EXPECT_EQ(short_runs, 1);
+  EXPECT_EQ(long_runs, 1);
+  EXPECT_EQ(task_environment_.GetPendingMainThreadTaskCount(), 1u);
+}
+
+TEST_F(PeriodicTaskSchedulerTest, ReportsTasks) {
+  int runs = 0;
+  auto registration = Register(base::TimeDelta::FromMinutes(10), &runs);
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(12));
+
+  base::Value info = scheduler_.GetTasksInfo();
+  ASSERT_EQ(info.GetList().size(), 1u);
+  EXPECT_EQ(*info.GetList()[0].FindStringKey("name"), "test");
+  EXPECT_EQ(info.GetList()[0].FindIntKey("runCount"), 1);
+  EXPECT_EQ(info.GetList()[0].FindDoubleKey("period"), 600);
+}
@@ -10,9 +10,19 @@
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 
 namespace bat_ads {
 
+namespace {
+
+// Fetched browsing history is refreshed this often, so that visits drop out
+// once they are more than |days_ago| days old or beyond |max_count|.
+constexpr base::TimeDelta kBrowsingHistoryRefreshInterval =
+    base::TimeDelta::FromHours(1);
+
+}  // namespace
+
 BatAdsClientMojoBridge::BatAdsClientMojoBridge(
     mojo::PendingAssociatedRemote<mojom::BatAdsClient> client_info) {
   bat_ads_client_.Bind(std::move(client_info));
@@ -20,6 +30,39 @@ BatAdsClientMojoBridge::BatAdsClientMojoBridge(
 
 BatAdsClientMojoBridge::~BatAdsClientMojoBridge() = default;
 
+void BatAdsClientMojoBridge::OnPrefValueChanged(const std::string& path,
+                                                base::Value value) {
+  CachePref(path, std::move(value));
+}
+
+void BatAdsClientMojoBridge::SetIsForeground(const bool is_foreground) {
+  is_foreground_ = is_foreground;
+}
+
+void BatAdsClientMojoBridge::SetAdEventHistory(
+    const std::map<std::string, std::vector<double>>& history) {
+  ad_event_history_.SetAll(history);
+}
+
+void BatAdsClientMojoBridge::OnBrowsingHistoryVisited(const std::string& url) {
+  if (!browsing_history_callbacks_.empty()) {
+    browsing_history_visited_while_fetching_.insert(url);
+  }
+
+  if (!browsing_history_fetched_at_.is_null()) {
+    browsing_history_.insert(url);
+  }
+}
+
+void BatAdsClientMojoBridge::OnBrowsingHistoryDeleted() {
+  if (!browsing_history_callbacks_.empty()) {
+    browsing_history_deleted_while_fetching_ = true;
+  }
+
+  browsing_history_.clear();
+  browsing_history_fetched_at_ = base::Time();
+}
+
 bool BatAdsClientMojoBridge::CanShowBackgroundNotifications() const {
   if (!connected())
     return false;
@@ -40,12 +83,17 @@ bool BatAdsClientMojoBridge::IsNetworkConnectionAvailable() const {
 }
 
 bool BatAdsClientMojoBridge::IsForeground() const {
+  if (is_foreground_) {
+    return *is_foreground_;
+  }
+
   if (!connected()) {
     return false;
   }
 
   bool is_foreground;
   bat_ads_client_->IsForeground(&is_foreground);
+  is_foreground_ = is_foreground;
   return is_foreground;
 }
 
@@ -90,6 +138,8 @@ void BatAdsClientMojoBridge::CloseNotification(
 void BatAdsClientMojoBridge::RecordAdEvent(const std::string& ad_type,
                                            const std::string& confirmation_type,
                                            const double timestamp) const {
+  ad_event_history_.Record(ad_type, confirmation_type, timestamp);
+
   if (!connected()) {
     return;
   }
@@ -100,16 +150,12 @@ void BatAdsClientMojoBridge::RecordAdEvent(const std::string& ad_type,
 std::vector<double> BatAdsClientMojoBridge::GetAdEvents(
     const std::string& ad_type,
     const std::string& confirmation_type) const {
-  if (!connected()) {
-    return {};
-  }
-
-  std::vector<double> ad_events;
-  bat_ads_client_->GetAdEvents(ad_type, confirmation_type, &ad_events);
-  return ad_events;
+  return ad_event_history_.Get(ad_type, confirmation_type);
 }
 
 void BatAdsClientMojoBridge::ResetAdEvents() const {
+  ad_event_history_.Reset();
+
   if (!connected()) {
     return;
   }
@@ -167,8 +213,9 @@ void BatAdsClientMojoBridge::Save(
 
 void OnLoadAdsResource(const ads::LoadCallback& callback,
                        const bool success,
-                       const std::string& value) {
-  callback(success, value);
+                       mojo_base::BigBuffer value) {
+  callback(success, std::string(reinterpret_cast<const char*>(value.data()),
+                                value.size()));
 }
 
 void BatAdsClientMojoBridge::LoadAdsResource(const std::string& id,
@@ -197,9 +244,59 @@ void BatAdsClientMojoBridge::GetBrowsingHistory(
     return;
   }
 
+  const bool is_same_window = max_count == browsing_history_max_count_ &&
+                              days_ago == browsing_history_days_ago_;
+
+  if (is_same_window && !browsing_history_fetched_at_.is_null() &&
+      base::Time::Now() - browsing_history_fetched_at_ <
+          kBrowsingHistoryRefreshInterval) {
+    callback(std::vector<std::string>(browsing_history_.begin(),
+                                      browsing_history_.end()));
+    return;
+  }
+
+  if (!browsing_history_callbacks_.empty()) {
+    if (is_same_window) {
+      browsing_history_callbacks_.push_back(std::move(callback));
+      return;
+    }
+
+    // Only one window is kept, so other windows are fetched as they used to.
+    bat_ads_client_->GetBrowsingHistory(
+        max_count, days_ago,
+        base::BindOnce(&OnGetBrowsingHistory, std::move(callback)));
+    return;
+  }
+
+  browsing_history_.clear();
+  browsing_history_max_count_ = max_count;
+  browsing_history_days_ago_ = days_ago;
+  browsing_history_fetched_at_ = base::Time();
+
+  browsing_history_callbacks_.push_back(std::move(callback));
   bat_ads_client_->GetBrowsingHistory(
       max_count, days_ago,
-      base::BindOnce(&OnGetBrowsingHistory, std::move(callback)));
+      base::BindOnce(&BatAdsClientMojoBridge::OnBrowsingHistoryFetched,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void BatAdsClientMojoBridge::OnBrowsingHistoryFetched(
+    const std::vector<std::string>& history) {
+  if (!browsing_history_deleted_while_fetching_) {
+    browsing_history_.insert(history.begin(), history.end());
+    browsing_history_.insert(browsing_history_visited_while_fetching_.begin(),
+                             browsing_history_visited_while_fetching_.end());
+    browsing_history_fetched_at_ = base::Time::Now();
+  }
+
+  browsing_history_visited_while_fetching_.clear();
+  browsing_history_deleted_while_fetching_ = false;
+
+  std::vector<ads::GetBrowsingHistoryCallback> callbacks;
+  callbacks.swap(browsing_history_callbacks_);
+  for (const auto& callback : callbacks) {
+    callback(history);
+  }
 }
 
 void BatAdsClientMojoBridge::RecordP2AEvent(const std::string& name,
@@ -231,13 +328,20 @@ void BatAdsClientMojoBridge::Load(
 
 std::string BatAdsClientMojoBridge::LoadResourceForId(
     const std::string& id) {
+  const auto iter = resources_for_id_.find(id);
+  if (iter != resources_for_id_.end()) {
+    return iter->second;
+  }
+
   std::string value;
 
   if (!connected()) {
     return value;
   }
 
-  bat_ads_client_->LoadResourceForId(id, &value);
+  if (bat_ads_client_->LoadResourceForId(id, &value) && !value.empty()) {
+    resources_for_id_[id] = value;
+  }
   return value;
 }
 
@@ -303,6 +407,11 @@ void BatAdsClientMojoBridge::Log(
 
 bool BatAdsClientMojoBridge::GetBooleanPref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_bool()) {
+    return cached_value->GetBool();
+  }
+
   bool value = false;
 
   if (!connected()) {
@@ -310,6 +419,7 @@ bool BatAdsClientMojoBridge::GetBooleanPref(
   }
 
   bat_ads_client_->GetBooleanPref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -320,11 +430,17 @@ void BatAdsClientMojoBridge::SetBooleanPref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetBooleanPref(path, value);
 }
 
 int BatAdsClientMojoBridge::GetIntegerPref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_int()) {
+    return cached_value->GetInt();
+  }
+
   int value = 0;
 
   if (!connected()) {
@@ -332,6 +448,7 @@ int BatAdsClientMojoBridge::GetIntegerPref(
   }
 
   bat_ads_client_->GetIntegerPref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -342,11 +459,17 @@ void BatAdsClientMojoBridge::SetIntegerPref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetIntegerPref(path, value);
 }
 
 double BatAdsClientMojoBridge::GetDoublePref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && (cached_value->is_double() || cached_value->is_int())) {
+    return cached_value->GetDouble();
+  }
+
   double value = 0.0;
 
   if (!connected()) {
@@ -354,6 +477,7 @@ double BatAdsClientMojoBridge::GetDoublePref(
   }
 
   bat_ads_client_->GetDoublePref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -364,11 +488,17 @@ void BatAdsClientMojoBridge::SetDoublePref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetDoublePref(path, value);
 }
 
 std::string BatAdsClientMojoBridge::GetStringPref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_string()) {
+    return cached_value->GetString();
+  }
+
   std::string value;
 
   if (!connected()) {
@@ -376,6 +506,7 @@ std::string BatAdsClientMojoBridge::GetStringPref(
   }
 
   bat_ads_client_->GetStringPref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -386,11 +517,20 @@ void BatAdsClientMojoBridge::SetStringPref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetStringPref(path, value);
 }
 
 int64_t BatAdsClientMojoBridge::GetInt64Pref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_string()) {
+    int64_t value = 0;
+    if (base::StringToInt64(cached_value->GetString(), &value)) {
+      return value;
+    }
+  }
+
   int64_t value = 0;
 
   if (!connected()) {
@@ -398,6 +538,7 @@ int64_t BatAdsClientMojoBridge::GetInt64Pref(
   }
 
   bat_ads_client_->GetInt64Pref(path, &value);
+  CachePref(path, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -408,11 +549,20 @@ void BatAdsClientMojoBridge::SetInt64Pref(
     return;
   }
 
+  CachePref(path, base::Value(base::NumberToString(value)));
   bat_ads_client_->SetInt64Pref(path, value);
 }
 
 uint64_t BatAdsClientMojoBridge::GetUint64Pref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_string()) {
+    uint64_t value = 0;
+    if (base::StringToUint64(cached_value->GetString(), &value)) {
+      return value;
+    }
+  }
+
   uint64_t value = 0;
 
   if (!connected()) {
@@ -420,6 +570,7 @@ uint64_t BatAdsClientMojoBridge::GetUint64Pref(
   }
 
   bat_ads_client_->GetUint64Pref(path, &value);
+  CachePref(path, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -430,6 +581,7 @@ void BatAdsClientMojoBridge::SetUint64Pref(
     return;
   }
 
+  CachePref(path, base::Value(base::NumberToString(value)));
   bat_ads_client_->SetUint64Pref(path, value);
 }
 
@@ -439,6 +591,8 @@ void BatAdsClientMojoBridge::ClearPref(
     return;
   }
 
+  // Only the browser knows the default value, so read it again next time.
+  prefs_.erase(path);
   bat_ads_client_->ClearPref(path);
 }
 
@@ -448,4 +602,19 @@ bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+const base::Value* BatAdsClientMojoBridge::GetCachedPref(
+    const std::string& path) const {
+  const auto iter = prefs_.find(path);
+  if (iter == prefs_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void BatAdsClientMojoBridge::CachePref(const std::string& path,
+                                       base::Value value) const {
+  prefs_[path] = std::move(value);
+}
+
 }  // namespace bat_ads
@@ -7,14 +7,22 @@
 #define BRAVE_COMPONENTS_SERVICES_BAT_ADS_BAT_ADS_CLIENT_MOJO_BRIDGE_H_
 
 #include <cstdint>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "bat/ads/ad_event_history.h"
 #include "bat/ads/ad_notification_info.h"
 #include "bat/ads/ads_client.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/values.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "mojo/public/cpp/base/big_buffer.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace bat_ads {
 
@@ -29,6 +37,20 @@ class BatAdsClientMojoBridge
   BatAdsClientMojoBridge(const BatAdsClientMojoBridge&) = delete;
   BatAdsClientMojoBridge& operator=(const BatAdsClientMojoBridge&) = delete;
 
+  // Prefs and foreground state are read from the browser once and then kept
+  // up to date by the browser, which pushes changes through these.
+  void OnPrefValueChanged(const std::string& path, base::Value value);
+  void SetIsForeground(const bool is_foreground);
+
+  // Ad events are kept here once the browser has handed over its history, and
+  // only written through to the browser so they outlive this process.
+  void SetAdEventHistory(
+      const std::map<std::string, std::vector<double>>& history);
+
+  // Keep the browsing history last fetched by GetBrowsingHistory up to date.
+  void OnBrowsingHistoryVisited(const std::string& url);
+  void OnBrowsingHistoryDeleted();
+
   // AdsClient implementation
   bool CanShowBackgroundNotifications() const override;
 
@@ -142,7 +164,40 @@ class BatAdsClientMojoBridge
  private:
   bool connected() const;
 
+  // Returns the mirrored value of |path|, or null if it hasn't been read yet.
+  const base::Value* GetCachedPref(const std::string& path) const;
+  void CachePref(const std::string& path, base::Value value) const;
+
+  void OnBrowsingHistoryFetched(const std::vector<std::string>& history);
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  // Filled in by the const getters on first read. Int64 and uint64 prefs are
+  // kept as strings, the way the browser stores them.
+  mutable std::map<std::string, base::Value> prefs_;
+  mutable absl::optional<bool> is_foreground_;
+
+  // Resource bundle data by id, which doesn't change while the browser runs.
+  std::map<std::string, std::string> resources_for_id_;
+
+  // Mutable as AdsClient records and resets ad events from const methods.
+  mutable ads::AdEventHistory ad_event_history_;
+
+  // Origins from the last GetBrowsingHistory fetch and the visits since, for
+  // |browsing_history_max_count_| and |browsing_history_days_ago_|. Null
+  // |browsing_history_fetched_at_| means there is nothing to answer from.
+  std::set<std::string> browsing_history_;
+  int browsing_history_max_count_ = 0;
+  int browsing_history_days_ago_ = 0;
+  base::Time browsing_history_fetched_at_;
+
+  // Set while a fetch is in flight. Visits during a fetch may be missing from
+  // its results, and deletions may not have been applied to them.
+  std::vector<ads::GetBrowsingHistoryCallback> browsing_history_callbacks_;
+  std::set<std::string> browsing_history_visited_while_fetching_;
+  bool browsing_history_deleted_while_fetching_ = false;
+
+  base::WeakPtrFactory<BatAdsClientMojoBridge> weak_factory_{this};
 };
 
 }  // namespace bat_ads
@@ -5,6 +5,7 @@
 
 #include "brave/components/services/bat_ads/bat_ads_impl.h"
 
+#include <map>
 #include <utility>
 #include <vector>
 
@@ -71,6 +72,26 @@ void BatAdsImpl::OnPrefChanged(const std::string& path) {
   ads_->OnPrefChanged(path);
 }
 
+void BatAdsImpl::OnPrefValueChanged(const std::string& path,
+                                    base::Value value) {
+  bat_ads_client_mojo_proxy_->OnPrefValueChanged(path, std::move(value));
+}
+
+void BatAdsImpl::SetAdEventHistory(
+    const base::flat_map<std::string, std::vector<double>>& history) {
+  bat_ads_client_mojo_proxy_->SetAdEventHistory(
+      std::map<std::string, std::vector<double>>(history.begin(),
+                                                 history.end()));
+}
+
+void BatAdsImpl::OnBrowsingHistoryVisited(const std::string& url) {
+  bat_ads_client_mojo_proxy_->OnBrowsingHistoryVisited(url);
+}
+
+void BatAdsImpl::OnBrowsingHistoryDeleted() {
+  bat_ads_client_mojo_proxy_->OnBrowsingHistoryDeleted();
+}
+
 void BatAdsImpl::OnHtmlLoaded(const int32_t tab_id,
                               const std::vector<std::string>& redirect_chain,
                               const std::string& html) {
@@ -96,10 +117,12 @@ void BatAdsImpl::OnIdle() {
 }
 
 void BatAdsImpl::OnForeground() {
+  bat_ads_client_mojo_proxy_->SetIsForeground(true);
   ads_->OnForeground();
 }
 
 void BatAdsImpl::OnBackground() {
+  bat_ads_client_mojo_proxy_->SetIsForeground(false);
   ads_->OnBackground();
 }
 
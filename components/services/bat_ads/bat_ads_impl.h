@@ -12,7 +12,9 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/public/interfaces/ads.mojom.h"
 #include "bat/ads/statement_info.h"
@@ -48,6 +50,11 @@ class BatAdsImpl :
       const std::string& locale) override;
 
   void OnPrefChanged(const std::string& path) override;
+  void OnPrefValueChanged(const std::string& path, base::Value value) override;
+  void SetAdEventHistory(
+      const base::flat_map<std::string, std::vector<double>>& history) override;
+  void OnBrowsingHistoryVisited(const std::string& url) override;
+  void OnBrowsingHistoryDeleted() override;
 
   void OnHtmlLoaded(const int32_t tab_id,
                     const std::vector<std::string>& redirect_chain,
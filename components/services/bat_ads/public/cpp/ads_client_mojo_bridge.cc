@@ -13,6 +13,7 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/span.h"
 #include "base/logging.h"
 #include "bat/ads/ad_notification_info.h"
 #include "bat/ads/ads.h"
@@ -88,20 +89,6 @@ void AdsClientMojoBridge::ShouldShowNotifications(
   std::move(callback).Run(ads_client_->ShouldShowNotifications());
 }
 
-bool AdsClientMojoBridge::GetAdEvents(const std::string& ad_type,
-                                      const std::string& confirmation_type,
-                                      std::vector<double>* out_ad_events) {
-  DCHECK(out_ad_events);
-  *out_ad_events = ads_client_->GetAdEvents(ad_type, confirmation_type);
-  return true;
-}
-
-void AdsClientMojoBridge::GetAdEvents(const std::string& ad_type,
-                                      const std::string& confirmation_type,
-                                      GetAdEventsCallback callback) {
-  std::move(callback).Run(ads_client_->GetAdEvents(ad_type, confirmation_type));
-}
-
 bool AdsClientMojoBridge::LoadResourceForId(
     const std::string& id,
     std::string* out_value) {
@@ -148,7 +135,8 @@ void AdsClientMojoBridge::OnLoadAdsResource(
   DCHECK(holder);
 
   if (holder->is_valid()) {
-    std::move(holder->get()).Run(success, std::move(value));
+    mojo_base::BigBuffer buffer(base::as_bytes(base::make_span(value)));
+    std::move(holder->get()).Run(success, std::move(buffer));
   }
 
   delete holder;
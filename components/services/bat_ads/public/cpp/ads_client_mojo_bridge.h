@@ -14,6 +14,7 @@
 #include "base/memory/weak_ptr.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "mojo/public/cpp/base/big_buffer.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 
 namespace bat_ads {
@@ -44,12 +45,6 @@ class AdsClientMojoBridge
   bool ShouldShowNotifications(bool* out_should_show) override;
   void ShouldShowNotifications(
       ShouldShowNotificationsCallback callback) override;
-  bool GetAdEvents(const std::string& ad_type,
-                   const std::string& confirmation_type,
-                   std::vector<double>* out_ad_events) override;
-  void GetAdEvents(const std::string& ad_type,
-                   const std::string& confirmation_type,
-                   GetAdEventsCallback callback) override;
 
   bool LoadResourceForId(
       const std::string& id,
@@ -11,9 +11,34 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "bat/ledger/option_keys.h"
 
 namespace bat_ledger {
 
+namespace {
+
+// Records how long the ledger process was blocked on a sync call to the
+// browser, for the calls that can't be answered locally.
+class ScopedSyncCallTimer {
+ public:
+  ScopedSyncCallTimer() = default;
+  ~ScopedSyncCallTimer() {
+    UMA_HISTOGRAM_TIMES("Brave.Rewards.LedgerClientSyncCallTime",
+                        timer_.Elapsed());
+  }
+
+  ScopedSyncCallTimer(const ScopedSyncCallTimer&) = delete;
+  ScopedSyncCallTimer& operator=(const ScopedSyncCallTimer&) = delete;
+
+ private:
+  base::ElapsedTimer timer_;
+};
+
+}  // namespace
+
 BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
       mojo::PendingAssociatedRemote<mojom::BatLedgerClient> client_info) {
   bat_ledger_client_.Bind(std::move(client_info));
@@ -21,6 +46,11 @@ BatLedgerClientMojoBridge::BatLedgerClientMojoBridge(
 
 BatLedgerClientMojoBridge::~BatLedgerClientMojoBridge() = default;
 
+void BatLedgerClientMojoBridge::OnStateValueChanged(const std::string& name,
+                                                    base::Value value) {
+  CacheState(name, std::move(value));
+}
+
 void OnLoadURL(
     const ledger::client::LoadURLCallback& callback,
     ledger::type::UrlResponsePtr response_ptr) {
@@ -135,6 +165,7 @@ std::string BatLedgerClientMojoBridge::URIEncode(const std::string& value) {
     return "";
 
   std::string encoded_value;
+  ScopedSyncCallTimer timer;
   bat_ledger_client_->URIEncode(value, &encoded_value);
   return encoded_value;
 }
@@ -150,119 +181,238 @@ void BatLedgerClientMojoBridge::PublisherListNormalized(
 
 void BatLedgerClientMojoBridge::SetBooleanState(const std::string& name,
                                                bool value) {
+  CacheState(name, base::Value(value));
   bat_ledger_client_->SetBooleanState(name, value);
 }
 
 bool BatLedgerClientMojoBridge::GetBooleanState(const std::string& name) const {
-  bool value;
-  bat_ledger_client_->GetBooleanState(name, &value);
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_bool())
+    return cached_value->GetBool();
+
+  bool value = false;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetBooleanState(name, &value))
+    CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetIntegerState(const std::string& name,
                                                int value) {
+  CacheState(name, base::Value(value));
   bat_ledger_client_->SetIntegerState(name, value);
 }
 
 int BatLedgerClientMojoBridge::GetIntegerState(const std::string& name) const {
-  int value;
-  bat_ledger_client_->GetIntegerState(name, &value);
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_int())
+    return cached_value->GetInt();
+
+  int value = 0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetIntegerState(name, &value))
+    CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetDoubleState(const std::string& name,
                                               double value) {
+  CacheState(name, base::Value(value));
   bat_ledger_client_->SetDoubleState(name, value);
 }
 
 double BatLedgerClientMojoBridge::GetDoubleState(
     const std::string& name) const {
-  double value;
-  bat_ledger_client_->GetDoubleState(name, &value);
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && (cached_value->is_double() || cached_value->is_int()))
+    return cached_value->GetDouble();
+
+  double value = 0.0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetDoubleState(name, &value))
+    CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetStringState(const std::string& name,
                               const std::string& value) {
+  CacheState(name, base::Value(value));
   bat_ledger_client_->SetStringState(name, value);
 }
 
 std::string BatLedgerClientMojoBridge::
 GetStringState(const std::string& name) const {
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_string())
+    return cached_value->GetString();
+
   std::string value;
-  bat_ledger_client_->GetStringState(name, &value);
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetStringState(name, &value))
+    CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetInt64State(const std::string& name,
                                              int64_t value) {
+  CacheState(name, base::Value(base::NumberToString(value)));
   bat_ledger_client_->SetInt64State(name, value);
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64State(
     const std::string& name) const {
-  int64_t value;
-  bat_ledger_client_->GetInt64State(name, &value);
+  const base::Value* cached_value = GetCachedState(name);
+  int64_t value = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToInt64(cached_value->GetString(), &value)) {
+    return value;
+  }
+
+  value = 0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetInt64State(name, &value))
+    CacheState(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetUint64State(const std::string& name,
                                               uint64_t value) {
+  CacheState(name, base::Value(base::NumberToString(value)));
   bat_ledger_client_->SetUint64State(name, value);
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64State(
     const std::string& name) const {
-  uint64_t value;
-  bat_ledger_client_->GetUint64State(name, &value);
+  const base::Value* cached_value = GetCachedState(name);
+  uint64_t value = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToUint64(cached_value->GetString(), &value)) {
+    return value;
+  }
+
+  value = 0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetUint64State(name, &value))
+    CacheState(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 void BatLedgerClientMojoBridge::ClearState(const std::string& name) {
+  // Only the browser knows the default value, so read it again next time.
+  state_.erase(name);
   bat_ledger_client_->ClearState(name);
 }
 
 bool BatLedgerClientMojoBridge::GetBooleanOption(
     const std::string& name) const {
-  bool value;
-  bat_ledger_client_->GetBooleanOption(name, &value);
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_bool())
+    return cached_value->GetBool();
+
+  bool value = false;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetBooleanOption(name, &value))
+    CacheOption(name, base::Value(value));
   return value;
 }
 
 int BatLedgerClientMojoBridge::GetIntegerOption(const std::string& name) const {
-  int value;
-  bat_ledger_client_->GetIntegerOption(name, &value);
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_int())
+    return cached_value->GetInt();
+
+  int value = 0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetIntegerOption(name, &value))
+    CacheOption(name, base::Value(value));
   return value;
 }
 
 double BatLedgerClientMojoBridge::GetDoubleOption(
     const std::string& name) const {
-  double value;
-  bat_ledger_client_->GetDoubleOption(name, &value);
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_double())
+    return cached_value->GetDouble();
+
+  double value = 0.0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetDoubleOption(name, &value))
+    CacheOption(name, base::Value(value));
   return value;
 }
 
 std::string BatLedgerClientMojoBridge::GetStringOption(
     const std::string& name) const {
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_string())
+    return cached_value->GetString();
+
   std::string value;
-  bat_ledger_client_->GetStringOption(name, &value);
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetStringOption(name, &value))
+    CacheOption(name, base::Value(value));
   return value;
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64Option(
     const std::string& name) const {
-  int64_t value;
-  bat_ledger_client_->GetInt64Option(name, &value);
+  const base::Value* cached_value = GetCachedOption(name);
+  int64_t value = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToInt64(cached_value->GetString(), &value)) {
+    return value;
+  }
+
+  value = 0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetInt64Option(name, &value))
+    CacheOption(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64Option(
     const std::string& name) const {
-  uint64_t value;
-  bat_ledger_client_->GetUint64Option(name, &value);
+  const base::Value* cached_value = GetCachedOption(name);
+  uint64_t value = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToUint64(cached_value->GetString(), &value)) {
+    return value;
+  }
+
+  value = 0;
+  ScopedSyncCallTimer timer;
+  if (bat_ledger_client_->GetUint64Option(name, &value))
+    CacheOption(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
+const base::Value* BatLedgerClientMojoBridge::GetCachedState(
+    const std::string& name) const {
+  const auto iter = state_.find(name);
+  return iter != state_.end() ? &iter->second : nullptr;
+}
+
+const base::Value* BatLedgerClientMojoBridge::GetCachedOption(
+    const std::string& name) const {
+  const auto iter = options_.find(name);
+  return iter != options_.end() ? &iter->second : nullptr;
+}
+
+void BatLedgerClientMojoBridge::CacheState(const std::string& name,
+                                           base::Value value) const {
+  state_[name] = std::move(value);
+}
+
+void BatLedgerClientMojoBridge::CacheOption(const std::string& name,
+                                            base::Value value) const {
+  // The browser derives this one from the connected wallet, so it isn't
+  // constant like the other options.
+  if (name == ledger::option::kIsBitflyerRegion)
+    return;
+
+  options_[name] = std::move(value);
+}
+
 bool BatLedgerClientMojoBridge::Connected() const {
   return bat_ledger_client_.is_bound();
 }
@@ -283,6 +433,7 @@ std::string BatLedgerClientMojoBridge::GetLegacyWallet() {
   }
 
   std::string wallet;
+  ScopedSyncCallTimer timer;
   bat_ledger_client_->GetLegacyWallet(&wallet);
   return wallet;
 }
@@ -305,6 +456,7 @@ void BatLedgerClientMojoBridge::ShowNotification(
 
 ledger::type::ClientInfoPtr BatLedgerClientMojoBridge::GetClientInfo() {
   auto info = ledger::type::ClientInfo::New();
+  ScopedSyncCallTimer timer;
   bat_ledger_client_->GetClientInfo(&info);
   return info;
 }
@@ -373,6 +525,7 @@ void BatLedgerClientMojoBridge::DeleteLog(
 absl::optional<std::string> BatLedgerClientMojoBridge::EncryptString(
     const std::string& value) {
   absl::optional<std::string> result;
+  ScopedSyncCallTimer timer;
   bat_ledger_client_->EncryptString(value, &result);
   return result;
 }
@@ -380,6 +533,7 @@ absl::optional<std::string> BatLedgerClientMojoBridge::EncryptString(
 absl::optional<std::string> BatLedgerClientMojoBridge::DecryptString(
     const std::string& value) {
   absl::optional<std::string> result;
+  ScopedSyncCallTimer timer;
   bat_ledger_client_->DecryptString(value, &result);
   return result;
 }
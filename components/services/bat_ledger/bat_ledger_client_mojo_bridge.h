@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -31,6 +32,10 @@ class BatLedgerClientMojoBridge :
   BatLedgerClientMojoBridge& operator=(
       const BatLedgerClientMojoBridge&) = delete;
 
+  // State is read from the browser once and then kept up to date by the
+  // browser, which pushes changes through this.
+  void OnStateValueChanged(const std::string& name, base::Value value);
+
   void OnReconcileComplete(
       const ledger::type::Result result,
       ledger::type::ContributionInfoPtr contribution) override;
@@ -125,7 +130,18 @@ class BatLedgerClientMojoBridge :
  private:
   bool Connected() const;
 
+  // Return the mirrored value of |name|, or null if it hasn't been read yet.
+  const base::Value* GetCachedState(const std::string& name) const;
+  const base::Value* GetCachedOption(const std::string& name) const;
+  void CacheState(const std::string& name, base::Value value) const;
+  void CacheOption(const std::string& name, base::Value value) const;
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+
+  // Filled in by the const getters on first read. Int64 and uint64 values are
+  // kept as strings, the way the browser stores them.
+  mutable std::map<std::string, base::Value> state_;
+  mutable std::map<std::string, base::Value> options_;
 };
 
 }  // namespace bat_ledger
@@ -1154,4 +1154,9 @@ void BatLedgerImpl::GetWalletPassphrase(GetWalletPassphraseCallback callback) {
   std::move(callback).Run(ledger_->GetWalletPassphrase());
 }
 
+void BatLedgerImpl::OnStateValueChanged(const std::string& name,
+                                        base::Value value) {
+  bat_ledger_client_mojo_bridge_->OnStateValueChanged(name, std::move(value));
+}
+
 }  // namespace bat_ledger
@@ -15,6 +15,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 
@@ -248,6 +249,8 @@ class BatLedgerImpl :
 
   void GetWalletPassphrase(GetWalletPassphraseCallback callback) override;
 
+  void OnStateValueChanged(const std::string& name, base::Value value) override;
+
  private:
   // workaround to pass base::OnceCallback into std::bind
   template <typename Callback>
@@ -46,7 +46,7 @@ class SidebarService : public KeyedService {
   explicit SidebarService(PrefService* prefs);
   ~SidebarService() override;
 
-  const std::vector<SidebarItem> items() const { return items_; }
+  const std::vector<SidebarItem>& items() const { return items_; }
 
   void AddItem(const SidebarItem& item);
   void RemoveItemAt(int index);
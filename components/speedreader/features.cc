@@ -22,4 +22,28 @@ const base::Feature kSpeedreaderFeature {
 const base::Feature kSpeedreaderLegacyBackend{
     "Speedreader Legacy Backend", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// When enabled along with a streaming backend, response chunks are fed to the
+// rewriter as they arrive and its output is forwarded right away instead of
+// distilling the fully buffered body.
+const base::Feature kSpeedreaderStreamingRewrite{
+    "SpeedreaderStreamingRewrite", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// When enabled, the first chunk of a buffered response is checked for
+// metadata saying the page is not an article, in which case the rest of the
+// response is passed through without being buffered or distilled.
+const base::Feature kSpeedreaderPreclassifier{
+    "SpeedreaderPreclassifier", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// When enabled, the compiled rewriter configuration of recently distilled
+// origins is kept and reused, and is built ahead of time when a readable URL
+// is typed into the omnibox.
+const base::Feature kSpeedreaderRewriterConfigPool{
+    "SpeedreaderRewriterConfigPool", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// When enabled, distilled pages whose responses carry an ETag or Last-Modified
+// header are kept in a bounded on-disk cache, so revisiting an unchanged page
+// skips distillation.
+const base::Feature kSpeedreaderDistilledCache{
+    "SpeedreaderDistilledCache", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace speedreader
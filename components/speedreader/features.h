@@ -13,6 +13,10 @@ struct Feature;
 namespace speedreader {
 extern const base::Feature kSpeedreaderFeature;
 extern const base::Feature kSpeedreaderLegacyBackend;
+extern const base::Feature kSpeedreaderStreamingRewrite;
+extern const base::Feature kSpeedreaderPreclassifier;
+extern const base::Feature kSpeedreaderRewriterConfigPool;
+extern const base::Feature kSpeedreaderDistilledCache;
 }  // namespace speedreader
 
 #endif  // BRAVE_COMPONENTS_SPEEDREADER_FEATURES_H_
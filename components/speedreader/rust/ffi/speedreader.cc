@@ -6,12 +6,19 @@
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 
 #include <iostream>
+#include <utility>
 
 #include "base/logging.h"
 #include "brave/components/speedreader/rust/ffi/speedreader_ffi.h"
 
 namespace speedreader {
 
+Preclassification PreclassifyDocument(const std::string& url,
+                                      const char* html,
+                                      size_t html_len) {
+  return preclassify_document(url.c_str(), url.length(), html, html_len);
+}
+
 SpeedReader::SpeedReader() : raw_(speedreader_new()) {}
 SpeedReader::SpeedReader(const char* whitelist_serialized,
                          size_t whitelist_size)
@@ -60,42 +67,72 @@ std::unique_ptr<Rewriter> SpeedReader::MakeRewriter(
                                     output_sink_user_data);
 }
 
+std::shared_ptr<RewriterConfig> SpeedReader::MakeRewriterConfig(
+    const std::string& url) {
+  return std::make_shared<RewriterConfig>(raw_, url);
+}
+
+std::unique_ptr<Rewriter> SpeedReader::MakeRewriter(
+    const std::string& url,
+    RewriterType rewriter_type,
+    std::shared_ptr<RewriterConfig> config,
+    void (*output_sink)(const char*, size_t, void*),
+    void* output_sink_user_data) {
+  return std::make_unique<Rewriter>(raw_, url, rewriter_type, std::move(config),
+                                    output_sink, output_sink_user_data);
+}
+
 Rewriter::Rewriter(C_SpeedReader* speedreader,
                    const std::string& url,
                    RewriterType rewriter_type)
-    : Rewriter(
-          speedreader,
-          url,
-          rewriter_type,
-          [](const char* chunk, size_t chunk_len, void* user_data) {
-            std::string* out = static_cast<std::string*>(user_data);
-            out->append(chunk, chunk_len);
-          },
-          &output_) {}
+    : Rewriter(speedreader, url, rewriter_type, nullptr, nullptr) {}
 
 Rewriter::Rewriter(C_SpeedReader* speedreader,
                    const std::string& url,
                    RewriterType rewriter_type,
                    void (*output_sink)(const char*, size_t, void*),
                    void* output_sink_user_data)
+    : Rewriter(speedreader,
+               url,
+               rewriter_type,
+               std::make_shared<RewriterConfig>(speedreader, url),
+               output_sink,
+               output_sink_user_data) {}
+
+Rewriter::Rewriter(C_SpeedReader* speedreader,
+                   const std::string& url,
+                   RewriterType rewriter_type,
+                   std::shared_ptr<RewriterConfig> config,
+                   void (*output_sink)(const char*, size_t, void*),
+                   void* output_sink_user_data)
     : output_(""),
       ended_(false),
       poisoned_(false),
-      config_raw_(
-          get_rewriter_opaque_config(speedreader, url.c_str(), url.length())),
-      raw_(rewriter_new(speedreader,
-                        url.c_str(),
-                        url.length(),
-                        output_sink,
-                        output_sink_user_data,
-                        config_raw_,
-                        rewriter_type)) {}
+      config_(std::move(config)) {
+  if (!output_sink) {
+    output_sink = [](const char* chunk, size_t chunk_len, void* user_data) {
+      std::string* out = static_cast<std::string*>(user_data);
+      out->append(chunk, chunk_len);
+    };
+    output_sink_user_data = &output_;
+  }
+  raw_ = rewriter_new(speedreader, url.c_str(), url.length(), output_sink,
+                      output_sink_user_data, config_->raw(), rewriter_type);
+}
 
 Rewriter::~Rewriter() {
   if (!ended_) {
     rewriter_free(raw_);
   }
-  free_rewriter_opaque_config(config_raw_);
+}
+
+RewriterConfig::RewriterConfig(C_SpeedReader* speedreader,
+                               const std::string& url)
+    : raw_(get_rewriter_opaque_config(speedreader, url.c_str(), url.length())) {
+}
+
+RewriterConfig::~RewriterConfig() {
+  free_rewriter_opaque_config(raw_);
 }
 
 int Rewriter::Write(const char* chunk, size_t chunk_len) {
@@ -32,6 +32,31 @@
 namespace speedreader {
 
 using RewriterType = C_CRewriterType;
+using Preclassification = C_CPreclassification;
+
+/// Classifies a document from its first bytes only (`og:type`, schema.org
+/// article markup, AMP links, `<article>`). Returns `PreclassifyUnknown` when
+/// the prefix carries no signal either way.
+SPEEDREADER_EXPORT Preclassification PreclassifyDocument(const std::string& url,
+                                                         const char* html,
+                                                         size_t html_len);
+
+/// Compiled rewriting configuration for the origin of a URL. Building it
+/// parses the site's selectors, so it can be kept around and shared by the
+/// `Rewriter`s of later documents on the same origin.
+class SPEEDREADER_EXPORT RewriterConfig {
+ public:
+  RewriterConfig(C_SpeedReader* speedreader, const std::string& url);
+  ~RewriterConfig();
+
+  RewriterConfig(const RewriterConfig&) = delete;
+  void operator=(const RewriterConfig&) = delete;
+
+  C_CRewriterConfig* raw() const { return raw_; }
+
+ private:
+  C_CRewriterConfig* raw_;
+};
 
 class SPEEDREADER_EXPORT Rewriter {
  public:
@@ -51,6 +76,16 @@ class SPEEDREADER_EXPORT Rewriter {
            RewriterType rewriter_type,
            void (*output_sink)(const char*, size_t, void*),
            void* output_sink_user_data);
+
+  /// Same as above, reusing a previously built `config` for the URL's origin
+  /// instead of building a new one. A null `output_sink` creates a buffering
+  /// `Rewriter`.
+  Rewriter(C_SpeedReader* speedreader,
+           const std::string& url,
+           RewriterType rewriter_type,
+           std::shared_ptr<RewriterConfig> config,
+           void (*output_sink)(const char*, size_t, void*),
+           void* output_sink_user_data);
   ~Rewriter();
 
   Rewriter(const Rewriter&) = delete;
@@ -73,7 +108,7 @@ class SPEEDREADER_EXPORT Rewriter {
   std::string output_;
   bool ended_;
   bool poisoned_;
-  C_CRewriterConfig* config_raw_;
+  std::shared_ptr<RewriterConfig> config_;
   C_CRewriter* raw_;
 };
 
@@ -114,6 +149,19 @@ class SPEEDREADER_EXPORT SpeedReader {
                                                              void*),
                                          void* output_sink_user_data);
 
+  /// Builds the rewriting configuration for the origin of `url`, for use with
+  /// the `MakeRewriter` overloads below.
+  std::shared_ptr<RewriterConfig> MakeRewriterConfig(const std::string& url);
+
+  /// Create a `Rewriter` that reuses `config`. A null `output_sink` creates a
+  /// buffering `Rewriter`.
+  std::unique_ptr<Rewriter> MakeRewriter(
+      const std::string& url,
+      RewriterType rewriter_type,
+      std::shared_ptr<RewriterConfig> config,
+      void (*output_sink)(const char*, size_t, void*) = nullptr,
+      void* output_sink_user_data = nullptr);
+
  private:
   C_SpeedReader* raw_;
 };
@@ -43,6 +43,14 @@ pub enum CRewriterType {
     RewriterUnknown,
 }
 
+/// Result of `preclassify_document`, see `classifier::Preclassification`.
+#[repr(C)]
+pub enum CPreclassification {
+    PreclassifyReadable,
+    PreclassifyNotReadable,
+    PreclassifyUnknown,
+}
+
 impl CRewriterType {
     fn to_rewriter_type(&self) -> Option<RewriterType> {
         match &self {
@@ -124,6 +132,24 @@ pub extern "C" fn find_type(
     CRewriterType::from(rewriter_type)
 }
 
+/// Classifies a document from its first bytes only, so loading can bail out
+/// early for pages that declare they are not articles.
+#[no_mangle]
+pub extern "C" fn preclassify_document(
+    url: *const c_char,
+    url_len: size_t,
+    html: *const c_char,
+    html_len: size_t,
+) -> CPreclassification {
+    let url = unwrap_or_ret! { to_str!(url, url_len), CPreclassification::PreclassifyUnknown };
+    let html = to_bytes!(html, html_len);
+    match classifier::preclassify(url, html) {
+        classifier::Preclassification::Readable => CPreclassification::PreclassifyReadable,
+        classifier::Preclassification::NotReadable => CPreclassification::PreclassifyNotReadable,
+        classifier::Preclassification::Unknown => CPreclassification::PreclassifyUnknown,
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn speedreader_free(speedreader: *mut SpeedReader) {
     assert_not_null!(speedreader);
@@ -165,4 +165,19 @@ TEST(SpeedreaderFFITest, RewriterParsingAmbiguity) {
   }
 }
 
+TEST(SpeedreaderFFITest, PreclassifyDocument) {
+  std::string url_str = "https://example.com/news/article/topic/index.html";
+  const char* article =
+      "<html><head><meta property=\"og:type\" content=\"article\">";
+  EXPECT_EQ(PreclassifyDocument(url_str, article, strlen(article)),
+            Preclassification::PreclassifyReadable);
+  const char* website =
+      "<html><head><meta property=\"og:type\" content=\"website\">";
+  EXPECT_EQ(PreclassifyDocument(url_str, website, strlen(website)),
+            Preclassification::PreclassifyNotReadable);
+  const char* no_signal = "<html><head><title>Hello</title>";
+  EXPECT_EQ(PreclassifyDocument(url_str, no_signal, strlen(no_signal)),
+            Preclassification::PreclassifyUnknown);
+}
+
 }  // namespace speedreader
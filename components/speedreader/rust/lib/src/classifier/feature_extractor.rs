@@ -109,6 +109,21 @@ impl TreeSink for FeaturisingTreeSink {
                         .or_insert(1);
                 }
             }
+
+            // records the value of `<meta property="og:type" content="..." />`
+            let is_og_type = attrs
+                .iter()
+                .any(|a| &*a.name.local == "property" && &*a.value == "og:type");
+            if is_og_type {
+                if let Some(content) = attrs.iter().find(|a| &*a.name.local == "content") {
+                    let key = if content.value.eq_ignore_ascii_case("article") {
+                        "og_type_article"
+                    } else {
+                        "og_type_other"
+                    };
+                    self.features.insert(key.to_string(), 1);
+                }
+            }
         }
 
         // checks if page is AMP compatible
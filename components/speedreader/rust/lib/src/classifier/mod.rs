@@ -1,7 +1,9 @@
 pub mod feature_extractor;
 mod model;
 use std::collections::HashMap;
+use url::Url;
 
+use feature_extractor::FeatureExtractorStreamer;
 use model::predict;
 use model::N_FEATURES;
 
@@ -22,6 +24,47 @@ impl Classifier {
     }
 }
 
+/// Outcome of looking only at the first bytes of a document.
+#[derive(Debug, PartialEq)]
+pub enum Preclassification {
+    /// The document declares itself an article.
+    Readable,
+    /// The document declares a non-article type and has no article markers.
+    NotReadable,
+    /// Not enough signal yet; the full pipeline has to decide.
+    Unknown,
+}
+
+/// Cheap classification on the beginning of a document: `og:type`, schema.org
+/// article markup, AMP links and `<article>` elements seen in `head`. Meant to
+/// skip distilling pages that say they are not articles before the whole body
+/// has been buffered.
+pub fn preclassify(url: &str, head: &[u8]) -> Preclassification {
+    let url = match Url::parse(url) {
+        Ok(url) => url,
+        Err(_) => return Preclassification::Unknown,
+    };
+    let mut extractor = match FeatureExtractorStreamer::try_new(&url) {
+        Ok(extractor) => extractor,
+        Err(_) => return Preclassification::Unknown,
+    };
+    // The prefix may end in the middle of a multi-byte sequence.
+    let head = String::from_utf8_lossy(head);
+    if extractor.write(&mut head.as_bytes()).is_err() {
+        return Preclassification::Unknown;
+    }
+
+    let features = extractor.features();
+    let has = |key: &str| features.get(key).cloned().unwrap_or(0) > 0;
+    if has("og_type_article") || has("schema_org") || has("amphtml") || has("article") {
+        Preclassification::Readable
+    } else if has("og_type_other") {
+        Preclassification::NotReadable
+    } else {
+        Preclassification::Unknown
+    }
+}
+
 // helpers
 fn convert_map(map: &HashMap<String, u32>) -> [f32; N_FEATURES] {
     let mut slice: [f32; N_FEATURES] = [0.0; N_FEATURES];
@@ -51,3 +94,32 @@ fn convert_map(map: &HashMap<String, u32>) -> [f32; N_FEATURES] {
 
     slice
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_preclassify() {
+        let url = "https://example.com/news/story";
+        assert_eq!(
+            preclassify(url, b"<html><head><meta property=\"og:type\" content=\"article\">"),
+            Preclassification::Readable
+        );
+        assert_eq!(
+            preclassify(url, b"<html><head><meta property=\"og:type\" content=\"website\">"),
+            Preclassification::NotReadable
+        );
+        assert_eq!(
+            preclassify(
+                url,
+                b"<html><head><meta property=\"og:type\" content=\"website\"></head><body><article>"
+            ),
+            Preclassification::Readable
+        );
+        assert_eq!(
+            preclassify(url, b"<html><head><title>Story</title>"),
+            Preclassification::Unknown
+        );
+    }
+}
@@ -0,0 +1,158 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/task_runner_util.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "crypto/sha2.h"
+#include "net/http/http_response_headers.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+// Distilled pages are not worth keeping if they are bigger than this.
+constexpr int64_t kMaxEntrySize = 2 * 1024 * 1024;
+
+absl::optional<std::string> ReadEntry(const base::FilePath& path) {
+  std::string distilled;
+  if (!base::ReadFileToStringWithMaxSize(path, &distilled, kMaxEntrySize))
+    return absl::nullopt;
+  // Bump the modification time so eviction drops the least recently used
+  // entries first.
+  const base::Time now = base::Time::Now();
+  base::TouchFile(path, now, now);
+  return distilled;
+}
+
+void EvictEntries(const base::FilePath& cache_dir,
+                  size_t max_entries,
+                  int64_t max_bytes) {
+  struct Entry {
+    base::FilePath path;
+    base::Time last_modified;
+    int64_t size;
+  };
+  std::vector<Entry> entries;
+  int64_t total_bytes = 0;
+  base::FileEnumerator enumerator(cache_dir, false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    const base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    entries.push_back({path, info.GetLastModifiedTime(), info.GetSize()});
+    total_bytes += info.GetSize();
+  }
+  if (entries.size() <= max_entries && total_bytes <= max_bytes)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.last_modified < b.last_modified;
+            });
+  size_t remaining = entries.size();
+  for (const Entry& entry : entries) {
+    if (remaining <= max_entries && total_bytes <= max_bytes)
+      break;
+    if (base::DeleteFile(entry.path)) {
+      remaining--;
+      total_bytes -= entry.size;
+    }
+  }
+}
+
+void WriteEntry(const base::FilePath& cache_dir,
+                const base::FilePath& path,
+                std::string distilled,
+                size_t max_entries,
+                int64_t max_bytes) {
+  if (!base::CreateDirectory(cache_dir))
+    return;
+  if (!base::ImportantFileWriter::WriteFileAtomically(path, distilled))
+    return;
+  EvictEntries(cache_dir, max_entries, max_bytes);
+}
+
+}  // namespace
+
+SpeedreaderDistilledCache::SpeedreaderDistilledCache(
+    const base::FilePath& cache_dir,
+    size_t max_entries,
+    int64_t max_bytes)
+    : cache_dir_(cache_dir),
+      max_entries_(max_entries),
+      max_bytes_(max_bytes),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+SpeedreaderDistilledCache::~SpeedreaderDistilledCache() = default;
+
+// static
+std::string SpeedreaderDistilledCache::MakeKey(
+    const GURL& url,
+    const net::HttpResponseHeaders* headers) {
+  if (!headers || !url.is_valid())
+    return std::string();
+  std::string etag;
+  std::string last_modified;
+  headers->EnumerateHeader(nullptr, "ETag", &etag);
+  headers->EnumerateHeader(nullptr, "Last-Modified", &last_modified);
+  if (etag.empty() && last_modified.empty())
+    return std::string();
+  // Weak ETags still change whenever the page content does, which is all
+  // that matters for reusing the distilled output.
+  return url.GetWithoutRef().spec() + "\n" + etag + "\n" + last_modified;
+}
+
+void SpeedreaderDistilledCache::Get(const std::string& key,
+                                    LookupCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!key.empty());
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ReadEntry, GetEntryPath(key)), std::move(callback));
+}
+
+void SpeedreaderDistilledCache::Put(const std::string& key,
+                                    std::string distilled) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!key.empty());
+  if (distilled.empty() ||
+      static_cast<int64_t>(distilled.size()) > kMaxEntrySize) {
+    return;
+  }
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&WriteEntry, cache_dir_, GetEntryPath(key),
+                     std::move(distilled), max_entries_, max_bytes_));
+}
+
+base::WeakPtr<SpeedreaderDistilledCache>
+SpeedreaderDistilledCache::GetWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+base::FilePath SpeedreaderDistilledCache::GetEntryPath(
+    const std::string& key) const {
+  return cache_dir_.AppendASCII(
+      base::HexEncode(crypto::SHA256HashString(key).data(),
+                      crypto::kSHA256Length));
+}
+
+}  // namespace speedreader
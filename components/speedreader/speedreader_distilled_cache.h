@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_CACHE_H_
+#define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class GURL;
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace speedreader {
+
+// Bounded on-disk cache of distilled pages. Entries are keyed by the page URL
+// together with the response's ETag and Last-Modified validators, so a page
+// that changed on the server never hits a stale entry. The least recently used
+// entries are evicted once the cache holds more than |max_entries| files or
+// |max_bytes| bytes. All file operations happen on a background sequence.
+class SpeedreaderDistilledCache {
+ public:
+  using LookupCallback =
+      base::OnceCallback<void(absl::optional<std::string> distilled)>;
+
+  static constexpr size_t kDefaultMaxEntries = 100;
+  static constexpr int64_t kDefaultMaxBytes = 20 * 1024 * 1024;
+
+  explicit SpeedreaderDistilledCache(const base::FilePath& cache_dir,
+                                     size_t max_entries = kDefaultMaxEntries,
+                                     int64_t max_bytes = kDefaultMaxBytes);
+  ~SpeedreaderDistilledCache();
+
+  SpeedreaderDistilledCache(const SpeedreaderDistilledCache&) = delete;
+  SpeedreaderDistilledCache& operator=(const SpeedreaderDistilledCache&) =
+      delete;
+
+  // Returns the cache key for a response, or an empty string if the response
+  // carries no validators and so can't be cached safely.
+  static std::string MakeKey(const GURL& url,
+                             const net::HttpResponseHeaders* headers);
+
+  void Get(const std::string& key, LookupCallback callback);
+  void Put(const std::string& key, std::string distilled);
+
+  base::WeakPtr<SpeedreaderDistilledCache> GetWeakPtr();
+
+ private:
+  base::FilePath GetEntryPath(const std::string& key) const;
+
+  const base::FilePath cache_dir_;
+  const size_t max_entries_;
+  const int64_t max_bytes_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<SpeedreaderDistilledCache> weak_factory_{this};
+};
+
+}  // namespace speedreader
+
+#endif  // BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_DISTILLED_CACHE_H_
@@ -0,0 +1,116 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace speedreader {
+
+namespace {
+
+scoped_refptr<net::HttpResponseHeaders> MakeHeaders(const std::string& raw) {
+  return base::MakeRefCounted<net::HttpResponseHeaders>(
+      net::HttpUtil::AssembleRawHeaders(raw));
+}
+
+}  // namespace
+
+class SpeedreaderDistilledCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  std::unique_ptr<SpeedreaderDistilledCache> MakeCache(size_t max_entries) {
+    return std::make_unique<SpeedreaderDistilledCache>(
+        temp_dir_.GetPath().AppendASCII("cache"), max_entries,
+        SpeedreaderDistilledCache::kDefaultMaxBytes);
+  }
+
+  absl::optional<std::string> Get(SpeedreaderDistilledCache* cache,
+                                  const std::string& key) {
+    absl::optional<std::string> result;
+    base::RunLoop run_loop;
+    cache->Get(key, base::BindOnce(
+                        [](absl::optional<std::string>* result,
+                           base::OnceClosure quit,
+                           absl::optional<std::string> distilled) {
+                          *result = std::move(distilled);
+                          std::move(quit).Run();
+                        },
+                        &result, run_loop.QuitClosure()));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(SpeedreaderDistilledCacheTest, KeyRequiresValidators) {
+  const GURL url("https://example.com/article");
+  EXPECT_TRUE(SpeedreaderDistilledCache::MakeKey(url, nullptr).empty());
+  EXPECT_TRUE(SpeedreaderDistilledCache::MakeKey(
+                  url, MakeHeaders("HTTP/1.1 200 OK\n\n").get())
+                  .empty());
+
+  const std::string etag_key = SpeedreaderDistilledCache::MakeKey(
+      url, MakeHeaders("HTTP/1.1 200 OK\nETag: \"v1\"\n\n").get());
+  EXPECT_FALSE(etag_key.empty());
+  EXPECT_NE(etag_key,
+            SpeedreaderDistilledCache::MakeKey(
+                url, MakeHeaders("HTTP/1.1 200 OK\nETag: \"v2\"\n\n").get()));
+  EXPECT_FALSE(SpeedreaderDistilledCache::MakeKey(
+                   url, MakeHeaders("HTTP/1.1 200 OK\nLast-Modified: "
+                                    "Wed, 21 Oct 2015 07:28:00 GMT\n\n")
+                            .get())
+                   .empty());
+  // The fragment doesn't change the page.
+  EXPECT_EQ(etag_key,
+            SpeedreaderDistilledCache::MakeKey(
+                GURL("https://example.com/article#comments"),
+                MakeHeaders("HTTP/1.1 200 OK\nETag: \"v1\"\n\n").get()));
+}
+
+TEST_F(SpeedreaderDistilledCacheTest, PutAndGet) {
+  auto cache = MakeCache(SpeedreaderDistilledCache::kDefaultMaxEntries);
+  EXPECT_FALSE(Get(cache.get(), "key"));
+
+  cache->Put("key", "<html>distilled</html>");
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("<html>distilled</html>", Get(cache.get(), "key"));
+  EXPECT_FALSE(Get(cache.get(), "other key"));
+}
+
+TEST_F(SpeedreaderDistilledCacheTest, EvictsOldEntries) {
+  auto cache = MakeCache(2);
+  cache->Put("first", "1");
+  task_environment_.RunUntilIdle();
+  cache->Put("second", "2");
+  task_environment_.RunUntilIdle();
+  cache->Put("third", "3");
+  task_environment_.RunUntilIdle();
+
+  size_t remaining = 0;
+  for (const char* key : {"first", "second", "third"}) {
+    if (Get(cache.get(), key))
+      remaining++;
+  }
+  EXPECT_EQ(2u, remaining);
+  EXPECT_TRUE(Get(cache.get(), "third"));
+}
+
+}  // namespace speedreader
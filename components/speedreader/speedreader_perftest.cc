@@ -0,0 +1,339 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/process/process_metrics.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/speedreader/speedreader_rewriter_service.h"
+#include "brave/components/speedreader/speedreader_throttle.h"
+#include "mojo/public/cpp/bindings/pending_receiver.h"
+#include "mojo/public/cpp/bindings/pending_remote.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe_drainer.h"
+#include "mojo/public/cpp/system/data_pipe_producer.h"
+#include "mojo/public/cpp/system/string_data_source.h"
+#include "net/base/net_errors.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/mojom/early_hints.mojom.h"
+#include "services/network/public/mojom/url_loader.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// Replays saved article pages through SpeedReaderThrottle and
+// SpeedReaderURLLoader exactly as a main frame navigation would see them: the
+// page is written into the body pipe of the original loader, distilled by the
+// configured backend and read back from the destination pipe. Pass
+// --speedreader-corpus-dir=<path> to replay a directory of saved .html pages
+// other than the checked in articles.
+
+namespace speedreader {
+
+namespace {
+
+const char kSpeedreaderCorpusDirSwitch[] = "speedreader-corpus-dir";
+
+const char kMetricPrefix[] = "SpeedReaderURLLoader.";
+const char kMetricThroughput[] = "throughput";
+const char kMetricTimeToFirstOutput[] = "time_to_first_output";
+const char kMetricTotalTime[] = "total_time";
+const char kMetricPeakMemory[] = "peak_memory";
+
+// Each page is replayed this many times and the median is reported, so one
+// slow run on a busy bot doesn't skew the results.
+constexpr int kReplayIterations = 10;
+
+base::FilePath GetCorpusDir() {
+  base::FilePath corpus_dir =
+      base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+          kSpeedreaderCorpusDirSwitch);
+  if (!corpus_dir.empty())
+    return corpus_dir;
+  base::FilePath source_root;
+  base::PathService::Get(base::DIR_SOURCE_ROOT, &source_root);
+  return source_root.AppendASCII("brave")
+      .AppendASCII("test")
+      .AppendASCII("data")
+      .AppendASCII("articles");
+}
+
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
+base::TimeDelta Median(std::vector<base::TimeDelta> samples) {
+  DCHECK(!samples.empty());
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                   samples.end());
+  return samples[samples.size() / 2];
+}
+
+// The component updater is not available in this test, the built-in
+// stylesheet and backend defaults are used instead.
+class TestingBraveComponentUpdaterDelegate
+    : public brave_component_updater::BraveComponent::Delegate {
+ public:
+  TestingBraveComponentUpdaterDelegate() = default;
+  ~TestingBraveComponentUpdaterDelegate() override = default;
+
+  TestingBraveComponentUpdaterDelegate(TestingBraveComponentUpdaterDelegate&) =
+      delete;
+  TestingBraveComponentUpdaterDelegate& operator=(
+      TestingBraveComponentUpdaterDelegate&) = delete;
+
+  using ComponentObserver = update_client::UpdateClient::Observer;
+
+  // brave_component_updater::BraveComponent::Delegate implementation
+  void Register(const std::string& component_name,
+                const std::string& component_base64_public_key,
+                base::OnceClosure registered_callback,
+                brave_component_updater::BraveComponent::ReadyCallback
+                    ready_callback) override {}
+  bool Unregister(const std::string& component_id) override { return true; }
+  void OnDemandUpdate(const std::string& component_id) override {}
+
+  void AddObserver(ComponentObserver* observer) override {}
+  void RemoveObserver(ComponentObserver* observer) override {}
+
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunner() override {
+    return base::ThreadTaskRunnerHandle::Get();
+  }
+
+  const std::string locale() const override { return "en"; }
+  PrefService* local_state() override { return nullptr; }
+};
+
+struct ReplayResult {
+  base::TimeDelta time_to_first_output;
+  base::TimeDelta total_time;
+  size_t peak_memory = 0;
+  size_t output_bytes = 0;
+};
+
+// Plays both ends of the intercepted response: the original loader the page
+// body is written to, and the destination client that reads the distilled
+// output.
+class PageReplay : public blink::URLLoaderThrottle::Delegate,
+                   public network::mojom::URLLoaderClient,
+                   public mojo::DataPipeDrainer::Client {
+ public:
+  explicit PageReplay(std::string body) : body_(std::move(body)) {}
+  ~PageReplay() override = default;
+
+  PageReplay(const PageReplay&) = delete;
+  PageReplay& operator=(const PageReplay&) = delete;
+
+  ReplayResult Run(SpeedreaderRewriterService* rewriter_service,
+                   const GURL& url) {
+    SpeedReaderThrottle throttle(rewriter_service, nullptr, nullptr,
+                                 base::ThreadTaskRunnerHandle::Get());
+    throttle.set_delegate(this);
+
+    memory_before_ = GetMallocUsage();
+    start_time_ = base::TimeTicks::Now();
+    bool defer = false;
+    auto response_head = network::mojom::URLResponseHead::New();
+    throttle.WillProcessResponse(url, response_head.get(), &defer);
+    EXPECT_TRUE(defer);
+    SendBody();
+    run_loop_.Run();
+
+    result_.total_time = base::TimeTicks::Now() - start_time_;
+    return result_;
+  }
+
+  // blink::URLLoaderThrottle::Delegate:
+  void CancelWithError(int error_code,
+                       base::StringPiece custom_reason) override {
+    ADD_FAILURE() << "Speedreader cancelled the load: " << error_code;
+    run_loop_.Quit();
+  }
+  void Resume() override { SampleMemory(); }
+  void InterceptResponse(
+      mojo::PendingRemote<network::mojom::URLLoader> new_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>
+          new_client_receiver,
+      mojo::PendingRemote<network::mojom::URLLoader>* original_loader,
+      mojo::PendingReceiver<network::mojom::URLLoaderClient>*
+          original_client_receiver) override {
+    // Keeps the self-owned SpeedReaderURLLoader alive.
+    speedreader_loader_ = std::move(new_loader);
+    destination_receiver_.Bind(std::move(new_client_receiver));
+    // Calls to the original loader are ignored.
+    original_loader_receiver_ =
+        original_loader->InitWithNewPipeAndPassReceiver();
+    *original_client_receiver = source_client_.BindNewPipeAndPassReceiver();
+  }
+
+  // network::mojom::URLLoaderClient:
+  void OnReceiveEarlyHints(network::mojom::EarlyHintsPtr early_hints) override {
+  }
+  void OnReceiveResponse(
+      network::mojom::URLResponseHeadPtr response_head) override {}
+  void OnReceiveRedirect(
+      const net::RedirectInfo& redirect_info,
+      network::mojom::URLResponseHeadPtr response_head) override {}
+  void OnUploadProgress(int64_t current_position,
+                        int64_t total_size,
+                        OnUploadProgressCallback ack_callback) override {}
+  void OnReceiveCachedMetadata(mojo_base::BigBuffer data) override {}
+  void OnTransferSizeUpdated(int32_t transfer_size_diff) override {}
+  void OnStartLoadingResponseBody(
+      mojo::ScopedDataPipeConsumerHandle body) override {
+    drainer_ = std::make_unique<mojo::DataPipeDrainer>(this, std::move(body));
+  }
+  void OnComplete(const network::URLLoaderCompletionStatus& status) override {
+    EXPECT_EQ(net::OK, status.error_code);
+    completed_ = true;
+    MaybeQuit();
+  }
+
+  // mojo::DataPipeDrainer::Client:
+  void OnDataAvailable(const void* data, size_t num_bytes) override {
+    if (result_.output_bytes == 0)
+      result_.time_to_first_output = base::TimeTicks::Now() - start_time_;
+    result_.output_bytes += num_bytes;
+    SampleMemory();
+  }
+  void OnDataComplete() override {
+    drained_ = true;
+    MaybeQuit();
+  }
+
+ private:
+  void SendBody() {
+    mojo::ScopedDataPipeProducerHandle producer;
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    ASSERT_EQ(MOJO_RESULT_OK,
+              mojo::CreateDataPipe(nullptr, producer, consumer));
+    source_client_->OnStartLoadingResponseBody(std::move(consumer));
+    producer_ = std::make_unique<mojo::DataPipeProducer>(std::move(producer));
+    producer_->Write(
+        std::make_unique<mojo::StringDataSource>(
+            body_, mojo::StringDataSource::AsyncWritingMode::
+                       STRING_STAYS_VALID_UNTIL_COMPLETION),
+        base::BindOnce(&PageReplay::OnBodySent, base::Unretained(this)));
+  }
+
+  void OnBodySent(MojoResult result) {
+    EXPECT_EQ(MOJO_RESULT_OK, result);
+    producer_.reset();
+    source_client_->OnComplete(network::URLLoaderCompletionStatus(net::OK));
+  }
+
+  void SampleMemory() {
+    const size_t usage = GetMallocUsage();
+    if (usage > memory_before_)
+      result_.peak_memory =
+          std::max(result_.peak_memory, usage - memory_before_);
+  }
+
+  void MaybeQuit() {
+    if (completed_ && drained_)
+      run_loop_.Quit();
+  }
+
+  const std::string body_;
+  base::RunLoop run_loop_;
+  base::TimeTicks start_time_;
+  size_t memory_before_ = 0;
+  ReplayResult result_;
+  bool completed_ = false;
+  bool drained_ = false;
+
+  mojo::PendingRemote<network::mojom::URLLoader> speedreader_loader_;
+  mojo::PendingReceiver<network::mojom::URLLoader> original_loader_receiver_;
+  mojo::Remote<network::mojom::URLLoaderClient> source_client_;
+  mojo::Receiver<network::mojom::URLLoaderClient> destination_receiver_{this};
+  std::unique_ptr<mojo::DataPipeProducer> producer_;
+  std::unique_ptr<mojo::DataPipeDrainer> drainer_;
+};
+
+}  // namespace
+
+class SpeedreaderPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    base::FileEnumerator enumerator(GetCorpusDir(), false,
+                                    base::FileEnumerator::FILES,
+                                    FILE_PATH_LITERAL("*.html"));
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      corpus_.push_back(path);
+    }
+    std::sort(corpus_.begin(), corpus_.end());
+    ASSERT_FALSE(corpus_.empty());
+
+    rewriter_service_ =
+        std::make_unique<SpeedreaderRewriterService>(&component_delegate_);
+  }
+
+  perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricThroughput, "bytesPerSecond");
+    reporter.RegisterImportantMetric(kMetricTimeToFirstOutput, "ms");
+    reporter.RegisterImportantMetric(kMetricTotalTime, "ms");
+    reporter.RegisterImportantMetric(kMetricPeakMemory, "bytes");
+    return reporter;
+  }
+
+  // Replays |page| and reports the median throughput and latencies, and the
+  // largest memory growth seen while it was distilled.
+  void RunStory(const base::FilePath& page) {
+    std::string body;
+    ASSERT_TRUE(base::ReadFileToString(page, &body));
+    const std::string story = page.BaseName().RemoveExtension().MaybeAsASCII();
+    const GURL url("https://example.com/articles/" + story);
+
+    std::vector<base::TimeDelta> first_output_times;
+    std::vector<base::TimeDelta> total_times;
+    size_t peak_memory = 0;
+    for (int i = 0; i < kReplayIterations; i++) {
+      PageReplay replay(body);
+      ReplayResult result = replay.Run(rewriter_service_.get(), url);
+      ASSERT_GT(result.output_bytes, 0u);
+      first_output_times.push_back(result.time_to_first_output);
+      total_times.push_back(result.total_time);
+      peak_memory = std::max(peak_memory, result.peak_memory);
+    }
+
+    perf_test::PerfResultReporter reporter = SetUpReporter(story);
+    const base::TimeDelta total_time = Median(total_times);
+    reporter.AddResult(kMetricThroughput,
+                       body.size() / total_time.InSecondsF());
+    reporter.AddResult(kMetricTimeToFirstOutput, Median(first_output_times));
+    reporter.AddResult(kMetricTotalTime, total_time);
+    reporter.AddResult(kMetricPeakMemory, peak_memory);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  TestingBraveComponentUpdaterDelegate component_delegate_;
+  std::unique_ptr<SpeedreaderRewriterService> rewriter_service_;
+  std::vector<base::FilePath> corpus_;
+};
+
+TEST_F(SpeedreaderPerfTest, Corpus) {
+  for (const base::FilePath& page : corpus_)
+    RunStory(page);
+}
+
+}  // namespace speedreader
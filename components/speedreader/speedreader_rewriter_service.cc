@@ -11,6 +11,7 @@
 #include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
@@ -20,11 +21,14 @@
 #include "components/grit/brave_components_resources.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
+#include "url/origin.h"
 
 namespace speedreader {
 
 namespace {
 
+constexpr size_t kRewriterConfigPoolSize = 8;
+
 std::string GetDistilledPageStylesheet(const base::FilePath& stylesheet_path) {
   std::string stylesheet;
   const bool success = base::ReadFileToString(stylesheet_path, &stylesheet);
@@ -43,7 +47,12 @@ std::string GetDistilledPageStylesheet(const base::FilePath& stylesheet_path) {
 SpeedreaderRewriterService::SpeedreaderRewriterService(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : component_(new speedreader::SpeedreaderComponent(delegate)),
-      speedreader_(new speedreader::SpeedReader) {
+      speedreader_(new speedreader::SpeedReader),
+      config_pool_(kRewriterConfigPoolSize),
+      memory_pressure_listener_(
+          FROM_HERE,
+          base::BindRepeating(&SpeedreaderRewriterService::OnMemoryPressure,
+                              base::Unretained(this))) {
   if (base::FeatureList::IsEnabled(kSpeedreaderLegacyBackend)) {
     backend_ = RewriterType::RewriterStreaming;
   }
@@ -72,6 +81,14 @@ SpeedreaderRewriterService::~SpeedreaderRewriterService() {
   component_->RemoveObserver(this);
 }
 
+void SpeedreaderRewriterService::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+    return;
+  // Rewriters keep their own reference, so only idle configurations go.
+  config_pool_.Clear();
+}
+
 void SpeedreaderRewriterService::OnWhitelistReady(const base::FilePath& path) {
   VLOG(2) << "Whitelist ready at " << path;
   base::ThreadPool::PostTaskAndReplyWithResult(
@@ -113,9 +130,62 @@ bool SpeedreaderRewriterService::IsWhitelisted(const GURL& url) {
 
 std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeRewriter(
     const GURL& url) {
+  if (base::FeatureList::IsEnabled(kSpeedreaderRewriterConfigPool)) {
+    return speedreader_->MakeRewriter(url.spec(), backend_,
+                                      GetRewriterConfig(url));
+  }
   return speedreader_->MakeRewriter(url.spec(), backend_);
 }
 
+std::unique_ptr<Rewriter> SpeedreaderRewriterService::MakeStreamingRewriter(
+    const GURL& url,
+    void (*output_sink)(const char*, size_t, void*),
+    void* output_sink_user_data) {
+  DCHECK(SupportsStreaming());
+  if (base::FeatureList::IsEnabled(kSpeedreaderRewriterConfigPool)) {
+    return speedreader_->MakeRewriter(url.spec(), backend_,
+                                      GetRewriterConfig(url), output_sink,
+                                      output_sink_user_data);
+  }
+  return speedreader_->MakeRewriter(url.spec(), backend_, output_sink,
+                                    output_sink_user_data);
+}
+
+void SpeedreaderRewriterService::WarmUp(const GURL& url) {
+  if (!base::FeatureList::IsEnabled(kSpeedreaderRewriterConfigPool) ||
+      !IsWhitelisted(url)) {
+    return;
+  }
+  const std::string origin = url::Origin::Create(url).Serialize();
+  if (config_pool_.Get(origin) != config_pool_.end())
+    return;
+  VLOG(2) << "Speedreader warming up rewriter config for " << origin;
+  config_pool_.Put(origin, speedreader_->MakeRewriterConfig(url.spec()));
+}
+
+std::shared_ptr<RewriterConfig> SpeedreaderRewriterService::GetRewriterConfig(
+    const GURL& url) {
+  const std::string origin = url::Origin::Create(url).Serialize();
+  auto it = config_pool_.Get(origin);
+  // The use count only grows on this thread, so a count of one means no
+  // rewriter holds the pooled configuration.
+  if (it != config_pool_.end() && it->second.use_count() == 1) {
+    UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.RewriterConfigPoolHit", true);
+    return it->second;
+  }
+
+  UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.RewriterConfigPoolHit", false);
+  std::shared_ptr<RewriterConfig> config =
+      speedreader_->MakeRewriterConfig(url.spec());
+  if (it == config_pool_.end())
+    config_pool_.Put(origin, config);
+  return config;
+}
+
+bool SpeedreaderRewriterService::SupportsStreaming() const {
+  return backend_ == RewriterType::RewriterStreaming;
+}
+
 const std::string& SpeedreaderRewriterService::GetContentStylesheet() {
   return content_stylesheet_;
 }
@@ -128,8 +198,11 @@ void SpeedreaderRewriterService::OnLoadStylesheet(std::string stylesheet) {
 void SpeedreaderRewriterService::OnLoadDATFileData(
     GetDATFileDataResult result) {
   VLOG(2) << "Speedreader loaded from DAT file";
-  if (result.first)
+  if (result.first) {
     speedreader_ = std::move(result.first);
+    // Configurations built from the previous whitelist are stale.
+    config_pool_.Clear();
+  }
 }
 
 }  // namespace speedreader
@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/mru_cache.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
@@ -45,6 +47,18 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   // The API
   bool IsWhitelisted(const GURL& url);
   std::unique_ptr<Rewriter> MakeRewriter(const GURL& url);
+  // Creates a rewriter that hands each chunk of output to |output_sink| as it
+  // is produced. Only valid when SupportsStreaming() is true.
+  std::unique_ptr<Rewriter> MakeStreamingRewriter(
+      const GURL& url,
+      void (*output_sink)(const char*, size_t, void*),
+      void* output_sink_user_data);
+  // Whether the backend can rewrite a document incrementally. The readability
+  // backend needs the whole document before it can produce anything.
+  bool SupportsStreaming() const;
+  // Builds the rewriter configuration for |url|'s origin ahead of the
+  // navigation, e.g. while it is being typed in the omnibox.
+  void WarmUp(const GURL& url);
   const std::string& GetContentStylesheet();
 
  private:
@@ -53,6 +67,12 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
 
   void OnLoadDATFileData(GetDATFileDataResult result);
   void OnLoadStylesheet(std::string stylesheet);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  // Returns a configuration for |url|'s origin that no other rewriter is
+  // using, from the pool when possible.
+  std::shared_ptr<RewriterConfig> GetRewriterConfig(const GURL& url);
 
   // Default backend is an Arc90 implementation.
   RewriterType backend_ = RewriterType::RewriterReadability;
@@ -60,6 +80,11 @@ class SpeedreaderRewriterService : public SpeedreaderComponent::Observer {
   std::string content_stylesheet_;
   std::unique_ptr<speedreader::SpeedreaderComponent> component_;
   std::unique_ptr<speedreader::SpeedReader> speedreader_;
+  // Configurations keyed by origin. Each one is handed to one rewriter at a
+  // time; rewriters run on worker threads and the Rust configuration isn't
+  // meant to be shared between them.
+  base::MRUCache<std::string, std::shared_ptr<RewriterConfig>> config_pool_;
+  base::MemoryPressureListener memory_pressure_listener_;
   base::WeakPtrFactory<SpeedreaderRewriterService> weak_factory_{this};
 };
 
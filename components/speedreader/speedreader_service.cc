@@ -5,9 +5,12 @@
 
 #include "brave/components/speedreader/speedreader_service.h"
 
+#include <utility>
+
 #include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
 #include "brave/components/speedreader/features.h"
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
 #include "brave/components/speedreader/speedreader_pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -74,7 +77,10 @@ void RecordHistograms(PrefService* prefs, bool toggled, bool enabled_now) {
 
 }  // namespace
 
-SpeedreaderService::SpeedreaderService(PrefService* prefs) : prefs_(prefs) {}
+SpeedreaderService::SpeedreaderService(
+    PrefService* prefs,
+    std::unique_ptr<SpeedreaderDistilledCache> distilled_cache)
+    : prefs_(prefs), distilled_cache_(std::move(distilled_cache)) {}
 
 SpeedreaderService::~SpeedreaderService() {}
 
@@ -15,9 +15,15 @@ class PrefService;
 
 namespace speedreader {
 
+class SpeedreaderDistilledCache;
+
 class SpeedreaderService : public KeyedService {
  public:
-  explicit SpeedreaderService(PrefService* prefs);
+  // |distilled_cache| is null for profiles that must not keep distilled pages
+  // on disk.
+  SpeedreaderService(PrefService* prefs,
+                     std::unique_ptr<SpeedreaderDistilledCache>
+                         distilled_cache);
   ~SpeedreaderService() override;
 
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
@@ -27,12 +33,16 @@ class SpeedreaderService : public KeyedService {
   bool IsEnabled();
   bool ShouldPromptUserToEnable() const;
   void IncrementPromptCount();
+  SpeedreaderDistilledCache* distilled_cache() {
+    return distilled_cache_.get();
+  }
 
   SpeedreaderService(const SpeedreaderService&) = delete;
   SpeedreaderService& operator=(const SpeedreaderService&) = delete;
 
  private:
   PrefService* prefs_ = nullptr;
+  std::unique_ptr<SpeedreaderDistilledCache> distilled_cache_;
 };
 
 }  // namespace speedreader
@@ -5,8 +5,10 @@
 
 #include "brave/components/speedreader/speedreader_throttle.h"
 
+#include <string>
 #include <utility>
 
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
 #include "brave/components/speedreader/speedreader_result_delegate.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_url_loader.h"
@@ -16,6 +18,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
+#include "net/http/http_response_headers.h"
 #include "services/network/public/mojom/url_response_head.mojom.h"
 
 namespace speedreader {
@@ -23,6 +26,7 @@ namespace speedreader {
 std::unique_ptr<SpeedReaderThrottle>
 SpeedReaderThrottle::MaybeCreateThrottleFor(
     SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
     HostContentSettingsMap* content_settings,
     base::WeakPtr<SpeedreaderResultDelegate> result_delegate,
     const GURL& url,
@@ -31,15 +35,17 @@ SpeedReaderThrottle::MaybeCreateThrottleFor(
   if (check_disabled_sites && !IsEnabledForSite(content_settings, url))
     return nullptr;
 
-  return std::make_unique<SpeedReaderThrottle>(rewriter_service,
-                                               result_delegate, task_runner);
+  return std::make_unique<SpeedReaderThrottle>(
+      rewriter_service, distilled_cache, result_delegate, task_runner);
 }
 
 SpeedReaderThrottle::SpeedReaderThrottle(
     SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
     base::WeakPtr<SpeedreaderResultDelegate> result_delegate,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner)
     : rewriter_service_(rewriter_service),
+      distilled_cache_(std::move(distilled_cache)),
       result_delegate_(result_delegate),
       task_runner_(std::move(task_runner)) {}
 
@@ -53,15 +59,22 @@ void SpeedReaderThrottle::WillProcessResponse(
   // Pause the response until Speedreader has done its job.
   *defer = true;
 
+  std::string distilled_cache_key;
+  if (distilled_cache_) {
+    distilled_cache_key = SpeedreaderDistilledCache::MakeKey(
+        response_url, response_head->headers.get());
+  }
+
   mojo::PendingRemote<network::mojom::URLLoader> new_remote;
   mojo::PendingReceiver<network::mojom::URLLoaderClient> new_receiver;
   mojo::PendingRemote<network::mojom::URLLoader> source_loader;
   mojo::PendingReceiver<network::mojom::URLLoaderClient> source_client_receiver;
   SpeedReaderURLLoader* speedreader_loader;
   std::tie(new_remote, new_receiver, speedreader_loader) =
-      SpeedReaderURLLoader::CreateLoader(weak_factory_.GetWeakPtr(),
-                                         result_delegate_, response_url,
-                                         task_runner_, rewriter_service_);
+      SpeedReaderURLLoader::CreateLoader(
+          weak_factory_.GetWeakPtr(), result_delegate_, response_url,
+          task_runner_, rewriter_service_, distilled_cache_,
+          std::move(distilled_cache_key));
   delegate_->InterceptResponse(std::move(new_remote), std::move(new_receiver),
                                &source_loader, &source_client_receiver);
   speedreader_loader->Start(std::move(source_loader),
@@ -19,18 +19,19 @@ class HostContentSettingsMap;
 
 namespace speedreader {
 
+class SpeedreaderDistilledCache;
 class SpeedreaderRewriterService;
 
 // Launches the speedreader distillation pass over a reponce body, deferring
-// the load until distillation is done.
-// TODO(iefremov): Avoid distilling the same page twice (see comments in
-// blink::URLLoaderThrottle)?
+// the load until distillation is done. If |distilled_cache| is set, a page
+// distilled earlier with the same validators is served from it instead.
 // TODO(iefremov): Check throttles order?
 // Cargoculted from |MimeSniffingThrottle|.
 class SpeedReaderThrottle : public blink::URLLoaderThrottle {
  public:
   static std::unique_ptr<SpeedReaderThrottle> MaybeCreateThrottleFor(
       SpeedreaderRewriterService* rewriter_service,
+      base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
       HostContentSettingsMap* content_settings,
       base::WeakPtr<SpeedreaderResultDelegate> result_delegate,
       const GURL& url,
@@ -41,6 +42,7 @@ class SpeedReaderThrottle : public blink::URLLoaderThrottle {
   // IPC in SpeedReaderLoader. |task_runner| is supposed to be bound to the
   // current sequence.
   SpeedReaderThrottle(SpeedreaderRewriterService* rewriter_service,
+                      base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
                       base::WeakPtr<SpeedreaderResultDelegate> result_delegate,
                       scoped_refptr<base::SingleThreadTaskRunner> task_runner);
   ~SpeedReaderThrottle() override;
@@ -58,6 +60,7 @@ class SpeedReaderThrottle : public blink::URLLoaderThrottle {
 
  private:
   SpeedreaderRewriterService* rewriter_service_;  // not owned
+  base::WeakPtr<SpeedreaderDistilledCache> distilled_cache_;
   base::WeakPtr<SpeedreaderResultDelegate> result_delegate_;
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   base::WeakPtrFactory<SpeedReaderThrottle> weak_factory_{this};
@@ -10,10 +10,13 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "brave/components/speedreader/features.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
+#include "brave/components/speedreader/speedreader_distilled_cache.h"
 #include "brave/components/speedreader/speedreader_result_delegate.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
 #include "brave/components/speedreader/speedreader_throttle.h"
@@ -29,6 +32,48 @@ constexpr uint32_t kReadBufferSize = 32768;
 
 }  // namespace
 
+// Owns a streaming Rewriter on the worker sequence and collects whatever
+// output each Write() or End() produces. If the rewriter fails the rest of the
+// document is passed through untouched, since part of the output may already
+// have been sent.
+class SpeedReaderURLLoader::StreamingRewriter {
+ public:
+  StreamingRewriter(SpeedreaderRewriterService* rewriter_service,
+                    const GURL& url)
+      : rewriter_(rewriter_service->MakeStreamingRewriter(url, &OnOutput,
+                                                          this)) {}
+  StreamingRewriter(const StreamingRewriter&) = delete;
+  StreamingRewriter& operator=(const StreamingRewriter&) = delete;
+  ~StreamingRewriter() = default;
+
+  std::string Write(std::string chunk) {
+    if (passthrough_)
+      return chunk;
+    if (rewriter_->Write(chunk.data(), chunk.length()) != 0) {
+      VLOG(2) << "Speedreader streaming rewrite failed, passing through";
+      passthrough_ = true;
+      output_.append(chunk);
+    }
+    return std::move(output_);
+  }
+
+  std::string End() {
+    if (!passthrough_)
+      rewriter_->End();
+    return std::move(output_);
+  }
+
+ private:
+  static void OnOutput(const char* chunk, size_t chunk_len, void* user_data) {
+    static_cast<StreamingRewriter*>(user_data)->output_.append(chunk,
+                                                               chunk_len);
+  }
+
+  std::string output_;
+  bool passthrough_ = false;
+  std::unique_ptr<Rewriter> rewriter_;
+};
+
 // static
 std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
            mojo::PendingReceiver<network::mojom::URLLoaderClient>,
@@ -38,7 +83,9 @@ SpeedReaderURLLoader::CreateLoader(
     base::WeakPtr<SpeedreaderResultDelegate> delegate,
     const GURL& response_url,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-    SpeedreaderRewriterService* rewriter_service) {
+    SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
+    std::string distilled_cache_key) {
   mojo::PendingRemote<network::mojom::URLLoader> url_loader;
   mojo::PendingRemote<network::mojom::URLLoaderClient> url_loader_client;
   mojo::PendingReceiver<network::mojom::URLLoaderClient>
@@ -47,7 +94,8 @@ SpeedReaderURLLoader::CreateLoader(
 
   auto loader = base::WrapUnique(new SpeedReaderURLLoader(
       std::move(throttle), std::move(delegate), response_url,
-      std::move(url_loader_client), std::move(task_runner), rewriter_service));
+      std::move(url_loader_client), std::move(task_runner), rewriter_service,
+      std::move(distilled_cache), std::move(distilled_cache_key)));
   SpeedReaderURLLoader* loader_rawptr = loader.get();
   mojo::MakeSelfOwnedReceiver(std::move(loader),
                               url_loader.InitWithNewPipeAndPassReceiver());
@@ -62,7 +110,9 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
     mojo::PendingRemote<network::mojom::URLLoaderClient>
         destination_url_loader_client,
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-    SpeedreaderRewriterService* rewriter_service)
+    SpeedreaderRewriterService* rewriter_service,
+    base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
+    std::string distilled_cache_key)
     : throttle_(throttle),
       delegate_(delegate),
       destination_url_loader_client_(std::move(destination_url_loader_client)),
@@ -74,7 +124,9 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
-      rewriter_service_(rewriter_service) {}
+      rewriter_service_(rewriter_service),
+      distilled_cache_(std::move(distilled_cache)),
+      distilled_cache_key_(std::move(distilled_cache_key)) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
 
@@ -126,8 +178,25 @@ void SpeedReaderURLLoader::OnTransferSizeUpdated(int32_t transfer_size_diff) {
 void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
-  state_ = State::kLoading;
   body_consumer_handle_ = std::move(body);
+  if (base::FeatureList::IsEnabled(kSpeedreaderStreamingRewrite) &&
+      rewriter_service_ && rewriter_service_->SupportsStreaming()) {
+    rewrite_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::TaskPriority::USER_BLOCKING});
+    StartStreaming(
+        std::make_unique<StreamingRewriter>(rewriter_service_, response_url_));
+    return;
+  }
+
+  state_ = State::kLoading;
+  if (distilled_cache_ && !distilled_cache_key_.empty()) {
+    // Look the page up while the body is being buffered.
+    cache_lookup_pending_ = true;
+    distilled_cache_->Get(
+        distilled_cache_key_,
+        base::BindOnce(&SpeedReaderURLLoader::OnDistilledCacheLookup,
+                       weak_factory_.GetWeakPtr()));
+  }
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
       MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
@@ -153,6 +222,7 @@ void SpeedReaderURLLoader::OnComplete(
       return;
     case State::kLoading:
     case State::kSending:
+    case State::kStreaming:
       // Defer calling OnComplete() until distilling has finished and all
       // data is sent.
       complete_status_ = status;
@@ -210,6 +280,10 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
       buffered_body_.resize(start_size);
+      if (cache_lookup_pending_) {
+        body_read_ = true;
+        return;
+      }
       MaybeLaunchSpeedreader();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
@@ -226,10 +300,34 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   // but skipping it for now to simplify things. Pumping is not free in terms
   // of CPU ticks, so we will have to keep alive speedreader instance on another
   // thread.
+  if (MaybeBailOutEarly())
+    return;
 
   body_consumer_watcher_.ArmOrNotify();
 }
 
+bool SpeedReaderURLLoader::MaybeBailOutEarly() {
+  DCHECK_EQ(State::kLoading, state_);
+  if (preclassified_ || cached_distilled_ ||
+      !base::FeatureList::IsEnabled(kSpeedreaderPreclassifier)) {
+    return false;
+  }
+  preclassified_ = true;
+
+  const Preclassification result = PreclassifyDocument(
+      response_url_.spec(), buffered_body_.data(), buffered_body_.size());
+  UMA_HISTOGRAM_ENUMERATION(
+      "Brave.Speedreader.Preclassification", static_cast<int>(result),
+      static_cast<int>(Preclassification::PreclassifyUnknown) + 1);
+  if (result != Preclassification::PreclassifyNotReadable)
+    return false;
+
+  VLOG(2) << __func__ << " not an article, passing through " << response_url_;
+  distilling_ = false;
+  StartStreaming(nullptr);
+  return true;
+}
+
 void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
   if (bytes_remaining_in_buffer_ > 0) {
@@ -246,6 +344,12 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
     return;
   }
 
+  if (cached_distilled_) {
+    VLOG(2) << __func__ << " serving cached distilled page " << response_url_;
+    CompleteLoading(std::move(*cached_distilled_));
+    return;
+  }
+
   VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
@@ -260,7 +364,7 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
               int written = rewriter->Write(data.c_str(), data.length());
               // Error occurred
               if (written != 0) {
-                return data;
+                return std::make_pair(std::move(data), false);
               }
 
               rewriter->End();
@@ -270,21 +374,42 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
               // explicit signal back from rewriter to indicate if content was
               // found
               if (transformed.length() < 1024) {
-                return data;
+                return std::make_pair(std::move(data), false);
               }
 
-              return stylesheet + transformed;
+              return std::make_pair(stylesheet + transformed, true);
             },
             std::move(buffered_body_),
             rewriter_service_->MakeRewriter(response_url_),
             rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
+        base::BindOnce(&SpeedReaderURLLoader::OnDistilled,
                        weak_factory_.GetWeakPtr()));
     return;
   }
   CompleteLoading(std::move(buffered_body_));
 }
 
+void SpeedReaderURLLoader::OnDistilledCacheLookup(
+    absl::optional<std::string> distilled) {
+  // The classifier may have switched to pass-through in the meantime.
+  if (state_ != State::kLoading)
+    return;
+  cache_lookup_pending_ = false;
+  UMA_HISTOGRAM_BOOLEAN("Brave.Speedreader.DistilledCacheHit",
+                        distilled.has_value());
+  // The body is still drained from the source, otherwise it would fail the
+  // request, but it is no longer distilled.
+  cached_distilled_ = std::move(distilled);
+  if (body_read_)
+    MaybeLaunchSpeedreader();
+}
+
+void SpeedReaderURLLoader::OnDistilled(std::pair<std::string, bool> result) {
+  if (result.second && distilled_cache_ && !distilled_cache_key_.empty())
+    distilled_cache_->Put(distilled_cache_key_, result.first);
+  CompleteLoading(std::move(result.first));
+}
+
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
@@ -335,7 +460,7 @@ void SpeedReaderURLLoader::CompleteSending() {
     // TODO(keur, iefremov): This API could probably be improved with an enum
     // indicating distill success, distill fail, load from cache.
     // |complete_status_| has an |exists_in_cache| field.
-    if (delegate_)
+    if (delegate_ && distilling_)
       delegate_->OnDistillComplete();
   }
 
@@ -346,7 +471,7 @@ void SpeedReaderURLLoader::CompleteSending() {
 }
 
 void SpeedReaderURLLoader::SendReceivedBodyToClient() {
-  DCHECK_EQ(State::kSending, state_);
+  DCHECK(state_ == State::kSending || state_ == State::kStreaming);
   // Send the buffered data first.
   DCHECK_GT(bytes_remaining_in_buffer_, 0u);
   size_t start_position = buffered_body_.size() - bytes_remaining_in_buffer_;
@@ -373,6 +498,140 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
   body_producer_watcher_.ArmOrNotify();
 }
 
+void SpeedReaderURLLoader::StartStreaming(
+    std::unique_ptr<StreamingRewriter> rewriter) {
+  state_ = State::kStreaming;
+  if (!throttle_) {
+    Abort();
+    return;
+  }
+
+  if (rewriter) {
+    DCHECK(rewrite_task_runner_);
+    streaming_rewriter_ =
+        std::unique_ptr<StreamingRewriter, base::OnTaskRunnerDeleter>(
+            rewriter.release(),
+            base::OnTaskRunnerDeleter(rewrite_task_runner_));
+  }
+
+  throttle_->Resume();
+  mojo::ScopedDataPipeConsumerHandle body_to_send;
+  MojoResult result =
+      mojo::CreateDataPipe(nullptr, body_producer_handle_, body_to_send);
+  if (result != MOJO_RESULT_OK) {
+    Abort();
+    return;
+  }
+  body_producer_watcher_.Watch(
+      body_producer_handle_.get(),
+      MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+      base::BindRepeating(&SpeedReaderURLLoader::OnStreamingBodyWritable,
+                          base::Unretained(this)));
+  // Passing through after the classifier bailed out replaces the buffering
+  // watcher.
+  body_consumer_watcher_.Cancel();
+  body_consumer_watcher_.Watch(
+      body_consumer_handle_.get(),
+      MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+      base::BindRepeating(&SpeedReaderURLLoader::OnStreamingBodyReadable,
+                          base::Unretained(this)));
+  destination_url_loader_client_->OnStartLoadingResponseBody(
+      std::move(body_to_send));
+
+  if (streaming_rewriter_) {
+    // The stylesheet goes out ahead of the distilled content, just like in the
+    // buffered mode.
+    buffered_body_ = rewriter_service_->GetContentStylesheet();
+  }
+  // When passing through, whatever was buffered so far goes out first.
+  bytes_remaining_in_buffer_ = buffered_body_.size();
+  PumpStreaming();
+}
+
+void SpeedReaderURLLoader::OnStreamingBodyReadable(MojoResult) {
+  DCHECK_EQ(State::kStreaming, state_);
+  DCHECK(!rewrite_in_flight_);
+
+  std::string chunk(kReadBufferSize, '\0');
+  uint32_t read_bytes = kReadBufferSize;
+  MojoResult result = body_consumer_handle_->ReadData(
+      &chunk[0], &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+  switch (result) {
+    case MOJO_RESULT_OK:
+      chunk.resize(read_bytes);
+      if (!streaming_rewriter_) {
+        OnStreamingOutput(false, std::move(chunk));
+        return;
+      }
+      rewrite_in_flight_ = true;
+      rewrite_task_runner_->PostTaskAndReplyWithResult(
+          FROM_HERE,
+          base::BindOnce(&StreamingRewriter::Write,
+                         base::Unretained(streaming_rewriter_.get()),
+                         std::move(chunk)),
+          base::BindOnce(&SpeedReaderURLLoader::OnStreamingOutput,
+                         weak_factory_.GetWeakPtr(), false));
+      return;
+    case MOJO_RESULT_FAILED_PRECONDITION:
+      // Reading is finished.
+      if (!streaming_rewriter_) {
+        OnStreamingOutput(true, std::string());
+        return;
+      }
+      rewrite_in_flight_ = true;
+      rewrite_task_runner_->PostTaskAndReplyWithResult(
+          FROM_HERE,
+          base::BindOnce(&StreamingRewriter::End,
+                         base::Unretained(streaming_rewriter_.get())),
+          base::BindOnce(&SpeedReaderURLLoader::OnStreamingOutput,
+                         weak_factory_.GetWeakPtr(), true));
+      return;
+    case MOJO_RESULT_SHOULD_WAIT:
+      body_consumer_watcher_.ArmOrNotify();
+      return;
+    default:
+      NOTREACHED();
+      return;
+  }
+}
+
+void SpeedReaderURLLoader::OnStreamingBodyWritable(MojoResult) {
+  DCHECK_EQ(State::kStreaming, state_);
+  PumpStreaming();
+}
+
+void SpeedReaderURLLoader::OnStreamingOutput(bool input_done,
+                                             std::string output) {
+  if (state_ != State::kStreaming)
+    return;
+  rewrite_in_flight_ = false;
+  streaming_input_done_ = input_done;
+  if (!output.empty()) {
+    // Drop what has already been sent before queueing the new output.
+    buffered_body_.erase(0, buffered_body_.size() - bytes_remaining_in_buffer_);
+    buffered_body_.append(output);
+    bytes_remaining_in_buffer_ = buffered_body_.size();
+  }
+  PumpStreaming();
+}
+
+void SpeedReaderURLLoader::PumpStreaming() {
+  DCHECK_EQ(State::kStreaming, state_);
+  if (bytes_remaining_in_buffer_ > 0) {
+    // Re-enters through OnStreamingBodyWritable once the pipe has room.
+    SendReceivedBodyToClient();
+    return;
+  }
+  if (rewrite_in_flight_)
+    return;
+  if (streaming_input_done_) {
+    state_ = State::kSending;
+    CompleteSending();
+    return;
+  }
+  body_consumer_watcher_.ArmOrNotify();
+}
+
 void SpeedReaderURLLoader::Abort() {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kAborted;
@@ -8,10 +8,12 @@
 
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
 #include "brave/components/speedreader/speedreader_result_delegate.h"
@@ -29,6 +31,7 @@
 namespace speedreader {
 
 class SpeedReaderThrottle;
+class SpeedreaderDistilledCache;
 class SpeedreaderRewriterService;
 
 // Loads the whole response body and tries to Speedreader-distill it.
@@ -46,8 +49,18 @@ class SpeedreaderRewriterService;
 //            done, this loader will dispatch queued messages like
 //            OnStartLoadingResponseBody() to the destination
 //            loader client, and then the state is changed to kSending.
+//            If the first chunk shows the page is not an article, the state
+//            changes to kStreaming without a rewriter, which passes the body
+//            through untouched. If the distilled cache has the page, the
+//            cached version is sent instead of distilling the body.
 // kSending: Receives the body and sends it to the destination loader client.
 //           The state changes to kCompleted after all data is sent.
+// kStreaming: Used instead of kLoading and kSending when the rewriter backend
+//             supports streaming. The response is resumed right away, each
+//             chunk read from the source loader is fed to the rewriter on a
+//             worker sequence, and its output is forwarded to the destination
+//             loader client as soon as it is available. The state changes to
+//             kCompleted after the rewriter has ended and all output is sent.
 // kCompleted: All data has been sent to the destination loader.
 // kAborted: Unexpected behavior happens. Watchers, pipes and the binding from
 //           the source loader to |this| are stopped. All incoming messages from
@@ -75,7 +88,9 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
                base::WeakPtr<SpeedreaderResultDelegate> delegate,
                const GURL& response_url,
                scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-               SpeedreaderRewriterService* rewriter_service);
+               SpeedreaderRewriterService* rewriter_service,
+               base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
+               std::string distilled_cache_key);
 
  private:
   SpeedReaderURLLoader(base::WeakPtr<SpeedReaderThrottle> throttle,
@@ -84,7 +99,9 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
                        mojo::PendingRemote<network::mojom::URLLoaderClient>
                            destination_url_loader_client,
                        scoped_refptr<base::SingleThreadTaskRunner> task_runner,
-                       SpeedreaderRewriterService* rewriter_service);
+                       SpeedreaderRewriterService* rewriter_service,
+                       base::WeakPtr<SpeedreaderDistilledCache> distilled_cache,
+                       std::string distilled_cache_key);
 
   // network::mojom::URLLoaderClient implementation (called from the source of
   // the response):
@@ -118,12 +135,31 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
+  void OnDistilledCacheLookup(absl::optional<std::string> distilled);
+  // |distilled| is false if the rewriter found nothing and |body| is the
+  // original page.
+  void OnDistilled(std::pair<std::string, bool> result);
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
   void CompleteSending();
   void SendReceivedBodyToClient();
 
+  // Streaming mode, see kStreaming above.
+  class StreamingRewriter;
+  // Starts forwarding the body as it arrives, through |rewriter| if set or
+  // untouched otherwise.
+  void StartStreaming(std::unique_ptr<StreamingRewriter> rewriter);
+  // Runs the cheap classifier on the first buffered chunk. Returns true if
+  // loading switched to pass-through.
+  bool MaybeBailOutEarly();
+  void OnStreamingBodyReadable(MojoResult);
+  void OnStreamingBodyWritable(MojoResult);
+  void OnStreamingOutput(bool input_done, std::string output);
+  // Advances the streaming pipeline: sends pending output, then reads the
+  // next chunk once the rewriter is idle.
+  void PumpStreaming();
+
   void Abort();
 
   base::WeakPtr<SpeedReaderThrottle> throttle_;
@@ -138,7 +174,14 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
-  enum class State { kWaitForBody, kLoading, kSending, kCompleted, kAborted };
+  enum class State {
+    kWaitForBody,
+    kLoading,
+    kSending,
+    kStreaming,
+    kCompleted,
+    kAborted
+  };
   State state_ = State::kWaitForBody;
 
   // Set if OnComplete() is called during distilling.
@@ -156,6 +199,25 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   // Not Owned
   SpeedreaderRewriterService* rewriter_service_;
 
+  // Empty |distilled_cache_key_| means the response can't be cached.
+  base::WeakPtr<SpeedreaderDistilledCache> distilled_cache_;
+  std::string distilled_cache_key_;
+  bool cache_lookup_pending_ = false;
+  absl::optional<std::string> cached_distilled_;
+  // Set if the body was fully read while the cache lookup was pending.
+  bool body_read_ = false;
+
+  // Only used in streaming mode. The rewriter lives on
+  // |rewrite_task_runner_|.
+  scoped_refptr<base::SequencedTaskRunner> rewrite_task_runner_;
+  std::unique_ptr<StreamingRewriter, base::OnTaskRunnerDeleter>
+      streaming_rewriter_{nullptr, base::OnTaskRunnerDeleter(nullptr)};
+  bool rewrite_in_flight_ = false;
+  bool streaming_input_done_ = false;
+  bool preclassified_ = false;
+  // False when the body is passed through, so no distill result is reported.
+  bool distilling_ = true;
+
   base::WeakPtrFactory<SpeedReaderURLLoader> weak_factory_{this};
 };
 
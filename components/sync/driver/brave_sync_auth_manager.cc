@@ -10,6 +10,7 @@
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_sync/crypto/crypto.h"
 #include "brave/components/brave_sync/network_time_helper.h"
+#include "crypto/sha2.h"
 
 namespace syncer {
 
@@ -34,6 +35,9 @@ void BraveSyncAuthManager::DeriveSigningKeys(const std::string& seed) {
   VLOG(1) << __func__;
   if (seed.empty())
     return;
+  const std::string seed_hash = crypto::SHA256HashString(seed);
+  if (!signing_keys_.empty() && seed_hash == seed_hash_)
+    return;
   const std::vector<uint8_t> HKDF_SALT = {
       72,  203, 156, 43,  64,  229, 225, 127, 214, 158, 50,  29,  130,
       186, 182, 207, 6,   108, 47,  254, 245, 71,  198, 109, 44,  108,
@@ -45,16 +49,17 @@ void BraveSyncAuthManager::DeriveSigningKeys(const std::string& seed) {
     return;
   const std::string info_str = "sync-auth-key";
   std::vector<uint8_t> info(info_str.begin(), info_str.end());
-  brave_sync::crypto::DeriveSigningKeysFromSeed(seed_bytes, &HKDF_SALT, &info,
-                                                &public_key_, &private_key_);
+  signing_keys_.Derive(seed_bytes, &HKDF_SALT, &info);
+  brave_sync::crypto::SecureZero(&seed_bytes);
+  seed_hash_ = seed_hash;
   if (registered_for_auth_notifications_)
     UpdateSyncAccountIfNecessary();
 }
 
 void BraveSyncAuthManager::ResetKeys() {
   VLOG(1) << __func__;
-  public_key_.clear();
-  private_key_.clear();
+  signing_keys_.Reset();
+  seed_hash_.clear();
   if (registered_for_auth_notifications_)
     UpdateSyncAccountIfNecessary();
 }
@@ -67,9 +72,10 @@ void BraveSyncAuthManager::RequestAccessToken() {
 }
 
 SyncAccountInfo BraveSyncAuthManager::DetermineAccountToUse() const {
-  if (!public_key_.empty()) {
+  if (!signing_keys_.empty()) {
+    const std::vector<uint8_t>& public_key = signing_keys_.public_key();
     const std::string client_id =
-        base::HexEncode(public_key_.data(), public_key_.size());
+        base::HexEncode(public_key.data(), public_key.size());
     AccountInfo account_info;
     account_info.account_id = CoreAccountId::FromString(client_id);
     account_info.gaia = client_id;
@@ -89,9 +95,10 @@ std::string BraveSyncAuthManager::GenerateAccessToken(
     const std::string& timestamp) {
   VLOG(1) << "timestamp=" << timestamp;
 
-  DCHECK(!timestamp.empty() && !public_key_.empty() && !private_key_.empty());
+  DCHECK(!timestamp.empty() && !signing_keys_.empty());
+  const std::vector<uint8_t>& public_key = signing_keys_.public_key();
   const std::string public_key_hex =
-      base::HexEncode(public_key_.data(), public_key_.size());
+      base::HexEncode(public_key.data(), public_key.size());
 
   const std::string timestamp_hex =
       base::HexEncode(timestamp.data(), timestamp.size());
@@ -99,8 +106,9 @@ std::string BraveSyncAuthManager::GenerateAccessToken(
   std::vector<uint8_t> timestamp_bytes;
   base::HexStringToBytes(timestamp_hex, &timestamp_bytes);
   std::vector<uint8_t> signature;
-  brave_sync::crypto::Sign(timestamp_bytes, private_key_, &signature);
-  DCHECK(brave_sync::crypto::Verify(timestamp_bytes, signature, public_key_));
+  brave_sync::crypto::Sign(timestamp_bytes, signing_keys_.private_key(),
+                           &signature);
+  DCHECK(brave_sync::crypto::Verify(timestamp_bytes, signature, public_key));
 
   const std::string signed_timestamp_hex =
       base::HexEncode(signature.data(), signature.size());
@@ -117,7 +125,7 @@ std::string BraveSyncAuthManager::GenerateAccessToken(
 
 void BraveSyncAuthManager::OnNetworkTimeFetched(const base::Time& time) {
   std::string timestamp = std::to_string(int64_t(time.ToJsTime()));
-  if (public_key_.empty() || private_key_.empty())
+  if (signing_keys_.empty())
     return;
   access_token_ = GenerateAccessToken(timestamp);
   if (registered_for_auth_notifications_)
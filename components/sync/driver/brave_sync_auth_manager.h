@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/time/time.h"
+#include "brave/components/brave_sync/crypto/crypto.h"
 #include "components/sync/driver/sync_auth_manager.h"
 
 namespace syncer {
@@ -21,6 +22,8 @@ class BraveSyncAuthManager : public SyncAuthManager {
                        const CredentialsChangedCallback& credentials_changed);
   ~BraveSyncAuthManager() override;
 
+  // Derives the signing keys from the sync code |seed|, unless they were
+  // already derived from it this session.
   void DeriveSigningKeys(const std::string& seed);
   void ResetKeys();
 
@@ -38,8 +41,9 @@ class BraveSyncAuthManager : public SyncAuthManager {
   std::string GenerateAccessToken(const std::string& timestamp);
   void OnNetworkTimeFetched(const base::Time& time);
 
-  std::vector<uint8_t> public_key_;
-  std::vector<uint8_t> private_key_;
+  brave_sync::crypto::SigningKeys signing_keys_;
+  // SHA-256 of the sync code |signing_keys_| come from.
+  std::string seed_hash_;
 
   base::WeakPtrFactory<BraveSyncAuthManager> weak_ptr_factory_{this};
 
@@ -132,6 +132,27 @@ TEST_F(BraveSyncAuthManagerTest, Reset) {
       auth_manager->GetActiveAccountInfo().account_info.account_id.empty());
 }
 
+TEST_F(BraveSyncAuthManagerTest, DeriveAfterReset) {
+  base::MockCallback<AccountStateChangedCallback> account_state_changed;
+  base::MockCallback<CredentialsChangedCallback> credentials_changed;
+  EXPECT_CALL(account_state_changed, Run()).Times(3);
+  auto auth_manager =
+      CreateAuthManager(account_state_changed.Get(), credentials_changed.Get());
+
+  auth_manager->RegisterForAuthNotifications();
+  auth_manager->DeriveSigningKeys(kSyncCode);
+  // The keys for the same sync code are kept rather than derived again.
+  auth_manager->DeriveSigningKeys(kSyncCode);
+  EXPECT_EQ(auth_manager->GetActiveAccountInfo().account_info.account_id,
+            CoreAccountId::FromString(kAccountId));
+
+  // Resetting drops them, so the same sync code derives them anew.
+  auth_manager->ResetKeys();
+  auth_manager->DeriveSigningKeys(kSyncCode);
+  EXPECT_EQ(auth_manager->GetActiveAccountInfo().account_info.account_id,
+            CoreAccountId::FromString(kAccountId));
+}
+
 TEST_F(BraveSyncAuthManagerTest, MalformedSyncCode) {
   base::MockCallback<AccountStateChangedCallback> account_state_changed;
   base::MockCallback<CredentialsChangedCallback> credentials_changed;
@@ -10,6 +10,8 @@ namespace prefs {
 
 const char kTorDisabled[] = "tor.tor_disabled";
 
+const char kTorPrelaunch[] = "tor.prelaunch";
+
 const char kAutoOnionRedirect[] = "tor.auto_onion_location";
 
 }  // namespace prefs
@@ -11,6 +11,9 @@ namespace prefs {
 
 extern const char kTorDisabled[];
 
+// Launch tor in the background at startup instead of on the first Tor window
+extern const char kTorPrelaunch[];
+
 // Automatically open onion available site or .onion domain in Tor window
 extern const char kAutoOnionRedirect[];
 
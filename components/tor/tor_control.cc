@@ -716,8 +716,8 @@ void TorControl::ReadDone(int rv) {
         // CRLF seen, so we must have i >= 2.  Emit a line and advance
         // to the next one, unless anything went wrong with the line.
         assert(i >= 1);
-        std::string line(readiobuf_->StartOfBuffer() + read_start_,
-                         readiobuf_->offset() + i - 1 - read_start_);
+        base::StringPiece line(readiobuf_->StartOfBuffer() + read_start_,
+                               readiobuf_->offset() + i - 1 - read_start_);
         read_start_ = readiobuf_->offset() + i + 1;
         read_cr_ = false;
         if (!ReadLine(line)) {
@@ -771,9 +771,11 @@ void TorControl::ReadDone(int rv) {
 // ReadLine(line)
 //
 //      We have read a line of input; process it.  Return true on
-//      success, false on error.
+//      success, false on error.  |line| points into the read buffer,
+//      so only what is handed to the delegate or command callbacks is
+//      copied out of it.
 //
-bool TorControl::ReadLine(const std::string& line) {
+bool TorControl::ReadLine(base::StringPiece line) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (line.size() < 4) {
@@ -788,26 +790,28 @@ bool TorControl::ReadLine(const std::string& line) {
   // intermediate reply and ` ' for a final reply.
   //
   // TODO(riastradh): parse or check syntax of status
-  std::string status(line, 0, 3);
+  base::StringPiece status = line.substr(0, 3);
   char pos = line[3];
-  std::string reply(line, 4);
+  base::StringPiece reply = line.substr(4);
 
   // Determine whether it is an asynchronous reply, status 6yz.
   if (status[0] == '6') {
     // Notify delegate of the raw reply.
-    NotifyTorRawAsync(status, reply);
+    NotifyTorRawAsync(std::string(status), std::string(reply));
 
     // Is this a new async reply?
     if (!async_) {
       // Parse the keyword and the initial line.
       const size_t sp = reply.find(' ');
-      std::string event_name, initial;
-      if (sp == std::string::npos) {
-        event_name = reply;
-      } else {
-        event_name = reply.substr(0, sp);
+      base::StringPiece event_name = reply.substr(0, sp);
+      base::StringPiece initial;
+      if (sp != base::StringPiece::npos)
         initial = reply.substr(sp + 1);
-      }
+
+      const auto& found = kTorControlEventByName.find(std::string(event_name));
+      const TorControlEvent event =
+          (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
+                                                 : (*found).second);
 
       // Discriminate on the position of the reply.
       switch (pos) {
@@ -815,12 +819,10 @@ bool TorControl::ReadLine(const std::string& line) {
           // Single-line async reply.
 
           // Bail if we don't recognize the event name.
-          const auto& found = kTorControlEventByName.find(event_name);
-          if (found == kTorControlEventByName.end()) {
+          if (event == TorControlEvent::INVALID) {
             VLOG(1) << "tor: unknown event: " << event_name;  // XXX escape
             return false;
           }
-          const TorControlEvent event = (*found).second;
 
           // Ignore if we don't think we're subscribed to this.
           if (!async_events_.count(event)) {
@@ -830,23 +832,21 @@ bool TorControl::ReadLine(const std::string& line) {
 
           // Notify the delegate of the parsed reply.  No extra
           // because there were no intermediate reply lines.
-          NotifyTorEvent(event, initial, {});
+          NotifyTorEvent(event, std::string(initial), {});
 
           return true;
         }
         case '-': {
           // Start of a multi-line async reply.
 
-          // Start a fresh async reply state.  Parse the rest, but
-          // skip it, if we don't recognize the event.
-          const auto& found = kTorControlEventByName.find(event_name);
-          const TorControlEvent event =
-              (found == kTorControlEventByName.end() ? TorControlEvent::INVALID
-                                                     : (*found).second);
+          // Start a fresh async reply state.  Skip the rest of it
+          // without parsing if we don't recognize the event or aren't
+          // subscribed to it.
           async_ = std::make_unique<Async>();
-          async_->event = event;
-          async_->initial = initial;
-          async_->skip = (event == TorControlEvent::INVALID);
+          async_->skip = !async_events_.count(event);
+          async_->event = async_->skip ? TorControlEvent::INVALID : event;
+          if (!async_->skip)
+            async_->initial = std::string(initial);
           return true;
         }
       }
@@ -873,12 +873,12 @@ bool TorControl::ReadLine(const std::string& line) {
             Error();
             return false;
           }
-          if (async_->extra.count(key)) {
+          if (!async_->extra.emplace(std::move(key), std::move(value))
+                   .second) {
             VLOG(1) << "tor: duplicate key in async continuation line";
             Error();
             return false;
           }
-          async_->extra[key] = value;
           return true;
         }
         case ' ': {
@@ -891,12 +891,12 @@ bool TorControl::ReadLine(const std::string& line) {
               Error();
               return false;
             }
-            if (async_->extra.count(key)) {
+            if (!async_->extra.emplace(std::move(key), std::move(value))
+                     .second) {
               VLOG(1) << "tor: duplicate key in async event";
               Error();
               return false;
             }
-            async_->extra[key] = value;
 
             // If we're still subscribed, notify the delegate of the
             // parsed reply.
@@ -913,26 +913,32 @@ bool TorControl::ReadLine(const std::string& line) {
     // Synchronous reply.  Return it to the next command callback in
     // the queue.
     switch (pos) {
-      case '-':
-        NotifyTorRawMid(status, reply);
+      case '-': {
+        const std::string status_str(status);
+        const std::string reply_str(reply);
+        NotifyTorRawMid(status_str, reply_str);
         if (!cmdq_.empty()) {
           PerLineCallback& perline = cmdq_.front().first;
-          perline.Run(status, reply);
+          perline.Run(status_str, reply_str);
         }
         return true;
+      }
       case '+':
         VLOG(2) << "tor: NYI: control data reply";
         // XXX Just ignore it for now.
         return true;
-      case ' ':
-        NotifyTorRawEnd(status, reply);
+      case ' ': {
+        const std::string status_str(status);
+        const std::string reply_str(reply);
+        NotifyTorRawEnd(status_str, reply_str);
         if (!cmdq_.empty()) {
           CmdCallback& callback = cmdq_.front().second;
           bool error = false;
-          std::move(callback).Run(error, status, reply);
+          std::move(callback).Run(error, status_str, reply_str);
           cmdq_.pop();
         }
         return true;
+      }
     }
   }
 
@@ -991,10 +997,9 @@ void TorControl::NotifyTorControlClosed() {
       base::BindOnce(&Delegate::OnTorControlClosed, delegate_, running_));
 }
 
-void TorControl::NotifyTorEvent(
-    TorControlEvent event,
-    const std::string& initial,
-    const std::map<std::string, std::string>& extra) {
+void TorControl::NotifyTorEvent(TorControlEvent event,
+                                const std::string& initial,
+                                const EventExtra& extra) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
   owner_task_runner_->PostTask(
       FROM_HERE,
@@ -1038,7 +1043,7 @@ void TorControl::NotifyTorRawEnd(const std::string& status,
 //      success, false on failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value) {
   size_t end;
@@ -1053,21 +1058,21 @@ bool TorControl::ParseKV(const std::string& string,
 //      failure.
 //
 // static
-bool TorControl::ParseKV(const std::string& string,
+bool TorControl::ParseKV(base::StringPiece string,
                          std::string* key,
                          std::string* value,
                          size_t* end) {
   DCHECK(key && value && end);
   // Search for `=' -- it had better be there.
-  size_t eq = string.find("=");
-  if (eq == std::string::npos)
+  size_t eq = string.find('=');
+  if (eq == base::StringPiece::npos)
     return false;
   size_t vstart = eq + 1;
 
   // If we're at the end of the string, value is empt.
   if (vstart == string.size()) {
-    *key = string.substr(0, eq);
-    *value = "";
+    key->assign(string.data(), eq);
+    value->clear();
     *end = string.size();
     return true;
   }
@@ -1076,7 +1081,7 @@ bool TorControl::ParseKV(const std::string& string,
   if (string[vstart] != '"') {
     // Not quoted.  Check for a delimiter.
     size_t i, vend = string.size();
-    if ((i = string.find(" ", vstart)) != std::string::npos) {
+    if ((i = string.find(' ', vstart)) != base::StringPiece::npos) {
       // Delimited.  Stop at the delimiter, and consume it.
       vend = i;
       *end = vend + 1;
@@ -1086,19 +1091,19 @@ bool TorControl::ParseKV(const std::string& string,
     }
 
     // Check for internal quotes; they are forbidden.
-    if ((i = string.find("\"", vstart)) != std::string::npos)
+    if ((i = string.find('"', vstart)) != base::StringPiece::npos)
       return false;
 
     // Extract the key and value and we're done.
-    *key = string.substr(0, eq);
-    *value = string.substr(vstart, vend - vstart);
+    key->assign(string.data(), eq);
+    value->assign(string.data() + vstart, vend - vstart);
     return true;
   }
 
   // Quoted string.  Parse it, and consume trailing spaces.
   if (!ParseQuoted(string.substr(eq + 1), value, end))
     return false;
-  *key = string.substr(0, eq);
+  key->assign(string.data(), eq);
   *end += eq + 1;
   while (*end < string.size() && string[*end] == ' ')
     (*end)++;
@@ -1113,7 +1118,7 @@ bool TorControl::ParseKV(const std::string& string,
 //      return false on failure.
 //
 // static
-bool TorControl::ParseQuoted(const std::string& string,
+bool TorControl::ParseQuoted(base::StringPiece string,
                              std::string* value,
                              size_t* end) {
   enum {
@@ -1238,7 +1243,8 @@ bool TorControl::ParseQuoted(const std::string& string,
       case REJECT:
         return false;
       case ACCEPT:
-        *value = buf.substr(0, pos);
+        buf.resize(pos);
+        *value = std::move(buf);
         *end = i + 1;
         return true;
       default:
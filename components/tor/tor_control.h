@@ -6,7 +6,6 @@
 #ifndef BRAVE_COMPONENTS_TOR_TOR_CONTROL_H_
 #define BRAVE_COMPONENTS_TOR_TOR_CONTROL_H_
 
-#include <map>
 #include <memory>
 #include <queue>
 #include <string>
@@ -16,8 +15,10 @@
 #include "brave/components/tor/tor_control_event.h"
 
 #include "base/callback.h"
+#include "base/containers/flat_map.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -49,6 +50,8 @@ class TorControl {
                                    const std::string& reply)>;
   using CmdCallback = base::OnceCallback<
       void(bool error, const std::string& status, const std::string& reply)>;
+  // Keyword arguments from the continuation lines of a multi-line event.
+  using EventExtra = base::flat_map<std::string, std::string>;
 
   class Delegate : public base::SupportsWeakPtr<Delegate> {
    public:
@@ -56,10 +59,9 @@ class TorControl {
     virtual void OnTorControlReady() = 0;
     virtual void OnTorControlClosed(bool was_running) = 0;
 
-    virtual void OnTorEvent(
-        TorControlEvent,
-        const std::string& initial,
-        const std::map<std::string, std::string>& extra) = 0;
+    virtual void OnTorEvent(TorControlEvent,
+                            const std::string& initial,
+                            const EventExtra& extra) = 0;
 
     // Debugging options.
     virtual void OnTorRawCmd(const std::string& cmd) {}
@@ -100,14 +102,14 @@ class TorControl {
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, ReadLine);
   FRIEND_TEST_ALL_PREFIXES(TorControlTest, GetCircuitEstablishedDone);
 
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value);
-  static bool ParseKV(const std::string& string,
+  static bool ParseKV(base::StringPiece string,
                       std::string* key,
                       std::string* value,
                       size_t* end);
-  static bool ParseQuoted(const std::string& string,
+  static bool ParseQuoted(base::StringPiece string,
                           std::string* value,
                           size_t* end);
 
@@ -172,7 +174,7 @@ class TorControl {
 
   void NotifyTorEvent(TorControlEvent,
                       const std::string& initial,
-                      const std::map<std::string, std::string>& extra);
+                      const EventExtra& extra);
   void NotifyTorRawCmd(const std::string& cmd);
   void NotifyTorRawAsync(const std::string& status, const std::string& line);
   void NotifyTorRawMid(const std::string& status, const std::string& line);
@@ -187,7 +189,7 @@ class TorControl {
   void DoReads();
   void ReadDoneAsync(int rv);
   void ReadDone(int rv);
-  bool ReadLine(const std::string& line);
+  bool ReadLine(base::StringPiece line);
 
   void Error();
 
@@ -216,13 +218,13 @@ class TorControl {
   bool read_cr_;    // true if we have parsed a CR
 
   // Asynchronous command response callback state machine.
-  std::map<TorControlEvent, size_t> async_events_;
+  base::flat_map<TorControlEvent, size_t> async_events_;
   struct Async {
     Async();
     ~Async();
     TorControlEvent event;
     std::string initial;
-    std::map<std::string, std::string> extra;
+    EventExtra extra;
     bool skip;
   };
   std::unique_ptr<Async> async_;
@@ -22,7 +22,7 @@ class MockTorControlDelegate : public TorControl::Delegate {
   MOCK_METHOD3(OnTorEvent,
                void(TorControlEvent,
                     const std::string&,
-                    const std::map<std::string, std::string>&));
+                    const TorControl::EventExtra&));
   MOCK_METHOD1(OnTorRawCmd, void(const std::string&));
   MOCK_METHOD2(OnTorRawAsync, void(const std::string&, const std::string&));
   MOCK_METHOD2(OnTorRawMid, void(const std::string&, const std::string&));
@@ -143,14 +143,16 @@ TEST(TorControlTest, ReadLine) {
   EXPECT_CALL(delegate, OnTorRawAsync("650", "FAKEVENT BEGIN")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "CONTINUE=FAKEVENT")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "END=FAKEVENT")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "STREAM 1 NEW")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "SOURCE_ADDR=1.2.3.4")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "CIRC 1000 EXTENDED")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "EXTRAMAGIC=99")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "ANONYMITY=high")).Times(1);
   EXPECT_CALL(delegate,
               OnTorEvent(TorControlEvent::NETWORK_LIVENESS, "DOWN", testing::_))
       .Times(1);
-  std::map<std::string, std::string> circ_extra = {{"ANONYMITY", "high"},
-                                                   {"EXTRAMAGIC", "99"}};
+  TorControl::EventExtra circ_extra = {{"ANONYMITY", "high"},
+                                       {"EXTRAMAGIC", "99"}};
   EXPECT_CALL(delegate,
               OnTorEvent(TorControlEvent::CIRC, "1000 EXTENDED", circ_extra))
       .Times(1);
@@ -170,6 +172,12 @@ TEST(TorControlTest, ReadLine) {
             EXPECT_TRUE(control->ReadLine("650-CONTINUE=FAKEVENT"));
             EXPECT_TRUE(control->ReadLine("650 END=FAKEVENT"));
             EXPECT_FALSE(control->async_);
+            // Known but unsubscribed multi async is skipped up front
+            EXPECT_TRUE(control->ReadLine("650-STREAM 1 NEW"));
+            EXPECT_TRUE(control->async_);
+            EXPECT_TRUE(control->async_->skip);
+            EXPECT_TRUE(control->ReadLine("650 SOURCE_ADDR=1.2.3.4"));
+            EXPECT_FALSE(control->async_);
             // Normal multi async
             control->async_events_[TorControlEvent::CIRC] = 1;
             EXPECT_TRUE(control->ReadLine("650-CIRC 1000 EXTENDED"));
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/files/file.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_number_conversions.h"
@@ -116,15 +117,36 @@ void TorFileWatcher::Poll() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(watch_sequence_checker_);
   DCHECK(polling_);
 
+  // FilePathWatcher reports every change in the directory, including the
+  // ones tor makes to its state and cache files.  Stat the two files first
+  // and only open and parse them when one of them has been replaced since
+  // the last attempt.
+  base::File::Info port_info;
+  base::File::Info cookie_info;
+  if (!base::GetFileInfo(watch_dir_path_.AppendASCII(kControlPortName),
+                         &port_info) ||
+      !base::GetFileInfo(watch_dir_path_.AppendASCII(kControlAuthCookieName),
+                         &cookie_info)) {
+    VLOG(2) << "tor: control files not yet written";
+    return PollDone();
+  }
+  if (port_info.last_modified == last_port_mtime_ &&
+      cookie_info.last_modified == last_cookie_mtime_) {
+    VLOG(2) << "tor: control files unchanged since last poll";
+    return PollDone();
+  }
+  last_port_mtime_ = port_info.last_modified;
+  last_cookie_mtime_ = cookie_info.last_modified;
+
   std::vector<uint8_t> cookie;
   base::Time cookie_mtime;
   int port;
   base::Time port_mtime;
 
-  if (!EatControlCookie(cookie, cookie_mtime))
-    return PollDone();
   if (!EatControlPort(port, port_mtime))
     return PollDone();
+  if (!EatControlCookie(cookie, cookie_mtime))
+    return PollDone();
 
   // Tor writes the control port first, then the auth cookie.  If the
   // auth cookie is _older_ than the control port, then it's certainly
@@ -207,7 +229,7 @@ bool TorFileWatcher::EatControlCookie(std::vector<uint8_t>& cookie,
 
   // Success!
   cookie.assign(buf, buf + nread);
-  mtime = info.last_accessed;
+  mtime = info.last_modified;
   VLOG(3) << "Control cookie " << base::HexEncode(buf, nread) << ", mtime "
           << mtime;
   return true;
@@ -13,6 +13,7 @@
 #include "base/files/file_path.h"
 #include "base/files/file_path_watcher.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 
 namespace base {
 class SequencedTaskRunner;
@@ -59,6 +60,10 @@ class TorFileWatcher {
   bool polling_;
   bool repoll_;
   base::FilePath watch_dir_path_;
+  // Modification times of the control files seen by the last poll, so a
+  // directory change that didn't touch them doesn't cause a re-parse.
+  base::Time last_port_mtime_;
+  base::Time last_cookie_mtime_;
 
   WatchCallback watch_callback_;
 
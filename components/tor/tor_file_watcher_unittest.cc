@@ -6,7 +6,12 @@
 #include <utility>
 
 #include "base/base_paths.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/task/bind_post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
 #include "brave/components/tor/tor_file_watcher.h"
 #include "content/public/test/browser_task_environment.h"
@@ -76,8 +81,10 @@ class TorFileWatcherTest : public testing::Test {
     return test_data_dir_.AppendASCII("tor").AppendASCII("tor_control");
   }
 
- private:
+ protected:
   content::BrowserTaskEnvironment task_environment_;
+
+ private:
   base::FilePath test_data_dir_;
 };
 
@@ -211,4 +218,58 @@ TEST_F(TorFileWatcherTest, EatControlPort) {
   EXPECT_NE(time.ToJsTime(), 0u);
 }
 
+TEST_F(TorFileWatcherTest, WaitsForFreshCookie) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath port_path =
+      temp_dir.GetPath().AppendASCII("controlport");
+  const base::FilePath cookie_path =
+      temp_dir.GetPath().AppendASCII("control_auth_cookie");
+  const std::string cookie_data(32, 'c');
+#if defined(OS_WIN)
+  ASSERT_TRUE(base::WriteFile(port_path, "PORT=127.0.0.1:5566\r\n"));
+#else
+  ASSERT_TRUE(base::WriteFile(port_path, "PORT=127.0.0.1:5566\n"));
+#endif
+  ASSERT_TRUE(base::WriteFile(cookie_path, cookie_data));
+
+  // A cookie older than the control port is left over from a previous run.
+  const base::Time now = base::Time::Now();
+  ASSERT_TRUE(
+      base::TouchFile(port_path, now, now - base::TimeDelta::FromHours(1)));
+  ASSERT_TRUE(base::TouchFile(cookie_path, now,
+                              now - base::TimeDelta::FromHours(2)));
+
+  bool called = false;
+  bool ready = false;
+  int port = 0;
+  std::vector<uint8_t> cookie;
+  base::RunLoop run_loop;
+  TorFileWatcher* tor_file_watcher = new TorFileWatcher(temp_dir.GetPath());
+  tor_file_watcher->StartWatching(base::BindPostTask(
+      base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(
+          [](bool* called, bool* ready, int* port,
+             std::vector<uint8_t>* cookie, base::OnceClosure quit,
+             bool success, std::vector<uint8_t> new_cookie, int new_port) {
+            *called = true;
+            *ready = success;
+            *port = new_port;
+            *cookie = std::move(new_cookie);
+            std::move(quit).Run();
+          },
+          &called, &ready, &port, &cookie, run_loop.QuitClosure())));
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(called);
+
+  // Tor replacing the cookie is what should wake the watcher up.
+  ASSERT_TRUE(base::WriteFile(cookie_path, cookie_data));
+  run_loop.Run();
+  EXPECT_TRUE(called);
+  EXPECT_TRUE(ready);
+  EXPECT_EQ(port, 5566);
+  EXPECT_EQ(cookie, std::vector<uint8_t>(cookie_data.begin(),
+                                         cookie_data.end()));
+}
+
 }  // namespace tor
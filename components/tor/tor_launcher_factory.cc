@@ -9,6 +9,9 @@
 
 #include "base/bind.h"
 #include "base/bind_post_task.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/tor/service_sandbox_type.h"
 #include "brave/components/tor/tor_file_watcher.h"
@@ -25,6 +28,9 @@ constexpr char kStatusClientBootstrap[] = "BOOTSTRAP";
 constexpr char kStatusClientBootstrapProgress[] = "PROGRESS=";
 constexpr char kStatusClientCircuitEstablished[] = "CIRCUIT_ESTABLISHED";
 constexpr char kStatusClientCircuitNotEstablished[] = "CIRCUIT_NOT_ESTABLISHED";
+constexpr int kBootstrapMilestones[] = {25, 50, 75, 100};
+// Guards against unbounded growth if tor never reports a circuit's fate.
+constexpr size_t kMaxPendingCircuits = 64;
 }  // namespace
 
 // static
@@ -116,6 +122,7 @@ void TorLauncherFactory::KillTorProcess() {
   is_starting_ = false;
   is_connected_ = false;
   tor_log_.clear();
+  pending_circuits_.clear();
 }
 
 int64_t TorLauncherFactory::GetTorPid() const {
@@ -178,6 +185,8 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
     // We have to wait for circuit established
     is_connected_ = false;
     tor_pid_ = pid;
+    launch_time_ = base::TimeTicks::Now();
+    last_bootstrap_milestone_ = 0;
   } else {
     LOG(ERROR) << "Tor Launching Failed(" << pid << ")";
     return;
@@ -218,6 +227,8 @@ void TorLauncherFactory::OnTorControlReady() {
                       base::DoNothing::Once<bool>());
   control_->Subscribe(tor::TorControlEvent::STREAM,
                       base::DoNothing::Once<bool>());
+  control_->Subscribe(tor::TorControlEvent::CIRC,
+                      base::DoNothing::Once<bool>());
   control_->Subscribe(tor::TorControlEvent::NOTICE,
                       base::DoNothing::Once<bool>());
   control_->Subscribe(tor::TorControlEvent::WARN,
@@ -326,10 +337,9 @@ void TorLauncherFactory::DelayedRelaunchTor() {
       base::TimeDelta::FromSeconds(1));
 }
 
-void TorLauncherFactory::OnTorEvent(
-    tor::TorControlEvent event,
-    const std::string& initial,
-    const std::map<std::string, std::string>& extra) {
+void TorLauncherFactory::OnTorEvent(tor::TorControlEvent event,
+                                    const std::string& initial,
+                                    const tor::TorControl::EventExtra& extra) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   const std::string raw_event =
       (*tor::kTorControlEventByEnum.find(event)).second + ": " + initial;
@@ -346,16 +356,26 @@ void TorLauncherFactory::OnTorEvent(
           progress_length - strlen(kStatusClientBootstrapProgress));
       for (auto& observer : observers_)
         observer.OnTorInitializing(percentage);
+      int progress;
+      if (base::StringToInt(percentage, &progress))
+        RecordBootstrapProgress(progress);
     } else if (initial.find(kStatusClientCircuitEstablished) !=
                std::string::npos) {
       for (auto& observer : observers_)
         observer.OnTorCircuitEstablished(true);
       is_connected_ = true;
+      if (!launch_time_.is_null()) {
+        base::UmaHistogramMediumTimes("Brave.Tor.TimeToCircuitEstablished",
+                                      base::TimeTicks::Now() - launch_time_);
+        launch_time_ = base::TimeTicks();
+      }
     } else if (initial.find(kStatusClientCircuitNotEstablished) !=
                std::string::npos) {
       for (auto& observer : observers_)
         observer.OnTorCircuitEstablished(false);
     }
+  } else if (event == tor::TorControlEvent::CIRC) {
+    OnCircuitEvent(initial);
   } else if (event == tor::TorControlEvent::NOTICE ||
              event == tor::TorControlEvent::WARN ||
              event == tor::TorControlEvent::ERR) {
@@ -365,6 +385,50 @@ void TorLauncherFactory::OnTorEvent(
   }
 }
 
+void TorLauncherFactory::RecordBootstrapProgress(int progress) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (launch_time_.is_null())
+    return;
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - launch_time_;
+  for (int milestone : kBootstrapMilestones) {
+    if (milestone <= last_bootstrap_milestone_ || milestone > progress)
+      continue;
+    base::UmaHistogramMediumTimes(
+        base::StringPrintf("Brave.Tor.BootstrapTime.%d", milestone), elapsed);
+    last_bootstrap_milestone_ = milestone;
+  }
+}
+
+void TorLauncherFactory::OnCircuitEvent(const std::string& initial) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // CIRC events start with "<CircuitID> <CircStatus>".
+  const size_t id_end = initial.find(' ');
+  if (id_end == std::string::npos)
+    return;
+  const std::string circuit_id = initial.substr(0, id_end);
+  const size_t status_end = initial.find(' ', id_end + 1);
+  const std::string status = initial.substr(
+      id_end + 1, status_end == std::string::npos ? std::string::npos
+                                                  : status_end - id_end - 1);
+
+  if (status == "LAUNCHED") {
+    if (pending_circuits_.size() < kMaxPendingCircuits)
+      pending_circuits_[circuit_id] = base::TimeTicks::Now();
+    return;
+  }
+  auto it = pending_circuits_.find(circuit_id);
+  if (it == pending_circuits_.end())
+    return;
+  if (status == "BUILT") {
+    base::UmaHistogramMediumTimes("Brave.Tor.CircuitBuildTime",
+                                  base::TimeTicks::Now() - it->second);
+  } else if (status != "FAILED" && status != "CLOSED") {
+    // EXTENDED and GUARD_WAIT are intermediate states.
+    return;
+  }
+  pending_circuits_.erase(it);
+}
+
 void TorLauncherFactory::OnTorRawCmd(const std::string& cmd) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(3) << "TOR CONTROL: command: " << cmd;
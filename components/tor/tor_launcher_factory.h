@@ -6,17 +6,18 @@
 #ifndef BRAVE_COMPONENTS_TOR_TOR_LAUNCHER_FACTORY_H_
 #define BRAVE_COMPONENTS_TOR_TOR_LAUNCHER_FACTORY_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/callback.h"
+#include "base/containers/flat_map.h"
 #include "base/memory/singleton.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
 #include "brave/components/tor/tor_control.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -51,7 +52,7 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void OnTorControlClosed(bool was_running) override;
   void OnTorEvent(tor::TorControlEvent event,
                   const std::string& initial,
-                  const std::map<std::string, std::string>& extra) override;
+                  const tor::TorControl::EventExtra& extra) override;
   void OnTorRawCmd(const std::string& cmd) override;
   void OnTorRawAsync(const std::string& status,
                      const std::string& line) override;
@@ -78,6 +79,11 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void GotSOCKSListeners(bool error, const std::vector<std::string>& listeners);
   void GotCircuitEstablished(bool error, bool established);
 
+  // Records how long after launch each bootstrap milestone was reached.
+  void RecordBootstrapProgress(int progress);
+  // Tracks LAUNCHED -> BUILT for each circuit from CIRC events.
+  void OnCircuitEvent(const std::string& initial);
+
   void LaunchTorInternal();
   void RelaunchTor();
   void DelayedRelaunchTor();
@@ -94,6 +100,12 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   int64_t tor_pid_;
 
+  // Reset on every launch; null once the circuit has been established.
+  base::TimeTicks launch_time_;
+  int last_bootstrap_milestone_ = 0;
+  // Launch time of circuits that haven't been built yet, keyed by circuit id.
+  base::flat_map<std::string, base::TimeTicks> pending_circuits_;
+
   tor::mojom::TorConfig config_;
 
   base::ObserverList<TorLauncherObserver> observers_;
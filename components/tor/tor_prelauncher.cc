@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_prelauncher.h"
+
+#include "brave/components/services/tor/public/interfaces/tor.mojom.h"
+#include "brave/components/tor/pref_names.h"
+#include "brave/components/tor/tor_launcher_factory.h"
+#include "components/prefs/pref_service.h"
+
+namespace tor {
+
+TorPrelauncher::TorPrelauncher(BraveTorClientUpdater* tor_client_updater,
+                               PrefService* local_state)
+    : tor_client_updater_(tor_client_updater), local_state_(local_state) {
+  DCHECK(tor_client_updater_);
+  DCHECK(local_state_);
+}
+
+TorPrelauncher::~TorPrelauncher() = default;
+
+void TorPrelauncher::Start() {
+  if (!local_state_->GetBoolean(prefs::kTorPrelaunch) ||
+      local_state_->GetBoolean(prefs::kTorDisabled)) {
+    return;
+  }
+
+  const base::FilePath executable_path =
+      tor_client_updater_->GetExecutablePath();
+  if (!executable_path.empty()) {
+    Launch(executable_path);
+    return;
+  }
+
+  // Registering the component is what a Tor window would do on open; the
+  // launch happens once the executable is installed.
+  tor_client_updater_observation_.Observe(tor_client_updater_);
+  tor_client_updater_->Register();
+}
+
+void TorPrelauncher::OnExecutableReady(const base::FilePath& path) {
+  if (path.empty())
+    return;
+  tor_client_updater_observation_.Reset();
+  Launch(path);
+}
+
+void TorPrelauncher::Launch(const base::FilePath& executable_path) {
+  TorLauncherFactory* tor_launcher_factory = TorLauncherFactory::GetInstance();
+  if (tor_launcher_factory->GetTorPid() >= 0)
+    return;
+
+  tor::mojom::TorConfig config(executable_path,
+                               tor_client_updater_->GetTorDataPath(),
+                               tor_client_updater_->GetTorWatchPath());
+  tor_launcher_factory->LaunchTorProcess(config);
+}
+
+}  // namespace tor
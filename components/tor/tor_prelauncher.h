@@ -0,0 +1,46 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_TOR_TOR_PRELAUNCHER_H_
+#define BRAVE_COMPONENTS_TOR_TOR_PRELAUNCHER_H_
+
+#include "base/scoped_observation.h"
+#include "brave/components/tor/brave_tor_client_updater.h"
+
+class PrefService;
+class TorLauncherFactory;
+
+namespace tor {
+
+// Starts the tor process in the background as soon as the tor client
+// component is ready, so that the first Tor window doesn't have to wait for
+// the launch and bootstrap. Only active when prefs::kTorPrelaunch is set and
+// Tor isn't disabled.
+class TorPrelauncher : public BraveTorClientUpdater::Observer {
+ public:
+  TorPrelauncher(BraveTorClientUpdater* tor_client_updater,
+                 PrefService* local_state);
+  ~TorPrelauncher() override;
+  TorPrelauncher(const TorPrelauncher&) = delete;
+  TorPrelauncher& operator=(const TorPrelauncher&) = delete;
+
+  void Start();
+
+  // BraveTorClientUpdater::Observer
+  void OnExecutableReady(const base::FilePath& path) override;
+
+ private:
+  void Launch(const base::FilePath& executable_path);
+
+  BraveTorClientUpdater* tor_client_updater_;
+  PrefService* local_state_;
+  base::ScopedObservation<BraveTorClientUpdater,
+                          BraveTorClientUpdater::Observer>
+      tor_client_updater_observation_{this};
+};
+
+}  // namespace tor
+
+#endif  // BRAVE_COMPONENTS_TOR_TOR_PRELAUNCHER_H_
@@ -5,10 +5,10 @@
 
 #include "brave/components/weekly_storage/daily_storage.h"
 
-#include <numeric>
 #include <utility>
 
 #include "base/logging.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/time/time.h"
@@ -16,6 +16,10 @@
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
 
+namespace {
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(5);
+}
+
 DailyStorage::DailyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
       pref_name_(pref_name),
@@ -35,28 +39,43 @@ DailyStorage::DailyStorage(PrefService* prefs,
   Load();
 }
 
-DailyStorage::~DailyStorage() = default;
+DailyStorage::~DailyStorage() {
+  if (save_timer_.IsRunning()) {
+    save_timer_.Stop();
+    Save();
+  }
+}
 
 void DailyStorage::RecordValueNow(uint64_t delta) {
   daily_values_.push_front({clock_->Now(), delta});
-  Save();
+  sum_ += delta;
+  FilterToDay();
+  ScheduleSave();
 }
 
 uint64_t DailyStorage::GetLast24HourSum() const {
-  // We record only value for last N days.
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [](const uint64_t acc, const DailyValue& item) {
-                           return acc + item.value;
-                         });
+  return sum_;
 }
 
 void DailyStorage::FilterToDay() {
-  if (daily_values_.empty()) {
+  // Remove all values that aren't within the last 24 hours. Values are
+  // recorded in order, so they are all at the back.
+  base::Time min = clock_->Now() - base::TimeDelta::FromDays(1);
+  while (!daily_values_.empty() && daily_values_.back().time <= min) {
+    sum_ -= daily_values_.back().value;
+    daily_values_.pop_back();
+  }
+}
+
+void DailyStorage::ScheduleSave() {
+  // Without a task runner (some unit tests) there is nothing to batch with.
+  if (!base::SequencedTaskRunnerHandle::IsSet()) {
+    Save();
     return;
   }
-  // Remove all values that aren't within the last 24 hours
-  base::Time min = clock_->Now() - base::TimeDelta::FromDays(1);
-  daily_values_.remove_if([min](DailyValue val) { return (val.time <= min); });
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE, kSaveDelay, this, &DailyStorage::Save);
+  }
 }
 
 void DailyStorage::Load() {
@@ -79,11 +98,15 @@ void DailyStorage::Load() {
       continue;
     }
     daily_values_.push_back({time, static_cast<uint64_t>(value->GetDouble())});
+    sum_ += daily_values_.back().value;
   }
 }
 
 void DailyStorage::Save() {
   FilterToDay();
+  if (!prefs_) {
+    return;
+  }
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
   list->ClearList();
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_DAILY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_DAILY_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -20,6 +21,8 @@ class PrefService;
 // Allows to track a sum of some
 // values added from time to time via |AddDelta| over the last 24 hours.
 // Requires |pref_name| to be already registered.
+// Like WeeklyStorage, writes to |pref_name| are batched and flushed on
+// destruction.
 class DailyStorage {
  public:
   DailyStorage(PrefService* prefs, const char* pref_name);
@@ -42,6 +45,7 @@ class DailyStorage {
     uint64_t value = 0ull;
   };
   void FilterToDay();
+  void ScheduleSave();
   void Load();
   void Save();
 
@@ -49,7 +53,11 @@ class DailyStorage {
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Newest first.
+  base::circular_deque<DailyValue> daily_values_;
+  uint64_t sum_ = 0ull;
+
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_DAILY_STORAGE_H_
@@ -5,9 +5,11 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
@@ -15,9 +17,12 @@
 #include "components/prefs/scoped_user_pref_update.h"
 
 namespace {
-constexpr size_t kDaysInWeek = 7;
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(5);
 }
 
+// static
+constexpr size_t WeeklyStorage::kDaysInWeek;
+
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
       pref_name_(pref_name),
@@ -37,117 +42,170 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs,
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  if (save_timer_.IsRunning()) {
+    save_timer_.Stop();
+    Save();
+  }
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
-  FilterToWeek();
-  daily_values_.front().value += delta;
-  Save();
+  AdvanceToToday().value += delta;
+  ScheduleSave();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
-  FilterToWeek();
-  DailyValue& today = daily_values_.front();
+  DailyValue& today = AdvanceToToday();
   if (today.value < value) {
     today.value = value;
   }
-  Save();
+  ScheduleSave();
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
-  // We record only value for last N days.
-  const base::Time n_days_ago =
-      clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  if (today_.is_null()) {
+    return 0;
+  }
+  // We record only value for last N days. |today_| may be behind the clock.
+  const int offset = DaysSinceToday(clock_->Now());
+  uint64_t sum = 0;
+  for (size_t age = 0; age < kDaysInWeek; age++) {
+    if (offset + static_cast<int>(age) < static_cast<int>(kDaysInWeek)) {
+      sum += daily_values_[SlotForAge(age)].value;
+    }
+  }
+  return sum;
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
-  // We record only value for last N days.
-  const base::Time n_days_ago =
-      clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
+  if (today_.is_null()) {
     return 0;
   }
-  return highest_it->value;
+  const int offset = DaysSinceToday(clock_->Now());
+  uint64_t highest = 0;
+  for (size_t age = 0; age < kDaysInWeek; age++) {
+    if (offset + static_cast<int>(age) < static_cast<int>(kDaysInWeek)) {
+      highest = std::max(highest, daily_values_[SlotForAge(age)].value);
+    }
+  }
+  return highest;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return days_recorded_ == kDaysInWeek;
 }
 
-void WeeklyStorage::FilterToWeek() {
-  base::Time now_midnight = clock_->Now().LocalMidnight();
-  base::Time last_saved_midnight;
+int WeeklyStorage::DaysSinceToday(base::Time time) const {
+  DCHECK(!today_.is_null());
+  // Midnights can be 23 or 25 hours apart around DST changes.
+  return std::lround((time.LocalMidnight() - today_).InHoursF() / 24);
+}
 
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
-  }
+size_t WeeklyStorage::SlotForAge(size_t age) const {
+  DCHECK_LT(age, kDaysInWeek);
+  return (today_slot_ + kDaysInWeek - age) % kDaysInWeek;
+}
 
-  if (now_midnight - last_saved_midnight > base::TimeDelta()) {
-    // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
+WeeklyStorage::DailyValue& WeeklyStorage::AdvanceToToday() {
+  const base::Time now_midnight = clock_->Now().LocalMidnight();
+  if (today_.is_null()) {
+    today_ = now_midnight;
+  } else {
+    const int days = DaysSinceToday(now_midnight);
+    if (days > 0) {
+      // Day changed. Clear the slots of the days in between, at most a week.
+      for (int i = 0; i < std::min(days, static_cast<int>(kDaysInWeek)); i++) {
+        today_slot_ = (today_slot_ + 1) % kDaysInWeek;
+        daily_values_[today_slot_] = DailyValue();
+      }
+      today_ = now_midnight;
     }
   }
+
+  DailyValue& today = daily_values_[today_slot_];
+  if (!today.recorded) {
+    today.recorded = true;
+    days_recorded_ = std::min(days_recorded_ + 1, kDaysInWeek);
+  }
+  return today;
+}
+
+void WeeklyStorage::ScheduleSave() {
+  // Without a task runner (some unit tests) there is nothing to batch with.
+  if (!base::SequencedTaskRunnerHandle::IsSet()) {
+    Save();
+    return;
+  }
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE, kSaveDelay, this, &WeeklyStorage::Save);
+  }
 }
 
 void WeeklyStorage::Load() {
-  DCHECK(daily_values_.empty());
+  DCHECK(today_.is_null());
   const base::ListValue* list = prefs_->GetList(pref_name_);
   if (!list) {
     return;
   }
+  // Entries are stored newest first.
   for (auto& it : list->GetList()) {
     const base::Value* day = it.FindKey("day");
     const base::Value* value = it.FindKey("value");
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (days_recorded_ == kDaysInWeek) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
+    days_recorded_++;
+    const base::Time time = base::Time::FromDoubleT(day->GetDouble());
+    if (today_.is_null()) {
+      today_ = time.LocalMidnight();
+    }
+    const int age = -DaysSinceToday(time);
+    if (age < 0 || age >= static_cast<int>(kDaysInWeek)) {
+      continue;
+    }
+    DailyValue& slot = daily_values_[SlotForAge(age)];
+    slot.value += static_cast<uint64_t>(value->GetDouble());
+    slot.recorded = true;
   }
 }
 
 void WeeklyStorage::Save() {
-  DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
+  if (!prefs_ || today_.is_null()) {
+    return;
+  }
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->ClearList();
-  for (const auto& u : daily_values_) {
+  size_t written = 0;
+  for (size_t age = 0; age < kDaysInWeek; age++) {
+    const DailyValue& daily_value = daily_values_[SlotForAge(age)];
+    if (!daily_value.recorded) {
+      continue;
+    }
+    // Round to the nearest midnight in case |age| spans a DST change.
+    const base::Time day = (today_ - base::TimeDelta::FromDays(age) +
+                            base::TimeDelta::FromHours(12))
+                               .LocalMidnight();
+    base::DictionaryValue value;
+    value.SetKey("day", base::Value(day.ToDoubleT()));
+    value.SetDoubleKey("value", daily_value.value);
+    list->Append(std::move(value));
+    written++;
+  }
+  // Days older than a week no longer have a slot, but still count towards
+  // IsOneWeekPassed() after a restart. Keep them as empty entries that fall
+  // outside the week.
+  for (size_t i = 1; written < days_recorded_; i++, written++) {
+    const base::Time day = today_ - base::TimeDelta::FromDays(kDaysInWeek + i);
     base::DictionaryValue value;
-    value.SetKey("day", base::Value(u.day.ToDoubleT()));
-    value.SetDoubleKey("value", u.value);
+    value.SetKey("day", base::Value(day.ToDoubleT()));
+    value.SetDoubleKey("value", 0);
     list->Append(std::move(value));
   }
 }
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
+#include <array>
 #include <memory>
 
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -22,6 +23,10 @@ class PrefService;
 // Requires |pref_name| to be already registered.
 // Feel free to improve and refactor it - templatize a stored value type,
 // change weekly interval or make a keyed service from it.
+//
+// Days live in a fixed ring of slots, so updates are O(1). Writes to
+// |pref_name| are batched: they happen a few seconds after the first unsaved
+// update and on destruction.
 class WeeklyStorage {
  public:
   WeeklyStorage(PrefService* prefs, const char* pref_name);
@@ -42,11 +47,20 @@ class WeeklyStorage {
   bool IsOneWeekPassed() const;
 
  private:
+  static constexpr size_t kDaysInWeek = 7;
+
   struct DailyValue {
-    base::Time day;
     uint64_t value = 0ull;
+    // Whether the day was written at all, as opposed to skipped.
+    bool recorded = false;
   };
-  void FilterToWeek();
+
+  // Number of days from |today_| to the day containing |time|.
+  int DaysSinceToday(base::Time time) const;
+  // Slot of the day |age| days before |today_|.
+  size_t SlotForAge(size_t age) const;
+  DailyValue& AdvanceToToday();
+  void ScheduleSave();
   void Load();
   void Save();
 
@@ -54,7 +68,14 @@ class WeeklyStorage {
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Local midnight of the newest slot, null until the first update.
+  base::Time today_;
+  size_t today_slot_ = 0;
+  std::array<DailyValue, kDaysInWeek> daily_values_;
+  // Distinct days written so far, capped at a week.
+  size_t days_recorded_ = 0;
+
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
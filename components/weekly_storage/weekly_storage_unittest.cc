@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
@@ -138,3 +139,48 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+TEST_F(WeeklyStorageTest, KeepsWeekPassedAcrossRestart) {
+  constexpr char kPrefName[] = "brave.weekly_test";
+  for (int day = 0; day < 7; day++) {
+    clock_->Advance(base::TimeDelta::FromDays(1));
+    state_->AddDelta(1);
+  }
+  EXPECT_TRUE(state_->IsOneWeekPassed());
+
+  clock_->Advance(base::TimeDelta::FromDays(10));
+  state_->AddDelta(1);
+  auto clock = std::make_unique<base::SimpleTestClock>();
+  clock->SetNow(clock_->Now());
+  state_.reset();
+
+  WeeklyStorage reloaded(&pref_service_, kPrefName, std::move(clock));
+  EXPECT_TRUE(reloaded.IsOneWeekPassed());
+  EXPECT_EQ(reloaded.GetWeeklySum(), 1ULL);
+}
+
+TEST(WeeklyStorageSaveTest, BatchesPrefWrites) {
+  constexpr char kPrefName[] = "brave.weekly_test";
+  base::test::TaskEnvironment task_environment(
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME);
+  TestingPrefServiceSimple pref_service;
+  pref_service.registry()->RegisterListPref(kPrefName);
+
+  auto todays_saved_value = [&pref_service, kPrefName]() {
+    return pref_service.GetList(kPrefName)->GetList()[0].FindDoubleKey("value");
+  };
+
+  auto storage = std::make_unique<WeeklyStorage>(&pref_service, kPrefName);
+  storage->AddDelta(1);
+  storage->AddDelta(2);
+  EXPECT_TRUE(pref_service.GetList(kPrefName)->GetList().empty());
+
+  task_environment.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  ASSERT_EQ(pref_service.GetList(kPrefName)->GetList().size(), 1u);
+  EXPECT_EQ(todays_saved_value(), 3);
+
+  // Pending updates are written on destruction.
+  storage->AddDelta(4);
+  storage.reset();
+  EXPECT_EQ(todays_saved_value(), 7);
+}
@@ -8,6 +8,8 @@
 
 #import <Foundation/Foundation.h>
 
+#include <stdint.h>
+
 #include <set>
 
 #include "brave/ios/browser/api/bookmarks/brave_bookmarks_observer.h"
@@ -53,9 +55,20 @@ class BookmarkModelListener : public bookmarks::BookmarkModelObserver {
       const bookmarks::BookmarkNode* node) override;
   void BookmarkAllUserNodesRemoved(bookmarks::BookmarkModel* model,
                                    const std::set<GURL>& removed_urls) override;
+  void ExtensiveBookmarkChangesBeginning(
+      bookmarks::BookmarkModel* model) override;
+  void ExtensiveBookmarkChangesEnded(bookmarks::BookmarkModel* model) override;
+
+  // Tells the observer that the children of |node| changed, or remembers
+  // |node| until the model's extensive changes end.
+  void NotifyChildrenChanged(bookmarks::BookmarkModel* model,
+                             const bookmarks::BookmarkNode* node);
 
   __strong id<BookmarkModelObserver> observer_;
   bookmarks::BookmarkModel* model_;  // NOT OWNED
+  // Ids of the folders whose children changed during extensive changes, such
+  // as a bulk import. Each gets one notification once the changes end.
+  std::set<int64_t> pending_children_changed_;
 };
 
 }  // namespace ios
@@ -13,6 +13,7 @@
 #include "brave/ios/browser/api/bookmarks/brave_bookmarks_api.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "components/bookmarks/browser/bookmark_model_observer.h"
+#include "components/bookmarks/browser/bookmark_utils.h"
 
 #if !defined(__has_feature) || !__has_feature(objc_arc)
 #error "This file requires ARC support."
@@ -81,11 +82,7 @@ void BookmarkModelListener::BookmarkNodeAdded(
     bookmarks::BookmarkModel* model,
     const bookmarks::BookmarkNode* parent,
     size_t index) {
-  if ([observer_ respondsToSelector:@selector(bookmarkNodeChildrenChanged:)]) {
-    IOSBookmarkNode* ios_parent = [[IOSBookmarkNode alloc] initWithNode:parent
-                                                                  model:model];
-    [observer_ bookmarkNodeChildrenChanged:ios_parent];
-  }
+  NotifyChildrenChanged(model, parent);
 }
 
 void BookmarkModelListener::BookmarkNodeRemoved(
@@ -104,9 +101,7 @@ void BookmarkModelListener::BookmarkNodeRemoved(
     [observer_ bookmarkNodeDeleted:ios_node fromFolder:ios_parent];
   }
 
-  if ([observer_ respondsToSelector:@selector(bookmarkNodeChildrenChanged:)]) {
-    [observer_ bookmarkNodeChildrenChanged:ios_parent];
-  }
+  NotifyChildrenChanged(model, parent);
 }
 
 void BookmarkModelListener::BookmarkNodeChanged(
@@ -132,11 +127,7 @@ void BookmarkModelListener::BookmarkNodeFaviconChanged(
 void BookmarkModelListener::BookmarkNodeChildrenReordered(
     bookmarks::BookmarkModel* model,
     const bookmarks::BookmarkNode* node) {
-  if ([observer_ respondsToSelector:@selector(bookmarkNodeChildrenChanged:)]) {
-    IOSBookmarkNode* ios_node = [[IOSBookmarkNode alloc] initWithNode:node
-                                                                model:model];
-    [observer_ bookmarkNodeChildrenChanged:ios_node];
-  }
+  NotifyChildrenChanged(model, node);
 }
 
 void BookmarkModelListener::BookmarkAllUserNodesRemoved(
@@ -146,6 +137,45 @@ void BookmarkModelListener::BookmarkAllUserNodesRemoved(
     [observer_ bookmarkModelRemovedAllNodes];
   }
 }
+
+void BookmarkModelListener::ExtensiveBookmarkChangesBeginning(
+    bookmarks::BookmarkModel* model) {
+  pending_children_changed_.clear();
+}
+
+void BookmarkModelListener::ExtensiveBookmarkChangesEnded(
+    bookmarks::BookmarkModel* model) {
+  std::set<int64_t> pending_children_changed;
+  pending_children_changed.swap(pending_children_changed_);
+  if (![observer_ respondsToSelector:@selector(bookmarkNodeChildrenChanged:)])
+    return;
+
+  for (int64_t id : pending_children_changed) {
+    // Folders removed later in the same batch were already reported deleted.
+    const bookmarks::BookmarkNode* node =
+        bookmarks::GetBookmarkNodeByID(model, id);
+    if (!node)
+      continue;
+    IOSBookmarkNode* ios_node = [[IOSBookmarkNode alloc] initWithNode:node
+                                                                model:model];
+    [observer_ bookmarkNodeChildrenChanged:ios_node];
+  }
+}
+
+void BookmarkModelListener::NotifyChildrenChanged(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  if (model->IsDoingExtensiveChanges()) {
+    pending_children_changed_.insert(node->id());
+    return;
+  }
+
+  if ([observer_ respondsToSelector:@selector(bookmarkNodeChildrenChanged:)]) {
+    IOSBookmarkNode* ios_node = [[IOSBookmarkNode alloc] initWithNode:node
+                                                                model:model];
+    [observer_ bookmarkNodeChildrenChanged:ios_node];
+  }
+}
 }  // namespace ios
 }  // namespace brave
 
@@ -101,6 +101,10 @@ const char kFolderChildrenEnd[] = "</DL><p>";
 // Number of characters to indent by.
 const size_t kIndentSize = 4;
 
+// Output is written to the file in chunks of about this size rather than
+// once per tag and attribute.
+const size_t kWriteBufferSize = 64 * 1024;
+
 // Fetches favicons for list of bookmarks and then starts Writer which outputs
 // bookmarks and favicons to html file.
 class BookmarkFaviconFetcher : public base::SupportsUserData::Data {
@@ -176,7 +180,7 @@ class Writer : public base::RefCountedThreadSafe<Writer> {
       return;
     }
 
-    if (!Write(kHeader)) {
+    if (!Write(kHeader) || !Flush()) {
       NotifyOnFinish(BookmarksExportObserver::Result::kCouldNotWriteHeader);
       return;
     }
@@ -208,8 +212,10 @@ class Writer : public base::RefCountedThreadSafe<Writer> {
 
     DecrementIndent();
 
-    Write(kFolderChildrenEnd);
-    Write(kNewline);
+    if (!Write(kFolderChildrenEnd) || !Write(kNewline) || !Flush()) {
+      NotifyOnFinish(BookmarksExportObserver::Result::kCouldNotWriteNodes);
+      return;
+    }
     // File close is forced so that unit test could read it.
     file_.reset();
 
@@ -260,12 +266,21 @@ class Writer : public base::RefCountedThreadSafe<Writer> {
   }
 
   // Writes raw text out returning true on success. This does not escape
-  // the text in anyway.
+  // the text in anyway. The text is buffered; see Flush().
   bool Write(const std::string& text) {
-    if (!text.length())
+    buffer_.append(text);
+    if (buffer_.size() < kWriteBufferSize)
       return true;
-    size_t wrote = file_->WriteAtCurrentPos(text.c_str(), text.length());
-    bool result = (wrote == text.length());
+    return Flush();
+  }
+
+  // Writes the buffered text to the file, returning true on success.
+  bool Flush() {
+    if (buffer_.empty())
+      return true;
+    int wrote = file_->WriteAtCurrentPos(buffer_.data(), buffer_.size());
+    bool result = (wrote == static_cast<int>(buffer_.size()));
+    buffer_.clear();
     if (!result) {
       PLOG(ERROR) << "Could not write text to " << path_;
       return false;
@@ -427,6 +442,9 @@ class Writer : public base::RefCountedThreadSafe<Writer> {
   // File we're writing to.
   std::unique_ptr<base::File> file_;
 
+  // Text not yet written to |file_|.
+  std::string buffer_;
+
   // How much we indent when writing a bookmark/folder. This is modified
   // via IncrementIndent and DecrementIndent.
   std::string indent_;
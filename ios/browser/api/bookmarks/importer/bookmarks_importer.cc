@@ -5,7 +5,9 @@
 
 #include "brave/ios/browser/api/bookmarks/importer/bookmarks_importer.h"
 
+#include <map>
 #include <set>
+#include <utility>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
@@ -112,6 +114,10 @@ void BookmarksImporter::AddBookmarks(
   model->BeginExtensiveChanges();
 
   std::set<const BookmarkNode*> folders_added_to;
+  // Folders on the bookmarks' paths, by parent and title, so that a large
+  // import doesn't scan a folder's children once per bookmark in it.
+  std::map<std::pair<const BookmarkNode*, std::u16string>, const BookmarkNode*>
+      path_folders;
   const BookmarkNode* top_level_folder = NULL;
   for (std::vector<ImportedBookmarkEntry>::const_iterator bookmark =
            reordered_bookmarks.begin();
@@ -148,15 +154,19 @@ void BookmarksImporter::AddBookmarks(
         continue;
       }
 
-      const auto it = std::find_if(
-          parent->children().cbegin(), parent->children().cend(),
-          [folder_name](const auto& node) {
-            return node->is_folder() && node->GetTitle() == *folder_name;
-          });
-      parent = (it == parent->children().cend())
-                   ? model->AddFolder(parent, parent->children().size(),
-                                      *folder_name)
-                   : it->get();
+      const BookmarkNode*& folder = path_folders[{parent, *folder_name}];
+      if (!folder) {
+        const auto it = std::find_if(
+            parent->children().cbegin(), parent->children().cend(),
+            [folder_name](const auto& node) {
+              return node->is_folder() && node->GetTitle() == *folder_name;
+            });
+        folder = (it == parent->children().cend())
+                     ? model->AddFolder(parent, parent->children().size(),
+                                        *folder_name)
+                     : it->get();
+      }
+      parent = folder;
     }
 
     folders_added_to.insert(parent);
@@ -143,6 +143,9 @@ ledger::type::DBCommandResponsePtr RunDBTransactionOnTaskRunner(
   ledger::Ledger* ledger;
   ledger::LedgerDatabase* rewardsDatabase;
   scoped_refptr<base::SequencedTaskRunner> databaseQueue;
+  // When the first initialization attempt started, for logging how long
+  // rewards take to become ready at launch.
+  base::TimeTicks initializationStartTime;
 }
 
 @property(nonatomic, copy) NSString* storagePath;
@@ -252,6 +255,9 @@ ledger::type::DBCommandResponsePtr RunDBTransactionOnTaskRunner(
 }
 
 - (void)initializeLedgerService:(nullable void (^)())completion {
+  if (initializationStartTime.is_null()) {
+    initializationStartTime = base::TimeTicks::Now();
+  }
   self.migrationType = BATLedgerDatabaseMigrationTypeDefault;
   [self databaseNeedsMigration:^(BOOL needsMigration) {
     if (needsMigration) {
@@ -313,6 +319,11 @@ ledger::type::DBCommandResponsePtr RunDBTransactionOnTaskRunner(
       }
     }
     self.initializationResult = static_cast<LedgerResult>(result);
+    if (!initializationStartTime.is_null()) {
+      BLOG(1, @"Rewards ready %lld ms after initialization started",
+           (base::TimeTicks::Now() - initializationStartTime).InMilliseconds());
+      initializationStartTime = base::TimeTicks();
+    }
     if (completion) {
       completion();
     }
@@ -391,34 +402,44 @@ ledger::type::DBCommandResponsePtr RunDBTransactionOnTaskRunner(
 }
 
 - (void)resetRewardsDatabase {
-  delete rewardsDatabase;
+  // Transactions still queued for the old database run before it is deleted,
+  // and the files are removed before the new one is first opened.
+  databaseQueue->DeleteSoon(FROM_HERE, rewardsDatabase);
   const auto dbPath = [self rewardsDatabasePath];
-  [NSFileManager.defaultManager removeItemAtPath:dbPath error:nil];
-  [NSFileManager.defaultManager
-      removeItemAtPath:[dbPath stringByAppendingString:@"-journal"]
-                 error:nil];
+  const auto journalPath = [dbPath stringByAppendingString:@"-journal"];
+  databaseQueue->PostTask(FROM_HERE, base::BindOnce(^{
+    [NSFileManager.defaultManager removeItemAtPath:dbPath error:nil];
+    [NSFileManager.defaultManager removeItemAtPath:journalPath error:nil];
+  }));
   rewardsDatabase = ledger::LedgerDatabase::CreateInstance(
       base::FilePath(base::SysNSStringToUTF8(dbPath)));
 }
 
 - (void)getCreateScript:(ledger::client::GetCreateScriptCallback)callback {
-  NSString* migrationScript = @"";
-  switch (self.migrationType) {
-    case BATLedgerDatabaseMigrationTypeNone:
-      // We shouldn't be migrating, therefore doesn't make sense that
-      // `getCreateScript` was called
-      BLOG(0,
-           @"DB: Attempted CoreData migration with an empty migration script");
-      break;
-    case BATLedgerDatabaseMigrationTypeTokensOnly:
-      migrationScript =
-          [BATLedgerDatabase migrateCoreDataBATOnlyToSQLTransaction];
-      break;
-    case BATLedgerDatabaseMigrationTypeDefault:
-    default:
-      migrationScript = [BATLedgerDatabase migrateCoreDataToSQLTransaction];
+  const auto migrationType = self.migrationType;
+  if (migrationType == BATLedgerDatabaseMigrationTypeNone) {
+    // We shouldn't be migrating, therefore doesn't make sense that
+    // `getCreateScript` was called
+    BLOG(0, @"DB: Attempted CoreData migration with an empty migration script");
+    callback("", 10);
+    return;
   }
-  callback(base::SysNSStringToUTF8(migrationScript), 10);
+
+  // Reading the whole CoreData store can take a while, so it is done on the
+  // database sequence rather than the main thread.
+  __weak BraveLedger* weakSelf = self;
+  base::PostTaskAndReplyWithResult(
+      databaseQueue.get(), FROM_HERE, base::BindOnce(^std::string {
+        NSString* migrationScript =
+            migrationType == BATLedgerDatabaseMigrationTypeTokensOnly
+                ? [BATLedgerDatabase migrateCoreDataBATOnlyToSQLTransaction]
+                : [BATLedgerDatabase migrateCoreDataToSQLTransaction];
+        return base::SysNSStringToUTF8(migrationScript);
+      }),
+      base::BindOnce(^(std::string migrationScript) {
+        if (weakSelf)
+          callback(migrationScript, 10);
+      }));
 }
 
 - (NSString*)randomStatePath {
@@ -25,14 +25,16 @@ OBJC_EXPORT
 /// CoreData storage into version 10 of the brave-core's database schema to
 /// then run and have ledger take over
 ///
-/// Return's nil if the migration template cannot be found
+/// Reads CoreData on a private queue context, so it may be called from any
+/// thread. Return's nil if the migration template cannot be found
 + (nullable NSString*)migrateCoreDataToSQLTransaction;
 
 /// Generates a SQL migration transaction that will move token related tables
 /// only (promos, promo creds, unblinded tokens) to version 10 of brave-core's
 /// database schema.
 ///
-/// Return's nil if the migration template cannot be found
+/// May be called from any thread. Return's nil if the migration template
+/// cannot be found
 + (nullable NSString*)migrateCoreDataBATOnlyToSQLTransaction;
 
 /// Deletes the server publisher list from the CoreData DB
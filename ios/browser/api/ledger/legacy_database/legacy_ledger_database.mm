@@ -31,18 +31,21 @@
     return nil;
   }
 
+  // A private queue context, so the script can be built off the main thread.
+  const auto context = [DataController newBackgroundContext];
   const auto statements = [[NSMutableArray alloc] init];
 
   // activity_info
   [statements
       addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                              ActivityInfo.class, ^(ActivityInfo* info) {
+                              context, ActivityInfo.class,
+                              ^(ActivityInfo* info) {
                                 return [self activityInfoInsertFor:info];
                               })];
 
   // contribution_info
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      ContributionInfo.class,
+                                      context, ContributionInfo.class,
                                       ^(ContributionInfo* info) {
                                         return [self
                                             contributionInfoInsertFor:info];
@@ -51,7 +54,7 @@
   // contribution_queue
   __block int64_t contributionQueueMaxID = 0;
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      ContributionQueue.class,
+                                      context, ContributionQueue.class,
                                       ^(ContributionQueue* obj) {
                                         contributionQueueMaxID =
                                             MAX(obj.id, contributionQueueMaxID);
@@ -69,7 +72,7 @@
   // contribution_queue_publishers
   [statements
       addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                              ContributionPublisher.class,
+                              context, ContributionPublisher.class,
                               ^(ContributionPublisher* obj) {
                                 return [self
                                     contributionQueuePublisherInsertFor:obj];
@@ -77,7 +80,7 @@
 
   // media_publisher_info
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      MediaPublisherInfo.class,
+                                      context, MediaPublisherInfo.class,
                                       ^(MediaPublisherInfo* obj) {
                                         return [self
                                             mediaPublisherInfoInsertFor:obj];
@@ -85,7 +88,7 @@
 
   // pending_contribution
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      PendingContribution.class,
+                                      context, PendingContribution.class,
                                       ^(PendingContribution* obj) {
                                         return [self
                                             pendingContributionInsertFor:obj];
@@ -93,13 +96,14 @@
 
   // promotion
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      Promotion.class, ^(Promotion* obj) {
+                                      context, Promotion.class,
+                                      ^(Promotion* obj) {
                                         return [self promotionInsertFor:obj];
                                       })];
 
   // promotion_creds
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      PromotionCredentials.class,
+                                      context, PromotionCredentials.class,
                                       ^(PromotionCredentials* obj) {
                                         return
                                             [self promotionCredsInsertFor:obj];
@@ -108,13 +112,14 @@
   // publisher_info
   [statements
       addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                              PublisherInfo.class, ^(PublisherInfo* obj) {
+                              context, PublisherInfo.class,
+                              ^(PublisherInfo* obj) {
                                 return [self publisherInfoInsertFor:obj];
                               })];
 
   // recurring_donation
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      RecurringDonation.class,
+                                      context, RecurringDonation.class,
                                       ^(RecurringDonation* obj) {
                                         return [self
                                             recurringDonationInsertFor:obj];
@@ -124,7 +129,8 @@
   __block int64_t unblindedTokenMaxID = 0;
   [statements
       addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                              UnblindedToken.class, ^(UnblindedToken* obj) {
+                              context, UnblindedToken.class,
+                              ^(UnblindedToken* obj) {
                                 unblindedTokenMaxID =
                                     MAX(obj.tokenID, unblindedTokenMaxID);
                                 return [self unblindedTokenInsertFor:obj];
@@ -158,17 +164,19 @@
     return nil;
   }
 
+  const auto context = [DataController newBackgroundContext];
   const auto statements = [[NSMutableArray alloc] init];
 
   // promotion
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      Promotion.class, ^(Promotion* obj) {
+                                      context, Promotion.class,
+                                      ^(Promotion* obj) {
                                         return [self promotionInsertFor:obj];
                                       })];
 
   // promotion_creds
   [statements addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                                      PromotionCredentials.class,
+                                      context, PromotionCredentials.class,
                                       ^(PromotionCredentials* obj) {
                                         return
                                             [self promotionCredsInsertFor:obj];
@@ -178,7 +186,8 @@
   __block int64_t unblindedTokenMaxID = 0;
   [statements
       addObjectsFromArray:MapFetchedObjectsToInsertsForClass(
-                              UnblindedToken.class, ^(UnblindedToken* obj) {
+                              context, UnblindedToken.class,
+                              ^(UnblindedToken* obj) {
                                 unblindedTokenMaxID =
                                     MAX(obj.tokenID, unblindedTokenMaxID);
                                 return [self unblindedTokenInsertFor:obj];
@@ -427,28 +436,30 @@ NS_INLINE NSString* SQLString(NSString* _Nonnull value) {
 }
 
 static NSArray<NSString*>* MapFetchedObjectsToInsertsForClass(
+    NSManagedObjectContext* context,
     Class clazz,
     NSString*(NS_NOESCAPE ^ block)(__kindof NSManagedObject* obj)) {
-  const auto context = DataController.viewContext;
-  const auto fetchRequest = [clazz fetchRequest];
-  fetchRequest.entity =
-      [NSEntityDescription entityForName:NSStringFromClass(clazz)
-                  inManagedObjectContext:context];
-  NSError* error;
-  const auto fetchedObjects = [context executeFetchRequest:fetchRequest
-                                                     error:&error];
-  if (error) {
-    return @[];
-  }
   const auto statements = [[NSMutableArray<NSString*> alloc] init];
-  [fetchedObjects
-      enumerateObjectsUsingBlock:^(NSManagedObject* _Nonnull obj,
-                                   NSUInteger idx, BOOL* _Nonnull stop) {
-        if (![obj isKindOfClass:clazz]) {
-          return;
-        }
-        [statements addObject:block(obj)];
-      }];
+  [context performBlockAndWait:^{
+    const auto fetchRequest = [clazz fetchRequest];
+    fetchRequest.entity =
+        [NSEntityDescription entityForName:NSStringFromClass(clazz)
+                    inManagedObjectContext:context];
+    NSError* error;
+    const auto fetchedObjects = [context executeFetchRequest:fetchRequest
+                                                       error:&error];
+    if (error) {
+      return;
+    }
+    [fetchedObjects
+        enumerateObjectsUsingBlock:^(NSManagedObject* _Nonnull obj,
+                                     NSUInteger idx, BOOL* _Nonnull stop) {
+          if (![obj isKindOfClass:clazz]) {
+            return;
+          }
+          [statements addObject:block(obj)];
+        }];
+  }];
   return statements;
 }
 
@@ -5,9 +5,12 @@
 
 #include "brave/net/dns/brave_resolve_context.h"
 
+#include <algorithm>
 #include <string>
 
+#include "base/metrics/histogram_functions.h"
 #include "brave/net/decentralized_dns/constants.h"
+#include "net/base/net_errors.h"
 #include "net/dns/dns_session.h"
 
 namespace {
@@ -17,6 +20,16 @@ bool IsDecentralizedDNSResolver(const std::string& server) {
          server == decentralized_dns::kENSDoHResolver;
 }
 
+// Weight of the newest sample in the rolling RTT estimate.
+constexpr double kRttSampleWeight = 0.3;
+
+// The next server is raced once the current one has taken this many times
+// the faster server's usual RTT...
+constexpr double kRacingRttMultiplier = 1.5;
+// ...but never sooner than this, to keep duplicate queries rare.
+constexpr base::TimeDelta kMinRacingDelay =
+    base::TimeDelta::FromMilliseconds(20);
+
 }  // namespace
 
 namespace net {
@@ -65,4 +78,76 @@ size_t BraveResolveContext::NumAvailableDohServers(
   return num + ResolveContext::NumAvailableDohServers(session);
 }
 
+base::TimeDelta BraveResolveContext::NextDohFallbackPeriod(
+    size_t doh_server_index,
+    const DnsSession* session) {
+  base::TimeDelta period =
+      ResolveContext::NextDohFallbackPeriod(doh_server_index, session);
+  if (!IsCurrentSession(session))
+    return period;
+  MaybeResetRttEstimates();
+
+  const auto& servers = session->config().dns_over_https_servers;
+  const base::TimeDelta own_rtt = GetDohServerRttEstimate(doh_server_index);
+  base::TimeDelta fastest_other_rtt;
+  for (size_t i = 0; i < doh_rtt_estimates_.size(); i++) {
+    // Decentralized DNS resolvers only answer for their own TLDs, so they
+    // can't stand in for a general purpose server.
+    if (i == doh_server_index || doh_rtt_estimates_[i].is_zero() ||
+        IsDecentralizedDNSResolver(servers[i].server_template) ||
+        !GetDohServerAvailability(i, session)) {
+      continue;
+    }
+    if (fastest_other_rtt.is_zero() ||
+        doh_rtt_estimates_[i] < fastest_other_rtt) {
+      fastest_other_rtt = doh_rtt_estimates_[i];
+    }
+  }
+  if (fastest_other_rtt.is_zero() ||
+      (!own_rtt.is_zero() && own_rtt <= fastest_other_rtt)) {
+    return period;
+  }
+  return std::min(period, std::max(fastest_other_rtt * kRacingRttMultiplier,
+                                   kMinRacingDelay));
+}
+
+void BraveResolveContext::RecordRtt(size_t server_index,
+                                    bool is_doh_server,
+                                    base::TimeDelta rtt,
+                                    int rv,
+                                    const DnsSession* session) {
+  ResolveContext::RecordRtt(server_index, is_doh_server, rtt, rv, session);
+  if (!is_doh_server || rv != OK || !IsCurrentSession(session))
+    return;
+  MaybeResetRttEstimates();
+  if (server_index >= doh_rtt_estimates_.size())
+    return;
+
+  base::TimeDelta& estimate = doh_rtt_estimates_[server_index];
+  estimate = estimate.is_zero() ? rtt
+                                : estimate * (1 - kRttSampleWeight) +
+                                      rtt * kRttSampleWeight;
+  base::UmaHistogramMediumTimes("Brave.DNS.DohServerRtt", rtt);
+}
+
+base::TimeDelta BraveResolveContext::GetDohServerRttEstimate(
+    size_t doh_server_index) const {
+  if (!rtt_estimates_session_ ||
+      rtt_estimates_session_.get() != current_session_.get() ||
+      doh_server_index >= doh_rtt_estimates_.size()) {
+    return base::TimeDelta();
+  }
+  return doh_rtt_estimates_[doh_server_index];
+}
+
+void BraveResolveContext::MaybeResetRttEstimates() {
+  if (rtt_estimates_session_ &&
+      rtt_estimates_session_.get() == current_session_.get() &&
+      doh_rtt_estimates_.size() == doh_server_stats_.size()) {
+    return;
+  }
+  rtt_estimates_session_ = current_session_;
+  doh_rtt_estimates_.assign(doh_server_stats_.size(), base::TimeDelta());
+}
+
 }  // namespace net
@@ -6,6 +6,10 @@
 #ifndef BRAVE_NET_DNS_BRAVE_RESOLVE_CONTEXT_H_
 #define BRAVE_NET_DNS_BRAVE_RESOLVE_CONTEXT_H_
 
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "net/base/net_export.h"
 #include "net/dns/resolve_context.h"
 
@@ -28,8 +32,30 @@ class NET_EXPORT_PRIVATE BraveResolveContext : public ResolveContext {
                                 const DnsSession* session) const override;
   size_t NumAvailableDohServers(const DnsSession* session) const override;
 
+  // Shortens the wait before DnsTransaction races the next DoH server when
+  // another available server has been answering faster than
+  // |doh_server_index|. The winner records the more recent success, so the
+  // DoH iterator tries it first from then on.
+  base::TimeDelta NextDohFallbackPeriod(size_t doh_server_index,
+                                        const DnsSession* session) override;
+  void RecordRtt(size_t server_index,
+                 bool is_doh_server,
+                 base::TimeDelta rtt,
+                 int rv,
+                 const DnsSession* session) override;
+
+  // Rolling average of the successful query times of |doh_server_index|, or
+  // a zero TimeDelta if it hasn't answered yet in the current session.
+  base::TimeDelta GetDohServerRttEstimate(size_t doh_server_index) const;
+
  private:
   bool IsFirstProbeCompleted(const ServerStats& stat) const;
+  // Drops the estimates if they belong to an older session.
+  void MaybeResetRttEstimates();
+
+  // Indexed like |doh_server_stats_|.
+  std::vector<base::TimeDelta> doh_rtt_estimates_;
+  base::WeakPtr<const DnsSession> rtt_estimates_session_;
 };
 
 }  // namespace net
@@ -123,6 +123,50 @@ TEST_F(BraveResolveContextTest, DohServerAvailability_RecordServerSuccess) {
   EXPECT_TRUE(doh_itr->AttemptAvailable());
 }
 
+TEST_F(BraveResolveContextTest, RacesFasterDohServer) {
+  DnsConfig config;
+  config.dns_over_https_servers.push_back(
+      DnsOverHttpsServerConfig("https://doh1.test/dns-query", true));
+  config.dns_over_https_servers.push_back(
+      DnsOverHttpsServerConfig("https://doh2.test/dns-query", true));
+  scoped_refptr<DnsSession> session = CreateDnsSession(config);
+
+  URLRequestContext request_context;
+  BraveResolveContext context(&request_context, true /* enable_caching */);
+  context.InvalidateCachesAndPerSessionData(session.get(),
+                                            false /* network_change */);
+
+  const base::TimeDelta default_period =
+      context.NextDohFallbackPeriod(0u, session.get());
+  EXPECT_GT(default_period, base::TimeDelta::FromMilliseconds(100));
+
+  context.RecordRtt(1u, true /* is_doh_server */,
+                    base::TimeDelta::FromMilliseconds(40), OK, session.get());
+  EXPECT_EQ(context.GetDohServerRttEstimate(1u),
+            base::TimeDelta::FromMilliseconds(40));
+  EXPECT_EQ(context.NextDohFallbackPeriod(0u, session.get()),
+            base::TimeDelta::FromMilliseconds(60));
+
+  // Failed queries don't count. Once server 0 proves faster, it is the one
+  // raced against server 1 instead.
+  context.RecordRtt(0u, true /* is_doh_server */,
+                    base::TimeDelta::FromMilliseconds(5), ERR_FAILED,
+                    session.get());
+  EXPECT_TRUE(context.GetDohServerRttEstimate(0u).is_zero());
+  context.RecordRtt(0u, true /* is_doh_server */,
+                    base::TimeDelta::FromMilliseconds(30), OK, session.get());
+  EXPECT_EQ(context.GetDohServerRttEstimate(0u),
+            base::TimeDelta::FromMilliseconds(30));
+  EXPECT_LE(context.NextDohFallbackPeriod(1u, session.get()),
+            base::TimeDelta::FromMilliseconds(45));
+
+  // A new session starts over.
+  scoped_refptr<DnsSession> new_session = CreateDnsSession(config);
+  context.InvalidateCachesAndPerSessionData(new_session.get(),
+                                            false /* network_change */);
+  EXPECT_TRUE(context.GetDohServerRttEstimate(1u).is_zero());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -0,0 +1,106 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "brave/third_party/blink/renderer/brave_farbling_pixels.h"
+
+namespace brave {
+
+namespace {
+
+// Grow the noise table in steps of at least this many values, so farbling a
+// buffer one sample at a time doesn't reallocate on every sample.
+constexpr size_t kMinNoiseTableGrowth = 4096;
+
+float NoiseValue(uint64_t state) {
+  const double max_uint64_as_double = UINT64_MAX;
+  // pseudo-random float between 0 and 0.1
+  return (state / max_uint64_as_double) / 10;
+}
+
+}  // namespace
+
+AudioNoiseTable::AudioNoiseTable(uint64_t seed) : state_(seed) {}
+
+AudioNoiseTable::~AudioNoiseTable() = default;
+
+void AudioNoiseTable::Fill(float* destination, size_t count) {
+  if (count > values_.size())
+    Grow(count);
+  const size_t from_table = std::min(count, values_.size());
+  std::memcpy(destination, values_.data(), from_table * sizeof(float));
+  // The table is full at this point, so |state_| is where the rest starts.
+  uint64_t state = state_;
+  for (size_t i = from_table; i < count; ++i) {
+    state = LfsrNext(state);
+    destination[i] = NoiseValue(state);
+  }
+}
+
+void AudioNoiseTable::Grow(size_t count) {
+  const size_t new_size = std::min(
+      kMaxSize, std::max(count, values_.size() + kMinNoiseTableGrowth));
+  values_.reserve(new_size);
+  while (values_.size() < new_size) {
+    state_ = LfsrNext(state_);
+    values_.push_back(NoiseValue(state_));
+  }
+}
+
+float AudioNoiseTable::AtSlow(size_t index) {
+  Grow(index + 1);
+  if (index < values_.size())
+    return values_[index];
+  uint64_t state = state_;
+  for (size_t i = values_.size(); i <= index; ++i)
+    state = LfsrNext(state);
+  return NoiseValue(state);
+}
+
+AudioFarbler::AudioFarbler() = default;
+AudioFarbler::AudioFarbler(const AudioFarbler&) = default;
+AudioFarbler& AudioFarbler::operator=(const AudioFarbler&) = default;
+AudioFarbler::~AudioFarbler() = default;
+
+// static
+AudioFarbler AudioFarbler::Scale(double factor) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kScale;
+  farbler.factor_ = factor;
+  return farbler;
+}
+
+// static
+AudioFarbler AudioFarbler::Noise(scoped_refptr<AudioNoiseTable> table) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kNoise;
+  farbler.noise_table_ = std::move(table);
+  return farbler;
+}
+
+void AudioFarbler::FarbleBuffer(float* data, size_t count) const {
+  if (!data || count == 0)
+    return;
+  switch (mode_) {
+    case Mode::kNone:
+      return;
+    case Mode::kScale: {
+      const double factor = factor_;
+      for (size_t i = 0; i < count; ++i)
+        data[i] = data[i] * factor;
+      return;
+    }
+    case Mode::kNoise:
+      noise_table_->Fill(data, count);
+      return;
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,100 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
+
+namespace brave {
+
+// The pseudo-random values that replace audio samples at the maximum farbling
+// level. Value i is the (i + 1)th output of the farbling LFSR started from
+// |seed|, scaled to [0, 0.1]. The table grows on demand and is shared by the
+// farblers of an execution context, so each value is generated once; values
+// past kMaxSize are generated on the fly instead of being kept.
+// Only used on the main thread; the reference count is thread safe because
+// audio nodes may be released on the audio thread.
+class AudioNoiseTable : public base::RefCountedThreadSafe<AudioNoiseTable> {
+ public:
+  static constexpr size_t kMaxSize = 1 << 20;
+
+  explicit AudioNoiseTable(uint64_t seed);
+
+  AudioNoiseTable(const AudioNoiseTable&) = delete;
+  AudioNoiseTable& operator=(const AudioNoiseTable&) = delete;
+
+  // Writes the first |count| values to |destination|.
+  void Fill(float* destination, size_t count);
+
+  float At(size_t index) {
+    if (index < values_.size())
+      return values_[index];
+    return AtSlow(index);
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<AudioNoiseTable>;
+  ~AudioNoiseTable();
+
+  void Grow(size_t count);
+  float AtSlow(size_t index);
+
+  std::vector<float> values_;
+  // LFSR state that produced the last value in |values_|.
+  uint64_t state_;
+};
+
+// Applies audio farbling to samples handed to scripts. Cheap to copy; the
+// default instance leaves samples untouched.
+class AudioFarbler {
+ public:
+  AudioFarbler();
+  AudioFarbler(const AudioFarbler&);
+  AudioFarbler& operator=(const AudioFarbler&);
+  ~AudioFarbler();
+
+  // Every sample is multiplied by |factor|.
+  static AudioFarbler Scale(double factor);
+  // Every sample is replaced by the matching value of |table|.
+  static AudioFarbler Noise(scoped_refptr<AudioNoiseTable> table);
+
+  bool IsActive() const { return mode_ != Mode::kNone; }
+
+  // Farbles sample |index| of a buffer, for loops that produce one sample at a
+  // time.
+  float Farble(float value, size_t index) const {
+    switch (mode_) {
+      case Mode::kNone:
+        return value;
+      case Mode::kScale:
+        return value * factor_;
+      case Mode::kNoise:
+        return noise_table_->At(index);
+    }
+    return value;
+  }
+
+  // Farbles the first |count| samples of |data| in one pass. The loops are
+  // kept trivial so they get vectorized.
+  void FarbleBuffer(float* data, size_t count) const;
+
+ private:
+  enum class Mode { kNone, kScale, kNoise };
+
+  Mode mode_ = Mode::kNone;
+  double factor_ = 1.0;
+  scoped_refptr<AudioNoiseTable> noise_table_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_H_
@@ -0,0 +1,159 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/third_party/blink/renderer/brave_farbling_pixels.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// Compares audio farbling through AudioFarbler with the per-sample callback it
+// replaced, over buffers the size of the largest AnalyserNode FFT and of a few
+// seconds of AudioBuffer data.
+
+namespace brave {
+
+namespace {
+
+using AudioFarblingCallback = base::RepeatingCallback<float(float, size_t)>;
+
+const char kMetricPrefix[] = "AudioFarbling.";
+const char kMetricCallbackTime[] = "callback_time_per_sample";
+const char kMetricBufferTime[] = "buffer_time_per_sample";
+const char kMetricPerSampleTime[] = "per_sample_time_per_sample";
+
+constexpr uint64_t kSeed = 0x0123456789abcdef;
+constexpr double kFudgeFactor = 0.995;
+constexpr int kIterations = 50;
+
+// The callbacks BraveSessionCache used to hand out.
+float ConstantMultiplier(double fudge_factor, float value, size_t index) {
+  return value * fudge_factor;
+}
+
+float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
+  static uint64_t v;
+  const double maxUInt64AsDouble = UINT64_MAX;
+  if (index == 0)
+    v = seed;
+  v = LfsrNext(v);
+  return (v / maxUInt64AsDouble) / 10;
+}
+
+std::vector<float> MakeSamples(size_t count) {
+  std::vector<float> samples(count);
+  for (size_t i = 0; i < count; i++)
+    samples[i] = static_cast<float>(i % 200) / 100 - 1;
+  return samples;
+}
+
+std::vector<float> FarbleWithCallback(const AudioFarblingCallback& callback,
+                                      std::vector<float> samples) {
+  for (size_t i = 0; i < samples.size(); i++)
+    samples[i] = callback.Run(samples[i], i);
+  return samples;
+}
+
+}  // namespace
+
+TEST(AudioFarblingTest, ScaleMatchesCallback) {
+  std::vector<float> samples = MakeSamples(4096);
+  std::vector<float> expected = FarbleWithCallback(
+      base::BindRepeating(&ConstantMultiplier, kFudgeFactor), samples);
+  AudioFarbler farbler = AudioFarbler::Scale(kFudgeFactor);
+  for (size_t i = 0; i < samples.size(); i++)
+    EXPECT_EQ(expected[i], farbler.Farble(samples[i], i));
+  farbler.FarbleBuffer(samples.data(), samples.size());
+  EXPECT_EQ(expected, samples);
+}
+
+TEST(AudioFarblingTest, NoiseMatchesCallback) {
+  // Longer than the table keeps, so the on the fly part is covered too.
+  const size_t count = AudioNoiseTable::kMaxSize + 100;
+  std::vector<float> samples = MakeSamples(count);
+  std::vector<float> expected = FarbleWithCallback(
+      base::BindRepeating(&PseudoRandomSequence, kSeed), samples);
+  AudioFarbler farbler =
+      AudioFarbler::Noise(base::MakeRefCounted<AudioNoiseTable>(kSeed));
+  for (size_t i = 0; i < 10000; i++)
+    EXPECT_EQ(expected[i], farbler.Farble(samples[i], i));
+  EXPECT_EQ(expected[count - 1], farbler.Farble(samples[count - 1], count - 1));
+  farbler.FarbleBuffer(samples.data(), samples.size());
+  EXPECT_EQ(expected, samples);
+}
+
+TEST(AudioFarblingTest, InactiveLeavesSamples) {
+  std::vector<float> samples = MakeSamples(16);
+  std::vector<float> expected = samples;
+  AudioFarbler farbler;
+  EXPECT_FALSE(farbler.IsActive());
+  farbler.FarbleBuffer(samples.data(), samples.size());
+  EXPECT_EQ(expected, samples);
+}
+
+class AudioFarblingPerfTest
+    : public testing::TestWithParam<std::tuple<bool, size_t>> {};
+
+TEST_P(AudioFarblingPerfTest, Farble) {
+  const bool noise = std::get<0>(GetParam());
+  const size_t count = std::get<1>(GetParam());
+  perf_test::PerfResultReporter reporter(
+      kMetricPrefix,
+      std::string(noise ? "noise_" : "scale_") + base::NumberToString(count));
+  reporter.RegisterImportantMetric(kMetricCallbackTime, "ns");
+  reporter.RegisterImportantMetric(kMetricBufferTime, "ns");
+  reporter.RegisterImportantMetric(kMetricPerSampleTime, "ns");
+
+  AudioFarblingCallback callback =
+      noise ? base::BindRepeating(&PseudoRandomSequence, kSeed)
+            : base::BindRepeating(&ConstantMultiplier, kFudgeFactor);
+  AudioFarbler farbler =
+      noise ? AudioFarbler::Noise(base::MakeRefCounted<AudioNoiseTable>(kSeed))
+            : AudioFarbler::Scale(kFudgeFactor);
+  std::vector<float> samples = MakeSamples(count);
+  const double sample_count = static_cast<double>(count) * kIterations;
+
+  base::ElapsedTimer callback_timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (size_t j = 0; j < count; j++)
+      samples[j] = callback.Run(samples[j], j);
+  }
+  reporter.AddResult(kMetricCallbackTime,
+                     callback_timer.Elapsed().InNanosecondsF() / sample_count);
+
+  // Warm the noise table, as a context that has farbled once already has.
+  farbler.FarbleBuffer(samples.data(), count);
+
+  base::ElapsedTimer buffer_timer;
+  for (int i = 0; i < kIterations; i++)
+    farbler.FarbleBuffer(samples.data(), count);
+  reporter.AddResult(kMetricBufferTime,
+                     buffer_timer.Elapsed().InNanosecondsF() / sample_count);
+
+  // The RealtimeAnalyser hooks run inside its own per-sample loops.
+  base::ElapsedTimer per_sample_timer;
+  for (int i = 0; i < kIterations; i++) {
+    for (size_t j = 0; j < count; j++)
+      samples[j] = farbler.Farble(samples[j], j);
+  }
+  reporter.AddResult(kMetricPerSampleTime,
+                     per_sample_timer.Elapsed().InNanosecondsF() /
+                         sample_count);
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         AudioFarblingPerfTest,
+                         testing::Combine(testing::Bool(),
+                                          testing::Values(32768, 441000)));
+
+}  // namespace brave
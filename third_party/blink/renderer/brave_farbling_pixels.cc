@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_farbling_pixels.h"
+
+#include "base/check.h"
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+
+namespace brave {
+
+void FarblePixels(uint64_t key, uint8_t* data, size_t size) {
+  if (!data || size == 0)
+    return;
+
+  // This needs to be type size_t because we pass it to base::StringPiece
+  // later for content hashing. This is safe because the maximum canvas
+  // dimensions are less than SIZE_T_MAX. (Width and height are each
+  // limited to 32,767 pixels.)
+  // Four bytes per pixel
+  const size_t pixel_count = size / 4;
+  if (pixel_count == 0)
+    return;
+  // calculate initial seed to find first pixel to perturb, based on |key| and
+  // canvas contents
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&key), sizeof key));
+  uint8_t canvas_key[32];
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(data), size),
+               canvas_key, sizeof canvas_key));
+  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
+  // iterate through 32-byte canvas key and use each bit to determine how to
+  // perturb the current pixel; each byte is used twice
+  for (int i = 0; i < 32; i++) {
+    for (int pass = 0; pass < 2; pass++) {
+      uint8_t bit = canvas_key[i];
+      for (int j = 0; j < 8; j++) {
+        // choose which channel (R, G, or B) to perturb
+        const uint64_t channel = v % 3;
+        const uint64_t pixel_index = 4 * (v % pixel_count) + channel;
+        data[pixel_index] ^= (bit & 0x1);
+        bit = bit >> 1;
+        // find next pixel to perturb
+        v = LfsrNext(v);
+      }
+    }
+  }
+}
+
+}  // namespace brave
@@ -0,0 +1,31 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_PIXELS_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_PIXELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Next value of the linear feedback shift register the farbling code uses as
+// its pseudo-random sequence.
+inline uint64_t LfsrNext(uint64_t v) {
+  const uint64_t zero = 0;
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+// Flips the low bit of a few pseudo-randomly chosen color channels of the
+// RGBA pixels in |data|. The choice is seeded from |key| and the pixels
+// themselves, so the same image always comes out the same for a given key.
+//
+// The cost is dominated by hashing |data|; only 512 channels are visited
+// whatever the image size.
+void FarblePixels(uint64_t key, uint8_t* data, size_t size);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_FARBLING_PIXELS_H_
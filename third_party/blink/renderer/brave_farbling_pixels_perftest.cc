@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_farbling_pixels.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/elapsed_timer.h"
+#include "crypto/hmac.h"
+#include "crypto/sha2.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// Measures canvas pixel farbling, the work done on every getImageData() and
+// toDataURL() call, split into hashing the image and perturbing it.
+
+namespace brave {
+
+namespace {
+
+const char kMetricPrefix[] = "FarblePixels.";
+const char kMetricFarbleTime[] = "farble_time_per_megapixel";
+const char kMetricHashTime[] = "hash_time_per_megapixel";
+
+constexpr uint64_t kKey = 0x0123456789abcdef;
+constexpr int kIterations = 20;
+
+std::vector<uint8_t> MakePixels(size_t pixel_count) {
+  std::vector<uint8_t> pixels(pixel_count * 4);
+  for (size_t i = 0; i < pixels.size(); i++)
+    pixels[i] = i % 251;
+  return pixels;
+}
+
+}  // namespace
+
+// Farbling has to stay stable, otherwise sites would see a different
+// fingerprint after an update.
+TEST(FarblePixelsTest, OutputUnchanged) {
+  std::vector<uint8_t> pixels = MakePixels(64 * 64);
+  FarblePixels(kKey, pixels.data(), pixels.size());
+  EXPECT_EQ(
+      "2C84217A04A82CDCB683DA0CE66CFFDA3DFC615795959659F349BE7D7A94443C",
+      base::HexEncode(crypto::SHA256HashString(base::StringPiece(
+                          reinterpret_cast<const char*>(pixels.data()),
+                          pixels.size()))
+                          .data(),
+                      crypto::kSHA256Length));
+}
+
+TEST(FarblePixelsTest, IgnoresEmptyImages) {
+  uint8_t pixels[3] = {1, 2, 3};
+  FarblePixels(kKey, nullptr, 0);
+  FarblePixels(kKey, pixels, sizeof pixels);
+  EXPECT_EQ(1, pixels[0]);
+  EXPECT_EQ(2, pixels[1]);
+  EXPECT_EQ(3, pixels[2]);
+}
+
+class FarblePixelsPerfTest : public testing::TestWithParam<int> {};
+
+TEST_P(FarblePixelsPerfTest, Canvas) {
+  const int side = GetParam();
+  const double megapixels = side * side / 1e6;
+  std::vector<uint8_t> pixels = MakePixels(side * side);
+  perf_test::PerfResultReporter reporter(
+      kMetricPrefix, base::NumberToString(side) + "x" +
+                         base::NumberToString(side));
+  reporter.RegisterImportantMetric(kMetricFarbleTime, "us");
+  reporter.RegisterImportantMetric(kMetricHashTime, "us");
+
+  base::ElapsedTimer farble_timer;
+  for (int i = 0; i < kIterations; i++)
+    FarblePixels(kKey, pixels.data(), pixels.size());
+  reporter.AddResult(kMetricFarbleTime,
+                     farble_timer.Elapsed().InMicrosecondsF() /
+                         (kIterations * megapixels));
+
+  // The hash alone, to show how much of the above is left for the
+  // perturbation itself.
+  crypto::HMAC hmac(crypto::HMAC::SHA256);
+  ASSERT_TRUE(hmac.Init(reinterpret_cast<const unsigned char*>(&kKey),
+                        sizeof kKey));
+  uint8_t digest[32];
+  base::ElapsedTimer hash_timer;
+  for (int i = 0; i < kIterations; i++) {
+    ASSERT_TRUE(hmac.Sign(
+        base::StringPiece(reinterpret_cast<const char*>(pixels.data()),
+                          pixels.size()),
+        digest, sizeof digest));
+  }
+  reporter.AddResult(kMetricHashTime, hash_timer.Elapsed().InMicrosecondsF() /
+                                          (kIterations * megapixels));
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         FarblePixelsPerfTest,
+                         testing::Values(256, 1024, 4096));
+
+}  // namespace brave